@@ -11,13 +11,34 @@
 
 #pragma once
 
+#include <bit>
+#include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #include <xstd/bit_set.hpp>
 
 namespace Xidi
 {
+  /// Invokes a callback once per set bit of a word-sized standard bitset, in ascending index
+  /// order. Set bits are located with hardware bit-scan instructions, via std::countr_zero, so
+  /// the work done scales with the number of set bits rather than with the size of the bitset.
+  /// @tparam kNumBits Number of bits in the bitset. Must fit in a single 64-bit word.
+  /// @tparam CallbackType Type of callback, invocable with the index of a set bit.
+  /// @param [in] bits Bitset whose set bits are of interest.
+  /// @param [in] callback Callback to invoke once per set bit.
+  template <size_t kNumBits, typename CallbackType>
+  inline void ForEachSetBit(const std::bitset<kNumBits>& bits, CallbackType callback)
+  {
+    static_assert(
+        kNumBits <= 64, "Bit-scan iteration requires the bitset to fit in a single 64-bit word.");
+
+    for (uint64_t remainingBits = bits.to_ullong(); 0 != remainingBits;
+         remainingBits &= (remainingBits - 1))
+      callback((unsigned int)std::countr_zero(remainingBits));
+  }
+
   /// Type alias for most bit set objects that operate on plain integers.
   /// @tparam kNumBits Number of bits to be represented by the underlying bit set object.
   template <size_t kNumBits> using BitSet = xstd::bit_set<kNumBits>;
@@ -16,6 +16,7 @@
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <Infra/Core/ProcessInfo.h>
 
@@ -35,7 +36,37 @@ namespace Xidi
       ImportFunctions,
 
       /// IImportFunctions2
-      ImportFunctions2
+      ImportFunctions2,
+
+      /// ILatency
+      Latency,
+
+      /// ISynthesisStatistics
+      SynthesisStatistics,
+
+      /// IInputMetrics
+      InputMetrics,
+
+      /// ILatencyMeasurement
+      LatencyMeasurement,
+
+      /// IDiagnostics
+      Diagnostics,
+
+      /// IMemoryAccounting
+      MemoryAccounting,
+
+      /// IStartupMetrics
+      StartupMetrics,
+
+      /// IStateChangeSubscription
+      StateChangeSubscription,
+
+      /// ICpuBudget
+      CpuBudget,
+
+      /// IImportFunctions3
+      ImportFunctions3
     };
 
     /// Xidi API base class. All API classes must inherit from this class.
@@ -109,6 +140,550 @@ namespace Xidi
     protected:
 
       inline IImportFunctions2(void) : IXidi(EClass::ImportFunctions2) {}
+
+      /// Used by deriving interface versions to register under their own API class enumerators.
+      explicit inline IImportFunctions2(EClass apiClass) : IXidi(apiClass) {}
+    };
+
+    /// Xidi API class for manipulating the functions Xidi imports from the system. Extends the
+    /// second version of this interface with a batched bind operation for loaders that replace an
+    /// entire function table at once.
+    class IImportFunctions3 : public IImportFunctions2
+    {
+    public:
+
+      /// Submits to Xidi an entire set of replacement import function addresses in a single
+      /// operation. The full table is validated before any replacement is published, so either
+      /// every function in the table has its address replaced or none of them do, and loaders
+      /// that bind the complete replacement set at process startup incur one call instead of one
+      /// per function. Valid function names are obtained using the #GetReplaceable API function.
+      /// @param [in] library Library for which functions are to be replaced.
+      /// @param [in] importFunctionTable Read-only reference to a map from function name to
+      /// replacement import address.
+      /// @return `true` if every function in the table was validated and had its address
+      /// replaced, `false` if the table was rejected and no replacements were applied.
+      virtual bool SetReplaceableAll(
+          ELibrary library,
+          const std::unordered_map<std::wstring_view, const void*>& importFunctionTable) = 0;
+
+    protected:
+
+      inline IImportFunctions3(void) : IImportFunctions2(EClass::ImportFunctions3) {}
+    };
+
+    /// Xidi API class for measuring input pipeline latency. Physical hardware snapshots are
+    /// stamped at capture time with a QueryPerformanceCounter value, which is threaded through the
+    /// mapping pipeline and exposed here so that end-to-end input latency can be measured and
+    /// regression-tracked in production builds.
+    class ILatency : public IXidi
+    {
+    public:
+
+      /// Retrieves the timestamp, in QueryPerformanceCounter units, at which the most recent
+      /// hardware snapshot for the specified physical controller was captured.
+      /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+      /// @return Capture timestamp, or 0 if the controller identifier is invalid or no snapshot
+      /// has been captured yet.
+      virtual int64_t GetLastCaptureTimestamp(unsigned int controllerIdentifier) const = 0;
+
+      /// Computes the time elapsed between capture of the most recent hardware snapshot for the
+      /// specified physical controller and the moment of this call.
+      /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+      /// @return Elapsed time in microseconds, or -1 if no snapshot has been captured yet or the
+      /// controller identifier is invalid.
+      virtual int64_t GetTimeSinceLastCaptureMicroseconds(
+          unsigned int controllerIdentifier) const = 0;
+
+    protected:
+
+      inline ILatency(void) : IXidi(EClass::Latency) {}
+    };
+
+    /// Xidi API class for observing keyboard and mouse synthesis behavior. Counters are
+    /// cumulative since process start and are maintained with relaxed atomic operations by the
+    /// input dispatch machinery, so a snapshot is approximate under concurrent updates but
+    /// reading one never blocks synthesis.
+    class ISynthesisStatistics : public IXidi
+    {
+    public:
+
+      /// Number of buckets in the injection latency histogram.
+      static constexpr unsigned int kLatencyHistogramBucketCount = 8;
+
+      /// Upper bound, in microseconds, of each injection latency histogram bucket. A latency
+      /// sample lands in the first bucket whose upper bound it does not exceed; the final bucket
+      /// is unbounded.
+      static constexpr uint64_t
+          kLatencyHistogramBucketUpperBoundsMicroseconds[kLatencyHistogramBucketCount] = {
+              100, 250, 500, 1000, 2500, 5000, 10000, UINT64_MAX};
+
+      /// Snapshot of the cumulative synthesis counters.
+      struct SCounters
+      {
+        /// Number of keyboard and mouse state contributions accepted from mappers.
+        uint64_t contributionsReceived;
+
+        /// Number of contributions absorbed by an identical already-pending contribution rather
+        /// than producing a new pending state change.
+        uint64_t contributionsCoalesced;
+
+        /// Number of INPUT records handed to the system for injection.
+        uint64_t eventsEmitted;
+
+        /// Number of INPUT records the system reported as not injected.
+        uint64_t eventsDropped;
+
+        /// Number of dispatch cycles that delivered at least one event.
+        uint64_t dispatchCycles;
+
+        /// Injection latency histogram. Each sample measures the time from the discrete
+        /// contribution that woke the dispatch thread to completion of the injection call that
+        /// delivered it.
+        uint64_t injectionLatencyHistogram[kLatencyHistogramBucketCount];
+      };
+
+      /// Retrieves a snapshot of the cumulative synthesis counters.
+      /// @return Filled-in counter snapshot structure.
+      virtual SCounters GetCounters(void) const = 0;
+
+    protected:
+
+      inline ISynthesisStatistics(void) : IXidi(EClass::SynthesisStatistics) {}
+    };
+
+    /// Xidi API class for observing input pipeline health via fixed-bucket histograms. All
+    /// histograms are cumulative since process start and are maintained with relaxed atomic
+    /// counters in the input hot paths, so a snapshot is approximate under concurrent updates but
+    /// reading one never blocks input processing.
+    class IInputMetrics : public IXidi
+    {
+    public:
+
+      /// Number of buckets in each latency histogram.
+      static constexpr unsigned int kLatencyHistogramBucketCount = 8;
+
+      /// Upper bound, in microseconds, of each latency histogram bucket. A sample lands in the
+      /// first bucket whose upper bound it does not exceed; the final bucket is unbounded.
+      static constexpr uint64_t
+          kLatencyHistogramBucketUpperBoundsMicroseconds[kLatencyHistogramBucketCount] = {
+              100, 250, 500, 1000, 2500, 5000, 10000, UINT64_MAX};
+
+      /// Number of buckets in the lock wait histogram.
+      static constexpr unsigned int kLockWaitHistogramBucketCount = 8;
+
+      /// Upper bound, in microseconds, of each lock wait histogram bucket. The first bucket
+      /// additionally counts uncontended acquisitions, which are detected without consulting the
+      /// clock at all.
+      static constexpr uint64_t
+          kLockWaitHistogramBucketUpperBoundsMicroseconds[kLockWaitHistogramBucketCount] = {
+              1, 5, 25, 100, 500, 2500, 10000, UINT64_MAX};
+
+      /// Number of buckets in the event buffer occupancy histogram.
+      static constexpr unsigned int kOccupancyHistogramBucketCount = 8;
+
+      /// Upper bound, as a percentage of event buffer capacity, of each occupancy histogram
+      /// bucket. A sample is taken whenever a state change is published to an enabled event
+      /// buffer.
+      static constexpr unsigned int
+          kOccupancyHistogramBucketUpperBoundsPercent[kOccupancyHistogramBucketCount] = {
+              0, 10, 25, 50, 75, 90, 99, 100};
+
+      /// Snapshot of the cumulative input pipeline histograms.
+      struct SHistograms
+      {
+        /// Time from physical hardware state capture to publication of the resulting virtual
+        /// controller state change.
+        uint64_t pollToRefreshLatency[kLatencyHistogramBucketCount];
+
+        /// Time from publication of a virtual controller state change to the first application
+        /// state read that observes it.
+        uint64_t refreshToReadLatency[kLatencyHistogramBucketCount];
+
+        /// Event buffer occupancy at state change publication time.
+        uint64_t eventBufferOccupancy[kOccupancyHistogramBucketCount];
+
+        /// Time spent waiting to acquire a virtual controller concurrency control lock.
+        uint64_t lockWaitTime[kLockWaitHistogramBucketCount];
+      };
+
+      /// Retrieves a snapshot of the cumulative input pipeline histograms.
+      /// @return Filled-in histogram snapshot structure.
+      virtual SHistograms GetHistograms(void) const = 0;
+
+      /// Number of instrumented hot-path profile sites. Site indices follow the order of the
+      /// internal #Profiler::EProfileSite enumerators: mapper state mapping, data packet write,
+      /// keyboard synthesis, and mouse synthesis.
+      static constexpr unsigned int kProfileSiteCount = 4;
+
+      /// Snapshot of the aggregated hot-path profiler cycle samples, one element per profile
+      /// site. All-zero unless sampling is enabled by configuration, and always all-zero in
+      /// builds that compile the profiling instrumentation out.
+      struct SProfileSamples
+      {
+        /// Number of invocations that were sampled, per site.
+        uint64_t sampleCount[kProfileSiteCount];
+
+        /// Total processor cycles measured across all sampled invocations, per site.
+        uint64_t totalCycles[kProfileSiteCount];
+
+        /// Largest number of processor cycles measured for any single sampled invocation, per
+        /// site.
+        uint64_t maximumCycles[kProfileSiteCount];
+      };
+
+      /// Retrieves a snapshot of the aggregated hot-path profiler samples.
+      /// @return Filled-in profiler sample snapshot structure.
+      virtual SProfileSamples GetProfileSamples(void) const = 0;
+
+      /// Snapshot of the cumulative event buffer drop accounting counters, aggregated across all
+      /// virtual controller event buffers. Useful for sizing event buffer capacity
+      /// recommendations from deployed-installation data.
+      struct SEventBufferCounters
+      {
+        /// Number of operations that overflowed an event buffer and discarded buffered events.
+        uint64_t overflowCount;
+
+        /// Total number of buffered events discarded due to overflow.
+        uint64_t droppedEventCount;
+
+        /// Largest number of events ever present at once in any single event buffer.
+        uint32_t highWaterMarkEvents;
+      };
+
+      /// Retrieves a snapshot of the cumulative event buffer drop accounting counters.
+      /// @return Filled-in event buffer counter snapshot structure.
+      virtual SEventBufferCounters GetEventBufferCounters(void) const = 0;
+
+      /// Number of real-time polling loops for which scheduler wakeup statistics are maintained.
+      /// Loop indices follow the order of the internal #InputMetrics::EPollingLoop enumerators:
+      /// physical state polling, then force feedback actuation.
+      static constexpr unsigned int kPollingLoopCount = 2;
+
+      /// Snapshot of the cumulative scheduler wakeup statistics for the real-time polling loops,
+      /// one element per loop. Lateness measures how far past its scheduled due time each timed
+      /// wakeup actually occurred, so installations with timer resolution or thread priority
+      /// problems show up as high lateness and overrun counts.
+      struct SPollingLoopStatistics
+      {
+        /// Number of timed wakeups measured, per loop.
+        uint64_t wakeupCount[kPollingLoopCount];
+
+        /// Total wakeup lateness across all measured wakeups, in milliseconds, per loop.
+        uint64_t totalLatenessMilliseconds[kPollingLoopCount];
+
+        /// Largest lateness measured for any single wakeup, in milliseconds, per loop.
+        uint64_t maximumLatenessMilliseconds[kPollingLoopCount];
+
+        /// Number of wakeups late by at least one full scheduled period, per loop.
+        uint64_t overrunCount[kPollingLoopCount];
+      };
+
+      /// Retrieves a snapshot of the cumulative polling loop scheduler wakeup statistics.
+      /// @return Filled-in polling loop statistics snapshot structure.
+      virtual SPollingLoopStatistics GetPollingLoopStatistics(void) const = 0;
+
+    protected:
+
+      inline IInputMetrics(void) : IXidi(EClass::InputMetrics) {}
+    };
+
+    /// Xidi API class for measuring per-stage input pipeline latency of a single marked input
+    /// transition. Arming the marker selects a physical button on a chosen controller, and the
+    /// next press edge of that button is then tracked through the pipeline, with a
+    /// QueryPerformanceCounter timestamp recorded as it passes each stage. Intended for latency
+    /// certification, with the marked transition produced either by real hardware or by injection
+    /// in automated tests.
+    class ILatencyMeasurement : public IXidi
+    {
+    public:
+
+      /// Per-stage timestamps recorded for a marked input transition, all in
+      /// QueryPerformanceCounter units.
+      struct SStageTimestamps
+      {
+        /// Whether the marked transition has passed through all pipeline stages. Timestamp fields
+        /// are only valid if this flag is set.
+        bool isComplete;
+
+        /// Timestamp at which the hardware snapshot containing the marked transition was
+        /// captured.
+        int64_t captureTime;
+
+        /// Timestamp at which the snapshot was published to state change waiters.
+        int64_t publishTime;
+
+        /// Timestamp at which a virtual controller refreshed its view with the snapshot.
+        int64_t refreshTime;
+
+        /// Timestamp at which an application first read the refreshed state.
+        int64_t readTime;
+      };
+
+      /// Arms the marker for the next press edge of the specified physical button on the
+      /// specified controller, discarding any in-progress or completed measurement. The press
+      /// edge is only recognized once the button has been observed unpressed, so a button already
+      /// held at arming time does not complete a measurement until it is released and pressed
+      /// again.
+      /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+      /// @param [in] physicalButton Physical button of interest, expressed as an
+      /// #Controller::EPhysicalButton enumerator value.
+      virtual void ArmMarker(unsigned int controllerIdentifier, unsigned int physicalButton) = 0;
+
+      /// Disarms the marker and discards any in-progress or completed measurement.
+      virtual void DisarmMarker(void) = 0;
+
+      /// Retrieves the stage timestamps recorded for the marked input transition.
+      /// @return Filled-in stage timestamp structure if the measurement is complete, otherwise a
+      /// structure with the completion flag unset.
+      virtual SStageTimestamps GetMeasurement(void) const = 0;
+
+    protected:
+
+      inline ILatencyMeasurement(void) : IXidi(EClass::LatencyMeasurement) {}
+    };
+
+    /// Xidi API class for querying the runtime health of the input stack. All reported values are
+    /// maintained in cached atomics updated by the owning subsystems as events occur, so taking a
+    /// snapshot is a constant-time read that never blocks input processing. Intended for periodic
+    /// polling by external monitoring agents to detect degraded input stacks.
+    class IDiagnostics : public IXidi
+    {
+    public:
+
+      /// Number of worker threads for which liveness is reported. Thread indices follow the order
+      /// of the internal #Diagnostics::EWorkerThread enumerators: physical state polling, force
+      /// feedback actuation, then keyboard and mouse input dispatch.
+      static constexpr unsigned int kWorkerThreadCount = 3;
+
+      /// Number of import modules for which resolution status is reported. Module indices follow
+      /// the order of the internal #Diagnostics::EImportModule enumerators: WinMM, DirectInput,
+      /// then XInput.
+      static constexpr unsigned int kImportModuleCount = 3;
+
+      /// Number of physical controller slots reported.
+      static constexpr unsigned int kControllerSlotCount = 4;
+
+      /// Maximum length of a reported mapper name, including its terminating null character.
+      static constexpr unsigned int kMapperNameCapacity = 64;
+
+      /// Enumerates the possible resolution states of an import module.
+      enum class EImportStatus : uint32_t
+      {
+        /// Module has not attempted to resolve its imported functions yet.
+        Unknown,
+
+        /// All required imported functions resolved successfully.
+        Resolved,
+
+        /// Resolution was attempted and failed.
+        Failed
+      };
+
+      /// Snapshot of the runtime health of the input stack.
+      struct SHealthSnapshot
+      {
+        /// Number of loop iterations completed, per worker thread. A counter that stops advancing
+        /// between snapshots indicates a dead or hung thread, and the difference between
+        /// snapshots divided by the polling interval gives the loop rate.
+        uint64_t threadIterationCount[kWorkerThreadCount];
+
+        /// Tick count, in milliseconds since system start, of the most recent loop iteration per
+        /// worker thread, or 0 for a thread that has never run. Threads block while idle by
+        /// design, so a stale value with an advancing iteration counter is not by itself a
+        /// problem indicator.
+        uint64_t threadLastActivityTime[kWorkerThreadCount];
+
+        /// Bit mask of physical controller slots currently reporting a connected device, with bit
+        /// position equal to controller identifier.
+        uint32_t connectedControllerMask;
+
+        /// Null-terminated name of the mapper in use per controller slot, truncated to the field
+        /// capacity, or an empty string if no mapper is configured.
+        wchar_t controllerMapperName[kControllerSlotCount][kMapperNameCapacity];
+
+        /// Import resolution status, per import module.
+        EImportStatus importStatus[kImportModuleCount];
+
+        /// System error code of the most recent unexpected input stack failure, or 0 if none has
+        /// occurred. Expected conditions like reads from disconnected controllers are not
+        /// reported here.
+        uint32_t lastErrorCode;
+
+        /// Tick count, in milliseconds since system start, at which the most recent unexpected
+        /// input stack failure occurred, or 0 if none has occurred.
+        uint64_t lastErrorTime;
+      };
+
+      /// Retrieves a snapshot of the runtime health of the input stack.
+      /// @return Filled-in health snapshot structure.
+      virtual SHealthSnapshot GetHealthSnapshot(void) const = 0;
+
+    protected:
+
+      inline IDiagnostics(void) : IXidi(EClass::Diagnostics) {}
+    };
+
+    /// Xidi API class for reporting the memory held live by Xidi inside the running process.
+    class IMemoryAccounting : public IXidi
+    {
+    public:
+
+      /// Number of subsystems for which live memory is reported. Subsystem indices follow the
+      /// order of the internal #MemoryAccounting::ESubsystem enumerators: state change event
+      /// buffers, element mapper object arenas, mapper parser caches, then device identity
+      /// caches.
+      static constexpr unsigned int kSubsystemCount = 4;
+
+      /// Snapshot of live memory usage.
+      struct SMemorySnapshot
+      {
+        /// Number of bytes currently held live, per subsystem. Subsystems that own their backing
+        /// storage outright report exact byte counts; cache-like subsystems report estimates
+        /// covering their keys and stored values but not container bookkeeping overhead.
+        uint64_t subsystemBytesLive[kSubsystemCount];
+
+        /// Whether low-memory mode is enabled for this process.
+        bool lowMemoryModeEnabled;
+      };
+
+      /// Retrieves a snapshot of the memory held live by Xidi.
+      /// @return Filled-in memory snapshot structure.
+      virtual SMemorySnapshot GetMemorySnapshot(void) const = 0;
+
+    protected:
+
+      inline IMemoryAccounting(void) : IXidi(EClass::MemoryAccounting) {}
+    };
+
+    /// Xidi API class for retrieving the measured durations of the startup initialization
+    /// phases, so external telemetry can attribute launch-time cost to individual phases.
+    /// Durations are recorded by the startup pipeline as each phase completes and are zero for
+    /// phases that have not yet run or do not exist in the running Xidi form.
+    class IStartupMetrics : public IXidi
+    {
+    public:
+
+      /// Number of measured startup phases. Phase indices follow the startup pipeline order:
+      /// configuration file read (including custom mapper construction), log output enablement,
+      /// physical controller initialization, configuration monitor start, trace provider
+      /// registration, then import library preload.
+      static constexpr unsigned int kStartupPhaseCount = 6;
+
+      /// Snapshot of startup phase timing.
+      struct SStartupPhaseTimes
+      {
+        /// Measured duration of each startup phase, in microseconds.
+        uint64_t phaseTimeMicroseconds[kStartupPhaseCount];
+
+        /// Whether all startup pipeline threads have run to completion, meaning every phase
+        /// duration is final.
+        bool startupComplete;
+      };
+
+      /// Retrieves a snapshot of the measured startup phase durations.
+      /// @return Filled-in startup phase timing structure.
+      virtual SStartupPhaseTimes GetStartupPhaseTimes(void) const = 0;
+
+    protected:
+
+      inline IStartupMetrics(void) : IXidi(EClass::StartupMetrics) {}
+    };
+
+    /// Xidi API class for subscribing to virtual controller state change notifications.
+    /// Intended for cooperating in-process consumers, such as input display overlays, that
+    /// would otherwise have to observe controller state by polling at high rate. Each
+    /// subscription is serviced by a dedicated notification thread that blocks on the internal
+    /// state change wait infrastructure, so callbacks are event-driven wakeups rather than
+    /// polling and fire once per published state change.
+    class IStateChangeSubscription : public IXidi
+    {
+    public:
+
+      /// Number of axis values in a state snapshot. Axis indices follow the internal axis
+      /// enumerator order: X, Y, Z, X rotation, Y rotation, then Z rotation.
+      static constexpr unsigned int kSnapshotAxisCount = 6;
+
+      /// Plain snapshot of a virtual controller's state, translated from the internal state
+      /// representation at notification time.
+      struct SStateSnapshot
+      {
+        /// Values for all axes, one element per axis.
+        int32_t axisValues[kSnapshotAxisCount];
+
+        /// Pressed state for each button, one bit per button with bit N corresponding to
+        /// button N+1.
+        uint32_t buttonMask;
+
+        /// Pressed state for each POV direction, one bit per direction in the order up, down,
+        /// left, then right starting from the least significant bit.
+        uint32_t povDirectionMask;
+
+        /// Timestamp, in QueryPerformanceCounter units, of the physical hardware snapshot from
+        /// which this state was produced, or 0 if no capture timestamp is available.
+        int64_t captureTimestamp;
+      };
+
+      /// Type of callback invoked on a dedicated notification thread each time the subscribed
+      /// controller's state changes. Callbacks must not block for long periods, as the next
+      /// notification for the same subscription cannot be delivered until the callback returns.
+      /// @param [in] controllerIdentifier Identifier of the controller whose state changed.
+      /// @param [in] newState Snapshot of the new controller state.
+      /// @param [in] context Context pointer supplied at subscription time.
+      using TStateChangeCallback = void (*)(
+          unsigned int controllerIdentifier, const SStateSnapshot& newState, void* context);
+
+      /// Subscribes to state change notifications for the specified controller.
+      /// @param [in] controllerIdentifier Identifier of the controller of interest.
+      /// @param [in] callback Callback to invoke on each state change.
+      /// @param [in] context Opaque context pointer passed through to each callback invocation.
+      /// @return Nonzero subscription token on success, 0 if the parameters are invalid.
+      virtual unsigned int Subscribe(
+          unsigned int controllerIdentifier, TStateChangeCallback callback, void* context) = 0;
+
+      /// Cancels the specified subscription. Blocks until the notification thread has exited,
+      /// so no callback for the subscription is in progress or will occur once this method
+      /// returns. Tokens that do not identify an active subscription are ignored.
+      /// @param [in] subscriptionToken Token returned by a previous subscription request.
+      virtual void Unsubscribe(unsigned int subscriptionToken) = 0;
+
+    protected:
+
+      inline IStateChangeSubscription(void) : IXidi(EClass::StateChangeSubscription) {}
+    };
+
+    /// Xidi API class for observing the status of the per-process CPU budget governor, which
+    /// tracks the aggregate CPU consumption of Xidi's worker threads and stretches their polling
+    /// and synthesis periods when a configured budget is exceeded.
+    class ICpuBudget : public IXidi
+    {
+    public:
+
+      /// Snapshot of the CPU budget governor's status.
+      struct SCpuBudgetStatus
+      {
+        /// Cumulative processor cycle count consumed by all registered worker threads, as of the
+        /// most recent governor sampling pass.
+        uint64_t aggregateCycleCount;
+
+        /// Aggregate worker thread CPU utilization over the most recent sample interval, as a
+        /// percentage of one processor core.
+        double utilizationPercentOfCore;
+
+        /// Configured CPU budget, as a percentage of one processor core, with 0 meaning
+        /// unlimited.
+        unsigned int budgetPercentOfCore;
+
+        /// Worker thread period scale factor currently in effect, with 1 meaning no degradation.
+        unsigned int periodScaleFactor;
+      };
+
+      /// Retrieves a snapshot of the CPU budget governor's status.
+      /// @return Filled-in status structure.
+      virtual SCpuBudgetStatus GetCpuBudgetStatus(void) const = 0;
+
+    protected:
+
+      inline ICpuBudget(void) : IXidi(EClass::CpuBudget) {}
     };
 
     /// Interface for accessing and replacing the functions for a single library's import table.
@@ -133,6 +708,38 @@ namespace Xidi
         return SetReplaceable(replaceableFunction->second, newAddress);
       }
 
+      /// Replaces an entire set of imported functions in a single batched operation. The whole
+      /// table is validated first, with each name resolved to its internal import table index
+      /// exactly once, and only once validation succeeds is the precomputed index plan published.
+      /// Either every function in the table is replaced or none are.
+      /// @param [in] importFunctionTable Read-only reference to a map from function name to
+      /// replacement import address.
+      /// @return `true` if the entire table was validated and published, `false` if any name was
+      /// not recognized, in which case no replacements were applied.
+      inline bool SetReplaceableAll(
+          const std::unordered_map<std::wstring_view, const void*>& importFunctionTable)
+      {
+        const std::unordered_map<std::wstring_view, size_t>& replaceableFunctions =
+            GetReplaceable();
+
+        std::vector<std::pair<size_t, const void*>> replacementPlan;
+        replacementPlan.reserve(importFunctionTable.size());
+        for (const auto& replacementFunction : importFunctionTable)
+        {
+          const auto replaceableFunction = replaceableFunctions.find(replacementFunction.first);
+          if (replaceableFunctions.cend() == replaceableFunction) return false;
+          replacementPlan.emplace_back(replaceableFunction->second, replacementFunction.second);
+        }
+
+        for (const auto& replacementPlanEntry : replacementPlan)
+        {
+          if (false == SetReplaceable(replacementPlanEntry.first, replacementPlanEntry.second))
+            return false;
+        }
+
+        return true;
+      }
+
       /// Replaces the specified imported function with a new one, identified by index into the
       /// import table.
       /// @param [in] replaceableFunctionIndex Index in the internal import table of the function
@@ -149,3 +756,12 @@ namespace Xidi
     inline constexpr const char* const kGetInterfaceFuncName = "XidiApiGetInterface";
   } // namespace Api
 } // namespace Xidi
+
+/// Looks up the interface object implementing the specified API class in this module. Exported so
+/// that other Xidi modules can locate it by name using `GetProcAddress`, and also callable
+/// directly by code within the same module to discover whichever providers the running Xidi form
+/// registers.
+/// @param [in] apiClass API class enumerator.
+/// @return Pointer to the registered implementing object, or `nullptr` if the interface is not
+/// implemented.
+extern "C" __declspec(dllexport) void* XidiApiGetInterface(Xidi::Api::EClass apiClass);
@@ -0,0 +1,315 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file CompileTimeMapper.h
+ *   Declaration of the compile-time mapper facility, which turns a constant-initialized element
+ *   map definition into a fully-inlined state mapping executor during constant evaluation.
+ *   Deployments whose mapper configuration is fixed at build time thereby compile their exact
+ *   mapper into straight-line code with no table walk and no per-step operation decode, while
+ *   dynamically-built mappers keep using the runtime-compiled mapping tables. Because the
+ *   executor is generated from the very same definition object that the mapper is constructed
+ *   with, it cannot diverge from the runtime mapping tables built from that definition.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "ElementMapper.h"
+#include "Mapper.h"
+
+namespace Xidi
+{
+  namespace Controller
+  {
+    namespace CompileTimeMapper
+    {
+      /// Describes the physical input source consumed by one element map definition slot.
+      /// Mirrors the source list used by the runtime mapping step compiler, but identifies each
+      /// slot by pointer-to-member so that definition objects can be inspected during constant
+      /// evaluation without ever reading the inactive array member of the definition union.
+      struct SStepSource
+      {
+        /// Element map definition slot from which the element mapper is read.
+        const IElementMapper* Mapper::SElementMapDefinition::* slot;
+
+        /// Prepared physical input value consumed by the slot.
+        Mapper::EMappingStepInput input;
+
+        /// Physical button consumed by the slot, meaningful only for button inputs.
+        EPhysicalButton sourceButton;
+      };
+
+      /// Physical input sources for all element map definition slots, listed in the order in
+      /// which element mappers contribute during a state mapping pass. This order is externally
+      /// visible through contribution aggregation semantics and must match the runtime mapping
+      /// step compiler exactly.
+      inline constexpr SStepSource kStepSources[] = {
+          {&Mapper::SElementMapDefinition::stickLeftX,
+           Mapper::EMappingStepInput::AnalogStickLeftX,
+           {}},
+          {&Mapper::SElementMapDefinition::stickLeftY,
+           Mapper::EMappingStepInput::AnalogStickLeftY,
+           {}},
+          {&Mapper::SElementMapDefinition::stickRightX,
+           Mapper::EMappingStepInput::AnalogStickRightX,
+           {}},
+          {&Mapper::SElementMapDefinition::stickRightY,
+           Mapper::EMappingStepInput::AnalogStickRightY,
+           {}},
+          {&Mapper::SElementMapDefinition::dpadUp,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::DpadUp},
+          {&Mapper::SElementMapDefinition::dpadDown,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::DpadDown},
+          {&Mapper::SElementMapDefinition::dpadLeft,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::DpadLeft},
+          {&Mapper::SElementMapDefinition::dpadRight,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::DpadRight},
+          {&Mapper::SElementMapDefinition::triggerLT, Mapper::EMappingStepInput::TriggerLT, {}},
+          {&Mapper::SElementMapDefinition::triggerRT, Mapper::EMappingStepInput::TriggerRT, {}},
+          {&Mapper::SElementMapDefinition::buttonA,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::A},
+          {&Mapper::SElementMapDefinition::buttonB,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::B},
+          {&Mapper::SElementMapDefinition::buttonX,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::X},
+          {&Mapper::SElementMapDefinition::buttonY,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::Y},
+          {&Mapper::SElementMapDefinition::buttonLB,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::LB},
+          {&Mapper::SElementMapDefinition::buttonRB,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::RB},
+          {&Mapper::SElementMapDefinition::buttonBack,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::Back},
+          {&Mapper::SElementMapDefinition::buttonStart,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::Start},
+          {&Mapper::SElementMapDefinition::buttonLS,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::LS},
+          {&Mapper::SElementMapDefinition::buttonRS,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::RS},
+          {&Mapper::SElementMapDefinition::buttonGuide,
+           Mapper::EMappingStepInput::Button,
+           EPhysicalButton::Guide},
+      };
+
+      static_assert(
+          _countof(kStepSources) ==
+              (sizeof(Mapper::SElementMapDefinition) / sizeof(const IElementMapper*)),
+          "Compile-time step source list must cover every element map definition slot.");
+
+      /// Determines whether the specified element map definition can be compiled into a
+      /// fully-inlined executor, which requires that every present element mapper be of a plain
+      /// axis, button, or POV type. Definitions using digital axis, split, invert, compound, or
+      /// custom element mappers cannot be compiled and must keep the runtime mapping tables.
+      /// @param [in] definition Element map definition to analyze.
+      /// @return `true` if the definition can be compiled, `false` otherwise.
+      consteval bool IsCompilable(const Mapper::UElementMapDefinition& definition)
+      {
+        for (const SStepSource& stepSource : kStepSources)
+        {
+          const IElementMapper* const elementMapper = definition.named.*(stepSource.slot);
+          if (nullptr == elementMapper) continue;
+
+          switch (elementMapper->GetType())
+          {
+            case EElementMapperType::Axis:
+            case EElementMapperType::Button:
+            case EElementMapperType::Pov:
+              break;
+
+            default:
+              return false;
+          }
+        }
+
+        return true;
+      }
+
+      /// Counts the steps that a compiled executor for the specified element map definition will
+      /// perform, which is simply the number of present element mappers.
+      /// @param [in] definition Element map definition to analyze.
+      /// @return Number of steps in the compiled executor.
+      consteval size_t CountSteps(const Mapper::UElementMapDefinition& definition)
+      {
+        size_t numSteps = 0;
+
+        for (const SStepSource& stepSource : kStepSources)
+        {
+          if (nullptr != definition.named.*(stepSource.slot)) numSteps += 1;
+        }
+
+        return numSteps;
+      }
+
+      /// Compiles a single trivial mapping step from the specified source and element mapper.
+      /// Fuses operation enumerators exactly the same way as the runtime trivial mapping step
+      /// compiler, so both produce identical steps from identical inputs. Must only be invoked
+      /// for element mappers of a plain axis, button, or POV type.
+      /// @param [in] stepSource Physical input source consumed by the step.
+      /// @param [in] elementMapper Element mapper that defines the step's operation and target.
+      /// @return Compiled trivial mapping step.
+      consteval Mapper::STrivialMappingStep CompileStep(
+          const SStepSource& stepSource, const IElementMapper* elementMapper)
+      {
+        // Operation enumerators are laid out so that, within each family, input source kinds and
+        // axis directions are fused by fixed offsets from a base enumerator.
+        unsigned int inputKind = 0;
+        uint8_t stepInputIndex = 0;
+
+        switch (stepSource.input)
+        {
+          case Mapper::EMappingStepInput::AnalogStickLeftX:
+          case Mapper::EMappingStepInput::AnalogStickLeftY:
+          case Mapper::EMappingStepInput::AnalogStickRightX:
+          case Mapper::EMappingStepInput::AnalogStickRightY:
+            inputKind = 0;
+            stepInputIndex = (uint8_t)stepSource.input;
+            break;
+
+          case Mapper::EMappingStepInput::TriggerLT:
+          case Mapper::EMappingStepInput::TriggerRT:
+            inputKind = 2;
+            stepInputIndex =
+                (uint8_t)((unsigned int)stepSource.input -
+                          (unsigned int)Mapper::EMappingStepInput::TriggerLT);
+            break;
+
+          default:
+            inputKind = 1;
+            stepInputIndex = (uint8_t)stepSource.sourceButton;
+            break;
+        }
+
+        switch (elementMapper->GetType())
+        {
+          case EElementMapperType::Axis:
+          {
+            const AxisMapper* const axisMapper = static_cast<const AxisMapper*>(elementMapper);
+            return {
+                .op = (Mapper::ETrivialStepOp)(
+                    (unsigned int)Mapper::ETrivialStepOp::AxisFromAnalogBoth + (3 * inputKind) +
+                    (unsigned int)axisMapper->GetAxisDirection()),
+                .inputIndex = stepInputIndex,
+                .target = (uint8_t)axisMapper->GetAxis(),
+                .targetElementMask = ElementMaskBit(
+                    {.type = EElementType::Axis, .axis = axisMapper->GetAxis()})};
+          }
+
+          case EElementMapperType::Button:
+          {
+            const ButtonMapper* const buttonMapper =
+                static_cast<const ButtonMapper*>(elementMapper);
+            return {
+                .op = (Mapper::ETrivialStepOp)(
+                    (unsigned int)Mapper::ETrivialStepOp::ButtonFromAnalog + inputKind),
+                .inputIndex = stepInputIndex,
+                .target = (uint8_t)buttonMapper->GetButton(),
+                .targetElementMask = ElementMaskBit(
+                    {.type = EElementType::Button, .button = buttonMapper->GetButton()})};
+          }
+
+          default:
+          {
+            const PovMapper* const povMapper = static_cast<const PovMapper*>(elementMapper);
+            return {
+                .op = (Mapper::ETrivialStepOp)(
+                    (unsigned int)Mapper::ETrivialStepOp::PovFromAnalog + inputKind),
+                .inputIndex = stepInputIndex,
+                .target = (uint8_t)povMapper->GetDirection(),
+                .targetElementMask = ElementMaskBit({.type = EElementType::Pov})};
+          }
+        }
+      }
+
+      /// Compiles the complete trivial mapping step sequence for the specified element map
+      /// definition during constant evaluation. Steps appear in contribution order, matching the
+      /// runtime mapping step compiler.
+      /// @tparam kDefinition Element map definition to compile. Must be a constant-initialized
+      /// object with static storage duration and must satisfy #IsCompilable.
+      /// @return Array holding one compiled step per present element mapper.
+      template <const Mapper::UElementMapDefinition& kDefinition>
+      consteval std::array<Mapper::STrivialMappingStep, CountSteps(kDefinition)> CompileSteps(
+          void)
+      {
+        std::array<Mapper::STrivialMappingStep, CountSteps(kDefinition)> compiledSteps = {};
+        size_t nextStepIndex = 0;
+
+        for (const SStepSource& stepSource : kStepSources)
+        {
+          const IElementMapper* const elementMapper = kDefinition.named.*(stepSource.slot);
+          if (nullptr == elementMapper) continue;
+
+          compiledSteps[nextStepIndex] = CompileStep(stepSource, elementMapper);
+          nextStepIndex += 1;
+        }
+
+        return compiledSteps;
+      }
+
+      /// Fully-inlined state mapping executor for the specified element map definition. Each
+      /// instantiation unrolls the definition's entire step sequence into straight-line code:
+      /// every step's operation, input index, and target are compile-time constants, so the
+      /// per-step operation decode folds away and only the contribution arithmetic remains.
+      /// Matches #Mapper::TInlinedMappingExecutor, so an instantiation can be passed directly to
+      /// a mapper constructor alongside the same definition, "MapperDefinitions.cpp"-style.
+      /// @tparam kDefinition Element map definition for which to generate the executor. Must be a
+      /// constant-initialized object with static storage duration and must satisfy #IsCompilable.
+      /// @param [in,out] controllerState Controller state data structure to be updated.
+      /// @param [in] physicalState Physical controller state from which to read button values.
+      /// @param [in] analogValues Prepared analog stick values, ordered by input enumerator.
+      /// @param [in] triggerValues Prepared trigger values, ordered by input enumerator.
+      /// @param [in] consumedElements Mask of virtual controller elements that consumers actually
+      /// read. Steps targeting elements outside this mask are skipped.
+      template <const Mapper::UElementMapDefinition& kDefinition>
+      void Executor(
+          SState& controllerState,
+          const SPhysicalState& physicalState,
+          const int16_t* analogValues,
+          const uint8_t* triggerValues,
+          TElementMask consumedElements)
+      {
+        static_assert(
+            IsCompilable(kDefinition),
+            "Compile-time mappers support only plain axis, button, and POV element mappers.");
+
+        static constexpr std::array kSteps = CompileSteps<kDefinition>();
+
+        [&]<size_t... kStepIndices>(std::index_sequence<kStepIndices...>)
+        {
+          ((0 != (kSteps[kStepIndices].targetElementMask & consumedElements)
+                ? Mapper::ApplyTrivialMappingStep(
+                      kSteps[kStepIndices],
+                      controllerState,
+                      physicalState,
+                      analogValues,
+                      triggerValues)
+                : (void)0),
+           ...);
+        }(std::make_index_sequence<kSteps.size()>());
+      }
+    } // namespace CompileTimeMapper
+  } // namespace Controller
+} // namespace Xidi
@@ -6,38 +6,97 @@
  * Copyright (c) 2016-2026
  ***********************************************************************************************//**
  * @file ConcurrencyWrapper.h
- *   Utility template for adding concurrency-safe operations to data.
+ *   Concurrency utility library shared by the input subsystems: a seqlock wrapper template for
+ *   single-producer multiple-consumer data publication, a versioned signal counter with atomic
+ *   wait/notify semantics, and a single-producer single-consumer ring buffer.
  **************************************************************************************************/
 
 #pragma once
 
-#include <condition_variable>
-#include <shared_mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <stop_token>
 
 namespace Xidi
 {
   /// Wraps data in a way that is concurrency-safe following a single-producer multiple-consumer
-  /// threading model.
+  /// threading model. Reads are implemented using a seqlock (version counter) so that they never
+  /// block the producer thread and complete without acquiring any locks. Threads that ask to sleep
+  /// until the wrapped data change wait directly on the version counter using atomic wait/notify,
+  /// so each waiter detects a change with a single atomic load and no thread ever contends on a
+  /// mutex.
   /// @tparam DataType Underlying wrapped data type.
   template <typename DataType> class ConcurrencyWrapper
   {
   public:
 
     /// Retrieves and returns the stored data in a concurrency-safe way.
+    /// Lock-free: retries only while a write is simultaneously in progress, and by design writes
+    /// are both quick and infrequent.
     /// @return Underlying wrapped data.
     inline DataType Get(void)
     {
-      std::shared_lock lock(mutex);
-      return data;
+      DataType dataSnapshot;
+      uint32_t versionBeforeRead = 0;
+
+      do
+      {
+        versionBeforeRead = version.load(std::memory_order_acquire);
+
+        // An odd version number means a write is in progress, in which case the data are not safe
+        // to read until the producer finishes and publishes an even version number.
+        while (0 != (versionBeforeRead & 1))
+          versionBeforeRead = version.load(std::memory_order_acquire);
+
+        dataSnapshot = data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+      }
+      while (version.load(std::memory_order_relaxed) != versionBeforeRead);
+
+      return dataSnapshot;
+    }
+
+    /// Retrieves and returns the stored data along with its version number in a concurrency-safe
+    /// way. The version number advances every time the data are rewritten, so a consumer can
+    /// detect that the data are unchanged since a previous read by comparing version numbers,
+    /// without retaining or comparing the data themselves. Version numbers should be treated as
+    /// opaque: they are only meaningful for equality comparison with other version numbers
+    /// obtained from the same object.
+    /// @param [out] dataVersion Filled with the version number of the returned data.
+    /// @return Underlying wrapped data.
+    inline DataType Get(uint32_t& dataVersion)
+    {
+      DataType dataSnapshot;
+      uint32_t versionBeforeRead = 0;
+
+      do
+      {
+        versionBeforeRead = version.load(std::memory_order_acquire);
+
+        // An odd version number means a write is in progress, in which case the data are not safe
+        // to read until the producer finishes and publishes an even version number.
+        while (0 != (versionBeforeRead & 1))
+          versionBeforeRead = version.load(std::memory_order_acquire);
+
+        dataSnapshot = data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+      }
+      while (version.load(std::memory_order_relaxed) != versionBeforeRead);
+
+      dataVersion = versionBeforeRead;
+      return dataSnapshot;
     }
 
     /// Writes to the stored data in a concurrency-safe way.
+    /// Intended to be invoked only by the single producer thread.
     /// @param [in] newData New data to be stored.
     inline void Set(const DataType& newData)
     {
-      std::unique_lock lock(mutex);
+      // Odd version number indicates to readers that a write is in progress.
+      version.fetch_add(1, std::memory_order_acquire);
       data = newData;
+      version.fetch_add(1, std::memory_order_release);
     }
 
     /// Updates the stored data in a concurrency-safe way and notifies all waiting threads of the
@@ -53,7 +112,7 @@ namespace Xidi
       if (newData != data)
       {
         Set(newData);
-        updateNotifier.notify_all();
+        version.notify_all();
         return true;
       }
 
@@ -70,20 +129,34 @@ namespace Xidi
     /// due to invalid parameter or interrupted wait.
     inline bool WaitForUpdate(DataType& externalData, std::stop_token stopToken)
     {
-      std::shared_lock lock(mutex);
-
-      updateNotifier.wait(
-          lock,
+      // A stop request bumps the version counter by two, which preserves its parity and hence does
+      // not disturb concurrent readers, then wakes all waiters so that interruption needs no
+      // auxiliary synchronization objects.
+      std::stop_callback stopWakeup(
           stopToken,
-          [this, &externalData]() -> bool
+          [this]() -> void
           {
-            return (data != externalData);
+            version.fetch_add(2, std::memory_order_release);
+            version.notify_all();
           });
 
-      if (stopToken.stop_requested()) return false;
+      while (true)
+      {
+        if (stopToken.stop_requested()) return false;
 
-      externalData = data;
-      return true;
+        const uint32_t versionBeforeCheck = version.load(std::memory_order_acquire);
+
+        DataType dataSnapshot = Get();
+        if (dataSnapshot != externalData)
+        {
+          externalData = dataSnapshot;
+          return true;
+        }
+
+        // Returns immediately if the version already moved past the value checked above, so no
+        // update can be missed between the comparison and the wait.
+        version.wait(versionBeforeCheck, std::memory_order_acquire);
+      }
     }
 
   private:
@@ -91,10 +164,132 @@ namespace Xidi
     /// Wrapped data.
     DataType data;
 
-    /// Condition variable used to wait for updates to the underlying wrapped data.
-    std::condition_variable_any updateNotifier;
+    /// Version number that is incremented twice per write, once when the write begins and once
+    /// when it completes. Odd values indicate a write in progress. Also serves as the futex on
+    /// which waiting threads sleep.
+    std::atomic<uint32_t> version;
+  };
+
+  /// Versioned publication cell on which threads can sleep until a new version is published.
+  /// Replaces the mutex/condition-variable pattern for signalling state changes that are
+  /// themselves stored elsewhere in atomic variables: the producer updates its state and then
+  /// invokes #Signal, and consumers wait directly on the version counter, so no thread ever
+  /// contends on a mutex. Version numbers are opaque and only meaningful for equality comparison
+  /// with other version numbers obtained from the same object.
+  class SignalCounter
+  {
+  public:
+
+    /// Retrieves the current version number, for use with the version-based #Wait overload.
+    /// @return Current version number.
+    inline uint32_t GetVersion(void) const
+    {
+      return version.load(std::memory_order_acquire);
+    }
+
+    /// Publishes a new version and wakes all waiting threads. Any state a waiter's predicate
+    /// examines must be written before this method is invoked.
+    inline void Signal(void)
+    {
+      version.fetch_add(1, std::memory_order_release);
+      version.notify_all();
+    }
+
+    /// Blocks the calling thread until the version number differs from the supplied last-known
+    /// value. Returns immediately if it already differs, so no signal can be missed between
+    /// retrieving the version number and starting the wait.
+    /// @param [in] lastKnownVersion Version number previously obtained from #GetVersion.
+    inline void Wait(uint32_t lastKnownVersion) const
+    {
+      version.wait(lastKnownVersion, std::memory_order_acquire);
+    }
+
+    /// Blocks the calling thread until the supplied predicate is satisfied. The predicate is
+    /// evaluated once before each wait, with the version number captured first, so a signal that
+    /// arrives between the predicate evaluation and the wait wakes the caller immediately.
+    /// @param [in] predicate Predicate to evaluate, invoked with no arguments and expected to
+    /// return `true` once the condition the caller is waiting for holds.
+    template <typename PredicateType> inline void Wait(PredicateType predicate) const
+    {
+      while (true)
+      {
+        const uint32_t versionBeforeCheck = GetVersion();
+        if (true == predicate()) return;
+        Wait(versionBeforeCheck);
+      }
+    }
+
+  private:
+
+    /// Version number that is incremented on every signal. Also serves as the futex on which
+    /// waiting threads sleep.
+    std::atomic<uint32_t> version;
+  };
+
+  /// Fixed-capacity ring buffer following a single-producer single-consumer threading model.
+  /// Exactly one thread may push and exactly one thread may pop, in which case all operations are
+  /// lock-free and wait-free: the producer and consumer each own one index and only ever read the
+  /// other's with acquire semantics. Indices advance monotonically and are mapped into the
+  /// element array by masking, which requires the capacity to be a power of two.
+  /// @tparam DataType Type of element held in the ring buffer. Must be default-constructible and
+  /// copy-assignable.
+  /// @tparam kCapacity Maximum number of elements the ring buffer can hold. Must be a power of
+  /// two.
+  template <typename DataType, size_t kCapacity> class SpscRingBuffer
+  {
+    static_assert(
+        (kCapacity >= 2) && (0 == (kCapacity & (kCapacity - 1))),
+        "Ring buffer capacity must be a power of two.");
+
+  public:
+
+    /// Determines if this ring buffer is empty. Exact when invoked by the consumer thread;
+    /// otherwise a snapshot that may be stale by the time it is examined.
+    /// @return `true` if the ring buffer holds no elements, `false` otherwise.
+    inline bool Empty(void) const
+    {
+      return (
+          popIndex.load(std::memory_order_relaxed) == pushIndex.load(std::memory_order_acquire));
+    }
+
+    /// Attempts to push an element into this ring buffer. Intended to be invoked only by the
+    /// single producer thread.
+    /// @param [in] element Element to push.
+    /// @return `true` if the element was pushed, `false` if the ring buffer is full.
+    inline bool TryPush(const DataType& element)
+    {
+      const size_t currentPushIndex = pushIndex.load(std::memory_order_relaxed);
+      if (kCapacity == (currentPushIndex - popIndex.load(std::memory_order_acquire)))
+        return false;
+
+      elements[currentPushIndex & (kCapacity - 1)] = element;
+      pushIndex.store(currentPushIndex + 1, std::memory_order_release);
+      return true;
+    }
+
+    /// Attempts to pop the oldest element from this ring buffer. Intended to be invoked only by
+    /// the single consumer thread.
+    /// @param [out] element Filled with the popped element, if successful.
+    /// @return `true` if an element was popped, `false` if the ring buffer is empty.
+    inline bool TryPop(DataType& element)
+    {
+      const size_t currentPopIndex = popIndex.load(std::memory_order_relaxed);
+      if (currentPopIndex == pushIndex.load(std::memory_order_acquire)) return false;
+
+      element = elements[currentPopIndex & (kCapacity - 1)];
+      popIndex.store(currentPopIndex + 1, std::memory_order_release);
+      return true;
+    }
+
+  private:
+
+    /// Element storage.
+    DataType elements[kCapacity];
+
+    /// Monotonic index of the next element to be pushed. Owned by the producer thread.
+    std::atomic<size_t> pushIndex;
 
-    /// Mutex for protecting against concurrent accesses to the underlying wrapped data.
-    std::shared_mutex mutex;
+    /// Monotonic index of the next element to be popped. Owned by the consumer thread.
+    std::atomic<size_t> popIndex;
   };
 } // namespace Xidi
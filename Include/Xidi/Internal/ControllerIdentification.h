@@ -16,6 +16,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "ApiDirectInput.h"
 #include "ControllerTypes.h"
@@ -94,6 +95,19 @@ namespace Xidi
       REFGUID instanceGUID,
       std::wstring* devicePath = nullptr);
 
+  /// Runs XInput support checks for the specified DirectInput controllers concurrently on a small
+  /// group of worker threads, recording the results in an internal cache. Subsequent calls to
+  /// #DoesDirectInputControllerSupportXInput for the same controllers are then served from the
+  /// cache, so the total time spent checking a batch of controllers is bounded by the slowest
+  /// single device rather than by the sum over all of them. Cached results are automatically
+  /// discarded whenever the system reports that hardware has arrived or been removed.
+  /// @tparam diVersion DirectInput version enumerator.
+  /// @param [in] dicontext IDirectInput context from which the controllers are to be obtained.
+  /// @param [in] instanceGUIDs DirectInput instance GUIDs identifying the controllers to check.
+  template <EDirectInputVersion diVersion> void PrescanDirectInputControllersForXInputSupport(
+      typename DirectInputTypes<diVersion>::IDirectInputCompatType* dicontext,
+      const std::vector<GUID>& instanceGUIDs);
+
   /// Performs a DirectInput-style controller enumeration of Xidi virtual controllers.
   /// Callback parameter type was copied and pasted from DirectInput headers and modified to be
   /// amenable to being used in a template like this.
@@ -49,6 +49,14 @@ namespace Xidi
       inline constexpr int16_t kAnalogPressedThresholdPositive =
           (kAnalogValueNeutral + kAnalogValueMax) / 3;
 
+      /// Deadzone and saturation percentages applied to a single analog source by the batch
+      /// transform kernels.
+      struct SAnalogTransformParams
+      {
+        unsigned int deadzonePercent;
+        unsigned int saturationPercent;
+      };
+
       /// Applies deadzone and saturation transformations to a raw analog value.
       /// @param [in] analogValue Analog value for which a deadzone should be applied.
       /// @param [in] deadzoneHudnredthsOfPercent Hundredths of a percent of the analog range for
@@ -56,6 +64,31 @@ namespace Xidi
       int16_t ApplyRawAnalogTransform(
           int16_t analogValue, unsigned int deadzonePercent, unsigned int saturationPercent);
 
+      /// Applies deadzone and saturation transformations to all four raw analog stick values of a
+      /// physical controller in a single vectorized pass. Per-lane results are identical to
+      /// invoking #ApplyRawAnalogTransform once per value with the corresponding parameters.
+      /// @param [in] analogValues Raw analog values to transform, one per lane.
+      /// @param [in] transformParams Deadzone and saturation percentages, one element per lane.
+      /// @param [out] transformedValues Filled with the transformed analog values.
+      void ApplyRawAnalogTransformBatch(
+          const int16_t (&analogValues)[4],
+          const SAnalogTransformParams (&transformParams)[4],
+          int16_t (&transformedValues)[4]);
+
+      /// Applies deadzone and saturation transformations radially to a two-dimensional analog
+      /// stick position. The stick position is treated as a vector: its magnitude is computed
+      /// once, the deadzone and saturation cutoffs are applied to the magnitude, and both axes
+      /// are then scaled together by a common factor. Direction is preserved exactly, so
+      /// diagonals are not distorted the way independent per-axis transforms distort them.
+      /// @param [in] coordinates Analog stick position to transform.
+      /// @param [in] deadzonePercent Percent of the analog range to treat as deadzone.
+      /// @param [in] saturationPercent Percent of the analog range at which to saturate.
+      /// @return Transformed analog stick position.
+      SAnalogStickCoordinates ApplyRadialAnalogTransform(
+          SAnalogStickCoordinates coordinates,
+          unsigned int deadzonePercent,
+          unsigned int saturationPercent);
+
       /// Applies deadzone and saturation transformations to a raw trigger value.
       /// @param [in] analogValue Analog value for which a deadzone should be applied.
       /// @param [in] deadzoneHudnredthsOfPercent Hundredths of a percent of the analog range for
@@ -63,6 +96,17 @@ namespace Xidi
       uint8_t ApplyRawTriggerTransform(
           uint8_t triggerValue, unsigned int deadzonePercent, unsigned int saturationPercent);
 
+      /// Applies deadzone and saturation transformations to both raw trigger values of a physical
+      /// controller in a single vectorized pass. Per-lane results are identical to invoking
+      /// #ApplyRawTriggerTransform once per value with the corresponding parameters.
+      /// @param [in] triggerValues Raw trigger values to transform, one per lane.
+      /// @param [in] transformParams Deadzone and saturation percentages, one element per lane.
+      /// @param [out] transformedValues Filled with the transformed trigger values.
+      void ApplyRawTriggerTransformBatch(
+          const uint8_t (&triggerValues)[2],
+          const SAnalogTransformParams (&transformParams)[2],
+          uint8_t (&transformedValues)[2]);
+
       /// Determines if an analog reading is considered "pressed" as a digital button in the
       /// negative direction.
       /// @param [in] analogValue Analog reading from the XInput controller.
@@ -171,6 +171,58 @@ namespace Xidi
 
     static_assert(sizeof(SElementIdentifier) <= 4, "Data structure size constraint violation.");
 
+    /// Type alias for a bit mask over virtual controller elements. Axes occupy the low-order bits
+    /// in enumerator order, buttons follow in enumerator order, and the POV occupies the final
+    /// bit.
+    using TElementMask = uint32_t;
+
+    /// Total number of virtual controller elements representable in an element mask.
+    inline constexpr unsigned int kVirtualElementCount =
+        (unsigned int)EAxis::Count + (unsigned int)EButton::Count + 1;
+
+    static_assert(
+        kVirtualElementCount <= (8 * sizeof(TElementMask)),
+        "Element mask type is too small to cover all virtual controller elements.");
+
+    /// Element mask with every virtual controller element present.
+    inline constexpr TElementMask kElementMaskAll =
+        (((TElementMask)1 << kVirtualElementCount) - 1);
+
+    /// Computes the element mask bit index that corresponds to a virtual controller element, with
+    /// very little error checking.
+    /// @param [in] element Virtual controller element for which the bit index is desired.
+    /// @return Corresponding element mask bit index.
+    constexpr unsigned int ElementMaskIndex(SElementIdentifier element)
+    {
+      switch (element.type)
+      {
+        case EElementType::Axis:
+          return (unsigned int)element.axis;
+        case EElementType::Button:
+          return (unsigned int)EAxis::Count + (unsigned int)element.button;
+        default:
+          return (unsigned int)EAxis::Count + (unsigned int)EButton::Count;
+      }
+    }
+
+    /// Computes the element mask with exactly the bit set that corresponds to a virtual
+    /// controller element. Identifiers that do not name a single concrete element, like the
+    /// whole-controller sentinel, conservatively produce a mask with every element present.
+    /// @param [in] element Virtual controller element for which the mask is desired.
+    /// @return Corresponding element mask.
+    constexpr TElementMask ElementMaskBit(SElementIdentifier element)
+    {
+      switch (element.type)
+      {
+        case EElementType::Axis:
+        case EElementType::Button:
+        case EElementType::Pov:
+          return ((TElementMask)1 << ElementMaskIndex(element));
+        default:
+          return kElementMaskAll;
+      }
+    }
+
     /// Capabilities of a single Xidi virtual controller axis. Identifies the axis type enumerator
     /// and contains other information about how the axis can behave as part of a virtual
     /// controller.
@@ -368,6 +420,22 @@ namespace Xidi
         sizeof(UPovDirection::components) == sizeof(UPovDirection::all),
         "Mismatch in POV view sizes.");
 
+    /// Packs the individual POV direction components into a dense bit representation, one bit per
+    /// #EPovDirection enumerator in enumerator order. Useful as an index into lookup tables that
+    /// cover all possible POV direction states.
+    /// @param [in] povDirection POV direction state to pack.
+    /// @return Packed POV direction state, strictly less than 2 to the power of
+    /// #EPovDirection::Count.
+    constexpr unsigned int PovDirectionIndex(UPovDirection povDirection)
+    {
+      unsigned int packedPovState = 0;
+
+      for (unsigned int i = 0; i < static_cast<unsigned int>(EPovDirection::Count); ++i)
+        packedPovState |= (static_cast<unsigned int>(povDirection.components[i]) << i);
+
+      return packedPovState;
+    }
+
     /// Native data format for virtual controllers, used internally to represent controller state.
     /// Validity or invalidity of each element depends on the mapper.
     struct SState
@@ -383,6 +451,11 @@ namespace Xidi
       /// quantity.
       UPovDirection povDirection;
 
+      /// Timestamp, in QueryPerformanceCounter units, of the physical hardware snapshot from which
+      /// this state was produced. Used for end-to-end latency accounting. Excluded from equality
+      /// comparisons so that identical inputs captured at different times compare equal.
+      int64_t captureTimestamp;
+
       constexpr bool operator==(const SState& other) const
       {
         return (
@@ -425,7 +498,7 @@ namespace Xidi
       }
     };
 
-    static_assert(sizeof(SState) <= 32, "Data structure size constraint violation.");
+    static_assert(sizeof(SState) <= 40, "Data structure size constraint violation.");
 
     /// Enumerates possible statuses for physical controller devices.
     enum class EPhysicalDeviceStatus : uint8_t
@@ -469,8 +542,10 @@ namespace Xidi
 
     /// Enumerates all digital buttons that might be present on a physical controller. As an
     /// implementation simplification, the order of enumerators corresponds to the ordering used in
-    /// XInput. One enumerator exists per possible button. Guide and Share buttons are not actually
-    /// used, but they still have space allocated for them on a speculative basis.
+    /// XInput. One enumerator exists per possible button. The Guide button is reported only when
+    /// the loaded XInput library exports the extended state-reading function; otherwise its bit is
+    /// always clear. The Share button is not actually used, but it still has space allocated for
+    /// it on a speculative basis.
     enum class EPhysicalButton : uint8_t
     {
       DpadUp,
@@ -483,7 +558,7 @@ namespace Xidi
       RS,
       LB,
       RB,
-      UnusedGuide,
+      Guide,
       UnusedShare,
       A,
       B,
@@ -513,7 +588,18 @@ namespace Xidi
       /// button.
       std::bitset<static_cast<int>(EPhysicalButton::Count)> button;
 
-      constexpr bool operator==(const SPhysicalState& other) const = default;
+      /// Timestamp, in QueryPerformanceCounter units, at which this snapshot was captured from the
+      /// hardware. Used for end-to-end latency accounting.
+      int64_t captureTimestamp;
+
+      /// Compares everything except the capture timestamp, so that identical hardware snapshots
+      /// captured at different times compare equal and do not generate spurious state updates.
+      constexpr bool operator==(const SPhysicalState& other) const
+      {
+        return (
+            (other.deviceStatus == deviceStatus) && (other.stick == stick) &&
+            (other.trigger == trigger) && (other.button == button));
+      }
 
       constexpr int16_t operator[](EPhysicalStick desiredStick) const
       {
@@ -546,6 +632,6 @@ namespace Xidi
       }
     };
 
-    static_assert(sizeof(SPhysicalState) <= 16, "Data structure size constraint violation.");
+    static_assert(sizeof(SPhysicalState) <= 24, "Data structure size constraint violation.");
   } // namespace Controller
 } // namespace Xidi
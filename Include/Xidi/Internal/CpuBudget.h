@@ -0,0 +1,58 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file CpuBudget.h
+ *   Declaration of the per-process CPU budget governor for Xidi's worker threads. Worker threads
+ *   register themselves at startup, a periodic governor pass aggregates their cycle consumption,
+ *   and when a configured budget is exceeded the governor raises a period scale factor that the
+ *   worker loops fold into their own polling and synthesis periods, degrading responsiveness
+ *   gracefully instead of exceeding the budget.
+ **************************************************************************************************/
+
+#pragma once
+
+namespace Xidi
+{
+  namespace CpuBudget
+  {
+    /// Maximum value of the period scale factor, bounding how far the governor can stretch
+    /// worker thread periods when the process is over its CPU budget.
+    inline constexpr unsigned int kMaxPeriodScaleFactor = 8;
+
+    /// Pure policy function that computes the next period scale factor from the current factor
+    /// and the most recent utilization sample. The factor doubles while utilization exceeds the
+    /// budget and halves once utilization drops below three quarters of the budget, with the gap
+    /// between those two thresholds providing hysteresis so the factor does not oscillate when
+    /// utilization hovers near the budget. A budget of 0 disables the governor entirely and
+    /// resets the factor to 1.
+    /// @param [in] currentPeriodScaleFactor Period scale factor currently in effect.
+    /// @param [in] utilizationPercentOfCore Aggregate worker thread CPU utilization over the most
+    /// recent sample interval, expressed as a percentage of one processor core.
+    /// @param [in] budgetPercentOfCore Configured CPU budget, expressed as a percentage of one
+    /// processor core, with 0 meaning unlimited.
+    /// @return Period scale factor that should be in effect for the next sample interval.
+    unsigned int ComputeNextPeriodScaleFactor(
+        unsigned int currentPeriodScaleFactor,
+        double utilizationPercentOfCore,
+        unsigned int budgetPercentOfCore);
+
+    /// Retrieves the period scale factor currently in effect. Worker thread loops multiply their
+    /// polling and synthesis periods by this factor, so a factor of 1, the normal case, means no
+    /// degradation is in effect. Intended to be consulted once per loop iteration; the cost is a
+    /// single relaxed atomic load.
+    /// @return Period scale factor currently in effect.
+    unsigned int GetPeriodScaleFactor(void);
+
+    /// Registers the calling thread with the CPU budget governor, which thereafter includes the
+    /// thread's cycle consumption in the aggregate it measures against the configured budget.
+    /// Intended to be called once at the top of each worker thread procedure. The first
+    /// registration starts the governor's periodic sampling pass. Registered threads are tracked
+    /// for the remainder of the process; worker threads that exit simply stop contributing new
+    /// cycles. Concurrency-safe.
+    void RegisterCurrentWorkerThread(void);
+  } // namespace CpuBudget
+} // namespace Xidi
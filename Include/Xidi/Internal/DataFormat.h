@@ -12,14 +12,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
+#include <span>
+#include <vector>
 
 #include "ApiDirectInput.h"
 #include "ControllerTypes.h"
+#include "StateChangeEventBuffer.h"
 
 namespace Xidi
 {
@@ -147,6 +152,38 @@ namespace Xidi
       {
         povOffsetsUnused.insert(offset);
       }
+
+      /// Computes the number of leading bytes of the application data packet that can hold
+      /// controller data, which is the end of the furthest mapped element or unused POV slot.
+      /// Applications sometimes declare very large packets with sparse mappings. Bytes beyond
+      /// this span are always zero in a written packet, so the precomputed packet template only
+      /// needs to cover this span and the remainder can be zero-filled.
+      /// @return Number of bytes, starting from the beginning of the data packet, that can hold
+      /// non-zero data when a data packet is written.
+      inline TOffset EffectiveWriteSpanBytes(void) const
+      {
+        TOffset effectiveWriteSpanBytes = 0;
+
+        for (const auto offsetValue : axisOffset)
+          if (kInvalidOffsetValue != offsetValue)
+            effectiveWriteSpanBytes =
+                std::max(effectiveWriteSpanBytes, offsetValue + (TOffset)sizeof(TAxisValue));
+
+        for (const auto offsetValue : buttonOffset)
+          if (kInvalidOffsetValue != offsetValue)
+            effectiveWriteSpanBytes =
+                std::max(effectiveWriteSpanBytes, offsetValue + (TOffset)sizeof(TButtonValue));
+
+        if (kInvalidOffsetValue != povOffset)
+          effectiveWriteSpanBytes =
+              std::max(effectiveWriteSpanBytes, povOffset + (TOffset)sizeof(EPovValue));
+
+        for (const auto offsetValue : povOffsetsUnused)
+          effectiveWriteSpanBytes =
+              std::max(effectiveWriteSpanBytes, offsetValue + (TOffset)sizeof(EPovValue));
+
+        return effectiveWriteSpanBytes;
+      }
     };
 
     /// Value used in place of a real offset to indicate that no valid offset exists.
@@ -174,6 +211,21 @@ namespace Xidi
     static std::unique_ptr<DataFormat> CreateFromApplicationFormatSpec(
         const DIDATAFORMAT& appFormatSpec, const Controller::SCapabilities controllerCapabilities);
 
+    /// Memoizing variant of #CreateFromApplicationFormatSpec. Data format objects are immutable
+    /// once created, so identical creation requests, which arise whenever an application opens
+    /// several Xidi controllers and sets the same custom data format on each, can all share one
+    /// object, including its compiled write plan and lookup tables. Created objects are memoized
+    /// process-wide, keyed by the serialized application format descriptor and controller
+    /// capabilities, so only the first request pays for reconciliation. Failed creation attempts
+    /// are not memoized. Concurrency-safe.
+    /// @param [in] appFormatSpec Application-provided DirectInput data format specification.
+    /// @param [in] controllerCapabilities Capabilities of the virtual controller for which the
+    /// data format is being specified.
+    /// @return Pointer to a possibly-shared data format representation, or `nullptr` if there is
+    /// an issue with the application format specification.
+    static std::shared_ptr<const DataFormat> CreateSharedFromApplicationFormatSpec(
+        const DIDATAFORMAT& appFormatSpec, const Controller::SCapabilities controllerCapabilities);
+
     /// Generates a DirectInput axis value from a virtual controller axis value.
     /// @param [in] axis Virtual controller axis value.
     /// @return Corresponding DirectInput value.
@@ -242,10 +294,25 @@ namespace Xidi
       return (GetOffsetForElement(element).has_value());
     }
 
+    /// Translates a contiguous span of buffered virtual controller state change events into
+    /// DirectInput object data records in a single pass, resolving each element's data format
+    /// offset directly from the precomputed per-element offset arrays. The output array must have
+    /// room for one record per event in the span. Failure indicates an event that identifies an
+    /// element not present in this data format, which callers are expected to have filtered out
+    /// ahead of time via the controller's event filter.
+    /// @param [in] events Span of buffered events to translate, oldest first.
+    /// @param [out] objectDataArray Array of object data records to fill.
+    /// @return `true` on success, `false` if an event could not be translated.
+    bool TranslateStateChangeEvents(
+        std::span<const Controller::StateChangeEventBuffer::SEvent> events,
+        LPDIDEVICEOBJECTDATA objectDataArray) const;
+
     /// Formats the specified virtual controller state as an application data packet and writes it
     /// to the specified buffer. Useful for providing the application with an instantaneous snapshot
-    /// of the state of a virtual controller. Failure indicates an issue with the arguments passed,
-    /// which is indicated to the DirectInput application by returning `DIERR_INVALIDPARAM`.
+    /// of the state of a virtual controller. Only the effective write span of the data format is
+    /// written; buffer bytes beyond the furthest mapped element never hold controller data and
+    /// are left untouched. Failure indicates an issue with the arguments passed, which is
+    /// indicated to the DirectInput application by returning `DIERR_INVALIDPARAM`.
     /// @return `true` on success, `false` on failure due to invalid arguments.
     bool WriteDataPacket(
         void* packetBuffer,
@@ -254,19 +321,76 @@ namespace Xidi
 
   private:
 
+    /// Describes a single value write performed when producing an application data packet.
+    /// The data format specification is immutable once an object is created, so at construction
+    /// time it is compiled into a linear sequence of these records, one per controller element the
+    /// application's format includes. Writing a data packet then executes the sequence directly
+    /// instead of re-interpreting the specification on every call.
+    struct SDataPacketWriteStep
+    {
+      /// Offset within the application data packet at which the value is written.
+      TOffset offsetInPacket;
+
+      /// Virtual controller element whose value is written. Element type determines both the
+      /// source of the value and the width and encoding of the write.
+      Controller::SElementIdentifier element;
+    };
+
     /// Objects cannot be constructed externally. This constructor requires a complete data
     /// format specification, which will be move-assigned to this object's instance variable,
     /// and a controller capabilities object which is not owned by (and must outlive) this
     /// object.
     inline DataFormat(
         const Controller::SCapabilities controllerCapabilities, SDataFormatSpec&& dataFormatSpec)
-        : controllerCapabilities(controllerCapabilities), dataFormatSpec(std::move(dataFormatSpec))
+        : controllerCapabilities(controllerCapabilities),
+          dataFormatSpec(std::move(dataFormatSpec)),
+          offsetElementTable(ComputeOffsetElementTable(this->dataFormatSpec)),
+          dataPacketTemplate(ComputeDataPacketTemplate(this->dataFormatSpec)),
+          dataPacketWriteSteps(ComputeDataPacketWriteSteps(this->dataFormatSpec))
     {}
 
+    /// Builds a direct-indexed reverse lookup table from application data packet offset to
+    /// virtual controller element for the specified data format specification. Offsets are
+    /// bounded by the packet size, so offset-to-element queries become a single array load
+    /// instead of an associative container lookup.
+    /// @param [in] dataFormatSpec Complete data format specification.
+    /// @return Reverse lookup table, indexed by offset, with empty slots at offsets that have no
+    /// associated element.
+    static std::vector<std::optional<Controller::SElementIdentifier>> ComputeOffsetElementTable(
+        const SDataFormatSpec& dataFormatSpec);
+
+    /// Computes the initial contents of an application data packet for the specified data format
+    /// specification. The template is all zero except for unused POV slots, which the application
+    /// expects to read as centered. It covers only the effective write span of the data format,
+    /// not the whole declared packet size, so sparse mappings in large declared packets do not
+    /// pay for full-packet fills.
+    /// @param [in] dataFormatSpec Complete data format specification.
+    /// @return Byte buffer holding the initial contents of an application data packet.
+    static std::vector<uint8_t> ComputeDataPacketTemplate(const SDataFormatSpec& dataFormatSpec);
+
+    /// Compiles the specified data format specification into a linear sequence of value write
+    /// steps, one per controller element present in the application's data format.
+    /// @param [in] dataFormatSpec Complete data format specification.
+    /// @return Write steps to execute when producing an application data packet.
+    static std::vector<SDataPacketWriteStep> ComputeDataPacketWriteSteps(
+        const SDataFormatSpec& dataFormatSpec);
+
     /// Controller capabilities. Often consulted when identifying controller objects.
     const Controller::SCapabilities controllerCapabilities;
 
     /// Complete description of the application's data format.
     const SDataFormatSpec dataFormatSpec;
+
+    /// Direct-indexed reverse lookup table from application data packet offset to virtual
+    /// controller element, with one slot per byte of the application data packet.
+    const std::vector<std::optional<Controller::SElementIdentifier>> offsetElementTable;
+
+    /// Initial contents of an application data packet, copied into the application's buffer
+    /// before individual element values are written. Sized to the effective write span of the
+    /// data format rather than the whole declared packet.
+    const std::vector<uint8_t> dataPacketTemplate;
+
+    /// Compiled sequence of value writes executed when producing an application data packet.
+    const std::vector<SDataPacketWriteStep> dataPacketWriteSteps;
   };
 } // namespace Xidi
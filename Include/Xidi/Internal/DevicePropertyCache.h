@@ -0,0 +1,84 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file DevicePropertyCache.h
+ *   Declaration of functionality for persisting the device properties that an application
+ *   applies to its virtual controllers and pre-applying them on subsequent launches.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace Controller
+  {
+    class VirtualController;
+
+    namespace DevicePropertyCache
+    {
+      /// Pre-applies all cached device properties to the specified virtual controller, in the
+      /// order in which they were originally recorded. Intended to be invoked once per virtual
+      /// controller at creation time, so that an application re-applying the same properties on
+      /// every launch finds each value already in place. Does nothing if the device property
+      /// cache is not enabled in the configuration file.
+      /// @param [in,out] controller Virtual controller to which cached properties are applied.
+      void ApplyToController(VirtualController& controller);
+
+      /// Records an applied axis deadzone property in the device property cache. Does nothing if
+      /// the device property cache is not enabled in the configuration file or if the identical
+      /// value is already cached.
+      /// @param [in] controllerIdentifier Identifier of the affected virtual controller.
+      /// @param [in] axis Affected axis, or no value if the property applies to all axes.
+      /// @param [in] deadzone Deadzone value that was applied.
+      void RecordAxisDeadzone(
+          TControllerIdentifier controllerIdentifier, std::optional<EAxis> axis, uint32_t deadzone);
+
+      /// Records an applied axis range property in the device property cache. Does nothing if the
+      /// device property cache is not enabled in the configuration file or if the identical value
+      /// is already cached.
+      /// @param [in] controllerIdentifier Identifier of the affected virtual controller.
+      /// @param [in] axis Affected axis, or no value if the property applies to all axes.
+      /// @param [in] rangeMin Minimum range value that was applied.
+      /// @param [in] rangeMax Maximum range value that was applied.
+      void RecordAxisRange(
+          TControllerIdentifier controllerIdentifier,
+          std::optional<EAxis> axis,
+          int32_t rangeMin,
+          int32_t rangeMax);
+
+      /// Records an applied axis saturation property in the device property cache. Does nothing
+      /// if the device property cache is not enabled in the configuration file or if the
+      /// identical value is already cached.
+      /// @param [in] controllerIdentifier Identifier of the affected virtual controller.
+      /// @param [in] axis Affected axis, or no value if the property applies to all axes.
+      /// @param [in] saturation Saturation value that was applied.
+      void RecordAxisSaturation(
+          TControllerIdentifier controllerIdentifier,
+          std::optional<EAxis> axis,
+          uint32_t saturation);
+
+      /// Records an applied event buffer capacity property in the device property cache. Does
+      /// nothing if the device property cache is not enabled in the configuration file or if the
+      /// identical value is already cached.
+      /// @param [in] controllerIdentifier Identifier of the affected virtual controller.
+      /// @param [in] capacity Event buffer capacity that was applied.
+      void RecordEventBufferCapacity(TControllerIdentifier controllerIdentifier, uint32_t capacity);
+
+      /// Records an applied force feedback gain property in the device property cache. Does
+      /// nothing if the device property cache is not enabled in the configuration file or if the
+      /// identical value is already cached.
+      /// @param [in] controllerIdentifier Identifier of the affected virtual controller.
+      /// @param [in] ffGain Force feedback gain value that was applied.
+      void RecordForceFeedbackGain(TControllerIdentifier controllerIdentifier, uint32_t ffGain);
+    } // namespace DevicePropertyCache
+  } // namespace Controller
+} // namespace Xidi
@@ -0,0 +1,95 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file Diagnostics.h
+ *   Declaration of runtime health tracking for the input stack. Subsystems record liveness,
+ *   device connectivity, import resolution, and error events as they occur into cached atomics,
+ *   and the accumulated state is exposed externally through the #Api::IDiagnostics interface for
+ *   periodic polling by monitoring agents.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace Diagnostics
+  {
+    /// Enumerates the worker threads whose liveness is tracked. Enumerator order determines the
+    /// thread indexing of the snapshot exposed through the #Api::IDiagnostics interface, so
+    /// existing enumerators must not be reordered.
+    enum class EWorkerThread : unsigned int
+    {
+      /// Physical controller state polling thread.
+      StatePolling,
+
+      /// Force feedback actuation thread.
+      ForceFeedback,
+
+      /// Keyboard and mouse input dispatch thread.
+      InputDispatch,
+
+      /// Sentinel value. Total number of tracked worker threads.
+      Count,
+    };
+
+    /// Enumerates the import modules whose resolution status is tracked. Enumerator order
+    /// determines the module indexing of the snapshot exposed through the #Api::IDiagnostics
+    /// interface, so existing enumerators must not be reordered.
+    enum class EImportModule : unsigned int
+    {
+      /// WinMM joystick API import module.
+      WinMM,
+
+      /// DirectInput API import module.
+      DirectInput,
+
+      /// XInput API import module.
+      XInput,
+
+      /// Sentinel value. Total number of tracked import modules.
+      Count,
+    };
+
+    /// Records completion of one loop iteration of the specified worker thread. Intended to be
+    /// called once per loop pass, advancing the iteration counter and activity timestamp that
+    /// monitoring agents use to detect dead or hung threads and to compute loop rates.
+    /// @param [in] workerThread Worker thread that completed an iteration.
+    void RecordThreadHeartbeat(EWorkerThread workerThread);
+
+    /// Records a change in the connection status of the specified physical controller slot.
+    /// Intended to be called only on status transitions, which the polling loop already detects.
+    /// @param [in] controllerIdentifier Identifier of the physical controller whose status
+    /// changed.
+    /// @param [in] isConnected Whether the slot now reports a connected device.
+    void RecordControllerConnected(
+        Controller::TControllerIdentifier controllerIdentifier, bool isConnected);
+
+    /// Retrieves the current connected-controller bitmask, in which the bit at the position of a
+    /// physical controller identifier is set whenever that slot reports a connected device. The
+    /// mask is maintained by the polling loop on status transitions, so reading it is a single
+    /// relaxed atomic load and is safe to perform on any hot path, including per-frame presence
+    /// probes issued by applications.
+    /// @return Bitmask of currently-connected physical controller slots.
+    uint32_t GetConnectedControllerMask(void);
+
+    /// Records the outcome of an import module's function resolution attempt. A recorded success
+    /// is sticky: modules that import from multiple candidate libraries record one outcome per
+    /// attempt, and a failed attempt never downgrades a success recorded for another library.
+    /// @param [in] importModule Import module that attempted resolution.
+    /// @param [in] resolutionSucceeded Whether all required functions resolved successfully.
+    void RecordImportResolution(EImportModule importModule, bool resolutionSucceeded);
+
+    /// Records an unexpected input stack failure. Expected conditions, like state reads from
+    /// disconnected controllers, should not be recorded here.
+    /// @param [in] errorCode System error code describing the failure.
+    void RecordInputStackError(uint32_t errorCode);
+  } // namespace Diagnostics
+} // namespace Xidi
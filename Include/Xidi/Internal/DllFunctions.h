@@ -97,6 +97,15 @@ namespace Xidi
       void** ptr;
     };
 
+    /// Prebinds all registered forwarded functions by resolving their destination addresses in one
+    /// pass on a background thread. Resolution otherwise happens lazily, with the first application
+    /// call to any forwarded export paying for library loading and the entire resolution sweep.
+    /// Intended to be invoked during startup, after which no application call ever takes the slow
+    /// resolution path if the prebinding pass wins the race. Safe to invoke concurrently with
+    /// application calls to forwarded exports, and does nothing if no forwarded functions are
+    /// registered in this module.
+    void PrebindForwardedFunctions(void);
+
     /// Attempts to load the specified function from the specified library. Logs an error message on
     /// failure.
     /// @param [in] libraryPath Path of the library from which the import is being attempted. Used
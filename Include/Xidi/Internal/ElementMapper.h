@@ -27,6 +27,32 @@ namespace Xidi
 {
   namespace Controller
   {
+    /// Enumerates the concrete element mapper types that support direct, devirtualized dispatch.
+    /// Mappers report their type once when a #Mapper object compiles its flat mapping table, and
+    /// the state mapping hot path then dispatches on the type tag with direct calls instead of
+    /// per-element virtual calls. Types not enumerated here use the generic #Custom tag and are
+    /// dispatched virtually.
+    enum class EElementMapperType : uint8_t
+    {
+      /// Any element mapper type without direct dispatch support. Always dispatched virtually.
+      Custom,
+
+      /// Concrete type is #AxisMapper.
+      Axis,
+
+      /// Concrete type is #ButtonMapper.
+      Button,
+
+      /// Concrete type is #DigitalAxisMapper.
+      DigitalAxis,
+
+      /// Concrete type is #PovMapper.
+      Pov,
+
+      /// Sentinel value, total number of enumerators.
+      Count
+    };
+
     /// Interface for mapping an XInput controller element's state reading to an internal controller
     /// state data structure value. An instance of this object exists for each XInput controller
     /// element in a mapper.
@@ -36,6 +62,32 @@ namespace Xidi
 
       virtual ~IElementMapper(void) = default;
 
+      /// Routes element mapper allocations into the arena active on the calling thread, if any,
+      /// so that entire object graphs can be cloned into contiguous memory. See
+      /// #ElementMapperArena. Falls back to the default heap when no arena is active.
+      /// @param [in] numBytes Number of bytes to allocate.
+      /// @return Pointer to the allocated memory.
+      static void* operator new(size_t numBytes);
+
+      /// Releases memory previously obtained from the corresponding allocation operator. Memory
+      /// that came from an arena is reclaimed by the arena itself, so deallocating it here is a
+      /// no-op.
+      /// @param [in] ptr Pointer to the memory to release.
+      static void operator delete(void* ptr) noexcept;
+
+      /// Reports the concrete type of this element mapper for direct dispatch purposes. Invoked
+      /// once per element when a #Mapper object is constructed, never on the state mapping hot
+      /// path. Any subclass that overrides contribution behavior of a directly-dispatched type
+      /// must also override this method, returning either its own enumerator or
+      /// #EElementMapperType::Custom to fall back to virtual dispatch. Declared `constexpr`, as
+      /// are the overrides in the directly-dispatched concrete types, so the compile-time mapper
+      /// facility can identify element mapper types during constant evaluation.
+      /// @return Type tag identifying the concrete element mapper type.
+      virtual constexpr EElementMapperType GetType(void) const
+      {
+        return EElementMapperType::Custom;
+      }
+
       /// Allocates, constructs, and returns a pointer to a copy of this element mapper.
       /// @return Smart pointer to a copy of this element mapper.
       virtual std::unique_ptr<IElementMapper> Clone(void) const = 0;
@@ -111,7 +163,7 @@ namespace Xidi
 
       /// Retrieves and returns the axis to which this mapper should contribute.
       /// @return Target axis.
-      inline EAxis GetAxis(void) const
+      inline constexpr EAxis GetAxis(void) const
       {
         return axis;
       }
@@ -119,7 +171,7 @@ namespace Xidi
       /// Retrieves and returns the axis direction to which this mapper should contribute on its
       /// associated axis.
       /// @return Target axis direction.
-      inline EAxisDirection GetAxisDirection(void) const
+      inline constexpr EAxisDirection GetAxisDirection(void) const
       {
         return direction;
       }
@@ -141,6 +193,11 @@ namespace Xidi
       int GetTargetElementCount(void) const override;
       std::optional<SElementIdentifier> GetTargetElementAt(int index) const override;
 
+      constexpr EElementMapperType GetType(void) const override
+      {
+        return EElementMapperType::Axis;
+      }
+
     private:
 
       /// Identifies the axis to which this mapper should contribute in the internal
@@ -164,6 +221,13 @@ namespace Xidi
 
       inline constexpr ButtonMapper(EButton button) : IElementMapper(), button(button) {}
 
+      /// Retrieves and returns the button to which this mapper should contribute.
+      /// @return Target button.
+      inline constexpr EButton GetButton(void) const
+      {
+        return button;
+      }
+
       // IElementMapper
       std::unique_ptr<IElementMapper> Clone(void) const override;
       void ContributeFromAnalogValue(
@@ -181,6 +245,11 @@ namespace Xidi
       int GetTargetElementCount(void) const override;
       std::optional<SElementIdentifier> GetTargetElementAt(int index) const override;
 
+      constexpr EElementMapperType GetType(void) const override
+      {
+        return EElementMapperType::Button;
+      }
+
     private:
 
       /// Identifies the button to which this mapper should contribute in the internal
@@ -286,6 +355,11 @@ namespace Xidi
           SState& controllerState,
           uint8_t triggerValue,
           uint32_t sourceIdentifier = 0) const override;
+
+      constexpr EElementMapperType GetType(void) const override
+      {
+        return EElementMapperType::DigitalAxis;
+      }
     };
 
     /// Inverts the input reading from an XInput controller element and then forwards it to another
@@ -530,7 +604,7 @@ namespace Xidi
 
       /// Retrieves and returns the direction used for contributions.
       /// @return Target direction for positive contributions.
-      inline EPovDirection GetDirection(void) const
+      inline constexpr EPovDirection GetDirection(void) const
       {
         return povDirection;
       }
@@ -552,6 +626,11 @@ namespace Xidi
       int GetTargetElementCount(void) const override;
       std::optional<SElementIdentifier> GetTargetElementAt(int index) const override;
 
+      constexpr EElementMapperType GetType(void) const override
+      {
+        return EElementMapperType::Pov;
+      }
+
     private:
 
       /// Identifies the POV direction to which this mapper should contribute in the internal
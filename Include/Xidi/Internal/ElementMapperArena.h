@@ -0,0 +1,96 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file ElementMapperArena.h
+ *   Declaration of an arena allocator used to keep a mapper's entire element mapper object graph
+ *   in contiguous memory.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Xidi
+{
+  namespace Controller
+  {
+    /// Bump allocator that holds an entire element mapper object graph in contiguous memory.
+    /// Element mappers are immutable once a mapper object is built, but they are created
+    /// individually on the heap, so a single element can end up several pointer hops apart from
+    /// its neighbors. Cloning a finished object graph into an arena places all of its objects
+    /// back-to-back, which improves cache locality of the per-poll traversal.
+    ///
+    /// An arena is used by activating it on the calling thread, which routes all element mapper
+    /// allocations made on that thread into the arena for the duration of the activation scope.
+    /// Any element mapper clone or element map assignment performed under an active scope
+    /// therefore lands in the arena without the element mapper classes needing to know about it.
+    /// Objects allocated from an arena are freed all at once when the arena itself is destroyed,
+    /// which must happen only after all such objects have been destructed.
+    class ElementMapperArena
+    {
+    public:
+
+      /// RAII type that activates an arena on the calling thread for its own lifetime. Scopes
+      /// nest; destruction restores whichever arena was previously active.
+      class ActivationScope
+      {
+      public:
+
+        explicit ActivationScope(ElementMapperArena& arena);
+
+        ~ActivationScope(void);
+
+        ActivationScope(const ActivationScope& other) = delete;
+
+      private:
+
+        /// Arena that was active on this thread before this scope was entered, if any.
+        ElementMapperArena* previousActiveArena;
+      };
+
+      ElementMapperArena(void) = default;
+
+      ~ElementMapperArena(void);
+
+      ElementMapperArena(const ElementMapperArena& other) = delete;
+
+      /// Retrieves the arena currently active on the calling thread, if any.
+      /// @return Pointer to the active arena, or `nullptr` if no arena is active.
+      static ElementMapperArena* ActiveArena(void);
+
+      /// Allocates the specified number of bytes from this arena. Returned memory is aligned
+      /// suitably for any object type and remains valid until the arena is destroyed. Never
+      /// returns `nullptr`; allocation failure is fatal, same as a failed `new` expression.
+      /// @param [in] numBytes Number of bytes to allocate.
+      /// @return Pointer to the allocated memory.
+      void* Allocate(size_t numBytes);
+
+    private:
+
+      /// Number of payload bytes in the first chunk. Sized so that, in practice, an entire
+      /// element mapper object graph fits into a single contiguous chunk; additional chunks of
+      /// twice the previous size are appended only if it does not.
+      static constexpr size_t kFirstChunkCapacityBytes = 4096;
+
+      /// Backing memory chunks, each a contiguous block carved up by bump allocation. Only the
+      /// most recently appended chunk is allocated from.
+      std::vector<std::unique_ptr<std::byte[]>> chunks;
+
+      /// Capacity in bytes of the most recently appended chunk.
+      size_t currentChunkCapacity = 0;
+
+      /// Number of bytes already allocated from the most recently appended chunk.
+      size_t currentChunkUsed = 0;
+
+      /// Total capacity in bytes of all chunks, used for memory accounting on destruction.
+      size_t totalChunkCapacityBytes = 0;
+    };
+  } // namespace Controller
+} // namespace Xidi
@@ -0,0 +1,147 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file EventTrace.h
+ *   Declaration of manifest-free Event Tracing for Windows (ETW) instrumentation for hot-path
+ *   input pipeline events. Events are emitted using the TraceLogging API, so no manifest
+ *   registration is needed and external tools like Windows Performance Analyzer can correlate
+ *   input pipeline timing with other trace data. Every emission point begins with the provider
+ *   enabled check built into the TraceLogging macros, so when no trace session is listening the
+ *   cost is a single predictable branch.
+ **************************************************************************************************/
+
+#pragma once
+
+#include "ApiWindows.h"
+
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace EventTrace
+  {
+    TRACELOGGING_DECLARE_PROVIDER(kXidiTraceProvider);
+
+    /// Registers the trace provider with the operating system, enabling event delivery to any
+    /// interested trace sessions. Safe to call multiple times, but not safe to call from a DLL
+    /// entry point. Until this function is called all emission points are silent no-ops.
+    void RegisterProvider(void);
+
+    /// Emits an event marking the completion of one poll of a physical controller.
+    /// @param [in] controllerIdentifier Identifier of the physical controller that was polled.
+    /// @param [in] stateChanged Whether the poll detected a physical state change.
+    inline void PhysicalPollCompleted(
+        Controller::TControllerIdentifier controllerIdentifier, bool stateChanged)
+    {
+      TraceLoggingWrite(
+          kXidiTraceProvider,
+          "PhysicalPollCompleted",
+          TraceLoggingValue(controllerIdentifier, "controllerIdentifier"),
+          TraceLoggingValue(stateChanged, "stateChanged"));
+    }
+
+    /// Emits an event marking the completion of a virtual controller state refresh attempt.
+    /// @param [in] controllerIdentifier Identifier of the associated virtual controller.
+    /// @param [in] stateAccepted Whether the refresh resulted in a processed state change.
+    inline void VirtualControllerRefreshed(
+        Controller::TControllerIdentifier controllerIdentifier, bool stateAccepted)
+    {
+      TraceLoggingWrite(
+          kXidiTraceProvider,
+          "VirtualControllerRefreshed",
+          TraceLoggingValue(controllerIdentifier, "controllerIdentifier"),
+          TraceLoggingValue(stateAccepted, "stateAccepted"));
+    }
+
+    /// Emits an event marking the completion of one force feedback actuation write to physical
+    /// controller hardware.
+    /// @param [in] controllerIdentifier Identifier of the physical controller that was actuated.
+    /// @param [in] writeSucceeded Whether the vibration write was accepted by the hardware.
+    inline void ForceFeedbackActuated(
+        Controller::TControllerIdentifier controllerIdentifier, bool writeSucceeded)
+    {
+      TraceLoggingWrite(
+          kXidiTraceProvider,
+          "ForceFeedbackActuated",
+          TraceLoggingValue(controllerIdentifier, "controllerIdentifier"),
+          TraceLoggingValue(writeSucceeded, "writeSucceeded"));
+    }
+
+    /// Emits paired start and stop events bracketing one application call to the DirectInput
+    /// device state retrieval method. Implemented as a scope object so that every return path,
+    /// including early error returns, produces a balanced pair for activity analysis.
+    class ScopedDeviceStateTrace
+    {
+    public:
+
+      inline ScopedDeviceStateTrace(Controller::TControllerIdentifier controllerIdentifier)
+          : controllerIdentifier(controllerIdentifier)
+      {
+        TraceLoggingWrite(
+            kXidiTraceProvider,
+            "GetDeviceState",
+            TraceLoggingOpcode(WINEVENT_OPCODE_START),
+            TraceLoggingValue(controllerIdentifier, "controllerIdentifier"));
+      }
+
+      inline ~ScopedDeviceStateTrace(void)
+      {
+        TraceLoggingWrite(
+            kXidiTraceProvider,
+            "GetDeviceState",
+            TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+            TraceLoggingValue(controllerIdentifier, "controllerIdentifier"));
+      }
+
+      ScopedDeviceStateTrace(const ScopedDeviceStateTrace&) = delete;
+
+    private:
+
+      /// Identifier of the associated virtual controller, repeated in the stop event so the pair
+      /// can be matched without relying on activity identifiers.
+      const Controller::TControllerIdentifier controllerIdentifier;
+    };
+
+    /// Emits paired start and stop events bracketing one application call to the DirectInput
+    /// buffered data retrieval method. Implemented as a scope object so that every return path,
+    /// including early error returns, produces a balanced pair for activity analysis.
+    class ScopedDeviceDataTrace
+    {
+    public:
+
+      inline ScopedDeviceDataTrace(Controller::TControllerIdentifier controllerIdentifier)
+          : controllerIdentifier(controllerIdentifier)
+      {
+        TraceLoggingWrite(
+            kXidiTraceProvider,
+            "GetDeviceData",
+            TraceLoggingOpcode(WINEVENT_OPCODE_START),
+            TraceLoggingValue(controllerIdentifier, "controllerIdentifier"));
+      }
+
+      inline ~ScopedDeviceDataTrace(void)
+      {
+        TraceLoggingWrite(
+            kXidiTraceProvider,
+            "GetDeviceData",
+            TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+            TraceLoggingValue(controllerIdentifier, "controllerIdentifier"));
+      }
+
+      ScopedDeviceDataTrace(const ScopedDeviceDataTrace&) = delete;
+
+    private:
+
+      /// Identifier of the associated virtual controller, repeated in the stop event so the pair
+      /// can be matched without relying on activity identifiers.
+      const Controller::TControllerIdentifier controllerIdentifier;
+    };
+  } // namespace EventTrace
+} // namespace Xidi
@@ -0,0 +1,149 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file FlightRecorder.h
+ *   Declaration of an always-on in-memory flight recorder of recent input pipeline activity.
+ *   Recent events are written into a preallocated ring buffer using relaxed atomic operations,
+ *   so recording costs little more than a few plain stores. The ring lives in static storage
+ *   behind a magic header, so it survives into crash dumps and can be located there by searching
+ *   process memory for the magic value, giving post-mortem visibility into what the input
+ *   pipeline was doing in the moments before a crash or hang.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Xidi
+{
+  namespace FlightRecorder
+  {
+    /// Enumerates the types of events that can be recorded. Underlying values appear verbatim in
+    /// crash dumps and are parsed by post-mortem tooling, so existing enumerators must never be
+    /// renumbered and new enumerators must only ever be appended.
+    enum class EEvent : uint32_t
+    {
+      /// No event. Identifies record slots that have never been written.
+      None = 0,
+
+      /// Application acquired a DirectInput device. First parameter is the virtual controller
+      /// identifier, and second parameter is the cooperative level.
+      DeviceAcquire = 1,
+
+      /// Application unacquired a DirectInput device. First parameter is the virtual controller
+      /// identifier.
+      DeviceUnacquire = 2,
+
+      /// Application requested an instantaneous device state snapshot. First parameter is the
+      /// virtual controller identifier, and second parameter is the supplied buffer size in
+      /// bytes.
+      DeviceGetDeviceState = 3,
+
+      /// Application requested buffered device events. First parameter is the virtual controller
+      /// identifier, second parameter is the requested event count, and third parameter is the
+      /// flags value.
+      DeviceGetDeviceData = 4,
+
+      /// Application set a device property. First parameter is the virtual controller
+      /// identifier, and second parameter is the first 32 bits of the property GUID.
+      DeviceSetProperty = 5,
+
+      /// Physical controller poll detected a state change. First parameter is the physical
+      /// controller identifier, and second parameter is the device status after the poll.
+      PhysicalStateChange = 6,
+
+      /// Physical controller device status changed. First parameter is the physical controller
+      /// identifier, second parameter is the old status, and third parameter is the new status.
+      PhysicalStatusChange = 7,
+
+      /// Virtual controller registered with a physical controller for force feedback, which
+      /// involves acquiring the physical controller's force feedback lock. First parameter is
+      /// the physical controller identifier.
+      ForceFeedbackRegister = 8,
+
+      /// Virtual controller unregistered with a physical controller for force feedback, which
+      /// involves acquiring the physical controller's force feedback lock. First parameter is
+      /// the physical controller identifier.
+      ForceFeedbackUnregister = 9,
+    };
+
+    /// Single flight recorder entry. The sequence number is written last with release semantics,
+    /// so a record whose sequence number is consistent with its position in the ring was fully
+    /// written, and post-mortem tooling can discard records that were mid-write at crash time.
+    struct SRecord
+    {
+      /// Global sequence number of this record, starting at 1, or 0 if the slot has never been
+      /// written.
+      std::atomic<uint32_t> sequence;
+
+      /// Identifier of the thread that recorded this event.
+      uint32_t threadId;
+
+      /// Tick count at recording time, in milliseconds since system start.
+      uint64_t timestamp;
+
+      /// Type of event recorded.
+      EEvent event;
+
+      /// Event parameters, with meanings determined by the event type.
+      uint32_t param1;
+      uint32_t param2;
+      uint32_t param3;
+    };
+
+    static_assert(
+        32 == sizeof(SRecord), "Flight record layout is parsed by post-mortem tooling.");
+
+    /// Number of records in the flight recorder ring. Must be a power of 2.
+    inline constexpr uint32_t kRecordCapacity = 1024;
+
+    /// Magic value that identifies the flight recorder area in a crash dump. Exactly fills the
+    /// magic field, including its terminating null character.
+    inline constexpr char kRecordAreaMagic[16] = "XidiFlightRec01";
+
+    /// Flight recorder storage area. Preallocated in static storage so that it is present in
+    /// crash dumps, and located there by searching process memory for the magic value. Fixed
+    /// fields describe the layout so that tooling does not need to match this header revision
+    /// exactly.
+    struct SRecordArea
+    {
+      /// Magic value, equal to #kRecordAreaMagic.
+      char magic[16];
+
+      /// Layout version, incremented whenever the record or area layout changes.
+      uint32_t version;
+
+      /// Size of a single record, in bytes.
+      uint32_t recordSizeBytes;
+
+      /// Number of records in the ring.
+      uint32_t recordCapacity;
+
+      /// Number of records ever written. The next record goes into slot
+      /// (sequence number - 1) modulo the capacity, so the most recent records are those with
+      /// the highest sequence numbers.
+      std::atomic<uint32_t> numRecordsWritten;
+
+      /// Ring of recent records.
+      SRecord records[kRecordCapacity];
+    };
+
+    /// Records an event into the flight recorder ring, overwriting the oldest record once the
+    /// ring is full. Safe to call concurrently from any thread, and never blocks.
+    /// @param [in] event Type of event to record.
+    /// @param [in] param1 First event parameter, with meaning determined by the event type.
+    /// @param [in] param2 Second event parameter, with meaning determined by the event type.
+    /// @param [in] param3 Third event parameter, with meaning determined by the event type.
+    void Record(EEvent event, uint32_t param1 = 0, uint32_t param2 = 0, uint32_t param3 = 0);
+
+    /// Retrieves read-only access to the flight recorder storage area, for use by diagnostic
+    /// code and tests. Post-mortem tooling locates the same area by magic value instead.
+    /// @return Read-only reference to the flight recorder storage area.
+    const SRecordArea& GetRecordArea(void);
+  } // namespace FlightRecorder
+} // namespace Xidi
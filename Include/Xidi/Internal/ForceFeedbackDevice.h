@@ -12,10 +12,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <shared_mutex>
 
+#include "ApiWindows.h"
 #include "ForceFeedbackEffect.h"
 #include "ForceFeedbackTypes.h"
 
@@ -39,8 +42,12 @@ namespace Xidi
         /// Describes an effect that is currently playing.
         struct SEffectData
         {
-          /// Effect object, which defines the force magnitude at any given time.
-          std::unique_ptr<Effect> effect;
+          /// Effect object, which defines the force magnitude at any given time. Held with shared
+          /// ownership because playback passes capture a snapshot reference and compute magnitudes
+          /// outside the registry lock. Parameter updates publish a replacement effect object
+          /// rather than modifying this one in place, so any object reachable through a snapshot
+          /// is never mutated.
+          std::shared_ptr<Effect> effect;
 
           /// Relative timestamp in milliseconds at which the effect started playing.
           TEffectTimeMs startTime;
@@ -70,6 +77,9 @@ namespace Xidi
           playingEffects.clear();
           stateEffectsAreMuted = false;
           stateEffectsArePaused = false;
+
+          for (auto& statusSlot : effectStatusMirror)
+            statusSlot.status.store(EEffectStatus::NotOnDevice, std::memory_order_relaxed);
         }
 
         /// Retrieves and returns the number of effects that exist in the device buffer and are
@@ -119,20 +129,38 @@ namespace Xidi
           return (0 != GetCountPlayingEffects());
         }
 
-        /// Determines if the identified effect is loaded into the device buffer.
+        /// Determines if the identified effect is loaded into the device buffer. Reads the effect
+        /// status mirror, so this query is lock-free and never contends with the actuation loop.
         /// @param [in] id Identifier of the effect of interest.
         /// @return `true` if so, `false` if not.
         inline bool IsEffectOnDevice(TEffectIdentifier id)
         {
-          std::shared_lock lock(mutex);
-          return (readyEffects.contains(id) || playingEffects.contains(id));
+          return (EEffectStatus::NotOnDevice != EffectStatusMirrorRead(id));
         }
 
         /// Determines if the identified effect is loaded into the device buffer and currently
-        /// playing.
+        /// playing. Effects in their start delay period are not considered playing. Reads the
+        /// effect status mirror, so this query is lock-free and never contends with the actuation
+        /// loop.
         /// @param [in] id Identifier of the effect of interest.
         /// @return `true` if so, `false` if not.
-        bool IsEffectPlaying(TEffectIdentifier id);
+        inline bool IsEffectPlaying(TEffectIdentifier id)
+        {
+          return (EEffectStatus::Playing == EffectStatusMirrorRead(id));
+        }
+
+        /// Determines how long the actuation thread can wait before this device next requires an
+        /// actuation pass. Officially playing effects produce continuous output and so require
+        /// every periodic pass, but effects that are all waiting out their start delays cannot
+        /// change the output until the earliest of their scheduled start transitions, and an empty
+        /// playback schedule requires no passes at all.
+        /// @param [in] timestamp Effective relative timestamp for the query. Generally should not
+        /// be passed (which would mean use the current time), but exposed for testing.
+        /// @return No value if no effects are playing, zero if a pass is required at the normal
+        /// actuation period, or otherwise the number of milliseconds until the earliest scheduled
+        /// effect start transition.
+        std::optional<TEffectTimeMs> MillisecondsUntilNextEffectTransition(
+            std::optional<TEffectTimeMs> timestamp = std::nullopt);
 
         /// Computes the magnitude components for all of the effects that are currently playing.
         /// Any effects that are completed are automatically stopped.
@@ -152,6 +180,17 @@ namespace Xidi
           stateEffectsAreMuted = muted;
         }
 
+        /// Registers an event to be signaled whenever an effect starts playing on this device.
+        /// Allows the actuation thread to block indefinitely while no effects are playing anywhere
+        /// without missing the start of playback. Passing `NULL` disables the notification.
+        /// @param [in] eventHandle Handle of the event to signal, which the caller continues to
+        /// own.
+        inline void SetPlaybackActivityNotificationEvent(HANDLE eventHandle)
+        {
+          std::unique_lock lock(mutex);
+          playbackActivityNotificationEvent = eventHandle;
+        }
+
         /// Sets the force feedback system's paused state.
         /// In paused state the effects do not play and their clocks do not advance towards their
         /// duration.
@@ -194,6 +233,46 @@ namespace Xidi
 
       private:
 
+        /// Enumerates the per-effect states tracked by the effect status mirror.
+        enum class EEffectStatus : uint8_t
+        {
+          /// Effect does not exist in the device buffer.
+          NotOnDevice,
+
+          /// Effect exists in the device buffer but is not playing.
+          Downloaded,
+
+          /// Effect has been started but its start delay period has not yet elapsed.
+          PendingStart,
+
+          /// Effect is officially playing.
+          Playing,
+        };
+
+        /// One entry of the effect status mirror. The identifier is meaningful only while the
+        /// status indicates the effect is on the device; a vacated slot keeps its stale identifier
+        /// until it is recycled for another effect.
+        struct SEffectStatusSlot
+        {
+          /// Identifier of the effect occupying this slot.
+          std::atomic<TEffectIdentifier> id;
+
+          /// Mirrored status of the effect occupying this slot.
+          std::atomic<EEffectStatus> status;
+        };
+
+        /// Reads the mirrored status of the identified effect without taking any locks.
+        /// @param [in] id Identifier of the effect of interest.
+        /// @return Mirrored status, or not-on-device if the effect has no slot.
+        EEffectStatus EffectStatusMirrorRead(TEffectIdentifier id);
+
+        /// Publishes a status for the identified effect into the effect status mirror, claiming a
+        /// vacant slot if the effect does not already occupy one. Must only be called while the
+        /// mutex is held exclusively, which serializes all mirror writers.
+        /// @param [in] id Identifier of the effect of interest.
+        /// @param [in] newStatus Status to publish for the effect.
+        void EffectStatusMirrorWrite(TEffectIdentifier id, EEffectStatus newStatus);
+
         /// Enforces proper concurrency control for this object.
         std::shared_mutex mutex;
 
@@ -218,6 +297,16 @@ namespace Xidi
 
         /// Caches the relative timestamp of the last playback operation.
         TEffectTimeMs timestampRelativeLastPlay;
+
+        /// Handle of an event to be signaled whenever an effect starts playing, or `NULL` if no
+        /// such notification is registered.
+        HANDLE playbackActivityNotificationEvent;
+
+        /// Lock-free mirror of per-effect download and playback status. Maintained by the
+        /// state-mutating methods while they hold the mutex exclusively and read without any
+        /// locking by the status query methods, so an application polling effect status every
+        /// frame never contends with the actuation loop for the mutex.
+        SEffectStatusSlot effectStatusMirror[kEffectMaxCount];
       };
     } // namespace ForceFeedback
   }   // namespace Controller
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <optional>
 
@@ -34,6 +36,19 @@ namespace Xidi
 
         virtual ~Effect(void) = default;
 
+        /// Routes effect object allocations through a recycling fixed-size block pool so that the
+        /// effect download and update paths, which applications exercise mid-frame, produce no
+        /// default heap allocator traffic at steady state. Requests too large for a pool block
+        /// fall back to the default heap.
+        /// @param [in] numBytes Number of bytes to allocate.
+        /// @return Pointer to the allocated memory.
+        static void* operator new(size_t numBytes);
+
+        /// Releases memory previously obtained from the corresponding allocation operator. Memory
+        /// that came from the pool is returned to it for reuse by a future effect allocation.
+        /// @param [in] ptr Pointer to the memory to release.
+        static void operator delete(void* ptr) noexcept;
+
         /// Allocates, constructs, and returns a pointer to a copy of this force feedback effect.
         /// @return Smart pointer to a copy of this force feedback effect.
         virtual std::unique_ptr<Effect> Clone(void) const = 0;
@@ -56,6 +71,7 @@ namespace Xidi
         inline void ClearEnvelope(void)
         {
           commonParameters.envelope = std::nullopt;
+          RefreshEnvelopeRuntime();
         }
 
         /// Retrieves and returns a read-only reference to the entire common parameters record
@@ -254,6 +270,16 @@ namespace Xidi
           return orderedMagnitudeComponents;
         }
 
+        /// Resets all of this effect's parameters, both common and type-specific, back to the
+        /// defaults a newly-constructed effect of the same type would have. The effect's
+        /// identifier is unaffected.
+        inline void ResetAllParameters(void)
+        {
+          commonParameters = SCommonParameters();
+          RefreshEnvelopeRuntime();
+          ResetTypeSpecificParameters();
+        }
+
         /// Updates this effect's associated axes.
         /// @param [in] newValue New parameter value.
         /// @return `true` if successful, `false` otherwise. This method will fail if the new
@@ -279,6 +305,7 @@ namespace Xidi
           if (newValue > 0)
           {
             commonParameters.duration = newValue;
+            RefreshEnvelopeRuntime();
             return true;
           }
 
@@ -338,6 +365,7 @@ namespace Xidi
             return false;
 
           commonParameters.envelope = newValue;
+          RefreshEnvelopeRuntime();
           return true;
         }
 
@@ -352,6 +380,7 @@ namespace Xidi
           if (other.id == id)
           {
             commonParameters = other.commonParameters;
+            RefreshEnvelopeRuntime();
             SyncTypeSpecificParametersFrom(other);
             return true;
           }
@@ -383,6 +412,12 @@ namespace Xidi
           return true;
         }
 
+        /// Resets any type-specific parameters back to their newly-constructed default state. The
+        /// default implementation does nothing because no type-specific parameters exist in the
+        /// base case. Subclasses that define their own type-specific parameters should override
+        /// this method.
+        virtual void ResetTypeSpecificParameters(void) {}
+
         /// Synchronizes the type-specific parameters in this effect with those in the supplied
         /// source effect. This is accomplished by copying the parameter values from the source
         /// effect. The default implementation does nothing, but subclasses that use type-specific
@@ -393,6 +428,70 @@ namespace Xidi
 
       private:
 
+        /// Derived envelope evaluation state. The envelope's shape is fixed once parameters are
+        /// set, so the breakpoint times and reciprocals of the attack and fade times are computed
+        /// once when parameters change. This makes per-sample envelope evaluation a
+        /// compare-and-multiply, with no divisions or optional accesses on the magnitude
+        /// computation path.
+        struct SEnvelopeRuntime
+        {
+          /// Whether an envelope parameter is present. If not, the other fields are meaningless
+          /// and envelope transformation is a passthrough.
+          bool isActive;
+
+          /// Time at which the attack region ends, equal to the envelope's attack time.
+          TEffectTimeMs attackEndTime;
+
+          /// Time at which the fade region begins, equal to the effect's duration less the
+          /// envelope's fade time. Equal to the maximum representable time if the effect has no
+          /// fade region.
+          TEffectTimeMs fadeStartTime;
+
+          /// Attack level, copied from the envelope.
+          TEffectValue attackLevel;
+
+          /// Fade level, copied from the envelope.
+          TEffectValue fadeLevel;
+
+          /// Reciprocal of the envelope's attack time. Unused if the attack time is zero because
+          /// in that case the attack region is empty.
+          TEffectValue attackTimeReciprocal;
+
+          /// Reciprocal of the envelope's fade time. Unused if the fade time is zero because in
+          /// that case the fade region is empty.
+          TEffectValue fadeTimeReciprocal;
+        };
+
+        /// Rebuilds the derived envelope evaluation state from the envelope and duration
+        /// parameters. Must be invoked whenever either of those parameters changes.
+        inline void RefreshEnvelopeRuntime(void)
+        {
+          if (false == commonParameters.envelope.has_value())
+          {
+            envelopeRuntime = {};
+            return;
+          }
+
+          const SEnvelope& envelope = commonParameters.envelope.value();
+
+          envelopeRuntime.isActive = true;
+          envelopeRuntime.attackEndTime = envelope.attackTime;
+          envelopeRuntime.attackLevel = envelope.attackLevel;
+          envelopeRuntime.fadeLevel = envelope.fadeLevel;
+          envelopeRuntime.attackTimeReciprocal = (0 == envelope.attackTime)
+              ? 0
+              : ((TEffectValue)1 / (TEffectValue)envelope.attackTime);
+          envelopeRuntime.fadeTimeReciprocal = (0 == envelope.fadeTime)
+              ? 0
+              : ((TEffectValue)1 / (TEffectValue)envelope.fadeTime);
+
+          if ((true == commonParameters.duration.has_value()) &&
+              (envelope.fadeTime <= commonParameters.duration.value()))
+            envelopeRuntime.fadeStartTime = commonParameters.duration.value() - envelope.fadeTime;
+          else
+            envelopeRuntime.fadeStartTime = std::numeric_limits<TEffectTimeMs>::max();
+        }
+
         /// Effect identifier.
         /// Effect objects of the same type can exist in multiple instances based on the
         /// idea of an effect object existing both in software and in a physical device
@@ -405,6 +504,10 @@ namespace Xidi
 
         /// Holds parameters common to all effects.
         SCommonParameters commonParameters;
+
+        /// Holds derived envelope evaluation state, kept synchronized with the envelope and
+        /// duration parameters.
+        SEnvelopeRuntime envelopeRuntime;
       };
 
       /// Intermediate abstract class for all effects that define their own type-specific
@@ -502,6 +605,13 @@ namespace Xidi
           return typeSpecificParameters.has_value();
         }
 
+        /// Default implementation of resetting type-specific parameters, which restores the
+        /// newly-constructed state of having no type-specific parameters at all.
+        void ResetTypeSpecificParameters(void) override
+        {
+          ClearTypeSpecificParameters();
+        }
+
         /// Default implementation of synchronizing type-specific parameters from the
         /// supplied source. No error checking is required here because the superclass takes
         /// care of that.
@@ -148,6 +148,13 @@ namespace Xidi
 
       private:
 
+        /// Rebuilds the precomputed per-axis unit coefficients from the coordinate
+        /// representations. Must be invoked whenever the direction changes. Precomputing the
+        /// coefficients means that computing magnitude components, which happens once per playing
+        /// effect on every actuation pass, is a single multiply per axis with no trigonometry and
+        /// no per-mode branching.
+        void RefreshUnitCoefficients(void);
+
         /// Number of axes represented by this direction vector.
         int numAxes;
 
@@ -177,6 +184,12 @@ namespace Xidi
         /// one axis is present and with certain specific values when only one axis is
         /// present.
         std::array<TEffectValue, kEffectAxesMaximumNumber - 1> spherical;
+
+        /// Precomputed projection of a unit-magnitude force onto each axis, canonical across all
+        /// of the coordinate systems a direction can be submitted in. Kept synchronized with the
+        /// coordinate representations, which are themselves retained solely for parameter
+        /// retrieval round-trips.
+        TMagnitudeComponents unitCoefficients;
       };
 
       /// Structure for representing an envelope that might be applied to an effect.
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 
@@ -23,15 +25,158 @@ namespace Xidi
 {
   namespace Globals
   {
+    /// Plain-old-data snapshot of the settings in the "Properties" section of the configuration
+    /// file that are consulted by steady-state input processing code. Compiled once from the
+    /// configuration data so that hot paths read struct members directly instead of repeating
+    /// string-keyed configuration lookups. Values that are only ever consumed in a derived form
+    /// are stored pre-derived.
+    struct SPropertiesSettings
+    {
+      /// Fraction of the maximum possible amount of circle-to-square field-of-motion correction
+      /// to apply to the left analog stick.
+      double circleToSquareFractionStickLeft;
+
+      /// Fraction of the maximum possible amount of circle-to-square field-of-motion correction
+      /// to apply to the right analog stick.
+      double circleToSquareFractionStickRight;
+
+      /// Scaling factor applied to the final force feedback effect values sent to controller
+      /// hardware.
+      double forceFeedbackEffectStrengthScalingFactor;
+
+      /// Extra deadzone to apply to the left analog stick, as a percentage of the analog range.
+      unsigned int deadzonePercentStickLeft;
+
+      /// Extra deadzone to apply to the right analog stick, as a percentage of the analog range.
+      unsigned int deadzonePercentStickRight;
+
+      /// Extra deadzone to apply to the left analog trigger, as a percentage of the analog range.
+      unsigned int deadzonePercentTriggerLT;
+
+      /// Extra deadzone to apply to the right analog trigger, as a percentage of the analog range.
+      unsigned int deadzonePercentTriggerRT;
+
+      /// Whether the left analog stick's deadzone and saturation are applied radially, as a
+      /// transformation of the two-dimensional stick vector's magnitude, rather than per axis.
+      bool radialDeadzoneStickLeft;
+
+      /// Whether the right analog stick's deadzone and saturation are applied radially, as a
+      /// transformation of the two-dimensional stick vector's magnitude, rather than per axis.
+      bool radialDeadzoneStickRight;
+
+      /// Extra saturation to apply to the left analog stick, as a percentage of the analog range.
+      unsigned int saturationPercentStickLeft;
+
+      /// Extra saturation to apply to the right analog stick, as a percentage of the analog range.
+      unsigned int saturationPercentStickRight;
+
+      /// Extra saturation to apply to the left analog trigger, as a percentage of the analog
+      /// range.
+      unsigned int saturationPercentTriggerLT;
+
+      /// Extra saturation to apply to the right analog trigger, as a percentage of the analog
+      /// range.
+      unsigned int saturationPercentTriggerRT;
+
+      /// Mouse speed scaling factor, expressed as a percentage of the default mouse speed.
+      unsigned int mouseSpeedScalingFactorPercent;
+
+      /// Number of buffered events that must accumulate before an application-registered state
+      /// change notification event is signalled.
+      uint32_t stateChangeEventSignalingWatermark;
+
+      /// Whether near-overflow coalescing of buffered state change events is enabled, whereby
+      /// successive axis and POV events for the same controller element are merged once a
+      /// buffer's occupancy passes a high-water mark.
+      bool stateChangeEventCoalescing;
+
+      /// Whether built-in properties like deadzone and saturation are applied on behalf of
+      /// interfaces that do not normally allow for application-supplied customization.
+      bool useBuiltinProperties;
+    };
+
     /// Determines if this process has input focus based on whether or not a window it owns is at
-    /// the foreground.
+    /// the foreground. Normally answered from a cached flag kept current by a foreground change
+    /// hook, so the common case is a single atomic load; if the hook cannot be installed the
+    /// system is queried directly instead.
     /// @return `true` if so, `false` if not.
     bool DoesCurrentProcessHaveInputFocus(void);
 
-    /// Retrieves the configuration object that represents the data read from a configuration file.
+    /// Retrieves the configuration object that represents the data read from a configuration
+    /// file. A configuration hot reload replaces the published object wholesale, so callers that
+    /// want to observe changes should call this function each time rather than caching the
+    /// reference. Superseded objects are nevertheless kept alive, so previously-obtained
+    /// references never dangle.
     /// @return Read-only configuration object reference.
     const Infra::Configuration::ConfigurationData& GetConfigurationData(void);
 
+    /// Retrieves the current configuration generation number, which starts at zero and is
+    /// incremented each time a configuration hot reload publishes a new settings snapshot.
+    /// Consumers that cache data derived from the configuration can compare against this value to
+    /// detect that their cached data is stale.
+    /// @return Current configuration generation number.
+    unsigned int GetConfigurationGeneration(void);
+
+    /// Determines which configuration section name applies to the current application for the
+    /// specified base section name. If the configuration data contains a per-application profile
+    /// section for the current executable (for example, "Properties:Game.exe"), that section
+    /// name is returned and the profile section takes precedence in its entirety over the
+    /// like-named global section; otherwise the base section name is returned unchanged.
+    /// @param [in] configurationSection Base configuration section name.
+    /// @return Section name to use when looking up settings in the configuration data.
+    std::wstring_view ApplicableConfigurationSection(std::wstring_view configurationSection);
+
+    /// Retrieves a precompiled snapshot of the settings in the "Properties" section of the
+    /// configuration file. The snapshot is recompiled whenever a configuration hot reload
+    /// publishes new settings, so per-use callers see updated values; otherwise the cost of a
+    /// call is a pair of atomic loads. As with the configuration data itself, superseded
+    /// snapshots are kept alive, so previously-obtained references never dangle.
+    /// @return Read-only settings snapshot reference.
+    const SPropertiesSettings& GetPropertiesSettings(void);
+
+    /// Applies the configured scheduling attributes for one of Xidi's worker threads to the
+    /// calling thread, and is therefore intended to be called at the top of each worker thread
+    /// procedure. Settings are read from the "WorkerThreads" section of the configuration file,
+    /// and for both the priority and the affinity mask a value of 0, the default, leaves the
+    /// corresponding attribute unchanged.
+    /// @param [in] prioritySettingName Name of the configuration setting holding the Windows
+    /// thread priority value to apply.
+    /// @param [in] affinitySettingName Name of the configuration setting holding the processor
+    /// affinity mask to apply.
+    void ApplyWorkerThreadAttributes(
+        std::wstring_view prioritySettingName, std::wstring_view affinitySettingName);
+
+    /// Type of a one-shot unit of work deferred to the background task scheduler. Tasks run on
+    /// a small shared pool of low-priority worker threads, so submitting work is much cheaper
+    /// than spawning a thread, but tasks must not block indefinitely lest they starve the pool.
+    using TBackgroundTask = std::function<void(void)>;
+
+    /// Type of a periodic unit of work deferred to the background task scheduler. Returns
+    /// `true` to be scheduled again one period later or `false` to stop recurring.
+    using TPeriodicBackgroundTask = std::function<bool(void)>;
+
+    /// Submits a one-shot task to the process-wide background task scheduler. The task becomes
+    /// eligible to run once the specified delay has elapsed and runs exactly once. Worker
+    /// threads are started lazily on first submission. Concurrency-safe.
+    /// @param [in] task Task to run.
+    /// @param [in] delayMilliseconds Minimum delay before the task becomes eligible to run.
+    /// Defaults to no delay.
+    void SubmitBackgroundTask(TBackgroundTask task, unsigned int delayMilliseconds = 0);
+
+    /// Submits a periodic task to the process-wide background task scheduler. The task first
+    /// runs one period after submission and then repeats every period for as long as it keeps
+    /// returning `true`. Periods are measured between the end of one run and the start of the
+    /// next, so a slow task does not pile up behind itself. Concurrency-safe.
+    /// @param [in] task Task to run.
+    /// @param [in] periodMilliseconds Interval between successive runs of the task.
+    void SubmitPeriodicBackgroundTask(
+        TPeriodicBackgroundTask task, unsigned int periodMilliseconds);
+
+    /// Blocks until every one-shot background task submitted before this call, including those
+    /// whose delay has not yet elapsed, has run to completion. Periodic tasks are unaffected.
+    /// Intended for shutdown paths that must not lose deferred work. Concurrency-safe.
+    void DrainBackgroundTasks(void);
+
     /// Performs run-time initialization.
     /// This function only performs operations that are safe to perform within a DLL entry point.
     void Initialize(void);
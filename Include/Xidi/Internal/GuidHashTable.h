@@ -0,0 +1,236 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file GuidHashTable.h
+ *   Declaration and implementation of open-addressing hash containers keyed by GUID. These are
+ *   intended for the small, known key populations that arise during device enumeration and force
+ *   feedback effect recognition, where the pointer-chasing of standard node-based hash containers
+ *   costs more than it buys. All elements are stored inline in a single flat allocation and
+ *   located by linear probing, so lookups touch at most a few adjacent cache lines. Erasure of
+ *   individual elements is deliberately unsupported, which avoids any need for tombstones; the
+ *   containers can only grow or be cleared in their entirety.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "ApiGUID.h"
+#include "ApiWindows.h"
+
+namespace Xidi
+{
+  /// Open-addressing hash map keyed by GUID. Capacity is always a power of two and the load
+  /// factor is kept at or below one half, so probe sequences stay short even as keys are added.
+  /// @tparam ValueType Type of value associated with each GUID key. Must be default-constructible
+  /// and movable.
+  template <typename ValueType> class GuidHashMap
+  {
+  public:
+
+    GuidHashMap(void) : GuidHashMap(kDefaultExpectedKeyCount) {}
+
+    /// Allows the caller to size the table up front for a key population known in advance, so
+    /// that no rehashing occurs while it is being filled.
+    /// @param [in] expectedKeyCount Expected number of keys the table will hold.
+    explicit GuidHashMap(size_t expectedKeyCount)
+        : slots(CapacityForExpectedKeyCount(expectedKeyCount)), numElements(0)
+    {}
+
+    GuidHashMap(std::initializer_list<std::pair<GUID, ValueType>> initialContents)
+        : GuidHashMap(initialContents.size())
+    {
+      for (const auto& initialElement : initialContents)
+        InsertOrAssign(initialElement.first, ValueType(initialElement.second));
+    }
+
+    /// Removes all elements from this map. Capacity is retained.
+    void Clear(void)
+    {
+      for (auto& slot : slots)
+      {
+        if (true == slot.occupied)
+        {
+          slot.value = ValueType();
+          slot.occupied = false;
+        }
+      }
+
+      numElements = 0;
+    }
+
+    /// Determines if this map contains the specified key.
+    /// @param [in] key GUID key for which to search.
+    /// @return `true` if an element with the specified key exists, `false` otherwise.
+    bool Contains(REFGUID key) const
+    {
+      return (nullptr != Find(key));
+    }
+
+    /// Searches this map for an element with the specified key.
+    /// @param [in] key GUID key for which to search.
+    /// @return Pointer to the associated value if an element with the specified key exists,
+    /// `nullptr` otherwise. The pointer is invalidated by any subsequent insertion.
+    const ValueType* Find(REFGUID key) const
+    {
+      const size_t capacityMask = slots.size() - 1;
+
+      for (size_t slotIndex = std::hash<GUID>()(key) & capacityMask;;
+           slotIndex = (slotIndex + 1) & capacityMask)
+      {
+        const SSlot& slot = slots[slotIndex];
+        if (false == slot.occupied) return nullptr;
+        if (true == std::equal_to<GUID>()(slot.key, key)) return &slot.value;
+      }
+    }
+
+    ValueType* Find(REFGUID key)
+    {
+      return const_cast<ValueType*>(static_cast<const GuidHashMap*>(this)->Find(key));
+    }
+
+    /// Inserts an element with the specified key, replacing the associated value if an element
+    /// with that key already exists.
+    /// @param [in] key GUID key of the element to insert.
+    /// @param [in] value Value to associate with the key.
+    /// @return `true` if a new element was inserted, `false` if the value of an existing element
+    /// was replaced.
+    bool InsertOrAssign(REFGUID key, ValueType value)
+    {
+      if (((1 + numElements) * 2) > slots.size()) GrowAndRehash();
+
+      const size_t capacityMask = slots.size() - 1;
+
+      for (size_t slotIndex = std::hash<GUID>()(key) & capacityMask;;
+           slotIndex = (slotIndex + 1) & capacityMask)
+      {
+        SSlot& slot = slots[slotIndex];
+
+        if (false == slot.occupied)
+        {
+          slot.key = key;
+          slot.value = std::move(value);
+          slot.occupied = true;
+          numElements += 1;
+          return true;
+        }
+
+        if (true == std::equal_to<GUID>()(slot.key, key))
+        {
+          slot.value = std::move(value);
+          return false;
+        }
+      }
+    }
+
+    /// Retrieves the number of elements held by this map.
+    /// @return Number of elements held by this map.
+    size_t Size(void) const
+    {
+      return numElements;
+    }
+
+  private:
+
+    /// Single element slot. Occupancy is tracked explicitly so that every possible GUID value,
+    /// including the null GUID, is usable as a key.
+    struct SSlot
+    {
+      /// GUID key of the element held in this slot.
+      GUID key;
+
+      /// Value of the element held in this slot.
+      ValueType value;
+
+      /// Whether or not this slot holds an element.
+      bool occupied;
+    };
+
+    /// Expected key count used when none is supplied at construction time.
+    static constexpr size_t kDefaultExpectedKeyCount = 8;
+
+    /// Computes the slot count needed to hold the specified number of keys at no more than half
+    /// load: the smallest power of two that is at least twice the expected key count.
+    /// @param [in] expectedKeyCount Expected number of keys the table will hold.
+    /// @return Number of slots to allocate.
+    static constexpr size_t CapacityForExpectedKeyCount(size_t expectedKeyCount)
+    {
+      size_t capacity = 2 * kDefaultExpectedKeyCount;
+      while (capacity < (2 * expectedKeyCount))
+        capacity *= 2;
+      return capacity;
+    }
+
+    /// Doubles the capacity of this map and redistributes all existing elements into the larger
+    /// slot array.
+    void GrowAndRehash(void)
+    {
+      std::vector<SSlot> oldSlots(2 * slots.size());
+      oldSlots.swap(slots);
+      numElements = 0;
+
+      for (auto& oldSlot : oldSlots)
+        if (true == oldSlot.occupied) InsertOrAssign(oldSlot.key, std::move(oldSlot.value));
+    }
+
+    /// Flat slot storage. Size is always a power of two.
+    std::vector<SSlot> slots;
+
+    /// Number of occupied slots.
+    size_t numElements;
+  };
+
+  /// Open-addressing hash set of GUIDs, with the same characteristics as #GuidHashMap.
+  class GuidHashSet
+  {
+  public:
+
+    GuidHashSet(void) = default;
+
+    /// Allows the caller to size the table up front for a key population known in advance.
+    /// @param [in] expectedKeyCount Expected number of keys the table will hold.
+    explicit GuidHashSet(size_t expectedKeyCount) : contents(expectedKeyCount) {}
+
+    /// Removes all elements from this set. Capacity is retained.
+    void Clear(void)
+    {
+      contents.Clear();
+    }
+
+    /// Determines if this set contains the specified key.
+    /// @param [in] key GUID key for which to search.
+    /// @return `true` if the specified key exists in this set, `false` otherwise.
+    bool Contains(REFGUID key) const
+    {
+      return contents.Contains(key);
+    }
+
+    /// Inserts the specified key into this set.
+    /// @param [in] key GUID key to insert.
+    /// @return `true` if the key was newly inserted, `false` if it was already present.
+    bool Insert(REFGUID key)
+    {
+      return contents.InsertOrAssign(key, true);
+    }
+
+    /// Retrieves the number of elements held by this set.
+    /// @return Number of elements held by this set.
+    size_t Size(void) const
+    {
+      return contents.Size();
+    }
+
+  private:
+
+    /// Underlying element storage. Values carry no information; only key presence matters.
+    GuidHashMap<bool> contents;
+  };
+} // namespace Xidi
@@ -0,0 +1,66 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file HotPathLogging.h
+ *   Declaration of deferred-formatting logging functionality for interface methods that sit on
+ *   the input hot path and are invoked by applications once or more per frame. Captured records
+ *   are handed off in batches to a single background writer thread, which performs all string
+ *   formatting and output, so calling threads never format messages or touch the log file.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+
+namespace Xidi
+{
+  namespace HotPathLogging
+  {
+    /// Captures a DirectInput interface method invocation as a fixed-size binary record in a
+    /// per-thread buffer, deferring all string formatting until the buffer fills and is flushed.
+    /// Callers are expected to check message output eligibility for the desired severity before
+    /// invoking this function, so that nothing at all is captured when the severity is disabled.
+    /// Because formatting is deferred, the method name must point to a string with static storage
+    /// duration, such as a string literal.
+    /// @param [in] severity Severity with which the invocation is eventually output.
+    /// @param [in] methodName Name of the invoked method. Must have static storage duration.
+    /// @param [in] objectId Internal identifier of the invoked interface object.
+    /// @param [in] controllerIdentifier 1-based identifier of the associated virtual controller.
+    /// @param [in] result Result code returned to the application by the invocation.
+    void RecordInvocation(
+        Infra::Message::ESeverity severity,
+        const wchar_t* methodName,
+        unsigned int objectId,
+        unsigned int controllerIdentifier,
+        HRESULT result);
+
+    /// Captures a WinMM joystick function invocation as a fixed-size binary record in a
+    /// per-thread buffer, deferring all string formatting until the buffer is handed off to the
+    /// background writer. Callers are expected to check message output eligibility for the
+    /// desired severity before invoking this function, so that nothing at all is captured when
+    /// the severity is disabled. Because formatting is deferred, the function name must point to
+    /// a string with static storage duration, such as a string literal.
+    /// @param [in] severity Severity with which the invocation is eventually output.
+    /// @param [in] functionName Name of the invoked function. Must have static storage duration.
+    /// @param [in] deviceId Identifier of the WinMM joystick device targeted by the invocation.
+    /// @param [in] result Result code returned to the application by the invocation.
+    void RecordWinMMInvocation(
+        Infra::Message::ESeverity severity,
+        const wchar_t* functionName,
+        unsigned int deviceId,
+        unsigned int result);
+
+    /// Hands off all invocation records currently buffered on the calling thread to the
+    /// background writer for formatting and output. Invoked automatically whenever a thread's
+    /// record buffer fills, so explicit calls are only needed to force out whatever partial
+    /// buffer contents exist, for example when diagnosing an issue that manifests before the
+    /// buffer fills.
+    void FlushThread(void);
+  } // namespace HotPathLogging
+} // namespace Xidi
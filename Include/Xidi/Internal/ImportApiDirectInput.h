@@ -24,6 +24,12 @@ namespace Xidi
       /// Retrieves a pointer to the interface that allows some imported functions to be replaced.
       Api::IMutableImportTable* GetMutableImportTable(void);
 
+      /// Loads the native DirectInput 8 library if it has not already been loaded. Individual
+      /// functions are still resolved on first use. Intended to be invoked from a background
+      /// thread during startup so that the first imported function call does not pay the library
+      /// load cost. Concurrency-safe.
+      void PreloadImportLibrary(void);
+
       HRESULT DirectInput8Create(
           HINSTANCE hinst, DWORD dwVersion, REFIID riidltf, LPVOID* ppvOut, LPUNKNOWN punkOuter);
       HRESULT DllRegisterServer(void);
@@ -37,6 +43,12 @@ namespace Xidi
       /// Retrieves a pointer to the interface that allows some imported functions to be replaced.
       Api::IMutableImportTable* GetMutableImportTable(void);
 
+      /// Loads the native DirectInput legacy library if it has not already been loaded. Individual
+      /// functions are still resolved on first use. Intended to be invoked from a background
+      /// thread during startup so that the first imported function call does not pay the library
+      /// load cost. Concurrency-safe.
+      void PreloadImportLibrary(void);
+
       HRESULT DirectInputCreateA(
           HINSTANCE hinst, DWORD dwVersion, LPDIRECTINPUTA* ppDI, LPUNKNOWN punkOuter);
       HRESULT DirectInputCreateW(
@@ -22,6 +22,12 @@ namespace Xidi
     /// Retrieves a pointer to the interface that allows some imported functions to be replaced.
     Api::IMutableImportTable* GetMutableImportTable(void);
 
+    /// Loads the native WinMM library if it has not already been loaded. Individual functions are
+    /// still resolved on first use. Intended to be invoked from a background thread during startup
+    /// so that the first imported function call does not pay the library load cost.
+    /// Concurrency-safe.
+    void PreloadImportLibrary(void);
+
     MMRESULT joyConfigChanged(DWORD dwFlags);
     MMRESULT joyGetDevCapsA(UINT_PTR uJoyID, LPJOYCAPSA pjc, UINT cbjc);
     MMRESULT joyGetDevCapsW(UINT_PTR uJoyID, LPJOYCAPSW pjc, UINT cbjc);
@@ -26,9 +26,33 @@ namespace Xidi
 {
   namespace ImportApiXInput
   {
+    /// Type of a function that reads the instantaneous state of an XInput controller.
+    using TXInputGetStateFunc = DWORD(__stdcall*)(DWORD, XINPUT_STATE*);
+
+    /// Describes the best available function for reading XInput controller state, selected once
+    /// when the XInput library is loaded.
+    struct SXInputStateReader
+    {
+      /// Address of the state-reading function. Valid for the lifetime of the process, so callers
+      /// on hot paths can cache it and invoke the function directly instead of dispatching
+      /// through the import table on every call.
+      TXInputGetStateFunc getStateFunc;
+
+      /// Whether or not the state-reading function reports the state of the Guide button.
+      bool reportsGuideButton;
+    };
+
     /// Dynamically loads the XInput library and sets up all imported function calls.
     void Initialize(void);
 
+    /// Retrieves the best available function for reading XInput controller state. Where the
+    /// loaded XInput library exports it, this is the extended state-reading function (exported by
+    /// ordinal only and commonly known as "XInputGetStateEx"), which has the same signature as
+    /// #XInputGetState but additionally reports the state of the Guide button. Otherwise it is
+    /// the documented #XInputGetState.
+    /// @return Structure describing the best available state-reading function.
+    SXInputStateReader GetXInputStateReader(void);
+
     DWORD XInputGetState(DWORD dwUserIndex, XINPUT_STATE* pState);
     DWORD XInputSetState(DWORD dwUserIndex, XINPUT_VIBRATION* pVibration);
   } // namespace ImportApiXInput
@@ -0,0 +1,49 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file InputDispatch.h
+ *   Declaration of the shared input synthesis dispatcher, which gathers pending keyboard and
+ *   mouse events and submits them to the system in combined batches.
+ **************************************************************************************************/
+
+#pragma once
+
+namespace Xidi
+{
+  namespace InputDispatch
+  {
+    /// Ensures the input dispatch thread is running. The thread gathers pending keyboard and
+    /// mouse input events each cycle and submits them all in a single system call. Idempotent
+    /// and concurrency-safe. Intended to be invoked whenever a keyboard or mouse state
+    /// contribution is submitted.
+    void EnsureDispatchThreadRunning(void);
+
+    /// Wakes the input dispatch thread so that it gathers and submits pending input events
+    /// immediately rather than at its next polling period. Intended to be invoked after
+    /// registering a discrete state change, such as a key or mouse button transition.
+    void WakeDispatchThread(void);
+
+    /// Wakes the input dispatch thread only if it has gone idle, at much lower cost than an
+    /// unconditional wake. Intended to be invoked after registering a continuous contribution,
+    /// such as mouse movement, which is resubmitted on every mapping poll: if a concurrent
+    /// submission races with the thread going idle and the wake is missed, the next resubmission
+    /// delivers it.
+    void WakeDispatchThreadIfIdle(void);
+
+    /// Records, for statistics purposes, that a keyboard or mouse state contribution was
+    /// received and produced a new pending state change. Counters are exposed through the
+    /// ISynthesisStatistics API class. Intended to be invoked by the keyboard and mouse
+    /// submission functions.
+    void RecordContributionReceived(void);
+
+    /// Records, for statistics purposes, that a keyboard or mouse state contribution was
+    /// absorbed by an identical already-pending contribution. Counters are exposed through the
+    /// ISynthesisStatistics API class. Intended to be invoked by the keyboard and mouse
+    /// submission functions.
+    void RecordContributionCoalesced(void);
+  } // namespace InputDispatch
+} // namespace Xidi
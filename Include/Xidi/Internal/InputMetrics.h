@@ -0,0 +1,92 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file InputMetrics.h
+ *   Declaration of always-on input pipeline health metrics. Hot paths submit samples into
+ *   fixed-bucket histograms maintained with relaxed atomic counters, and the accumulated
+ *   histograms are exposed externally through the #Api::IInputMetrics interface.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace InputMetrics
+  {
+    /// Records publication of a virtual controller state change. Submits a poll-to-refresh
+    /// latency sample measured from the supplied hardware capture timestamp and arms the
+    /// refresh-to-read measurement for the specified controller.
+    /// @param [in] controllerIdentifier Identifier of the associated physical controller.
+    /// @param [in] captureTimestamp Hardware state capture timestamp, in QueryPerformanceCounter
+    /// units, or 0 if no capture timestamp is available, in which case no latency sample is
+    /// submitted.
+    void RecordStateRefreshed(
+        Controller::TControllerIdentifier controllerIdentifier, int64_t captureTimestamp);
+
+    /// Records an application state read for the specified controller. The first read after each
+    /// published state change submits a refresh-to-read latency sample; subsequent reads of the
+    /// same state return without consulting the clock.
+    /// @param [in] controllerIdentifier Identifier of the associated physical controller.
+    void RecordStateRead(Controller::TControllerIdentifier controllerIdentifier);
+
+    /// Records an event buffer occupancy sample at state change publication time.
+    /// @param [in] occupiedEvents Number of events currently in the event buffer.
+    /// @param [in] capacityEvents Total event buffer capacity. No sample is recorded if 0.
+    void RecordEventBufferOccupancy(uint32_t occupiedEvents, uint32_t capacityEvents);
+
+    /// Records an event buffer overflow occurrence that discarded the specified number of
+    /// buffered events.
+    /// @param [in] droppedEvents Number of events discarded by the overflow.
+    void RecordEventBufferOverflow(uint32_t droppedEvents);
+
+    /// Records advancement of an event buffer's occupancy high-water mark. Only invoked when a
+    /// buffer's own high-water mark advances, so this is well off the per-event hot path.
+    /// @param [in] occupiedEvents New high-water mark, in number of occupied events.
+    void RecordEventBufferHighWaterMark(uint32_t occupiedEvents);
+
+    /// Enumerates the real-time polling loops whose scheduler wakeup behavior is measured.
+    /// Enumerator order determines the loop indexing of the statistics exposed through the
+    /// #Api::IInputMetrics interface, so existing enumerators must not be reordered.
+    enum class EPollingLoop : unsigned int
+    {
+      /// Physical controller state polling loop.
+      StatePolling,
+
+      /// Force feedback actuation loop.
+      ForceFeedback,
+
+      /// Sentinel value. Total number of measured polling loops.
+      Count,
+    };
+
+    /// Records one timed wakeup of a real-time polling loop. Lateness of at least one full
+    /// scheduled period additionally counts as an overrun, and lateness beyond the configured
+    /// warning threshold produces a rate-limited log message identifying the degraded loop.
+    /// @param [in] pollingLoop Polling loop that woke up.
+    /// @param [in] latenessMilliseconds Actual wakeup time minus scheduled due time, in
+    /// milliseconds, with early wakeups submitted as 0.
+    /// @param [in] periodMilliseconds Scheduled wait period that preceded the wakeup, in
+    /// milliseconds.
+    void RecordPollingLoopWakeup(
+        EPollingLoop pollingLoop, uint32_t latenessMilliseconds, uint32_t periodMilliseconds);
+
+    /// Records an uncontended virtual controller lock acquisition, which counts into the first
+    /// lock wait histogram bucket without any clock query.
+    void RecordUncontendedLockAcquisition(void);
+
+    /// Acquires the supplied lock, which must have been the subject of a failed non-blocking
+    /// acquisition attempt, while measuring the time spent waiting, and submits the measurement
+    /// as a lock wait sample.
+    /// @param [in,out] lock Lock object to acquire.
+    void AcquireLockWithWaitMeasurement(std::unique_lock<std::recursive_mutex>& lock);
+  } // namespace InputMetrics
+} // namespace Xidi
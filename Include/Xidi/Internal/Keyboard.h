@@ -12,11 +12,17 @@
 
 #pragma once
 
+#include <vector>
+
+#include "ApiWindows.h"
+
 namespace Xidi
 {
   namespace Keyboard
   {
-    /// Number of milliseconds to wait between physical keyboard update attempts.
+    /// Number of milliseconds to wait between physical keyboard update attempts while any
+    /// virtual keys are held pressed. Updates themselves are event-driven; this period only
+    /// bounds how quickly a loss of input focus is noticed while keys are held.
     inline constexpr unsigned int kKeyboardUpdatePeriodMilliseconds = 10;
 
     /// Number of keyboard keys that exist in total on a virtual keyboard.
@@ -29,6 +35,17 @@ namespace Xidi
     /// constants).
     using TKeyIdentifier = unsigned int;
 
+    /// Appends a keyboard input event to the supplied buffer for every virtual key whose state
+    /// has changed since the previous invocation, consuming all pending key state contributions
+    /// in the process. Intended to be invoked only by the input dispatch thread.
+    /// @param [in,out] inputEvents Buffer to which input events are appended.
+    /// @param [in] forceNeutralState If `true`, all pressed keys transition to released
+    /// regardless of pending contributions. Used on loss of input focus and on shutdown.
+    /// @return `true` if any virtual keys remain pressed afterwards, meaning the dispatch thread
+    /// needs to keep cycling periodically, or `false` if it is safe to block until the next
+    /// contribution.
+    bool AppendPendingKeyboardEvents(std::vector<INPUT>& inputEvents, bool forceNeutralState);
+
     /// Submits a key state of pressed.
     /// @param [in] key Keyboard key that is affected.
     void SubmitKeyPressedState(TKeyIdentifier key);
@@ -0,0 +1,73 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file LatencyMeasurement.h
+ *   Declaration of per-stage input pipeline latency measurement for a single marked input
+ *   transition. Pipeline stages submit notifications as state flows through them, and once a
+ *   marked button press edge has passed through every stage the resulting per-stage timestamp
+ *   breakdown is exposed externally through the #Api::ILatencyMeasurement interface.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "ApiXidi.h"
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace LatencyMeasurement
+  {
+    /// Arms the marker for the next press edge of the specified physical button on the specified
+    /// controller, discarding any in-progress or completed measurement. The press edge is only
+    /// recognized once the button has been observed unpressed, so a button already held at arming
+    /// time does not complete a measurement until it is released and pressed again. Arming is
+    /// expected to happen while the marked button is at rest.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @param [in] physicalButton Physical button of interest.
+    void ArmMarker(
+        Controller::TControllerIdentifier controllerIdentifier,
+        Controller::EPhysicalButton physicalButton);
+
+    /// Disarms the marker and discards any in-progress or completed measurement.
+    void DisarmMarker(void);
+
+    /// Retrieves the stage timestamps recorded for the marked input transition.
+    /// @return Filled-in stage timestamp structure if the measurement is complete, otherwise a
+    /// structure with the completion flag unset.
+    Api::ILatencyMeasurement::SStageTimestamps GetMeasurement(void);
+
+    /// Submits a physical hardware snapshot at publication time. If the marker is armed for the
+    /// specified controller and the snapshot contains the marked button's press edge, the capture
+    /// and publication stage timestamps are recorded. No-op unless the marker is armed, costing
+    /// just a single atomic load on the polling hot path.
+    /// @param [in] controllerIdentifier Identifier of the physical controller whose snapshot is
+    /// being published.
+    /// @param [in] physicalState Physical hardware snapshot being published.
+    void SubmitPhysicalState(
+        Controller::TControllerIdentifier controllerIdentifier,
+        const Controller::SPhysicalState& physicalState);
+
+    /// Submits acceptance of a state refresh by a virtual controller. If a marked transition is
+    /// awaiting refresh on the specified controller and the refreshed state is not older than the
+    /// marked snapshot, the refresh stage timestamp is recorded. No-op unless a measurement is in
+    /// that stage, costing just a single atomic load on the refresh hot path.
+    /// @param [in] controllerIdentifier Identifier of the associated physical controller.
+    /// @param [in] captureTimestamp Capture timestamp carried by the refreshed state, in
+    /// QueryPerformanceCounter units, or 0 if unavailable.
+    void SubmitStateRefresh(
+        Controller::TControllerIdentifier controllerIdentifier, int64_t captureTimestamp);
+
+    /// Submits an application state read. If a marked transition is awaiting its first read on
+    /// the specified controller, the read stage timestamp is recorded and the measurement is
+    /// complete. No-op unless a measurement is in that stage, costing just a single atomic load
+    /// on the state read hot path.
+    /// @param [in] controllerIdentifier Identifier of the associated physical controller.
+    void SubmitStateRead(Controller::TControllerIdentifier controllerIdentifier);
+  } // namespace LatencyMeasurement
+} // namespace Xidi
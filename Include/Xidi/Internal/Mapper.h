@@ -12,13 +12,18 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
 #include <string_view>
+#include <vector>
 
 #include "ApiBitSet.h"
 #include "ApiWindows.h"
+#include "ControllerMath.h"
 #include "ControllerTypes.h"
 #include "ElementMapper.h"
+#include "ElementMapperArena.h"
 #include "ForceFeedbackTypes.h"
 
 /// Computes the index of the specified named controller element in the unnamed array representation
@@ -71,6 +76,7 @@ namespace Xidi
         std::unique_ptr<const IElementMapper> buttonStart = nullptr;
         std::unique_ptr<const IElementMapper> buttonLS = nullptr;
         std::unique_ptr<const IElementMapper> buttonRS = nullptr;
+        std::unique_ptr<const IElementMapper> buttonGuide = nullptr;
       };
 
       /// Physical force feedback actuator mappers, one per force feedback actuator.
@@ -82,6 +88,8 @@ namespace Xidi
         ForceFeedback::SActuatorElement rightMotor;
         ForceFeedback::SActuatorElement leftImpulseTrigger;
         ForceFeedback::SActuatorElement rightImpulseTrigger;
+
+        constexpr bool operator==(const SForceFeedbackActuatorMap& other) const = default;
       };
 
       static_assert(
@@ -116,6 +124,56 @@ namespace Xidi
         UElementMap& operator=(UElementMap&& other);
       };
 
+      /// Non-owning analog of #SElementMap used to describe built-in mapper definitions. Each
+      /// field points to an element mapper with constant-initialized storage, so an entire
+      /// definition can be placed in the read-only section with no dynamic allocation and no
+      /// static initialization code. Field order mirrors #SElementMap exactly.
+      struct SElementMapDefinition
+      {
+        const IElementMapper* stickLeftX = nullptr;
+        const IElementMapper* stickLeftY = nullptr;
+        const IElementMapper* stickRightX = nullptr;
+        const IElementMapper* stickRightY = nullptr;
+        const IElementMapper* dpadUp = nullptr;
+        const IElementMapper* dpadDown = nullptr;
+        const IElementMapper* dpadLeft = nullptr;
+        const IElementMapper* dpadRight = nullptr;
+        const IElementMapper* triggerLT = nullptr;
+        const IElementMapper* triggerRT = nullptr;
+        const IElementMapper* buttonA = nullptr;
+        const IElementMapper* buttonB = nullptr;
+        const IElementMapper* buttonX = nullptr;
+        const IElementMapper* buttonY = nullptr;
+        const IElementMapper* buttonLB = nullptr;
+        const IElementMapper* buttonRB = nullptr;
+        const IElementMapper* buttonBack = nullptr;
+        const IElementMapper* buttonStart = nullptr;
+        const IElementMapper* buttonLS = nullptr;
+        const IElementMapper* buttonRS = nullptr;
+        const IElementMapper* buttonGuide = nullptr;
+      };
+
+      /// Dual representation of an element map definition, mirroring #UElementMap. Intended for
+      /// internal use only. In one representation the elements all have names for
+      /// element-specific access. In the other, all the elements are collapsed into an array for
+      /// easy iteration.
+      union UElementMapDefinition
+      {
+        SElementMapDefinition named;
+        const IElementMapper* all[sizeof(SElementMapDefinition) / sizeof(const IElementMapper*)];
+
+        static_assert(sizeof(named) == sizeof(all), "Element map definition field mismatch.");
+
+        static_assert(
+            (sizeof(SElementMapDefinition) / sizeof(const IElementMapper*)) ==
+                (sizeof(SElementMap) / sizeof(std::unique_ptr<const IElementMapper>)),
+            "Element map definition must cover every element map slot.");
+
+        constexpr UElementMapDefinition(void) : named() {}
+
+        constexpr UElementMapDefinition(const SElementMapDefinition& named) : named(named) {}
+      };
+
       /// Dual representation of a force feedback actuator map. Intended for internal use only.
       /// In one representation the elements all have names for element-specific access.
       /// In the other, all the elements are collapsed into an array for easy iteration.
@@ -150,6 +208,206 @@ namespace Xidi
           sizeof(UForceFeedbackActuatorMap::named) == sizeof(UForceFeedbackActuatorMap::all),
           "Force feedback actuator field mismatch.");
 
+      /// Enumerates the prepared physical input values that a single step of the compiled mapping
+      /// table can consume. Analog and trigger inputs identify one of the transformed values
+      /// prepared once per state mapping pass, and button input identifies a physical button via
+      /// the accompanying button field of the step.
+      enum class EMappingStepInput : uint8_t
+      {
+        AnalogStickLeftX,
+        AnalogStickLeftY,
+        AnalogStickRightX,
+        AnalogStickRightY,
+        TriggerLT,
+        TriggerRT,
+        Button,
+
+        /// Sentinel value, total number of enumerators.
+        Count
+      };
+
+      /// Enumerates the fused operations available to the specialized trivial mapping executor.
+      /// Each enumerator combines a trivial element mapper type, an input source kind, and, for
+      /// axis operations, an axis direction, so the executor decodes exactly one tag per step and
+      /// performs the contribution with fully inlined arithmetic instead of calling out to the
+      /// element mapper object.
+      enum class ETrivialStepOp : uint8_t
+      {
+        AxisFromAnalogBoth,
+        AxisFromAnalogPositive,
+        AxisFromAnalogNegative,
+        AxisFromButtonBoth,
+        AxisFromButtonPositive,
+        AxisFromButtonNegative,
+        AxisFromTriggerBoth,
+        AxisFromTriggerPositive,
+        AxisFromTriggerNegative,
+        ButtonFromAnalog,
+        ButtonFromButton,
+        ButtonFromTrigger,
+        PovFromAnalog,
+        PovFromButton,
+        PovFromTrigger,
+
+        /// Sentinel value, total number of enumerators.
+        Count
+      };
+
+      /// One step of the specialized trivial mapping table, compiled at construction time for
+      /// mappers whose element maps consist entirely of plain axis, button, and POV element
+      /// mappers. Steps are densely packed so the entire table for a typical mapper fits in a
+      /// single cache line. Also produced during constant evaluation by the compile-time mapper
+      /// facility, see "CompileTimeMapper.h".
+      struct STrivialMappingStep
+      {
+        /// Fused operation performed by this step.
+        ETrivialStepOp op;
+
+        /// Input consumed by this step: index of a prepared analog stick value, index of a
+        /// prepared trigger value, or physical button identifier, depending on the operation.
+        uint8_t inputIndex;
+
+        /// Target written by this step: axis, button, or POV direction enumerator, depending on
+        /// the operation.
+        uint8_t target;
+
+        /// Mask with the single bit set that corresponds to the virtual controller element
+        /// written by this step. Used to skip steps whose targets no consumer reads.
+        TElementMask targetElementMask;
+      };
+
+      /// Signature of a fully-inlined state mapping executor generated at compile time for a
+      /// fixed element map definition. Behaviorally identical to executing the runtime-compiled
+      /// trivial mapping table, but the entire step sequence is straight-line code with no table
+      /// walk and no per-step operation decode. Parameters match those of the runtime executors:
+      /// the controller state to be updated, the physical state from which to read button values,
+      /// the prepared analog and trigger values ordered by step input enumerator, and the mask of
+      /// virtual controller elements that consumers actually read.
+      using TInlinedMappingExecutor = void (*)(
+          SState& controllerState,
+          const SPhysicalState& physicalState,
+          const int16_t* analogValues,
+          const uint8_t* triggerValues,
+          TElementMask consumedElements);
+
+      /// Performs the contribution of a single trivial mapping step against the specified
+      /// controller state. This is the sole definition of the arithmetic for every fused trivial
+      /// operation, shared between the runtime trivial mapping executor and the compile-time
+      /// mapper facility. When invoked with a compile-time constant step, the operation decode
+      /// folds away entirely, leaving just the contribution arithmetic. The step's target element
+      /// mask is deliberately not consulted here; skipping unconsumed steps is the caller's
+      /// responsibility.
+      /// @param [in] step Trivial mapping step to perform.
+      /// @param [in,out] controllerState Controller state data structure to be updated.
+      /// @param [in] physicalState Physical controller state from which to read button values.
+      /// @param [in] analogValues Prepared analog stick values, ordered by input enumerator.
+      /// @param [in] triggerValues Prepared trigger values, ordered by input enumerator.
+      static inline void ApplyTrivialMappingStep(
+          const STrivialMappingStep& step,
+          SState& controllerState,
+          const SPhysicalState& physicalState,
+          const int16_t* analogValues,
+          const uint8_t* triggerValues)
+      {
+        // These constants replicate the trigger-to-axis conversion performed by the axis element
+        // mapper, so the trivial step executors produce bit-identical contributions.
+        constexpr double kBidirectionalStepSize = (double)(kAnalogValueMax - kAnalogValueMin) /
+            (double)(kTriggerValueMax - kTriggerValueMin);
+        constexpr double kPositiveStepSize =
+            (double)kAnalogValueMax / (double)(kTriggerValueMax - kTriggerValueMin);
+        constexpr double kNegativeStepSize =
+            (double)kAnalogValueMin / (double)(kTriggerValueMax - kTriggerValueMin);
+
+        switch (step.op)
+        {
+          case ETrivialStepOp::AxisFromAnalogBoth:
+            controllerState[(EAxis)step.target] += (int32_t)analogValues[step.inputIndex];
+            break;
+
+          case ETrivialStepOp::AxisFromAnalogPositive:
+            controllerState[(EAxis)step.target] +=
+                (((int32_t)analogValues[step.inputIndex]) - kAnalogValueMin) >> 1;
+            break;
+
+          case ETrivialStepOp::AxisFromAnalogNegative:
+            controllerState[(EAxis)step.target] +=
+                (((int32_t)analogValues[step.inputIndex]) - kAnalogValueMax) >> 1;
+            break;
+
+          case ETrivialStepOp::AxisFromButtonBoth:
+            controllerState[(EAxis)step.target] +=
+                (physicalState[(EPhysicalButton)step.inputIndex] ? kAnalogValueMax
+                                                                 : kAnalogValueMin);
+            break;
+
+          case ETrivialStepOp::AxisFromButtonPositive:
+            controllerState[(EAxis)step.target] +=
+                (physicalState[(EPhysicalButton)step.inputIndex] ? kAnalogValueMax
+                                                                 : kAnalogValueNeutral);
+            break;
+
+          case ETrivialStepOp::AxisFromButtonNegative:
+            controllerState[(EAxis)step.target] +=
+                (physicalState[(EPhysicalButton)step.inputIndex] ? kAnalogValueMin
+                                                                 : kAnalogValueNeutral);
+            break;
+
+          case ETrivialStepOp::AxisFromTriggerBoth:
+            controllerState[(EAxis)step.target] +=
+                (int32_t)((double)triggerValues[step.inputIndex] * kBidirectionalStepSize) +
+                kAnalogValueMin;
+            break;
+
+          case ETrivialStepOp::AxisFromTriggerPositive:
+            controllerState[(EAxis)step.target] +=
+                (int32_t)((double)triggerValues[step.inputIndex] * kPositiveStepSize) +
+                kAnalogValueNeutral;
+            break;
+
+          case ETrivialStepOp::AxisFromTriggerNegative:
+            controllerState[(EAxis)step.target] +=
+                (int32_t)((double)triggerValues[step.inputIndex] * kNegativeStepSize) -
+                kAnalogValueNeutral;
+            break;
+
+          case ETrivialStepOp::ButtonFromAnalog:
+            controllerState[(EButton)step.target] =
+                (controllerState[(EButton)step.target] ||
+                 Math::IsAnalogPressed(analogValues[step.inputIndex]));
+            break;
+
+          case ETrivialStepOp::ButtonFromButton:
+            controllerState[(EButton)step.target] =
+                (controllerState[(EButton)step.target] ||
+                 physicalState[(EPhysicalButton)step.inputIndex]);
+            break;
+
+          case ETrivialStepOp::ButtonFromTrigger:
+            controllerState[(EButton)step.target] =
+                (controllerState[(EButton)step.target] ||
+                 Math::IsTriggerPressed(triggerValues[step.inputIndex]));
+            break;
+
+          case ETrivialStepOp::PovFromAnalog:
+            if (true == Math::IsAnalogPressed(analogValues[step.inputIndex]))
+              controllerState.povDirection.components[step.target] = true;
+            break;
+
+          case ETrivialStepOp::PovFromButton:
+            if (true == physicalState[(EPhysicalButton)step.inputIndex])
+              controllerState.povDirection.components[step.target] = true;
+            break;
+
+          case ETrivialStepOp::PovFromTrigger:
+            if (true == Math::IsTriggerPressed(triggerValues[step.inputIndex]))
+              controllerState.povDirection.components[step.target] = true;
+            break;
+
+          default:
+            break;
+        }
+      }
+
       /// Set of axes that must be present on all virtual controllers.
       /// Contents are based on expectations of both DirectInput and WinMM state data structures.
       /// If no element mappers contribute to these axes then they will be continually reported as
@@ -184,6 +442,26 @@ namespace Xidi
           SElementMap&& elements,
           SForceFeedbackActuatorMap forceFeedbackActuators = kDefaultForceFeedbackActuatorMap);
 
+      /// Intended for built-in mapper definitions. The definition is not owned by this object;
+      /// its element mappers are cloned directly into this object's arena, so the definition
+      /// itself can be constant-initialized read-only data and incurs no dynamic allocation of
+      /// its own. An inlined mapping executor generated at compile time from the same definition,
+      /// see "CompileTimeMapper.h", may optionally be supplied and is then used in place of the
+      /// runtime-compiled mapping tables for full state mapping passes.
+      Mapper(
+          const std::wstring_view name,
+          const UElementMapDefinition& elements,
+          SForceFeedbackActuatorMap forceFeedbackActuators = kDefaultForceFeedbackActuatorMap,
+          TInlinedMappingExecutor inlinedMappingExecutor = nullptr);
+
+      /// Does not require or register a name for this mapper. This version is primarily useful
+      /// for testing the compile-time mapper facility against the runtime mapping tables built
+      /// from the same definition.
+      Mapper(
+          const UElementMapDefinition& elements,
+          SForceFeedbackActuatorMap forceFeedbackActuators = kDefaultForceFeedbackActuatorMap,
+          TInlinedMappingExecutor inlinedMappingExecutor = nullptr);
+
       /// Does not require or register a name for this mapper. This version is primarily useful for
       /// testing. Requires that a unique mapper be specified for each controller element, which in
       /// turn becomes owned by this object. For controller elements that are not used, `nullptr`
@@ -276,6 +554,31 @@ namespace Xidi
         return name;
       }
 
+      /// Registers this mapper object under an additional name, interning it in the registry so
+      /// that multiple names share one immutable mapper object instead of each name carrying a
+      /// deep copy of an identical element mapper graph. Intended for custom mappers that are
+      /// pure aliases of their templates. The shared object keeps its original name, so #GetName
+      /// on a mapper obtained via an alias returns the name under which the object was first
+      /// created.
+      /// @param [in] aliasName Additional name to associate with this mapper object.
+      void RegisterAlias(std::wstring_view aliasName) const;
+
+      /// Removes a previously-registered alias name from the registry. Has no effect if the name
+      /// is unknown or is the name under which a mapper object was originally created, as opposed
+      /// to an alias; original names are unregistered only on destruction of the mapper object.
+      /// Primarily useful for tests, which need to clean up registered names between test cases.
+      /// @param [in] aliasName Alias name to remove from the registry.
+      static void UnregisterAlias(std::wstring_view aliasName);
+
+      /// Removes the specified name from the registry so that it can be registered anew, retiring
+      /// the associated mapper object if the name is the one under which it was originally
+      /// created. Retired mapper objects are kept alive, rather than destroyed, because consumers
+      /// that already obtained a pointer to a mapper may continue using it indefinitely. Has no
+      /// effect if the name is unknown. Supports rebuilding an updated mapper under a
+      /// previously-used name.
+      /// @param [in] mapperName Mapper name to remove from the registry.
+      static void UnregisterAndRetire(std::wstring_view mapperName);
+
       /// Maps from virtual force feedback effect magnitude component to physical force feedback
       /// actuator values.
       /// @param [in] virtualEffectComponents Virtual force feedback vector expressed as a magnitude
@@ -292,9 +595,14 @@ namespace Xidi
       /// @param [in] physicalState Physical controller state from which to read.
       /// @param [in] sourceControllerIdentifier Opaque identifier of the physical controller
       /// associated with the state being mapped.
+      /// @param [in] consumedElements Mask of virtual controller elements that consumers actually
+      /// read, defaulting to all elements. Steps that can only write elements outside this mask
+      /// are skipped entirely, and the skipped elements report neutral values.
       /// @return Controller state object that was filled as a result of the mapping.
       SState MapStatePhysicalToVirtual(
-          SPhysicalState physicalState, uint32_t sourceControllerIdentifier) const;
+          SPhysicalState physicalState,
+          uint32_t sourceControllerIdentifier,
+          TElementMask consumedElements = kElementMaskAll) const;
 
       /// Maps from physical controller state to virtual controller state in which the physical
       /// controller is completely neutral and possibly even disconnected. Does not apply any
@@ -306,17 +614,214 @@ namespace Xidi
 
     private:
 
+      /// One step of the compiled flat mapping table. The table holds one densely-packed step per
+      /// present element mapper, in fixed contribution order, so the state mapping hot path
+      /// iterates steps without touching absent element map slots. Each step carries the element
+      /// mapper's type tag so contributions from the common concrete mapper types can be
+      /// dispatched with direct calls instead of virtual calls.
+      struct SMappingStep
+      {
+        /// Element mapper that this step invokes. Never `nullptr`.
+        const IElementMapper* elementMapper;
+
+        /// Positional index of the element mapper within the overall element map, used to compute
+        /// the opaque source identifier passed to the element mapper.
+        uint32_t elementMapIndex;
+
+        /// Concrete type tag of the element mapper, captured once at compile time of the table.
+        EElementMapperType type;
+
+        /// Prepared physical input value that this step consumes.
+        EMappingStepInput input;
+
+        /// Physical button that this step consumes, valid only if the input enumerator says so.
+        EPhysicalButton sourceButton;
+
+        /// Sole virtual controller element targeted by this step. Valid only if the element
+        /// mapper has exactly one target, which is guaranteed for the directly-dispatched concrete
+        /// types. Used for incremental mapping, which must be able to reset a step's previous
+        /// contribution before re-running it.
+        SElementIdentifier targetElement;
+
+        /// POV direction targeted by this step, valid only if the target element is a POV. Kept
+        /// separately because #SElementIdentifier does not distinguish POV directions, and
+        /// incremental mapping needs that distinction both for overlap analysis and for resetting
+        /// previous contributions.
+        EPovDirection targetPovDirection;
+
+        /// Mask of all virtual controller elements this step can write. Steps whose element
+        /// mapper cannot be analyzed, including all custom element mappers, conservatively carry
+        /// a mask with every element present so they are never skipped. Used to skip steps whose
+        /// targets no consumer reads.
+        TElementMask targetElementMask;
+      };
+
+      /// Per-controller cached inputs and output supporting incremental state mapping. When a new
+      /// physical state arrives and incremental mapping is supported, only the steps whose source
+      /// input actually changed are re-run against the cached output state. Guarded by its own
+      /// mutex because mapper objects are shared across controllers and threads; in steady-state
+      /// operation the mutex is uncontended.
+      struct SIncrementalMappingState
+      {
+        /// Concurrency guard for this cache slot.
+        std::mutex guard;
+
+        /// Whether or not the cached inputs and output below are valid.
+        bool valid = false;
+
+        /// Cached prepared analog stick values from the previous mapping pass.
+        int16_t analogValues[4] = {};
+
+        /// Cached prepared trigger values from the previous mapping pass.
+        uint8_t triggerValues[2] = {};
+
+        /// Cached physical button state bits from the previous mapping pass.
+        uint32_t buttonValues = 0;
+
+        /// Consumed element mask in effect during the previous mapping pass. A change in the
+        /// mask invalidates the cache, since elements excluded by the previous mask hold neutral
+        /// values in the cached output state.
+        TElementMask consumedElements = kElementMaskAll;
+
+        /// Mapped output state from the previous mapping pass.
+        SState outputState = {};
+      };
+
+      /// Precomputed routing for one physical force feedback actuator. Compiled once at
+      /// construction time from the actuator map so that each actuation pass evaluates a fixed
+      /// weighted dot product over squared magnitude components instead of re-interpreting
+      /// actuator mode enumerators and bit-fields on every pass. An actuator's raw strength is
+      /// the square root of the weighted sum of squared components, which reproduces both
+      /// single-axis mode (weight 1 on one axis, strength equal to the component's absolute
+      /// value) and magnitude projection mode (weight 1 on each of two axes) exactly.
+      struct SForceFeedbackActuatorRoute
+      {
+        /// Per-virtual-axis weights applied to squared magnitude components. Absent or disabled
+        /// actuators have every weight equal to 0 and therefore always produce no output.
+        ForceFeedback::TEffectValue squaredComponentWeights[(int)EAxis::Count];
+
+        /// Virtual axis whose component sign gates this actuator's output. Valid only if the
+        /// direction field below requests gating.
+        EAxis gateAxis;
+
+        /// Direction requirement on the gate axis. Actuators in single-axis mode with a
+        /// positive-only or negative-only direction produce output only when the sign of the
+        /// gate axis component matches; `Both` disables gating entirely.
+        EAxisDirection gateAxisDirection;
+      };
+
+      /// Compiles the flat per-actuator routing table for the specified force feedback actuator
+      /// map. Invoked once at construction time; the resulting table is immutable thereafter,
+      /// just like the actuator map itself.
+      /// @param [in] actuatorMap Force feedback actuator map for which to compile routes.
+      /// @return Compiled per-actuator routing table.
+      static std::array<SForceFeedbackActuatorRoute, (int)ForceFeedback::EActuator::Count>
+          ComputeForceFeedbackActuatorRoutes(const UForceFeedbackActuatorMap& actuatorMap);
+
+      /// Compiles the flat mapping table for the specified element map. Invoked once at
+      /// construction time; the resulting table is immutable thereafter, just like the element
+      /// map itself.
+      /// @param [in] elementMap Element map for which to compile a mapping table.
+      /// @return Compiled flat mapping table.
+      static std::vector<SMappingStep> CompileMappingSteps(const UElementMap& elementMap);
+
+      /// Determines whether or not the specified compiled mapping table supports incremental
+      /// mapping. Incremental mapping requires that every step use one of the directly-dispatched
+      /// concrete element mapper types, which are known to be free of side effects, and that no
+      /// two steps target the same virtual controller element, since aggregated contributions
+      /// cannot be individually reset.
+      /// @param [in] mappingSteps Compiled mapping table to analyze.
+      /// @return `true` if incremental mapping is supported, `false` otherwise.
+      static bool ComputeIncrementalMappingSupport(const std::vector<SMappingStep>& mappingSteps);
+
+      /// Compiles the specialized trivial mapping table for the specified compiled mapping table.
+      /// Succeeds only if every step uses a plain axis, button, or POV element mapper; mappers
+      /// that genuinely need split, invert, compound, or other custom element mapper behavior
+      /// keep using the general executor.
+      /// @param [in] mappingSteps Compiled mapping table from which to compile.
+      /// @return Specialized trivial mapping table, or an empty table if any step is not trivial.
+      static std::vector<STrivialMappingStep> CompileTrivialMappingSteps(
+          const std::vector<SMappingStep>& mappingSteps);
+
+      /// Executes every step of the specialized trivial mapping table against the specified
+      /// controller state. Behaviorally identical to #ExecuteMappingSteps for the mappers that
+      /// support it, but performs every contribution with inlined arithmetic and no calls into
+      /// element mapper objects. Must only be invoked if the trivial mapping table is non-empty.
+      /// @param [in,out] controllerState Controller state data structure to be updated.
+      /// @param [in] physicalState Physical controller state from which to read button values.
+      /// @param [in] analogValues Prepared analog stick values, ordered by input enumerator.
+      /// @param [in] triggerValues Prepared trigger values, ordered by input enumerator.
+      /// @param [in] consumedElements Mask of virtual controller elements that consumers actually
+      /// read. Steps targeting elements outside this mask are skipped.
+      void ExecuteTrivialMappingSteps(
+          SState& controllerState,
+          const SPhysicalState& physicalState,
+          const int16_t* analogValues,
+          const uint8_t* triggerValues,
+          TElementMask consumedElements) const;
+
+      /// Executes every step of the compiled mapping table against the specified controller state.
+      /// @param [in,out] controllerState Controller state data structure to be updated.
+      /// @param [in] physicalState Physical controller state from which to read button values.
+      /// @param [in] analogValues Prepared analog stick values, ordered by input enumerator.
+      /// @param [in] triggerValues Prepared trigger values, ordered by input enumerator.
+      /// @param [in] sourceControllerIdentifier Opaque identifier of the physical controller
+      /// associated with the state being mapped.
+      /// @param [in] consumedElements Mask of virtual controller elements that consumers actually
+      /// read. Steps that can only write elements outside this mask are skipped.
+      void ExecuteMappingSteps(
+          SState& controllerState,
+          const SPhysicalState& physicalState,
+          const int16_t* analogValues,
+          const uint8_t* triggerValues,
+          uint32_t sourceControllerIdentifier,
+          TElementMask consumedElements) const;
+
+      /// Arena that holds this mapper's entire element mapper object graph in contiguous memory.
+      /// Declared before #elements so that it is destroyed only after all of the element mappers
+      /// allocated from it have been destructed.
+      ElementMapperArena elementMapperArena;
+
       /// All controller element mappers.
       const UElementMap elements;
 
       /// All force feedback actuator mappings.
       const UForceFeedbackActuatorMap forceFeedbackActuators;
 
+      /// Compiled per-actuator routing table for the force feedback actuator map.
+      /// Initialization of this member depends on prior initialization of
+      /// #forceFeedbackActuators so it must come after.
+      const std::array<SForceFeedbackActuatorRoute, (int)ForceFeedback::EActuator::Count>
+          forceFeedbackActuatorRoutes;
+
       /// Capabilities of the controller described by the element mappers in aggregate.
       /// Initialization of this member depends on prior initialization of #elements so it
       /// must come after.
       const SCapabilities capabilities;
 
+      /// Compiled flat mapping table for the element map. Initialization of this member depends
+      /// on prior initialization of #elements so it must come after.
+      const std::vector<SMappingStep> mappingSteps;
+
+      /// Whether or not the compiled mapping table supports incremental mapping. Initialization
+      /// of this member depends on prior initialization of #mappingSteps so it must come after.
+      const bool mappingStepsSupportIncremental;
+
+      /// Specialized trivial mapping table, empty if this mapper's element map contains any
+      /// element mapper that is not trivial. Initialization of this member depends on prior
+      /// initialization of #mappingSteps so it must come after.
+      const std::vector<STrivialMappingStep> trivialMappingSteps;
+
+      /// Fully-inlined mapping executor generated at compile time from this mapper's element map
+      /// definition, or `nullptr` for mappers that use the runtime-compiled mapping tables. When
+      /// present, full state mapping passes invoke it instead of walking any mapping table.
+      const TInlinedMappingExecutor inlinedMappingExecutor;
+
+      /// Per-controller incremental mapping caches, indexed by physical controller identifier.
+      /// Mutable because caching a previous mapping pass does not change the observable behavior
+      /// of this object.
+      mutable SIncrementalMappingState incrementalMappingState[kPhysicalControllerCount];
+
       /// Name of this mapper.
       const std::wstring_view name;
     };
@@ -185,6 +185,21 @@ namespace Xidi
       /// @return `true` if successful, `false` otherwise.
       bool InvalidateBlueprint(std::wstring_view mapperName);
 
+      /// Reopens a blueprint for modification so that it can be rebuilt, supporting incremental
+      /// rebuilds in which only the blueprints whose definitions changed are reconstructed. If the
+      /// blueprint was already built, the mapper object registered under its name is retired from
+      /// the registry, making the name available to the replacement mapper. Blueprints that were
+      /// never built, and blueprints previously marked invalid, are simply made buildable again.
+      /// Blueprints that name the reopened blueprint as a template are not cascaded automatically;
+      /// callers that want dependents rebuilt against the replacement must reopen them too. After
+      /// reopening and modifying the desired blueprints, a subsequent call to #Build rebuilds only
+      /// those blueprints, leaving all other registered mappers untouched. This method will fail
+      /// if the mapper name does not identify an existing blueprint.
+      /// @param [in] mapperName Name that identifies the mapper described by a possibly-existing
+      /// blueprint.
+      /// @return `true` if successful, `false` otherwise.
+      bool ReopenBlueprint(std::wstring_view mapperName);
+
       /// Sets a specific element mapper to be applied as a modification to the template when this
       /// object is built into a mapper. If `nullptr` is specified, then the modification to be
       /// applied to the template is element mapper removal. Use #ClearBlueprintElementMapper to
@@ -102,6 +102,13 @@ namespace Xidi
       std::optional<unsigned int> FindForceFeedbackActuatorIndex(
           std::wstring_view ffActuatorString);
 
+      /// Releases the element mapper prototype cache, which exists to speed up parsing of
+      /// repeated element mapper strings during custom mapper construction and is not needed once
+      /// construction is complete. Intended to be invoked after initialization when operating in
+      /// low-memory mode. Safe to invoke at any time; a cleared cache is simply repopulated on
+      /// demand.
+      void ClearParsedPrototypeCache(void);
+
       /// Attempts to build an element mapper using the supplied string.
       /// This is the main entry point intended for use when parsing element mappers from strings.
       /// @param [in] elementMapperString Input string supposedly representing an element mapper.
@@ -0,0 +1,65 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file MemoryAccounting.h
+ *   Declaration of per-subsystem live memory accounting and of the low-memory operating mode.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace Xidi
+{
+  namespace MemoryAccounting
+  {
+    /// Enumerates the subsystems for which live memory is tracked. Subsystems that own their
+    /// backing storage outright report exact byte counts; cache-like subsystems report estimates
+    /// covering their keys and stored values but not container bookkeeping overhead.
+    enum class ESubsystem : unsigned int
+    {
+      /// Committed ring storage backing state change event buffers.
+      EventBuffers,
+
+      /// Arena chunks backing element mapper object graphs.
+      MapperObjects,
+
+      /// Element mapper prototype cache retained by the mapper parser.
+      ParseCaches,
+
+      /// Cached per-device XInput support check results.
+      IdentityCaches,
+
+      /// Sentinel value, total number of tracked subsystems.
+      Count
+    };
+
+    /// Records that the specified subsystem allocated the specified number of bytes.
+    /// @param [in] subsystem Subsystem that performed the allocation.
+    /// @param [in] numBytes Number of bytes allocated.
+    void RecordAllocation(ESubsystem subsystem, uint64_t numBytes);
+
+    /// Records that the specified subsystem released the specified number of bytes. Must be
+    /// balanced against prior allocation records for the same subsystem.
+    /// @param [in] subsystem Subsystem that performed the release.
+    /// @param [in] numBytes Number of bytes released.
+    void RecordRelease(ESubsystem subsystem, uint64_t numBytes);
+
+    /// Retrieves the number of bytes currently held live by the specified subsystem.
+    /// @param [in] subsystem Subsystem of interest.
+    /// @return Number of bytes currently held live.
+    uint64_t GetLiveBytes(ESubsystem subsystem);
+
+    /// Determines whether low-memory mode is enabled for this process. In low-memory mode,
+    /// subsystems cap their buffer sizes and release or bound structures that exist purely to
+    /// speed up repeated operations. The mode is read from the configuration file once and
+    /// latched for the lifetime of the process, because the caps it controls are applied as
+    /// structures are created and cannot meaningfully be revisited afterwards.
+    /// @return `true` if low-memory mode is enabled, `false` otherwise.
+    bool IsLowMemoryModeEnabled(void);
+  } // namespace MemoryAccounting
+} // namespace Xidi
@@ -14,6 +14,9 @@
 
 #include <cstdint>
 #include <optional>
+#include <vector>
+
+#include "ApiWindows.h"
 
 namespace Xidi
 {
@@ -80,6 +83,22 @@ namespace Xidi
       Count
     };
 
+    /// Appends a mouse input event to the supplied buffer for every mouse button whose state has
+    /// changed since the previous invocation, consuming all pending button contributions in the
+    /// process, followed by movement events for any mouse axes with non-neutral contribution
+    /// sums. Button and wheel events flush on every invocation; the movement pass self-paces to
+    /// the mouse update period and scales motion by elapsed time, so invoking this function more
+    /// frequently than the update period flushes discrete events sooner without changing pointer
+    /// speed. Intended to be invoked only by the input dispatch thread.
+    /// @param [in,out] inputEvents Buffer to which input events are appended.
+    /// @param [in] forceNeutralState If `true`, all pressed buttons transition to released and
+    /// movement is suppressed regardless of pending contributions. Used on loss of input focus
+    /// and on shutdown.
+    /// @return `true` if any mouse buttons remain pressed or any movement is in progress,
+    /// meaning the dispatch thread needs to keep cycling periodically, or `false` if it is safe
+    /// to block until the next contribution.
+    bool AppendPendingMouseEvents(std::vector<INPUT>& inputEvents, bool forceNeutralState);
+
     /// Submits a mouse button state of pressed.
     /// @param [in] button Mouse button that is affected.
     void SubmitMouseButtonPressedState(EMouseButton button);
@@ -0,0 +1,28 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file PerformanceSummary.h
+ *   Declaration of the per-session performance summary emitted when the Xidi library is
+ *   unloaded. The summary aggregates counters that the metrics subsystems already maintain on
+ *   their hot paths, so producing it adds no steady-state cost whatsoever; all aggregation work
+ *   happens once at process detach time.
+ **************************************************************************************************/
+
+#pragma once
+
+namespace Xidi
+{
+  namespace PerformanceSummary
+  {
+    /// Aggregates the cumulative counters maintained by the registered metrics providers and
+    /// emits a compact per-session performance summary to the log: polling loop activity, input
+    /// pipeline latency percentiles, event buffer drop accounting, keyboard and mouse synthesis
+    /// totals, and live memory by subsystem. Providers not registered in the running Xidi form
+    /// are silently skipped. Intended to be invoked exactly once, during DLL process detach.
+    void EmitSessionSummary(void);
+  } // namespace PerformanceSummary
+} // namespace Xidi
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <stop_token>
 
 #include "ApiWindows.h"
@@ -22,9 +23,18 @@ namespace Xidi
 {
   namespace Controller
   {
-    /// Number of milliseconds to wait between polling attempts.
+    /// Number of milliseconds to wait between polling attempts when no consumer read cadence has
+    /// been established.
     inline constexpr unsigned int kPhysicalPollingPeriodMilliseconds = 5;
 
+    /// Shortest number of milliseconds to wait between polling attempts when adapting the polling
+    /// period to the consumer read cadence.
+    inline constexpr unsigned int kPhysicalPollingPeriodMinMilliseconds = 1;
+
+    /// Longest number of milliseconds to wait between polling attempts when adapting the polling
+    /// period to the consumer read cadence.
+    inline constexpr unsigned int kPhysicalPollingPeriodMaxMilliseconds = 16;
+
     /// Number of milliseconds to wait between force feedback actuation passes.
     inline constexpr unsigned int kPhysicalForceFeedbackPeriodMilliseconds = 5;
 
@@ -32,6 +42,24 @@ namespace Xidi
     /// the last attempt resulted in an error, such as the controller being disconnected.
     inline constexpr unsigned int kPhysicalErrorBackoffPeriodMilliseconds = 100;
 
+    /// Ensures that physical controller state data structures are initialized and the worker
+    /// threads that service them are created, all of which otherwise happens on first use. The
+    /// polling threads remain parked until a consumer registers demand, so this does not cause any
+    /// hardware polling by itself. Intended to be invoked from a background thread during startup
+    /// so that an application's first controller access does not pay the initialization cost.
+    /// Mapper selection happens during initialization, so the configuration file must already have
+    /// been read before this function is invoked. Concurrency-safe.
+    void EnsurePhysicalControllersInitialized(void);
+
+    /// Retrieves a process-wide coarse timestamp, in milliseconds and in the same units as the
+    /// system multimedia timer. The timestamp is refreshed once per polling pass, so while polling
+    /// is active its staleness is bounded by one polling period. Intended for consumers that stamp
+    /// work items at polling cadence, such as buffered event generation, and would otherwise pay
+    /// an imported-function call for each timestamp. Falls back to querying the system timer
+    /// directly if no polling pass has published a timestamp yet. Concurrency-safe.
+    /// @return Coarse timestamp in milliseconds.
+    uint32_t GetCoarseTimestampMilliseconds(void);
+
     /// Retrieves and returns the capabilities of the controller layout implemented by the mapper
     /// associated with the specified physical controller. Controller capabilities act as metadata
     /// that are used internally and can be presented to applications. Concurrency-safe.
@@ -43,6 +71,13 @@ namespace Xidi
     /// @return Physical controller state data.
     SPhysicalState GetCurrentPhysicalControllerState(TControllerIdentifier controllerIdentifier);
 
+    /// Retrieves the current device change notification generation value, which increments
+    /// whenever the system reports that hardware has arrived or been removed. Intended for
+    /// consumers that cache device enumeration results and need to know when to invalidate them.
+    /// Ensures the device change notification monitor is running. Concurrency-safe.
+    /// @return Current device change notification generation value.
+    uint32_t GetDeviceChangeNotificationGeneration(void);
+
     /// Retrieves the instantaneous raw state of the specified controller after it is mapped to a
     /// virtual state but without any further processing. Concurrency-safe.
     /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
@@ -66,6 +101,46 @@ namespace Xidi
     void PhysicalControllerForceFeedbackUnregister(
         TControllerIdentifier controllerIdentifier, const VirtualController* virtualController);
 
+    /// Notifies the physical controller layer that the device-wide force feedback gain property
+    /// of a virtual controller registered with the specified physical controller has changed, so
+    /// that the cached combined gain can be recomputed. Concurrency-safe.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    void PhysicalControllerForceFeedbackGainChanged(TControllerIdentifier controllerIdentifier);
+
+    /// Registers demand for physical controller state polling. While at least one registered
+    /// consumer exists the polling threads actively poll the hardware, and while none exist they
+    /// are parked and consume essentially no CPU time. Invoked automatically whenever a virtual
+    /// controller object is created. Concurrency-safe.
+    void PhysicalControllerPollingDemandRegister(void);
+
+    /// Unregisters previously-registered demand for physical controller state polling. Invoked
+    /// automatically whenever a virtual controller object is destroyed. Concurrency-safe.
+    void PhysicalControllerPollingDemandUnregister(void);
+
+    /// Registers the set of virtual controller elements a consumer reads from the specified
+    /// physical controller. The mapping pass skips element mappers whose targets no registered
+    /// consumer reads, so a consumer that reads only a few elements, paired with no other
+    /// consumers, pays mapping cost for only those elements. Each registration must eventually be
+    /// balanced by exactly one unregistration with the same mask. Concurrency-safe.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @param [in] elements Mask of virtual controller elements the consumer reads.
+    void PhysicalControllerConsumedElementsRegister(
+        TControllerIdentifier controllerIdentifier, TElementMask elements);
+
+    /// Unregisters a previously-registered set of consumed virtual controller elements.
+    /// Concurrency-safe.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @param [in] elements Mask of virtual controller elements previously registered.
+    void PhysicalControllerConsumedElementsUnregister(
+        TControllerIdentifier controllerIdentifier, TElementMask elements);
+
+    /// Notes that a consumer has just read the state of the specified physical controller. The
+    /// intervals between consumer reads determine the cadence to which the polling period for that
+    /// controller adapts, bounded below by #kPhysicalPollingPeriodMinMilliseconds and above by
+    /// #kPhysicalPollingPeriodMaxMilliseconds. Concurrency-safe.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    void PhysicalControllerMarkConsumerRead(TControllerIdentifier controllerIdentifier);
+
     /// Waits for the specified physical controller's state to change. When it does, retrieves and
     /// returns the new state. This function is fully concurrency-safe. If needed, the caller can
     /// interrupt the wait using a stop token.
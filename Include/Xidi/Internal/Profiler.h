@@ -0,0 +1,129 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file Profiler.h
+ *   Declaration of sampling profiler hooks for hot-path code. Instrumented sites measure
+ *   processor cycles for a configurable fraction of their invocations, with per-thread
+ *   decimation counters so that the common unsampled invocation costs no synchronization at all.
+ *   Aggregated samples are exposed externally through the #Api::IInputMetrics interface. Defining
+ *   XIDI_SKIP_PROFILING compiles all instrumentation out entirely.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef XIDI_SKIP_PROFILING
+#include <intrin.h>
+#endif
+
+namespace Xidi
+{
+  namespace Profiler
+  {
+    /// Enumerates all instrumented hot-path sites. Enumerator order defines the site indices used
+    /// when aggregated samples are exposed through the #Api::IInputMetrics interface, so it
+    /// cannot be changed.
+    enum class EProfileSite : unsigned int
+    {
+      /// Mapper pass that transforms physical controller state into virtual controller state.
+      MapperStateMapping,
+
+      /// Data format pass that writes virtual controller state into an application data packet.
+      DataPacketWrite,
+
+      /// Keyboard synthesis pass that turns pending key state changes into input events.
+      KeyboardSynthesis,
+
+      /// Mouse synthesis pass that turns pending mouse state changes into input events.
+      MouseSynthesis,
+
+      /// Sentinel value, total number of enumerators.
+      Count
+    };
+
+    /// Aggregated cycle samples for a single instrumented site.
+    struct SSiteSamples
+    {
+      /// Number of invocations that were sampled.
+      uint64_t sampleCount;
+
+      /// Total processor cycles measured across all sampled invocations.
+      uint64_t totalCycles;
+
+      /// Largest number of processor cycles measured for any single sampled invocation.
+      uint64_t maximumCycles;
+    };
+
+#ifndef XIDI_SKIP_PROFILING
+    /// Determines whether the current invocation of the specified site should be sampled, based
+    /// on the configured sampling interval and the calling thread's decimation counter. Costs a
+    /// single branch when profiling is disabled by configuration.
+    /// @param [in] site Instrumented site being invoked.
+    /// @return `true` if the invocation should be sampled, `false` otherwise.
+    bool ShouldSample(EProfileSite site);
+
+    /// Submits a measured cycle sample for the specified site.
+    /// @param [in] site Instrumented site that was sampled.
+    /// @param [in] elapsedCycles Processor cycles measured for the sampled invocation.
+    void Submit(EProfileSite site, uint64_t elapsedCycles);
+
+    /// Retrieves the aggregated samples for the specified site.
+    /// @param [in] site Instrumented site of interest.
+    /// @return Aggregated sample structure.
+    SSiteSamples GetSiteSamples(EProfileSite site);
+
+    /// Measures the processor cycles spent in a scope at an instrumented site, for invocations
+    /// selected by the sampling interval. Intended to be placed at the top of an instrumented
+    /// function.
+    class ScopedSample
+    {
+    public:
+
+      inline ScopedSample(EProfileSite site)
+          : site(site), isActive(ShouldSample(site)), startCycles(isActive ? __rdtsc() : 0)
+      {}
+
+      inline ~ScopedSample(void)
+      {
+        if (true == isActive) Submit(site, (__rdtsc() - startCycles));
+      }
+
+      ScopedSample(const ScopedSample& other) = delete;
+
+    private:
+
+      /// Instrumented site being measured.
+      const EProfileSite site;
+
+      /// Whether this particular invocation was selected for sampling.
+      const bool isActive;
+
+      /// Cycle counter value at scope entry, valid only if this invocation is being sampled.
+      const uint64_t startCycles;
+    };
+#else
+    /// No-op form of the scoped cycle measurement object, used when all profiling instrumentation
+    /// is compiled out.
+    class ScopedSample
+    {
+    public:
+
+      inline ScopedSample(EProfileSite site) {}
+
+      ScopedSample(const ScopedSample& other) = delete;
+    };
+
+    /// No-op form of the aggregated sample retrieval function, used when all profiling
+    /// instrumentation is compiled out.
+    inline SSiteSamples GetSiteSamples(EProfileSite site)
+    {
+      return {};
+    }
+#endif
+  } // namespace Profiler
+} // namespace Xidi
@@ -0,0 +1,131 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file RateLimitedLogging.h
+ *   Declaration of per-call-site message rate limiting. Applications that misuse the DirectInput
+ *   API in a loop, for example by repeatedly invoking a method in a state in which it can only
+ *   fail, would otherwise cause the same message to be formatted and output thousands of times
+ *   per second, at which point the logging itself becomes the performance problem. Rate-limited
+ *   call sites emit a bounded number of messages per time window and summarize whatever was
+ *   suppressed in between, so worst-case logging overhead is bounded regardless of application
+ *   behavior.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+
+/// Outputs a formatted message subject to per-call-site rate limiting. Each textual expansion of
+/// this macro maintains its own independent rate limiter state, and suppressed messages are
+/// summarized with a repeat count the next time the call site is permitted to output.
+#define XIDI_RATE_LIMITED_OUTPUT_FORMATTED(severity, format, ...)                                  \
+  do                                                                                               \
+  {                                                                                                \
+    if (true == Infra::Message::WillOutputMessageOfSeverity(severity))                             \
+    {                                                                                              \
+      static ::Xidi::RateLimitedLogging::SCallSiteState callSiteState;                             \
+      uint32_t numSuppressedMessages = 0;                                                          \
+      if (true ==                                                                                  \
+          ::Xidi::RateLimitedLogging::ShouldOutput(callSiteState, numSuppressedMessages))          \
+      {                                                                                            \
+        if (0 != numSuppressedMessages)                                                            \
+          Infra::Message::OutputFormatted(                                                         \
+              severity,                                                                            \
+              L"%s: Message repeated %u more time(s) while suppressed by rate limiting.",          \
+              __FUNCTIONW__ L"()",                                                                 \
+              numSuppressedMessages);                                                              \
+        Infra::Message::OutputFormatted(severity, format, ##__VA_ARGS__);                          \
+      }                                                                                            \
+    }                                                                                              \
+  }                                                                                                \
+  while (false)
+
+namespace Xidi
+{
+  namespace RateLimitedLogging
+  {
+    /// Length of the time window within which a single call site's message output is limited, in
+    /// milliseconds.
+    inline constexpr uint64_t kWindowLengthMilliseconds = 1000;
+
+    /// Maximum number of messages a single call site can output per time window. Messages beyond
+    /// this limit are counted and summarized instead of being output.
+    inline constexpr uint32_t kMaxMessagesPerWindow = 5;
+
+    /// Per-call-site rate limiter state. One instance exists per rate-limited call site, declared
+    /// as a function-local static by the rate limiting macros. All fields are atomic so that
+    /// concurrent invocations of the same call site never block one another; under contention the
+    /// counts are approximate, which is acceptable for deciding whether to log.
+    struct SCallSiteState
+    {
+      /// Timestamp of the start of the current time window, or 0 if no window has started yet.
+      std::atomic<uint64_t> windowStartTimeMilliseconds = 0;
+
+      /// Number of messages attributed to the current time window, including suppressed ones.
+      std::atomic<uint32_t> numMessagesThisWindow = 0;
+
+      /// Number of messages suppressed since the last message that was actually output.
+      std::atomic<uint32_t> numSuppressedMessages = 0;
+    };
+
+    /// Determines whether a rate-limited call site is permitted to output a message, updating the
+    /// call site state accordingly. When output is permitted, the number of messages suppressed
+    /// since the last permitted output is returned through the output parameter so the caller can
+    /// summarize them.
+    /// @param [in,out] callSiteState Rate limiter state for the call site.
+    /// @param [out] numSuppressedMessages Filled with the number of suppressed messages being
+    /// reclaimed by this output, or 0 if none were suppressed. Only meaningful when this function
+    /// returns `true`.
+    /// @param [in] timestamp Optional current timestamp, in milliseconds. Defaults to the current
+    /// system uptime, with the parameter itself existing primarily for tests.
+    /// @return `true` if the call site is permitted to output a message, `false` if the message
+    /// should be suppressed.
+    inline bool ShouldOutput(
+        SCallSiteState& callSiteState,
+        uint32_t& numSuppressedMessages,
+        std::optional<uint64_t> timestamp = std::nullopt)
+    {
+      const uint64_t currentTimeMilliseconds = timestamp.value_or(GetTickCount64());
+
+      uint64_t windowStartTimeMilliseconds =
+          callSiteState.windowStartTimeMilliseconds.load(std::memory_order_relaxed);
+
+      if ((0 == windowStartTimeMilliseconds) ||
+          ((currentTimeMilliseconds - windowStartTimeMilliseconds) >= kWindowLengthMilliseconds))
+      {
+        // Only one thread wins the race to open a new window. Losers fall through and are
+        // counted against the window the winner just opened.
+        if (true ==
+            callSiteState.windowStartTimeMilliseconds.compare_exchange_strong(
+                windowStartTimeMilliseconds, currentTimeMilliseconds, std::memory_order_relaxed))
+        {
+          callSiteState.numMessagesThisWindow.store(1, std::memory_order_relaxed);
+          numSuppressedMessages =
+              callSiteState.numSuppressedMessages.exchange(0, std::memory_order_relaxed);
+          return true;
+        }
+      }
+
+      if (callSiteState.numMessagesThisWindow.fetch_add(1, std::memory_order_relaxed) <
+          kMaxMessagesPerWindow)
+      {
+        numSuppressedMessages =
+            callSiteState.numSuppressedMessages.exchange(0, std::memory_order_relaxed);
+        return true;
+      }
+
+      callSiteState.numSuppressedMessages.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } // namespace RateLimitedLogging
+} // namespace Xidi
@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <string_view>
+#include <vector>
+
 #include <Hookshot/StaticHook.h>
 
 #include "ApiWindows.h"
@@ -23,6 +26,62 @@ namespace Xidi
   /// @param [in] setHookResult Result returned from Hookshot of the attempt to set the hook.
   void OutputSetHookResult(const wchar_t* functionName, Hookshot::EResult setHookResult);
 
+  /// Collects hook sites so that they can be installed together as a single batch. Hook sites are
+  /// prepared up front by resolving all of the addresses involved, which requires no code
+  /// patching, and are then committed in one tight pass. Hookshot installs each hook within its
+  /// own code-patching synchronization window, so committing this way keeps address resolution
+  /// and logging out of those windows and minimizes the time during which the overall hook set is
+  /// only partially installed, however many hooks are added to the batch.
+  class HookBatch
+  {
+  public:
+
+    /// Describes a single hook site that is part of a batch.
+    struct SHookSite
+    {
+      /// Name of the function being hooked. Used for logging.
+      std::wstring_view functionName;
+
+      /// Address of the original function that should be hooked.
+      void* originalFunc;
+
+      /// Hook function that should be invoked instead of the original function.
+      const void* hookFunc;
+
+      /// Result of the installation attempt. Valid only once the batch has been committed.
+      Hookshot::EResult result;
+    };
+
+    inline HookBatch(Hookshot::IHookshot* hookshot) : hookshot(hookshot), hookSites() {}
+
+    /// Adds a hook site to the batch. No code patching takes place until the batch is committed.
+    /// @param [in] functionName Name of the function being hooked, used for logging. The
+    /// underlying string must remain valid for the lifetime of the batch object.
+    /// @param [in] originalFunc Address of the function that should be hooked.
+    /// @param [in] hookFunc Hook function that should be invoked instead.
+    void Prepare(std::wstring_view functionName, void* originalFunc, const void* hookFunc);
+
+    /// Installs all prepared hook sites back-to-back and then logs the result of each attempt.
+    /// @return Number of hook sites that were successfully installed.
+    size_t Commit(void);
+
+    /// Provides read-only access to the hook sites in this batch, including per-site results once
+    /// the batch has been committed.
+    /// @return Read-only reference to the container of hook sites.
+    inline const std::vector<SHookSite>& GetHookSites(void) const
+    {
+      return hookSites;
+    }
+
+  private:
+
+    /// Hookshot interface pointer used to commit the batch.
+    Hookshot::IHookshot* hookshot;
+
+    /// Holds all hook sites prepared so far, in preparation order.
+    std::vector<SHookSite> hookSites;
+  };
+
   /// Sets all hooks and replaces Xidi import functions for the specified library.
   /// @param [in] hookshot Hookshot interface pointer.
   /// @param [in] apiImportFunctions Xidi API interface pointer for replacing Xidi's imported
@@ -37,9 +96,9 @@ namespace Xidi
   /// find it in the main Xidi library.
   void SetHooksForLibrary(
       Hookshot::IHookshot* hookshot,
-      Api::IImportFunctions2* apiImportFunctions,
+      Api::IImportFunctions3* apiImportFunctions,
       HMODULE xidiLibraryHandle,
-      Api::IImportFunctions2::ELibrary libraryIdentifier,
+      Api::IImportFunctions3::ELibrary libraryIdentifier,
       const wchar_t* libraryName,
       const wchar_t* libraryFilename,
       const wchar_t* replacementFunctionPrefix);
@@ -47,6 +106,13 @@ namespace Xidi
   /// Sets a hook on the COM function `CoCreateInstance`.
   /// @param [in] hookshot Hookshot interface pointer.
   void SetHookCoCreateInstance(Hookshot::IHookshot* hookshot);
+
+  /// Ensures that the hook module's global initialization has been started. The hook module is
+  /// injected into processes indiscriminately, so instead of initializing from its DLL entry
+  /// point it defers that work until one of its hooks first observes DirectInput or WinMM
+  /// activity, and processes that exhibit neither pay only for hook stub installation.
+  /// Idempotent and concurrency-safe.
+  void EnsureHookModuleInitialized(void);
 } // namespace Xidi
 
 // Windows API: CoCreateInstance
@@ -0,0 +1,58 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file SharedPhysicalState.h
+ *   Declaration of opt-in cross-process sharing of physical controller state. When multiple
+ *   processes on the same desktop each load Xidi, every one of them ordinarily runs its own
+ *   polling pipeline against the same physical controller slots. In shared mode the first
+ *   instance to start is elected the poller and publishes its physical state snapshots into a
+ *   named shared-memory segment, and all other instances read those snapshots wait-free using
+ *   the same seqlock scheme as #ConcurrencyWrapper instead of issuing their own driver calls.
+ **************************************************************************************************/
+
+#pragma once
+
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace SharedPhysicalState
+  {
+    /// Determines whether shared physical state mode is enabled by configuration and the shared
+    /// segment was successfully set up, performing the poller election and segment mapping on
+    /// first call. Not safe to call from a DLL entry point.
+    /// @return `true` if shared mode is active for this process, `false` otherwise.
+    bool IsSharedModeActive(void);
+
+    /// Determines whether this process was elected the poller for the shared segment. Only
+    /// meaningful when shared mode is active.
+    /// @return `true` if this process publishes snapshots to the shared segment, `false` if it
+    /// consumes them.
+    bool IsPoller(void);
+
+    /// Publishes a physical state snapshot to the shared segment. Intended to be invoked by the
+    /// polling thread for every completed poll. No effect unless this process is the active
+    /// poller.
+    /// @param [in] controllerIdentifier Identifier of the physical controller that was polled.
+    /// @param [in] physicalState Physical state snapshot to publish.
+    void PublishPhysicalState(
+        Controller::TControllerIdentifier controllerIdentifier,
+        const Controller::SPhysicalState& physicalState);
+
+    /// Attempts a wait-free read of the latest physical state snapshot from the shared segment.
+    /// Succeeds only for consumer processes while the poller is alive and actively publishing,
+    /// so a caller that receives `false` should fall back to reading the controller hardware
+    /// directly.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @param [out] physicalState Filled with the snapshot read from the shared segment, if
+    /// successful.
+    /// @return `true` if a fresh snapshot was read from the shared segment, `false` otherwise.
+    bool TryReadSharedPhysicalState(
+        Controller::TControllerIdentifier controllerIdentifier,
+        Controller::SPhysicalState& physicalState);
+  } // namespace SharedPhysicalState
+} // namespace Xidi
@@ -11,10 +11,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <bit>
 #include <cstdint>
+#include <span>
 
-#include <boost/circular_buffer.hpp>
-
+#include "ApiWindows.h"
 #include "ControllerTypes.h"
 
 namespace Xidi
@@ -22,8 +24,14 @@ namespace Xidi
   namespace Controller
   {
     /// Implements a state change event buffer for a virtual controller. Used for providing buffered
-    /// event functionality. Methods are not concurrency-safe, so some form of external concurrency
-    /// control is required. Behavior is modelled after DirectInput buffered event documentation.
+    /// event functionality. Internally this is a lock-free ring buffer with power-of-two storage,
+    /// safe for concurrent use by a single producer (appending events) and a single consumer
+    /// (reading and popping events), so event delivery does not serialize against state refresh.
+    /// Storage is backed by a per-buffer arena whose address space is reserved lazily on first
+    /// enable and whose pages are committed on demand, so capacity changes never perform heap
+    /// allocation. Capacity changes are still not concurrency-safe and require external
+    /// concurrency control, as do bulk operations that must observe a consistent view across
+    /// multiple method calls. Behavior is modelled after DirectInput buffered event documentation.
     /// For example, number of events stored is artificially limited to one less than declared
     /// capacity.
     class StateChangeEventBuffer
@@ -86,44 +94,159 @@ namespace Xidi
         /// respect to all other input events, but in practice it is locally monotonic with respect
         /// to all virtual controller events.
         uint32_t sequence;
+
+        /// Timestamp, in QueryPerformanceCounter units, at which the physical hardware snapshot
+        /// that produced this event was captured. Used for end-to-end latency accounting.
+        int64_t captureTimestamp;
       };
 
-      static_assert(sizeof(SEvent) <= 16, "Data structure size constraint violation.");
+      static_assert(sizeof(SEvent) <= 24, "Data structure size constraint violation.");
+
+      /// Read-only view of events currently present in the buffer, in chronological order.
+      /// Because the underlying storage is a ring, the events may wrap around the end of storage,
+      /// in which case they are described by two contiguous pieces. If no wraparound occurs the
+      /// second piece is empty.
+      struct SEventSpans
+      {
+        /// First, and possibly only, contiguous piece of events, oldest first.
+        std::span<const SEvent> first;
+
+        /// Second contiguous piece of events, present only if the events wrap around the end of
+        /// the underlying ring storage.
+        std::span<const SEvent> second;
+
+        /// Retrieves and returns the total number of events described by this view.
+        /// @return Total event count across both pieces.
+        inline uint32_t Count(void) const
+        {
+          return (uint32_t)(first.size() + second.size());
+        }
+      };
 
       /// Maximum allowed event buffer capacity, measured in number of events. Computed to allow a
-      /// maximum of 1MB for event storage.
+      /// maximum of 1MB for committed event storage.
       static constexpr uint32_t kEventBufferCapacityMax = (1024 * 1024) / sizeof(SEvent);
 
+      /// Maximum allowed event buffer capacity while low-memory mode is enabled, measured in
+      /// number of events. Computed to allow a maximum of 64kB for committed event storage.
+      static constexpr uint32_t kEventBufferCapacityLowMemoryMax = (64 * 1024) / sizeof(SEvent);
+
+      /// Number of event slots in the storage arena address space reservation. Sized to the
+      /// smallest power of two that can hold the maximum capacity so that ring positions can
+      /// always be turned into storage indices with a mask operation. Only address space is
+      /// reserved at this size; pages are committed on demand up to the current capacity.
+      static constexpr uint32_t kEventStorageSlotsMax = std::bit_ceil(kEventBufferCapacityMax);
+
       /// Constructs an empty event buffer with capacity of 0, which means this event buffer is
-      /// disabled until it is enabled by request.
-      inline StateChangeEventBuffer(void) : eventBuffer(), eventBufferOverflowed() {}
+      /// disabled until it is enabled by request. No storage is reserved until first enabled.
+      inline StateChangeEventBuffer(void)
+          : eventStorage(nullptr),
+            eventStorageSize(0),
+            eventStorageNumCommitted(0),
+            eventBufferCapacity(0),
+            headIndex(0),
+            tailIndex(0),
+            eventBufferOverflowed(false),
+            totalOverflowCount(0),
+            totalDroppedEventCount(0),
+            totalCoalescedEventCount(0),
+            eventCountHighWaterMark(0),
+            eventCoalescingEnabled(false)
+      {}
+
+      StateChangeEventBuffer(const StateChangeEventBuffer& other) = delete;
+
+      ~StateChangeEventBuffer(void);
 
       /// Allows read-only access to events by index, without performing any bounds-checking. Event
-      /// with index 0 is the oldest, and higher indices indicate more recent events.
+      /// with index 0 is the oldest, and higher indices indicate more recent events. To prevent the
+      /// event buffer from overwriting events while accessing multiple of them, the caller should
+      /// either pop events as they are consumed or obtain the associated virtual controller's lock.
       /// @param [in] index Index of the desired event.
       /// @return Read-only reference to the event at the desired index.
       inline const SEvent& operator[](uint32_t index) const
       {
-        return eventBuffer[index];
+        return eventStorage
+            [(headIndex.load(std::memory_order_acquire) + index) & (eventStorageSize - 1)];
+      }
+
+      /// Allocates a contiguous range of globally-ordered event sequence numbers using a single
+      /// synchronized operation. Intended for producers that fan a single state refresh out into
+      /// multiple events: allocating the whole range up front and assigning sequence numbers
+      /// locally avoids one synchronized operation per event while preserving global sequence
+      /// number monotonicity.
+      /// @param [in] numSequenceNumbers Number of sequence numbers to allocate.
+      /// @return First sequence number of the allocated range, with subsequent numbers following
+      /// consecutively.
+      static uint32_t AllocateSequenceRange(uint32_t numSequenceNumbers);
+
+      /// Appends a single event to the event buffer, given its data. The event is assigned the
+      /// next globally-ordered sequence number automatically.
+      /// @param [in] eventData Event data to append.
+      /// @param [in] timestamp Timestamp to apply to the appended event.
+      /// @param [in] captureTimestamp Optional hardware capture timestamp, in
+      /// QueryPerformanceCounter units, to apply to the appended event.
+      inline void AppendEvent(SEventData eventData, uint32_t timestamp, int64_t captureTimestamp = 0)
+      {
+        AppendEvent(eventData, timestamp, AllocateSequenceRange(1), captureTimestamp);
       }
 
-      /// Appends a single event to the event buffer, given its data.
+      /// Appends a single event to the event buffer, given its data and an explicitly-assigned
+      /// sequence number previously obtained from #AllocateSequenceRange.
       /// @param [in] eventData Event data to append.
       /// @param [in] timestamp Timestamp to apply to the appended event.
-      void AppendEvent(SEventData eventData, uint32_t timestamp);
+      /// @param [in] sequence Sequence number to apply to the appended event.
+      /// @param [in] captureTimestamp Optional hardware capture timestamp, in
+      /// QueryPerformanceCounter units, to apply to the appended event.
+      void AppendEvent(
+          SEventData eventData, uint32_t timestamp, uint32_t sequence, int64_t captureTimestamp = 0);
 
       /// Retrieves and returns the capacity of this event buffer.
       /// @return Event buffer capacity.
       inline uint32_t GetCapacity(void) const
       {
-        return (uint32_t)eventBuffer.capacity();
+        return eventBufferCapacity;
       }
 
       /// Retrieves and returns the number of events currently present in this event buffer.
       /// @return Event count in this event buffer.
       inline uint32_t GetCount(void) const
       {
-        return (uint32_t)eventBuffer.size();
+        // Head is loaded before tail so that a concurrent append can never cause the computed
+        // count to go negative, only to momentarily include the event being appended.
+        const uint32_t head = headIndex.load(std::memory_order_acquire);
+        const uint32_t tail = tailIndex.load(std::memory_order_acquire);
+        return (tail - head);
+      }
+
+      /// Retrieves a read-only view of up to the specified number of the oldest events currently
+      /// present in the buffer, without copying them. The view refers directly into the ring
+      /// storage, so to prevent the event buffer from overwriting events while the view is in use
+      /// the caller should either pop events as they are consumed or obtain the associated virtual
+      /// controller's lock.
+      /// @param [in] maxEvents Maximum number of events to include in the view.
+      /// @return Read-only view of the oldest events, in chronological order.
+      SEventSpans GetEvents(uint32_t maxEvents) const;
+
+      /// Checks if the near-overflow event coalescing policy is enabled on this buffer.
+      /// @return `true` if event coalescing is enabled, `false` otherwise.
+      inline bool IsCoalescingEnabled(void) const
+      {
+        return eventCoalescingEnabled;
+      }
+
+      /// Enables or disables the near-overflow event coalescing policy on this buffer. When
+      /// enabled and occupancy passes a high-water mark, an appended axis or POV event that
+      /// refers to the same controller element as the newest queued event replaces that event's
+      /// value in place instead of consuming another slot. Button events always queue
+      /// individually so their press and release edges are never lost. Because coalescing mutates
+      /// the newest queued event in place, consumers must serialize reads against appends using
+      /// the associated virtual controller's lock, which they are already documented to need for
+      /// multi-event views.
+      /// @param [in] coalescingEnabled Whether event coalescing should be enabled.
+      inline void SetCoalescingEnabled(bool coalescingEnabled)
+      {
+        eventCoalescingEnabled = coalescingEnabled;
       }
 
       /// Checks if this event buffer is enabled.
@@ -133,11 +256,44 @@ namespace Xidi
         return (0 != GetCapacity());
       }
 
+      /// Retrieves the largest number of events ever present in this event buffer at once.
+      /// Useful for recommending an appropriate buffer capacity. Never reset.
+      /// @return Event count high-water mark.
+      inline uint32_t GetEventCountHighWaterMark(void) const
+      {
+        return eventCountHighWaterMark.load(std::memory_order_relaxed);
+      }
+
+      /// Retrieves the total number of events this event buffer has discarded due to overflow
+      /// since construction. Unlike the overflow flag, this counter is never cleared.
+      /// @return Total number of dropped events.
+      inline uint64_t GetTotalDroppedEventCount(void) const
+      {
+        return totalDroppedEventCount.load(std::memory_order_relaxed);
+      }
+
+      /// Retrieves the total number of events this event buffer has absorbed by merging them into
+      /// an already-queued event for the same controller element under the near-overflow
+      /// coalescing policy. Never reset.
+      /// @return Total number of coalesced events.
+      inline uint64_t GetTotalCoalescedEventCount(void) const
+      {
+        return totalCoalescedEventCount.load(std::memory_order_relaxed);
+      }
+
+      /// Retrieves the number of times this event buffer has overflowed and discarded events
+      /// since construction. Unlike the overflow flag, this counter is never cleared.
+      /// @return Total number of overflow occurrences.
+      inline uint64_t GetTotalOverflowCount(void) const
+      {
+        return totalOverflowCount.load(std::memory_order_relaxed);
+      }
+
       /// Checks if an overflow condition has occurred on this buffer that has yet to be cleared.
       /// @return `true` if an overflow condition is present, `false` otherwise.
       inline bool IsOverflowed(void) const
       {
-        return eventBufferOverflowed;
+        return eventBufferOverflowed.load(std::memory_order_acquire);
       }
 
       /// Removes and discards the oldest events from the buffer and clears any present overflow
@@ -153,19 +309,70 @@ namespace Xidi
       /// event buffer, an overflow condition is triggered and the oldest excess events are
       /// discarded. Buffer always maintains one free space, so the actual number of events stored
       /// is one less than capacity. This is to be consistent with documentation for
-      /// IDirectInputDevice8::GetDeviceData.
+      /// IDirectInputDevice8::GetDeviceData. Whenever the existing ring storage is already large
+      /// enough for the new capacity the change is purely logical and queued events are neither
+      /// moved nor copied; only growth beyond the largest capacity ever used commits additional
+      /// pages and relocates queued events. Not concurrency-safe.
       /// @param [in] capacity Desired event buffer capacity.
       void SetCapacity(uint32_t capacity);
 
     private:
 
-      /// Underlying event buffer object. Holds all individual event elements.
-      boost::circular_buffer<SEvent> eventBuffer;
+      /// Base address of the underlying event storage arena, or `nullptr` if this event buffer
+      /// has never been enabled. Address space for #kEventStorageSlotsMax events is reserved
+      /// lazily on first enable and pages are committed on demand as capacity grows.
+      SEvent* eventStorage;
+
+      /// Number of event slots currently in use for ring storage. Always a power of two at least
+      /// as large as the declared capacity, so that ring positions can be turned into storage
+      /// indices with a mask operation, and never larger than the number of committed slots.
+      /// Never shrinks, so capacity changes within the largest size ever used leave the index
+      /// mask, and hence the positions of queued events, untouched.
+      uint32_t eventStorageSize;
+
+      /// Number of event slots whose backing pages have been committed. Only ever grows, so
+      /// repeated capacity changes settle into pure pointer arithmetic with no memory management
+      /// operations at all.
+      uint32_t eventStorageNumCommitted;
+
+      /// Declared capacity of this event buffer, in number of events. Unlike the storage size this
+      /// is not required to be a power of two, and the number of events stored is limited to one
+      /// less than this value.
+      uint32_t eventBufferCapacity;
+
+      /// Free-running ring position of the oldest event present in the buffer. Advanced by the
+      /// consumer when popping events and by the producer when overwriting the oldest event on
+      /// overflow, hence updates use compare-and-exchange.
+      std::atomic<uint32_t> headIndex;
+
+      /// Free-running ring position one past the most recent event present in the buffer.
+      /// Advanced only by the producer.
+      std::atomic<uint32_t> tailIndex;
 
       /// Overflow flag for the event buffer. Set whenever an operation causes the event buffer to
       /// hit capacity and discard some previously-stored events. Cleared whenever events are
       /// retrieved such that the event buffer goes below capacity.
-      bool eventBufferOverflowed;
+      std::atomic<bool> eventBufferOverflowed;
+
+      /// Number of times this event buffer has overflowed and discarded events since
+      /// construction. Unlike the overflow flag this counter is never cleared, so it can be used
+      /// for rate accounting.
+      std::atomic<uint64_t> totalOverflowCount;
+
+      /// Total number of events discarded due to overflow since construction. Never cleared.
+      std::atomic<uint64_t> totalDroppedEventCount;
+
+      /// Total number of events absorbed by near-overflow coalescing since construction. Never
+      /// cleared.
+      std::atomic<uint64_t> totalCoalescedEventCount;
+
+      /// Whether the near-overflow event coalescing policy is enabled on this buffer. Written
+      /// only at buffer configuration time, before events flow.
+      bool eventCoalescingEnabled;
+
+      /// Largest number of events ever present in this event buffer at once. Never cleared.
+      /// Only the producer updates it, so updates do not need compare-and-exchange.
+      std::atomic<uint32_t> eventCountHighWaterMark;
     };
   } // namespace Controller
 } // namespace Xidi
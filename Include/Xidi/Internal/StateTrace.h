@@ -0,0 +1,161 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file StateTrace.h
+ *   Declaration of record-and-replay functionality for physical controller state traces. When
+ *   recording is enabled by configuration, every physical state change observed by the polling
+ *   thread is captured as a timestamped binary record and written to a trace file by a
+ *   low-priority writer thread, so real gameplay input can be captured without perturbing the
+ *   polling pipeline. When replay is enabled, recorded traces are fed back through the full
+ *   mapping pipeline in place of hardware reads, at original or accelerated speed, giving
+ *   reproducible performance regression runs driven by real input instead of synthetic patterns.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace StateTrace
+  {
+    /// Magic value that identifies a state trace file. Exactly fills the magic field, including
+    /// its terminating null character.
+    inline constexpr char kTraceFileMagic[16] = "XidiStateTrace1";
+
+    /// Trace file layout version, incremented whenever the header or record layout changes.
+    inline constexpr uint32_t kTraceFileVersion = 1;
+
+    /// Header at the beginning of every state trace file. Fixed fields describe the record
+    /// layout so that tooling and future versions can skip records they do not understand.
+    struct STraceFileHeader
+    {
+      /// Magic value, equal to #kTraceFileMagic.
+      char magic[16];
+
+      /// Layout version, equal to #kTraceFileVersion at recording time.
+      uint32_t version;
+
+      /// Size of each trace record that follows this header, in bytes.
+      uint32_t recordSizeBytes;
+
+      /// Reserved for future use. Written as zero.
+      uint32_t reserved[2];
+    };
+
+    static_assert(
+        32 == sizeof(STraceFileHeader), "Trace file header layout is parsed by external tooling.");
+
+    /// Single state trace record, capturing one physical controller state change. Physical state
+    /// is serialized field-by-field rather than by copying #Controller::SPhysicalState directly,
+    /// so the file layout is independent of in-memory representation details.
+    struct STraceRecord
+    {
+      /// Time at which the state change was observed, in milliseconds since the start of the
+      /// trace.
+      uint32_t timestampMilliseconds;
+
+      /// Identifier of the physical controller whose state changed.
+      uint8_t controllerIdentifier;
+
+      /// Device status at capture time, as a #Controller::EPhysicalDeviceStatus value.
+      uint8_t deviceStatus;
+
+      /// Digital button values, one bit per button in #Controller::EPhysicalButton order.
+      uint16_t buttons;
+
+      /// Analog stick values, in #Controller::EPhysicalStick order.
+      int16_t stick[static_cast<int>(Controller::EPhysicalStick::Count)];
+
+      /// Analog trigger values, in #Controller::EPhysicalTrigger order.
+      uint8_t trigger[static_cast<int>(Controller::EPhysicalTrigger::Count)];
+
+      /// Reserved for future use. Written as zero.
+      uint8_t reserved[2];
+    };
+
+    static_assert(
+        20 == sizeof(STraceRecord), "Trace record layout is parsed by external tooling.");
+    static_assert(
+        16 >= static_cast<int>(Controller::EPhysicalButton::Count),
+        "Trace record button field holds one bit per possible physical button.");
+
+    /// Packs a physical state snapshot into a trace record.
+    /// @param [in] timestampMilliseconds Time at which the state change was observed, in
+    /// milliseconds since the start of the trace.
+    /// @param [in] controllerIdentifier Identifier of the physical controller whose state
+    /// changed.
+    /// @param [in] physicalState Physical state snapshot to pack.
+    /// @return Trace record representation of the supplied physical state.
+    inline STraceRecord TraceRecordFromPhysicalState(
+        uint32_t timestampMilliseconds,
+        Controller::TControllerIdentifier controllerIdentifier,
+        const Controller::SPhysicalState& physicalState)
+    {
+      STraceRecord traceRecord = {
+          .timestampMilliseconds = timestampMilliseconds,
+          .controllerIdentifier = static_cast<uint8_t>(controllerIdentifier),
+          .deviceStatus = static_cast<uint8_t>(physicalState.deviceStatus),
+          .buttons = static_cast<uint16_t>(physicalState.button.to_ulong())};
+
+      for (int i = 0; i < static_cast<int>(Controller::EPhysicalStick::Count); ++i)
+        traceRecord.stick[i] = physicalState.stick[i];
+
+      for (int i = 0; i < static_cast<int>(Controller::EPhysicalTrigger::Count); ++i)
+        traceRecord.trigger[i] = physicalState.trigger[i];
+
+      return traceRecord;
+    }
+
+    /// Unpacks a trace record into a physical state snapshot. The capture timestamp is left at
+    /// zero and is expected to be stamped by the replay backend at replay time.
+    /// @param [in] traceRecord Trace record to unpack.
+    /// @return Physical state snapshot represented by the supplied trace record.
+    inline Controller::SPhysicalState PhysicalStateFromTraceRecord(const STraceRecord& traceRecord)
+    {
+      Controller::SPhysicalState physicalState = {
+          .deviceStatus = static_cast<Controller::EPhysicalDeviceStatus>(traceRecord.deviceStatus),
+          .button = traceRecord.buttons};
+
+      for (int i = 0; i < static_cast<int>(Controller::EPhysicalStick::Count); ++i)
+        physicalState.stick[i] = traceRecord.stick[i];
+
+      for (int i = 0; i < static_cast<int>(Controller::EPhysicalTrigger::Count); ++i)
+        physicalState.trigger[i] = traceRecord.trigger[i];
+
+      return physicalState;
+    }
+
+    /// Submits one polled physical state for recording. Intended to be invoked by the polling
+    /// thread for every completed poll. No effect unless recording is enabled by configuration,
+    /// in which case only states that differ from the previous recorded state for the same
+    /// controller are queued for the writer thread, so the polling thread never blocks on file
+    /// output. Performs recording setup on first call, so not safe to call from a DLL entry
+    /// point.
+    /// @param [in] controllerIdentifier Identifier of the physical controller that was polled.
+    /// @param [in] physicalState Physical state snapshot that was polled.
+    void SubmitPolledState(
+        Controller::TControllerIdentifier controllerIdentifier,
+        const Controller::SPhysicalState& physicalState);
+
+    /// Attempts to read replayed physical state for the specified controller. Succeeds only when
+    /// replay is enabled by configuration and the configured trace file was successfully loaded,
+    /// in which case the returned snapshot is the trace state current at the trace time
+    /// corresponding to now, and callers should bypass hardware reads entirely. Once the end of
+    /// the trace is reached the final state is held indefinitely. Performs trace file loading on
+    /// first call, so not safe to call from a DLL entry point.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @param [out] physicalState Filled with the replayed snapshot, stamped at read time, if
+    /// successful.
+    /// @return `true` if replay is active and a snapshot was produced, `false` otherwise.
+    bool TryReadReplayState(
+        Controller::TControllerIdentifier controllerIdentifier,
+        Controller::SPhysicalState& physicalState);
+  } // namespace StateTrace
+} // namespace Xidi
@@ -48,6 +48,7 @@
 // literals. All exist as wide-character strings only.
 #define XIDI_CONFIG_PROPERTIES_PREFIX_CIRCLE_TO_SQUARE_PERCENT L"CircleToSquarePercent"
 #define XIDI_CONFIG_PROPERTIES_PREFIX_DEADZONE_PERCENT         L"DeadzonePercent"
+#define XIDI_CONFIG_PROPERTIES_PREFIX_RADIAL_DEADZONE          L"RadialDeadzone"
 #define XIDI_CONFIG_PROPERTIES_PREFIX_SATURATION_PERCENT       L"SaturationPercent"
 #define XIDI_CONFIG_PROPERTIES_SUFFIX_STICK_LEFT               L"StickLeft"
 #define XIDI_CONFIG_PROPERTIES_SUFFIX_STICK_RIGHT              L"StickRight"
@@ -73,6 +74,10 @@ namespace Xidi
     /// Configuration file setting separator for generating per-controller setting strings.
     inline constexpr wchar_t kCharConfigurationSettingSeparator = L'.';
 
+    /// Character that separates a base section name from an executable name within the section
+    /// name for per-application profile sections.
+    inline constexpr wchar_t kCharConfigurationSectionProfileSeparator = L':';
+
     /// Configuration file section name for log-related settings.
     inline constexpr std::wstring_view kStrConfigurationSectionLog = L"Log";
 
@@ -82,6 +87,18 @@ namespace Xidi
     /// Configuration file setting for specifying the logging verbosity level.
     inline constexpr std::wstring_view kStrConfigurationSettingLogLevel = L"Level";
 
+    /// Configuration file setting for specifying the hot-path profiling sampling interval. A
+    /// value of N means one of every N invocations of each instrumented hot path is measured, and
+    /// 0, the default, disables profiling entirely.
+    inline constexpr std::wstring_view kStrConfigurationSettingLogProfilingSampleInterval =
+        L"ProfilingSampleInterval";
+
+    /// Configuration file setting for specifying the polling loop wakeup lateness, in
+    /// milliseconds, beyond which a rate-limited warning message is logged. A value of 0, the
+    /// default, disables the warning without affecting statistics collection.
+    inline constexpr std::wstring_view kStrConfigurationSettingLogPollingJitterWarningThreshold =
+        L"PollingJitterWarningThreshold";
+
     /// Configuration file section name for mapper-related settings.
     inline constexpr std::wstring_view kStrConfigurationSectionMapper = L"Mapper";
 
@@ -102,6 +119,28 @@ namespace Xidi
     /// of virtual controllers.
     inline constexpr std::wstring_view kStrConfigurationSectionProperties = L"Properties";
 
+    /// Configuration file setting for selecting the backend used to capture physical controller
+    /// hardware state. Valid values are "XInput" for the XInput API and "WinMM" for the WinMM
+    /// joystick API. Can additionally be suffixed with a controller number to select a backend for
+    /// an individual controller.
+    inline constexpr std::wstring_view kStrConfigurationSettingPropertiesCaptureBackend =
+        L"CaptureBackend";
+
+    /// Configuration file setting for selecting the backend used to poll physical controllers for
+    /// state changes. Valid values are "Sleep" for a fixed-period sleep loop and "Timer" for a
+    /// high-resolution waitable timer. Polling threads additionally remain parked whenever no
+    /// virtual controller objects exist to consume state updates.
+    inline constexpr std::wstring_view kStrConfigurationSettingPropertiesPollingBackend =
+        L"PollingBackend";
+
+    /// Configuration file setting for selecting the backend used to deliver synthesized keyboard
+    /// and mouse events to the system. Valid values are "SendInput" for the standard system input
+    /// queue and "PostMessage" for posting window messages directly to the foreground window when
+    /// it belongs to the current process, which avoids system input queue serialization at the
+    /// cost of being invisible to applications that read input through raw input APIs.
+    inline constexpr std::wstring_view kStrConfigurationSettingPropertiesSynthesisBackend =
+        L"SynthesisBackend";
+
     /// Configuration file setting for customizing the force feedback effect strength. Expressed as
     /// a percentage that is used to scale the final effect values sent to the controller hardware.
     /// This can be used to reduce, but not amplify, the strength of force feedback effects.
@@ -120,6 +159,18 @@ namespace Xidi
     inline constexpr std::wstring_view kStrConfigurationSettingsPropertiesUseBuiltinProperties =
         L"UseBuiltInProperties";
 
+    /// Configuration file setting for enabling or disabling the device property cache, which
+    /// persists the device properties an application applies to its virtual controllers and
+    /// pre-applies them at device creation time on subsequent launches.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingsPropertiesUseDevicePropertyCache = L"UseDevicePropertyCache";
+
+    /// Configuration file setting for enabling or disabling cross-process sharing of physical
+    /// controller state, whereby one process polls the hardware and all other processes read its
+    /// published snapshots from a shared-memory segment.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingsPropertiesUseSharedPhysicalState = L"UseSharedPhysicalState";
+
     /// Configuration file setting for correcting the left analog stick's circular field of motion
     /// to a square field of motion, expressed as a percent of the maximum possible amount of
     /// correction (perfect circle to perfect square).
@@ -158,6 +209,19 @@ namespace Xidi
     inline constexpr std::wstring_view kStrConfigurationSettingsPropertiesDeadzonePercentTriggerRT =
         XIDI_CONFIG_PROPERTIES_PREFIX_DEADZONE_PERCENT XIDI_CONFIG_PROPERTIES_SUFFIX_TRIGGER_RT;
 
+    /// Configuration file setting for switching the left analog stick's deadzone and saturation
+    /// to radial mode, which transforms the stick position as a two-dimensional vector by
+    /// magnitude rather than per axis and hence does not distort diagonals.
+    inline constexpr std::wstring_view kStrConfigurationSettingsPropertiesRadialDeadzoneStickLeft =
+        XIDI_CONFIG_PROPERTIES_PREFIX_RADIAL_DEADZONE XIDI_CONFIG_PROPERTIES_SUFFIX_STICK_LEFT;
+
+    /// Configuration file setting for switching the right analog stick's deadzone and saturation
+    /// to radial mode, which transforms the stick position as a two-dimensional vector by
+    /// magnitude rather than per axis and hence does not distort diagonals.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingsPropertiesRadialDeadzoneStickRight =
+            XIDI_CONFIG_PROPERTIES_PREFIX_RADIAL_DEADZONE XIDI_CONFIG_PROPERTIES_SUFFIX_STICK_RIGHT;
+
     /// Configuration file setting for adding extra saturation to the left analog stick, expressed
     /// as a percentage of the analog range.
     inline constexpr std::wstring_view
@@ -186,6 +250,112 @@ namespace Xidi
             XIDI_CONFIG_PROPERTIES_PREFIX_SATURATION_PERCENT
                 XIDI_CONFIG_PROPERTIES_SUFFIX_TRIGGER_RT;
 
+    /// Configuration file setting for coalescing state change event notifications. Specifies the
+    /// number of buffered events that must accumulate before the application-registered
+    /// notification event is signalled. A value of 0, the default, signals on every virtual
+    /// controller state change.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingsPropertiesStateChangeEventSignalingWatermark =
+            L"StateChangeEventSignalingWatermark";
+
+    /// Configuration file setting for enabling or disabling low-memory mode, which caps event
+    /// buffer sizes and releases or bounds caches that exist purely to speed up repeated
+    /// operations, reducing the steady-state memory held in every process Xidi is loaded into.
+    inline constexpr std::wstring_view kStrConfigurationSettingsPropertiesLowMemoryMode =
+        L"LowMemoryMode";
+
+    /// Configuration file setting for enabling or disabling near-overflow coalescing of buffered
+    /// state change events. When enabled and a buffer's occupancy passes a high-water mark,
+    /// successive axis and POV events for the same controller element are merged, keeping the
+    /// latest value, so button transitions are never evicted by axis spam.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingsPropertiesStateChangeEventCoalescing =
+            L"StateChangeEventCoalescing";
+
+    /// Configuration file section name for recording and replaying physical controller state
+    /// traces.
+    inline constexpr std::wstring_view kStrConfigurationSectionStateTrace = L"StateTrace";
+
+    /// Configuration file setting for the path of the file to which physical controller state
+    /// changes are recorded during play. Recording is disabled when this setting is absent.
+    inline constexpr std::wstring_view kStrConfigurationSettingStateTraceRecordFilename =
+        L"RecordFilename";
+
+    /// Configuration file setting for the path of the file from which physical controller state
+    /// is replayed in place of hardware reads. Replay is disabled when this setting is absent.
+    inline constexpr std::wstring_view kStrConfigurationSettingStateTraceReplayFilename =
+        L"ReplayFilename";
+
+    /// Configuration file setting for the replay speed, in percent of the originally recorded
+    /// speed. A value of 100, the default, replays the trace at its original speed.
+    inline constexpr std::wstring_view kStrConfigurationSettingStateTraceReplaySpeedPercent =
+        L"ReplaySpeedPercent";
+
+    /// Configuration file section name for controlling the scheduling of Xidi worker threads.
+    inline constexpr std::wstring_view kStrConfigurationSectionWorkerThreads = L"WorkerThreads";
+
+    /// Configuration file setting for the priority of the physical controller state polling
+    /// thread, expressed as a Windows thread priority value. A value of 0, the default, leaves
+    /// the thread at its default priority.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsPollingThreadPriority = L"PollingThreadPriority";
+
+    /// Configuration file setting for the processor affinity mask of the physical controller
+    /// state polling thread. A value of 0, the default, leaves the thread free to run on any
+    /// processor.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsPollingThreadAffinityMask =
+            L"PollingThreadAffinityMask";
+
+    /// Configuration file setting for the priority of the force feedback actuation thread,
+    /// expressed as a Windows thread priority value. A value of 0, the default, leaves the
+    /// thread at its default priority.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsForceFeedbackThreadPriority =
+            L"ForceFeedbackThreadPriority";
+
+    /// Configuration file setting for the processor affinity mask of the force feedback
+    /// actuation thread. A value of 0, the default, leaves the thread free to run on any
+    /// processor.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsForceFeedbackThreadAffinityMask =
+            L"ForceFeedbackThreadAffinityMask";
+
+    /// Configuration file setting for the priority of the keyboard and mouse input dispatch
+    /// thread, expressed as a Windows thread priority value. A value of 0, the default, leaves
+    /// the thread at its default priority.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsInputDispatchThreadPriority =
+            L"InputDispatchThreadPriority";
+
+    /// Configuration file setting for the processor affinity mask of the keyboard and mouse
+    /// input dispatch thread. A value of 0, the default, leaves the thread free to run on any
+    /// processor.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsInputDispatchThreadAffinityMask =
+            L"InputDispatchThreadAffinityMask";
+
+    /// Configuration file setting for the priority of the background task scheduler worker
+    /// threads, expressed as a Windows thread priority value. A value of 0, the default, leaves
+    /// the threads at below-normal priority.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsBackgroundTaskThreadPriority =
+            L"BackgroundTaskThreadPriority";
+
+    /// Configuration file setting for the processor affinity mask of the background task
+    /// scheduler worker threads. A value of 0, the default, leaves the threads free to run on
+    /// any processor.
+    inline constexpr std::wstring_view
+        kStrConfigurationSettingWorkerThreadsBackgroundTaskThreadAffinityMask =
+            L"BackgroundTaskThreadAffinityMask";
+
+    /// Configuration file setting for the CPU budget of Xidi's worker threads, expressed as a
+    /// percentage of one processor core. When the aggregate CPU consumption of the worker
+    /// threads exceeds this budget, their polling and synthesis periods are stretched until
+    /// consumption falls back within it. A value of 0, the default, disables the budget.
+    inline constexpr std::wstring_view kStrConfigurationSettingWorkerThreadsCpuBudgetPercent =
+        L"CpuBudgetPercent";
+
     /// Configuration file section name for specifying behavioral tweaks to work around bugs in
     /// games.
     inline constexpr std::wstring_view kStrConfigurationSectionWorkarounds = L"Workarounds";
@@ -223,6 +393,9 @@ namespace Xidi
     /// Use this to identify Xidi's form (dinput, dinput8, winmm) in areas of user interaction.
     std::wstring_view GetFormName(void);
 
+    /// Complete path and filename of the Xidi configuration file.
+    std::wstring_view GetConfigurationFilePath(void);
+
     /// Directory name in which system-supplied libraries are found.
     std::wstring_view GetSystemDirectoryName(void);
 
@@ -249,6 +422,24 @@ namespace Xidi
     /// @return Resulting string representation for the specified GUID.
     Infra::TemporaryString GuidToString(const GUID& guid);
 
+    /// Retrieves a string used to represent a per-controller capture backend configuration
+    /// setting. These are initialized on first invocation and returned subsequently as read-only
+    /// views. An empty view is returned if an invalid controller identifier is specified.
+    /// @param [in] controllerIdentifier Controller identifier for which a string is desired.
+    /// @return Corresponding configuration setting string, or an empty view if the controller
+    /// identifier is out of range.
+    std::wstring_view CaptureBackendConfigurationNameString(
+        Controller::TControllerIdentifier controllerIdentifier);
+
+    /// Retrieves the name of the per-application profile version of the specified configuration
+    /// section for the current executable, of the form "Section:Executable.exe". These are
+    /// initialized on first invocation and returned subsequently as read-only views. An empty
+    /// view is returned for section names that do not support per-application profiles.
+    /// @param [in] configurationSection Base configuration section name.
+    /// @return Corresponding per-application profile section name, or an empty view if the
+    /// specified section does not support per-application profiles.
+    std::wstring_view ConfigurationProfileSectionName(std::wstring_view configurationSection);
+
     /// Retrieves a string used to represent a per-controller mapper type configuration setting.
     /// These are initialized on first invocation and returned subsequently as read-only views.
     /// An empty view is returned if an invalid controller identifier is specified.
@@ -12,7 +12,7 @@
 #pragma once
 
 #include <array>
-#include <bitset>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <mutex>
@@ -20,9 +20,12 @@
 #include <thread>
 #include <utility>
 
+#include "ApiBitSet.h"
+#include "ConcurrencyWrapper.h"
 #include "ControllerTypes.h"
 #include "ForceFeedbackDevice.h"
 #include "ForceFeedbackTypes.h"
+#include "InputMetrics.h"
 #include "Mapper.h"
 #include "StateChangeEventBuffer.h"
 
@@ -92,6 +95,14 @@ namespace Xidi
         static constexpr unsigned int kBaseIndexPov =
             (unsigned int)EAxis::Count + (unsigned int)EButton::Count;
 
+        /// Total number of virtual controller elements representable in the filter.
+        static constexpr unsigned int kNumElements =
+            (unsigned int)EAxis::Count + (unsigned int)EButton::Count + 1;
+
+        /// Type alias for a set of virtual controller elements, indexed identically to the
+        /// filter. Used for bulk word-level filter queries.
+        using TElementSet = BitSet<kNumElements>;
+
         /// Computes the filter index that corresponds to a given controller element, with very
         /// little error checking.
         /// @param [in] element Controller index for which the filter index is desired.
@@ -111,22 +122,49 @@ namespace Xidi
           }
         }
 
+        /// Computes the controller element that corresponds to a given filter index, with very
+        /// little error checking. Inverse of #ElementToIndex.
+        /// @param [in] index Filter index for which the controller element is desired.
+        /// @return Corresponding controller element.
+        static inline SElementIdentifier IndexToElement(unsigned int index)
+        {
+          if (index >= kBaseIndexPov) return {.type = EElementType::Pov};
+
+          if (index >= kBaseIndexButton)
+            return {.type = EElementType::Button, .button = (EButton)(index - kBaseIndexButton)};
+
+          return {.type = EElementType::Axis, .axis = (EAxis)(index - kBaseIndexAxis)};
+        }
+
         /// Adds all controller elements to the filter.
-        inline EventFilter(void) : filter(ULLONG_MAX) {}
+        inline EventFilter(void) : filter()
+        {
+          filter.fill();
+        }
 
         /// Adds the specified virtual controller element to the filter so that events are generated
         /// for it.
         /// @param [in] element Desired virtual controller element.
         inline void Add(SElementIdentifier element)
         {
-          filter.set(ElementToIndex(element));
+          filter.insert(ElementToIndex(element));
         }
 
         /// Adds all virtual controller elements to the filter, essentially turning the filter into
         /// a no-op and generating events for all elements.
         inline void AddAll(void)
         {
-          filter.set();
+          filter.fill();
+        }
+
+        /// Computes the subset of the supplied element set that is allowed by the filter to
+        /// generate events. The intersection is computed with whole-word bit operations, so a
+        /// single call replaces one filter query per element of the supplied set.
+        /// @param [in] elements Set of virtual controller elements of interest.
+        /// @return Subset of the supplied elements contained in the filter.
+        inline TElementSet AllowedElements(const TElementSet& elements) const
+        {
+          return (filter & elements);
         }
 
         /// Tests if the filter contains the specified virtual controller element.
@@ -134,7 +172,7 @@ namespace Xidi
         /// @return `true` if it is contained in the filter, `false` otherwise.
         inline bool Contains(SElementIdentifier element) const
         {
-          return filter.test(ElementToIndex(element));
+          return filter.contains(ElementToIndex(element));
         }
 
         /// Remove the specified virtual controller element from the filter so that events are not
@@ -142,20 +180,20 @@ namespace Xidi
         /// @param [in] element Desired virtual controller element.
         inline void Remove(SElementIdentifier element)
         {
-          filter.reset(ElementToIndex(element));
+          filter.erase(ElementToIndex(element));
         }
 
         /// Removes all virtual controller elements from the filter, resulting in no events being
         /// generated whatsoever.
         inline void RemoveAll(void)
         {
-          filter.reset();
+          filter.clear();
         }
 
       private:
 
         /// Holds the filter itself, one bit per virtual controller element.
-        std::bitset<(int)EAxis::Count + (int)EButton::Count + 1> filter;
+        TElementSet filter;
       };
 
       /// Properties of an individual axis.
@@ -163,43 +201,58 @@ namespace Xidi
       /// See DirectInput documentation for the meaning of each individual field.
       struct SAxisProperties
       {
+        /// Number of fractional bits in the fixed-point transformation slope coefficients.
+        /// Chosen so that the worst-case quantization error over the full physical range of an
+        /// axis stays below one output unit, while products still fit comfortably in 64 bits.
+        static constexpr int32_t kTransformFixedPointBits = 17;
+
         /// Specifies whether or not the transformations identified by this object should be enabled
         /// for the corresponding axis (in other words, should the axis properties be applied or
         /// ignored).
-        bool transformationsEnabled;
+        bool transformationsEnabled = false;
 
         /// Deadzone of the axis, expressed as a percentage of the physical range around its center
         /// point. Can be from 0 (no deadzone) to 10000 (100% of the physical range is dead).
-        uint32_t deadzone;
+        uint32_t deadzone = 0;
 
         /// Highest raw analog value on the positive side of the axis that falls within the deadzone
         /// region. Values at or below this should report neutral.
-        int32_t deadzoneRawCutoffPositive;
+        int32_t deadzoneRawCutoffPositive = 0;
 
         /// Lowest raw analog value on the negative side of the axis that fallw within the deadzone
         /// region. Values at or above this should report neutral.
-        int32_t deadzoneRawCutoffNegative;
+        int32_t deadzoneRawCutoffNegative = 0;
 
         /// Saturation point of the axis, expressed as a percentage of its physical range in both
         /// directions. Can be from 0 (entire axis is saturated) to 10000 (do not saturate at all).
-        uint32_t saturation;
+        uint32_t saturation = 0;
 
         /// Lowest raw analog value on the positive side of the axis that faills within the
         /// saturation region. Values at or above this should report extreme.
-        int32_t saturationRawCutoffPositive;
+        int32_t saturationRawCutoffPositive = 0;
 
         /// Minimum value in the range of raw analog values that falls within the deadzone. Values
         /// at or below this should report extreme.
-        int32_t saturationRawCutoffNegative;
+        int32_t saturationRawCutoffNegative = 0;
 
         /// Minimum reportable value for the axis.
-        int32_t rangeMin;
+        int32_t rangeMin = 0;
 
         /// Maximum reportable value for the axis.
-        int32_t rangeMax;
+        int32_t rangeMax = 0;
 
         /// Neutral value for the axis.
-        int32_t rangeNeutral;
+        int32_t rangeNeutral = 0;
+
+        /// Fixed-point slope of the positive-side linear transformation region, with
+        /// #kTransformFixedPointBits fractional bits. Precomputed whenever deadzone, range, or
+        /// saturation changes so the per-refresh transformation needs no division.
+        int64_t transformSlopePositive = 0;
+
+        /// Fixed-point slope of the negative-side linear transformation region, with
+        /// #kTransformFixedPointBits fractional bits. Precomputed whenever deadzone, range, or
+        /// saturation changes so the per-refresh transformation needs no division.
+        int64_t transformSlopeNegative = 0;
 
         constexpr SAxisProperties(void)
         {
@@ -221,6 +274,7 @@ namespace Xidi
               (((kAnalogValueMax - kAnalogValueNeutral) * (int32_t)newDeadzone) / kAxisDeadzoneMax);
           deadzoneRawCutoffNegative = kAnalogValueNeutral -
               (((kAnalogValueNeutral - kAnalogValueMin) * (int32_t)newDeadzone) / kAxisDeadzoneMax);
+          UpdateTransformSlopes();
         }
 
         /// Sets the range and ensures value consistency between fields, but otherwise performs no
@@ -232,6 +286,7 @@ namespace Xidi
           rangeMin = newRangeMin;
           rangeMax = newRangeMax;
           rangeNeutral = ((newRangeMin + newRangeMax) / 2);
+          UpdateTransformSlopes();
         }
 
         /// Sets the saturation and ensures value consistency between fields, but otherwise performs
@@ -246,6 +301,30 @@ namespace Xidi
           saturationRawCutoffNegative = kAnalogValueNeutral -
               (((kAnalogValueNeutral - kAnalogValueMin) * (int32_t)newSaturation) /
                kAxisSaturationMax);
+          UpdateTransformSlopes();
+        }
+
+        /// Recomputes the fixed-point slopes of the two linear transformation regions from the
+        /// current deadzone, range, and saturation cutoff values. Invoked whenever any of those
+        /// values changes, so the per-refresh transformation hot path is reduced to a
+        /// multiply-add-shift per axis.
+        constexpr void UpdateTransformSlopes(void)
+        {
+          const int64_t positiveRegionExtent =
+              ((int64_t)saturationRawCutoffPositive - (int64_t)deadzoneRawCutoffPositive);
+          const int64_t negativeRegionExtent =
+              ((int64_t)saturationRawCutoffNegative - (int64_t)deadzoneRawCutoffNegative);
+
+          transformSlopePositive =
+              ((0 == positiveRegionExtent)
+                   ? 0
+                   : ((((int64_t)rangeMax - (int64_t)rangeNeutral) << kTransformFixedPointBits) /
+                      positiveRegionExtent));
+          transformSlopeNegative =
+              ((0 == negativeRegionExtent)
+                   ? 0
+                   : ((((int64_t)rangeMin - (int64_t)rangeNeutral) << kTransformFixedPointBits) /
+                      negativeRegionExtent));
         }
 
         /// Sets whether or not the transformations identified by this object should be enabled for
@@ -447,6 +526,18 @@ namespace Xidi
         return eventBuffer[index];
       }
 
+      /// Retrieves a read-only view of up to the specified number of the oldest buffered events,
+      /// without copying them, so a batch of events can be translated in a single pass rather than
+      /// one indexed access at a time. Because the event buffer is a ring the view may consist of
+      /// two contiguous pieces. To prevent the event buffer from being modified while the view is
+      /// in use, the caller should first obtain this virtual controller's lock.
+      /// @param [in] maxEvents Maximum number of events to include in the view.
+      /// @return Read-only view of the oldest buffered events, in chronological order.
+      inline StateChangeEventBuffer::SEventSpans GetEventBufferEvents(uint32_t maxEvents) const
+      {
+        return eventBuffer.GetEvents(maxEvents);
+      }
+
       /// Retrieves and returns the force feedback gain property for this controller.
       /// @return Force feedback gain property value.
       inline uint32_t GetForceFeedbackGain(void) const
@@ -462,9 +553,20 @@ namespace Xidi
       }
 
       /// Retrieves and returns the latest view of the state of this virtual controller.
+      /// Does not acquire this virtual controller's lock. State is read from a published snapshot,
+      /// so application threads reading state never contend with the background thread that
+      /// refreshes it.
       /// @return Current state of this virtual controller.
       SState GetState(void);
 
+      /// Retrieves and returns the latest view of the state of this virtual controller along with
+      /// an opaque state version number. The version number advances whenever the state changes,
+      /// so callers that cache derived data can detect an unchanged state by comparing version
+      /// numbers across calls. Does not acquire this virtual controller's lock on the common path.
+      /// @param [out] stateVersion Filled with the version number of the returned state.
+      /// @return Current state of this virtual controller.
+      SState GetState(uint32_t& stateVersion);
+
       /// Checks if this virtual controller has a state change event handle which would be signalled
       /// on virtual controller state change.
       /// @return `true` if so, `false` otherwise.
@@ -495,7 +597,18 @@ namespace Xidi
       /// mutex.
       inline std::unique_lock<std::recursive_mutex> Lock(void)
       {
-        return std::unique_lock(controllerMutex);
+        // Acquisitions are sampled into the lock wait metrics histogram. The uncontended path,
+        // which is by far the most common, is detected with a non-blocking acquisition attempt
+        // and recorded without any clock query; only contended acquisitions pay for a wait time
+        // measurement.
+        std::unique_lock lock(controllerMutex, std::try_to_lock);
+
+        if (true == lock.owns_lock())
+          InputMetrics::RecordUncontendedLockAcquisition();
+        else
+          InputMetrics::AcquireLockWithWaitMeasurement(lock);
+
+        return lock;
       }
 
       /// Removes and discards up to the specified number of the oldest events from this virtual
@@ -503,9 +616,17 @@ namespace Xidi
       /// @param [in] numEventsToPop Maximum number of events to remove.
       void PopEventBufferOldestEvents(uint32_t numEventsToPop);
 
+      /// Returns this virtual controller to its freshly-constructed state so that it can be handed
+      /// back to an application as if it were newly created. Unregisters for force feedback,
+      /// clears the state change notification event, disables and empties the event buffer, and
+      /// restores all properties to their default values. The background monitoring thread is
+      /// deliberately left running. Intended to be invoked automatically when the interface object
+      /// that owns this virtual controller is recycled through the device object pool.
+      void PrepareForReuse(void);
+
       /// Generates this virtual controller's processed state view by applying this virtual
-      /// controller's properties to its raw state view. Not concurrency-safe, and primarily
-      /// intended for internal use.
+      /// controller's properties to its raw state view, for all axes regardless of dirty state.
+      /// Not concurrency-safe, and primarily intended for internal use.
       void ReapplyProperties(void);
 
       /// Refreshes the virtual controller's state using the supplied new state data.
@@ -569,6 +690,15 @@ namespace Xidi
       /// the target axis.
       void SetAllAxisTransformationsEnabled(bool transformationsEnabled);
 
+      /// Declares the set of virtual controller elements the application actually consumes, which
+      /// is propagated to the physical controller layer so that the mapping pass can skip element
+      /// mappers whose targets no consumer reads. Defaults to all elements at construction time,
+      /// and is typically narrowed once the application selects a data format. Must be invoked
+      /// while this virtual controller's lock is held.
+      /// @param [in] newConsumedElements Mask of virtual controller elements the application
+      /// consumes.
+      void SetConsumedElements(TElementMask newConsumedElements);
+
       /// Sets the event buffer capacity.
       /// @param [in] capacity Desired event buffer capacity in number of events.
       /// @return `true` if the new event buffer capacity was successfully validated and set,
@@ -587,15 +717,49 @@ namespace Xidi
       /// entirely.
       void SetStateChangeEvent(HANDLE eventHandle);
 
-      /// Signals the state change event.
+      /// Signals the state change event, subject to the configured signaling policy as evaluated
+      /// during the most recent accepted state refresh.
       /// Intended to be invoked internally.
       void SignalStateChangeEvent(void);
 
     private:
 
+      /// Recomputes the processed state view for only those axes whose properties have changed
+      /// since the last recomputation, then publishes the result. Property setters defer this work
+      /// by just marking axes dirty, so bursts of property changes during device setup collapse
+      /// into a single recomputation at the next state read or refresh. Must be invoked while this
+      /// virtual controller's lock is held.
+      void ApplyDirtyAxisProperties(void);
+
+      /// Marks the properties of a single axis as changed so that the processed state view for
+      /// that axis is lazily recomputed. Must be invoked while this virtual controller's lock is
+      /// held.
+      /// @param [in] axis Axis whose properties changed.
+      inline void MarkAxisPropertiesDirty(EAxis axis)
+      {
+        dirtyAxisProperties.insert((int)axis);
+        hasDirtyAxisProperties.store(true, std::memory_order_release);
+      }
+
+      /// Marks the properties of all axes as changed so that the entire processed state view is
+      /// lazily recomputed. Must be invoked while this virtual controller's lock is held.
+      inline void MarkAllAxisPropertiesDirty(void)
+      {
+        dirtyAxisProperties.fill();
+        hasDirtyAxisProperties.store(true, std::memory_order_release);
+      }
+
       /// Controller identifier to be used when communicating with the underlying real controller.
       const TControllerIdentifier kControllerIdentifier;
 
+      /// Number of buffered events that must accumulate before the state change event is
+      /// signalled, read from the configuration file at construction time. A value of 0 selects
+      /// the default policy of signalling on every virtual controller state change. Non-zero
+      /// values coalesce notifications by signalling only when the buffered event count crosses
+      /// this watermark from below, with 1 meaning an empty-to-non-empty transition. Ignored
+      /// whenever the event buffer is disabled, in which case the default policy applies.
+      const uint32_t kStateChangeEventSignalingWatermark;
+
       /// Provides concurrency control to the data structures in this virtual controller.
       std::recursive_mutex controllerMutex;
 
@@ -606,21 +770,45 @@ namespace Xidi
       /// events. Default state is all controller elements are included in the filter.
       EventFilter eventFilter;
 
+      /// Mask of virtual controller elements the application consumes, as currently registered
+      /// with the physical controller layer. Default state is all elements. Protected by this
+      /// virtual controller's lock.
+      TElementMask consumedElements;
+
       /// All properties associated with this virtual controller.
       SProperties properties;
 
+      /// Set of axes whose properties have changed but whose processed state contribution has not
+      /// yet been recomputed. Protected by this virtual controller's lock.
+      BitSetEnum<EAxis> dirtyAxisProperties;
+
+      /// Quick check for whether any axis properties are dirty, so that lock-free state reads can
+      /// skip lazy property application entirely in the common case of no pending changes.
+      std::atomic<bool> hasDirtyAxisProperties;
+
       /// State of the virtual controller as of the last refresh.
       /// Raw values, with no properties or other processing applied.
       SState stateRaw;
 
       /// State of the virtual controller as of the last refresh.
-      /// Fully processed, all properties have been applied.
+      /// Fully processed, all properties have been applied. Acts as the working copy for state
+      /// mutations and is protected by this virtual controller's lock.
       SState stateProcessed;
 
+      /// Published snapshot of the fully processed state, updated whenever the working copy
+      /// changes. Readers access this snapshot without acquiring this virtual controller's lock,
+      /// so the lock itself is reserved for mutations and event buffer operations.
+      ConcurrencyWrapper<SState> stateProcessedSnapshot;
+
       /// State change event notification handle, optionally provided by applications.
       /// The underlying event object is owned by the application, not by this object.
       HANDLE stateChangeEventHandle;
 
+      /// Whether the most recent accepted state refresh satisfied the signaling policy. Written
+      /// during each state refresh while this virtual controller's lock is held and consumed by
+      /// the subsequent signal attempt on the same monitor thread.
+      bool stateChangeEventShouldSignal;
+
       /// Background thread that monitors the associated physical controller for updates.
       std::thread physicalControllerMonitor;
 
@@ -11,16 +11,24 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "ApiDirectInput.h"
+#include "ApiGUID.h"
 #include "DataFormat.h"
 #include "VirtualController.h"
 
 namespace Xidi
 {
+  template <EDirectInputVersion diVersion> class VirtualDirectInputEffect;
+
   /// Enumerates possible access modes for DirectInput devices.
   enum class ECooperativeLevel
   {
@@ -34,6 +42,55 @@ namespace Xidi
     Exclusive
   };
 
+  /// Precomputed lookup tables for identifying virtual controller elements from DirectInput-style
+  /// object identifiers. Contents are derived entirely from a virtual controller's capabilities,
+  /// which are fixed once a mapper is selected, so the tables are built once per device object.
+  /// Offset-based identification is not represented here because the data format object maintains
+  /// its own offset-to-element table.
+  struct SElementIdentificationTables
+  {
+    /// Maps a DirectInput axis instance index, as extracted from a DIPH_BYID object identifier, to
+    /// the corresponding axis element.
+    std::optional<Controller::SElementIdentifier>
+        axisElementByInstance[(int)Controller::EAxis::Count];
+
+    /// Maps a DirectInput button instance index, as extracted from a DIPH_BYID object identifier,
+    /// to the corresponding button element.
+    std::optional<Controller::SElementIdentifier>
+        buttonElementByInstance[(int)Controller::EButton::Count];
+
+    /// POV element, present only if the virtual controller has a POV.
+    std::optional<Controller::SElementIdentifier> povElement;
+
+    /// Maps packed HID usage data, with usage in the low word and usage page in the high word
+    /// exactly as encoded in a DIPH_BYUSAGE object identifier, to the corresponding element.
+    /// Contains an entry for each element present on the virtual controller.
+    std::map<DWORD, Controller::SElementIdentifier> elementByHidUsageData;
+  };
+
+  /// Shadow copy of the virtual controller property values that applications commonly poll
+  /// through GetProperty. Kept in sync by refreshing it from the virtual controller whenever a
+  /// SetProperty call could have changed one of the values, so property reads are plain structure
+  /// reads on the device object that involve no virtual controller calls. Per-axis values are
+  /// indexed by axis type, not by the axis instance index reported to applications.
+  struct SPropertyValueShadow
+  {
+    /// Capacity of the event buffer, reported for DIPROP_BUFFERSIZE.
+    DWORD eventBufferCapacity;
+
+    /// Per-axis deadzone values, reported for DIPROP_DEADZONE.
+    DWORD axisDeadzone[(int)Controller::EAxis::Count];
+
+    /// Per-axis saturation values, reported for DIPROP_SATURATION.
+    DWORD axisSaturation[(int)Controller::EAxis::Count];
+
+    /// Per-axis range minimum values, reported for DIPROP_RANGE.
+    LONG axisRangeMin[(int)Controller::EAxis::Count];
+
+    /// Per-axis range maximum values, reported for DIPROP_RANGE.
+    LONG axisRangeMax[(int)Controller::EAxis::Count];
+  };
+
   /// Implements the IDirectInputDevice interface for all supported versions of DirectInput. This
   /// base class only implements methods common to all versions of the interface.
   /// @tparam diVersion DirectInput version enumerator.
@@ -85,6 +142,24 @@ namespace Xidi
       effectRegistry.erase(effect);
     }
 
+    /// Attempts to take a previously-pooled force feedback effect object for the specified effect
+    /// GUID. Pooled objects have already been detached from this object and had their parameters
+    /// reset, so the caller is responsible for preparing the returned object for reuse.
+    /// @param [in] rguidEffect Reference to the GUID that identifies the force feedback effect.
+    /// @return Pointer to a pooled effect object, ownership of which transfers to the caller, or
+    /// `nullptr` if the pool holds no object for the specified GUID.
+    VirtualDirectInputEffect<diVersion>* ForceFeedbackEffectPoolTake(REFGUID rguidEffect);
+
+    /// Offers a fully-released force feedback effect object to this object's effect pool so that
+    /// a future effect creation request with the same GUID can reuse it.
+    /// Intended to be invoked automatically as effect objects are fully released.
+    /// @param [in] rguidEffect Reference to the GUID that identifies the force feedback effect.
+    /// @param [in] effectObject Address of the effect object being offered to the pool.
+    /// @return `true` if the pool accepted ownership of the object, `false` if the pool is full,
+    /// in which case the caller retains ownership and should destroy the object as usual.
+    bool ForceFeedbackEffectPoolReturn(
+        REFGUID rguidEffect, VirtualDirectInputEffect<diVersion>* effectObject);
+
     /// Retrieves and returns the configured cooperative level that defines how access to the
     /// underlying physical device is shared with other objects. The cooperative level defaults to
     /// shared but can be updated by the application via an interface method.
@@ -140,6 +215,14 @@ namespace Xidi
       return kObjectId;
     }
 
+    /// Returns this object, including its underlying virtual controller, to its
+    /// freshly-constructed state with a reference count of 1 so that it can be handed back to an
+    /// application as if it were newly created. The virtual controller's background monitoring
+    /// thread and any pooled force feedback effect objects are deliberately retained, since both
+    /// remain usable after reuse. Intended to be invoked automatically as fully-released device
+    /// interface objects are recycled through the device object pool.
+    void PrepareForReuse(void);
+
     // IDirectInputDevice (legacy and 8)
     HRESULT __stdcall Acquire(void) override;
     HRESULT __stdcall CreateEffect(
@@ -201,10 +284,44 @@ namespace Xidi
 
   protected:
 
+    /// Builds the cached table of object instance information structures if it does not currently
+    /// exist. The table contents depend on the virtual controller's capabilities and the
+    /// application's data format, so the table is emptied whenever the data format changes and
+    /// rebuilt on next use.
+    void RefreshCachedObjectEnumerationTable(void);
+
+    /// Implements all of the SetProperty functionality. Wrapped by the interface method so that
+    /// the property value shadow can be refreshed after any property change attempt, irrespective
+    /// of which of the many internal paths produced the result.
+    /// @param [in] rguidProp Property GUID reference. See DirectInput documentation.
+    /// @param [in] pdiph Property value header. See DirectInput documentation.
+    /// @return Result of the property change attempt. See DirectInput documentation.
+    HRESULT SetPropertyInternal(REFGUID rguidProp, LPCDIPROPHEADER pdiph);
+
+    /// Warms the state read path so that the application's first state read after acquisition
+    /// runs at steady-state latency rather than paying cold-start costs. Performs one throwaway
+    /// state retrieval, mapping pass, and data packet write, touching the same memory the read
+    /// path uses, and seeds the cached state packet so the first read can take the differential
+    /// fast path. Does nothing if no application data format is set. Invoked during Acquire;
+    /// purely an optimization, so it produces no result and any internal failure is ignored.
+    void PrewarmStateReadPath(void);
+
     /// Unique internal object identifier. Used for logging purposes to distinguish between multiple
     /// objects associated with the same virtual controller.
     const unsigned int kObjectId;
 
+    /// Return code for the Poll method. Defaults to `DI_NOEFFECT` because polling is not required
+    /// for Xidi virtual controllers, but a configured workaround can change it for applications
+    /// that explicitly check for return codes like `DI_OK`. Computed once at construction so that
+    /// Poll, which applications invoke every frame, is reduced to returning this value.
+    const DWORD kPollReturnCode;
+
+    /// Indicates whether or not diagnostic logging of hot-path method invocations was enabled
+    /// when this device object was created. Sampled once at construction so that per-frame
+    /// methods pay only a single branch on this flag; consequently, raising the logging verbosity
+    /// at runtime does not turn on hot-path invocation logging for existing device objects.
+    const bool kHotPathLoggingEnabled;
+
     /// Virtual controller with which to interface.
     std::unique_ptr<Controller::VirtualController> controller;
 
@@ -213,14 +330,65 @@ namespace Xidi
     /// requires that an applicaton acquire the device in exclusive mode.
     ECooperativeLevel cooperativeLevel;
 
-    /// Data format specification for communicating with the DirectInput application.
-    std::unique_ptr<DataFormat> dataFormat;
+    /// Data format specification for communicating with the DirectInput application. Immutable
+    /// and possibly shared with other devices on which an identical format was set.
+    std::shared_ptr<const DataFormat> dataFormat;
+
+    /// Lookup tables for identifying controller elements in constant time, built once at
+    /// construction from the virtual controller's capabilities.
+    const SElementIdentificationTables elementIdentificationTables;
+
+    /// Shadow copy of commonly-polled property values, populated at construction and refreshed
+    /// whenever SetProperty could have changed one of the shadowed values.
+    SPropertyValueShadow propertyValueShadow;
+
+    /// Cached copy of the most recent application data packet produced by GetDeviceState, valid
+    /// when non-empty. Controllers commonly sit unchanged across many frames while applications
+    /// poll at frame rate, so when the virtual controller state version matches the cached one
+    /// the packet is copied to the application directly and the mapping pass is skipped entirely.
+    /// Invariant: when non-empty this holds exactly the declared data packet size in bytes, with
+    /// every byte exactly as DataFormat::WriteDataPacket defines it, so serving a read from the
+    /// cache is byte-identical to performing a full data packet write. Emptied whenever the
+    /// application data format changes.
+    std::vector<uint8_t> cachedStatePacket;
+
+    /// Virtual controller state version number corresponding to #cachedStatePacket.
+    uint32_t cachedStatePacketVersion;
+
+    /// Cached table of fully-filled object instance information structures, one per enumerable
+    /// object, in enumeration order. Built on first use because the information depends only on
+    /// the virtual controller's capabilities and the application's data format, both of which are
+    /// fixed once set. Repeat object enumerations loop over this table and apply filter flags,
+    /// rather than regenerating names, GUID types, and offsets. Emptied whenever the application
+    /// data format changes.
+    std::vector<typename DirectInputTypes<diVersion>::DeviceObjectInstanceType>
+        cachedObjectEnumerationTable;
+
+    /// Fully-populated device instance information structure, built once at construction because
+    /// its contents are fixed per virtual controller. GetDeviceInfo reduces to copying the number
+    /// of bytes the application requested, which also covers the compatibility version of the
+    /// structure since it is a prefix of the full version.
+    const DirectInputTypes<diVersion>::DeviceInstanceType cachedDeviceInstanceInfo;
+
+    /// Display name of the associated virtual controller in wide-character form, built once at
+    /// construction. Name-valued properties always use wide characters, irrespective of this
+    /// object's character mode, so property requests copy from this cached string instead of
+    /// reformatting the name, which involves a resource string load, on every call.
+    const std::array<WCHAR, MAX_PATH> cachedControllerNameWide;
 
     /// Registry of all force feedback effect objects created by this object. Deliberately not
     /// type-safe to avoid a circular dependency between header files. Used exclusively to allow
     /// DirectInput device objects to enumerate the effect objects associated with them.
     std::set<void*> effectRegistry;
 
+    /// Pool of fully-released force feedback effect objects available for reuse by subsequent
+    /// effect creation requests, keyed by effect GUID and bounded in size per GUID. Pooled objects
+    /// are detached from this object entirely: they are absent from the effect registry and hold
+    /// no reference on this object, so the pool does not keep this object alive. Some applications
+    /// create and release effects at a high rate during gameplay, and pooling turns those cycles
+    /// into parameter resets on warm memory instead of full allocate-construct round trips.
+    std::unordered_map<GUID, std::vector<VirtualDirectInputEffect<diVersion>*>> effectPool;
+
     /// Reference count.
     std::atomic<unsigned long> refCount;
 
@@ -318,4 +486,15 @@ namespace Xidi
         : VirtualDirectInputDeviceVersionLegacyOnly(std::move(controller))
     {}
   };
+
+  /// Attempts to take a previously-pooled device interface object for the specified virtual
+  /// controller. Pooled objects have already been reset to their freshly-constructed state,
+  /// including a reference count of 1, so the returned object can be presented directly to an
+  /// application as if it were newly created.
+  /// @tparam diVersion DirectInput version enumerator.
+  /// @param [in] controllerId Identifier of the virtual controller of interest.
+  /// @return Pointer to a device interface object, ownership of which transfers to the caller, or
+  /// `nullptr` if the pool holds no object for the specified virtual controller.
+  template <EDirectInputVersion diVersion> VirtualDirectInputDeviceBase<diVersion>*
+      VirtualDirectInputDevicePoolTake(Controller::TControllerIdentifier controllerId);
 } // namespace Xidi
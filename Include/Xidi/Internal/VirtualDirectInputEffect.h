@@ -74,6 +74,12 @@ namespace Xidi
     /// See DirectInput documentation for parameter and return type information.
     HRESULT DownloadInternal(void);
 
+    /// Prepares this effect object for reuse after it has been taken from the associated device
+    /// object's effect pool. Re-establishes the state the initialization constructor produces:
+    /// the reference count is reset, the associated device object is referenced, this object is
+    /// registered with it, and all effect parameters are reset back to their defaults.
+    void PrepareForReuse(void);
+
     /// Dumps the contents of the provided effect parameter structure to the log.
     /// Intended for internal use.
     /// @param [in] peff Pointer to the effect structure to dump.
@@ -145,8 +151,28 @@ namespace Xidi
       return effect->Clone();
     }
 
+    /// Applies type-specific effect parameters directly to the underlying effect, without cloning
+    /// it first. Used by the parameter update fast path for applications that submit
+    /// type-specific-only updates every frame. Can be overridden by subclasses. The default
+    /// implementation accepts and ignores the parameters because no type-specific parameters exist
+    /// in the base case.
+    /// @param [in] peff Structure containing type-specific effect parameter data.
+    /// @return `true` if the parameters were applied successfully, `false` if they are invalid. On
+    /// failure the underlying effect is left untouched.
+    virtual bool SetTypeSpecificParametersDirect(LPCDIEFFECT peff)
+    {
+      return true;
+    }
+
   private:
 
+    /// Detaches this effect object from the associated device object in preparation for sitting
+    /// in its effect pool: the effect is removed from the physical device if downloaded,
+    /// unregistered, and the reference held on the device object is released so that pooled
+    /// objects do not keep the device object alive. Invoked on full release once the pool has
+    /// accepted ownership of this object.
+    void DetachForPooling(void);
+
     /// Associated DirectInput device object.
     VirtualDirectInputDeviceBase<diVersion>& associatedDevice;
 
@@ -158,6 +184,11 @@ namespace Xidi
 
     /// Reference count.
     std::atomic<unsigned long> refCount;
+
+    /// Whether this effect object is currently detached from the associated device object and
+    /// sitting in its effect pool. Pooled objects have already been cleaned up, so destruction
+    /// skips the detachment steps that would otherwise run.
+    bool isDetachedForPooling;
   };
 
   /// Template for DirectInput force feedback effect objects that have type-specific parameters.
@@ -237,6 +268,18 @@ namespace Xidi
       return std::move(updatedEffect);
     }
 
+    bool SetTypeSpecificParametersDirect(LPCDIEFFECT peff) override
+    {
+      if (peff->cbTypeSpecificParams < sizeof(DirectInputTypeSpecificParameterType)) return false;
+
+      if (nullptr == peff->lpvTypeSpecificParams) return false;
+
+      const DirectInputTypeSpecificParameterType& directInputTypeSpecificParams =
+          *((DirectInputTypeSpecificParameterType*)peff->lpvTypeSpecificParams);
+      return TypedUnderlyingEffect().SetTypeSpecificParameters(
+          ConvertFromDirectInput(directInputTypeSpecificParams));
+    }
+
     /// Converts from the DirectInput type-specific parameter type to the internal type-specific
     /// parameter type. Performs no error-checking.
     /// @param [in] diTypeSpecificParams Type-specific parameters in DirectInput format.
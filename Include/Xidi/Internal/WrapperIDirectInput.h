@@ -11,6 +11,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "ApiDirectInput.h"
 
 namespace Xidi
@@ -34,6 +40,11 @@ namespace Xidi
     static BOOL __stdcall CallbackEnumDevicesFiltered(
         const DirectInputTypes<diVersion>::DeviceInstanceType* lpddi, LPVOID pvRef);
 
+    /// Callback used to capture enumerated device instance records into a cache entry instead of
+    /// presenting them to the application.
+    static BOOL __stdcall CallbackEnumDevicesCapture(
+        const DirectInputTypes<diVersion>::DeviceInstanceType* lpddi, LPVOID pvRef);
+
     // IUnknown
     HRESULT __stdcall QueryInterface(REFIID riid, LPVOID* ppvObj) override;
     ULONG __stdcall AddRef(void) override;
@@ -61,6 +72,40 @@ namespace Xidi
 
     /// The underlying IDirectInput8 object that this instance wraps.
     DirectInputTypes<diVersion>::IDirectInputType* underlyingDIObject;
+
+  private:
+
+    /// Cached result of one merged device enumeration.
+    struct SCachedEnumeration
+    {
+      /// Device change notification generation at the time this cache entry was built. The entry
+      /// is stale, and must be rebuilt, once the generation moves past this value.
+      uint32_t deviceChangeGeneration;
+
+      /// Merged, ordered device instance records exactly as they are presented to applications.
+      std::vector<typename DirectInputTypes<diVersion>::DeviceInstanceType> deviceInstances;
+    };
+
+    /// Runs the full merged device enumeration, including both Xidi virtual controllers and
+    /// filtered system devices, presenting each device instance to the supplied callback.
+    /// @param [in] dwDevType Device type filter, supplied by the application.
+    /// @param [in] lpCallback Callback to invoke once per enumerated device.
+    /// @param [in] pvRef Opaque parameter to pass to the callback.
+    /// @param [in] dwFlags Enumeration behavior flags, supplied by the application.
+    /// @return `DI_OK` on success, or an underlying enumeration error code on failure.
+    HRESULT EnumDevicesInternal(
+        DWORD dwDevType,
+        DirectInputTypes<diVersion>::EnumDevicesCallbackType lpCallback,
+        LPVOID pvRef,
+        DWORD dwFlags);
+
+    /// Cached merged enumeration results, keyed by the device type and flags parameters that
+    /// produced them. Guarded by #enumerationCacheGuard.
+    std::map<std::pair<DWORD, DWORD>, SCachedEnumeration> cachedEnumerations;
+
+    /// Serializes access to the enumeration cache, which can be consulted by multiple
+    /// application threads concurrently.
+    std::mutex enumerationCacheGuard;
   };
 
   /// Subclass for methods only present in version 8 of the IDirectInput interface.
@@ -0,0 +1,49 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file AllocationCounter.h
+ *   Declaration of test-process heap allocation counting. The test executable replaces the
+ *   global allocation operators with counting versions, so tests can assert that a code path
+ *   performs no heap allocation whatsoever. Used to codify the zero-allocation invariant on hot
+ *   input pipeline paths.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace XidiTest
+{
+  /// Retrieves the total number of heap allocations made by the test process since it started.
+  /// Counts every invocation of a global allocation operator, irrespective of size or alignment.
+  /// @return Total number of heap allocations made so far.
+  uint64_t GetTotalHeapAllocationCount(void);
+
+  /// Counts heap allocations made during its own lifetime. Intended to be placed on the stack
+  /// around a code path that is expected not to allocate, after any lazy initialization that
+  /// path performs has already been triggered.
+  class ScopedAllocationCounter
+  {
+  public:
+
+    inline ScopedAllocationCounter(void)
+        : initialAllocationCount(GetTotalHeapAllocationCount())
+    {}
+
+    /// Retrieves the number of heap allocations made since this object was constructed.
+    /// @return Number of heap allocations observed so far during this object's lifetime.
+    inline uint64_t NumAllocations(void) const
+    {
+      return (GetTotalHeapAllocationCount() - initialAllocationCount);
+    }
+
+  private:
+
+    /// Total process-wide allocation count captured at construction time.
+    const uint64_t initialAllocationCount;
+  };
+} // namespace XidiTest
@@ -24,6 +24,11 @@ namespace XidiTest
 {
   using namespace ::Xidi::Controller;
 
+  /// Simulates a system device change notification by incrementing the mock device change
+  /// notification generation counter, which is what the physical controller interface reports to
+  /// consumers that cache device enumeration results.
+  void SimulateDeviceChangeNotification(void);
+
   /// Object used to exert behavioral control over the physical controller interface. The physical
   /// controller interface itself is implemented as free functions. Test cases can use instances of
   /// this object to control the behavior of that interface. All required state is maintained in an
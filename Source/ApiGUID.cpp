@@ -15,29 +15,56 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 
-size_t std::hash<GUID>::operator()(REFGUID keyval) const
+/// Loads the low and high 64-bit halves of a GUID. The memcpy calls express unaligned loads
+/// portably and compile down to plain 64-bit register loads.
+/// @param [in] guid GUID whose halves are to be loaded.
+/// @param [out] lowHalf Filled with the low 64 bits of the GUID.
+/// @param [out] highHalf Filled with the high 64 bits of the GUID.
+static inline void LoadGuidHalves(REFGUID guid, uint64_t& lowHalf, uint64_t& highHalf)
 {
   static_assert(
-      0 == (sizeof(GUID) % sizeof(size_t)), "GUID size is not aligned with the piece size.");
+      (2 * sizeof(uint64_t)) == sizeof(GUID), "GUID is expected to be exactly 128 bits in size.");
 
-  constexpr int kNumPieces = sizeof(GUID) / sizeof(size_t);
-  static_assert(kNumPieces >= 1, "GUID size is too small compared to the piece size.");
+  memcpy(&lowHalf, &guid, sizeof(lowHalf));
+  memcpy(&highHalf, (const uint8_t*)&guid + sizeof(lowHalf), sizeof(highHalf));
+}
 
-  const size_t* rawGUID = (const size_t*)&keyval;
-  std::hash<size_t> hasher;
+size_t std::hash<GUID>::operator()(REFGUID keyval) const
+{
+  uint64_t lowHalf = 0;
+  uint64_t highHalf = 0;
+  LoadGuidHalves(keyval, lowHalf, highHalf);
 
-  size_t hash = 0;
-  for (int i = 0; i < kNumPieces; ++i)
-    hash ^= hasher(rawGUID[i]);
+  // Combines the two halves and then applies the SplitMix64 mixing finalizer. GUIDs differ from
+  // one another only in a few bits or bytes in practice, so the finalizer's job is to spread
+  // those differences across the entire hash value, which matters for containers that derive a
+  // bucket or slot index from its low-order bits.
+  uint64_t hashValue = lowHalf ^ (highHalf * 0x9e3779b97f4a7c15ull);
+  hashValue ^= (hashValue >> 30);
+  hashValue *= 0xbf58476d1ce4e5b9ull;
+  hashValue ^= (hashValue >> 27);
+  hashValue *= 0x94d049bb133111ebull;
+  hashValue ^= (hashValue >> 31);
 
-  return hash;
+  return (size_t)hashValue;
 }
 
 bool std::equal_to<GUID>::operator()(REFGUID lhs, REFGUID rhs) const
 {
-  return (memcmp(&lhs, &rhs, sizeof(GUID)) == 0);
+  uint64_t lhsLowHalf = 0;
+  uint64_t lhsHighHalf = 0;
+  LoadGuidHalves(lhs, lhsLowHalf, lhsHighHalf);
+
+  uint64_t rhsLowHalf = 0;
+  uint64_t rhsHighHalf = 0;
+  LoadGuidHalves(rhs, rhsLowHalf, rhsHighHalf);
+
+  // Expressed branch-free so the comparison compiles to a single 128-bit compare: two quadword
+  // comparisons whose results are combined without intervening control flow.
+  return ((lhsLowHalf == rhsLowHalf) & (lhsHighHalf == rhsHighHalf));
 }
 
 bool std::less<GUID>::operator()(REFGUID lhs, REFGUID rhs) const
@@ -6,7 +6,8 @@
  * Copyright (c) 2016-2026
  ***********************************************************************************************//**
  * @file ApiXidiImportFunctions2.cpp
- *   Implementation of the ImportFunctions2 part of the Xidi API.
+ *   Implementation of the import function replacement part of the Xidi API, currently at
+ *   interface version 3.
  **************************************************************************************************/
 
 #include <unordered_map>
@@ -19,8 +20,9 @@ namespace Xidi
 {
   namespace Api
   {
-    /// Implements the Xidi API interface #IImportFunctions2.
-    class ImportFunctionsReplacer : public IImportFunctions2
+    /// Implements the Xidi API interface #IImportFunctions3, which also serves older loaders
+    /// that only use the #IImportFunctions2 part of the interface.
+    class ImportFunctionsReplacer : public IImportFunctions3
     {
     public:
 
@@ -53,6 +55,17 @@ namespace Xidi
         return numReplacedFunctions;
       }
 
+      // IImportFunctions3
+      bool SetReplaceableAll(
+          ELibrary library,
+          const std::unordered_map<std::wstring_view, const void*>& importFunctionTable) override
+      {
+        const auto mutableImportTableIter = mutableImportTablesByLibrary.find(library);
+        if (mutableImportTablesByLibrary.cend() == mutableImportTableIter) return false;
+
+        return mutableImportTableIter->second->SetReplaceableAll(importFunctionTable);
+      }
+
     private:
 
       /// Map from library to associated mutable import table interface.
@@ -69,5 +82,30 @@ namespace Xidi
 
     // Singleton Xidi API implementation object.
     static ImportFunctionsReplacer importFunctionsReplacer;
+
+    /// Keeps the import function replacement implementation registered under the older
+    /// ImportFunctions2 API class by forwarding to the version 3 implementation object, so that
+    /// loader modules built against interface version 2 continue to work.
+    class ImportFunctionsReplacerVersion2 : public IImportFunctions2
+    {
+    public:
+
+      // IImportFunctions2
+      const std::unordered_map<std::wstring_view, size_t>* GetReplaceable(
+          ELibrary library) const override
+      {
+        return importFunctionsReplacer.GetReplaceable(library);
+      }
+
+      size_t SetReplaceable(
+          ELibrary library,
+          const std::unordered_map<std::wstring_view, const void*>& importFunctionTable) override
+      {
+        return importFunctionsReplacer.SetReplaceable(library, importFunctionTable);
+      }
+    };
+
+    // Singleton Xidi API implementation object for the older interface version.
+    static ImportFunctionsReplacerVersion2 importFunctionsReplacerVersion2;
   } // namespace Api
 } // namespace Xidi
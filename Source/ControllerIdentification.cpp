@@ -12,9 +12,16 @@
 
 #include "ControllerIdentification.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #include <Infra/Core/Configuration.h>
 #include <Infra/Core/Message.h>
@@ -24,9 +31,13 @@
 
 #include "ApiBitSet.h"
 #include "ApiDirectInput.h"
+#include "ApiGUID.h"
 #include "ControllerTypes.h"
 #include "Globals.h"
+#include "GuidHashTable.h"
 #include "Mapper.h"
+#include "MemoryAccounting.h"
+#include "PhysicalController.h"
 #include "Strings.h"
 
 namespace Xidi
@@ -151,7 +162,7 @@ namespace Xidi
   {
     static const bool useShortVirtualControllerNames =
         Globals::GetConfigurationData()
-            [Strings::kStrConfigurationSectionWorkarounds]
+            [Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionWorkarounds)]
             [Strings::kStrConfigurationSettingsWorkaroundsUseShortVirtualControllerNames]
                 .ValueOr(false);
     return useShortVirtualControllerNames;
@@ -251,10 +262,69 @@ namespace Xidi
     return std::nullopt;
   }
 
-  template <EDirectInputVersion diVersion> bool DoesDirectInputControllerSupportXInput(
-      typename DirectInputTypes<diVersion>::IDirectInputCompatType* dicontext,
-      REFGUID instanceGUID,
-      std::wstring* devicePath)
+  /// Maximum number of worker threads used to run XInput support checks concurrently during a
+  /// prescan operation. Each check creates a device interface object and queries it for a
+  /// property, so the checks are independent of one another and overlap well.
+  static constexpr size_t kXInputSupportCheckMaxWorkers = 4;
+
+  /// Holds the result of a single XInput support check.
+  struct SXInputSupportCheckResult
+  {
+    /// Whether or not the device supports XInput.
+    bool supportsXInput;
+
+    /// Device identifying path, filled in only if the device supports XInput.
+    std::wstring devicePath;
+  };
+
+  /// Cached XInput support check results, keyed by device instance GUID. Instance GUIDs are stable
+  /// for as long as a device remains attached, so cached results are only valid until the system
+  /// reports a device change. Guarded by #xinputSupportCheckCacheGuard.
+  static GuidHashMap<SXInputSupportCheckResult> xinputSupportCheckCache;
+
+  /// Device change notification generation at the time the cached XInput support check results
+  /// were recorded. Guarded by #xinputSupportCheckCacheGuard.
+  static uint32_t xinputSupportCheckCacheGeneration = 0;
+
+  /// Estimated number of bytes held by the XInput support check cache, covering its keys and
+  /// stored values but not container bookkeeping overhead. Guarded by
+  /// #xinputSupportCheckCacheGuard.
+  static uint64_t xinputSupportCheckCacheBytesEstimate = 0;
+
+  /// Maximum number of XInput support check results retained while low-memory mode is enabled.
+  /// Systems with fewer attached devices than this are unaffected by the cap.
+  static constexpr size_t kXInputSupportCheckCacheLowMemoryMaxEntries = 8;
+
+  /// Serializes access to the XInput support check cache, which is consulted both by application
+  /// threads and by prescan worker threads.
+  static std::mutex xinputSupportCheckCacheGuard;
+
+  /// Evicts all cached XInput support check results if the system has reported a hardware change
+  /// since they were recorded. Must be invoked with #xinputSupportCheckCacheGuard held.
+  /// @param [in] currentGeneration Current device change notification generation.
+  static void EvictStaleXInputSupportCheckResults(uint32_t currentGeneration)
+  {
+    if (currentGeneration != xinputSupportCheckCacheGeneration)
+    {
+      xinputSupportCheckCache.Clear();
+      xinputSupportCheckCacheGeneration = currentGeneration;
+
+      MemoryAccounting::RecordRelease(
+          MemoryAccounting::ESubsystem::IdentityCaches, xinputSupportCheckCacheBytesEstimate);
+      xinputSupportCheckCacheBytesEstimate = 0;
+    }
+  }
+
+  /// Performs the actual XInput support check for a single DirectInput controller, without
+  /// consulting the cache. Refer to #DoesDirectInputControllerSupportXInput for more information.
+  /// @tparam diVersion DirectInput version enumerator.
+  /// @param [in] dicontext IDirectInput context from which the controller is to be obtained.
+  /// @param [in] instanceGUID DirectInput instance GUID identifying the controller.
+  /// @return Result of the check, including the device path if the controller supports XInput.
+  template <EDirectInputVersion diVersion> static SXInputSupportCheckResult
+      CheckDirectInputControllerXInputSupport(
+          typename DirectInputTypes<diVersion>::IDirectInputCompatType* dicontext,
+          REFGUID instanceGUID)
   {
     bool deviceSupportsXInput = false;
 
@@ -268,7 +338,7 @@ namespace Xidi
           L"Unable to check if device with instance GUID %s supports XInput: Failed to create the device (result = 0x%08x).",
           Strings::GuidToString(instanceGUID).AsCString(),
           static_cast<unsigned int>(result));
-      return false;
+      return {.supportsXInput = false};
     }
 
     DIPROPGUIDANDPATH devinfo = {
@@ -287,15 +357,17 @@ namespace Xidi
           L"Unable to check if device with instance GUID %s supports XInput: Failed to query for property DIPROP_GUIDANDPATH (result = 0x%08x).",
           Strings::GuidToString(instanceGUID).AsCString(),
           static_cast<unsigned int>(result));
-      return false;
+      return {.supportsXInput = false};
     }
 
+    SXInputSupportCheckResult checkResult = {.supportsXInput = false};
+
     // The documented "best" way of determining if a device supports XInput is to look for
     // "&IG_" in the device path string.
     if (nullptr != wcsstr(devinfo.wszPath, L"&IG_") || nullptr != wcsstr(devinfo.wszPath, L"&ig_"))
     {
       deviceSupportsXInput = true;
-      if (nullptr != devicePath) *devicePath = devinfo.wszPath;
+      checkResult = {.supportsXInput = true, .devicePath = devinfo.wszPath};
     }
 
     Infra::Message::OutputFormatted(
@@ -305,6 +377,63 @@ namespace Xidi
         devinfo.wszPath,
         (deviceSupportsXInput ? L"supports" : L"does not support"));
 
+    return checkResult;
+  }
+
+  template <EDirectInputVersion diVersion> bool DoesDirectInputControllerSupportXInput(
+      typename DirectInputTypes<diVersion>::IDirectInputCompatType* dicontext,
+      REFGUID instanceGUID,
+      std::wstring* devicePath)
+  {
+    const uint32_t deviceChangeGeneration = Controller::GetDeviceChangeNotificationGeneration();
+
+    {
+      std::scoped_lock lock(xinputSupportCheckCacheGuard);
+      EvictStaleXInputSupportCheckResults(deviceChangeGeneration);
+
+      const SXInputSupportCheckResult* const cachedResult =
+          xinputSupportCheckCache.Find(instanceGUID);
+      if (nullptr != cachedResult)
+      {
+        if ((true == cachedResult->supportsXInput) && (nullptr != devicePath))
+          *devicePath = cachedResult->devicePath;
+        return cachedResult->supportsXInput;
+      }
+    }
+
+    SXInputSupportCheckResult checkResult =
+        CheckDirectInputControllerXInputSupport<diVersion>(dicontext, instanceGUID);
+    const bool deviceSupportsXInput = checkResult.supportsXInput;
+
+    if ((true == deviceSupportsXInput) && (nullptr != devicePath))
+      *devicePath = checkResult.devicePath;
+
+    {
+      std::scoped_lock lock(xinputSupportCheckCacheGuard);
+      EvictStaleXInputSupportCheckResults(deviceChangeGeneration);
+
+      // In low-memory mode the cache is capped at a small fixed number of entries, bounding its
+      // footprint on systems with many attached devices. Checks beyond the cap stay correct but
+      // are recomputed on each enumeration pass.
+      const size_t cacheEntriesMax =
+          ((true == MemoryAccounting::IsLowMemoryModeEnabled())
+               ? kXInputSupportCheckCacheLowMemoryMaxEntries
+               : SIZE_MAX);
+
+      if ((false == xinputSupportCheckCache.Contains(instanceGUID)) &&
+          (xinputSupportCheckCache.Size() < cacheEntriesMax))
+      {
+        const uint64_t numBytesEstimate =
+            (sizeof(GUID) + sizeof(SXInputSupportCheckResult) +
+             (checkResult.devicePath.size() * sizeof(wchar_t)));
+        xinputSupportCheckCacheBytesEstimate += numBytesEstimate;
+        MemoryAccounting::RecordAllocation(
+            MemoryAccounting::ESubsystem::IdentityCaches, numBytesEstimate);
+
+        xinputSupportCheckCache.InsertOrAssign(instanceGUID, std::move(checkResult));
+      }
+    }
+
     return deviceSupportsXInput;
   }
 
@@ -317,6 +446,69 @@ namespace Xidi
   template bool DoesDirectInputControllerSupportXInput<EDirectInputVersion::kLegacyW>(
       IDirectInputW*, REFGUID, std::wstring*);
 
+  template <EDirectInputVersion diVersion> void PrescanDirectInputControllersForXInputSupport(
+      typename DirectInputTypes<diVersion>::IDirectInputCompatType* dicontext,
+      const std::vector<GUID>& instanceGUIDs)
+  {
+    const uint32_t deviceChangeGeneration = Controller::GetDeviceChangeNotificationGeneration();
+
+    std::vector<GUID> uncachedInstanceGUIDs;
+    uncachedInstanceGUIDs.reserve(instanceGUIDs.size());
+
+    {
+      std::scoped_lock lock(xinputSupportCheckCacheGuard);
+      EvictStaleXInputSupportCheckResults(deviceChangeGeneration);
+
+      for (const GUID& instanceGUID : instanceGUIDs)
+        if (false == xinputSupportCheckCache.Contains(instanceGUID))
+          uncachedInstanceGUIDs.push_back(instanceGUID);
+    }
+
+    if (true == uncachedInstanceGUIDs.empty()) return;
+
+    // With only one check outstanding there is nothing to be gained from extra threads.
+    if (1 == uncachedInstanceGUIDs.size())
+    {
+      DoesDirectInputControllerSupportXInput<diVersion>(
+          dicontext, uncachedInstanceGUIDs.front());
+      return;
+    }
+
+    // DirectInput interface objects follow the free-threaded COM model, so multiple worker
+    // threads can create and query device interface objects through the same context
+    // concurrently. Workers pull instance GUIDs from a shared index so that a single slow device
+    // does not hold up checks for the others.
+    const size_t numWorkers =
+        std::min(kXInputSupportCheckMaxWorkers, uncachedInstanceGUIDs.size());
+    std::atomic<size_t> nextInstanceIndex = 0;
+
+    std::vector<std::thread> workers;
+    workers.reserve(numWorkers);
+
+    for (size_t workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+      workers.emplace_back(
+          [dicontext, &uncachedInstanceGUIDs, &nextInstanceIndex](void) -> void
+          {
+            for (size_t instanceIndex = nextInstanceIndex.fetch_add(1);
+                 instanceIndex < uncachedInstanceGUIDs.size();
+                 instanceIndex = nextInstanceIndex.fetch_add(1))
+              DoesDirectInputControllerSupportXInput<diVersion>(
+                  dicontext, uncachedInstanceGUIDs[instanceIndex]);
+          });
+
+    for (std::thread& worker : workers)
+      worker.join();
+  }
+
+  template void PrescanDirectInputControllersForXInputSupport<EDirectInputVersion::k8A>(
+      IDirectInput8A*, const std::vector<GUID>&);
+  template void PrescanDirectInputControllersForXInputSupport<EDirectInputVersion::k8W>(
+      IDirectInput8W*, const std::vector<GUID>&);
+  template void PrescanDirectInputControllersForXInputSupport<EDirectInputVersion::kLegacyA>(
+      IDirectInputA*, const std::vector<GUID>&);
+  template void PrescanDirectInputControllersForXInputSupport<EDirectInputVersion::kLegacyW>(
+      IDirectInputW*, const std::vector<GUID>&);
+
   template <EDirectInputVersion diVersion> BOOL EnumerateVirtualControllers(
       BOOL(FAR PASCAL* lpCallback)(
           const typename DirectInputTypes<diVersion>::DeviceInstanceType*, LPVOID),
@@ -329,7 +521,7 @@ namespace Xidi
 
     const uint64_t activeVirtualControllerMask =
         Globals::GetConfigurationData()
-            [Strings::kStrConfigurationSectionWorkarounds]
+            [Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionWorkarounds)]
             [Strings::kStrConfigurationSettingWorkaroundsActiveVirtualControllerMask]
                 .ValueOr(UINT64_MAX);
 
@@ -422,29 +614,69 @@ namespace Xidi
       typename DirectInputTypes<diVersion>::DeviceInstanceType& instanceInfo,
       Controller::TControllerIdentifier controllerId)
   {
-    instanceInfo.guidInstance = VirtualControllerGuid(controllerId);
-    instanceInfo.guidProduct = VirtualControllerGuid(controllerId);
-    instanceInfo.dwDevType = DirectInputTypes<diVersion>::XinputGamepadDeviceType();
-    FillVirtualControllerName(
-        instanceInfo.tszInstanceName, _countof(instanceInfo.tszInstanceName), controllerId);
-    FillVirtualControllerName(
-        instanceInfo.tszProductName, _countof(instanceInfo.tszProductName), controllerId);
+    // Identity information is fixed for each virtual controller once the configuration is loaded,
+    // so the complete identity block for all virtual controllers is computed on first use and
+    // thereafter served by copying from this table. Some applications enumerate devices every few
+    // seconds to detect hotplug events, and with this table each enumeration pass involves no
+    // GUID composition or string formatting whatsoever.
+    static const std::array<
+        typename DirectInputTypes<diVersion>::DeviceInstanceType,
+        Controller::kPhysicalControllerCount>
+        kVirtualControllerInstanceInfo = []() -> std::array<
+                                                 typename DirectInputTypes<
+                                                     diVersion>::DeviceInstanceType,
+                                                 Controller::kPhysicalControllerCount>
+    {
+      std::array<
+          typename DirectInputTypes<diVersion>::DeviceInstanceType,
+          Controller::kPhysicalControllerCount>
+          instanceInfoTable = {};
+
+      for (Controller::TControllerIdentifier precomputeControllerId = 0;
+           precomputeControllerId < Controller::kPhysicalControllerCount;
+           ++precomputeControllerId)
+      {
+        typename DirectInputTypes<diVersion>::DeviceInstanceType& tableEntry =
+            instanceInfoTable[precomputeControllerId];
+
+        tableEntry.dwSize = sizeof(tableEntry);
+        tableEntry.guidInstance = VirtualControllerGuid(precomputeControllerId);
+        tableEntry.guidProduct = VirtualControllerGuid(precomputeControllerId);
+        tableEntry.dwDevType = DirectInputTypes<diVersion>::XinputGamepadDeviceType();
+        FillVirtualControllerName(
+            tableEntry.tszInstanceName,
+            _countof(tableEntry.tszInstanceName),
+            precomputeControllerId);
+        FillVirtualControllerName(
+            tableEntry.tszProductName,
+            _countof(tableEntry.tszProductName),
+            precomputeControllerId);
+
+        if (true == DoesControllerSupportForceFeedback(precomputeControllerId))
+          tableEntry.guidFFDriver = kVirtualControllerForceFeedbackDriverGuid;
+        else
+          tableEntry.guidFFDriver = {};
+
+        const SHidUsageData virtualControllerHidData = HidUsageDataForVirtualController();
+        tableEntry.wUsagePage = virtualControllerHidData.usagePage;
+        tableEntry.wUsage = virtualControllerHidData.usage;
+      }
+
+      return instanceInfoTable;
+    }();
+
+    if (controllerId >= Controller::kPhysicalControllerCount) return;
 
     // DirectInput versions 5 and higher include extra members in this structure, and this is
-    // indicated on input using the size member of the structure.
-    if (instanceInfo.dwSize >
-        offsetof(typename DirectInputTypes<diVersion>::DeviceInstanceType, tszProductName) +
-            sizeof(DirectInputTypes<diVersion>::DeviceInstanceType::tszProductName))
-    {
-      if (true == DoesControllerSupportForceFeedback(controllerId))
-        instanceInfo.guidFFDriver = kVirtualControllerForceFeedbackDriverGuid;
-      else
-        instanceInfo.guidFFDriver = {};
-
-      const SHidUsageData virtualControllerHidData = HidUsageDataForVirtualController();
-      instanceInfo.wUsagePage = virtualControllerHidData.usagePage;
-      instanceInfo.wUsage = virtualControllerHidData.usage;
-    }
+    // indicated on input using the size member of the structure. The older version of the
+    // structure is a prefix of the newer version, so copying only the number of bytes the caller
+    // indicated fills exactly the members the caller's structure version defines.
+    const DWORD requestedSize = instanceInfo.dwSize;
+    CopyMemory(
+        &instanceInfo,
+        &kVirtualControllerInstanceInfo[controllerId],
+        std::min((size_t)requestedSize, sizeof(kVirtualControllerInstanceInfo[controllerId])));
+    instanceInfo.dwSize = requestedSize;
   }
 
   template void FillVirtualControllerInfo<EDirectInputVersion::k8A>(
@@ -459,6 +691,36 @@ namespace Xidi
   template <> int FillVirtualControllerName<LPSTR>(
       LPSTR buf, size_t bufcount, Controller::TControllerIdentifier controllerIndex)
   {
+    // Names are formatted from a loadable resource string once per controller and cached, because
+    // this function sits on application-facing enumeration and capability query paths that some
+    // applications invoke repeatedly. Out-of-range controller indices fall through to direct
+    // formatting, which preserves the behavior of producing a name for any index.
+    static const auto kVirtualControllerNames =
+        []() -> std::array<std::array<CHAR, MAX_PATH>, Controller::kPhysicalControllerCount>
+    {
+      Infra::TemporaryBuffer<CHAR> xidiControllerNameFormatString;
+      LoadStringA(
+          Infra::ProcessInfo::GetThisModuleInstanceHandle(),
+          (ShouldUseShortNameFormatForVirtualControllers()
+               ? IDS_XIDI_CONTROLLERIDENTIFICATION_CONTROLLER_SHORT_NAME_FORMAT
+               : IDS_XIDI_CONTROLLERIDENTIFICATION_CONTROLLER_NAME_FORMAT),
+          xidiControllerNameFormatString.Data(),
+          xidiControllerNameFormatString.Capacity());
+
+      std::array<std::array<CHAR, MAX_PATH>, Controller::kPhysicalControllerCount> names = {};
+      for (Controller::TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount; ++i)
+        sprintf_s(
+            names[i].data(),
+            names[i].size(),
+            (LPCSTR)xidiControllerNameFormatString.Data(),
+            (i + 1));
+
+      return names;
+    }();
+
+    if (controllerIndex < Controller::kPhysicalControllerCount)
+      return sprintf_s(buf, bufcount, "%s", kVirtualControllerNames[controllerIndex].data());
+
     Infra::TemporaryBuffer<CHAR> xidiControllerNameFormatString;
     LoadStringA(
         Infra::ProcessInfo::GetThisModuleInstanceHandle(),
@@ -475,6 +737,33 @@ namespace Xidi
   template <> int FillVirtualControllerName<LPWSTR>(
       LPWSTR buf, size_t bufcount, Controller::TControllerIdentifier controllerIndex)
   {
+    // See above regarding caching. This is the wide-character analog of the same logic.
+    static const auto kVirtualControllerNames =
+        []() -> std::array<std::array<WCHAR, MAX_PATH>, Controller::kPhysicalControllerCount>
+    {
+      Infra::TemporaryBuffer<WCHAR> xidiControllerNameFormatString;
+      LoadStringW(
+          Infra::ProcessInfo::GetThisModuleInstanceHandle(),
+          (ShouldUseShortNameFormatForVirtualControllers()
+               ? IDS_XIDI_CONTROLLERIDENTIFICATION_CONTROLLER_SHORT_NAME_FORMAT
+               : IDS_XIDI_CONTROLLERIDENTIFICATION_CONTROLLER_NAME_FORMAT),
+          xidiControllerNameFormatString.Data(),
+          xidiControllerNameFormatString.Capacity());
+
+      std::array<std::array<WCHAR, MAX_PATH>, Controller::kPhysicalControllerCount> names = {};
+      for (Controller::TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount; ++i)
+        swprintf_s(
+            names[i].data(),
+            names[i].size(),
+            (LPCWSTR)xidiControllerNameFormatString.Data(),
+            (i + 1));
+
+      return names;
+    }();
+
+    if (controllerIndex < Controller::kPhysicalControllerCount)
+      return swprintf_s(buf, bufcount, L"%s", kVirtualControllerNames[controllerIndex].data());
+
     Infra::TemporaryBuffer<WCHAR> xidiControllerNameFormatString;
     LoadStringW(
         Infra::ProcessInfo::GetThisModuleInstanceHandle(),
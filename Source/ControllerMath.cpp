@@ -13,6 +13,7 @@
 #include "ControllerMath.h"
 
 #include <cmath>
+#include <emmintrin.h>
 
 #include "ControllerTypes.h"
 
@@ -46,6 +47,153 @@ namespace Xidi
         return kAnalogValueNeutral + (int16_t)(transformedAnalogBase * transformationScaleFactor);
       }
 
+      void ApplyRawAnalogTransformBatch(
+          const int16_t (&analogValues)[4],
+          const SAnalogTransformParams (&transformParams)[4],
+          int16_t (&transformedValues)[4])
+      {
+        static_assert(
+            0 == kAnalogValueNeutral, "Deadzone lanes are masked directly to the neutral value.");
+
+        // Most commonly all lanes are configured as pass-through, in which case the transformation
+        // can be skipped entirely, mirroring the early return in the scalar version.
+        bool allLanesPassThrough = true;
+        for (const auto& laneParams : transformParams)
+        {
+          if ((0 != laneParams.deadzonePercent) || (100 != laneParams.saturationPercent))
+          {
+            allLanesPassThrough = false;
+            break;
+          }
+        }
+
+        if (true == allLanesPassThrough)
+        {
+          for (int lane = 0; lane < _countof(analogValues); ++lane)
+            transformedValues[lane] = analogValues[lane];
+          return;
+        }
+
+        // Per-lane cutoffs and scale factors are computed with the exact same integer and
+        // floating-point expressions as the scalar version so that results match bit-for-bit.
+        // Lanes where the saturation cutoff equals the deadzone cutoff produce an infinite scale
+        // factor, but such lanes always take the deadzone or saturation select below, so the
+        // linear-region product is discarded.
+        alignas(16) double laneValues[4];
+        alignas(16) double laneDeadzoneCutoffs[4];
+        alignas(16) double laneSaturationCutoffs[4];
+        alignas(16) double laneScaleFactors[4];
+
+        for (int lane = 0; lane < _countof(analogValues); ++lane)
+        {
+          const int16_t deadzoneCutoff =
+              ((kAnalogValueMax - kAnalogValueNeutral) * transformParams[lane].deadzonePercent) /
+              100;
+          const int16_t saturationCutoff =
+              ((kAnalogValueMax - kAnalogValueNeutral) * transformParams[lane].saturationPercent) /
+              100;
+
+          laneValues[lane] = (double)analogValues[lane];
+          laneDeadzoneCutoffs[lane] = (double)deadzoneCutoff;
+          laneSaturationCutoffs[lane] = (double)saturationCutoff;
+          laneScaleFactors[lane] = ((double)(kAnalogValueMax - kAnalogValueNeutral)) /
+              ((double)(saturationCutoff - deadzoneCutoff));
+        }
+
+        for (int lanePair = 0; lanePair < 2; ++lanePair)
+        {
+          const __m128d values = _mm_load_pd(&laneValues[2 * lanePair]);
+          const __m128d deadzoneCutoffs = _mm_load_pd(&laneDeadzoneCutoffs[2 * lanePair]);
+          const __m128d saturationCutoffs = _mm_load_pd(&laneSaturationCutoffs[2 * lanePair]);
+          const __m128d scaleFactors = _mm_load_pd(&laneScaleFactors[2 * lanePair]);
+
+          const __m128d absValues = _mm_andnot_pd(_mm_set1_pd(-0.0), values);
+          const __m128d isNonNegative = _mm_cmpge_pd(values, _mm_setzero_pd());
+
+          // Linear region: (value -/+ deadzoneCutoff) * scaleFactor, with the sign of the cutoff
+          // adjustment selected per lane based on the sign of the value.
+          const __m128d transformedBases = _mm_or_pd(
+              _mm_and_pd(isNonNegative, _mm_sub_pd(values, deadzoneCutoffs)),
+              _mm_andnot_pd(isNonNegative, _mm_add_pd(values, deadzoneCutoffs)));
+          __m128d results = _mm_mul_pd(transformedBases, scaleFactors);
+
+          // Saturation region: extreme value in the direction of the input.
+          const __m128d saturatedValues = _mm_or_pd(
+              _mm_and_pd(isNonNegative, _mm_set1_pd((double)kAnalogValueMax)),
+              _mm_andnot_pd(isNonNegative, _mm_set1_pd((double)kAnalogValueMin)));
+          const __m128d isSaturated = _mm_cmpge_pd(absValues, saturationCutoffs);
+          results = _mm_or_pd(
+              _mm_and_pd(isSaturated, saturatedValues), _mm_andnot_pd(isSaturated, results));
+
+          // Deadzone region overrides everything else, same as in the scalar version, and forces
+          // the result to the neutral value.
+          const __m128d isInDeadzone = _mm_cmple_pd(absValues, deadzoneCutoffs);
+          results = _mm_andnot_pd(isInDeadzone, results);
+
+          const __m128i resultsInt = _mm_cvttpd_epi32(results);
+          transformedValues[(2 * lanePair) + 0] = (int16_t)_mm_cvtsi128_si32(resultsInt);
+          transformedValues[(2 * lanePair) + 1] =
+              (int16_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(resultsInt, _MM_SHUFFLE(1, 1, 1, 1)));
+        }
+
+        // Individual pass-through lanes take the scalar version's early return, which passes the
+        // input through without even saturating it at the extreme analog values.
+        for (int lane = 0; lane < _countof(analogValues); ++lane)
+        {
+          if ((0 == transformParams[lane].deadzonePercent) &&
+              (100 == transformParams[lane].saturationPercent))
+            transformedValues[lane] = analogValues[lane];
+        }
+      }
+
+      SAnalogStickCoordinates ApplyRadialAnalogTransform(
+          SAnalogStickCoordinates coordinates,
+          unsigned int deadzonePercent,
+          unsigned int saturationPercent)
+      {
+        if ((0 == deadzonePercent) && (100 == saturationPercent)) return coordinates;
+
+        const int16_t deadzoneCutoff =
+            ((kAnalogValueMax - kAnalogValueNeutral) * deadzonePercent) / 100;
+        const int16_t saturationCutoff =
+            ((kAnalogValueMax - kAnalogValueNeutral) * saturationPercent) / 100;
+
+        // Magnitude is computed once for the whole stick vector. Both squares come from a single
+        // vector multiply, and on diagonals the magnitude can exceed the single-axis extreme,
+        // which is expected and handled by the saturation case below.
+        const __m128d coordinateVector =
+            _mm_setr_pd((double)coordinates.x, (double)coordinates.y);
+        const __m128d coordinatesSquared = _mm_mul_pd(coordinateVector, coordinateVector);
+        const double magnitude = std::sqrt(_mm_cvtsd_f64(
+            _mm_add_sd(coordinatesSquared, _mm_unpackhi_pd(coordinatesSquared, coordinatesSquared))));
+
+        if (magnitude <= (double)deadzoneCutoff)
+          return {.x = kAnalogValueNeutral, .y = kAnalogValueNeutral};
+
+        // Saturation clamps the magnitude to the extreme analog value while preserving direction,
+        // and the linear region rescales the magnitude between the cutoffs to the full analog
+        // range, exactly as the scalar transform does for a single axis.
+        double magnitudeScaleFactor = 0.0;
+        if (magnitude >= (double)saturationCutoff)
+          magnitudeScaleFactor = ((double)(kAnalogValueMax - kAnalogValueNeutral)) / magnitude;
+        else
+          magnitudeScaleFactor = (((magnitude - (double)deadzoneCutoff) *
+                                   (((double)(kAnalogValueMax - kAnalogValueNeutral)) /
+                                    ((double)(saturationCutoff - deadzoneCutoff)))) /
+                                  magnitude);
+
+        // Both axes are scaled together by the common factor in one vector multiply, which is
+        // what keeps the transformed position on the same ray from center as the input.
+        alignas(16) double scaledCoordinates[2];
+        _mm_store_pd(
+            scaledCoordinates,
+            _mm_mul_pd(coordinateVector, _mm_set1_pd(magnitudeScaleFactor)));
+
+        return {
+            .x = (int16_t)scaledCoordinates[0],
+            .y = (int16_t)scaledCoordinates[1]};
+      }
+
       uint8_t ApplyRawTriggerTransform(
           uint8_t triggerValue, unsigned int deadzonePercent, unsigned int saturationPercent)
       {
@@ -70,6 +218,88 @@ namespace Xidi
         return kTriggerValueMin + (uint8_t)(transformedTriggerBase * transformationScaleFactor);
       }
 
+      void ApplyRawTriggerTransformBatch(
+          const uint8_t (&triggerValues)[2],
+          const SAnalogTransformParams (&transformParams)[2],
+          uint8_t (&transformedValues)[2])
+      {
+        // As with the analog batch kernel, pass-through configuration for all lanes is by far the
+        // most common situation and skips the transformation entirely.
+        bool allLanesPassThrough = true;
+        for (const auto& laneParams : transformParams)
+        {
+          if ((0 != laneParams.deadzonePercent) || (100 != laneParams.saturationPercent))
+          {
+            allLanesPassThrough = false;
+            break;
+          }
+        }
+
+        if (true == allLanesPassThrough)
+        {
+          for (int lane = 0; lane < _countof(triggerValues); ++lane)
+            transformedValues[lane] = triggerValues[lane];
+          return;
+        }
+
+        // Cutoffs, scale factors, and the linear-region math all mirror the scalar version
+        // exactly, including its use of single-precision arithmetic, so results match
+        // bit-for-bit. Only the two low lanes of each vector are meaningful.
+        alignas(16) float laneValues[4] = {};
+        alignas(16) float laneScaleFactors[4] = {};
+        uint8_t laneDeadzoneCutoffs[2];
+        uint8_t laneSaturationCutoffs[2];
+
+        for (int lane = 0; lane < _countof(triggerValues); ++lane)
+        {
+          laneDeadzoneCutoffs[lane] =
+              (uint8_t)((((unsigned int)kTriggerValueMax - (unsigned int)kTriggerValueMin) *
+                         transformParams[lane].deadzonePercent) /
+                        100);
+          laneSaturationCutoffs[lane] =
+              (uint8_t)((((unsigned int)kTriggerValueMax - (unsigned int)kTriggerValueMin) *
+                         transformParams[lane].saturationPercent) /
+                        100);
+
+          laneValues[lane] = (float)triggerValues[lane];
+          laneScaleFactors[lane] = ((float)(kTriggerValueMax - kTriggerValueMin)) /
+              ((float)(laneSaturationCutoffs[lane] - laneDeadzoneCutoffs[lane]));
+        }
+
+        const __m128 values = _mm_load_ps(laneValues);
+        const __m128 deadzoneCutoffs =
+            _mm_setr_ps((float)laneDeadzoneCutoffs[0], (float)laneDeadzoneCutoffs[1], 0.0f, 0.0f);
+        const __m128 saturationCutoffs = _mm_setr_ps(
+            (float)laneSaturationCutoffs[0], (float)laneSaturationCutoffs[1], 0.0f, 0.0f);
+
+        const __m128 linearResults = _mm_mul_ps(
+            _mm_sub_ps(values, deadzoneCutoffs), _mm_load_ps(laneScaleFactors));
+        const __m128i linearResultsInt = _mm_cvttps_epi32(linearResults);
+
+        const int isInDeadzoneMask = _mm_movemask_ps(_mm_cmple_ps(values, deadzoneCutoffs));
+        const int isSaturatedMask = _mm_movemask_ps(_mm_cmpge_ps(values, saturationCutoffs));
+
+        for (int lane = 0; lane < _countof(triggerValues); ++lane)
+        {
+          const int laneBit = (1 << lane);
+
+          if ((0 == transformParams[lane].deadzonePercent) &&
+              (100 == transformParams[lane].saturationPercent))
+            transformedValues[lane] = triggerValues[lane];
+          else if (0 != (isInDeadzoneMask & laneBit))
+            transformedValues[lane] = kTriggerValueMin;
+          else if (0 != (isSaturatedMask & laneBit))
+            transformedValues[lane] = kTriggerValueMax;
+          else
+            transformedValues[lane] =
+                (uint8_t)(kTriggerValueMin +
+                          ((0 == lane)
+                               ? _mm_cvtsi128_si32(linearResultsInt)
+                               : _mm_cvtsi128_si32(
+                                     _mm_shuffle_epi32(linearResultsInt, _MM_SHUFFLE(1, 1, 1, 1)))));
+        }
+      }
+
       SAnalogStickCoordinates TransformCoordinatesCircleToSquare(
           SAnalogStickCoordinates circleCoords, double amountFraction)
       {
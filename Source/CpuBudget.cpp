@@ -0,0 +1,254 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file CpuBudget.cpp
+ *   Implementation of the per-process CPU budget governor for Xidi's worker threads.
+ **************************************************************************************************/
+
+#include "CpuBudget.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+#include "ApiXidi.h"
+#include "Globals.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace CpuBudget
+  {
+    /// Interval between governor sampling passes. Long enough that the cost of a pass, a handful
+    /// of cycle time queries, is negligible, but short enough that an over-budget condition is
+    /// corrected within a few seconds.
+    static constexpr unsigned int kGovernorSamplePeriodMilliseconds = 1000;
+
+    /// Period scale factor currently in effect, consulted by worker thread loops once per
+    /// iteration.
+    static std::atomic<unsigned int> currentPeriodScaleFactor = 1;
+
+    /// Aggregate cycle count across all registered worker threads, as of the most recent
+    /// governor sampling pass.
+    static std::atomic<uint64_t> lastAggregateCycleCount = 0;
+
+    /// Aggregate worker thread CPU utilization over the most recent sample interval, as a
+    /// percentage of one processor core.
+    static std::atomic<double> lastUtilizationPercentOfCore = 0.0;
+
+    /// Serializes access to the worker thread registry.
+    static std::mutex workerThreadRegistryGuard;
+
+    /// Retrieves the registry of handles for all worker threads registered with the governor.
+    /// Must only be accessed while holding #workerThreadRegistryGuard. The underlying object is
+    /// deliberately leaked so that the governor's sampling pass, which runs on a detached
+    /// background task worker thread, can never observe it destroyed.
+    /// @return Mutable reference to the worker thread handle registry.
+    static std::vector<HANDLE>& WorkerThreadRegistry(void)
+    {
+      static std::vector<HANDLE>* const workerThreadRegistry = new std::vector<HANDLE>;
+      return *workerThreadRegistry;
+    }
+
+    /// Retrieves the nominal number of processor cycles per millisecond, used to convert thread
+    /// cycle counts into time. The nominal frequency is read once from the registry; dynamic
+    /// frequency scaling means the conversion is approximate, which is acceptable because the
+    /// budget itself is a coarse contractual bound rather than a precise measurement.
+    /// @return Nominal cycles per millisecond, or 0 if the processor frequency could not be
+    /// determined, in which case the governor stays inactive.
+    static uint64_t NominalCyclesPerMillisecond(void)
+    {
+      static const uint64_t nominalCyclesPerMillisecond = []() -> uint64_t
+      {
+        DWORD processorFrequencyMhz = 0;
+        DWORD dataSizeBytes = sizeof(processorFrequencyMhz);
+
+        if (ERROR_SUCCESS !=
+            RegGetValueW(
+                HKEY_LOCAL_MACHINE,
+                L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                L"~MHz",
+                RRF_RT_REG_DWORD,
+                nullptr,
+                &processorFrequencyMhz,
+                &dataSizeBytes))
+        {
+          Infra::Message::Output(
+              Infra::Message::ESeverity::Warning,
+              L"CPU budget governor is inactive because the nominal processor frequency could not be determined.");
+          return 0;
+        }
+
+        return ((uint64_t)processorFrequencyMhz * 1000);
+      }();
+
+      return nominalCyclesPerMillisecond;
+    }
+
+    /// Retrieves the configured CPU budget. Read from the configuration data on every sampling
+    /// pass so that configuration hot reloads take effect without a restart.
+    /// @return Configured CPU budget as a percentage of one processor core, with 0 meaning
+    /// unlimited.
+    static unsigned int ConfiguredBudgetPercentOfCore(void)
+    {
+      return (unsigned int)Globals::GetConfigurationData()[Globals::ApplicableConfigurationSection(
+          Strings::kStrConfigurationSectionWorkerThreads)]
+                               [Strings::kStrConfigurationSettingWorkerThreadsCpuBudgetPercent]
+                                   .ValueOr(0);
+    }
+
+    /// Executes one governor sampling pass: aggregates cycle consumption across all registered
+    /// worker threads, converts the delta since the previous pass into a utilization percentage,
+    /// and updates the period scale factor accordingly. Runs periodically on a background task
+    /// worker thread.
+    /// @return Always `true`, so the pass keeps recurring for the remainder of the process.
+    static bool GovernorSamplePass(void)
+    {
+      uint64_t aggregateCycleCount = 0;
+      {
+        std::scoped_lock lock(workerThreadRegistryGuard);
+        for (const HANDLE workerThreadHandle : WorkerThreadRegistry())
+        {
+          ULONG64 threadCycleCount = 0;
+          if (FALSE != QueryThreadCycleTime(workerThreadHandle, &threadCycleCount))
+            aggregateCycleCount += threadCycleCount;
+        }
+      }
+
+      // Only the governor pass itself touches these, and passes never overlap, so no
+      // synchronization is needed beyond the atomics published for external consumption.
+      static uint64_t previousAggregateCycleCount = 0;
+      static uint64_t previousSampleTimeMilliseconds = 0;
+
+      const uint64_t currentTimeMilliseconds = GetTickCount64();
+      const uint64_t elapsedMilliseconds =
+          (currentTimeMilliseconds - previousSampleTimeMilliseconds);
+      const uint64_t cycleCountDelta = (aggregateCycleCount - previousAggregateCycleCount);
+      const uint64_t nominalCyclesPerMillisecond = NominalCyclesPerMillisecond();
+
+      lastAggregateCycleCount.store(aggregateCycleCount, std::memory_order_relaxed);
+
+      // The very first pass has no previous sample to measure against, so it only records the
+      // baseline for the next pass.
+      if ((0 != previousSampleTimeMilliseconds) && (0 != elapsedMilliseconds) &&
+          (0 != nominalCyclesPerMillisecond))
+      {
+        const double utilizationPercentOfCore =
+            (((double)cycleCountDelta / (double)nominalCyclesPerMillisecond) * 100.0) /
+            (double)elapsedMilliseconds;
+        lastUtilizationPercentOfCore.store(utilizationPercentOfCore, std::memory_order_relaxed);
+
+        const unsigned int budgetPercentOfCore = ConfiguredBudgetPercentOfCore();
+        const unsigned int previousPeriodScaleFactor =
+            currentPeriodScaleFactor.load(std::memory_order_relaxed);
+        const unsigned int nextPeriodScaleFactor = ComputeNextPeriodScaleFactor(
+            previousPeriodScaleFactor, utilizationPercentOfCore, budgetPercentOfCore);
+
+        if (nextPeriodScaleFactor != previousPeriodScaleFactor)
+        {
+          currentPeriodScaleFactor.store(nextPeriodScaleFactor, std::memory_order_relaxed);
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Info,
+              L"CPU budget governor changed the worker thread period scale factor from %u to %u (utilization %.2lf%% of one core, budget %u%%).",
+              previousPeriodScaleFactor,
+              nextPeriodScaleFactor,
+              utilizationPercentOfCore,
+              budgetPercentOfCore);
+        }
+      }
+
+      previousAggregateCycleCount = aggregateCycleCount;
+      previousSampleTimeMilliseconds = currentTimeMilliseconds;
+
+      return true;
+    }
+
+    unsigned int ComputeNextPeriodScaleFactor(
+        unsigned int currentPeriodScaleFactor,
+        double utilizationPercentOfCore,
+        unsigned int budgetPercentOfCore)
+    {
+      if (0 == budgetPercentOfCore) return 1;
+
+      if (utilizationPercentOfCore > (double)budgetPercentOfCore)
+      {
+        const unsigned int doubledPeriodScaleFactor = (currentPeriodScaleFactor * 2);
+        return ((doubledPeriodScaleFactor > kMaxPeriodScaleFactor) ? kMaxPeriodScaleFactor
+                                                                   : doubledPeriodScaleFactor);
+      }
+
+      if (utilizationPercentOfCore < (0.75 * (double)budgetPercentOfCore))
+      {
+        const unsigned int halvedPeriodScaleFactor = (currentPeriodScaleFactor / 2);
+        return ((0 == halvedPeriodScaleFactor) ? 1 : halvedPeriodScaleFactor);
+      }
+
+      return currentPeriodScaleFactor;
+    }
+
+    unsigned int GetPeriodScaleFactor(void)
+    {
+      return currentPeriodScaleFactor.load(std::memory_order_relaxed);
+    }
+
+    void RegisterCurrentWorkerThread(void)
+    {
+      HANDLE workerThreadHandle = NULL;
+      if (FALSE ==
+          DuplicateHandle(
+              GetCurrentProcess(),
+              GetCurrentThread(),
+              GetCurrentProcess(),
+              &workerThreadHandle,
+              THREAD_QUERY_LIMITED_INFORMATION,
+              FALSE,
+              0))
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"CPU budget governor failed to register a worker thread (error code %u). Its CPU consumption will not be counted against the budget.",
+            GetLastError());
+        return;
+      }
+
+      bool isFirstRegisteredThread = false;
+      {
+        std::scoped_lock lock(workerThreadRegistryGuard);
+        WorkerThreadRegistry().push_back(workerThreadHandle);
+        isFirstRegisteredThread = (1 == WorkerThreadRegistry().size());
+      }
+
+      if (true == isFirstRegisteredThread)
+        Globals::SubmitPeriodicBackgroundTask(
+            GovernorSamplePass, kGovernorSamplePeriodMilliseconds);
+    }
+
+    /// Implements the Xidi API interface #Api::ICpuBudget.
+    class CpuBudgetProvider : public Api::ICpuBudget
+    {
+    public:
+
+      // ICpuBudget
+      SCpuBudgetStatus GetCpuBudgetStatus(void) const override
+      {
+        return {
+            .aggregateCycleCount = lastAggregateCycleCount.load(std::memory_order_relaxed),
+            .utilizationPercentOfCore =
+                lastUtilizationPercentOfCore.load(std::memory_order_relaxed),
+            .budgetPercentOfCore = ConfiguredBudgetPercentOfCore(),
+            .periodScaleFactor = currentPeriodScaleFactor.load(std::memory_order_relaxed)};
+      }
+    };
+
+    /// Singleton Xidi API implementation object.
+    static CpuBudgetProvider cpuBudgetProvider;
+  } // namespace CpuBudget
+} // namespace Xidi
@@ -12,8 +12,10 @@
 
 #include "DataFormat.h"
 
+#include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <vector>
@@ -23,6 +25,7 @@
 #include "ApiBitSet.h"
 #include "ApiDirectInput.h"
 #include "ControllerTypes.h"
+#include "Profiler.h"
 #include "Strings.h"
 
 // Handler for invalid or unselectable object data format specifications.
@@ -405,6 +408,116 @@ namespace Xidi
     return std::nullopt;
   }
 
+  /// Signature of a single object format specification within an application data format. The
+  /// identification GUID is stored by value so that the signature remains valid independently of
+  /// the application-owned memory behind the original specification.
+  struct SObjectFormatSignature
+  {
+    /// Identification GUID, if the object format specification supplied one.
+    std::optional<GUID> guid;
+
+    /// Offset of the object's data within the application data packet.
+    DWORD offset;
+
+    /// Object type filter.
+    DWORD type;
+
+    /// Object flags.
+    DWORD flags;
+  };
+
+  /// Single entry in the cache of previously-reconciled application data format specifications.
+  /// Applications overwhelmingly pass one of the stock DirectInput formats, typically
+  /// `c_dfDIJoystick` or `c_dfDIJoystick2`, and do so once per device they create, so after the
+  /// first full reconciliation pass the resulting specification can simply be copied for any
+  /// subsequent request whose format signature and virtual controller capabilities both match.
+  struct SReconciledFormatCacheEntry
+  {
+    /// Capabilities of the virtual controller for which the format was reconciled.
+    Controller::SCapabilities controllerCapabilities;
+
+    /// Flags from the application data format specification.
+    DWORD flags;
+
+    /// Data packet size from the application data format specification.
+    DWORD dataSize;
+
+    /// Signatures of all object format specifications, in application-supplied order.
+    std::vector<SObjectFormatSignature> objectFormatSignatures;
+
+    /// Reconciled data format specification produced by the full creation pass.
+    DataFormat::SDataFormatSpec dataFormatSpec;
+
+    /// Fully-constructed data format object shared among all devices whose creation requests
+    /// match this entry, including its compiled write plan and lookup tables. Populated lazily
+    /// by the first shared creation request, so entries recorded by the non-shared creation
+    /// path do not hold an object until one is actually wanted.
+    std::shared_ptr<const DataFormat> sharedDataFormat;
+  };
+
+  /// Retrieves the cache of previously-reconciled application data format specifications.
+  /// Growth is bounded by the number of distinct (format, capabilities) pairs the application
+  /// uses, which in practice is very small.
+  /// @return Mutable reference to the cache.
+  static std::vector<SReconciledFormatCacheEntry>& ReconciledFormatCache(void)
+  {
+    static std::vector<SReconciledFormatCacheEntry> reconciledFormatCache;
+    return reconciledFormatCache;
+  }
+
+  /// Retrieves the mutex that guards the cache of previously-reconciled application data format
+  /// specifications. Applications are allowed to set data formats from multiple threads.
+  /// @return Mutable reference to the mutex.
+  static std::mutex& ReconciledFormatCacheGuard(void)
+  {
+    static std::mutex reconciledFormatCacheGuard;
+    return reconciledFormatCacheGuard;
+  }
+
+  /// Checks if the supplied application data format specification and virtual controller
+  /// capabilities match the signature stored in the supplied cache entry.
+  /// @param [in] appFormatSpec Application-provided DirectInput data format specification.
+  /// @param [in] controllerCapabilities Capabilities of the virtual controller for which the data
+  /// format is being specified.
+  /// @param [in] cacheEntry Cache entry against which to compare.
+  /// @return `true` if the cache entry matches, `false` otherwise.
+  static bool ApplicationFormatSpecMatchesCacheEntry(
+      const DIDATAFORMAT& appFormatSpec,
+      const Controller::SCapabilities controllerCapabilities,
+      const SReconciledFormatCacheEntry& cacheEntry)
+  {
+    if (false == (controllerCapabilities == cacheEntry.controllerCapabilities)) return false;
+
+    if ((appFormatSpec.dwFlags != cacheEntry.flags) ||
+        (appFormatSpec.dwDataSize != cacheEntry.dataSize) ||
+        ((size_t)appFormatSpec.dwNumObjs != cacheEntry.objectFormatSignatures.size()))
+      return false;
+
+    for (DWORD i = 0; i < appFormatSpec.dwNumObjs; ++i)
+    {
+      const DIOBJECTDATAFORMAT& objectFormatSpec = appFormatSpec.rgodf[i];
+      const SObjectFormatSignature& objectFormatSignature = cacheEntry.objectFormatSignatures[i];
+
+      if ((objectFormatSpec.dwOfs != objectFormatSignature.offset) ||
+          (objectFormatSpec.dwType != objectFormatSignature.type) ||
+          (objectFormatSpec.dwFlags != objectFormatSignature.flags))
+        return false;
+
+      if (nullptr == objectFormatSpec.pguid)
+      {
+        if (true == objectFormatSignature.guid.has_value()) return false;
+      }
+      else
+      {
+        if ((false == objectFormatSignature.guid.has_value()) ||
+            (false == (*objectFormatSpec.pguid == objectFormatSignature.guid.value())))
+          return false;
+      }
+    }
+
+    return true;
+  }
+
   std::unique_ptr<DataFormat> DataFormat::CreateFromApplicationFormatSpec(
       const DIDATAFORMAT& appFormatSpec, const Controller::SCapabilities controllerCapabilities)
   {
@@ -462,6 +575,29 @@ namespace Xidi
         return nullptr;
     }
 
+    // Recognized-format fast path. Stock DirectInput formats like `c_dfDIJoystick` and
+    // `c_dfDIJoystick2` are passed by virtually every application, so a format whose signature was
+    // already reconciled for the same virtual controller capabilities is satisfied by copying the
+    // cached specification instead of repeating the generic reconciliation pass below.
+    {
+      std::unique_lock lock(ReconciledFormatCacheGuard());
+
+      for (const auto& cacheEntry : ReconciledFormatCache())
+      {
+        if (true ==
+            ApplicationFormatSpecMatchesCacheEntry(appFormatSpec, controllerCapabilities, cacheEntry))
+        {
+          Infra::Message::Output(
+              Infra::Message::ESeverity::Info,
+              L"Application data format matches a previously-accepted format. Reusing the existing reconciled specification.");
+
+          SDataFormatSpec cachedDataFormatSpec = cacheEntry.dataFormatSpec;
+          return std::unique_ptr<DataFormat>(
+              new DataFormat(controllerCapabilities, std::move(cachedDataFormatSpec)));
+        }
+      }
+    }
+
     DataFormatBuildHelper buildHelper(controllerCapabilities, appFormatSpec.dwDataSize);
     SDataFormatSpec dataFormatSpec(appFormatSpec.dwDataSize);
     int numElementsSelected = 0;
@@ -659,32 +795,153 @@ namespace Xidi
         L"Accepted and successfully set application data format. Total data packet size is %u byte(s), and %d virtual controller element(s) were selected.",
         appFormatSpec.dwDataSize,
         numElementsSelected);
+
+    // Record the accepted format so that subsequent requests with the same signature and
+    // capabilities can take the recognized-format fast path.
+    {
+      std::vector<SObjectFormatSignature> objectFormatSignatures;
+      objectFormatSignatures.reserve(appFormatSpec.dwNumObjs);
+
+      for (DWORD i = 0; i < appFormatSpec.dwNumObjs; ++i)
+      {
+        const DIOBJECTDATAFORMAT& objectFormatSpec = appFormatSpec.rgodf[i];
+
+        SObjectFormatSignature objectFormatSignature = {
+            .offset = objectFormatSpec.dwOfs,
+            .type = objectFormatSpec.dwType,
+            .flags = objectFormatSpec.dwFlags};
+        if (nullptr != objectFormatSpec.pguid) objectFormatSignature.guid = *objectFormatSpec.pguid;
+
+        objectFormatSignatures.push_back(std::move(objectFormatSignature));
+      }
+
+      std::unique_lock lock(ReconciledFormatCacheGuard());
+      ReconciledFormatCache().push_back(
+          {.controllerCapabilities = controllerCapabilities,
+           .flags = appFormatSpec.dwFlags,
+           .dataSize = appFormatSpec.dwDataSize,
+           .objectFormatSignatures = std::move(objectFormatSignatures),
+           .dataFormatSpec = dataFormatSpec});
+    }
+
     return std::unique_ptr<DataFormat>(
         new DataFormat(controllerCapabilities, std::move(dataFormatSpec)));
   }
 
-  EPovValue DataFormat::DirectInputPovValue(Controller::UPovDirection pov)
+  std::shared_ptr<const DataFormat> DataFormat::CreateSharedFromApplicationFormatSpec(
+      const DIDATAFORMAT& appFormatSpec, const Controller::SCapabilities controllerCapabilities)
+  {
+    // Fast path: a previous request with a matching format signature and matching capabilities
+    // either already holds a shared object or holds a reconciled specification from which one
+    // can be built without repeating reconciliation.
+    if ((appFormatSpec.dwNumObjs >= 1) && (nullptr != appFormatSpec.rgodf))
+    {
+      std::unique_lock lock(ReconciledFormatCacheGuard());
+
+      for (auto& cacheEntry : ReconciledFormatCache())
+      {
+        if (true ==
+            ApplicationFormatSpecMatchesCacheEntry(appFormatSpec, controllerCapabilities, cacheEntry))
+        {
+          if (nullptr == cacheEntry.sharedDataFormat)
+          {
+            SDataFormatSpec cachedDataFormatSpec = cacheEntry.dataFormatSpec;
+            cacheEntry.sharedDataFormat = std::shared_ptr<const DataFormat>(
+                new DataFormat(controllerCapabilities, std::move(cachedDataFormatSpec)));
+          }
+
+          return cacheEntry.sharedDataFormat;
+        }
+      }
+    }
+
+    // Slow path: run the full creation pass, which on success records a reconciled cache entry
+    // for the request, then publish the new object into that entry so subsequent requests share
+    // it. The entry can be missing if another thread raced in a conflicting cache insertion, in
+    // which case the new object is simply returned unshared, which is correct because data
+    // format objects are immutable.
+    std::shared_ptr<const DataFormat> newDataFormat =
+        CreateFromApplicationFormatSpec(appFormatSpec, controllerCapabilities);
+
+    if (nullptr != newDataFormat)
+    {
+      std::unique_lock lock(ReconciledFormatCacheGuard());
+
+      for (auto& cacheEntry : ReconciledFormatCache())
+      {
+        if (true ==
+            ApplicationFormatSpecMatchesCacheEntry(appFormatSpec, controllerCapabilities, cacheEntry))
+        {
+          if (nullptr == cacheEntry.sharedDataFormat) cacheEntry.sharedDataFormat = newDataFormat;
+          return cacheEntry.sharedDataFormat;
+        }
+      }
+    }
+
+    return newDataFormat;
+  }
+
+  /// Builds a lookup table holding the final DirectInput POV encoding for every possible packed
+  /// POV direction state, so that translation at state write time is a single table load with no
+  /// conditional chain. Entries are derived from compass coordinates, so opposite directions
+  /// cancel and a fully-centered or contradictory state encodes as centered.
+  /// @return POV encoding table, indexed by packed POV direction state.
+  static consteval std::array<EPovValue, (1u << (unsigned int)Controller::EPovDirection::Count)>
+      ComputePovEncodingTable(void)
   {
-    static constexpr EPovValue kPovDirectionValues[3][3] = {
+    constexpr EPovValue kPovDirectionValues[3][3] = {
         {EPovValue::NW, EPovValue::N, EPovValue::NE},
         {EPovValue::W, EPovValue::Center, EPovValue::E},
         {EPovValue::SW, EPovValue::S, EPovValue::SE}};
 
-    const int xCoord = ((true == pov.components[(int)Controller::EPovDirection::Right]) ? 1 : 0) -
-        ((true == pov.components[(int)Controller::EPovDirection::Left]) ? 1 : 0);
-    const int yCoord = ((true == pov.components[(int)Controller::EPovDirection::Down]) ? 1 : 0) -
-        ((true == pov.components[(int)Controller::EPovDirection::Up]) ? 1 : 0);
+    std::array<EPovValue, (1u << (unsigned int)Controller::EPovDirection::Count)> encodingTable =
+        {};
+
+    for (unsigned int packedPovState = 0; packedPovState < encodingTable.size(); ++packedPovState)
+    {
+      const bool up = (0 != (packedPovState & (1u << (unsigned int)Controller::EPovDirection::Up)));
+      const bool down =
+          (0 != (packedPovState & (1u << (unsigned int)Controller::EPovDirection::Down)));
+      const bool left =
+          (0 != (packedPovState & (1u << (unsigned int)Controller::EPovDirection::Left)));
+      const bool right =
+          (0 != (packedPovState & (1u << (unsigned int)Controller::EPovDirection::Right)));
+
+      const int xCoord = (right ? 1 : 0) - (left ? 1 : 0);
+      const int yCoord = (down ? 1 : 0) - (up ? 1 : 0);
+
+      encodingTable[packedPovState] = kPovDirectionValues[1 + yCoord][1 + xCoord];
+    }
 
-    return kPovDirectionValues[1 + yCoord][1 + xCoord];
+    return encodingTable;
+  }
+
+  EPovValue DataFormat::DirectInputPovValue(Controller::UPovDirection pov)
+  {
+    static constexpr std::array<EPovValue, (1u << (unsigned int)Controller::EPovDirection::Count)>
+        kPovEncodingTable = ComputePovEncodingTable();
+
+    return kPovEncodingTable[Controller::PovDirectionIndex(pov)];
+  }
+
+  std::vector<std::optional<Controller::SElementIdentifier>> DataFormat::ComputeOffsetElementTable(
+      const SDataFormatSpec& dataFormatSpec)
+  {
+    std::vector<std::optional<Controller::SElementIdentifier>> offsetElementTable(
+        dataFormatSpec.packetSizeBytes);
+
+    for (const auto& offsetElementRecord : dataFormatSpec.offsetElementMap)
+      offsetElementTable[offsetElementRecord.first] = offsetElementRecord.second;
+
+    return offsetElementTable;
   }
 
   std::optional<Controller::SElementIdentifier> DataFormat::GetElementForOffset(
       TOffset offset) const
   {
-    const auto elementRecord = dataFormatSpec.offsetElementMap.find(offset);
-    if (elementRecord != dataFormatSpec.offsetElementMap.cend()) return elementRecord->second;
+    if (offset >= offsetElementTable.size()) return std::nullopt;
 
-    return std::nullopt;
+    return offsetElementTable[offset];
   }
 
   std::optional<TOffset> DataFormat::GetOffsetForElement(
@@ -710,53 +967,153 @@ namespace Xidi
     return std::nullopt;
   }
 
-  bool DataFormat::WriteDataPacket(
-      void* packetBuffer,
-      TOffset packetBufferSizeBytes,
-      const Controller::SState& controllerState) const
+  std::vector<uint8_t> DataFormat::ComputeDataPacketTemplate(const SDataFormatSpec& dataFormatSpec)
   {
-    // Sanity check: did the application allocate sufficient buffer space?
-    if (packetBufferSizeBytes < dataFormatSpec.packetSizeBytes) return false;
-
-    uint8_t* const packetByteBuffer = (uint8_t*)packetBuffer;
+    // Everything not explicitly written will be 0, except for unused POVs which must be
+    // initialized to center position. The template covers only the effective write span of the
+    // data format; all bytes beyond the span are zero and are filled separately whenever a data
+    // packet is written.
+    std::vector<uint8_t> dataPacketTemplate(dataFormatSpec.EffectiveWriteSpanBytes());
 
-    // Initialize the application data packet.
-    // Everything not explicitly written will be 0, except for unused POVs which must be initialized
-    // to center position.
-    ZeroMemory(packetBuffer, packetBufferSizeBytes);
     for (auto povOffsetUnused : dataFormatSpec.povOffsetsUnused)
     {
-      EPovValue* const valueLocation = (EPovValue*)(&packetByteBuffer[povOffsetUnused]);
+      EPovValue* const valueLocation = (EPovValue*)(&dataPacketTemplate[povOffsetUnused]);
       *valueLocation = EPovValue::Center;
     }
 
-    // Axis values
+    return dataPacketTemplate;
+  }
+
+  std::vector<DataFormat::SDataPacketWriteStep> DataFormat::ComputeDataPacketWriteSteps(
+      const SDataFormatSpec& dataFormatSpec)
+  {
+    std::vector<SDataPacketWriteStep> dataPacketWriteSteps;
+
     for (int i = 0; i < _countof(dataFormatSpec.axisOffset); ++i)
     {
       if (kInvalidOffsetValue != dataFormatSpec.axisOffset[i])
-      {
-        TAxisValue* const valueLocation =
-            (TAxisValue*)(&packetByteBuffer[dataFormatSpec.axisOffset[i]]);
-        *valueLocation = DirectInputAxisValue(controllerState.axis[i]);
-      }
+        dataPacketWriteSteps.push_back(
+            {.offsetInPacket = dataFormatSpec.axisOffset[i],
+             .element = {
+                 .type = Controller::EElementType::Axis, .axis = (Controller::EAxis)i}});
     }
 
-    // Button values
     for (int i = 0; i < _countof(dataFormatSpec.buttonOffset); ++i)
     {
       if (kInvalidOffsetValue != dataFormatSpec.buttonOffset[i])
+        dataPacketWriteSteps.push_back(
+            {.offsetInPacket = dataFormatSpec.buttonOffset[i],
+             .element = {
+                 .type = Controller::EElementType::Button, .button = (Controller::EButton)i}});
+    }
+
+    if (kInvalidOffsetValue != dataFormatSpec.povOffset)
+      dataPacketWriteSteps.push_back(
+          {.offsetInPacket = dataFormatSpec.povOffset,
+           .element = {.type = Controller::EElementType::Pov}});
+
+    return dataPacketWriteSteps;
+  }
+
+  bool DataFormat::TranslateStateChangeEvents(
+      std::span<const Controller::StateChangeEventBuffer::SEvent> events,
+      LPDIDEVICEOBJECTDATA objectDataArray) const
+  {
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+      const Controller::StateChangeEventBuffer::SEvent& event = events[i];
+
+      TOffset offset = kInvalidOffsetValue;
+      DWORD data = 0;
+
+      switch (event.data.element.type)
       {
-        TButtonValue* const valueLocation =
-            (TButtonValue*)(&packetByteBuffer[dataFormatSpec.buttonOffset[i]]);
-        *valueLocation = DirectInputButtonValue(controllerState.button[i]);
+        case Controller::EElementType::Axis:
+          offset = dataFormatSpec.axisOffset[(int)event.data.element.axis];
+          data = (DWORD)DirectInputAxisValue(event.data.value.axis);
+          break;
+
+        case Controller::EElementType::Button:
+          offset = dataFormatSpec.buttonOffset[(int)event.data.element.button];
+          data = (DWORD)DirectInputButtonValue(event.data.value.button);
+          break;
+
+        case Controller::EElementType::Pov:
+          offset = dataFormatSpec.povOffset;
+          data = (DWORD)DirectInputPovValue(event.data.value.povDirection);
+          break;
       }
+
+      if (kInvalidOffsetValue == offset) return false;
+
+      // Aggregate initialization zeroes all fields not explicitly filled, such as the application
+      // data cookie present in newer versions of the structure.
+      objectDataArray[i] = {
+          .dwOfs = offset,
+          .dwData = data,
+          .dwTimeStamp = event.timestamp,
+          .dwSequence = event.sequence};
     }
 
-    // POV value
-    if (kInvalidOffsetValue != dataFormatSpec.povOffset)
+    return true;
+  }
+
+  bool DataFormat::WriteDataPacket(
+      void* packetBuffer,
+      TOffset packetBufferSizeBytes,
+      const Controller::SState& controllerState) const
+  {
+    const Profiler::ScopedSample profileSample(Profiler::EProfileSite::DataPacketWrite);
+
+    // Sanity check: did the application allocate sufficient buffer space?
+    if (packetBufferSizeBytes < dataFormatSpec.packetSizeBytes) return false;
+
+    uint8_t* const packetByteBuffer = (uint8_t*)packetBuffer;
+
+    // Initialize the application data packet from the precomputed template, which holds zeroes
+    // everywhere except unused POV slots and covers the effective write span of the data format.
+    // Bytes beyond the span never hold controller data, but applications expect zeroes across the
+    // whole declared packet (a stale byte in an unmapped button slot would read as a pressed
+    // button), so the remainder of the buffer, including any extra space beyond the declared
+    // packet, is zero-filled rather than copied from a full-size template.
+    CopyMemory(packetBuffer, dataPacketTemplate.data(), dataPacketTemplate.size());
+    if (packetBufferSizeBytes > dataPacketTemplate.size())
+      ZeroMemory(
+          &packetByteBuffer[dataPacketTemplate.size()],
+          (packetBufferSizeBytes - dataPacketTemplate.size()));
+
+    // Execute the compiled write plan, one value write per controller element present in the
+    // application's data format.
+    for (const auto& dataPacketWriteStep : dataPacketWriteSteps)
     {
-      EPovValue* const valueLocation = (EPovValue*)(&packetByteBuffer[dataFormatSpec.povOffset]);
-      *valueLocation = DirectInputPovValue(controllerState.povDirection);
+      switch (dataPacketWriteStep.element.type)
+      {
+        case Controller::EElementType::Axis:
+        {
+          TAxisValue* const valueLocation =
+              (TAxisValue*)(&packetByteBuffer[dataPacketWriteStep.offsetInPacket]);
+          *valueLocation =
+              DirectInputAxisValue(controllerState.axis[(int)dataPacketWriteStep.element.axis]);
+          break;
+        }
+
+        case Controller::EElementType::Button:
+        {
+          TButtonValue* const valueLocation =
+              (TButtonValue*)(&packetByteBuffer[dataPacketWriteStep.offsetInPacket]);
+          *valueLocation = DirectInputButtonValue(
+              controllerState.button[(int)dataPacketWriteStep.element.button]);
+          break;
+        }
+
+        case Controller::EElementType::Pov:
+        {
+          EPovValue* const valueLocation =
+              (EPovValue*)(&packetByteBuffer[dataPacketWriteStep.offsetInPacket]);
+          *valueLocation = DirectInputPovValue(controllerState.povDirection);
+          break;
+        }
+      }
     }
 
     return true;
@@ -0,0 +1,448 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file DevicePropertyCache.cpp
+ *   Implementation of functionality for persisting the device properties that an application
+ *   applies to its virtual controllers and pre-applying them on subsequent launches.
+ **************************************************************************************************/
+
+#include "DevicePropertyCache.h"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <Infra/Core/Message.h>
+#include <Infra/Core/ProcessInfo.h>
+#include <Infra/Core/TemporaryBuffer.h>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "Globals.h"
+#include "Strings.h"
+#include "VirtualController.h"
+
+namespace Xidi
+{
+  namespace Controller
+  {
+    namespace DevicePropertyCache
+    {
+      /// Enumerates the device properties that can be held in the device property cache.
+      /// Enumerator values are persisted in cache files and therefore must not be renumbered.
+      enum class ECachedProperty : int32_t
+      {
+        /// Axis deadzone, set using `DIPROP_DEADZONE`.
+        AxisDeadzone,
+
+        /// Axis range, set using `DIPROP_RANGE`.
+        AxisRange,
+
+        /// Axis saturation, set using `DIPROP_SATURATION`.
+        AxisSaturation,
+
+        /// Event buffer capacity, set using `DIPROP_BUFFERSIZE`.
+        EventBufferCapacity,
+
+        /// Force feedback gain, set using `DIPROP_FFGAIN`.
+        ForceFeedbackGain,
+
+        /// Sentinel value, total number of enumerators.
+        Count
+      };
+
+      /// Record of a single applied device property, exactly as stored in a cache file.
+      struct SPropertyRecord
+      {
+        /// Identifier of the affected virtual controller.
+        uint32_t controllerIdentifier;
+
+        /// Property that was applied.
+        ECachedProperty property;
+
+        /// Affected axis, or #kAxisAll if the property applies to all axes or is not an axis
+        /// property.
+        int32_t axis;
+
+        /// First property value. Holds the only value for single-valued properties and the range
+        /// minimum for the axis range property.
+        int32_t value1;
+
+        /// Second property value. Holds the range maximum for the axis range property and is
+        /// unused otherwise.
+        int32_t value2;
+      };
+
+      /// Header at the beginning of every device property cache file.
+      struct SCacheFileHeader
+      {
+        /// Magic value identifying a device property cache file.
+        uint32_t magic;
+
+        /// Number of property records that follow the header.
+        uint32_t recordCount;
+      };
+
+      /// Magic value identifying a device property cache file.
+      static constexpr uint32_t kCacheFileMagic = 0x31435058;
+
+      /// Axis field value indicating that a property applies to all axes or is not an axis
+      /// property.
+      static constexpr int32_t kAxisAll = -1;
+
+      /// Maximum number of property records accepted from a cache file. Real applications apply
+      /// at most a few properties per axis per controller, so anything larger indicates a
+      /// damaged file.
+      static constexpr uint32_t kMaxRecordCount = 256;
+
+      /// Enforces proper concurrency control over the in-memory property records.
+      static std::mutex propertyRecordsMutex;
+
+      /// In-memory property records, in application order. Mirrored to the cache file whenever a
+      /// record is added or updated.
+      static std::vector<SPropertyRecord> propertyRecords;
+
+      /// Determines if the device property cache is enabled in the configuration file.
+      /// This is an opt-in feature, so the default is disabled.
+      /// @return `true` if so, `false` if not.
+      static bool IsCacheEnabled(void)
+      {
+        static const bool isCacheEnabled =
+            Globals::GetConfigurationData()
+                [Globals::ApplicableConfigurationSection(
+                    Strings::kStrConfigurationSectionProperties)]
+                [Strings::kStrConfigurationSettingsPropertiesUseDevicePropertyCache]
+                    .ValueOr(false);
+        return isCacheEnabled;
+      }
+
+      /// Generates and returns the path of the device property cache file for the current
+      /// executable. The file is placed in the same directory as Xidi log files and is keyed by
+      /// executable base name, so every launch of the same application shares one cache.
+      /// @return Path of the device property cache file.
+      static std::wstring_view GetCacheFilePath(void)
+      {
+        static std::wstring cacheFilePath;
+        static std::once_flag initFlag;
+
+        std::call_once(
+            initFlag,
+            []() -> void
+            {
+              Infra::TemporaryString cacheFilename;
+
+              PWSTR knownFolderPath;
+              const HRESULT result =
+                  SHGetKnownFolderPath(FOLDERID_Desktop, 0, nullptr, &knownFolderPath);
+
+              if (S_OK == result)
+              {
+                cacheFilename << knownFolderPath << L'\\';
+                CoTaskMemFree(knownFolderPath);
+              }
+
+              cacheFilename << Infra::ProcessInfo::GetProductName() << L"_PropertyCache_"
+                            << Infra::ProcessInfo::GetExecutableBaseName() << L".dat";
+
+              cacheFilePath.assign(cacheFilename);
+            });
+
+        return cacheFilePath;
+      }
+
+      /// Checks that the specified property record is well-formed, meaning that its fields all
+      /// hold values in their valid ranges. Used to reject records from damaged cache files.
+      /// @param [in] propertyRecord Property record to check.
+      /// @return `true` if the record is well-formed, `false` otherwise.
+      static bool IsValidPropertyRecord(const SPropertyRecord& propertyRecord)
+      {
+        if (propertyRecord.controllerIdentifier >= kPhysicalControllerCount) return false;
+
+        if (((int32_t)propertyRecord.property < 0) ||
+            ((int32_t)propertyRecord.property >= (int32_t)ECachedProperty::Count))
+          return false;
+
+        if ((kAxisAll != propertyRecord.axis) &&
+            ((propertyRecord.axis < 0) || (propertyRecord.axis >= (int32_t)EAxis::Count)))
+          return false;
+
+        return true;
+      }
+
+      /// Loads property records from the cache file, if it exists and is well-formed. Must be
+      /// invoked with the property records mutex held. A missing file is the normal first-launch
+      /// case and produces an empty record set, as does a file that fails validation.
+      static void LoadFromCacheFileInternal(void)
+      {
+        const HANDLE cacheFile = CreateFileW(
+            GetCacheFilePath().data(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL);
+        if (INVALID_HANDLE_VALUE == cacheFile) return;
+
+        SCacheFileHeader cacheFileHeader = {};
+        DWORD numBytesRead = 0;
+
+        if ((FALSE ==
+             ReadFile(
+                 cacheFile, &cacheFileHeader, sizeof(cacheFileHeader), &numBytesRead, nullptr)) ||
+            (sizeof(cacheFileHeader) != numBytesRead) ||
+            (kCacheFileMagic != cacheFileHeader.magic) ||
+            (cacheFileHeader.recordCount > kMaxRecordCount))
+        {
+          CloseHandle(cacheFile);
+          return;
+        }
+
+        std::vector<SPropertyRecord> loadedRecords(cacheFileHeader.recordCount);
+        const DWORD numRecordBytesExpected =
+            (DWORD)(cacheFileHeader.recordCount * sizeof(SPropertyRecord));
+
+        if ((FALSE ==
+             ReadFile(
+                 cacheFile, loadedRecords.data(), numRecordBytesExpected, &numBytesRead, nullptr)) ||
+            (numRecordBytesExpected != numBytesRead))
+        {
+          CloseHandle(cacheFile);
+          return;
+        }
+
+        CloseHandle(cacheFile);
+
+        for (const SPropertyRecord& loadedRecord : loadedRecords)
+          if (false == IsValidPropertyRecord(loadedRecord)) return;
+
+        propertyRecords = std::move(loadedRecords);
+
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Loaded %u device property record(s) from the device property cache.",
+            cacheFileHeader.recordCount);
+      }
+
+      /// Ensures that property records have been loaded from the cache file, performing the load
+      /// on first invocation. Must be invoked with the property records mutex held.
+      static void EnsureLoadedFromCacheFile(void)
+      {
+        static bool isLoaded = false;
+
+        if (false == isLoaded)
+        {
+          isLoaded = true;
+          LoadFromCacheFileInternal();
+        }
+      }
+
+      /// Rewrites the cache file from the in-memory property records. Must be invoked with the
+      /// property records mutex held. Write failures are logged and otherwise ignored, because
+      /// the cache is purely an optimization.
+      static void PersistToCacheFileInternal(void)
+      {
+        const HANDLE cacheFile = CreateFileW(
+            GetCacheFilePath().data(),
+            GENERIC_WRITE,
+            0,
+            nullptr,
+            CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL);
+        if (INVALID_HANDLE_VALUE == cacheFile)
+        {
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Warning,
+              L"Failed to write the device property cache file (error code %u).",
+              GetLastError());
+          return;
+        }
+
+        const SCacheFileHeader cacheFileHeader = {
+            .magic = kCacheFileMagic, .recordCount = (uint32_t)propertyRecords.size()};
+        DWORD numBytesWritten = 0;
+
+        WriteFile(cacheFile, &cacheFileHeader, sizeof(cacheFileHeader), &numBytesWritten, nullptr);
+        WriteFile(
+            cacheFile,
+            propertyRecords.data(),
+            (DWORD)(propertyRecords.size() * sizeof(SPropertyRecord)),
+            &numBytesWritten,
+            nullptr);
+
+        CloseHandle(cacheFile);
+      }
+
+      /// Adds or updates a property record in the device property cache and mirrors the change
+      /// to the cache file. Records are keyed by controller, property, and axis, so re-applying a
+      /// property replaces its previous record. Re-applying a property with values identical to
+      /// those already cached, which is what happens when an application repeats its usual
+      /// property-setting sequence on a controller that was pre-applied from the cache, costs
+      /// only the lookup and performs no file write.
+      /// @param [in] newPropertyRecord Property record to add or update.
+      static void SubmitPropertyRecord(const SPropertyRecord& newPropertyRecord)
+      {
+        if (false == IsCacheEnabled()) return;
+
+        std::unique_lock lock(propertyRecordsMutex);
+        EnsureLoadedFromCacheFile();
+
+        for (SPropertyRecord& existingRecord : propertyRecords)
+        {
+          if ((existingRecord.controllerIdentifier == newPropertyRecord.controllerIdentifier) &&
+              (existingRecord.property == newPropertyRecord.property) &&
+              (existingRecord.axis == newPropertyRecord.axis))
+          {
+            if ((existingRecord.value1 == newPropertyRecord.value1) &&
+                (existingRecord.value2 == newPropertyRecord.value2))
+              return;
+
+            existingRecord = newPropertyRecord;
+            PersistToCacheFileInternal();
+            return;
+          }
+        }
+
+        if (propertyRecords.size() >= kMaxRecordCount) return;
+
+        propertyRecords.push_back(newPropertyRecord);
+        PersistToCacheFileInternal();
+      }
+
+      void ApplyToController(VirtualController& controller)
+      {
+        if (false == IsCacheEnabled()) return;
+
+        // Records are copied out under the lock and applied outside of it. Applying a record
+        // goes through the same virtual controller setters that record cache updates, and those
+        // updates find identical values already cached and return without re-entering the lock
+        // for a file write.
+        std::vector<SPropertyRecord> recordsToApply;
+
+        do
+        {
+          std::unique_lock lock(propertyRecordsMutex);
+          EnsureLoadedFromCacheFile();
+
+          for (const SPropertyRecord& propertyRecord : propertyRecords)
+            if (propertyRecord.controllerIdentifier == controller.GetIdentifier())
+              recordsToApply.push_back(propertyRecord);
+        }
+        while (false);
+
+        for (const SPropertyRecord& propertyRecord : recordsToApply)
+        {
+          switch (propertyRecord.property)
+          {
+            case ECachedProperty::AxisDeadzone:
+              if (kAxisAll == propertyRecord.axis)
+                controller.SetAllAxisDeadzone((uint32_t)propertyRecord.value1);
+              else
+                controller.SetAxisDeadzone(
+                    (EAxis)propertyRecord.axis, (uint32_t)propertyRecord.value1);
+              break;
+
+            case ECachedProperty::AxisRange:
+              if (kAxisAll == propertyRecord.axis)
+                controller.SetAllAxisRange(propertyRecord.value1, propertyRecord.value2);
+              else
+                controller.SetAxisRange(
+                    (EAxis)propertyRecord.axis, propertyRecord.value1, propertyRecord.value2);
+              break;
+
+            case ECachedProperty::AxisSaturation:
+              if (kAxisAll == propertyRecord.axis)
+                controller.SetAllAxisSaturation((uint32_t)propertyRecord.value1);
+              else
+                controller.SetAxisSaturation(
+                    (EAxis)propertyRecord.axis, (uint32_t)propertyRecord.value1);
+              break;
+
+            case ECachedProperty::EventBufferCapacity:
+              controller.SetEventBufferCapacity((uint32_t)propertyRecord.value1);
+              break;
+
+            case ECachedProperty::ForceFeedbackGain:
+              controller.SetForceFeedbackGain((uint32_t)propertyRecord.value1);
+              break;
+
+            default:
+              break;
+          }
+        }
+
+        if (false == recordsToApply.empty())
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Info,
+              L"Pre-applied %u cached device property record(s) to virtual controller %u.",
+              (unsigned int)recordsToApply.size(),
+              (unsigned int)(1 + controller.GetIdentifier()));
+      }
+
+      void RecordAxisDeadzone(
+          TControllerIdentifier controllerIdentifier, std::optional<EAxis> axis, uint32_t deadzone)
+      {
+        SubmitPropertyRecord(
+            {.controllerIdentifier = controllerIdentifier,
+             .property = ECachedProperty::AxisDeadzone,
+             .axis = ((true == axis.has_value()) ? (int32_t)axis.value() : kAxisAll),
+             .value1 = (int32_t)deadzone,
+             .value2 = 0});
+      }
+
+      void RecordAxisRange(
+          TControllerIdentifier controllerIdentifier,
+          std::optional<EAxis> axis,
+          int32_t rangeMin,
+          int32_t rangeMax)
+      {
+        SubmitPropertyRecord(
+            {.controllerIdentifier = controllerIdentifier,
+             .property = ECachedProperty::AxisRange,
+             .axis = ((true == axis.has_value()) ? (int32_t)axis.value() : kAxisAll),
+             .value1 = rangeMin,
+             .value2 = rangeMax});
+      }
+
+      void RecordAxisSaturation(
+          TControllerIdentifier controllerIdentifier,
+          std::optional<EAxis> axis,
+          uint32_t saturation)
+      {
+        SubmitPropertyRecord(
+            {.controllerIdentifier = controllerIdentifier,
+             .property = ECachedProperty::AxisSaturation,
+             .axis = ((true == axis.has_value()) ? (int32_t)axis.value() : kAxisAll),
+             .value1 = (int32_t)saturation,
+             .value2 = 0});
+      }
+
+      void RecordEventBufferCapacity(TControllerIdentifier controllerIdentifier, uint32_t capacity)
+      {
+        SubmitPropertyRecord(
+            {.controllerIdentifier = controllerIdentifier,
+             .property = ECachedProperty::EventBufferCapacity,
+             .axis = kAxisAll,
+             .value1 = (int32_t)capacity,
+             .value2 = 0});
+      }
+
+      void RecordForceFeedbackGain(TControllerIdentifier controllerIdentifier, uint32_t ffGain)
+      {
+        SubmitPropertyRecord(
+            {.controllerIdentifier = controllerIdentifier,
+             .property = ECachedProperty::ForceFeedbackGain,
+             .axis = kAxisAll,
+             .value1 = (int32_t)ffGain,
+             .value2 = 0});
+      }
+    } // namespace DevicePropertyCache
+  } // namespace Controller
+} // namespace Xidi
@@ -0,0 +1,167 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file Diagnostics.cpp
+ *   Implementation of runtime health tracking for the input stack.
+ **************************************************************************************************/
+
+#include "Diagnostics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "ApiWindows.h"
+#include "ApiXidi.h"
+#include "ControllerTypes.h"
+#include "Mapper.h"
+
+namespace Xidi
+{
+  namespace Diagnostics
+  {
+    /// Number of loop iterations completed per tracked worker thread.
+    static std::atomic<uint64_t> threadIterationCount[(unsigned int)EWorkerThread::Count];
+
+    /// Tick count of the most recent loop iteration per tracked worker thread, or 0 for a thread
+    /// that has never run.
+    static std::atomic<uint64_t> threadLastActivityTime[(unsigned int)EWorkerThread::Count];
+
+    /// Bit mask of physical controller slots currently reporting a connected device.
+    static std::atomic<uint32_t> connectedControllerMask;
+
+    /// Import resolution status per tracked import module.
+    static std::atomic<Api::IDiagnostics::EImportStatus>
+        importStatus[(unsigned int)EImportModule::Count];
+
+    /// System error code of the most recent unexpected input stack failure, or 0 if none has
+    /// occurred.
+    static std::atomic<uint32_t> lastErrorCode;
+
+    /// Tick count at which the most recent unexpected input stack failure occurred, or 0 if none
+    /// has occurred.
+    static std::atomic<uint64_t> lastErrorTime;
+
+    void RecordThreadHeartbeat(EWorkerThread workerThread)
+    {
+      const unsigned int threadIndex = (unsigned int)workerThread;
+      if (threadIndex >= (unsigned int)EWorkerThread::Count) return;
+
+      threadIterationCount[threadIndex].fetch_add(1, std::memory_order_relaxed);
+      threadLastActivityTime[threadIndex].store(GetTickCount64(), std::memory_order_relaxed);
+    }
+
+    void RecordControllerConnected(
+        Controller::TControllerIdentifier controllerIdentifier, bool isConnected)
+    {
+      if (controllerIdentifier >= Controller::kPhysicalControllerCount) return;
+
+      if (true == isConnected)
+        connectedControllerMask.fetch_or(
+            (uint32_t)(1u << controllerIdentifier), std::memory_order_relaxed);
+      else
+        connectedControllerMask.fetch_and(
+            (uint32_t)~(1u << controllerIdentifier), std::memory_order_relaxed);
+    }
+
+    uint32_t GetConnectedControllerMask(void)
+    {
+      return connectedControllerMask.load(std::memory_order_relaxed);
+    }
+
+    void RecordImportResolution(EImportModule importModule, bool resolutionSucceeded)
+    {
+      const unsigned int moduleIndex = (unsigned int)importModule;
+      if (moduleIndex >= (unsigned int)EImportModule::Count) return;
+
+      if (true == resolutionSucceeded)
+      {
+        importStatus[moduleIndex].store(
+            Api::IDiagnostics::EImportStatus::Resolved, std::memory_order_relaxed);
+      }
+      else
+      {
+        // Modules that import from multiple candidate libraries record one outcome per attempt,
+        // so a failed attempt must never downgrade a success already recorded for another
+        // library.
+        Api::IDiagnostics::EImportStatus expectedStatus =
+            Api::IDiagnostics::EImportStatus::Unknown;
+        importStatus[moduleIndex].compare_exchange_strong(
+            expectedStatus, Api::IDiagnostics::EImportStatus::Failed, std::memory_order_relaxed);
+      }
+    }
+
+    void RecordInputStackError(uint32_t errorCode)
+    {
+      lastErrorCode.store(errorCode, std::memory_order_relaxed);
+      lastErrorTime.store(GetTickCount64(), std::memory_order_relaxed);
+    }
+
+    /// Implements the Xidi API interface #IDiagnostics.
+    class DiagnosticsProvider : public Api::IDiagnostics
+    {
+    public:
+
+      // IDiagnostics
+      SHealthSnapshot GetHealthSnapshot(void) const override
+      {
+        static_assert(
+            kWorkerThreadCount == (unsigned int)EWorkerThread::Count,
+            "Worker thread count mismatch between the Xidi API and the diagnostics implementation.");
+        static_assert(
+            kImportModuleCount == (unsigned int)EImportModule::Count,
+            "Import module count mismatch between the Xidi API and the diagnostics implementation.");
+        static_assert(
+            kControllerSlotCount == Controller::kPhysicalControllerCount,
+            "Controller slot count mismatch between the Xidi API and the diagnostics implementation.");
+
+        SHealthSnapshot healthSnapshot = {};
+
+        for (unsigned int threadIndex = 0; threadIndex < kWorkerThreadCount; ++threadIndex)
+        {
+          healthSnapshot.threadIterationCount[threadIndex] =
+              threadIterationCount[threadIndex].load(std::memory_order_relaxed);
+          healthSnapshot.threadLastActivityTime[threadIndex] =
+              threadLastActivityTime[threadIndex].load(std::memory_order_relaxed);
+        }
+
+        healthSnapshot.connectedControllerMask =
+            connectedControllerMask.load(std::memory_order_relaxed);
+
+        for (Controller::TControllerIdentifier controllerIdentifier = 0;
+             controllerIdentifier < Controller::kPhysicalControllerCount;
+             ++controllerIdentifier)
+        {
+          const Controller::Mapper* const mapper =
+              Controller::Mapper::GetConfigured(controllerIdentifier);
+          if (nullptr == mapper) continue;
+
+          const std::wstring_view mapperName = mapper->GetName();
+          const size_t numCharsToCopy =
+              ((mapperName.length() < (kMapperNameCapacity - 1)) ? mapperName.length()
+                                                                 : (kMapperNameCapacity - 1));
+
+          for (size_t charIndex = 0; charIndex < numCharsToCopy; ++charIndex)
+            healthSnapshot.controllerMapperName[controllerIdentifier][charIndex] =
+                mapperName[charIndex];
+        }
+
+        for (unsigned int moduleIndex = 0; moduleIndex < kImportModuleCount; ++moduleIndex)
+          healthSnapshot.importStatus[moduleIndex] =
+              importStatus[moduleIndex].load(std::memory_order_relaxed);
+
+        healthSnapshot.lastErrorCode = lastErrorCode.load(std::memory_order_relaxed);
+        healthSnapshot.lastErrorTime = lastErrorTime.load(std::memory_order_relaxed);
+
+        return healthSnapshot;
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static DiagnosticsProvider diagnosticsProvider;
+  } // namespace Diagnostics
+} // namespace Xidi
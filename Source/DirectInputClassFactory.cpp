@@ -12,6 +12,9 @@
 
 #include "DirectInputClassFactory.h"
 
+#include <array>
+#include <mutex>
+
 #include <Infra/Core/Message.h>
 
 #include "ApiWindows.h"
@@ -20,6 +23,28 @@
 
 namespace Xidi
 {
+  /// Protects the cache of constructed class objects below.
+  static std::mutex classObjectCacheGuard;
+
+  /// Caches the wrapper object constructed for each supported combination of DirectInput version
+  /// and character mode. Launchers and overlay middleware activate the DirectInput class object
+  /// multiple times per session, and each activation previously constructed the underlying COM
+  /// plumbing anew. Each cached object holds one reference owned by the cache, so it lives for
+  /// the remainder of the process, and repeat activations of the same flavor reduce to a
+  /// reference count increment. Objects created for aggregation are never cached, because each
+  /// aggregate needs a distinct inner object.
+  static std::array<IUnknown*, 4> classObjectCache;
+
+  /// Computes the index into the class object cache for the specified combination of DirectInput
+  /// version and character mode.
+  /// @param [in] version8Requested Whether the DirectInput 8 interface flavor was requested.
+  /// @param [in] useUnicode Whether the Unicode interface flavor was requested.
+  /// @return Index of the corresponding class object cache element.
+  static inline size_t ClassObjectCacheIndex(bool version8Requested, bool useUnicode)
+  {
+    return (((true == version8Requested) ? 2 : 0) + ((true == useUnicode) ? 1 : 0));
+  }
+
   bool DirectInputClassFactory::CanCreateObjectsOfClass(REFCLSID rclsid)
   {
     return (IsEqualCLSID(CLSID_DirectInput8, rclsid) || IsEqualCLSID(CLSID_DirectInput, rclsid));
@@ -70,6 +95,19 @@ namespace Xidi
 
     if (true == validInterfaceRequested)
     {
+      if (nullptr == pUnkOuter)
+      {
+        std::unique_lock lock(classObjectCacheGuard);
+        IUnknown* const cachedClassObject =
+            classObjectCache[ClassObjectCacheIndex(version8Requested, useUnicode)];
+        if (nullptr != cachedClassObject)
+        {
+          cachedClassObject->AddRef();
+          *ppvObject = cachedClassObject;
+          return S_OK;
+        }
+      }
+
       IClassFactory* underlyingObjectFactory = nullptr;
       const HRESULT underlyingObjectFactoryCreateResult =
           (version8Requested
@@ -123,6 +161,24 @@ namespace Xidi
             return E_UNEXPECTED;
           }
 
+          if (nullptr == pUnkOuter)
+          {
+            IUnknown* const newClassObject = reinterpret_cast<IUnknown*>(*ppvObject);
+
+            std::unique_lock lock(classObjectCacheGuard);
+            IUnknown*& classObjectCacheSlot =
+                classObjectCache[ClassObjectCacheIndex(version8Requested, useUnicode)];
+            if (nullptr == classObjectCacheSlot)
+            {
+              // The reference added here is owned by the cache and never released, which keeps
+              // the object alive after the application releases all of its own references. If
+              // another thread concurrently constructed and published an object of the same
+              // flavor, this one is simply handed back uncached.
+              newClassObject->AddRef();
+              classObjectCacheSlot = newClassObject;
+            }
+          }
+
           return S_OK;
         }
         else
@@ -15,6 +15,7 @@
 #include <map>
 #include <mutex>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 
 #include "ApiWindows.h"
@@ -23,6 +24,8 @@
 #include "Infra/Core/Strings.h"
 #include "Infra/Core/TemporaryBuffer.h"
 
+extern "C" void DllForwardedFunctionsInitialize(void);
+
 namespace Xidi
 {
   namespace DllFunctions
@@ -100,6 +103,16 @@ namespace Xidi
       TerminateProcess(Infra::ProcessInfo::GetCurrentProcessHandle(), (UINT)-1);
     }
 
+    void PrebindForwardedFunctions(void)
+    {
+      if (true == allForwardedFunctions.empty()) return;
+
+      // The resolution pass is protected by a once-flag, so if an application call to a forwarded
+      // export races ahead of this thread it simply performs the resolution itself and the
+      // prebinding pass becomes a no-op.
+      std::thread(DllForwardedFunctionsInitialize).detach();
+    }
+
     bool TryImport(
         std::wstring_view libraryPath,
         HMODULE libraryHandle,
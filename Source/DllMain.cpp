@@ -10,8 +10,13 @@
  **************************************************************************************************/
 
 #include "ApiWindows.h"
+#include "DllFunctions.h"
 #include "Globals.h"
 
+#ifndef XIDI_SKIP_MAPPERS
+#include "PerformanceSummary.h"
+#endif
+
 /// Performs library initialization and teardown functions.
 /// Invoked automatically by the operating system.
 /// Refer to Windows documentation for more information.
@@ -25,7 +30,13 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ulReasonForCall, LPVOID lpReserved)
   switch (ulReasonForCall)
   {
     case DLL_PROCESS_ATTACH:
+#ifndef XIDI_HOOK_MODULE
+      // The hook module is injected into processes indiscriminately, so it skips initialization
+      // at load time and instead defers it until one of its hooks first observes DirectInput or
+      // WinMM activity. See EnsureHookModuleInitialized.
       Xidi::Globals::Initialize();
+#endif
+      Xidi::DllFunctions::PrebindForwardedFunctions();
       break;
 
     case DLL_THREAD_ATTACH:
@@ -35,6 +46,10 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ulReasonForCall, LPVOID lpReserved)
       break;
 
     case DLL_PROCESS_DETACH:
+#ifndef XIDI_SKIP_MAPPERS
+      // Only the full-featured engine form maintains the metrics this summary aggregates.
+      Xidi::PerformanceSummary::EmitSessionSummary();
+#endif
       break;
   }
 
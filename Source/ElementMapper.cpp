@@ -13,20 +13,64 @@
 #include "ElementMapper.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <new>
 #include <optional>
 
 #include "ControllerMath.h"
 #include "ControllerTypes.h"
+#include "ElementMapperArena.h"
 #include "Globals.h"
 #include "Keyboard.h"
 #include "Mouse.h"
-#include "Strings.h"
 
 namespace Xidi
 {
   namespace Controller
   {
+    namespace
+    {
+      /// Header prepended to every element mapper allocation, recording whether the memory came
+      /// from an arena or from the default heap so that deallocation can be routed correctly.
+      /// Aligned to the maximum fundamental alignment so that the object following the header is
+      /// itself suitably aligned.
+      struct alignas(std::max_align_t) SAllocationHeader
+      {
+        /// `true` if the allocation came from an arena, `false` if it came from the default heap.
+        bool fromArena;
+      };
+    } // namespace
+
+    void* IElementMapper::operator new(size_t numBytes)
+    {
+      ElementMapperArena* const activeArena = ElementMapperArena::ActiveArena();
+
+      SAllocationHeader* allocationHeader = nullptr;
+      if (nullptr != activeArena)
+      {
+        allocationHeader = reinterpret_cast<SAllocationHeader*>(
+            activeArena->Allocate(sizeof(SAllocationHeader) + numBytes));
+        allocationHeader->fromArena = true;
+      }
+      else
+      {
+        allocationHeader = reinterpret_cast<SAllocationHeader*>(
+            ::operator new(sizeof(SAllocationHeader) + numBytes));
+        allocationHeader->fromArena = false;
+      }
+
+      return (allocationHeader + 1);
+    }
+
+    void IElementMapper::operator delete(void* ptr) noexcept
+    {
+      if (nullptr == ptr) return;
+
+      SAllocationHeader* const allocationHeader = (reinterpret_cast<SAllocationHeader*>(ptr) - 1);
+      if (false == allocationHeader->fromArena) ::operator delete(allocationHeader);
+    }
+
     std::unique_ptr<IElementMapper> AxisMapper::Clone(void) const
     {
       return std::make_unique<AxisMapper>(*this);
@@ -388,11 +432,7 @@ namespace Xidi
     void MouseAxisMapper::ContributeFromAnalogValue(
         SState& controllerState, int16_t analogValue, uint32_t sourceIdentifier) const
     {
-      static const bool kEnableMouseAxisProperites =
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesUseBuiltinProperties]
-                  .ValueOr(true);
+      const bool kEnableMouseAxisProperites = Globals::GetPropertiesSettings().useBuiltinProperties;
 
       constexpr double kAnalogToMouseScalingFactor =
           (double)(Mouse::kMouseMovementUnitsMax - Mouse::kMouseMovementUnitsMin) /
@@ -473,11 +513,7 @@ namespace Xidi
     void MouseAxisMapper::ContributeFromTriggerValue(
         SState& controllerState, uint8_t triggerValue, uint32_t sourceIdentifier) const
     {
-      static const bool kEnableMouseAxisProperites =
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesUseBuiltinProperties]
-                  .ValueOr(true);
+      const bool kEnableMouseAxisProperites = Globals::GetPropertiesSettings().useBuiltinProperties;
 
       constexpr double kBidirectionalStepSize =
           (double)(Mouse::kMouseMovementUnitsMax - Mouse::kMouseMovementUnitsMin) /
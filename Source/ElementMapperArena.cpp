@@ -0,0 +1,77 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file ElementMapperArena.cpp
+ *   Implementation of an arena allocator used to keep a mapper's entire element mapper object
+ *   graph in contiguous memory.
+ **************************************************************************************************/
+
+#include "ElementMapperArena.h"
+
+#include <cstddef>
+#include <memory>
+
+#include "MemoryAccounting.h"
+
+namespace Xidi
+{
+  namespace Controller
+  {
+    /// Arena currently active on each thread, if any. Set and restored by activation scopes.
+    static thread_local ElementMapperArena* threadActiveArena = nullptr;
+
+    ElementMapperArena::ActivationScope::ActivationScope(ElementMapperArena& arena)
+        : previousActiveArena(threadActiveArena)
+    {
+      threadActiveArena = &arena;
+    }
+
+    ElementMapperArena::ActivationScope::~ActivationScope(void)
+    {
+      threadActiveArena = previousActiveArena;
+    }
+
+    ElementMapperArena::~ElementMapperArena(void)
+    {
+      MemoryAccounting::RecordRelease(
+          MemoryAccounting::ESubsystem::MapperObjects, totalChunkCapacityBytes);
+    }
+
+    ElementMapperArena* ElementMapperArena::ActiveArena(void)
+    {
+      return threadActiveArena;
+    }
+
+    void* ElementMapperArena::Allocate(size_t numBytes)
+    {
+      // Rounding every allocation up to the maximum fundamental alignment keeps the bump pointer
+      // suitably aligned for whatever object is allocated next.
+      constexpr size_t kAlignment = alignof(std::max_align_t);
+      numBytes = (numBytes + (kAlignment - 1)) & ~(kAlignment - 1);
+
+      if ((currentChunkCapacity - currentChunkUsed) < numBytes)
+      {
+        size_t newChunkCapacity =
+            ((0 == currentChunkCapacity) ? kFirstChunkCapacityBytes : (2 * currentChunkCapacity));
+        while (newChunkCapacity < numBytes)
+          newChunkCapacity *= 2;
+
+        chunks.push_back(std::make_unique<std::byte[]>(newChunkCapacity));
+        currentChunkCapacity = newChunkCapacity;
+        currentChunkUsed = 0;
+
+        totalChunkCapacityBytes += newChunkCapacity;
+        MemoryAccounting::RecordAllocation(
+            MemoryAccounting::ESubsystem::MapperObjects, newChunkCapacity);
+      }
+
+      void* const allocation = &chunks.back()[currentChunkUsed];
+      currentChunkUsed += numBytes;
+      return allocation;
+    }
+  } // namespace Controller
+} // namespace Xidi
@@ -0,0 +1,36 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file EventTrace.cpp
+ *   Implementation of manifest-free Event Tracing for Windows (ETW) instrumentation for hot-path
+ *   input pipeline events.
+ **************************************************************************************************/
+
+#include "EventTrace.h"
+
+#include <mutex>
+
+namespace Xidi
+{
+  namespace EventTrace
+  {
+    // Provider GUID is fixed so that trace sessions can enable this provider by GUID without
+    // needing it to be registered first.
+    // {5fc4cc5e-5aaf-49b8-9dfd-77506b1dc7e9}
+    TRACELOGGING_DEFINE_PROVIDER(
+        kXidiTraceProvider,
+        "Xidi",
+        (0x5fc4cc5e, 0x5aaf, 0x49b8, 0x9d, 0xfd, 0x77, 0x50, 0x6b, 0x1d, 0xc7, 0xe9));
+
+    void RegisterProvider(void)
+    {
+      static std::once_flag registerProviderFlag;
+      std::call_once(
+          registerProviderFlag, []() -> void { TraceLoggingRegister(kXidiTraceProvider); });
+    }
+  } // namespace EventTrace
+} // namespace Xidi
@@ -11,6 +11,8 @@
 
 #include "ExportApiDirectInput.h"
 
+#include <mutex>
+
 #include <Infra/Core/Message.h>
 
 #include "ApiDirectInput.h"
@@ -74,11 +76,52 @@ namespace Xidi
           Infra::Message::ESeverity::Info, L"Successfully created a DirectInput interface object.");
     }
 
+    /// Creates a new wrapped DirectInput interface object of the specified version or reuses the
+    /// cached one if it already exists. Middleware stacks commonly create DirectInput interfaces
+    /// from multiple components in one process, so the first interface object created for each
+    /// version and character set combination is cached and handed out again on repeat requests
+    /// with just a reference count increment, instead of repeating the system creation call and
+    /// the wrapper object construction. The cache permanently holds one reference of its own, so
+    /// cached interface objects live for the remainder of the process even if the application
+    /// releases all of its references.
+    /// @tparam diVersion DirectInput version enumerator.
+    /// @tparam SystemCreateFunc Type of the callable that invokes the imported system creation
+    /// function.
+    /// @param [out] interfaceObject Filled with a pointer to the wrapped interface object on
+    /// success, with one reference belonging to the caller.
+    /// @param [in] systemCreateFunc Callable that invokes the imported system creation function,
+    /// with a pointer to the underlying system interface pointer to fill as its only parameter.
+    /// Invoked only if no cached interface object exists.
+    /// @return `DI_OK` on success, or the error code produced by the system creation callable on
+    /// failure. Failures are not cached, so a subsequent request retries the system call.
+    template <EDirectInputVersion diVersion, typename SystemCreateFunc>
+    static HRESULT CreateOrReuseInterfaceObject(
+        void** interfaceObject, SystemCreateFunc systemCreateFunc)
+    {
+      static WrapperIDirectInput<diVersion>* cachedInterfaceObject = nullptr;
+      static std::mutex cachedInterfaceObjectGuard;
+
+      std::scoped_lock lock(cachedInterfaceObjectGuard);
+
+      if (nullptr == cachedInterfaceObject)
+      {
+        typename DirectInputTypes<diVersion>::IDirectInputType* systemInterfaceObject = nullptr;
+        const HRESULT systemCreateResult = systemCreateFunc(&systemInterfaceObject);
+        if (DI_OK != systemCreateResult) return systemCreateResult;
+
+        // The single reference returned by the system creation call becomes the reference that
+        // the cache itself owns and never releases.
+        cachedInterfaceObject = new WrapperIDirectInput<diVersion>(systemInterfaceObject);
+      }
+
+      cachedInterfaceObject->AddRef();
+      *interfaceObject = cachedInterfaceObject;
+      return DI_OK;
+    }
+
     HRESULT __stdcall Version8DirectInput8Create(
         HINSTANCE hinst, DWORD dwVersion, REFIID riidltf, LPVOID* ppvOut, LPUNKNOWN punkOuter)
     {
-      void* diObject = nullptr;
-
       if (dwVersion < dinputVersion8Min || dwVersion > dinputVersion8Max)
       {
         LogVersionOutOfRange(dinputVersion8Min, dinputVersion8Max, dwVersion);
@@ -91,23 +134,39 @@ namespace Xidi
         return DIERR_INVALIDPARAM;
       }
 
-      HRESULT result = ImportApiDirectInput::Version8::DirectInput8Create(
-          hinst, dwVersion, riidltf, &diObject, punkOuter);
+      HRESULT result = DI_OK;
+
+      if (IID_IDirectInput8W == riidltf)
+        result = CreateOrReuseInterfaceObject<EDirectInputVersion::k8W>(
+            ppvOut,
+            [hinst, dwVersion, punkOuter](IDirectInput8W** systemInterfaceObject) -> HRESULT
+            {
+              return ImportApiDirectInput::Version8::DirectInput8Create(
+                  hinst,
+                  dwVersion,
+                  IID_IDirectInput8W,
+                  reinterpret_cast<LPVOID*>(systemInterfaceObject),
+                  punkOuter);
+            });
+      else
+        result = CreateOrReuseInterfaceObject<EDirectInputVersion::k8A>(
+            ppvOut,
+            [hinst, dwVersion, punkOuter](IDirectInput8A** systemInterfaceObject) -> HRESULT
+            {
+              return ImportApiDirectInput::Version8::DirectInput8Create(
+                  hinst,
+                  dwVersion,
+                  IID_IDirectInput8A,
+                  reinterpret_cast<LPVOID*>(systemInterfaceObject),
+                  punkOuter);
+            });
+
       if (DI_OK != result)
       {
         LogSystemCreateError(result);
         return result;
       }
 
-      if (IID_IDirectInput8W == riidltf)
-        diObject = new WrapperIDirectInput<EDirectInputVersion::k8W>(
-            reinterpret_cast<IDirectInput8W*>(diObject));
-      else
-        diObject = new WrapperIDirectInput<EDirectInputVersion::k8A>(
-            reinterpret_cast<IDirectInput8A*>(diObject));
-
-      *ppvOut = (LPVOID)diObject;
-
       LogSystemCreateSuccess();
       return result;
     }
@@ -115,26 +174,28 @@ namespace Xidi
     HRESULT __stdcall VersionLegacyDirectInputCreateA(
         HINSTANCE hinst, DWORD dwVersion, LPDIRECTINPUTA* ppDI, LPUNKNOWN punkOuter)
     {
-      IDirectInputA* diObject = nullptr;
-
       if (dwVersion < dinputVersionLegacyMin || dwVersion > dinputVersionLegacyMax)
       {
         LogVersionOutOfRange(dinputVersionLegacyMin, dinputVersionLegacyMax, dwVersion);
         return E_FAIL;
       }
 
-      HRESULT result = ImportApiDirectInput::VersionLegacy::DirectInputCreateA(
-          hinst, dinputVersionLegacy, reinterpret_cast<LPDIRECTINPUTA*>(&diObject), punkOuter);
+      const HRESULT result = CreateOrReuseInterfaceObject<EDirectInputVersion::kLegacyA>(
+          reinterpret_cast<void**>(ppDI),
+          [hinst, punkOuter](IDirectInput7A** systemInterfaceObject) -> HRESULT
+          {
+            return ImportApiDirectInput::VersionLegacy::DirectInputCreateA(
+                hinst,
+                dinputVersionLegacy,
+                reinterpret_cast<LPDIRECTINPUTA*>(systemInterfaceObject),
+                punkOuter);
+          });
       if (DI_OK != result)
       {
         LogSystemCreateError(result);
         return result;
       }
 
-      diObject = new WrapperIDirectInput<EDirectInputVersion::kLegacyA>(
-          reinterpret_cast<IDirectInput7A*>(diObject));
-      *ppDI = (LPDIRECTINPUTA)diObject;
-
       LogSystemCreateSuccess();
       return result;
     }
@@ -142,26 +203,28 @@ namespace Xidi
     HRESULT __stdcall VersionLegacyDirectInputCreateW(
         HINSTANCE hinst, DWORD dwVersion, LPDIRECTINPUTW* ppDI, LPUNKNOWN punkOuter)
     {
-      IDirectInputW* diObject = nullptr;
-
       if (dwVersion < dinputVersionLegacyMin || dwVersion > dinputVersionLegacyMax)
       {
         LogVersionOutOfRange(dinputVersionLegacyMin, dinputVersionLegacyMax, dwVersion);
         return E_FAIL;
       }
 
-      HRESULT result = ImportApiDirectInput::VersionLegacy::DirectInputCreateW(
-          hinst, dinputVersionLegacy, reinterpret_cast<LPDIRECTINPUTW*>(&diObject), punkOuter);
+      const HRESULT result = CreateOrReuseInterfaceObject<EDirectInputVersion::kLegacyW>(
+          reinterpret_cast<void**>(ppDI),
+          [hinst, punkOuter](IDirectInput7W** systemInterfaceObject) -> HRESULT
+          {
+            return ImportApiDirectInput::VersionLegacy::DirectInputCreateW(
+                hinst,
+                dinputVersionLegacy,
+                reinterpret_cast<LPDIRECTINPUTW*>(systemInterfaceObject),
+                punkOuter);
+          });
       if (DI_OK != result)
       {
         LogSystemCreateError(result);
         return result;
       }
 
-      diObject = new WrapperIDirectInput<EDirectInputVersion::kLegacyW>(
-          reinterpret_cast<IDirectInput7W*>(diObject));
-      *ppDI = (LPDIRECTINPUTW)diObject;
-
       LogSystemCreateSuccess();
       return result;
     }
@@ -169,8 +232,6 @@ namespace Xidi
     HRESULT __stdcall VersionLegacyDirectInputCreateEx(
         HINSTANCE hinst, DWORD dwVersion, REFIID riidltf, LPVOID* ppvOut, LPUNKNOWN punkOuter)
     {
-      void* diObject = nullptr;
-
       if (dwVersion < dinputVersionLegacyMin || dwVersion > dinputVersionLegacyMax)
       {
         LogVersionOutOfRange(dinputVersionLegacyMin, dinputVersionLegacyMax, dwVersion);
@@ -185,21 +246,33 @@ namespace Xidi
         return DIERR_INVALIDPARAM;
       }
 
-      HRESULT result;
-      BOOL useUnicode = FALSE;
+      HRESULT result = DI_OK;
 
       if (IID_IDirectInputW == riidltf || IID_IDirectInput2W == riidltf ||
           IID_IDirectInput7W == riidltf)
-      {
-        useUnicode = TRUE;
-        result = ImportApiDirectInput::VersionLegacy::DirectInputCreateEx(
-            hinst, dinputVersionLegacy, riidltf, &diObject, punkOuter);
-      }
+        result = CreateOrReuseInterfaceObject<EDirectInputVersion::kLegacyW>(
+            ppvOut,
+            [hinst, riidltf, punkOuter](IDirectInput7W** systemInterfaceObject) -> HRESULT
+            {
+              return ImportApiDirectInput::VersionLegacy::DirectInputCreateEx(
+                  hinst,
+                  dinputVersionLegacy,
+                  riidltf,
+                  reinterpret_cast<LPVOID*>(systemInterfaceObject),
+                  punkOuter);
+            });
       else
-      {
-        result = ImportApiDirectInput::VersionLegacy::DirectInputCreateEx(
-            hinst, dinputVersionLegacy, riidltf, &diObject, punkOuter);
-      }
+        result = CreateOrReuseInterfaceObject<EDirectInputVersion::kLegacyA>(
+            ppvOut,
+            [hinst, riidltf, punkOuter](IDirectInput7A** systemInterfaceObject) -> HRESULT
+            {
+              return ImportApiDirectInput::VersionLegacy::DirectInputCreateEx(
+                  hinst,
+                  dinputVersionLegacy,
+                  riidltf,
+                  reinterpret_cast<LPVOID*>(systemInterfaceObject),
+                  punkOuter);
+            });
 
       if (DI_OK != result)
       {
@@ -207,15 +280,6 @@ namespace Xidi
         return result;
       }
 
-      if (TRUE == useUnicode)
-        diObject = new WrapperIDirectInput<EDirectInputVersion::kLegacyW>(
-            reinterpret_cast<IDirectInput7W*>(diObject));
-      else
-        diObject = new WrapperIDirectInput<EDirectInputVersion::kLegacyA>(
-            reinterpret_cast<IDirectInput7A*>(diObject));
-
-      *ppvOut = diObject;
-
       LogSystemCreateSuccess();
       return result;
     }
@@ -0,0 +1,76 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file FlightRecorder.cpp
+ *   Implementation of an always-on in-memory flight recorder of recent input pipeline activity.
+ **************************************************************************************************/
+
+#include "FlightRecorder.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "ApiWindows.h"
+
+namespace Xidi
+{
+  namespace FlightRecorder
+  {
+    /// Flight recorder storage area. The header fields are initialized statically so that the
+    /// magic value is searchable in a crash dump even if the crash happens before any event is
+    /// recorded.
+    static SRecordArea recordArea = {
+        .magic =
+            {kRecordAreaMagic[0],
+             kRecordAreaMagic[1],
+             kRecordAreaMagic[2],
+             kRecordAreaMagic[3],
+             kRecordAreaMagic[4],
+             kRecordAreaMagic[5],
+             kRecordAreaMagic[6],
+             kRecordAreaMagic[7],
+             kRecordAreaMagic[8],
+             kRecordAreaMagic[9],
+             kRecordAreaMagic[10],
+             kRecordAreaMagic[11],
+             kRecordAreaMagic[12],
+             kRecordAreaMagic[13],
+             kRecordAreaMagic[14],
+             kRecordAreaMagic[15]},
+        .version = 1,
+        .recordSizeBytes = sizeof(SRecord),
+        .recordCapacity = kRecordCapacity};
+
+    void Record(EEvent event, uint32_t param1, uint32_t param2, uint32_t param3)
+    {
+      // Claiming a sequence number is the only synchronization between concurrent recording
+      // threads. Each sequence number maps to exactly one ring slot, so two threads write the
+      // same slot only if one of them has fallen a full ring capacity behind, in which case the
+      // stale record is sacrificed. This is a diagnostic ring, so that is an acceptable outcome
+      // in exchange for never blocking.
+      const uint32_t sequence =
+          1 + recordArea.numRecordsWritten.fetch_add(1, std::memory_order_relaxed);
+      SRecord& record = recordArea.records[(sequence - 1) % kRecordCapacity];
+
+      // Invalidating the sequence number first and rewriting it last, with release semantics,
+      // lets post-mortem tooling identify records that were mid-write at crash time.
+      record.sequence.store(0, std::memory_order_relaxed);
+      record.threadId = GetCurrentThreadId();
+      record.timestamp = GetTickCount64();
+      record.event = event;
+      record.param1 = param1;
+      record.param2 = param2;
+      record.param3 = param3;
+      record.sequence.store(sequence, std::memory_order_release);
+    }
+
+    const SRecordArea& GetRecordArea(void)
+    {
+      return recordArea;
+    }
+  } // namespace FlightRecorder
+} // namespace Xidi
@@ -12,6 +12,8 @@
 
 #include "ForceFeedbackDevice.h"
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
@@ -39,6 +41,45 @@ namespace Xidi
             timestampBase;
       }
 
+      /// Minimal standard allocator that serves shared pointer control blocks from the effect
+      /// block pool, by way of the allocation operators on the effect base class. Together with
+      /// the pooled effect objects themselves, this makes publishing an effect to the registry
+      /// free of default heap allocator traffic at steady state.
+      template <typename T> struct SPooledEffectAllocator
+      {
+        using value_type = T;
+
+        SPooledEffectAllocator(void) = default;
+
+        template <typename U> constexpr SPooledEffectAllocator(
+            const SPooledEffectAllocator<U>& other) noexcept
+        {}
+
+        T* allocate(size_t numElements)
+        {
+          return reinterpret_cast<T*>(Effect::operator new(numElements * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t numElements) noexcept
+        {
+          Effect::operator delete(ptr);
+        }
+      };
+
+      /// Describes a single playing effect captured by a playback pass while holding the registry
+      /// lock. Magnitude computation for snapshot entries takes place after the lock is released.
+      struct SPlaybackSnapshotEntry
+      {
+        /// Effect object for which a magnitude contribution is to be computed. Shared ownership
+        /// keeps the object alive and stable even if a concurrent parameter update publishes a
+        /// replacement for it in the registry.
+        std::shared_ptr<const Effect> effect;
+
+        /// Time within the effect's playback for which the magnitude contribution is to be
+        /// computed.
+        TEffectTimeMs playTime;
+      };
+
       Device::Device(void) : Device(ImportApiWinMM::timeGetTime()) {}
 
       Device::Device(TEffectTimeMs timestampBase)
@@ -48,106 +89,230 @@ namespace Xidi
             stateEffectsAreMuted(),
             stateEffectsArePaused(),
             timestampBase(timestampBase),
-            timestampRelativeLastPlay()
+            timestampRelativeLastPlay(),
+            playbackActivityNotificationEvent(NULL),
+            effectStatusMirror{}
       {}
 
+      Device::EEffectStatus Device::EffectStatusMirrorRead(TEffectIdentifier id)
+      {
+        for (auto& statusSlot : effectStatusMirror)
+        {
+          if (id != statusSlot.id.load(std::memory_order_relaxed)) continue;
+
+          const EEffectStatus status = statusSlot.status.load(std::memory_order_acquire);
+
+          // Re-checking the identifier catches a concurrent writer recycling this slot for a
+          // different effect between the two loads above. Writers publish the identifier before
+          // the status, with release ordering on the status store, so a slot whose identifier
+          // still matches after the status load delivered a status that belongs to this effect.
+          if (id != statusSlot.id.load(std::memory_order_relaxed))
+            return EEffectStatus::NotOnDevice;
+
+          return status;
+        }
+
+        return EEffectStatus::NotOnDevice;
+      }
+
+      void Device::EffectStatusMirrorWrite(TEffectIdentifier id, EEffectStatus newStatus)
+      {
+        SEffectStatusSlot* vacantSlot = nullptr;
+
+        for (auto& statusSlot : effectStatusMirror)
+        {
+          if (id == statusSlot.id.load(std::memory_order_relaxed))
+          {
+            if (newStatus != statusSlot.status.load(std::memory_order_relaxed))
+              statusSlot.status.store(newStatus, std::memory_order_release);
+            return;
+          }
+
+          if ((nullptr == vacantSlot) &&
+              (EEffectStatus::NotOnDevice ==
+               statusSlot.status.load(std::memory_order_relaxed)))
+            vacantSlot = &statusSlot;
+        }
+
+        // The mirror has exactly as many slots as the device buffer has effect capacity and the
+        // capacity check happens before any mirror write, so a vacant slot always exists when a
+        // new effect needs one.
+        if ((EEffectStatus::NotOnDevice == newStatus) || (nullptr == vacantSlot)) return;
+
+        // Identifier before status, with release ordering on the status store, so that a reader
+        // that observes the slot as occupied also observes the matching identifier.
+        vacantSlot->id.store(id, std::memory_order_relaxed);
+        vacantSlot->status.store(newStatus, std::memory_order_release);
+      }
+
       bool Device::AddOrUpdateEffect(const Effect& effect)
       {
+        // Cloning happens before the lock is acquired so that the critical section consists only
+        // of map operations and a pointer swap. Updates publish the clone as a replacement effect
+        // object rather than synchronizing parameters into the stored object, which means a
+        // playback pass concurrently computing magnitudes from a snapshot of the old object is
+        // unaffected. The clone itself comes from the effect block pool, and supplying a pooled
+        // allocator here places the shared pointer control block there too.
+        std::unique_ptr<Effect> clonedEffect = effect.Clone();
+        std::shared_ptr<Effect> newEffect(
+            clonedEffect.release(), std::default_delete<Effect>(), SPooledEffectAllocator<Effect>());
+
         std::unique_lock lock(mutex);
 
         auto playingEffectIter = playingEffects.find(effect.Identifier());
         if (playingEffects.end() != playingEffectIter)
-          return playingEffectIter->second.effect->SyncParametersFrom(effect);
+        {
+          playingEffectIter->second.effect = std::move(newEffect);
+          return true;
+        }
 
         auto readyEffectIter = readyEffects.find(effect.Identifier());
         if (readyEffects.end() != readyEffectIter)
-          return readyEffectIter->second.effect->SyncParametersFrom(effect);
+        {
+          readyEffectIter->second.effect = std::move(newEffect);
+          return true;
+        }
 
         if ((playingEffects.size() + readyEffects.size()) >= kEffectMaxCount) return false;
 
-        readyEffects.emplace(std::make_pair(effect.Identifier(), effect.Clone()));
+        readyEffects.emplace(std::make_pair(effect.Identifier(), std::move(newEffect)));
+        EffectStatusMirrorWrite(effect.Identifier(), EEffectStatus::Downloaded);
 
         return true;
       }
 
-      bool Device::IsEffectPlaying(TEffectIdentifier id)
+      std::optional<TEffectTimeMs> Device::MillisecondsUntilNextEffectTransition(
+          std::optional<TEffectTimeMs> timestamp)
       {
         std::shared_lock lock(mutex);
 
-        auto playingEffectIter = playingEffects.find(id);
-        if (playingEffects.end() == playingEffectIter) return false;
+        if (true == playingEffects.empty()) return std::nullopt;
 
-        // This last check filters out effects that are pending playback but have not yet officially
-        // started due to a start delay.
-        return (timestampRelativeLastPlay >= playingEffectIter->second.startTime);
+        // While paused the playback clock is frozen, but unpausing is not signaled to the
+        // actuation thread, so it needs to keep up its periodic passes to notice promptly.
+        if (true == stateEffectsArePaused) return 0;
+
+        const TEffectTimeMs relativeTimestampNow = RelativeTimestamp(timestampBase, timestamp);
+        TEffectTimeMs earliestScheduledStartTime = 0;
+        bool anyStartTransitionScheduled = false;
+
+        for (const auto& playingEffect : playingEffects)
+        {
+          // An effect that has reached its start time produces continuous output, or in the muted
+          // case could begin doing so the moment the device is unmuted, either of which requires
+          // passes at the normal actuation period.
+          if (relativeTimestampNow >= playingEffect.second.startTime) return 0;
+
+          if ((false == anyStartTransitionScheduled) ||
+              (playingEffect.second.startTime < earliestScheduledStartTime))
+          {
+            earliestScheduledStartTime = playingEffect.second.startTime;
+            anyStartTransitionScheduled = true;
+          }
+        }
+
+        return (earliestScheduledStartTime - relativeTimestampNow);
       }
 
       TOrderedMagnitudeComponents Device::PlayEffects(std::optional<TEffectTimeMs> timestamp)
       {
-        std::unique_lock lock(mutex);
-
-        const TEffectTimeMs relativeTimestampPlayback = RelativeTimestamp(timestampBase, timestamp);
+        // Playback bookkeeping takes place under the registry lock, but it captures a stable
+        // snapshot of the playing effects so that magnitude computations, the expensive part of a
+        // playback pass, happen after the lock is released. Application threads that update effect
+        // parameters therefore only ever contend with map operations, not with magnitude
+        // computations, and a parameter update that lands mid-pass leaves the in-progress pass
+        // computing from its stable snapshot.
+        std::array<SPlaybackSnapshotEntry, kEffectMaxCount> playbackSnapshot;
+        unsigned int playbackSnapshotCount = 0;
 
-        if (true == stateEffectsArePaused)
         {
-          timestampBase += (relativeTimestampPlayback - timestampRelativeLastPlay);
-          return {};
-        }
+          std::unique_lock lock(mutex);
 
-        timestampRelativeLastPlay = relativeTimestampPlayback;
+          const TEffectTimeMs relativeTimestampPlayback =
+              RelativeTimestamp(timestampBase, timestamp);
 
-        TOrderedMagnitudeComponents playbackResult = {};
+          if (true == stateEffectsArePaused)
+          {
+            timestampBase += (relativeTimestampPlayback - timestampRelativeLastPlay);
+            return {};
+          }
 
-        auto playingEffectIter = playingEffects.begin();
-        while (playingEffectIter != playingEffects.end())
-        {
-          SEffectData& effectData = playingEffectIter->second;
+          timestampRelativeLastPlay = relativeTimestampPlayback;
 
-          // Effects with start delays would be added to the playing effects data structure with
-          // start times in the future. This check skips playback of effects that have not
-          // officially started playing due to a start delay parameter.
-          if (relativeTimestampPlayback >= effectData.startTime)
+          auto playingEffectIter = playingEffects.begin();
+          while (playingEffectIter != playingEffects.end())
           {
-            const TEffectTimeMs effectPlayTime = relativeTimestampPlayback - effectData.startTime;
+            SEffectData& effectData = playingEffectIter->second;
 
-            if (effectPlayTime >= effectData.effect->GetDuration())
+            // Effects with start delays would be added to the playing effects data structure with
+            // start times in the future. This check skips playback of effects that have not
+            // officially started playing due to a start delay parameter.
+            if (relativeTimestampPlayback >= effectData.startTime)
             {
-              // An iteration of the effect has finished playing.
-              // If there are iterations left then repeat the effect, otherwise remove it from
-              // playback.
-              if (effectData.numIterationsLeft > 0)
-              {
-                effectData.numIterationsLeft -= 1;
-                effectData.startTime = relativeTimestampPlayback;
+              const TEffectTimeMs effectPlayTime = relativeTimestampPlayback - effectData.startTime;
 
-                if (false == stateEffectsAreMuted)
-                  playbackResult += effectData.effect->ComputeOrderedMagnitudeComponents(0);
+              if (effectPlayTime >= effectData.effect->GetDuration())
+              {
+                // An iteration of the effect has finished playing.
+                // If there are iterations left then repeat the effect, otherwise remove it from
+                // playback.
+                if (effectData.numIterationsLeft > 0)
+                {
+                  effectData.numIterationsLeft -= 1;
+                  effectData.startTime = relativeTimestampPlayback;
+
+                  EffectStatusMirrorWrite(playingEffectIter->first, EEffectStatus::Playing);
+
+                  if (false == stateEffectsAreMuted)
+                    playbackSnapshot[playbackSnapshotCount++] = {
+                        .effect = effectData.effect, .playTime = 0};
+                }
+                else
+                {
+                  EffectStatusMirrorWrite(playingEffectIter->first, EEffectStatus::Downloaded);
+
+                  // As soon as the playing effect is removed from its container the iterator is
+                  // invalidated. Therefore, move on to the next effect before removing it. This
+                  // path is the only one that bypasses the auto-increment that occurs at the end of
+                  // a loop iteration.
+                  auto finishedEffectIter = playingEffectIter++;
+                  readyEffects.insert(playingEffects.extract(finishedEffectIter));
+                  continue;
+                }
               }
               else
               {
-                // As soon as the playing effect is removed from its container the iterator is
-                // invalidated. Therefore, move on to the next effect before removing it. This path
-                // is the only one that bypasses the auto-increment that occurs at the end of a loop
-                // iteration.
-                auto finishedEffectIter = playingEffectIter++;
-                readyEffects.insert(playingEffects.extract(finishedEffectIter));
-                continue;
+                // Effect is currently playing, so it contributes a magnitude for its current play
+                // time. Effects whose start delay elapsed this pass transition to officially
+                // playing in the status mirror here, which is a no-op store-skip on later passes.
+                EffectStatusMirrorWrite(playingEffectIter->first, EEffectStatus::Playing);
+
+                if (false == stateEffectsAreMuted)
+                  playbackSnapshot[playbackSnapshotCount++] = {
+                      .effect = effectData.effect, .playTime = effectPlayTime};
               }
             }
-            else
-            {
-              // Effect is currently playing.
-              // This is as simple as computing its magnitude components and adding them to the
-              // result.
-              if (false == stateEffectsAreMuted)
-                playbackResult +=
-                    effectData.effect->ComputeOrderedMagnitudeComponents(effectPlayTime);
-            }
-          }
 
-          ++playingEffectIter;
+            ++playingEffectIter;
+          }
         }
 
+        // Magnitude contributions are computed into a contiguous array of component vectors, one
+        // row per snapshot entry, with the polymorphic per-effect computation confined to the
+        // first loop. The second loop that sums the rows is a flat pass over contiguous
+        // floating-point values, which keeps the marginal cost of each additional concurrently
+        // playing effect low.
+        std::array<TOrderedMagnitudeComponents, kEffectMaxCount> playbackComponents;
+
+        for (unsigned int i = 0; i < playbackSnapshotCount; ++i)
+          playbackComponents[i] = playbackSnapshot[i].effect->ComputeOrderedMagnitudeComponents(
+              playbackSnapshot[i].playTime);
+
+        TOrderedMagnitudeComponents playbackResult = {};
+
+        for (unsigned int i = 0; i < playbackSnapshotCount; ++i)
+          playbackResult += playbackComponents[i];
+
         return playbackResult;
       }
 
@@ -161,11 +326,28 @@ namespace Xidi
         auto readyEffectIter = readyEffects.find(id);
         if (readyEffects.end() == readyEffectIter) return false;
 
-        readyEffectIter->second.startTime = RelativeTimestamp(timestampBase, timestamp) +
+        const TEffectTimeMs effectStartTime = RelativeTimestamp(timestampBase, timestamp) +
             readyEffectIter->second.effect->GetStartDelay();
+        readyEffectIter->second.startTime = effectStartTime;
         readyEffectIter->second.numIterationsLeft = numIterations - 1;
 
-        return playingEffects.insert(readyEffects.extract(readyEffectIter)).inserted;
+        const bool startResult =
+            playingEffects.insert(readyEffects.extract(readyEffectIter)).inserted;
+
+        if (true == startResult)
+        {
+          // Effects with a pending start delay are not officially playing yet; they transition to
+          // playing in the status mirror once a playback pass reaches their start time.
+          EffectStatusMirrorWrite(
+              id,
+              ((timestampRelativeLastPlay >= effectStartTime) ? EEffectStatus::Playing
+                                                              : EEffectStatus::PendingStart));
+
+          if (NULL != playbackActivityNotificationEvent)
+            SetEvent(playbackActivityNotificationEvent);
+        }
+
+        return startResult;
       }
 
       void Device::StopAllEffects(void)
@@ -173,7 +355,10 @@ namespace Xidi
         std::unique_lock lock(mutex);
 
         while (false == playingEffects.empty())
+        {
+          EffectStatusMirrorWrite(playingEffects.cbegin()->first, EEffectStatus::Downloaded);
           readyEffects.insert(playingEffects.extract(playingEffects.cbegin()));
+        }
       }
 
       bool Device::StopEffect(TEffectIdentifier id)
@@ -183,16 +368,22 @@ namespace Xidi
         auto playingEffectIter = playingEffects.find(id);
         if (playingEffects.end() == playingEffectIter) return false;
 
-        return readyEffects.insert(playingEffects.extract(playingEffectIter)).inserted;
+        const bool stopResult =
+            readyEffects.insert(playingEffects.extract(playingEffectIter)).inserted;
+        if (true == stopResult) EffectStatusMirrorWrite(id, EEffectStatus::Downloaded);
+
+        return stopResult;
       }
 
       bool Device::RemoveEffect(TEffectIdentifier id)
       {
         std::unique_lock lock(mutex);
 
-        if (0 != readyEffects.erase(id)) return true;
-
-        if (0 != playingEffects.erase(id)) return true;
+        if ((0 != readyEffects.erase(id)) || (0 != playingEffects.erase(id)))
+        {
+          EffectStatusMirrorWrite(id, EEffectStatus::NotOnDevice);
+          return true;
+        }
 
         return false;
       }
@@ -11,8 +11,11 @@
 
 #include "ForceFeedbackEffect.h"
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 #include "ForceFeedbackMath.h"
@@ -23,10 +26,117 @@ namespace Xidi
   {
     namespace ForceFeedback
     {
+      namespace
+      {
+        /// Header prepended to every effect allocation, recording whether the memory came from the
+        /// block pool or from the default heap so that deallocation can be routed correctly.
+        /// Aligned to the maximum fundamental alignment so that the object following the header is
+        /// itself suitably aligned.
+        struct alignas(std::max_align_t) SAllocationHeader
+        {
+          /// `true` if the allocation came from the block pool, `false` if it came from the
+          /// default heap.
+          bool fromPool;
+        };
+
+        /// Size in bytes of a single pool block, including its allocation header. Must be large
+        /// enough to hold any concrete effect type; a static assertion at the end of this file
+        /// verifies this for every type the product ships.
+        inline constexpr size_t kPoolBlockSizeBytes = 512;
+
+        /// Number of pool blocks obtained from the default heap at a time whenever the free list
+        /// is empty. Slabs live for the life of the process, so the pool's footprint is bounded by
+        /// the peak number of simultaneously live effect objects rounded up to a slab boundary.
+        inline constexpr size_t kPoolBlocksPerSlab = 64;
+
+        /// Free list node overlaid onto unused pool blocks.
+        struct SPoolBlock
+        {
+          /// Next free block in the list, or `nullptr` for the last one.
+          SPoolBlock* next;
+        };
+
+        /// Enforces proper concurrency control over the pool free list. Effects are allocated and
+        /// released from both application threads and the actuation thread.
+        static std::mutex poolMutex;
+
+        /// Head of the pool free list.
+        static SPoolBlock* poolFreeList = nullptr;
+
+        /// Obtains a single block from the pool, carving up a new slab from the default heap if
+        /// the free list is empty. After warm-up, allocations are served entirely from the free
+        /// list.
+        /// @return Pointer to a pool block of #kPoolBlockSizeBytes bytes.
+        static void* PoolAllocateBlock(void)
+        {
+          std::unique_lock lock(poolMutex);
+
+          if (nullptr == poolFreeList)
+          {
+            std::byte* const newSlab = new std::byte[kPoolBlockSizeBytes * kPoolBlocksPerSlab];
+
+            for (size_t i = 0; i < kPoolBlocksPerSlab; ++i)
+            {
+              SPoolBlock* const newBlock =
+                  reinterpret_cast<SPoolBlock*>(newSlab + (i * kPoolBlockSizeBytes));
+              newBlock->next = poolFreeList;
+              poolFreeList = newBlock;
+            }
+          }
+
+          SPoolBlock* const allocatedBlock = poolFreeList;
+          poolFreeList = allocatedBlock->next;
+          return allocatedBlock;
+        }
+
+        /// Returns a single block to the pool for reuse by a future allocation.
+        /// @param [in] block Pointer to the pool block to release.
+        static void PoolFreeBlock(void* block)
+        {
+          std::unique_lock lock(poolMutex);
+
+          SPoolBlock* const freedBlock = reinterpret_cast<SPoolBlock*>(block);
+          freedBlock->next = poolFreeList;
+          poolFreeList = freedBlock;
+        }
+      } // namespace
+
       /// Holds the next available value for a force feedback effect identifier.
       static std::atomic<TEffectIdentifier> nextEffectIdentifier = 0;
 
-      Effect::Effect(void) : id(nextEffectIdentifier++), commonParameters() {}
+      void* Effect::operator new(size_t numBytes)
+      {
+        SAllocationHeader* allocationHeader = nullptr;
+
+        if (numBytes <= (kPoolBlockSizeBytes - sizeof(SAllocationHeader)))
+        {
+          allocationHeader = reinterpret_cast<SAllocationHeader*>(PoolAllocateBlock());
+          allocationHeader->fromPool = true;
+        }
+        else
+        {
+          allocationHeader = reinterpret_cast<SAllocationHeader*>(
+              ::operator new(sizeof(SAllocationHeader) + numBytes));
+          allocationHeader->fromPool = false;
+        }
+
+        return (allocationHeader + 1);
+      }
+
+      void Effect::operator delete(void* ptr) noexcept
+      {
+        if (nullptr == ptr) return;
+
+        SAllocationHeader* const allocationHeader =
+            (reinterpret_cast<SAllocationHeader*>(ptr) - 1);
+
+        if (true == allocationHeader->fromPool)
+          PoolFreeBlock(allocationHeader);
+        else
+          ::operator delete(allocationHeader);
+      }
+
+      Effect::Effect(void) : id(nextEffectIdentifier++), commonParameters(), envelopeRuntime() {}
 
       bool ConstantForceEffect::AreTypeSpecificParametersValid(
           const SConstantForceParameters& newTypeSpecificParameters) const
@@ -116,12 +226,13 @@ namespace Xidi
 
       TEffectValue PeriodicEffect::ComputePhase(TEffectTimeMs rawTime) const
       {
+        const SPeriodicParameters& periodicParameters = GetTypeSpecificParameters().value();
+
         const TEffectValue rawTimeInPeriods =
-            (TEffectValue)rawTime / (TEffectValue)GetTypeSpecificParameters().value().period;
+            (TEffectValue)rawTime / (TEffectValue)periodicParameters.period;
 
         TEffectValue currentPhase = std::round(
-            ((rawTimeInPeriods - floorf(rawTimeInPeriods)) * 36000) +
-            GetTypeSpecificParameters().value().phase);
+            ((rawTimeInPeriods - floorf(rawTimeInPeriods)) * 36000) + periodicParameters.phase);
         if (currentPhase >= 36000) currentPhase -= 36000;
 
         return currentPhase;
@@ -139,11 +250,12 @@ namespace Xidi
 
       TEffectValue PeriodicEffect::ComputeRawMagnitude(TEffectTimeMs rawTime) const
       {
-        const TEffectValue modifiedAmplitude =
-            ApplyEnvelope(rawTime, GetTypeSpecificParameters().value().amplitude);
+        const SPeriodicParameters& periodicParameters = GetTypeSpecificParameters().value();
+
+        const TEffectValue modifiedAmplitude = ApplyEnvelope(rawTime, periodicParameters.amplitude);
         const TEffectValue rawMagnitude =
             (modifiedAmplitude * WaveformAmplitude(ComputePhase(rawTime))) +
-            GetTypeSpecificParameters().value().offset;
+            periodicParameters.offset;
 
         return std::min(
             kEffectForceMagnitudeMaximum, std::max(kEffectForceMagnitudeMinimum, rawMagnitude));
@@ -192,6 +304,28 @@ namespace Xidi
 
       TEffectValue SineWaveEffect::WaveformAmplitude(TEffectValue phase) const
       {
+        // Phase values are produced in whole hundredths of degrees, so on the actuation path
+        // every sine evaluation is served directly from this table, which covers one full wave
+        // cycle at phase granularity and is built once on first use. Table entries reproduce
+        // #TrigonometrySine exactly, including its rounding behavior, so using the table is not
+        // observable in the output. Non-integral phase values, which can only arise from unusual
+        // application-supplied phase offset parameters, fall back to direct computation.
+        static const std::array<TEffectValue, 36000> kSineWaveTable = []()
+            -> std::array<TEffectValue, 36000>
+        {
+          std::array<TEffectValue, 36000> sineWaveTable = {};
+
+          for (unsigned int phaseIndex = 0; phaseIndex < sineWaveTable.size(); ++phaseIndex)
+            sineWaveTable[phaseIndex] = TrigonometrySine((TEffectValue)phaseIndex);
+
+          return sineWaveTable;
+        }();
+
+        const unsigned int phaseIndex = (unsigned int)phase;
+        if ((phase >= 0) && (phaseIndex < kSineWaveTable.size()) &&
+            ((TEffectValue)phaseIndex == phase))
+          return kSineWaveTable[phaseIndex];
+
         return TrigonometrySine(phase);
       }
 
@@ -234,23 +368,24 @@ namespace Xidi
 
       TEffectValue Effect::ApplyEnvelope(TEffectTimeMs rawTime, TEffectValue sustainLevel) const
       {
-        if (false == commonParameters.envelope.has_value()) return sustainLevel;
+        // Breakpoint times and attack/fade time reciprocals are precomputed whenever the envelope
+        // or duration parameters change, so evaluating the envelope at a given time requires only
+        // comparisons, multiplications, and additions. Slopes themselves cannot be precomputed
+        // because the sustain level can vary with time for some effect types.
+        if (false == envelopeRuntime.isActive) return sustainLevel;
 
-        const SEnvelope& envelope = commonParameters.envelope.value();
-
-        if (rawTime < envelope.attackTime)
+        if (rawTime < envelopeRuntime.attackEndTime)
         {
           const TEffectTimeMs envelopeTime = rawTime;
           const TEffectValue envelopeSlope =
-              (sustainLevel - envelope.attackLevel) / envelope.attackTime;
-          return envelope.attackLevel + (envelopeSlope * envelopeTime);
+              (sustainLevel - envelopeRuntime.attackLevel) * envelopeRuntime.attackTimeReciprocal;
+          return envelopeRuntime.attackLevel + (envelopeSlope * envelopeTime);
         }
-        else if (rawTime > commonParameters.duration.value() - envelope.fadeTime)
+        else if (rawTime > envelopeRuntime.fadeStartTime)
         {
-          const TEffectTimeMs envelopeTime =
-              rawTime - (commonParameters.duration.value() - envelope.fadeTime);
+          const TEffectTimeMs envelopeTime = rawTime - envelopeRuntime.fadeStartTime;
           const TEffectValue envelopeSlope =
-              (envelope.fadeLevel - sustainLevel) / envelope.fadeTime;
+              (envelopeRuntime.fadeLevel - sustainLevel) * envelopeRuntime.fadeTimeReciprocal;
           return sustainLevel + (envelopeSlope * envelopeTime);
         }
 
@@ -264,6 +399,28 @@ namespace Xidi
         const TEffectTimeMs rawTime = time - (time % commonParameters.samplePeriodForComputations);
         return ComputeRawMagnitude(rawTime) * commonParameters.gainFraction;
       }
+
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(ConstantForceEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(RampForceEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(SawtoothDownEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(SawtoothUpEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(SineWaveEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(SquareWaveEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
+      static_assert(
+          (sizeof(SAllocationHeader) + sizeof(TriangleWaveEffect)) <= kPoolBlockSizeBytes,
+          "Pool block size constraint violation.");
     } // namespace ForceFeedback
   }   // namespace Controller
 } // namespace Xidi
@@ -12,11 +12,16 @@
 
 #include "Globals.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #include <Infra/Core/Configuration.h>
 #include <Infra/Core/Message.h>
@@ -28,10 +33,17 @@
 #include "GitVersionInfo.generated.h"
 
 #ifndef XIDI_SKIP_CONFIG
+#include "ApiXidi.h"
 #include "XidiConfigReader.h"
 #ifndef XIDI_SKIP_MAPPERS
+#include "EventTrace.h"
+#include "ImportApiDirectInput.h"
+#include "ImportApiWinMM.h"
 #include "Mapper.h"
 #include "MapperBuilder.h"
+#include "MapperParser.h"
+#include "MemoryAccounting.h"
+#include "PhysicalController.h"
 #endif
 #endif
 
@@ -43,6 +55,11 @@ namespace Xidi
 {
   namespace Globals
   {
+    /// Generation number of the currently-published configuration settings. Starts at zero and is
+    /// incremented each time a configuration hot reload publishes a new snapshot, so consumers
+    /// that cache configuration-derived data can cheaply detect staleness.
+    static std::atomic<unsigned int> configurationGeneration;
+
 #ifndef XIDI_SKIP_CONFIG
 #ifndef XIDI_SKIP_MAPPERS
     /// Holds custom mapper blueprints produced while reading from a configuration file.
@@ -65,9 +82,21 @@ namespace Xidi
       }
 
       customMapperBuilder.Clear();
+
+      // In low-memory mode the parser's element mapper prototype cache is also released. It
+      // exists to speed up repeated element mapper strings during construction and is not needed
+      // once all mappers have been built.
+      if (true == MemoryAccounting::IsLowMemoryModeEnabled())
+        Controller::MapperParser::ClearParsedPrototypeCache();
     }
 #endif
 
+    /// Currently-published configuration data snapshot. Initialized by the first call to
+    /// #GetConfigurationData and replaced wholesale by configuration hot reloads. Superseded
+    /// snapshots are deliberately kept alive because callers may still hold references into them,
+    /// and snapshots are only superseded a handful of times per tuning session.
+    static std::atomic<const Infra::Configuration::ConfigurationData*> activeConfigData;
+
     /// Generates and returns the file path for a Xidi log file. This is a combination of the
     /// product name, Xidi form name, PID, executable base name, and the .log extension,
     /// placed in the current user's desktop directory.
@@ -125,12 +154,13 @@ namespace Xidi
     /// Enables the log, if it is configured in the configuration file.
     static void EnableLogIfConfigured(void)
     {
-      const bool logEnabled = GetConfigurationData()[Strings::kStrConfigurationSectionLog]
-                                                    [Strings::kStrConfigurationSettingLogEnabled]
-                                                        .ValueOr(false);
-      const int64_t logLevel = GetConfigurationData()[Strings::kStrConfigurationSectionLog]
-                                                     [Strings::kStrConfigurationSettingLogLevel]
-                                                         .ValueOr(0);
+      const auto& logConfigData = GetConfigurationData()[ApplicableConfigurationSection(
+          Strings::kStrConfigurationSectionLog)];
+
+      const bool logEnabled =
+          logConfigData[Strings::kStrConfigurationSettingLogEnabled].ValueOr(false);
+      const int64_t logLevel =
+          logConfigData[Strings::kStrConfigurationSettingLogLevel].ValueOr(0);
 
       if ((true == logEnabled) && (logLevel > 0))
       {
@@ -140,9 +170,450 @@ namespace Xidi
         EnableLog(configuredSeverity);
       }
     }
+
+    /// Re-reads the configuration file and, if it parses cleanly, rebuilds any custom mappers it
+    /// defines, publishes the result as a new configuration snapshot, and re-applies the log
+    /// settings. On parse errors the currently-published snapshot is left untouched, so a
+    /// half-saved or broken configuration file never disrupts a running session.
+    static void ReloadConfiguration(void)
+    {
+      XidiConfigReader configReader;
+
+#ifndef XIDI_SKIP_MAPPERS
+      configReader.SetMapperBuilder(&customMapperBuilder);
 #endif
 
-    bool DoesCurrentProcessHaveInputFocus(void)
+      std::unique_ptr<Infra::Configuration::ConfigurationData> newConfigData =
+          std::make_unique<Infra::Configuration::ConfigurationData>(
+              configReader.ReadConfigurationFile(Strings::GetConfigurationFilePath()));
+
+      if (true == configReader.HasErrorMessages())
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Warning,
+            L"Errors were encountered while re-reading the configuration file. The previous settings remain in effect.");
+        configReader.LogAllErrorMessages();
+
+#ifndef XIDI_SKIP_MAPPERS
+        customMapperBuilder.Clear();
+#endif
+
+        return;
+      }
+
+#ifndef XIDI_SKIP_MAPPERS
+      // Rebuilt custom mappers re-register under their names and thereby replace their previous
+      // versions for all subsequent name lookups. The previous mapper objects stay alive because
+      // running controllers and open device objects may still hold pointers to them.
+      BuildCustomMappers();
+#endif
+
+      // Snapshot first, then generation, both with release ordering, so that a consumer observing
+      // the new generation number is guaranteed to read the new snapshot.
+      activeConfigData.store(newConfigData.release(), std::memory_order_release);
+      configurationGeneration.fetch_add(1, std::memory_order_release);
+
+      EnableLogIfConfigured();
+
+      Infra::Message::Output(
+          Infra::Message::ESeverity::Info,
+          L"Configuration file was modified. Reloaded it and republished the settings snapshot.");
+    }
+
+    /// Manages the thread that watches the configuration file for modifications and hot reloads
+    /// it whenever one occurs, so that settings can be tuned without restarting the application.
+    /// The thread spends its life blocked in the system waiting for a directory change
+    /// notification and consumes no cycles while the file is unchanged. Wraps the thread handle
+    /// to ensure safe termination and clean-up.
+    class ConfigurationMonitor
+    {
+    public:
+
+      inline ConfigurationMonitor(void) : monitorThread(), exitEvent(NULL) {}
+
+      /// Safely exits the configuration monitor thread if it is started.
+      ~ConfigurationMonitor(void)
+      {
+        if (true == monitorThread.joinable())
+        {
+          SetEvent(exitEvent);
+          monitorThread.join();
+          CloseHandle(exitEvent);
+        }
+      }
+
+      /// Starts running the configuration monitor thread.
+      inline void Start(void)
+      {
+        if (false == monitorThread.joinable())
+        {
+          exitEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+          if (NULL == exitEvent) return;
+
+          monitorThread = std::thread(MonitorConfigurationFile, exitEvent);
+        }
+      }
+
+    private:
+
+      /// Delay between noticing a change to the configuration file and re-reading it. Editors
+      /// typically produce a burst of file system operations per save, so the file is given a
+      /// moment to settle, which also coalesces the burst into a single reload.
+      static constexpr DWORD kReloadSettleDelayMilliseconds = 100;
+
+      /// Watches the directory that contains the configuration file and triggers a reload
+      /// whenever the configuration file itself changes. If the directory cannot be watched the
+      /// thread exits and configuration changes require a restart, as before.
+      /// @param [in] exitEvent Handle of the event that signals this thread to exit.
+      static void MonitorConfigurationFile(HANDLE exitEvent)
+      {
+        const std::wstring_view configFilePath = Strings::GetConfigurationFilePath();
+        const size_t lastSeparatorPos = configFilePath.find_last_of(L'\\');
+        if (std::wstring_view::npos == lastSeparatorPos) return;
+
+        const std::wstring configDirectory(configFilePath.substr(0, lastSeparatorPos));
+        const std::wstring_view configFileName = configFilePath.substr(1 + lastSeparatorPos);
+
+        const HANDLE directoryHandle = CreateFile(
+            configDirectory.c_str(),
+            FILE_LIST_DIRECTORY,
+            (FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE),
+            nullptr,
+            OPEN_EXISTING,
+            (FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED),
+            NULL);
+        if (INVALID_HANDLE_VALUE == directoryHandle) return;
+
+        const HANDLE changeEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (NULL == changeEvent)
+        {
+          CloseHandle(directoryHandle);
+          return;
+        }
+
+        // Receives change notification records, which the system requires be DWORD-aligned.
+        alignas(sizeof(DWORD)) uint8_t changeBuffer[1024];
+
+        while (true)
+        {
+          OVERLAPPED overlapped = {};
+          overlapped.hEvent = changeEvent;
+
+          if (FALSE ==
+              ReadDirectoryChangesW(
+                  directoryHandle,
+                  changeBuffer,
+                  sizeof(changeBuffer),
+                  FALSE,
+                  (FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE |
+                   FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION),
+                  nullptr,
+                  &overlapped,
+                  nullptr))
+            break;
+
+          const HANDLE waitHandles[] = {exitEvent, changeEvent};
+          if ((WAIT_OBJECT_0 + 1) !=
+              WaitForMultipleObjects(_countof(waitHandles), waitHandles, FALSE, INFINITE))
+          {
+            // The pending watch operation references the stack-allocated buffer and overlapped
+            // structure, so it must be fully cancelled before this function can safely return.
+            CancelIoEx(directoryHandle, &overlapped);
+
+            DWORD unusedNumChangeBytes = 0;
+            GetOverlappedResult(directoryHandle, &overlapped, &unusedNumChangeBytes, TRUE);
+            break;
+          }
+
+          DWORD numChangeBytes = 0;
+          if (FALSE ==
+              GetOverlappedResult(directoryHandle, &overlapped, &numChangeBytes, FALSE))
+            continue;
+
+          // A zero-length completion means the notification buffer overflowed, in which case the
+          // specific changed files are unknown and the configuration file is conservatively
+          // assumed to be among them.
+          bool configFileChanged = (0 == numChangeBytes);
+
+          for (size_t changeRecordOffset = 0;
+               (false == configFileChanged) && (changeRecordOffset < (size_t)numChangeBytes);)
+          {
+            const FILE_NOTIFY_INFORMATION* const changeRecord =
+                reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(&changeBuffer[changeRecordOffset]);
+            const std::wstring_view changedFileName(
+                changeRecord->FileName, changeRecord->FileNameLength / sizeof(wchar_t));
+
+            if ((changedFileName.length() == configFileName.length()) &&
+                (0 ==
+                 _wcsnicmp(
+                     changedFileName.data(), configFileName.data(), configFileName.length())))
+              configFileChanged = true;
+
+            if (0 == changeRecord->NextEntryOffset) break;
+            changeRecordOffset += changeRecord->NextEntryOffset;
+          }
+
+          if (false == configFileChanged) continue;
+
+          if (WAIT_TIMEOUT != WaitForSingleObject(exitEvent, kReloadSettleDelayMilliseconds))
+            break;
+
+          ReloadConfiguration();
+        }
+
+        CloseHandle(changeEvent);
+        CloseHandle(directoryHandle);
+      }
+
+      /// Handle for the configuration monitor thread itself.
+      std::thread monitorThread;
+
+      /// Handle of the manual-reset event used to tell the monitor thread to exit.
+      HANDLE exitEvent;
+    };
+
+    /// Singleton object that wraps the configuration monitor thread.
+    static ConfigurationMonitor configurationMonitor;
+
+    /// Enumerates the startup pipeline phases whose durations are measured. Enumerator order
+    /// determines the phase indexing of the timings exposed through the #Api::IStartupMetrics
+    /// interface, so existing enumerators must not be reordered.
+    enum class EStartupPhase : unsigned int
+    {
+      /// Configuration file read, including custom mapper construction.
+      ConfigurationRead,
+
+      /// Log output enablement based on the configured log settings.
+      LogEnablement,
+
+      /// Physical controller initialization, including per-controller mapper selection.
+      PhysicalControllerInitialization,
+
+      /// Configuration file change monitor start.
+      ConfigurationMonitorStart,
+
+      /// Event trace provider registration.
+      TraceProviderRegistration,
+
+      /// Preloading of the native libraries from which functions are imported.
+      ImportLibraryPreload,
+
+      /// Sentinel value. Total number of measured startup phases.
+      Count
+    };
+
+    /// Measured duration of each startup phase, in microseconds. Written by the startup
+    /// pipeline threads as each phase completes and read by the startup metrics interface.
+    static std::atomic<uint64_t> startupPhaseTimeMicroseconds[(unsigned int)EStartupPhase::Count];
+
+    /// Number of startup pipeline threads that have not yet run to completion. Starts at the
+    /// number of pipeline threads the running Xidi form uses and is decremented by each as it
+    /// finishes; the thread that decrements it to zero emits the phase timing summary.
+#ifndef XIDI_SKIP_MAPPERS
+    static std::atomic<unsigned int> startupPipelinesOutstanding = 2;
+#else
+    static std::atomic<unsigned int> startupPipelinesOutstanding = 1;
+#endif
+
+    /// Runs the specified startup stage while measuring its duration with the performance
+    /// counter and records the result against the specified startup phase.
+    /// @param [in] startupPhase Startup phase being measured.
+    /// @param [in] stageFunc Stage implementation to run.
+    template <typename StageFunc> static void TimeStartupPhase(
+        EStartupPhase startupPhase, StageFunc stageFunc)
+    {
+      LARGE_INTEGER counterFrequency;
+      LARGE_INTEGER startTime;
+      LARGE_INTEGER endTime;
+
+      QueryPerformanceFrequency(&counterFrequency);
+      QueryPerformanceCounter(&startTime);
+      stageFunc();
+      QueryPerformanceCounter(&endTime);
+
+      startupPhaseTimeMicroseconds[(unsigned int)startupPhase].store(
+          (uint64_t)(((endTime.QuadPart - startTime.QuadPart) * 1000000) /
+                     counterFrequency.QuadPart),
+          std::memory_order_relaxed);
+    }
+
+    /// Marks one startup pipeline thread as complete and, once all of them are, emits a
+    /// one-line summary of the measured phase durations at info level for launch-time
+    /// attribution.
+    static void RecordStartupPipelineComplete(void)
+    {
+      if (1 != startupPipelinesOutstanding.fetch_sub(1, std::memory_order_acq_rel)) return;
+
+      Infra::Message::OutputFormatted(
+          Infra::Message::ESeverity::Info,
+          L"Startup phase times (us): config read = %llu, log enablement = %llu, physical controller init = %llu, config monitor start = %llu, trace provider registration = %llu, import preload = %llu.",
+          (unsigned long long)startupPhaseTimeMicroseconds
+              [(unsigned int)EStartupPhase::ConfigurationRead]
+                  .load(std::memory_order_relaxed),
+          (unsigned long long)startupPhaseTimeMicroseconds
+              [(unsigned int)EStartupPhase::LogEnablement]
+                  .load(std::memory_order_relaxed),
+          (unsigned long long)startupPhaseTimeMicroseconds
+              [(unsigned int)EStartupPhase::PhysicalControllerInitialization]
+                  .load(std::memory_order_relaxed),
+          (unsigned long long)startupPhaseTimeMicroseconds
+              [(unsigned int)EStartupPhase::ConfigurationMonitorStart]
+                  .load(std::memory_order_relaxed),
+          (unsigned long long)startupPhaseTimeMicroseconds
+              [(unsigned int)EStartupPhase::TraceProviderRegistration]
+                  .load(std::memory_order_relaxed),
+          (unsigned long long)startupPhaseTimeMicroseconds
+              [(unsigned int)EStartupPhase::ImportLibraryPreload]
+                  .load(std::memory_order_relaxed));
+    }
+
+    /// Implements the Xidi API interface #Xidi::Api::IStartupMetrics.
+    class StartupMetricsProvider : public Api::IStartupMetrics
+    {
+    public:
+
+      // IStartupMetrics
+      SStartupPhaseTimes GetStartupPhaseTimes(void) const override
+      {
+        static_assert(
+            kStartupPhaseCount == (unsigned int)EStartupPhase::Count,
+            "Startup phase count mismatch between the Xidi API and the pipeline implementation.");
+
+        SStartupPhaseTimes startupPhaseTimes = {
+            .startupComplete =
+                (0 == startupPipelinesOutstanding.load(std::memory_order_acquire))};
+
+        for (unsigned int phaseIndex = 0; phaseIndex < kStartupPhaseCount; ++phaseIndex)
+          startupPhaseTimes.phaseTimeMicroseconds[phaseIndex] =
+              startupPhaseTimeMicroseconds[phaseIndex].load(std::memory_order_relaxed);
+
+        return startupPhaseTimes;
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static StartupMetricsProvider startupMetricsProvider;
+
+    /// Manages the background threads that run the startup initialization pipeline. Startup work
+    /// is organized into stages: stages that depend on one another run in order on the same
+    /// thread, and stages that are mutually independent run concurrently on separate threads. The
+    /// pipeline is started from the process attach notification, which runs while the loader lock
+    /// is held, so the pipeline threads are started but never synchronized with from that context.
+    /// Every stage publishes its results through interfaces that are individually lazy and
+    /// concurrency-safe, so an application thread that needs a result before the pipeline has
+    /// produced it simply does the work itself, and the corresponding pipeline stage becomes a
+    /// no-op. Wraps the thread handles to ensure safe clean-up.
+    class InitializationPipeline
+    {
+    public:
+
+      inline InitializationPipeline(void) : stageThreads() {}
+
+      /// Waits for the pipeline threads to finish, if they were started. All stages complete
+      /// within a bounded amount of time after startup, so by clean-up time these joins do not
+      /// block.
+      ~InitializationPipeline(void)
+      {
+        for (auto& stageThread : stageThreads)
+          if (true == stageThread.joinable()) stageThread.join();
+      }
+
+      /// Starts the pipeline threads if they are not already started. Threads created while the
+      /// loader lock is held do not begin executing until it is released, at which point the
+      /// pipeline runs concurrently with whatever startup work the application itself is doing.
+      inline void Start(void)
+      {
+        if (false == stageThreads[0].joinable())
+        {
+          stageThreads[0] = std::thread(RunConfigurationStages);
+
+#ifndef XIDI_SKIP_MAPPERS
+          stageThreads[1] = std::thread(RunSystemLibraryStages);
+#endif
+        }
+      }
+
+    private:
+
+      /// Runs the stages that depend on the contents of the configuration file, in dependency
+      /// order: configuration file reading (including custom mapper construction), then log
+      /// output enablement, which consumes the log settings, then physical controller
+      /// initialization, which selects a mapper per controller and therefore must wait until all
+      /// mappers are registered.
+      static void RunConfigurationStages(void)
+      {
+        TimeStartupPhase(
+            EStartupPhase::ConfigurationRead, []() -> void { GetConfigurationData(); });
+        TimeStartupPhase(
+            EStartupPhase::LogEnablement, []() -> void { EnableLogIfConfigured(); });
+
+#ifndef XIDI_SKIP_MAPPERS
+        TimeStartupPhase(
+            EStartupPhase::PhysicalControllerInitialization,
+            []() -> void
+            {
+              Controller::Mapper::DumpRegisteredMappers();
+              Controller::EnsurePhysicalControllersInitialized();
+            });
+#endif
+
+        // Hot reload only begins watching for configuration file changes once the initial read
+        // is complete and its results are fully applied.
+        TimeStartupPhase(
+            EStartupPhase::ConfigurationMonitorStart,
+            []() -> void { configurationMonitor.Start(); });
+
+        RecordStartupPipelineComplete();
+      }
+
+#ifndef XIDI_SKIP_MAPPERS
+      /// Runs the stages that touch only system libraries and are therefore independent of the
+      /// configuration file: preloading the native libraries from which functions are imported,
+      /// so that the first imported function call only pays for resolving the one function it
+      /// actually needs. These stages exist only in the main Xidi library, which is the only
+      /// module that imports from the system libraries.
+      static void RunSystemLibraryStages(void)
+      {
+        // Trace provider registration is not safe from a DLL entry point, which is why it happens
+        // here on a pipeline thread rather than directly in Initialize.
+        TimeStartupPhase(
+            EStartupPhase::TraceProviderRegistration,
+            []() -> void { EventTrace::RegisterProvider(); });
+
+        TimeStartupPhase(
+            EStartupPhase::ImportLibraryPreload,
+            []() -> void
+            {
+              ImportApiWinMM::PreloadImportLibrary();
+              ImportApiDirectInput::Version8::PreloadImportLibrary();
+              ImportApiDirectInput::VersionLegacy::PreloadImportLibrary();
+            });
+
+        RecordStartupPipelineComplete();
+      }
+#endif
+
+      /// Handles for the pipeline threads themselves.
+      std::thread stageThreads[2];
+    };
+
+    /// Singleton object that wraps the initialization pipeline threads.
+    static InitializationPipeline initializationPipeline;
+#endif
+
+    /// Cached result of the most recent input focus determination, updated by the focus monitor
+    /// whenever the system foreground window changes. Valid only while #inputFocusCacheIsValid
+    /// indicates so.
+    static std::atomic<bool> currentProcessHasInputFocus;
+
+    /// Indicates whether the cached input focus flag is being kept current by an installed
+    /// foreground change hook. While `false`, focus determinations fall back to querying the
+    /// system directly.
+    static std::atomic<bool> inputFocusCacheIsValid;
+
+    /// Determines directly from the system whether this process has input focus.
+    /// @return `true` if so, `false` if not.
+    static bool QueryCurrentProcessHasInputFocus(void)
     {
       DWORD foregroundProcess = 0;
       GetWindowThreadProcessId(GetForegroundWindow(), &foregroundProcess);
@@ -150,10 +621,106 @@ namespace Xidi
       return (GetCurrentProcessId() == foregroundProcess);
     }
 
-    const Infra::Configuration::ConfigurationData& GetConfigurationData(void)
+    /// WinEvent hook callback invoked by the system whenever the foreground window changes.
+    /// Updates the cached input focus flag.
+    static void CALLBACK OnForegroundWindowChanged(
+        HWINEVENTHOOK, DWORD, HWND hwnd, LONG, LONG, DWORD, DWORD)
     {
-      static Infra::Configuration::ConfigurationData configData;
+      DWORD foregroundProcess = 0;
+      GetWindowThreadProcessId(hwnd, &foregroundProcess);
+
+      currentProcessHasInputFocus.store(
+          (GetCurrentProcessId() == foregroundProcess), std::memory_order_relaxed);
+    }
+
+    /// Manages the thread that keeps the cached input focus flag current. Out-of-context WinEvent
+    /// callbacks are delivered through the message queue of the thread that installed the hook,
+    /// so a dedicated thread pumps messages; it is otherwise blocked in the system and consumes
+    /// no cycles between foreground changes. Wraps the thread handle to ensure safe termination
+    /// and clean-up.
+    class InputFocusMonitor
+    {
+    public:
+
+      inline InputFocusMonitor(void) : monitorThread(), monitorThreadId() {}
+
+      /// Safely exits the focus monitor thread if it is started.
+      ~InputFocusMonitor(void)
+      {
+        if (true == monitorThread.joinable())
+        {
+          const DWORD threadId = monitorThreadId.load(std::memory_order_acquire);
+          if (0 != threadId) PostThreadMessage(threadId, WM_QUIT, 0, 0);
+          monitorThread.join();
+        }
+      }
+
+      /// Starts running the focus monitor thread.
+      inline void Start(void)
+      {
+        if (false == monitorThread.joinable())
+          monitorThread = std::thread(MonitorInputFocus, &monitorThreadId);
+      }
+
+    private:
+
+      /// Installs the foreground change hook, seeds the cached focus flag, and pumps messages so
+      /// the hook callbacks are delivered. If the hook cannot be installed the cache is never
+      /// marked valid, and focus determinations continue to query the system directly.
+      /// @param [out] monitorThreadId Receives the identifier of the monitor thread, so it can be
+      /// told to quit during clean-up.
+      static void MonitorInputFocus(std::atomic<DWORD>* monitorThreadId)
+      {
+        monitorThreadId->store(GetCurrentThreadId(), std::memory_order_release);
+
+        const HWINEVENTHOOK foregroundEventHook = SetWinEventHook(
+            EVENT_SYSTEM_FOREGROUND,
+            EVENT_SYSTEM_FOREGROUND,
+            NULL,
+            OnForegroundWindowChanged,
+            0,
+            0,
+            WINEVENT_OUTOFCONTEXT);
+        if (NULL == foregroundEventHook) return;
+
+        currentProcessHasInputFocus.store(
+            QueryCurrentProcessHasInputFocus(), std::memory_order_relaxed);
+        inputFocusCacheIsValid.store(true, std::memory_order_release);
+
+        MSG message;
+        while (0 < GetMessage(&message, NULL, 0, 0))
+        {
+          TranslateMessage(&message);
+          DispatchMessage(&message);
+        }
+
+        inputFocusCacheIsValid.store(false, std::memory_order_release);
+        UnhookWinEvent(foregroundEventHook);
+      }
+
+      /// Handle for the focus monitor thread itself.
+      std::thread monitorThread;
+
+      /// System identifier of the focus monitor thread, used to post it a quit message.
+      std::atomic<DWORD> monitorThreadId;
+    };
+
+    /// Singleton object that wraps the focus monitor thread.
+    static InputFocusMonitor inputFocusMonitor;
+
+    bool DoesCurrentProcessHaveInputFocus(void)
+    {
+      static std::once_flag focusMonitorFlag;
+      std::call_once(focusMonitorFlag, []() -> void { inputFocusMonitor.Start(); });
 
+      if (true == inputFocusCacheIsValid.load(std::memory_order_acquire))
+        return currentProcessHasInputFocus.load(std::memory_order_relaxed);
+
+      return QueryCurrentProcessHasInputFocus();
+    }
+
+    const Infra::Configuration::ConfigurationData& GetConfigurationData(void)
+    {
 #ifndef XIDI_SKIP_CONFIG
       static std::once_flag readConfigFlag;
       std::call_once(
@@ -166,7 +733,9 @@ namespace Xidi
             configReader.SetMapperBuilder(&customMapperBuilder);
 #endif
 
-            configData = configReader.ReadConfigurationFile();
+            std::unique_ptr<Infra::Configuration::ConfigurationData> configData =
+                std::make_unique<Infra::Configuration::ConfigurationData>(
+                    configReader.ReadConfigurationFile(Strings::GetConfigurationFilePath()));
 
             if (false == configReader.HasErrorMessages())
             {
@@ -184,28 +753,351 @@ namespace Xidi
               configReader.LogAllErrorMessages();
               Infra::Message::Output(
                   Infra::Message::ESeverity::Error,
-                  L"None of the settings in the configuration file were applied. Fix the errors and restart the application.");
+                  L"None of the settings in the configuration file were applied. Fix the errors and save the configuration file to apply them.");
 
               Infra::Message::Output(
                   Infra::Message::ESeverity::ForcedInteractiveWarning,
                   L"Errors were encountered during configuration file reading. See log file on the Desktop for more information.");
 
-              configData.Clear();
+              configData->Clear();
             }
+
+            activeConfigData.store(configData.release(), std::memory_order_release);
           });
-#endif
 
+      return *activeConfigData.load(std::memory_order_acquire);
+#else
+      static Infra::Configuration::ConfigurationData configData;
       return configData;
+#endif
+    }
+
+    unsigned int GetConfigurationGeneration(void)
+    {
+      return configurationGeneration.load(std::memory_order_acquire);
+    }
+
+    std::wstring_view ApplicableConfigurationSection(std::wstring_view configurationSection)
+    {
+      const std::wstring_view profileSectionName =
+          Strings::ConfigurationProfileSectionName(configurationSection);
+
+      if ((false == profileSectionName.empty()) &&
+          (true == GetConfigurationData().Contains(profileSectionName)))
+        return profileSectionName;
+
+      return configurationSection;
+    }
+
+    /// Compiles a properties settings snapshot from the currently-published configuration data.
+    /// @return Compiled settings snapshot.
+    static SPropertiesSettings CompilePropertiesSettings(void)
+    {
+      const auto& properties = GetConfigurationData()[ApplicableConfigurationSection(
+          Strings::kStrConfigurationSectionProperties)];
+
+      return {
+          .circleToSquareFractionStickLeft =
+              static_cast<double>(
+                  properties
+                      [Strings::kStrConfigurationSettingsPropertiesCircleToSquarePercentStickLeft]
+                          .ValueOr(0)) /
+              100.0,
+          .circleToSquareFractionStickRight =
+              static_cast<double>(
+                  properties
+                      [Strings::
+                           kStrConfigurationSettingsPropertiesCircleToSquarePercentStickRight]
+                          .ValueOr(0)) /
+              100.0,
+          .forceFeedbackEffectStrengthScalingFactor =
+              static_cast<double>(
+                  properties
+                      [Strings::
+                           kStrConfigurationSettingPropertiesForceFeedbackEffectStrengthPercent]
+                          .ValueOr(100)) /
+              100.0,
+          .deadzonePercentStickLeft = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesDeadzonePercentStickLeft]
+                  .ValueOr(0)),
+          .deadzonePercentStickRight = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesDeadzonePercentStickRight]
+                  .ValueOr(0)),
+          .deadzonePercentTriggerLT = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesDeadzonePercentTriggerLT]
+                  .ValueOr(0)),
+          .deadzonePercentTriggerRT = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesDeadzonePercentTriggerRT]
+                  .ValueOr(0)),
+          .radialDeadzoneStickLeft =
+              properties[Strings::kStrConfigurationSettingsPropertiesRadialDeadzoneStickLeft]
+                  .ValueOr(false),
+          .radialDeadzoneStickRight =
+              properties[Strings::kStrConfigurationSettingsPropertiesRadialDeadzoneStickRight]
+                  .ValueOr(false),
+          .saturationPercentStickLeft = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesSaturationPercentStickLeft]
+                  .ValueOr(100)),
+          .saturationPercentStickRight = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesSaturationPercentStickRight]
+                  .ValueOr(100)),
+          .saturationPercentTriggerLT = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesSaturationPercentTriggerLT]
+                  .ValueOr(100)),
+          .saturationPercentTriggerRT = static_cast<unsigned int>(
+              properties[Strings::kStrConfigurationSettingsPropertiesSaturationPercentTriggerRT]
+                  .ValueOr(100)),
+          .mouseSpeedScalingFactorPercent = static_cast<unsigned int>(
+              properties
+                  [Strings::kStrConfigurationSettingPropertiesMouseSpeedScalingFactorPercent]
+                      .ValueOr(100)),
+          .stateChangeEventSignalingWatermark = static_cast<uint32_t>(
+              properties
+                  [Strings::kStrConfigurationSettingsPropertiesStateChangeEventSignalingWatermark]
+                      .ValueOr(0)),
+          .stateChangeEventCoalescing =
+              properties[Strings::kStrConfigurationSettingsPropertiesStateChangeEventCoalescing]
+                  .ValueOr(false),
+          .useBuiltinProperties =
+              properties[Strings::kStrConfigurationSettingsPropertiesUseBuiltinProperties]
+                  .ValueOr(true)};
+    }
+
+    const SPropertiesSettings& GetPropertiesSettings(void)
+    {
+      // Readers obtain the current snapshot with a single atomic pointer load, and the snapshot
+      // is recompiled on demand by whichever caller first observes a new configuration
+      // generation. Superseded snapshots are deliberately kept alive because callers may still
+      // hold references into them.
+      static std::atomic<const SPropertiesSettings*> activePropertiesSettings;
+      static std::atomic<int64_t> activePropertiesSettingsGeneration = -1;
+      static std::mutex compilePropertiesSettingsMutex;
+
+      const int64_t currentGeneration = (int64_t)GetConfigurationGeneration();
+      if (currentGeneration != activePropertiesSettingsGeneration.load(std::memory_order_acquire))
+      {
+        std::unique_lock lock(compilePropertiesSettingsMutex);
+
+        if (currentGeneration !=
+            activePropertiesSettingsGeneration.load(std::memory_order_relaxed))
+        {
+          activePropertiesSettings.store(
+              new SPropertiesSettings(CompilePropertiesSettings()), std::memory_order_release);
+          activePropertiesSettingsGeneration.store(currentGeneration, std::memory_order_release);
+        }
+      }
+
+      return *activePropertiesSettings.load(std::memory_order_acquire);
+    }
+
+    /// Process-wide scheduler for deferred background work. Maintains a small shared pool of
+    /// low-priority worker threads so that subsystems can move work off the input path without
+    /// each spawning threads of their own, which keeps Xidi's total thread count bounded.
+    /// Supports immediate and delayed one-shot tasks, periodic tasks, and draining of
+    /// outstanding one-shot work for shutdown paths.
+    class BackgroundTaskScheduler
+    {
+    public:
+
+      /// Submits a task to run once the specified delay has elapsed. A period of zero denotes a
+      /// one-shot task; otherwise, after each run that returns `true` the task is rescheduled
+      /// to run again one period later.
+      /// @param [in] task Task to run.
+      /// @param [in] delayMilliseconds Minimum delay before the task becomes eligible to run.
+      /// @param [in] periodMilliseconds Interval between successive runs, or 0 for one-shot.
+      void Submit(
+          TPeriodicBackgroundTask&& task,
+          unsigned int delayMilliseconds,
+          unsigned int periodMilliseconds)
+      {
+        {
+          std::unique_lock lock(taskGuard);
+          EnsureWorkerThreadsStarted();
+
+          pendingTasks.emplace(
+              GetTickCount64() + delayMilliseconds,
+              SPendingTask{.task = std::move(task), .periodMilliseconds = periodMilliseconds});
+
+          if (0 == periodMilliseconds) numOneShotTasksOutstanding += 1;
+        }
+
+        taskAvailableSignal.notify_one();
+      }
+
+      /// Blocks until every outstanding one-shot task has run to completion, including those
+      /// whose delay has not yet elapsed. Periodic tasks are unaffected.
+      void Drain(void)
+      {
+        std::unique_lock lock(taskGuard);
+        drainCompleteSignal.wait(
+            lock, [this]() -> bool { return (0 == numOneShotTasksOutstanding); });
+      }
+
+    private:
+
+      /// Internal record for a task that has been submitted but not yet run to completion.
+      struct SPendingTask
+      {
+        /// Task to run.
+        TPeriodicBackgroundTask task;
+
+        /// Interval between successive runs of the task, or 0 for a one-shot task.
+        unsigned int periodMilliseconds;
+      };
+
+      /// Starts the worker thread pool if it is not already running. Must be invoked with
+      /// #taskGuard held. Worker threads are detached, and the singleton scheduler object is
+      /// deliberately leaked, so that tasks running during process teardown never touch a
+      /// destroyed object.
+      void EnsureWorkerThreadsStarted(void)
+      {
+        if (true == workerThreadsStarted) return;
+
+        workerThreadsStarted = true;
+        for (unsigned int i = 0; i < kBackgroundTaskWorkerCount; ++i)
+          std::thread(&BackgroundTaskScheduler::WorkerThread, this).detach();
+      }
+
+      /// Runs deferred tasks as they become due. Multiple worker threads run this procedure,
+      /// so long-running tasks delay other tasks only once the whole pool is busy.
+      void WorkerThread(void)
+      {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+        ApplyWorkerThreadAttributes(
+            Strings::kStrConfigurationSettingWorkerThreadsBackgroundTaskThreadPriority,
+            Strings::kStrConfigurationSettingWorkerThreadsBackgroundTaskThreadAffinityMask);
+
+        std::unique_lock lock(taskGuard);
+        while (true)
+        {
+          if (true == pendingTasks.empty())
+          {
+            taskAvailableSignal.wait(lock);
+            continue;
+          }
+
+          const uint64_t currentTimeMilliseconds = GetTickCount64();
+          const uint64_t nextDueTimeMilliseconds = pendingTasks.begin()->first;
+          if (currentTimeMilliseconds < nextDueTimeMilliseconds)
+          {
+            taskAvailableSignal.wait_for(
+                lock,
+                std::chrono::milliseconds(nextDueTimeMilliseconds - currentTimeMilliseconds));
+            continue;
+          }
+
+          SPendingTask dueTask = std::move(pendingTasks.begin()->second);
+          pendingTasks.erase(pendingTasks.begin());
+
+          lock.unlock();
+          const bool shouldRunAgain = dueTask.task();
+          lock.lock();
+
+          if (0 == dueTask.periodMilliseconds)
+          {
+            numOneShotTasksOutstanding -= 1;
+            if (0 == numOneShotTasksOutstanding) drainCompleteSignal.notify_all();
+          }
+          else if (true == shouldRunAgain)
+          {
+            pendingTasks.emplace(
+                GetTickCount64() + dueTask.periodMilliseconds, std::move(dueTask));
+          }
+        }
+      }
+
+      /// Number of worker threads in the pool. Deliberately small: background tasks are
+      /// latency-tolerant by definition, and the point of the shared pool is to bound Xidi's
+      /// total thread count.
+      static constexpr unsigned int kBackgroundTaskWorkerCount = 2;
+
+      /// Pending tasks, keyed and ordered by due time in milliseconds since system start.
+      std::multimap<uint64_t, SPendingTask> pendingTasks;
+
+      /// Mutex for protecting against concurrent accesses to the pending task collection and
+      /// the associated bookkeeping fields.
+      std::mutex taskGuard;
+
+      /// Signalled whenever a new task is submitted, waking a worker to re-evaluate its wait.
+      std::condition_variable taskAvailableSignal;
+
+      /// Signalled whenever the number of outstanding one-shot tasks reaches zero.
+      std::condition_variable drainCompleteSignal;
+
+      /// Whether or not the worker thread pool has been started.
+      bool workerThreadsStarted = false;
+
+      /// Number of one-shot tasks submitted but not yet run to completion.
+      unsigned int numOneShotTasksOutstanding = 0;
+    };
+
+    /// Retrieves the singleton background task scheduler object, creating it on first use. The
+    /// object is intentionally leaked because its detached worker threads may outlive static
+    /// destruction.
+    static BackgroundTaskScheduler& GetBackgroundTaskScheduler(void)
+    {
+      static BackgroundTaskScheduler* const backgroundTaskScheduler =
+          new BackgroundTaskScheduler;
+      return *backgroundTaskScheduler;
+    }
+
+    void SubmitBackgroundTask(TBackgroundTask task, unsigned int delayMilliseconds)
+    {
+      GetBackgroundTaskScheduler().Submit(
+          [taskToRun = std::move(task)]() -> bool
+          {
+            taskToRun();
+            return false;
+          },
+          delayMilliseconds,
+          0);
+    }
+
+    void SubmitPeriodicBackgroundTask(TPeriodicBackgroundTask task, unsigned int periodMilliseconds)
+    {
+      GetBackgroundTaskScheduler().Submit(std::move(task), periodMilliseconds, periodMilliseconds);
+    }
+
+    void DrainBackgroundTasks(void)
+    {
+      GetBackgroundTaskScheduler().Drain();
+    }
+
+    void ApplyWorkerThreadAttributes(
+        std::wstring_view prioritySettingName, std::wstring_view affinitySettingName)
+    {
+      const auto& workerThreadSettings = GetConfigurationData()[ApplicableConfigurationSection(
+          Strings::kStrConfigurationSectionWorkerThreads)];
+
+      const int64_t threadPriority = workerThreadSettings[prioritySettingName].ValueOr(0);
+      if (0 != threadPriority)
+      {
+        if (FALSE == SetThreadPriority(GetCurrentThread(), (int)threadPriority))
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Warning,
+              L"Failed to set priority %d for the worker thread configured by setting %.*s.",
+              (int)threadPriority,
+              (int)prioritySettingName.length(),
+              prioritySettingName.data());
+      }
+
+      const int64_t threadAffinityMask = workerThreadSettings[affinitySettingName].ValueOr(0);
+      if (0 != threadAffinityMask)
+      {
+        if (0 == SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)threadAffinityMask))
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Warning,
+              L"Failed to set affinity mask 0x%llx for the worker thread configured by setting %.*s.",
+              (unsigned long long)threadAffinityMask,
+              (int)affinitySettingName.length(),
+              affinitySettingName.data());
+      }
     }
 
     void Initialize(void)
     {
 #ifndef XIDI_SKIP_CONFIG
-      EnableLogIfConfigured();
-
-#ifndef XIDI_SKIP_MAPPERS
-      Controller::Mapper::DumpRegisteredMappers();
-#endif
+      initializationPipeline.Start();
 #endif
     }
   } // namespace Globals
@@ -36,7 +36,7 @@ namespace Xidi
     return xidiLibraryHandle;
   }
 
-  static Api::IImportFunctions2* GetImportFunctionsApi(void)
+  static Api::IImportFunctions3* GetImportFunctionsApi(void)
   {
     HMODULE xidiLibraryHandle = GetMainLibraryHandle();
     if (NULL == xidiLibraryHandle)
@@ -63,8 +63,8 @@ namespace Xidi
       return nullptr;
     }
 
-    Api::IImportFunctions2* xidiImportFunctions = reinterpret_cast<Xidi::Api::IImportFunctions2*>(
-        funcXidiApiGetInterface(Xidi::Api::EClass::ImportFunctions2));
+    Api::IImportFunctions3* xidiImportFunctions = reinterpret_cast<Xidi::Api::IImportFunctions3*>(
+        funcXidiApiGetInterface(Xidi::Api::EClass::ImportFunctions3));
     if (nullptr == xidiImportFunctions)
     {
       Infra::Message::OutputFormatted(
@@ -113,7 +113,7 @@ HOOKSHOT_HOOK_MODULE_ENTRY(hookshot)
               hookshot,
               Xidi::GetImportFunctionsApi(),
               Xidi::GetMainLibraryHandle(),
-              Xidi::Api::IImportFunctions2::ELibrary::DInput,
+              Xidi::Api::IImportFunctions3::ELibrary::DInput,
               L"DInput",
               modulePath,
               L"dinput_");
@@ -141,7 +141,7 @@ HOOKSHOT_HOOK_MODULE_ENTRY(hookshot)
               hookshot,
               Xidi::GetImportFunctionsApi(),
               Xidi::GetMainLibraryHandle(),
-              Xidi::Api::IImportFunctions2::ELibrary::DInput8,
+              Xidi::Api::IImportFunctions3::ELibrary::DInput8,
               L"DInput8",
               modulePath,
               L"dinput8_");
@@ -169,7 +169,7 @@ HOOKSHOT_HOOK_MODULE_ENTRY(hookshot)
               hookshot,
               Xidi::GetImportFunctionsApi(),
               Xidi::GetMainLibraryHandle(),
-              Xidi::Api::IImportFunctions2::ELibrary::WinMM,
+              Xidi::Api::IImportFunctions3::ELibrary::WinMM,
               L"WinMM",
               modulePath,
               L"winmm_");
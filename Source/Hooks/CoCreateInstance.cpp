@@ -96,6 +96,23 @@ namespace Xidi
 HRESULT StaticHook_CoCreateInstance::Hook(
     REFCLSID rclsid, LPUNKNOWN pUnkOuter, DWORD dwClsContext, REFIID riid, LPVOID* ppv)
 {
+  // Constant-time prefilter for the overwhelming majority of COM activations, which have nothing
+  // to do with DirectInput. All of the DirectInput class identifiers share the same first field
+  // except for the low bits: CLSID_DirectInput is {25E609E0-B259-11CF-BFC7-444553540000}, with
+  // DirectInputDevice, DirectInput8, and DirectInputDevice8 at 25E609E1, 25E609E4, and 25E609E5
+  // respectively. A single branchless masked comparison against that first field therefore
+  // rejects everything else in a couple of instructions, before any other work happens. The
+  // prefilter can only reject: anything that passes it still goes through the full CLSID
+  // comparisons below. The values are fixed COM ABI constants and can never change.
+  constexpr DWORD kDirectInputClsidData1Base = 0x25E609E0;
+  constexpr DWORD kDirectInputClsidData1VariantMask = 0x00000005;
+  if (kDirectInputClsidData1Base != (rclsid.Data1 & ~kDirectInputClsidData1VariantMask))
+    return Original(rclsid, pUnkOuter, dwClsContext, riid, ppv);
+
+  // A DirectInput class activation is one of the signs of activity that triggers the hook
+  // module's deferred initialization.
+  Xidi::EnsureHookModuleInitialized();
+
   static const HMODULE xidiLibraryHandle =
       LoadLibraryW(Xidi::Strings::GetXidiMainLibraryFilename().data());
   if (nullptr == xidiLibraryHandle)
@@ -0,0 +1,296 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file HotPathLogging.cpp
+ *   Implementation of deferred-formatting logging functionality for interface methods that sit on
+ *   the input hot path and are invoked by applications once or more per frame. Captured records
+ *   are handed off in batches to a single background writer thread, which performs all string
+ *   formatting and output, so calling threads never format messages or touch the log file.
+ **************************************************************************************************/
+
+#include "HotPathLogging.h"
+
+#include <malloc.h>
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+
+namespace Xidi
+{
+  namespace HotPathLogging
+  {
+    /// Number of invocation records each thread can buffer before a flush is forced. Sized so that
+    /// the buffer covers on the order of a second of per-frame invocations while keeping the
+    /// per-thread footprint small.
+    inline constexpr unsigned int kInvocationRecordCapacity = 64;
+
+    /// Enumerates the supported record layouts, which select the format string used when a record
+    /// is eventually formatted by the background writer.
+    enum class ERecordFormat : uint8_t
+    {
+      /// DirectInput interface method invocation on a virtual controller object.
+      DirectInputMethod,
+
+      /// WinMM joystick function invocation on a joystick device.
+      WinMMFunction,
+    };
+
+    /// Single captured invocation. All fields are fixed-size values that are trivially copied at
+    /// capture time. The method name is stored by pointer, which is safe because it is required to
+    /// have static storage duration.
+    struct SInvocationRecord
+    {
+      /// Severity with which the record is eventually output.
+      Infra::Message::ESeverity severity;
+
+      /// Record layout, which selects the format string used at output time.
+      ERecordFormat format;
+
+      /// Name of the invoked method or function.
+      const wchar_t* methodName;
+
+      /// Internal identifier of the invoked interface object, for DirectInput records only.
+      unsigned int objectId;
+
+      /// 1-based identifier of the associated virtual controller for DirectInput records, or the
+      /// identifier of the targeted joystick device for WinMM records.
+      unsigned int controllerIdentifier;
+
+      /// Result code returned to the application by the invocation.
+      HRESULT result;
+
+      /// System tick count at capture time, in milliseconds. Output with the record so that
+      /// deferral does not obscure when the invocation actually happened.
+      uint32_t captureTickCount;
+    };
+
+    /// Batch of invocation records handed off from a capturing thread to the background writer.
+    /// Batches circulate between a pending list, which holds filled batches awaiting output, and a
+    /// free list, which holds emptied batches available for reuse, both of which are lock-free
+    /// singly-linked lists.
+    struct SRecordBatch
+    {
+      /// Links this batch into either the pending list or the free list.
+      SLIST_ENTRY listEntry;
+
+      /// Number of records contained in this batch.
+      unsigned int numRecords;
+
+      /// Captured records, in capture order.
+      SInvocationRecord records[kInvocationRecordCapacity];
+    };
+
+    /// Per-thread buffer of captured invocation records, handed off to the background writer in
+    /// capture order once full. One buffer exists per thread so that capturing a record on the hot
+    /// path never contends on any synchronization object.
+    thread_local static SInvocationRecord invocationRecords[kInvocationRecordCapacity];
+
+    /// Number of records currently buffered on this thread.
+    thread_local static unsigned int numInvocationRecords = 0;
+
+    /// List of filled batches awaiting formatting and output by the background writer. Producers
+    /// push filled batches with a single interlocked operation, so handoff is lock-free.
+    static SLIST_HEADER pendingBatchList;
+
+    /// List of emptied batches available for reuse, so that a steady logging load settles into a
+    /// fixed set of batch allocations.
+    static SLIST_HEADER freeBatchList;
+
+    /// Auto-reset event signalled whenever a filled batch is pushed onto the pending list, used to
+    /// wake the background writer.
+    static HANDLE batchReadyEvent = NULL;
+
+    /// Formats and outputs the specified invocation records in order. Runs on the background
+    /// writer thread under normal operation, or on the capturing thread if the background writer
+    /// could not be created.
+    /// @param [in] records Array of records to output.
+    /// @param [in] numRecords Number of records in the array.
+    static void OutputRecords(const SInvocationRecord* records, unsigned int numRecords)
+    {
+      for (unsigned int i = 0; i < numRecords; ++i)
+      {
+        const SInvocationRecord& invocationRecord = records[i];
+
+        switch (invocationRecord.format)
+        {
+          case ERecordFormat::WinMMFunction:
+            Infra::Message::OutputFormatted(
+                invocationRecord.severity,
+                L"Invoked %s on device %u, result = %u, captured at %u ms.",
+                invocationRecord.methodName,
+                invocationRecord.controllerIdentifier,
+                (unsigned int)invocationRecord.result,
+                invocationRecord.captureTickCount);
+            break;
+
+          default:
+            Infra::Message::OutputFormatted(
+                invocationRecord.severity,
+                L"Invoked %s on interface object %u associated with Xidi virtual controller %u, result = 0x%08x, captured at %u ms.",
+                invocationRecord.methodName,
+                invocationRecord.objectId,
+                invocationRecord.controllerIdentifier,
+                invocationRecord.result,
+                invocationRecord.captureTickCount);
+            break;
+        }
+      }
+    }
+
+    /// Entry point for the background writer thread. Waits for filled batches to arrive on the
+    /// pending list, then formats and outputs their records and returns the emptied batches to
+    /// the free list. This thread is the only consumer of the pending list, so all formatting and
+    /// output is serialized here, away from the threads on which invocations are captured.
+    static void BackgroundWriterThread(void)
+    {
+      while (true)
+      {
+        WaitForSingleObject(batchReadyEvent, INFINITE);
+
+        PSLIST_ENTRY flushedBatchChain = InterlockedFlushSList(&pendingBatchList);
+        while (nullptr != flushedBatchChain)
+        {
+          // Flushing produces the chain in most-recently-pushed-first order, so it is reversed
+          // before output to restore approximate chronological order across threads. Records
+          // within each batch are already in capture order.
+          PSLIST_ENTRY reversedBatchChain = nullptr;
+          while (nullptr != flushedBatchChain)
+          {
+            PSLIST_ENTRY nextEntry = flushedBatchChain->Next;
+            flushedBatchChain->Next = reversedBatchChain;
+            reversedBatchChain = flushedBatchChain;
+            flushedBatchChain = nextEntry;
+          }
+
+          while (nullptr != reversedBatchChain)
+          {
+            SRecordBatch* const batch = (SRecordBatch*)reversedBatchChain;
+            reversedBatchChain = reversedBatchChain->Next;
+
+            OutputRecords(batch->records, batch->numRecords);
+            InterlockedPushEntrySList(&freeBatchList, &batch->listEntry);
+          }
+
+          flushedBatchChain = InterlockedFlushSList(&pendingBatchList);
+        }
+      }
+    }
+
+    /// Ensures the background writer thread and its associated data structures exist, creating
+    /// them on first invocation.
+    /// @return `true` if the background writer is available, `false` if it could not be created,
+    /// in which case records are formatted and output synchronously on the capturing thread.
+    static bool EnsureBackgroundWriter(void)
+    {
+      static bool backgroundWriterAvailable = false;
+      static std::once_flag backgroundWriterInitFlag;
+
+      std::call_once(
+          backgroundWriterInitFlag,
+          []() -> void
+          {
+            InitializeSListHead(&pendingBatchList);
+            InitializeSListHead(&freeBatchList);
+
+            batchReadyEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+            if (NULL == batchReadyEvent) return;
+
+            std::thread(BackgroundWriterThread).detach();
+            backgroundWriterAvailable = true;
+          });
+
+      return backgroundWriterAvailable;
+    }
+
+    /// Obtains an empty record batch, preferring reuse of a previously-emptied batch over a new
+    /// allocation. Batches are aligned as required for lock-free singly-linked list membership.
+    /// @return Empty batch, or `nullptr` if no batch could be obtained.
+    static SRecordBatch* AcquireEmptyBatch(void)
+    {
+      PSLIST_ENTRY reusableEntry = InterlockedPopEntrySList(&freeBatchList);
+      if (nullptr != reusableEntry) return (SRecordBatch*)reusableEntry;
+
+      return (SRecordBatch*)_aligned_malloc(sizeof(SRecordBatch), MEMORY_ALLOCATION_ALIGNMENT);
+    }
+
+    /// Appends a record to the calling thread's buffer, forcing a flush once the buffer is full.
+    /// @param [in] invocationRecord Record to append.
+    static inline void AppendRecord(const SInvocationRecord& invocationRecord)
+    {
+      invocationRecords[numInvocationRecords] = invocationRecord;
+      numInvocationRecords += 1;
+
+      if (kInvocationRecordCapacity == numInvocationRecords) FlushThread();
+    }
+
+    void RecordInvocation(
+        Infra::Message::ESeverity severity,
+        const wchar_t* methodName,
+        unsigned int objectId,
+        unsigned int controllerIdentifier,
+        HRESULT result)
+    {
+      AppendRecord(
+          {.severity = severity,
+           .format = ERecordFormat::DirectInputMethod,
+           .methodName = methodName,
+           .objectId = objectId,
+           .controllerIdentifier = controllerIdentifier,
+           .result = result,
+           .captureTickCount = (uint32_t)GetTickCount()});
+    }
+
+    void RecordWinMMInvocation(
+        Infra::Message::ESeverity severity,
+        const wchar_t* functionName,
+        unsigned int deviceId,
+        unsigned int result)
+    {
+      AppendRecord(
+          {.severity = severity,
+           .format = ERecordFormat::WinMMFunction,
+           .methodName = functionName,
+           .objectId = 0,
+           .controllerIdentifier = deviceId,
+           .result = (HRESULT)result,
+           .captureTickCount = (uint32_t)GetTickCount()});
+    }
+
+    void FlushThread(void)
+    {
+      if (0 == numInvocationRecords) return;
+
+      if (true == EnsureBackgroundWriter())
+      {
+        SRecordBatch* const batch = AcquireEmptyBatch();
+        if (nullptr != batch)
+        {
+          std::memcpy(
+              batch->records,
+              invocationRecords,
+              sizeof(SInvocationRecord) * numInvocationRecords);
+          batch->numRecords = numInvocationRecords;
+          numInvocationRecords = 0;
+
+          InterlockedPushEntrySList(&pendingBatchList, &batch->listEntry);
+          SetEvent(batchReadyEvent);
+          return;
+        }
+      }
+
+      // Fallback path, used only if the background writer or a batch is unavailable.
+      OutputRecords(invocationRecords, numInvocationRecords);
+      numInvocationRecords = 0;
+    }
+  } // namespace HotPathLogging
+} // namespace Xidi
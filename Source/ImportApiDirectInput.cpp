@@ -13,7 +13,6 @@
 #include "ImportApiDirectInput.h"
 
 #include <exception>
-#include <mutex>
 #include <string_view>
 #include <unordered_map>
 
@@ -22,6 +21,7 @@
 #include <Infra/Core/ProcessInfo.h>
 
 #include "ApiDirectInput.h"
+#include "Diagnostics.h"
 #include "DllFunctions.h"
 #include "Globals.h"
 #include "Strings.h"
@@ -30,16 +30,11 @@
 #define IMPORT_TABLE_INDEX_OF(importTable, name)                                                   \
   (offsetof(decltype(importTable), named.##name) / sizeof(decltype(importTable)::ptr[0]))
 
-/// Attempts to import a single function and save it into the import table.
-#define TRY_IMPORT(importTable, libraryPath, libraryHandle, functionName)                          \
-  if (nullptr == importTable.ptr[IMPORT_TABLE_INDEX_OF(importTable, functionName)])                \
-  {                                                                                                \
-    DllFunctions::TryImport(                                                                       \
-        libraryPath,                                                                               \
-        loadedLibrary,                                                                             \
-        #functionName,                                                                             \
-        &importTable.ptr[IMPORT_TABLE_INDEX_OF(importTable, functionName)]);                       \
-  }
+/// Resolves a single imported function on first use. Does nothing if the function has already been
+/// resolved or replaced.
+#define RESOLVE_IMPORT_IF_NEEDED(importTable, resolveImportFunction, functionName)                 \
+  if (nullptr == importTable.named.functionName)                                                   \
+  resolveImportFunction(IMPORT_TABLE_INDEX_OF(importTable, functionName), #functionName)
 
 namespace Xidi
 {
@@ -150,17 +145,6 @@ namespace Xidi
       }
     };
 
-    /// Logs a debug event related to attempting to load the system-provided library for importing
-    /// functions.
-    /// @param [in] libraryPath Path of the library that was loaded.
-    static void LogInitializeLibraryPath(LPCWSTR libraryPath)
-    {
-      Infra::Message::OutputFormatted(
-          Infra::Message::ESeverity::Debug,
-          L"Attempting to import DirectInput functions from %s.",
-          libraryPath);
-    }
-
     /// Logs an error event related to failure to initialize the import table because the import
     /// library could not be loaded.
     /// @param [in] libraryPath Path of the library that was loaded.
@@ -172,71 +156,105 @@ namespace Xidi
           libraryPath);
     }
 
-    /// Dynamically loads the DirectInput 8 and sets up all imported function calls.
-    static void InitializeVersion8(void)
+    /// Dynamically loads the DirectInput 8 library on first use and returns its handle on all
+    /// subsequent uses.
+    /// @return Handle of the loaded library, or `nullptr` if it could not be loaded.
+    static HMODULE LoadImportLibraryVersion8(void)
+    {
+      static const HMODULE loadedLibrary = []() -> HMODULE
+      {
+        std::wstring_view libraryPath = Strings::GetSystemLibraryFilenameDirectInput8();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Debug,
+            L"Attempting to import DirectInput 8 functions from %s.",
+            libraryPath.data());
+
+        HMODULE importLibrary = LoadLibraryEx(libraryPath.data(), nullptr, 0);
+        if (nullptr == importLibrary) LogInitializeFailed(libraryPath.data());
+
+        Diagnostics::RecordImportResolution(
+            Diagnostics::EImportModule::DirectInput, (nullptr != importLibrary));
+        return importLibrary;
+      }();
+
+      return loadedLibrary;
+    }
+
+    /// Dynamically loads the DirectInput legacy library on first use and returns its handle on
+    /// all subsequent uses.
+    /// @return Handle of the loaded library, or `nullptr` if it could not be loaded.
+    static HMODULE LoadImportLibraryVersionLegacy(void)
     {
-      static std::once_flag initializeFlag;
-      std::call_once(
-          initializeFlag,
-          []() -> void
-          {
-            std::wstring_view libraryPath = Strings::GetSystemLibraryFilenameDirectInput8();
-            Infra::Message::OutputFormatted(
-                Infra::Message::ESeverity::Debug,
-                L"Attempting to import DirectInput 8 functions from %s.",
-                libraryPath.data());
-
-            HMODULE loadedLibrary = LoadLibraryEx(libraryPath.data(), nullptr, 0);
-            if (nullptr == loadedLibrary)
-            {
-              LogInitializeFailed(libraryPath.data());
-              return;
-            }
-
-            TRY_IMPORT(importTableVersion8, libraryPath, loadedLibrary, DirectInput8Create);
-            TRY_IMPORT(importTableVersion8, libraryPath, loadedLibrary, DllRegisterServer);
-            TRY_IMPORT(importTableVersion8, libraryPath, loadedLibrary, DllUnregisterServer);
-            TRY_IMPORT(importTableVersion8, libraryPath, loadedLibrary, DllCanUnloadNow);
-            TRY_IMPORT(importTableVersion8, libraryPath, loadedLibrary, DllGetClassObject);
-
-            Infra::Message::Output(
-                Infra::Message::ESeverity::Info, L"Finished importing DirectInput 8 functions.");
-          });
+      static const HMODULE loadedLibrary = []() -> HMODULE
+      {
+        std::wstring_view libraryPath = Strings::GetSystemLibraryFilenameDirectInput();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Debug,
+            L"Attempting to import DirectInput legacy functions from %s.",
+            libraryPath.data());
+
+        HMODULE importLibrary = LoadLibraryEx(libraryPath.data(), nullptr, 0);
+        if (nullptr == importLibrary) LogInitializeFailed(libraryPath.data());
+
+        Diagnostics::RecordImportResolution(
+            Diagnostics::EImportModule::DirectInput, (nullptr != importLibrary));
+        return importLibrary;
+      }();
+
+      return loadedLibrary;
+    }
+
+    /// Resolves a single function imported from the native DirectInput 8 library and atomically
+    /// publishes its address into the import table. Invoked on the first call to each imported
+    /// function, so only the functions an application actually uses are ever resolved, and no
+    /// full sweep over the export surface sits on the startup critical path. Benign if invoked
+    /// concurrently, because all contending resolutions produce the same address, and a
+    /// replacement already published via the import table interface is never overwritten.
+    /// @param [in] importTableIndex Index of the function in the import table pointer array.
+    /// @param [in] functionName Name of the function to resolve.
+    static void ResolveImportVersion8(size_t importTableIndex, const char* functionName)
+    {
+      HMODULE loadedLibrary = LoadImportLibraryVersion8();
+      if (nullptr == loadedLibrary) return;
+
+      const void* importedFunction = nullptr;
+      if (false ==
+          DllFunctions::TryImport(
+              Strings::GetSystemLibraryFilenameDirectInput8(),
+              loadedLibrary,
+              functionName,
+              &importedFunction))
+        return;
+
+      InterlockedCompareExchangePointer(
+          (volatile PVOID*)&importTableVersion8.ptr[importTableIndex],
+          (PVOID)importedFunction,
+          nullptr);
     }
 
-    /// Dynamically loads the DirectInput 8 and sets up all imported function calls.
-    static void InitializeVersionLegacy(void)
+    /// Resolves a single function imported from the native DirectInput legacy library and
+    /// atomically publishes its address into the import table. Refer to #ResolveImportVersion8
+    /// for more information on resolution semantics.
+    /// @param [in] importTableIndex Index of the function in the import table pointer array.
+    /// @param [in] functionName Name of the function to resolve.
+    static void ResolveImportVersionLegacy(size_t importTableIndex, const char* functionName)
     {
-      static std::once_flag initializeFlag;
-      std::call_once(
-          initializeFlag,
-          []() -> void
-          {
-            std::wstring_view libraryPath = Strings::GetSystemLibraryFilenameDirectInput();
-            Infra::Message::OutputFormatted(
-                Infra::Message::ESeverity::Debug,
-                L"Attempting to import DirectInput legacy functions from %s.",
-                libraryPath.data());
-
-            HMODULE loadedLibrary = LoadLibraryEx(libraryPath.data(), nullptr, 0);
-            if (nullptr == loadedLibrary)
-            {
-              LogInitializeFailed(libraryPath.data());
-              return;
-            }
-
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DirectInputCreateA);
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DirectInputCreateW);
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DirectInputCreateEx);
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DllRegisterServer);
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DllUnregisterServer);
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DllCanUnloadNow);
-            TRY_IMPORT(importTableVersionLegacy, libraryPath, loadedLibrary, DllGetClassObject);
-
-            Infra::Message::Output(
-                Infra::Message::ESeverity::Info,
-                L"Finished importing DirectInput legacy functions.");
-          });
+      HMODULE loadedLibrary = LoadImportLibraryVersionLegacy();
+      if (nullptr == loadedLibrary) return;
+
+      const void* importedFunction = nullptr;
+      if (false ==
+          DllFunctions::TryImport(
+              Strings::GetSystemLibraryFilenameDirectInput(),
+              loadedLibrary,
+              functionName,
+              &importedFunction))
+        return;
+
+      InterlockedCompareExchangePointer(
+          (volatile PVOID*)&importTableVersionLegacy.ptr[importTableIndex],
+          (PVOID)importedFunction,
+          nullptr);
     }
 
     namespace Version8
@@ -247,35 +265,40 @@ namespace Xidi
         return &mutableImportTableDInput8;
       }
 
+      void PreloadImportLibrary(void)
+      {
+        LoadImportLibraryVersion8();
+      }
+
       HRESULT DirectInput8Create(
           HINSTANCE hinst, DWORD dwVersion, REFIID riidltf, LPVOID* ppvOut, LPUNKNOWN punkOuter)
       {
-        if (nullptr == importTableVersion8.named.DirectInput8Create) InitializeVersion8();
+        RESOLVE_IMPORT_IF_NEEDED(importTableVersion8, ResolveImportVersion8, DirectInput8Create);
         return importTableVersion8.named.DirectInput8Create(
             hinst, dwVersion, riidltf, ppvOut, punkOuter);
       }
 
       HRESULT DllRegisterServer(void)
       {
-        if (nullptr == importTableVersion8.named.DllRegisterServer) InitializeVersion8();
+        RESOLVE_IMPORT_IF_NEEDED(importTableVersion8, ResolveImportVersion8, DllRegisterServer);
         return importTableVersion8.named.DllRegisterServer();
       }
 
       HRESULT DllUnregisterServer(void)
       {
-        if (nullptr == importTableVersion8.named.DllUnregisterServer) InitializeVersion8();
+        RESOLVE_IMPORT_IF_NEEDED(importTableVersion8, ResolveImportVersion8, DllUnregisterServer);
         return importTableVersion8.named.DllUnregisterServer();
       }
 
       HRESULT DllCanUnloadNow(void)
       {
-        if (nullptr == importTableVersion8.named.DllCanUnloadNow) InitializeVersion8();
+        RESOLVE_IMPORT_IF_NEEDED(importTableVersion8, ResolveImportVersion8, DllCanUnloadNow);
         return importTableVersion8.named.DllCanUnloadNow();
       }
 
       HRESULT DllGetClassObject(REFCLSID rclsid, REFIID riid, LPVOID* ppv)
       {
-        if (nullptr == importTableVersion8.named.DllGetClassObject) InitializeVersion8();
+        RESOLVE_IMPORT_IF_NEEDED(importTableVersion8, ResolveImportVersion8, DllGetClassObject);
         return importTableVersion8.named.DllGetClassObject(rclsid, riid, ppv);
       }
     } // namespace Version8
@@ -288,51 +311,61 @@ namespace Xidi
         return &mutableImportTableDInput;
       }
 
+      void PreloadImportLibrary(void)
+      {
+        LoadImportLibraryVersionLegacy();
+      }
+
       HRESULT DirectInputCreateA(
           HINSTANCE hinst, DWORD dwVersion, LPDIRECTINPUTA* ppDI, LPUNKNOWN punkOuter)
       {
-        if (nullptr == importTableVersionLegacy.named.DirectInputCreateA) InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DirectInputCreateA);
         return importTableVersionLegacy.named.DirectInputCreateA(hinst, dwVersion, ppDI, punkOuter);
       }
 
       HRESULT DirectInputCreateW(
           HINSTANCE hinst, DWORD dwVersion, LPDIRECTINPUTW* ppDI, LPUNKNOWN punkOuter)
       {
-        if (nullptr == importTableVersionLegacy.named.DirectInputCreateW) InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DirectInputCreateW);
         return importTableVersionLegacy.named.DirectInputCreateW(hinst, dwVersion, ppDI, punkOuter);
       }
 
       HRESULT DirectInputCreateEx(
           HINSTANCE hinst, DWORD dwVersion, REFIID riidltf, LPVOID* ppvOut, LPUNKNOWN punkOuter)
       {
-        if (nullptr == importTableVersionLegacy.named.DirectInputCreateEx)
-          InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DirectInputCreateEx);
         return importTableVersionLegacy.named.DirectInputCreateEx(
             hinst, dwVersion, riidltf, ppvOut, punkOuter);
       }
 
       HRESULT DllRegisterServer(void)
       {
-        if (nullptr == importTableVersionLegacy.named.DllRegisterServer) InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DllRegisterServer);
         return importTableVersionLegacy.named.DllRegisterServer();
       }
 
       HRESULT DllUnregisterServer(void)
       {
-        if (nullptr == importTableVersionLegacy.named.DllUnregisterServer)
-          InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DllUnregisterServer);
         return importTableVersionLegacy.named.DllUnregisterServer();
       }
 
       HRESULT DllCanUnloadNow(void)
       {
-        if (nullptr == importTableVersionLegacy.named.DllCanUnloadNow) InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DllCanUnloadNow);
         return importTableVersionLegacy.named.DllCanUnloadNow();
       }
 
       HRESULT DllGetClassObject(REFCLSID rclsid, REFIID riid, LPVOID* ppv)
       {
-        if (nullptr == importTableVersionLegacy.named.DllGetClassObject) InitializeVersionLegacy();
+        RESOLVE_IMPORT_IF_NEEDED(
+            importTableVersionLegacy, ResolveImportVersionLegacy, DllGetClassObject);
         return importTableVersionLegacy.named.DllGetClassObject(rclsid, riid, ppv);
       }
     } // namespace VersionLegacy
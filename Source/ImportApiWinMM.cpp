@@ -12,8 +12,6 @@
 
 #include "ImportApiWinMM.h"
 
-#include <mutex>
-#include <set>
 #include <string_view>
 #include <unordered_map>
 
@@ -23,6 +21,7 @@
 
 #include "ApiWindows.h"
 #include "ApiXidi.h"
+#include "Diagnostics.h"
 #include "DllFunctions.h"
 #include "Globals.h"
 #include "Strings.h"
@@ -31,16 +30,11 @@
 #define IMPORT_TABLE_INDEX_OF(name)                                                                \
   (offsetof(UImportTable, named.##name) / sizeof(UImportTable::ptr[0]))
 
-/// Attempts to import a single function and save it into the import table.
-#define TRY_IMPORT(libraryPath, libraryHandle, functionName)                                       \
-  if (nullptr == importTable.ptr[IMPORT_TABLE_INDEX_OF(functionName)])                             \
-  {                                                                                                \
-    DllFunctions::TryImport(                                                                       \
-        libraryPath,                                                                               \
-        loadedLibrary,                                                                             \
-        #functionName,                                                                             \
-        &importTable.ptr[IMPORT_TABLE_INDEX_OF(functionName)]);                                    \
-  }
+/// Resolves a single imported function on first use. Does nothing if the function has already been
+/// resolved or replaced.
+#define RESOLVE_IMPORT_IF_NEEDED(functionName)                                                     \
+  if (nullptr == importTable.named.functionName)                                                   \
+  ResolveImport(IMPORT_TABLE_INDEX_OF(functionName), #functionName)
 
 namespace Xidi
 {
@@ -115,126 +109,139 @@ namespace Xidi
       return &mutableImportTableWinMM;
     }
 
-    /// Dynamically loads the WinMM library and sets up all imported function calls.
-    static void Initialize(void)
-    {
-      static std::once_flag initializeFlag;
-
-      std::call_once(
-          initializeFlag,
-          []() -> void
-          {
-            std::wstring_view libraryPath = Strings::GetSystemLibraryFilenameWinMM();
-            Infra::Message::OutputFormatted(
-                Infra::Message::ESeverity::Debug,
-                L"Attempting to import WinMM functions from %s.",
-                libraryPath.data());
-
-            HMODULE loadedLibrary = LoadLibraryEx(libraryPath.data(), nullptr, 0);
-            if (nullptr == loadedLibrary)
-            {
-              Infra::Message::Output(
-                  Infra::Message::ESeverity::Error,
-                  L"Failed to initialize imported WinMM functions.");
-              return;
-            }
-
-            TRY_IMPORT(libraryPath, loadedLibrary, joyConfigChanged);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyGetDevCapsA);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyGetDevCapsW);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyGetNumDevs);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyGetPos);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyGetPosEx);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyGetThreshold);
-            TRY_IMPORT(libraryPath, loadedLibrary, joyReleaseCapture);
-            TRY_IMPORT(libraryPath, loadedLibrary, joySetCapture);
-            TRY_IMPORT(libraryPath, loadedLibrary, joySetThreshold);
-            TRY_IMPORT(libraryPath, loadedLibrary, timeBeginPeriod);
-            TRY_IMPORT(libraryPath, loadedLibrary, timeGetDevCaps);
-            TRY_IMPORT(libraryPath, loadedLibrary, timeGetTime);
-
-            // Initialization complete.
-            Infra::Message::OutputFormatted(
-                Infra::Message::ESeverity::Info,
-                L"Successfully initialized imported WinMM functions.");
-          });
+    /// Dynamically loads the WinMM library on first use and returns its handle on all subsequent
+    /// uses.
+    /// @return Handle of the loaded library, or `nullptr` if it could not be loaded.
+    static HMODULE LoadImportLibrary(void)
+    {
+      static const HMODULE loadedLibrary = []() -> HMODULE
+      {
+        std::wstring_view libraryPath = Strings::GetSystemLibraryFilenameWinMM();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Debug,
+            L"Attempting to import WinMM functions from %s.",
+            libraryPath.data());
+
+        HMODULE importLibrary = LoadLibraryEx(libraryPath.data(), nullptr, 0);
+        if (nullptr == importLibrary)
+          Infra::Message::Output(
+              Infra::Message::ESeverity::Error,
+              L"Failed to initialize imported WinMM functions.");
+
+        Diagnostics::RecordImportResolution(
+            Diagnostics::EImportModule::WinMM, (nullptr != importLibrary));
+        return importLibrary;
+      }();
+
+      return loadedLibrary;
+    }
+
+    /// Resolves a single function imported from the native WinMM library and atomically publishes
+    /// its address into the import table. Invoked on the first call to each imported function, so
+    /// only the functions an application actually uses are ever resolved, and no full sweep over
+    /// the export surface sits on the startup critical path. Benign if invoked concurrently,
+    /// because all contending resolutions produce the same address, and a replacement already
+    /// published via the import table interface is never overwritten.
+    /// @param [in] importTableIndex Index of the function in the import table pointer array.
+    /// @param [in] functionName Name of the function to resolve.
+    static void ResolveImport(size_t importTableIndex, const char* functionName)
+    {
+      HMODULE loadedLibrary = LoadImportLibrary();
+      if (nullptr == loadedLibrary) return;
+
+      const void* importedFunction = nullptr;
+      if (false ==
+          DllFunctions::TryImport(
+              Strings::GetSystemLibraryFilenameWinMM(),
+              loadedLibrary,
+              functionName,
+              &importedFunction))
+        return;
+
+      InterlockedCompareExchangePointer(
+          (volatile PVOID*)&importTable.ptr[importTableIndex], (PVOID)importedFunction, nullptr);
+    }
+
+    void PreloadImportLibrary(void)
+    {
+      LoadImportLibrary();
     }
 
     MMRESULT joyConfigChanged(DWORD dwFlags)
     {
-      if (nullptr == importTable.named.joyConfigChanged) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyConfigChanged);
       return importTable.named.joyConfigChanged(dwFlags);
     }
 
     MMRESULT joyGetDevCapsA(UINT_PTR uJoyID, LPJOYCAPSA pjc, UINT cbjc)
     {
-      if (nullptr == importTable.named.joyGetDevCapsA) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyGetDevCapsA);
       return importTable.named.joyGetDevCapsA(uJoyID, pjc, cbjc);
     }
 
     MMRESULT joyGetDevCapsW(UINT_PTR uJoyID, LPJOYCAPSW pjc, UINT cbjc)
     {
-      if (nullptr == importTable.named.joyGetDevCapsW) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyGetDevCapsW);
       return importTable.named.joyGetDevCapsW(uJoyID, pjc, cbjc);
     }
 
     UINT joyGetNumDevs(void)
     {
-      if (nullptr == importTable.named.joyGetNumDevs) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyGetNumDevs);
       return importTable.named.joyGetNumDevs();
     }
 
     MMRESULT joyGetPos(UINT uJoyID, LPJOYINFO pji)
     {
-      if (nullptr == importTable.named.joyGetPos) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyGetPos);
       return importTable.named.joyGetPos(uJoyID, pji);
     }
 
     MMRESULT joyGetPosEx(UINT uJoyID, LPJOYINFOEX pji)
     {
-      if (nullptr == importTable.named.joyGetPosEx) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyGetPosEx);
       return importTable.named.joyGetPosEx(uJoyID, pji);
     }
 
     MMRESULT joyGetThreshold(UINT uJoyID, LPUINT puThreshold)
     {
-      if (nullptr == importTable.named.joyGetThreshold) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyGetThreshold);
       return importTable.named.joyGetThreshold(uJoyID, puThreshold);
     }
 
     MMRESULT joyReleaseCapture(UINT uJoyID)
     {
-      if (nullptr == importTable.named.joyReleaseCapture) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joyReleaseCapture);
       return importTable.named.joyReleaseCapture(uJoyID);
     }
 
     MMRESULT joySetCapture(HWND hwnd, UINT uJoyID, UINT uPeriod, BOOL fChanged)
     {
-      if (nullptr == importTable.named.joySetCapture) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joySetCapture);
       return importTable.named.joySetCapture(hwnd, uJoyID, uPeriod, fChanged);
     }
 
     MMRESULT joySetThreshold(UINT uJoyID, UINT uThreshold)
     {
-      if (nullptr == importTable.named.joySetThreshold) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(joySetThreshold);
       return importTable.named.joySetThreshold(uJoyID, uThreshold);
     }
 
     MMRESULT timeBeginPeriod(UINT uPeriod)
     {
-      if (nullptr == importTable.named.timeBeginPeriod) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(timeBeginPeriod);
       return importTable.named.timeBeginPeriod(uPeriod);
     }
 
     MMRESULT timeGetDevCaps(LPTIMECAPS ptc, UINT cbtc)
     {
-      if (nullptr == importTable.named.timeGetDevCaps) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(timeGetDevCaps);
       return importTable.named.timeGetDevCaps(ptc, cbtc);
     }
 
     DWORD timeGetTime(void)
     {
-      if (nullptr == importTable.named.timeGetTime) Initialize();
+      RESOLVE_IMPORT_IF_NEEDED(timeGetTime);
       return importTable.named.timeGetTime();
     }
   } // namespace ImportApiWinMM
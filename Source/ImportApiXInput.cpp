@@ -19,6 +19,7 @@
 #include <Infra/Core/ProcessInfo.h>
 
 #include "ApiWindows.h"
+#include "Diagnostics.h"
 #include "DllFunctions.h"
 
 /// Computes the index of the specified named function in the pointer array of the import table.
@@ -61,6 +62,17 @@ namespace Xidi
     /// Holds the imported WinMM API function addresses.
     static UImportTable importTable;
 
+    /// Export ordinal of the extended state-reading function, commonly known as
+    /// "XInputGetStateEx". Newer XInput libraries export it by ordinal only, and it is absent
+    /// from the XInput headers because it is not documented.
+    static constexpr WORD kXInputGetStateExOrdinal = 100;
+
+    /// Address of the extended state-reading function resolved from the loaded XInput library,
+    /// or `nullptr` if the loaded library does not export it. The extended function has the same
+    /// signature as the documented state-reading function but additionally reports the state of
+    /// the Guide button.
+    static TXInputGetStateFunc xinputGetStateExFunc = nullptr;
+
     /// Shows an error and terminates the process in the event of failure to import a particular
     /// function from the import library.
     /// @param [in] libraryName Name of the library from which the import is being attempted.
@@ -79,6 +91,7 @@ namespace Xidi
     /// library.
     static void TerminateProcessBecauseNoXInputLibraryLoaded(void)
     {
+      Diagnostics::RecordImportResolution(Diagnostics::EImportModule::XInput, false);
       Infra::Message::Output(
           Infra::Message::ESeverity::ForcedInteractiveError,
           L"Failed to load an XInput library.\n\nXidi cannot function without it.");
@@ -102,8 +115,9 @@ namespace Xidi
 
             for (const auto& xinputLibraryName : kXInputLibraryNamesOrdered)
             {
-              // Initialize the import table.
+              // Initialize the import table and the optional extended function address.
               ZeroMemory(&importTable, sizeof(importTable));
+              xinputGetStateExFunc = nullptr;
 
               Infra::Message::OutputFormatted(
                   Infra::Message::ESeverity::Info,
@@ -125,10 +139,22 @@ namespace Xidi
               IMPORT_OR_TERMINATE(xinputLibraryName, loadedLibrary, XInputGetState);
               IMPORT_OR_TERMINATE(xinputLibraryName, loadedLibrary, XInputSetState);
 
+              // Attempt to obtain the address of the extended state-reading function, which is
+              // optional, so failure to locate it is not an error.
+              xinputGetStateExFunc = (TXInputGetStateFunc)GetProcAddress(
+                  loadedLibrary, MAKEINTRESOURCEA(kXInputGetStateExOrdinal));
+              if (nullptr != xinputGetStateExFunc)
+                Infra::Message::OutputFormatted(
+                    Infra::Message::ESeverity::Info,
+                    L"Located the extended state-reading function at ordinal %u in %s. Guide button state is available.",
+                    (unsigned int)kXInputGetStateExOrdinal,
+                    xinputLibraryName);
+
               // Initialization complete.
               Infra::Message::OutputFormatted(
                   Infra::Message::ESeverity::Info,
                   L"Successfully initialized imported XInput functions.");
+              Diagnostics::RecordImportResolution(Diagnostics::EImportModule::XInput, true);
               return;
             }
 
@@ -136,6 +162,16 @@ namespace Xidi
           });
     }
 
+    SXInputStateReader GetXInputStateReader(void)
+    {
+      Initialize();
+
+      if (nullptr != xinputGetStateExFunc)
+        return {.getStateFunc = xinputGetStateExFunc, .reportsGuideButton = true};
+
+      return {.getStateFunc = importTable.named.XInputGetState, .reportsGuideButton = false};
+    }
+
     DWORD XInputGetState(DWORD dwUserIndex, XINPUT_STATE* pState)
     {
       if (nullptr == importTable.named.XInputGetState) Initialize();
@@ -0,0 +1,557 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file InputDispatch.cpp
+ *   Implementation of the shared input synthesis dispatcher, which gathers pending keyboard and
+ *   mouse events and submits them to the system in combined batches.
+ **************************************************************************************************/
+
+#include "InputDispatch.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+#include "ApiXidi.h"
+#include "CpuBudget.h"
+#include "Diagnostics.h"
+#include "Globals.h"
+#include "Keyboard.h"
+#include "Mouse.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace InputDispatch
+  {
+    /// Number of milliseconds to wait between input dispatch cycles while any continuous or held
+    /// input state requires periodic synthesis. The mouse movement unit-to-pixel conversion
+    /// assumes one movement event per mouse update period, so the dispatch period must match it.
+    /// The keyboard update period only bounds how quickly a loss of input focus is noticed, so
+    /// cycling faster than it is harmless.
+    inline constexpr unsigned int kDispatchPeriodMilliseconds = Mouse::kMouseUpdatePeriodMilliseconds;
+
+    static_assert(
+        kDispatchPeriodMilliseconds <= Keyboard::kKeyboardUpdatePeriodMilliseconds,
+        "Input dispatch period must not exceed the keyboard update period.");
+
+    /// Cumulative synthesis statistics counters, maintained with relaxed atomic operations and
+    /// exposed through the ISynthesisStatistics API class.
+    static std::atomic<uint64_t> statContributionsReceived;
+    static std::atomic<uint64_t> statContributionsCoalesced;
+    static std::atomic<uint64_t> statEventsEmitted;
+    static std::atomic<uint64_t> statEventsDropped;
+    static std::atomic<uint64_t> statDispatchCycles;
+    static std::atomic<uint64_t> statInjectionLatencyHistogram
+        [Api::ISynthesisStatistics::kLatencyHistogramBucketCount];
+
+    /// QueryPerformanceCounter timestamp of the oldest discrete contribution that has not yet
+    /// been delivered, or 0 if no such contribution is pending. Stamped by #WakeDispatchThread
+    /// and consumed by the dispatch thread to produce injection latency samples.
+    static std::atomic<int64_t> pendingContributionTimestamp;
+
+    /// Adds a sample to the injection latency histogram.
+    /// @param [in] latencyMicroseconds Measured latency, in microseconds, from contribution to
+    /// completed injection.
+    static void RecordInjectionLatencySample(uint64_t latencyMicroseconds)
+    {
+      for (unsigned int bucket = 0;
+           bucket < Api::ISynthesisStatistics::kLatencyHistogramBucketCount;
+           ++bucket)
+      {
+        if (latencyMicroseconds <=
+            Api::ISynthesisStatistics::kLatencyHistogramBucketUpperBoundsMicroseconds[bucket])
+        {
+          statInjectionLatencyHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+
+    /// Enumerates the backends available for delivering synthesized input events to the system.
+    enum class ESynthesisBackend
+    {
+      /// Standard system input queue, via the `SendInput` API. Visible to all input APIs but
+      /// serialized against the foreground thread's message queue.
+      SendInput,
+
+      /// Window messages posted directly to the foreground window whenever it belongs to the
+      /// current process, bypassing system input queue serialization. Invisible to raw input
+      /// APIs, so this is an opt-in for games known to read input from window messages.
+      PostMessage
+    };
+
+    /// Retrieves the synthesis backend selected in the configuration file.
+    /// @return Configured synthesis backend, defaulting to the standard system input queue
+    /// backend if the configuration file does not specify otherwise.
+    static ESynthesisBackend GetConfiguredSynthesisBackend(void)
+    {
+      static const ESynthesisBackend configuredSynthesisBackend = []() -> ESynthesisBackend
+      {
+        const auto& configData = Globals::GetConfigurationData();
+        const std::wstring_view propertiesSectionName =
+            Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionProperties);
+
+        if (true == configData.Contains(propertiesSectionName))
+        {
+          const auto& propertiesConfigData = configData[propertiesSectionName];
+
+          if (true ==
+              propertiesConfigData.Contains(
+                  Strings::kStrConfigurationSettingPropertiesSynthesisBackend))
+          {
+            std::wstring_view synthesisBackendName =
+                propertiesConfigData[Strings::kStrConfigurationSettingPropertiesSynthesisBackend]
+                    ->GetString();
+
+            if (L"SendInput" == synthesisBackendName) return ESynthesisBackend::SendInput;
+            if (L"PostMessage" == synthesisBackendName) return ESynthesisBackend::PostMessage;
+
+            Infra::Message::OutputFormatted(
+                Infra::Message::ESeverity::Warning,
+                L"Unrecognized synthesis backend \"%s\" specified in the configuration file. Defaulting to the SendInput backend.",
+                synthesisBackendName.data());
+          }
+        }
+
+        return ESynthesisBackend::SendInput;
+      }();
+
+      return configuredSynthesisBackend;
+    }
+
+    /// Determines the window to which synthesized input events can be posted directly.
+    /// @return Handle of the foreground window if it belongs to the current process, or `NULL`
+    /// otherwise, in which case direct posting is not possible.
+    static HWND SynthesisTargetWindow(void)
+    {
+      const HWND foregroundWindow = GetForegroundWindow();
+      if (NULL == foregroundWindow) return NULL;
+
+      DWORD foregroundWindowProcessId = 0;
+      GetWindowThreadProcessId(foregroundWindow, &foregroundWindowProcessId);
+      if (GetCurrentProcessId() != foregroundWindowProcessId) return NULL;
+
+      return foregroundWindow;
+    }
+
+    /// Posts a window message and reports the outcome as a delivery count, for use when
+    /// tallying how many events in a batch were successfully delivered.
+    /// @param [in] targetWindow Window to which the message is posted.
+    /// @param [in] message Message identifier.
+    /// @param [in] wParam First message parameter.
+    /// @param [in] lParam Second message parameter.
+    /// @return 1 if the message was posted successfully, 0 otherwise.
+    static inline unsigned int PostMessageCounted(
+        HWND targetWindow, UINT message, WPARAM wParam, LPARAM lParam)
+    {
+      return ((0 != PostMessage(targetWindow, message, wParam, lParam)) ? 1 : 0);
+    }
+
+    /// Delivers a batch of synthesized input events by posting window messages directly to the
+    /// specified window, bypassing the system input queue. Keyboard events become `WM_KEYDOWN`
+    /// and `WM_KEYUP` messages, mouse button and wheel events become the corresponding mouse
+    /// messages at the current cursor position, and mouse movement moves the cursor itself,
+    /// which in turn generates the movement message.
+    /// @param [in] targetWindow Window to which the messages are posted.
+    /// @param [in] inputEvents Input events to deliver.
+    /// @return Number of input events successfully delivered.
+    static unsigned int SubmitInputEventsViaWindowMessages(
+        HWND targetWindow, const std::vector<INPUT>& inputEvents)
+    {
+      unsigned int numEventsDelivered = 0;
+
+      POINT cursorPosition = {};
+      GetCursorPos(&cursorPosition);
+
+      POINT cursorPositionClient = cursorPosition;
+      ScreenToClient(targetWindow, &cursorPositionClient);
+
+      for (const INPUT& inputEvent : inputEvents)
+      {
+        switch (inputEvent.type)
+        {
+          case INPUT_KEYBOARD:
+          {
+            const bool isKeyUp = (0 != (inputEvent.ki.dwFlags & KEYEVENTF_KEYUP));
+            const bool isExtendedKey = (0 != (inputEvent.ki.dwFlags & KEYEVENTF_EXTENDEDKEY));
+            const UINT virtualKeyCode =
+                MapVirtualKey(inputEvent.ki.wScan, MAPVK_VSC_TO_VK_EX);
+
+            LPARAM keyMessageDetails = 1 | ((LPARAM)(inputEvent.ki.wScan & 0xff) << 16);
+            if (true == isExtendedKey) keyMessageDetails |= ((LPARAM)1 << 24);
+            if (true == isKeyUp) keyMessageDetails |= (((LPARAM)1 << 30) | ((LPARAM)1 << 31));
+
+            numEventsDelivered += PostMessageCounted(
+                targetWindow,
+                ((true == isKeyUp) ? WM_KEYUP : WM_KEYDOWN),
+                (WPARAM)virtualKeyCode,
+                keyMessageDetails);
+            break;
+          }
+
+          case INPUT_MOUSE:
+            if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_MOVE))
+            {
+              // Moving the cursor directly generates the corresponding movement message, and
+              // subsequent button messages in the same batch see the updated position.
+              cursorPosition.x += inputEvent.mi.dx;
+              cursorPosition.y += inputEvent.mi.dy;
+              if (0 != SetCursorPos(cursorPosition.x, cursorPosition.y)) numEventsDelivered += 1;
+
+              cursorPositionClient = cursorPosition;
+              ScreenToClient(targetWindow, &cursorPositionClient);
+            }
+            else if (0 != (inputEvent.mi.dwFlags & (MOUSEEVENTF_WHEEL | MOUSEEVENTF_HWHEEL)))
+            {
+              // Wheel messages carry screen coordinates, unlike button messages.
+              numEventsDelivered += PostMessageCounted(
+                  targetWindow,
+                  ((0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_WHEEL)) ? WM_MOUSEWHEEL
+                                                                      : WM_MOUSEHWHEEL),
+                  MAKEWPARAM(0, (WORD)(short)(LONG)inputEvent.mi.mouseData),
+                  MAKELPARAM(cursorPosition.x, cursorPosition.y));
+            }
+            else
+            {
+              const LPARAM buttonMessageCursorPosition =
+                  MAKELPARAM(cursorPositionClient.x, cursorPositionClient.y);
+
+              if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_LEFTDOWN))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow, WM_LBUTTONDOWN, MK_LBUTTON, buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_LEFTUP))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow, WM_LBUTTONUP, 0, buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_MIDDLEDOWN))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow, WM_MBUTTONDOWN, MK_MBUTTON, buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_MIDDLEUP))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow, WM_MBUTTONUP, 0, buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_RIGHTDOWN))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow, WM_RBUTTONDOWN, MK_RBUTTON, buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_RIGHTUP))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow, WM_RBUTTONUP, 0, buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_XDOWN))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow,
+                    WM_XBUTTONDOWN,
+                    MAKEWPARAM(0, (WORD)inputEvent.mi.mouseData),
+                    buttonMessageCursorPosition);
+              else if (0 != (inputEvent.mi.dwFlags & MOUSEEVENTF_XUP))
+                numEventsDelivered += PostMessageCounted(
+                    targetWindow,
+                    WM_XBUTTONUP,
+                    MAKEWPARAM(0, (WORD)inputEvent.mi.mouseData),
+                    buttonMessageCursorPosition);
+            }
+            break;
+
+          default:
+            break;
+        }
+      }
+
+      return numEventsDelivered;
+    }
+
+    /// Delivers a batch of synthesized input events using the configured synthesis backend.
+    /// The direct window message backend requires the foreground window to belong to the current
+    /// process; whenever it does not, delivery falls back to the system input queue so events
+    /// are never dropped.
+    /// @param [in] inputEvents Input events to deliver.
+    static void SubmitInputEvents(std::vector<INPUT>& inputEvents)
+    {
+      unsigned int numEventsDelivered = 0;
+
+      if (ESynthesisBackend::PostMessage == GetConfiguredSynthesisBackend())
+      {
+        const HWND targetWindow = SynthesisTargetWindow();
+        if (NULL != targetWindow)
+          numEventsDelivered = SubmitInputEventsViaWindowMessages(targetWindow, inputEvents);
+        else
+          numEventsDelivered =
+              SendInput((UINT)inputEvents.size(), inputEvents.data(), (int)sizeof(INPUT));
+      }
+      else
+      {
+        numEventsDelivered =
+            SendInput((UINT)inputEvents.size(), inputEvents.data(), (int)sizeof(INPUT));
+      }
+
+      statEventsEmitted.fetch_add(inputEvents.size(), std::memory_order_relaxed);
+      if (numEventsDelivered < inputEvents.size())
+        statEventsDropped.fetch_add(
+            inputEvents.size() - numEventsDelivered, std::memory_order_relaxed);
+      statDispatchCycles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Indicates whether the dispatch thread is blocked indefinitely waiting for a contribution.
+    /// Used by #WakeDispatchThreadIfIdle to avoid the cost of an unconditional event signal on
+    /// the high-rate continuous contribution path.
+    static std::atomic<bool> dispatchThreadIsIdle = false;
+
+    /// Retrieves the handle of the auto-reset event that is signaled whenever an input state
+    /// contribution requires the dispatch thread's attention. The dispatch thread blocks on this
+    /// event instead of polling, so a contribution wakes it immediately. Created on first use.
+    /// @return Handle of the dispatch activity event, or `NULL` if event creation failed, in
+    /// which case the dispatch thread falls back to polling.
+    static HANDLE DispatchActivityEvent(void)
+    {
+      static const HANDLE dispatchActivityEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+      return dispatchActivityEvent;
+    }
+
+    /// Manages the thread that gathers pending keyboard and mouse events and submits them to the
+    /// system. Wraps the thread handle to ensure safe termination and clean-up.
+    class InputDispatchThread
+    {
+    public:
+
+      inline InputDispatchThread(void) : inputDispatchThread(), inputDispatchStop() {}
+
+      /// Safely exits the input dispatch thread if it is started.
+      ~InputDispatchThread(void)
+      {
+        Exit();
+      }
+
+      /// Terminates the input dispatch thread.
+      inline void Exit(void)
+      {
+        if (true == inputDispatchThread.joinable())
+        {
+          inputDispatchStop.request_stop();
+
+          // The dispatch thread may be blocked indefinitely waiting for input activity, so it
+          // must be woken in order to observe the stop request.
+          const HANDLE dispatchActivityEvent = DispatchActivityEvent();
+          if (NULL != dispatchActivityEvent) SetEvent(dispatchActivityEvent);
+
+          inputDispatchThread.join();
+        }
+      }
+
+      /// Starts running the input dispatch thread.
+      inline void Start(void)
+      {
+        if ((false == inputDispatchThread.joinable()) &&
+            (false == inputDispatchStop.stop_requested()))
+        {
+          inputDispatchThread = std::thread(DispatchInputEvents, inputDispatchStop.get_token());
+        }
+      }
+
+    private:
+
+      /// Gathers pending keyboard and mouse input events each cycle and submits them all to the
+      /// system in a single call, so that simultaneous keyboard and mouse synthesis, such as a
+      /// stick-to-mouse movement alongside a keyboard-mapped button, costs one kernel transition
+      /// per cycle rather than one per module.
+      /// @param [in] inputDispatchStopToken Stop token used to indicate that this method should
+      /// terminate.
+      static void DispatchInputEvents(std::stop_token inputDispatchStopToken)
+      {
+        Globals::ApplyWorkerThreadAttributes(
+            Strings::kStrConfigurationSettingWorkerThreadsInputDispatchThreadPriority,
+            Strings::kStrConfigurationSettingWorkerThreadsInputDispatchThreadAffinityMask);
+        CpuBudget::RegisterCurrentWorkerThread();
+
+        std::vector<INPUT> inputEvents;
+        inputEvents.reserve(
+            Keyboard::kVirtualKeyboardKeyCount + (size_t)Mouse::EMouseAxis::Count +
+            (size_t)Mouse::EMouseButton::Count);
+
+        // While no keys or buttons are pressed and no movement is in progress this thread blocks
+        // indefinitely on the activity event and does no work at all; a contribution wakes it
+        // immediately, so synthesis latency is bounded by thread scheduling rather than by the
+        // dispatch period. While any state requires periodic synthesis it instead waits at most
+        // one dispatch period, so that continuous movement flows and a loss of input focus is
+        // noticed promptly. A contribution that lands while a dispatch cycle is in progress
+        // leaves the auto-reset event signaled, causing the next wait to return immediately, so
+        // no discrete state change can be lost.
+        bool idleUntilNextContribution = false;
+
+        const HANDLE dispatchActivityEvent = DispatchActivityEvent();
+
+        while (true)
+        {
+          // The CPU budget governor stretches the dispatch period while the process is over its
+          // configured budget. Mouse movement synthesis scales emitted motion by the time
+          // actually elapsed between passes, so a stretched period coarsens pointer updates
+          // without changing overall movement speed.
+          const unsigned int dispatchWaitMilliseconds =
+              (kDispatchPeriodMilliseconds * CpuBudget::GetPeriodScaleFactor());
+
+          if (NULL == dispatchActivityEvent)
+          {
+            Sleep(dispatchWaitMilliseconds);
+          }
+          else if (true == idleUntilNextContribution)
+          {
+            dispatchThreadIsIdle.store(true);
+            WaitForSingleObject(dispatchActivityEvent, INFINITE);
+            dispatchThreadIsIdle.store(false);
+          }
+          else
+          {
+            WaitForSingleObject(dispatchActivityEvent, dispatchWaitMilliseconds);
+          }
+
+          Diagnostics::RecordThreadHeartbeat(Diagnostics::EWorkerThread::InputDispatch);
+
+          const bool haveInputFocus = Globals::DoesCurrentProcessHaveInputFocus();
+          const bool terminationRequested = inputDispatchStopToken.stop_requested();
+
+          // If the current process does not have input focus or this thread is exiting then all
+          // pressed keys and buttons should be submitted to the system as released and movement
+          // should stop.
+          const bool forceNeutralState =
+              ((false == haveInputFocus) || (true == terminationRequested));
+
+          const bool keyboardRequiresPeriodicSynthesis =
+              Keyboard::AppendPendingKeyboardEvents(inputEvents, forceNeutralState);
+          const bool mouseRequiresPeriodicSynthesis =
+              Mouse::AppendPendingMouseEvents(inputEvents, forceNeutralState);
+
+          // The pending contribution timestamp is consumed every cycle, even if nothing is
+          // delivered, so a contribution that produced no event (for example, one absorbed by a
+          // forced neutral state) cannot inflate a later latency sample.
+          const int64_t contributionTimestamp =
+              pendingContributionTimestamp.exchange(0, std::memory_order_relaxed);
+
+          if (inputEvents.size() > 0)
+          {
+            SubmitInputEvents(inputEvents);
+            inputEvents.clear();
+
+            if (0 != contributionTimestamp)
+            {
+              static const int64_t counterTicksPerSecond = []() -> int64_t
+              {
+                LARGE_INTEGER counterFrequency;
+                QueryPerformanceFrequency(&counterFrequency);
+                return counterFrequency.QuadPart;
+              }();
+
+              LARGE_INTEGER injectionCompleteTime;
+              QueryPerformanceCounter(&injectionCompleteTime);
+
+              RecordInjectionLatencySample((uint64_t)(
+                  ((injectionCompleteTime.QuadPart - contributionTimestamp) * 1000000LL) /
+                  counterTicksPerSecond));
+            }
+          }
+
+          idleUntilNextContribution =
+              ((false == keyboardRequiresPeriodicSynthesis) &&
+               (false == mouseRequiresPeriodicSynthesis));
+
+          if (true == terminationRequested) break;
+        }
+      }
+
+      /// Handle for the dispatch thread itself.
+      std::thread inputDispatchThread;
+
+      /// Stop indicator to be used for exiting the input dispatch thread when needed.
+      std::stop_source inputDispatchStop;
+    };
+
+    /// Singleton object that wraps the input dispatch thread.
+    static InputDispatchThread inputDispatchThread;
+
+    void EnsureDispatchThreadRunning(void)
+    {
+      static std::once_flag initFlag;
+      std::call_once(
+          initFlag,
+          []() -> void
+          {
+            inputDispatchThread.Start();
+            Infra::Message::OutputFormatted(
+                Infra::Message::ESeverity::Info,
+                L"Initialized the input dispatch thread. Updates are event-driven with an active dispatch period of %u ms, delivered using the %s synthesis backend.",
+                kDispatchPeriodMilliseconds,
+                ((ESynthesisBackend::PostMessage == GetConfiguredSynthesisBackend())
+                     ? L"PostMessage"
+                     : L"SendInput"));
+          });
+    }
+
+    void WakeDispatchThread(void)
+    {
+      // Only the oldest undelivered contribution is stamped, so the latency sample measures the
+      // full time from first contribution to completed injection for each dispatch cycle.
+      if (0 == pendingContributionTimestamp.load(std::memory_order_relaxed))
+      {
+        LARGE_INTEGER contributionTime;
+        QueryPerformanceCounter(&contributionTime);
+
+        int64_t expectedTimestamp = 0;
+        pendingContributionTimestamp.compare_exchange_strong(
+            expectedTimestamp, contributionTime.QuadPart, std::memory_order_relaxed);
+      }
+
+      const HANDLE dispatchActivityEvent = DispatchActivityEvent();
+      if (NULL != dispatchActivityEvent) SetEvent(dispatchActivityEvent);
+    }
+
+    void WakeDispatchThreadIfIdle(void)
+    {
+      // A continuous contribution racing with the dispatch thread going idle can miss the wake,
+      // which is tolerated: continuous contributions are resubmitted on every mapping poll, and
+      // the next resubmission observes the idle flag and delivers the wake.
+      if (true == dispatchThreadIsIdle.exchange(false)) WakeDispatchThread();
+    }
+
+    void RecordContributionReceived(void)
+    {
+      statContributionsReceived.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordContributionCoalesced(void)
+    {
+      statContributionsCoalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Implements the Xidi API interface #ISynthesisStatistics.
+    class SynthesisStatisticsProvider : public Api::ISynthesisStatistics
+    {
+    public:
+
+      // ISynthesisStatistics
+      SCounters GetCounters(void) const override
+      {
+        SCounters counters = {
+            .contributionsReceived = statContributionsReceived.load(std::memory_order_relaxed),
+            .contributionsCoalesced = statContributionsCoalesced.load(std::memory_order_relaxed),
+            .eventsEmitted = statEventsEmitted.load(std::memory_order_relaxed),
+            .eventsDropped = statEventsDropped.load(std::memory_order_relaxed),
+            .dispatchCycles = statDispatchCycles.load(std::memory_order_relaxed)};
+
+        for (unsigned int bucket = 0; bucket < kLatencyHistogramBucketCount; ++bucket)
+          counters.injectionLatencyHistogram[bucket] =
+              statInjectionLatencyHistogram[bucket].load(std::memory_order_relaxed);
+
+        return counters;
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static SynthesisStatisticsProvider synthesisStatisticsProvider;
+  } // namespace InputDispatch
+} // namespace Xidi
@@ -0,0 +1,371 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file InputMetrics.cpp
+ *   Implementation of always-on input pipeline health metrics.
+ **************************************************************************************************/
+
+#include "InputMetrics.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+#include "ApiXidi.h"
+#include "ControllerTypes.h"
+#include "Globals.h"
+#include "Profiler.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace InputMetrics
+  {
+    /// Poll-to-refresh latency histogram counters.
+    static std::atomic<uint64_t>
+        pollToRefreshLatencyHistogram[Api::IInputMetrics::kLatencyHistogramBucketCount];
+
+    /// Refresh-to-read latency histogram counters.
+    static std::atomic<uint64_t>
+        refreshToReadLatencyHistogram[Api::IInputMetrics::kLatencyHistogramBucketCount];
+
+    /// Event buffer occupancy histogram counters.
+    static std::atomic<uint64_t>
+        eventBufferOccupancyHistogram[Api::IInputMetrics::kOccupancyHistogramBucketCount];
+
+    /// Lock wait time histogram counters.
+    static std::atomic<uint64_t>
+        lockWaitTimeHistogram[Api::IInputMetrics::kLockWaitHistogramBucketCount];
+
+    /// Total number of event buffer overflow occurrences across all event buffers.
+    static std::atomic<uint64_t> eventBufferOverflowCount;
+
+    /// Total number of buffered events discarded due to overflow across all event buffers.
+    static std::atomic<uint64_t> eventBufferDroppedEventCount;
+
+    /// Largest number of events ever present at once in any single event buffer.
+    static std::atomic<uint32_t> eventBufferHighWaterMark;
+
+    /// Number of measured timed wakeups per real-time polling loop.
+    static std::atomic<uint64_t> pollingLoopWakeupCount[(unsigned int)EPollingLoop::Count];
+
+    /// Total wakeup lateness per real-time polling loop, in milliseconds.
+    static std::atomic<uint64_t>
+        pollingLoopTotalLatenessMilliseconds[(unsigned int)EPollingLoop::Count];
+
+    /// Largest single-wakeup lateness per real-time polling loop, in milliseconds.
+    static std::atomic<uint64_t>
+        pollingLoopMaximumLatenessMilliseconds[(unsigned int)EPollingLoop::Count];
+
+    /// Number of wakeups late by at least one full scheduled period, per real-time polling loop.
+    static std::atomic<uint64_t> pollingLoopOverrunCount[(unsigned int)EPollingLoop::Count];
+
+    /// Tick count of the most recent jitter warning message per real-time polling loop, used for
+    /// rate limiting, or 0 if no warning has been emitted yet.
+    static std::atomic<uint64_t> pollingLoopLastWarningTime[(unsigned int)EPollingLoop::Count];
+
+    /// Timestamp of the most recent published state change per physical controller, in
+    /// QueryPerformanceCounter units. Consumed, and reset to 0, by the first state read that
+    /// follows, so each published change produces at most one refresh-to-read sample.
+    static std::atomic<int64_t>
+        pendingRefreshTimestamp[Controller::kPhysicalControllerCount];
+
+    /// Retrieves the performance counter frequency, in counts per second.
+    /// @return Performance counter frequency.
+    static int64_t PerformanceCounterFrequency(void)
+    {
+      static const int64_t performanceCounterFrequency = []() -> int64_t
+      {
+        LARGE_INTEGER counterFrequency;
+        QueryPerformanceFrequency(&counterFrequency);
+        return counterFrequency.QuadPart;
+      }();
+
+      return performanceCounterFrequency;
+    }
+
+    /// Retrieves the current performance counter value.
+    /// @return Current performance counter value.
+    static inline int64_t PerformanceCounterNow(void)
+    {
+      LARGE_INTEGER currentTime;
+      QueryPerformanceCounter(&currentTime);
+      return currentTime.QuadPart;
+    }
+
+    /// Converts an elapsed performance counter interval to microseconds.
+    /// @param [in] elapsedCounts Elapsed time in performance counter units.
+    /// @return Elapsed time in microseconds.
+    static inline uint64_t CountsToMicroseconds(int64_t elapsedCounts)
+    {
+      if (elapsedCounts <= 0) return 0;
+      return (uint64_t)((elapsedCounts * 1000000LL) / PerformanceCounterFrequency());
+    }
+
+    /// Submits a latency sample into the specified histogram.
+    /// @param [in,out] histogram Histogram counter array, with
+    /// #Api::IInputMetrics::kLatencyHistogramBucketCount elements.
+    /// @param [in] bucketUpperBounds Bucket upper bound array of the same element count.
+    /// @param [in] bucketCount Number of histogram buckets.
+    /// @param [in] sampleMicroseconds Latency sample in microseconds.
+    static inline void AddHistogramSample(
+        std::atomic<uint64_t>* histogram,
+        const uint64_t* bucketUpperBounds,
+        unsigned int bucketCount,
+        uint64_t sampleMicroseconds)
+    {
+      for (unsigned int bucket = 0; bucket < bucketCount; ++bucket)
+      {
+        if (sampleMicroseconds <= bucketUpperBounds[bucket])
+        {
+          histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+
+    void RecordStateRefreshed(
+        Controller::TControllerIdentifier controllerIdentifier, int64_t captureTimestamp)
+    {
+      if (controllerIdentifier >= Controller::kPhysicalControllerCount) return;
+
+      const int64_t currentTime = PerformanceCounterNow();
+
+      if (0 != captureTimestamp)
+        AddHistogramSample(
+            pollToRefreshLatencyHistogram,
+            Api::IInputMetrics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+            Api::IInputMetrics::kLatencyHistogramBucketCount,
+            CountsToMicroseconds(currentTime - captureTimestamp));
+
+      pendingRefreshTimestamp[controllerIdentifier].store(
+          currentTime, std::memory_order_relaxed);
+    }
+
+    void RecordStateRead(Controller::TControllerIdentifier controllerIdentifier)
+    {
+      if (controllerIdentifier >= Controller::kPhysicalControllerCount) return;
+
+      // Repeat reads of an already-observed state are the common case, and they complete here
+      // with just this one exchange operation.
+      const int64_t refreshTimestamp =
+          pendingRefreshTimestamp[controllerIdentifier].exchange(0, std::memory_order_relaxed);
+      if (0 == refreshTimestamp) return;
+
+      AddHistogramSample(
+          refreshToReadLatencyHistogram,
+          Api::IInputMetrics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+          Api::IInputMetrics::kLatencyHistogramBucketCount,
+          CountsToMicroseconds(PerformanceCounterNow() - refreshTimestamp));
+    }
+
+    void RecordEventBufferOccupancy(uint32_t occupiedEvents, uint32_t capacityEvents)
+    {
+      if (0 == capacityEvents) return;
+
+      const unsigned int occupancyPercent =
+          (unsigned int)(((uint64_t)occupiedEvents * 100) / capacityEvents);
+
+      for (unsigned int bucket = 0; bucket < Api::IInputMetrics::kOccupancyHistogramBucketCount;
+           ++bucket)
+      {
+        if (occupancyPercent <=
+            Api::IInputMetrics::kOccupancyHistogramBucketUpperBoundsPercent[bucket])
+        {
+          eventBufferOccupancyHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+
+    void RecordEventBufferOverflow(uint32_t droppedEvents)
+    {
+      eventBufferOverflowCount.fetch_add(1, std::memory_order_relaxed);
+      eventBufferDroppedEventCount.fetch_add(droppedEvents, std::memory_order_relaxed);
+    }
+
+    void RecordEventBufferHighWaterMark(uint32_t occupiedEvents)
+    {
+      uint32_t observedHighWaterMark = eventBufferHighWaterMark.load(std::memory_order_relaxed);
+      while ((occupiedEvents > observedHighWaterMark) &&
+             (false ==
+              eventBufferHighWaterMark.compare_exchange_weak(
+                  observedHighWaterMark, occupiedEvents, std::memory_order_relaxed)))
+        ;
+    }
+
+    /// Retrieves the configured polling loop jitter warning threshold. Lateness at or beyond
+    /// this value produces a rate-limited warning message, and 0 disables the warning entirely.
+    /// @return Configured warning threshold, in milliseconds.
+    static unsigned int JitterWarningThresholdMilliseconds(void)
+    {
+      static const unsigned int warningThresholdMilliseconds =
+          (unsigned int)Globals::GetConfigurationData()
+              [Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionLog)]
+              [Strings::kStrConfigurationSettingLogPollingJitterWarningThreshold]
+                  .ValueOr(0);
+      return warningThresholdMilliseconds;
+    }
+
+    void RecordPollingLoopWakeup(
+        EPollingLoop pollingLoop, uint32_t latenessMilliseconds, uint32_t periodMilliseconds)
+    {
+      /// Human-readable polling loop names for jitter warning messages, indexed by loop.
+      static constexpr const wchar_t* kPollingLoopNames[(unsigned int)EPollingLoop::Count] = {
+          L"physical state polling", L"force feedback actuation"};
+
+      /// Minimum time between jitter warning messages for the same polling loop.
+      static constexpr uint64_t kWarningIntervalMilliseconds = 60000;
+
+      const unsigned int loopIndex = (unsigned int)pollingLoop;
+      if (loopIndex >= (unsigned int)EPollingLoop::Count) return;
+
+      pollingLoopWakeupCount[loopIndex].fetch_add(1, std::memory_order_relaxed);
+      pollingLoopTotalLatenessMilliseconds[loopIndex].fetch_add(
+          latenessMilliseconds, std::memory_order_relaxed);
+
+      uint64_t observedMaximumLateness =
+          pollingLoopMaximumLatenessMilliseconds[loopIndex].load(std::memory_order_relaxed);
+      while ((latenessMilliseconds > observedMaximumLateness) &&
+             (false ==
+              pollingLoopMaximumLatenessMilliseconds[loopIndex].compare_exchange_weak(
+                  observedMaximumLateness, latenessMilliseconds, std::memory_order_relaxed)))
+        ;
+
+      if ((0 != periodMilliseconds) && (latenessMilliseconds >= periodMilliseconds))
+        pollingLoopOverrunCount[loopIndex].fetch_add(1, std::memory_order_relaxed);
+
+      const unsigned int warningThresholdMilliseconds = JitterWarningThresholdMilliseconds();
+      if ((0 != warningThresholdMilliseconds) &&
+          (latenessMilliseconds >= warningThresholdMilliseconds))
+      {
+        const uint64_t currentTimeMilliseconds = GetTickCount64();
+        uint64_t lastWarningTimeMilliseconds =
+            pollingLoopLastWarningTime[loopIndex].load(std::memory_order_relaxed);
+
+        if (((0 == lastWarningTimeMilliseconds) ||
+             ((currentTimeMilliseconds - lastWarningTimeMilliseconds) >=
+              kWarningIntervalMilliseconds)) &&
+            (true ==
+             pollingLoopLastWarningTime[loopIndex].compare_exchange_strong(
+                 lastWarningTimeMilliseconds,
+                 currentTimeMilliseconds,
+                 std::memory_order_relaxed)))
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Warning,
+              L"The %s loop woke up %u ms late from a scheduled %u ms wait. System timer resolution or thread scheduling may be degraded on this machine.",
+              kPollingLoopNames[loopIndex],
+              latenessMilliseconds,
+              periodMilliseconds);
+      }
+    }
+
+    void RecordUncontendedLockAcquisition(void)
+    {
+      lockWaitTimeHistogram[0].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void AcquireLockWithWaitMeasurement(std::unique_lock<std::recursive_mutex>& lock)
+    {
+      const int64_t waitStartTime = PerformanceCounterNow();
+      lock.lock();
+
+      AddHistogramSample(
+          lockWaitTimeHistogram,
+          Api::IInputMetrics::kLockWaitHistogramBucketUpperBoundsMicroseconds,
+          Api::IInputMetrics::kLockWaitHistogramBucketCount,
+          CountsToMicroseconds(PerformanceCounterNow() - waitStartTime));
+    }
+
+    /// Implements the Xidi API interface #IInputMetrics.
+    class InputMetricsProvider : public Api::IInputMetrics
+    {
+    public:
+
+      // IInputMetrics
+      SHistograms GetHistograms(void) const override
+      {
+        SHistograms histograms = {};
+
+        for (unsigned int bucket = 0; bucket < kLatencyHistogramBucketCount; ++bucket)
+        {
+          histograms.pollToRefreshLatency[bucket] =
+              pollToRefreshLatencyHistogram[bucket].load(std::memory_order_relaxed);
+          histograms.refreshToReadLatency[bucket] =
+              refreshToReadLatencyHistogram[bucket].load(std::memory_order_relaxed);
+        }
+
+        for (unsigned int bucket = 0; bucket < kOccupancyHistogramBucketCount; ++bucket)
+          histograms.eventBufferOccupancy[bucket] =
+              eventBufferOccupancyHistogram[bucket].load(std::memory_order_relaxed);
+
+        for (unsigned int bucket = 0; bucket < kLockWaitHistogramBucketCount; ++bucket)
+          histograms.lockWaitTime[bucket] =
+              lockWaitTimeHistogram[bucket].load(std::memory_order_relaxed);
+
+        return histograms;
+      }
+
+      SProfileSamples GetProfileSamples(void) const override
+      {
+        static_assert(
+            kProfileSiteCount == (unsigned int)Profiler::EProfileSite::Count,
+            "Profile site count mismatch between the Xidi API and the profiler.");
+
+        SProfileSamples profileSamples = {};
+
+        for (unsigned int site = 0; site < kProfileSiteCount; ++site)
+        {
+          const Profiler::SSiteSamples siteSamples =
+              Profiler::GetSiteSamples((Profiler::EProfileSite)site);
+
+          profileSamples.sampleCount[site] = siteSamples.sampleCount;
+          profileSamples.totalCycles[site] = siteSamples.totalCycles;
+          profileSamples.maximumCycles[site] = siteSamples.maximumCycles;
+        }
+
+        return profileSamples;
+      }
+
+      SEventBufferCounters GetEventBufferCounters(void) const override
+      {
+        return {
+            .overflowCount = eventBufferOverflowCount.load(std::memory_order_relaxed),
+            .droppedEventCount = eventBufferDroppedEventCount.load(std::memory_order_relaxed),
+            .highWaterMarkEvents = eventBufferHighWaterMark.load(std::memory_order_relaxed)};
+      }
+
+      SPollingLoopStatistics GetPollingLoopStatistics(void) const override
+      {
+        static_assert(
+            kPollingLoopCount == (unsigned int)EPollingLoop::Count,
+            "Polling loop count mismatch between the Xidi API and the metrics implementation.");
+
+        SPollingLoopStatistics pollingLoopStatistics = {};
+
+        for (unsigned int loopIndex = 0; loopIndex < kPollingLoopCount; ++loopIndex)
+        {
+          pollingLoopStatistics.wakeupCount[loopIndex] =
+              pollingLoopWakeupCount[loopIndex].load(std::memory_order_relaxed);
+          pollingLoopStatistics.totalLatenessMilliseconds[loopIndex] =
+              pollingLoopTotalLatenessMilliseconds[loopIndex].load(std::memory_order_relaxed);
+          pollingLoopStatistics.maximumLatenessMilliseconds[loopIndex] =
+              pollingLoopMaximumLatenessMilliseconds[loopIndex].load(std::memory_order_relaxed);
+          pollingLoopStatistics.overrunCount[loopIndex] =
+              pollingLoopOverrunCount[loopIndex].load(std::memory_order_relaxed);
+        }
+
+        return pollingLoopStatistics;
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static InputMetricsProvider inputMetricsProvider;
+  } // namespace InputMetrics
+} // namespace Xidi
@@ -12,317 +12,236 @@
 
 #include "Keyboard.h"
 
-#include <bitset>
-#include <mutex>
-#include <stop_token>
-#include <thread>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
 #include <vector>
 
-#include <Infra/Core/Message.h>
-
-#include "ApiBitSet.h"
 #include "ApiWindows.h"
 #include "ControllerTypes.h"
-#include "Globals.h"
+#include "InputDispatch.h"
+#include "Profiler.h"
 
 namespace Xidi
 {
   namespace Keyboard
   {
-    /// Type used to represent the state of an entire virtual keyboard.
-    using TState = BitSet<kVirtualKeyboardKeyCount>;
+    /// Number of 64-bit words needed to hold one bit per virtual keyboard key.
+    inline constexpr unsigned int kStateWordCount = (kVirtualKeyboardKeyCount + 63) / 64;
 
     /// Tracks "pressed" and "released" key state contributions and generates keyboard state
-    /// snapshots.
+    /// snapshots. Contributions are staged into atomic bit arrays so that the mapping hot path
+    /// marks keys with single lock-free operations, never contending on a mutex with the thread
+    /// that synthesizes keyboard events.
     class StateContributionTracker
     {
     public:
 
-      inline StateContributionTracker(void)
-      {
-        Reset();
-      }
-
       /// Determines if the specified key is marked as having been pressed since the last snapshot.
       /// A key marked pressed can also be marked released. The two are not mutually exclusive.
       /// @param [in] key Identifier of the keyboard key of interest.
       /// @return `true` if it is marked pressed, `false` if not.
-      constexpr bool IsMarkedPressed(TKeyIdentifier key) const
+      inline bool IsMarkedPressed(TKeyIdentifier key) const
       {
-        return pressedKeys.contains(key);
+        return (
+            0 != (pressedKeys[key / 64].load(std::memory_order_relaxed) & (1ull << (key % 64))));
       }
 
       /// Determines if the specified key is marked as having been released since the last snapshot.
       /// A key marked released can also be marked pressed. The two are not mutually exclusive.
       /// @param [in] key Identifier of the keyboard key of interest.
       /// @return `true` if it is marked released, `false` if not.
-      constexpr bool IsMarkedReleased(TKeyIdentifier key) const
-      {
-        return !(notReleasedKeys.contains(key));
-      }
-
-      /// Locks this object for ensuring proper concurrency control.
-      /// The returned lock object is scoped and, as a result, will automatically unlock upon its
-      /// destruction.
-      /// @return Scoped lock object that has acquired this object's concurrency control mutex.
-      inline std::unique_lock<std::mutex> Lock(void)
+      inline bool IsMarkedReleased(TKeyIdentifier key) const
       {
-        return std::unique_lock(keyboardStateGuard);
+        return (
+            0 != (releasedKeys[key / 64].load(std::memory_order_relaxed) & (1ull << (key % 64))));
       }
 
       /// Registers a key press contribution.
       /// Has no effect if the key is already marked as being pressed since the last snapshot.
       /// @param [in] key Identifier of the target keyboard key.
-      constexpr void MarkPressed(TKeyIdentifier key)
+      inline void MarkPressed(TKeyIdentifier key)
       {
-        pressedKeys.insert(key);
+        pressedKeys[key / 64].fetch_or((1ull << (key % 64)), std::memory_order_relaxed);
       }
 
       /// Registers a key release contribution.
       /// Has no effect if the key is already marked as being released since the last snapshot.
       /// @param [in] key Identifier of the target keyboard key.
-      constexpr void MarkRelease(TKeyIdentifier key)
+      inline void MarkRelease(TKeyIdentifier key)
       {
-        notReleasedKeys.erase(key);
+        releasedKeys[key / 64].fetch_or((1ull << (key % 64)), std::memory_order_relaxed);
       }
 
-      /// Computes the next keyboard snapshot by applying the marked changes to the specified
-      /// previous snapshot. Afterwards, resets internal state so no keys are marked as pressed or
-      /// released.
-      /// @param [in] previousSnapshot Previous snapshot against which to apply the marked changes.
-      constexpr TState SnapshotRelativeTo(const TState& previousSnapshot)
+      /// Computes one word of the next keyboard snapshot by consuming the marked changes for that
+      /// word and applying them to the corresponding word of the previous snapshot. Afterwards,
+      /// no keys in the word are marked as pressed or released.
+      /// @param [in] wordIndex Index of the 64-key word for which a snapshot is desired.
+      /// @param [in] previousSnapshotWord Previous snapshot word against which to apply the marked
+      /// changes.
+      /// @return Next snapshot word.
+      inline uint64_t SnapshotWordRelativeTo(unsigned int wordIndex, uint64_t previousSnapshotWord)
       {
+        const uint64_t pressedWord = pressedKeys[wordIndex].exchange(0, std::memory_order_relaxed);
+        const uint64_t releasedWord =
+            releasedKeys[wordIndex].exchange(0, std::memory_order_relaxed);
+
         // If a key is marked pressed since the last snapshot, then no matter what it is pressed in
         // the next snapshot. Otherwise, a key continues to be pressed if it was pressed in the last
         // snapshot and not released since.
-        const TState nextSnapshot = pressedKeys | (previousSnapshot & notReleasedKeys);
-
-        Reset();
-        return nextSnapshot;
-      }
-
-      /// Computes a keyboard state snapshot using only the marked changes.
-      /// Afterwards, resets internal state so no keys are marked as pressed or released.
-      constexpr TState Snapshot(void)
-      {
-        return SnapshotRelativeTo(TState());
-      }
-
-      /// Resets all marked contributions back to empty.
-      constexpr void Reset(void)
-      {
-        pressedKeys.clear();
-        notReleasedKeys.fill();
+        return (pressedWord | (previousSnapshotWord & ~releasedWord));
       }
 
     private:
 
-      /// Set of keys marked "pressed" since the last snapshot.
-      TState pressedKeys;
-
-      /// Inverted set of keys marked "released" since the last snapshot.
-      /// Keys present in this set have not been marked released since the last snapshot.
-      TState notReleasedKeys;
+      /// Set of keys marked "pressed" since the last snapshot, one bit per key.
+      std::atomic<uint64_t> pressedKeys[kStateWordCount];
 
-      /// For ensuring proper concurrency control of accesses to the virtual keyboard state
-      /// represented by this object.
-      std::mutex keyboardStateGuard;
+      /// Set of keys marked "released" since the last snapshot, one bit per key.
+      std::atomic<uint64_t> releasedKeys[kStateWordCount];
     };
 
-    /// Manages a thread that continuously runs and updates the physical keyboard state from virtual
-    /// keyboard state. Wraps the thread handle to ensure safe termination and clean-up.
-    class KeyboardUpdateThread
+    /// Holds changes to keyboard state since the last snapshot.
+    /// Virtual keyboard state snapshots are maintained by the input dispatch thread.
+    static StateContributionTracker keyboardTracker;
+
+    /// Most recent virtual keyboard state snapshot, maintained across invocations of
+    /// #AppendPendingKeyboardEvents. No synchronization is needed because only the input
+    /// dispatch thread reads or writes it.
+    static uint64_t previousKeyboardState[kStateWordCount];
+
+    /// Generates the proper flags indicating how the scan code should be interpreted for the
+    /// given keyboard key.
+    /// @param [in] key Keyboard key identifier.
+    /// @return Flags indicating how the scan code corresponding to the identified key should be
+    /// interpreted.
+    static constexpr DWORD KeyboardEventFlags(TKeyIdentifier key)
     {
-    public:
+      // Any key identifiers higher than the maximum 7-bit value are "extended" keys and need to
+      // be flagged as such.
+      if (key > 0x7f)
+        return (KEYEVENTF_SCANCODE | KEYEVENTF_EXTENDEDKEY);
+      else
+        return KEYEVENTF_SCANCODE;
+    }
 
-      inline KeyboardUpdateThread(StateContributionTracker& keyboardTracker)
-          : keyboardUpdateThread(), keyboardUpdateStop(), keyboardTracker(keyboardTracker)
-      {}
+    /// Generates the proper 16-bit scan code for the given keyboard key.
+    /// @param [in] key Keyboard key identifier.
+    /// @return Proper 16-bit scan code to use for the key.
+    static constexpr WORD KeyboardEventScanCode(TKeyIdentifier key)
+    {
+      // Only the bottom 7 bits of the key identifier are used.
+      // Any key identifiers higher than the maximum 7-bit value are "extended" keys for which a
+      // prefix of 0xe0 is needed in the full 16-bit quantity.
+      if (key > 0x7f)
+        return ((0xe0 << 8) | (key & 0x7f));
+      else
+        return key;
+    }
 
-      /// Safely exits the keyboard update thread if it is started.
-      ~KeyboardUpdateThread(void)
-      {
-        Exit();
-      }
+    /// Index into the per-key input event templates for a key press event.
+    static constexpr unsigned int kInputTemplateIndexPress = 0;
 
-      /// Terminates the keyboard update thread.
-      inline void Exit(void)
-      {
-        if (true == keyboardUpdateThread.joinable())
-        {
-          keyboardUpdateStop.request_stop();
-          keyboardUpdateThread.join();
-        }
-      }
+    /// Index into the per-key input event templates for a key release event.
+    static constexpr unsigned int kInputTemplateIndexRelease = 1;
+
+    /// Fully-populated keyboard input event templates, two per keyboard key: press at
+    /// #kInputTemplateIndexPress and release at #kInputTemplateIndexRelease. Built once at module
+    /// initialization so that emitting an event is a single copy of a template with no per-event
+    /// scan code or flag computation.
+    static const std::array<std::array<INPUT, 2>, kVirtualKeyboardKeyCount>
+        kKeyboardInputTemplates = []()
+    {
+      std::array<std::array<INPUT, 2>, kVirtualKeyboardKeyCount> inputTemplates = {};
 
-      /// Starts running the keyboard update thread.
-      inline void Start(void)
+      for (TKeyIdentifier key = 0; key < kVirtualKeyboardKeyCount; ++key)
       {
-        if ((false == keyboardUpdateThread.joinable()) &&
-            (false == keyboardUpdateStop.stop_requested()))
-        {
-          keyboardUpdateThread = std::thread(
-              UpdatePhysicalKeyboardState, &keyboardTracker, keyboardUpdateStop.get_token());
-        }
+        inputTemplates[key][kInputTemplateIndexPress] = INPUT(
+            {.type = INPUT_KEYBOARD,
+             .ki = {.wScan = KeyboardEventScanCode(key), .dwFlags = KeyboardEventFlags(key)}});
+        inputTemplates[key][kInputTemplateIndexRelease] = INPUT(
+            {.type = INPUT_KEYBOARD,
+             .ki = {
+                 .wScan = KeyboardEventScanCode(key),
+                 .dwFlags = KEYEVENTF_KEYUP | KeyboardEventFlags(key)}});
       }
 
-    private:
+      return inputTemplates;
+    }();
 
-      /// Generates the proper flags indicating how the scan code should be interpreted for the
-      /// given keyboard key.
-      /// @param [in] key Keyboard key identifier.
-      /// @return Flags indicating how the scan code corresponding to the identified key should be
-      /// interpreted.
-      static inline DWORD KeyboardEventFlags(TKeyIdentifier key)
-      {
-        // Any key identifiers higher than the maximum 7-bit value are "extended" keys and need to
-        // be flagged as such.
-        if (key > 0x7f)
-          return (KEYEVENTF_SCANCODE | KEYEVENTF_EXTENDEDKEY);
-        else
-          return KEYEVENTF_SCANCODE;
-      }
+    bool AppendPendingKeyboardEvents(std::vector<INPUT>& inputEvents, bool forceNeutralState)
+    {
+      const Profiler::ScopedSample profileSample(Profiler::EProfileSite::KeyboardSynthesis);
 
-      /// Generates the proper 16-bit scan code for the given keyboard key.
-      /// @param [in] key Keyboard key identifier.
-      /// @return Proper 16-bit scan code to use for the key.
-      static inline WORD KeyboardEventScanCode(TKeyIdentifier key)
-      {
-        // Only the bottom 7 bits of the key identifier are used.
-        // Any key identifiers higher than the maximum 7-bit value are "extended" keys for which a
-        // prefix of 0xe0 is needed in the full 16-bit quantity.
-        if (key > 0x7f)
-          return ((0xe0 << 8) | (key & 0x7f));
-        else
-          return key;
-      }
+      bool anyVirtualKeysPressed = false;
 
-      /// Periodically checks for changes between the previous and next views of the virtual
-      /// keyboard key states. On detected state change, generates and submits a keyboard input
-      /// event to the system.
-      /// @param [in] keyboardTracker Pointer to the keyboard state contribution tracker object to
-      /// use for updates.
-      /// @param [in] keyboardUpdateStopToken Stop token used to indicate that this method should
-      /// terminate.
-      static void UpdatePhysicalKeyboardState(
-          StateContributionTracker* keyboardTracker, std::stop_token keyboardUpdateStopToken)
+      for (unsigned int wordIndex = 0; wordIndex < kStateWordCount; ++wordIndex)
       {
-        std::vector<INPUT> keyboardEvents;
-        keyboardEvents.reserve(kVirtualKeyboardKeyCount);
+        uint64_t nextKeyboardStateWord =
+            keyboardTracker.SnapshotWordRelativeTo(wordIndex, previousKeyboardState[wordIndex]);
+
+        if (true == forceNeutralState) nextKeyboardStateWord = 0;
 
-        TState previousKeyboardState;
+        uint64_t transitionedKeys = nextKeyboardStateWord ^ previousKeyboardState[wordIndex];
 
-        while (true)
+        while (0 != transitionedKeys)
         {
-          Sleep(kKeyboardUpdatePeriodMilliseconds);
-
-          const bool haveInputFocus = Globals::DoesCurrentProcessHaveInputFocus();
-          const bool terminationRequested = keyboardUpdateStopToken.stop_requested();
-
-          {
-            auto lock = keyboardTracker->Lock();
-
-            TState nextKeyboardState = keyboardTracker->SnapshotRelativeTo(previousKeyboardState);
-
-            // If the current process does not have input focus or this thread is exiting then all
-            // pressed keys should be submitted to the system as released.
-            if ((false == haveInputFocus) || (true == terminationRequested))
-              nextKeyboardState.clear();
-
-            const TState transitionedKeys = nextKeyboardState ^ previousKeyboardState;
-
-            for (auto transitionedKeyIter : transitionedKeys)
-            {
-              const int transitionedKey = (int)transitionedKeyIter;
-
-              if (nextKeyboardState.contains(transitionedKey))
-              {
-                // Key with a transition is present in the next snapshot. This means it was pressed.
-                keyboardEvents.emplace_back(INPUT(
-                    {.type = INPUT_KEYBOARD,
-                     .ki = {
-                         .wScan = KeyboardEventScanCode(transitionedKey),
-                         .dwFlags = KeyboardEventFlags(transitionedKey)}}));
-              }
-              else
-              {
-                // Key with a transition is present in the next snapshot. This means it was
-                // released.
-                keyboardEvents.emplace_back(INPUT(
-                    {.type = INPUT_KEYBOARD,
-                     .ki = {
-                         .wScan = KeyboardEventScanCode(transitionedKey),
-                         .dwFlags = KEYEVENTF_KEYUP | KeyboardEventFlags(transitionedKey)}}));
-              }
-            }
-
-            previousKeyboardState = nextKeyboardState;
-          }
-
-          if (keyboardEvents.size() > 0)
-          {
-            SendInput((UINT)keyboardEvents.size(), keyboardEvents.data(), (int)sizeof(INPUT));
-            keyboardEvents.clear();
-          }
-
-          if (true == terminationRequested) break;
+          const int transitionedKey = (int)(64 * wordIndex) + std::countr_zero(transitionedKeys);
+          transitionedKeys &= (transitionedKeys - 1);
+
+          // Key with a transition that is present in the next snapshot was pressed,
+          // otherwise it was released.
+          const bool transitionIsFromUnpressedToPressed =
+              (0 != (nextKeyboardStateWord & (1ull << (transitionedKey % 64))));
+
+          inputEvents.push_back(
+              kKeyboardInputTemplates[transitionedKey]
+                                     [(true == transitionIsFromUnpressedToPressed)
+                                          ? kInputTemplateIndexPress
+                                          : kInputTemplateIndexRelease]);
         }
-      }
-
-      /// Handle for the update thread itself.
-      std::thread keyboardUpdateThread;
 
-      /// Stop indicator to be used for exiting the keyboard update thread when needed.
-      std::stop_source keyboardUpdateStop;
-
-      /// Keyboard contribution tracker object that should be used during the updates.
-      StateContributionTracker& keyboardTracker;
-    };
-
-    /// Holds changes to keyboard state since the last snapshot.
-    /// Virtual keyboard state snapshots are maintained by the thread that periodically updates
-    /// physical keyboard state.
-    static StateContributionTracker keyboardTracker;
+        previousKeyboardState[wordIndex] = nextKeyboardStateWord;
 
-    /// Singleton object that wraps the keyboard update thread.
-    static KeyboardUpdateThread keyboardUpdateThread(keyboardTracker);
+        if (0 != nextKeyboardStateWord) anyVirtualKeysPressed = true;
+      }
 
-    /// Initializes internal data structures, creates internal threads, and begins periodically
-    /// checking for keyboard events that need to be submitted. Idempotent and concurrency-safe.
-    static void InitializeAndBeginUpdating(void)
-    {
-      static std::once_flag initFlag;
-      std::call_once(
-          initFlag,
-          []() -> void
-          {
-            keyboardUpdateThread.Start();
-            Infra::Message::OutputFormatted(
-                Infra::Message::ESeverity::Info,
-                L"Initialized the keyboard event thread. Desired update period is %u ms.",
-                kKeyboardUpdatePeriodMilliseconds);
-          });
+      return anyVirtualKeysPressed;
     }
 
     void SubmitKeyPressedState(TKeyIdentifier key)
     {
-      InitializeAndBeginUpdating();
+      InputDispatch::EnsureDispatchThreadRunning();
 
+      // The check avoids a read-modify-write operation, and a wake of the dispatch thread, in
+      // the common steady-state case of a key being re-marked before the dispatch thread has
+      // taken its next snapshot.
       if (false == keyboardTracker.IsMarkedPressed(key))
       {
-        auto lock = keyboardTracker.Lock();
         keyboardTracker.MarkPressed(key);
+        InputDispatch::RecordContributionReceived();
+        InputDispatch::WakeDispatchThread();
+      }
+      else
+      {
+        InputDispatch::RecordContributionCoalesced();
       }
     }
 
     void SubmitKeyReleasedState(TKeyIdentifier key)
     {
-      InitializeAndBeginUpdating();
+      InputDispatch::EnsureDispatchThreadRunning();
 
       if (false == keyboardTracker.IsMarkedReleased(key))
       {
-        auto lock = keyboardTracker.Lock();
         keyboardTracker.MarkRelease(key);
+        InputDispatch::RecordContributionReceived();
+        InputDispatch::WakeDispatchThread();
+      }
+      else
+      {
+        InputDispatch::RecordContributionCoalesced();
       }
     }
   } // namespace Keyboard
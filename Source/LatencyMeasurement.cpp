@@ -0,0 +1,202 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file LatencyMeasurement.cpp
+ *   Implementation of per-stage input pipeline latency measurement for a single marked input
+ *   transition.
+ **************************************************************************************************/
+
+#include "LatencyMeasurement.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "ApiWindows.h"
+#include "ApiXidi.h"
+#include "ControllerTypes.h"
+
+namespace Xidi
+{
+  namespace LatencyMeasurement
+  {
+    /// Enumerates the stages of the marker state machine. The marked transition advances through
+    /// the stages strictly in order, with each stage transition published by the pipeline thread
+    /// that observed it.
+    enum class EMarkerStage : unsigned int
+    {
+      /// No marker is armed and no measurement exists.
+      Disarmed,
+
+      /// A marker is armed and the marked button's press edge has not yet been observed.
+      Armed,
+
+      /// The marked press edge has been captured and published, and the measurement is waiting
+      /// for a virtual controller to refresh with the marked snapshot.
+      AwaitingRefresh,
+
+      /// The marked snapshot has been refreshed, and the measurement is waiting for the first
+      /// application state read.
+      AwaitingRead,
+
+      /// The marked transition has passed through all pipeline stages.
+      Complete
+    };
+
+    /// Current marker stage. Doubles as the publication point for the non-atomic marker fields
+    /// below: each stage transition is a release store, and each stage check in a submission
+    /// function is an acquire load, so a thread that observes a stage also observes all fields
+    /// written before the transition into it.
+    static std::atomic<EMarkerStage> markerStage = EMarkerStage::Disarmed;
+
+    /// Identifier of the physical controller being marked.
+    static Controller::TControllerIdentifier markerControllerIdentifier;
+
+    /// Physical button whose press edge is being marked.
+    static Controller::EPhysicalButton markerPhysicalButton;
+
+    /// Last observed value of the marked button. Initialized to pressed at arming time so that a
+    /// press edge is only recognized once the button has been observed unpressed. Only touched by
+    /// the thread that publishes physical snapshots for the marked controller.
+    static bool markerButtonPreviouslyPressed;
+
+    /// Timestamp at which the hardware snapshot containing the marked transition was captured.
+    static int64_t markerCaptureTime;
+
+    /// Timestamp at which the marked snapshot was published to state change waiters.
+    static int64_t markerPublishTime;
+
+    /// Timestamp at which a virtual controller refreshed its view with the marked snapshot.
+    static int64_t markerRefreshTime;
+
+    /// Timestamp at which an application first read the refreshed state.
+    static int64_t markerReadTime;
+
+    /// Retrieves the current performance counter value.
+    /// @return Current performance counter value.
+    static inline int64_t PerformanceCounterNow(void)
+    {
+      LARGE_INTEGER currentTime;
+      QueryPerformanceCounter(&currentTime);
+      return currentTime.QuadPart;
+    }
+
+    void ArmMarker(
+        Controller::TControllerIdentifier controllerIdentifier,
+        Controller::EPhysicalButton physicalButton)
+    {
+      if (controllerIdentifier >= Controller::kPhysicalControllerCount) return;
+      if (physicalButton >= Controller::EPhysicalButton::Count) return;
+
+      // Disarming first quiesces the submission functions before the marker fields are rewritten.
+      markerStage.store(EMarkerStage::Disarmed, std::memory_order_release);
+
+      markerControllerIdentifier = controllerIdentifier;
+      markerPhysicalButton = physicalButton;
+      markerButtonPreviouslyPressed = true;
+      markerCaptureTime = 0;
+      markerPublishTime = 0;
+      markerRefreshTime = 0;
+      markerReadTime = 0;
+
+      markerStage.store(EMarkerStage::Armed, std::memory_order_release);
+    }
+
+    void DisarmMarker(void)
+    {
+      markerStage.store(EMarkerStage::Disarmed, std::memory_order_release);
+    }
+
+    Api::ILatencyMeasurement::SStageTimestamps GetMeasurement(void)
+    {
+      if (EMarkerStage::Complete != markerStage.load(std::memory_order_acquire)) return {};
+
+      return {
+          .isComplete = true,
+          .captureTime = markerCaptureTime,
+          .publishTime = markerPublishTime,
+          .refreshTime = markerRefreshTime,
+          .readTime = markerReadTime};
+    }
+
+    void SubmitPhysicalState(
+        Controller::TControllerIdentifier controllerIdentifier,
+        const Controller::SPhysicalState& physicalState)
+    {
+      if (EMarkerStage::Armed != markerStage.load(std::memory_order_acquire)) return;
+      if (controllerIdentifier != markerControllerIdentifier) return;
+
+      const bool markerButtonPressed = physicalState[markerPhysicalButton];
+      const bool markerPressEdge =
+          ((false == markerButtonPreviouslyPressed) && (true == markerButtonPressed));
+      markerButtonPreviouslyPressed = markerButtonPressed;
+
+      if (false == markerPressEdge) return;
+
+      // Injected snapshots might not carry a capture timestamp, in which case publication time is
+      // the best available approximation of capture time.
+      markerCaptureTime =
+          ((0 != physicalState.captureTimestamp) ? physicalState.captureTimestamp
+                                                 : PerformanceCounterNow());
+      markerPublishTime = PerformanceCounterNow();
+
+      markerStage.store(EMarkerStage::AwaitingRefresh, std::memory_order_release);
+    }
+
+    void SubmitStateRefresh(
+        Controller::TControllerIdentifier controllerIdentifier, int64_t captureTimestamp)
+    {
+      if (EMarkerStage::AwaitingRefresh != markerStage.load(std::memory_order_acquire)) return;
+      if (controllerIdentifier != markerControllerIdentifier) return;
+
+      // A refresh carrying a snapshot older than the marked one predates the marked transition
+      // and cannot be its delivery. A refresh at or after the marked capture carries the marked
+      // transition's effect, even if the marked snapshot itself was superseded before delivery.
+      if ((0 != captureTimestamp) && (captureTimestamp < markerCaptureTime)) return;
+
+      markerRefreshTime = PerformanceCounterNow();
+      markerStage.store(EMarkerStage::AwaitingRead, std::memory_order_release);
+    }
+
+    void SubmitStateRead(Controller::TControllerIdentifier controllerIdentifier)
+    {
+      if (EMarkerStage::AwaitingRead != markerStage.load(std::memory_order_acquire)) return;
+      if (controllerIdentifier != markerControllerIdentifier) return;
+
+      markerReadTime = PerformanceCounterNow();
+      markerStage.store(EMarkerStage::Complete, std::memory_order_release);
+    }
+
+    /// Implements the Xidi API interface #ILatencyMeasurement.
+    class LatencyMeasurementProvider : public Api::ILatencyMeasurement
+    {
+    public:
+
+      // ILatencyMeasurement
+      void ArmMarker(unsigned int controllerIdentifier, unsigned int physicalButton) override
+      {
+        if (physicalButton >= (unsigned int)Controller::EPhysicalButton::Count) return;
+
+        LatencyMeasurement::ArmMarker(
+            (Controller::TControllerIdentifier)controllerIdentifier,
+            (Controller::EPhysicalButton)physicalButton);
+      }
+
+      void DisarmMarker(void) override
+      {
+        LatencyMeasurement::DisarmMarker();
+      }
+
+      SStageTimestamps GetMeasurement(void) const override
+      {
+        return LatencyMeasurement::GetMeasurement();
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static LatencyMeasurementProvider latencyMeasurementProvider;
+  } // namespace LatencyMeasurement
+} // namespace Xidi
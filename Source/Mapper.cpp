@@ -12,10 +12,13 @@
 
 #include "Mapper.h"
 
+#include <array>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string_view>
 
 #include <Infra/Core/Configuration.h>
@@ -28,6 +31,7 @@
 #include "ElementMapper.h"
 #include "ForceFeedbackTypes.h"
 #include "Globals.h"
+#include "Profiler.h"
 #include "Strings.h"
 
 namespace Xidi
@@ -55,6 +59,8 @@ namespace Xidi
 
         if (Infra::Message::WillOutputMessageOfSeverity(kDumpSeverity))
         {
+          std::shared_lock lock(registryMutex);
+
           Infra::Message::Output(kDumpSeverity, L"Begin dump of all known mappers.");
 
           for (const auto& knownMapper : knownMappers)
@@ -103,6 +109,8 @@ namespace Xidi
           return;
         }
 
+        std::unique_lock lock(registryMutex);
+
         knownMappers[name] = object;
 
         if (true == defaultMapper.empty()) defaultMapper = name;
@@ -122,6 +130,8 @@ namespace Xidi
           return;
         }
 
+        std::unique_lock lock(registryMutex);
+
         if (false == knownMappers.contains(name))
         {
           Infra::Message::OutputFormatted(
@@ -152,6 +162,8 @@ namespace Xidi
       /// the registry.
       const Mapper* GetMapper(std::wstring_view mapperName)
       {
+        std::shared_lock lock(registryMutex);
+
         if (true == mapperName.empty()) mapperName = defaultMapper;
 
         const auto mapperRecord = knownMappers.find(mapperName);
@@ -164,6 +176,11 @@ namespace Xidi
 
       MapperRegistry(void) = default;
 
+      /// Enforces proper concurrency control for this registry. Configuration hot reloads can
+      /// re-register rebuilt custom mappers while application threads concurrently look mappers
+      /// up by name.
+      std::shared_mutex registryMutex;
+
       /// Implements the registry of known mappers.
       std::map<std::wstring_view, const Mapper*> knownMappers;
 
@@ -289,80 +306,146 @@ namespace Xidi
       return -FilterAnalogStickValue(analogValue);
     }
 
-    /// Computes the physical force feedback actuator value for the specified actuator given a
-    /// vector of magnitude components.
-    /// @param [in] virtualEffectComponents Virtual force feedback vector expressed as a magnitude
-    /// component vector.
-    /// @param [in] actuatorElement Physical force feedback actuator element for which an actuator
-    /// value is desired.
-    /// @param [in] gain Gain modifier to apply as a scalar multiplier on the physical actuator
-    /// value.
-    /// @return Physical force feedback actuator value that can be sent directly to the actuator
-    /// itself.
-    static inline ForceFeedback::TPhysicalActuatorValue ForceFeedbackActuatorValue(
-        ForceFeedback::TOrderedMagnitudeComponents virtualEffectComponents,
-        ForceFeedback::SActuatorElement actuatorElement,
-        ForceFeedback::TEffectValue gain)
+    /// Invokes an element mapper's contribution from an analog value, dispatching with a direct
+    /// call for the concrete element mapper types that support it and a virtual call otherwise.
+    /// The type tag is captured once when the mapping table is compiled, so the state mapping hot
+    /// path never performs a vtable lookup for the common mapper types.
+    /// @param [in] elementMapper Element mapper from which to request a contribution.
+    /// @param [in] elementMapperType Concrete type tag of the element mapper.
+    /// @param [in,out] controllerState Controller state data structure to be updated.
+    /// @param [in] analogValue Analog value to contribute.
+    /// @param [in] sourceIdentifier Opaque identifier of the contribution source.
+    static inline void ContributeFromAnalogValueDirect(
+        const IElementMapper* elementMapper,
+        EElementMapperType elementMapperType,
+        SState& controllerState,
+        int16_t analogValue,
+        uint32_t sourceIdentifier)
     {
-      if (false == actuatorElement.isPresent) return 0;
+      switch (elementMapperType)
+      {
+        case EElementMapperType::Axis:
+          static_cast<const AxisMapper*>(elementMapper)
+              ->AxisMapper::ContributeFromAnalogValue(
+                  controllerState, analogValue, sourceIdentifier);
+          break;
 
-      ForceFeedback::TEffectValue virtualActuatorStrengthRaw = 0;
+        case EElementMapperType::Button:
+          static_cast<const ButtonMapper*>(elementMapper)
+              ->ButtonMapper::ContributeFromAnalogValue(
+                  controllerState, analogValue, sourceIdentifier);
+          break;
 
-      switch (actuatorElement.mode)
+        case EElementMapperType::DigitalAxis:
+          static_cast<const DigitalAxisMapper*>(elementMapper)
+              ->DigitalAxisMapper::ContributeFromAnalogValue(
+                  controllerState, analogValue, sourceIdentifier);
+          break;
+
+        case EElementMapperType::Pov:
+          static_cast<const PovMapper*>(elementMapper)
+              ->PovMapper::ContributeFromAnalogValue(
+                  controllerState, analogValue, sourceIdentifier);
+          break;
+
+        default:
+          elementMapper->ContributeFromAnalogValue(controllerState, analogValue, sourceIdentifier);
+          break;
+      }
+    }
+
+    /// Invokes an element mapper's contribution from a button value, dispatching with a direct
+    /// call for the concrete element mapper types that support it and a virtual call otherwise.
+    /// @param [in] elementMapper Element mapper from which to request a contribution.
+    /// @param [in] elementMapperType Concrete type tag of the element mapper.
+    /// @param [in,out] controllerState Controller state data structure to be updated.
+    /// @param [in] buttonPressed Button state to contribute.
+    /// @param [in] sourceIdentifier Opaque identifier of the contribution source.
+    static inline void ContributeFromButtonValueDirect(
+        const IElementMapper* elementMapper,
+        EElementMapperType elementMapperType,
+        SState& controllerState,
+        bool buttonPressed,
+        uint32_t sourceIdentifier)
+    {
+      switch (elementMapperType)
       {
-        case ForceFeedback::EActuatorMode::SingleAxis:
-        {
-          if (ForceFeedback::kEffectForceMagnitudeZero ==
-              virtualEffectComponents[(int)actuatorElement.singleAxis.axis])
-            return 0;
-
-          const bool actuatorDirectionIsNegative =
-              std::signbit(virtualEffectComponents[(int)actuatorElement.singleAxis.axis]);
-          if ((EAxisDirection::Positive == actuatorElement.singleAxis.direction) &&
-              (true == actuatorDirectionIsNegative))
-            return 0;
-          if ((EAxisDirection::Negative == actuatorElement.singleAxis.direction) &&
-              (false == actuatorDirectionIsNegative))
-            return 0;
-
-          virtualActuatorStrengthRaw =
-              virtualEffectComponents[(int)actuatorElement.singleAxis.axis];
+        case EElementMapperType::Axis:
+          static_cast<const AxisMapper*>(elementMapper)
+              ->AxisMapper::ContributeFromButtonValue(
+                  controllerState, buttonPressed, sourceIdentifier);
+          break;
+
+        case EElementMapperType::Button:
+          static_cast<const ButtonMapper*>(elementMapper)
+              ->ButtonMapper::ContributeFromButtonValue(
+                  controllerState, buttonPressed, sourceIdentifier);
+          break;
+
+        case EElementMapperType::DigitalAxis:
+          static_cast<const DigitalAxisMapper*>(elementMapper)
+              ->DigitalAxisMapper::ContributeFromButtonValue(
+                  controllerState, buttonPressed, sourceIdentifier);
           break;
-        }
 
-        case ForceFeedback::EActuatorMode::MagnitudeProjection:
-          virtualActuatorStrengthRaw = (ForceFeedback::TEffectValue)std::sqrt(
-              std::pow(
-                  virtualEffectComponents[(int)actuatorElement.magnitudeProjection.axisFirst], 2) +
-              std::pow(
-                  virtualEffectComponents[(int)actuatorElement.magnitudeProjection.axisSecond], 2));
+        case EElementMapperType::Pov:
+          static_cast<const PovMapper*>(elementMapper)
+              ->PovMapper::ContributeFromButtonValue(
+                  controllerState, buttonPressed, sourceIdentifier);
           break;
 
         default:
-          return 0;
+          elementMapper->ContributeFromButtonValue(
+              controllerState, buttonPressed, sourceIdentifier);
+          break;
       }
+    }
 
-      constexpr ForceFeedback::TEffectValue kPhysicalActuatorRange = (ForceFeedback::TEffectValue)(
-          std::numeric_limits<ForceFeedback::TPhysicalActuatorValue>::max() -
-          std::numeric_limits<ForceFeedback::TPhysicalActuatorValue>::min());
-      constexpr ForceFeedback::TEffectValue kVirtualMagnitudeRange =
-          ForceFeedback::kEffectForceMagnitudeMaximum - ForceFeedback::kEffectForceMagnitudeZero;
-      constexpr ForceFeedback::TEffectValue kScalingFactor =
-          kPhysicalActuatorRange / kVirtualMagnitudeRange;
+    /// Invokes an element mapper's contribution from a trigger value, dispatching with a direct
+    /// call for the concrete element mapper types that support it and a virtual call otherwise.
+    /// @param [in] elementMapper Element mapper from which to request a contribution.
+    /// @param [in] elementMapperType Concrete type tag of the element mapper.
+    /// @param [in,out] controllerState Controller state data structure to be updated.
+    /// @param [in] triggerValue Trigger value to contribute.
+    /// @param [in] sourceIdentifier Opaque identifier of the contribution source.
+    static inline void ContributeFromTriggerValueDirect(
+        const IElementMapper* elementMapper,
+        EElementMapperType elementMapperType,
+        SState& controllerState,
+        uint8_t triggerValue,
+        uint32_t sourceIdentifier)
+    {
+      switch (elementMapperType)
+      {
+        case EElementMapperType::Axis:
+          static_cast<const AxisMapper*>(elementMapper)
+              ->AxisMapper::ContributeFromTriggerValue(
+                  controllerState, triggerValue, sourceIdentifier);
+          break;
 
-      const ForceFeedback::TEffectValue gainMultiplier =
-          gain / ForceFeedback::kEffectModifierMaximum;
-      const ForceFeedback::TEffectValue virtualActuatorStrengthMax =
-          (ForceFeedback::kEffectForceMagnitudeMaximum - ForceFeedback::kEffectForceMagnitudeZero) *
-          gainMultiplier;
+        case EElementMapperType::Button:
+          static_cast<const ButtonMapper*>(elementMapper)
+              ->ButtonMapper::ContributeFromTriggerValue(
+                  controllerState, triggerValue, sourceIdentifier);
+          break;
 
-      const ForceFeedback::TEffectValue virtualActuatorStrength = std::min(
-          virtualActuatorStrengthMax,
-          gainMultiplier *
-              std::abs(virtualActuatorStrengthRaw - ForceFeedback::kEffectForceMagnitudeZero));
-      const long physicalActuatorStrength = std::lround(virtualActuatorStrength * kScalingFactor);
+        case EElementMapperType::DigitalAxis:
+          static_cast<const DigitalAxisMapper*>(elementMapper)
+              ->DigitalAxisMapper::ContributeFromTriggerValue(
+                  controllerState, triggerValue, sourceIdentifier);
+          break;
+
+        case EElementMapperType::Pov:
+          static_cast<const PovMapper*>(elementMapper)
+              ->PovMapper::ContributeFromTriggerValue(
+                  controllerState, triggerValue, sourceIdentifier);
+          break;
 
-      return (ForceFeedback::TPhysicalActuatorValue)physicalActuatorStrength;
+        default:
+          elementMapper->ContributeFromTriggerValue(
+              controllerState, triggerValue, sourceIdentifier);
+          break;
+      }
     }
 
     /// Computes the opaque source identifier that is to be passed to an element mapper.
@@ -385,13 +468,337 @@ namespace Xidi
       }
     }
 
+    std::vector<Mapper::SMappingStep> Mapper::CompileMappingSteps(const UElementMap& elementMap)
+    {
+      /// Describes the physical input source consumed by one element map slot.
+      struct SStepSource
+      {
+        unsigned int elementMapIndex;
+        EMappingStepInput input;
+        EPhysicalButton sourceButton;
+      };
+
+      // Sources are listed in the order in which element mappers contribute during a state
+      // mapping pass. This order is externally visible through contribution aggregation semantics
+      // and must be preserved. The source button field is meaningful only for button inputs.
+      static const SStepSource kStepSources[] = {
+          {ELEMENT_MAP_INDEX_OF(stickLeftX), EMappingStepInput::AnalogStickLeftX, {}},
+          {ELEMENT_MAP_INDEX_OF(stickLeftY), EMappingStepInput::AnalogStickLeftY, {}},
+          {ELEMENT_MAP_INDEX_OF(stickRightX), EMappingStepInput::AnalogStickRightX, {}},
+          {ELEMENT_MAP_INDEX_OF(stickRightY), EMappingStepInput::AnalogStickRightY, {}},
+          {ELEMENT_MAP_INDEX_OF(dpadUp), EMappingStepInput::Button, EPhysicalButton::DpadUp},
+          {ELEMENT_MAP_INDEX_OF(dpadDown), EMappingStepInput::Button, EPhysicalButton::DpadDown},
+          {ELEMENT_MAP_INDEX_OF(dpadLeft), EMappingStepInput::Button, EPhysicalButton::DpadLeft},
+          {ELEMENT_MAP_INDEX_OF(dpadRight), EMappingStepInput::Button, EPhysicalButton::DpadRight},
+          {ELEMENT_MAP_INDEX_OF(triggerLT), EMappingStepInput::TriggerLT, {}},
+          {ELEMENT_MAP_INDEX_OF(triggerRT), EMappingStepInput::TriggerRT, {}},
+          {ELEMENT_MAP_INDEX_OF(buttonA), EMappingStepInput::Button, EPhysicalButton::A},
+          {ELEMENT_MAP_INDEX_OF(buttonB), EMappingStepInput::Button, EPhysicalButton::B},
+          {ELEMENT_MAP_INDEX_OF(buttonX), EMappingStepInput::Button, EPhysicalButton::X},
+          {ELEMENT_MAP_INDEX_OF(buttonY), EMappingStepInput::Button, EPhysicalButton::Y},
+          {ELEMENT_MAP_INDEX_OF(buttonLB), EMappingStepInput::Button, EPhysicalButton::LB},
+          {ELEMENT_MAP_INDEX_OF(buttonRB), EMappingStepInput::Button, EPhysicalButton::RB},
+          {ELEMENT_MAP_INDEX_OF(buttonBack), EMappingStepInput::Button, EPhysicalButton::Back},
+          {ELEMENT_MAP_INDEX_OF(buttonStart), EMappingStepInput::Button, EPhysicalButton::Start},
+          {ELEMENT_MAP_INDEX_OF(buttonLS), EMappingStepInput::Button, EPhysicalButton::LS},
+          {ELEMENT_MAP_INDEX_OF(buttonRS), EMappingStepInput::Button, EPhysicalButton::RS},
+          {ELEMENT_MAP_INDEX_OF(buttonGuide), EMappingStepInput::Button, EPhysicalButton::Guide},
+      };
+
+      static_assert(
+          _countof(kStepSources) ==
+              (sizeof(SElementMap) / sizeof(std::unique_ptr<const IElementMapper>)),
+          "Mapping step source list must cover every element map slot.");
+
+      std::vector<SMappingStep> mappingSteps;
+      mappingSteps.reserve(_countof(kStepSources));
+
+      for (const auto& stepSource : kStepSources)
+      {
+        const IElementMapper* const elementMapper =
+            elementMap.all[stepSource.elementMapIndex].get();
+        if (nullptr == elementMapper) continue;
+
+        const EElementMapperType elementMapperType = elementMapper->GetType();
+
+        // Steps with exactly one target additionally record that target so incremental mapping
+        // can reset a step's previous contribution before re-running it. The whole-controller
+        // element type acts as a sentinel meaning no single target exists.
+        SElementIdentifier targetElement = {.type = EElementType::WholeController};
+        EPovDirection targetPovDirection = {};
+
+        if (1 == elementMapper->GetTargetElementCount())
+        {
+          targetElement = elementMapper->GetTargetElementAt(0).value_or(
+              SElementIdentifier({.type = EElementType::WholeController}));
+
+          if ((EElementMapperType::Pov == elementMapperType) &&
+              (EElementType::Pov == targetElement.type))
+            targetPovDirection = static_cast<const PovMapper*>(elementMapper)->GetDirection();
+        }
+
+        // The target element mask is the union over all of the element mapper's enumerable
+        // targets. Custom element mappers may have side effects beyond their declared targets,
+        // such as contributing to keyboard or mouse synthesis, and element mappers with no
+        // enumerable targets cannot be analyzed at all, so both conservatively carry a mask with
+        // every element present and are never skipped.
+        TElementMask targetElementMask = 0;
+        const int numTargetElements = elementMapper->GetTargetElementCount();
+
+        if ((EElementMapperType::Custom == elementMapperType) || (numTargetElements < 1))
+        {
+          targetElementMask = kElementMaskAll;
+        }
+        else
+        {
+          for (int targetIdx = 0; targetIdx < numTargetElements; ++targetIdx)
+            targetElementMask |= ElementMaskBit(elementMapper->GetTargetElementAt(targetIdx)
+                                                    .value_or(SElementIdentifier(
+                                                        {.type = EElementType::WholeController})));
+        }
+
+        mappingSteps.push_back(
+            {.elementMapper = elementMapper,
+             .elementMapIndex = stepSource.elementMapIndex,
+             .type = elementMapperType,
+             .input = stepSource.input,
+             .sourceButton = stepSource.sourceButton,
+             .targetElement = targetElement,
+             .targetPovDirection = targetPovDirection,
+             .targetElementMask = targetElementMask});
+      }
+
+      return mappingSteps;
+    }
+
+    bool Mapper::ComputeIncrementalMappingSupport(const std::vector<SMappingStep>& mappingSteps)
+    {
+      for (size_t i = 0; i < mappingSteps.size(); ++i)
+      {
+        const SMappingStep& step = mappingSteps[i];
+
+        // Custom element mapper types may have side effects or aggregation semantics that are
+        // invisible to this analysis, and multi-target element mappers cannot have their previous
+        // contributions individually reset. Either one forces full evaluation on every pass.
+        if (EElementMapperType::Custom == step.type) return false;
+        if (EElementType::WholeController == step.targetElement.type) return false;
+
+        // Two steps targeting the same virtual controller element aggregate their contributions,
+        // which cannot be unwound one step at a time. POV targets conflict only if they press the
+        // same direction, since each direction is stored as an independent component.
+        for (size_t j = 0; j < i; ++j)
+        {
+          const SMappingStep& earlierStep = mappingSteps[j];
+
+          if (false == (earlierStep.targetElement == step.targetElement)) continue;
+          if ((EElementType::Pov == step.targetElement.type) &&
+              (earlierStep.targetPovDirection != step.targetPovDirection))
+            continue;
+
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    std::vector<Mapper::STrivialMappingStep> Mapper::CompileTrivialMappingSteps(
+        const std::vector<SMappingStep>& mappingSteps)
+    {
+      std::vector<STrivialMappingStep> trivialMappingSteps;
+      trivialMappingSteps.reserve(mappingSteps.size());
+
+      for (const SMappingStep& step : mappingSteps)
+      {
+        // Operation enumerators are laid out so that, within each family, input source kinds and
+        // axis directions are fused by fixed offsets from a base enumerator.
+        ETrivialStepOp stepOp = ETrivialStepOp::Count;
+        uint8_t stepInputIndex = 0;
+        uint8_t stepTarget = 0;
+
+        unsigned int inputKind = 0;
+        switch (step.input)
+        {
+          case EMappingStepInput::AnalogStickLeftX:
+          case EMappingStepInput::AnalogStickLeftY:
+          case EMappingStepInput::AnalogStickRightX:
+          case EMappingStepInput::AnalogStickRightY:
+            inputKind = 0;
+            stepInputIndex = (uint8_t)step.input;
+            break;
+
+          case EMappingStepInput::TriggerLT:
+          case EMappingStepInput::TriggerRT:
+            inputKind = 2;
+            stepInputIndex =
+                (uint8_t)((unsigned int)step.input - (unsigned int)EMappingStepInput::TriggerLT);
+            break;
+
+          case EMappingStepInput::Button:
+            inputKind = 1;
+            stepInputIndex = (uint8_t)step.sourceButton;
+            break;
+
+          default:
+            return std::vector<STrivialMappingStep>();
+        }
+
+        switch (step.type)
+        {
+          case EElementMapperType::Axis:
+          {
+            if (EElementType::Axis != step.targetElement.type)
+              return std::vector<STrivialMappingStep>();
+
+            const EAxisDirection axisDirection =
+                static_cast<const AxisMapper*>(step.elementMapper)->GetAxisDirection();
+            if ((unsigned int)axisDirection >= (unsigned int)EAxisDirection::Count)
+              return std::vector<STrivialMappingStep>();
+
+            stepOp = (ETrivialStepOp)(
+                (unsigned int)ETrivialStepOp::AxisFromAnalogBoth + (3 * inputKind) +
+                (unsigned int)axisDirection);
+            stepTarget = (uint8_t)step.targetElement.axis;
+            break;
+          }
+
+          case EElementMapperType::Button:
+            if (EElementType::Button != step.targetElement.type)
+              return std::vector<STrivialMappingStep>();
+
+            stepOp =
+                (ETrivialStepOp)((unsigned int)ETrivialStepOp::ButtonFromAnalog + inputKind);
+            stepTarget = (uint8_t)step.targetElement.button;
+            break;
+
+          case EElementMapperType::Pov:
+            if (EElementType::Pov != step.targetElement.type)
+              return std::vector<STrivialMappingStep>();
+
+            stepOp = (ETrivialStepOp)((unsigned int)ETrivialStepOp::PovFromAnalog + inputKind);
+            stepTarget = (uint8_t)step.targetPovDirection;
+            break;
+
+          default:
+            return std::vector<STrivialMappingStep>();
+        }
+
+        trivialMappingSteps.push_back(
+            {.op = stepOp,
+             .inputIndex = stepInputIndex,
+             .target = stepTarget,
+             .targetElementMask = step.targetElementMask});
+      }
+
+      return trivialMappingSteps;
+    }
+
+    std::array<Mapper::SForceFeedbackActuatorRoute, (int)ForceFeedback::EActuator::Count> Mapper::
+        ComputeForceFeedbackActuatorRoutes(const UForceFeedbackActuatorMap& actuatorMap)
+    {
+      std::array<SForceFeedbackActuatorRoute, (int)ForceFeedback::EActuator::Count> routes = {};
+
+      for (int i = 0; i < (int)ForceFeedback::EActuator::Count; ++i)
+      {
+        const ForceFeedback::SActuatorElement actuatorElement = actuatorMap.all[i];
+        SForceFeedbackActuatorRoute& route = routes[i];
+
+        // Zero-initialization above already encodes an actuator that produces no output, which
+        // is the correct routing for absent actuators and unrecognized actuator modes.
+        route.gateAxisDirection = EAxisDirection::Both;
+        if (false == actuatorElement.isPresent) continue;
+
+        switch (actuatorElement.mode)
+        {
+          case ForceFeedback::EActuatorMode::SingleAxis:
+            route.squaredComponentWeights[(int)actuatorElement.singleAxis.axis] = 1;
+            route.gateAxis = actuatorElement.singleAxis.axis;
+            route.gateAxisDirection = actuatorElement.singleAxis.direction;
+            break;
+
+          case ForceFeedback::EActuatorMode::MagnitudeProjection:
+            // Accumulation handles a degenerate projection onto one axis twice, which doubles
+            // the squared component exactly as the direct computation would.
+            route.squaredComponentWeights[(int)actuatorElement.magnitudeProjection.axisFirst] += 1;
+            route.squaredComponentWeights[(int)actuatorElement.magnitudeProjection.axisSecond] += 1;
+            break;
+
+          default:
+            break;
+        }
+      }
+
+      return routes;
+    }
+
+    /// Clones the specified element map into the specified arena so that the entire object graph
+    /// of the copy, including any sub-mappers, occupies contiguous memory. The original element
+    /// map, along with its individually heap-allocated objects, is left for the caller to discard.
+    /// @param [in] arena Arena into which to clone.
+    /// @param [in] elementMap Element map to clone.
+    /// @return Arena-backed deep copy of the element map.
+    static Mapper::UElementMap CloneElementMapIntoArena(
+        ElementMapperArena& arena, const Mapper::UElementMap& elementMap)
+    {
+      const ElementMapperArena::ActivationScope activationScope(arena);
+      return elementMap;
+    }
+
+    /// Clones the element mappers referenced by the specified definition into the specified
+    /// arena, producing an owning element map whose entire object graph occupies contiguous
+    /// memory. The definition itself is read-only data and remains untouched.
+    /// @param [in] arena Arena into which to clone.
+    /// @param [in] elementMapDefinition Element map definition whose mappers are to be cloned.
+    /// @return Arena-backed element map built from the definition.
+    static Mapper::UElementMap CloneElementMapIntoArena(
+        ElementMapperArena& arena, const Mapper::UElementMapDefinition& elementMapDefinition)
+    {
+      const ElementMapperArena::ActivationScope activationScope(arena);
+
+      Mapper::UElementMap elementMap;
+      for (int i = 0; i < _countof(elementMapDefinition.all); ++i)
+      {
+        if (nullptr != elementMapDefinition.all[i])
+          elementMap.all[i] = elementMapDefinition.all[i]->Clone();
+      }
+
+      return elementMap;
+    }
+
     Mapper::Mapper(
         const std::wstring_view name,
         SElementMap&& elements,
         SForceFeedbackActuatorMap forceFeedbackActuators)
-        : elements(std::move(elements)),
+        : elementMapperArena(),
+          elements(CloneElementMapIntoArena(elementMapperArena, UElementMap(std::move(elements)))),
           forceFeedbackActuators(forceFeedbackActuators),
+          forceFeedbackActuatorRoutes(
+              ComputeForceFeedbackActuatorRoutes(this->forceFeedbackActuators)),
           capabilities(DeriveCapabilitiesFromElementMap(this->elements, forceFeedbackActuators)),
+          mappingSteps(CompileMappingSteps(this->elements)),
+          mappingStepsSupportIncremental(ComputeIncrementalMappingSupport(this->mappingSteps)),
+          trivialMappingSteps(CompileTrivialMappingSteps(this->mappingSteps)),
+          inlinedMappingExecutor(nullptr),
+          name(name)
+    {
+      if (false == name.empty()) MapperRegistry::GetInstance().RegisterMapper(name, this);
+    }
+
+    Mapper::Mapper(
+        const std::wstring_view name,
+        const UElementMapDefinition& elements,
+        SForceFeedbackActuatorMap forceFeedbackActuators,
+        TInlinedMappingExecutor inlinedMappingExecutor)
+        : elementMapperArena(),
+          elements(CloneElementMapIntoArena(elementMapperArena, elements)),
+          forceFeedbackActuators(forceFeedbackActuators),
+          forceFeedbackActuatorRoutes(
+              ComputeForceFeedbackActuatorRoutes(this->forceFeedbackActuators)),
+          capabilities(DeriveCapabilitiesFromElementMap(this->elements, forceFeedbackActuators)),
+          mappingSteps(CompileMappingSteps(this->elements)),
+          mappingStepsSupportIncremental(ComputeIncrementalMappingSupport(this->mappingSteps)),
+          trivialMappingSteps(CompileTrivialMappingSteps(this->mappingSteps)),
+          inlinedMappingExecutor(inlinedMappingExecutor),
           name(name)
     {
       if (false == name.empty()) MapperRegistry::GetInstance().RegisterMapper(name, this);
@@ -401,6 +808,13 @@ namespace Xidi
         : Mapper(L"", std::move(elements), forceFeedbackActuators)
     {}
 
+    Mapper::Mapper(
+        const UElementMapDefinition& elements,
+        SForceFeedbackActuatorMap forceFeedbackActuators,
+        TInlinedMappingExecutor inlinedMappingExecutor)
+        : Mapper(L"", elements, forceFeedbackActuators, inlinedMappingExecutor)
+    {}
+
     Mapper::~Mapper(void)
     {
       if (false == name.empty()) MapperRegistry::GetInstance().UnregisterMapper(name, this);
@@ -427,6 +841,43 @@ namespace Xidi
       return *this;
     }
 
+    void Mapper::RegisterAlias(std::wstring_view aliasName) const
+    {
+      MapperRegistry::GetInstance().RegisterMapper(aliasName, this);
+    }
+
+    void Mapper::UnregisterAlias(std::wstring_view aliasName)
+    {
+      const Mapper* const mapperObject = MapperRegistry::GetInstance().GetMapper(aliasName);
+      if (nullptr == mapperObject) return;
+
+      // A name that matches the mapper object's own name is not an alias. Such registrations are
+      // removed only when the mapper object itself is destroyed.
+      if (mapperObject->GetName() == aliasName) return;
+
+      MapperRegistry::GetInstance().UnregisterMapper(aliasName, mapperObject);
+    }
+
+    void Mapper::UnregisterAndRetire(std::wstring_view mapperName)
+    {
+      const Mapper* const mapperObject = MapperRegistry::GetInstance().GetMapper(mapperName);
+      if (nullptr == mapperObject) return;
+
+      MapperRegistry::GetInstance().UnregisterMapper(mapperName, mapperObject);
+
+      if (mapperObject->GetName() == mapperName)
+      {
+        // The name being retired is the one under which the mapper object was originally created,
+        // so this object owns itself and nothing else will ever destroy it. Retired mapper objects
+        // are deliberately kept alive until program termination because consumers may still hold
+        // pointers to them. The container is heap-allocated so that it, and the objects it holds,
+        // survive past the lifetime of typical static objects.
+        static std::vector<const Mapper*>* const retiredMappers =
+            new std::vector<const Mapper*>();
+        retiredMappers->push_back(mapperObject);
+      }
+    }
+
     void Mapper::DumpRegisteredMappers(void)
     {
       MapperRegistry::GetInstance().DumpRegisteredMappers();
@@ -439,100 +890,117 @@ namespace Xidi
 
     const Mapper* Mapper::GetConfigured(TControllerIdentifier controllerIdentifier)
     {
-      static const Mapper* configuredMapper[kPhysicalControllerCount];
-      static std::once_flag configuredMapperFlag;
+      // Assignments are re-derived on demand whenever a configuration hot reload publishes a new
+      // generation, which is how rebuilt custom mappers take effect on running controllers. The
+      // steady-state cost of a call is one atomic generation check plus one atomic pointer load.
+      static std::atomic<const Mapper*> configuredMapper[kPhysicalControllerCount];
+      static std::atomic<int64_t> configuredForGeneration = -1;
+      static std::mutex configuredMapperMutex;
+
+      const int64_t currentGeneration = (int64_t)Globals::GetConfigurationGeneration();
+      if (currentGeneration != configuredForGeneration.load(std::memory_order_acquire))
+      {
+        std::unique_lock lock(configuredMapperMutex);
+
+        if (currentGeneration != configuredForGeneration.load(std::memory_order_relaxed))
+        {
+          const Mapper* newConfiguredMapper[kPhysicalControllerCount] = {};
+
+          const auto& configData = Globals::GetConfigurationData();
+          const std::wstring_view mapperSectionName =
+              Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionMapper);
 
-      std::call_once(
-          configuredMapperFlag,
-          []() -> void
+          if (true == configData.Contains(mapperSectionName))
           {
-            const auto& configData = Globals::GetConfigurationData();
+            // Mapper section exists in the configuration file.
+            // If the controller-independent type setting exists, it will be used as the fallback
+            // default, otherwise the default mapper will be used for this purpose. If any
+            // per-controller type settings exist, they take precedence.
+            const auto& mapperConfigData = configData[mapperSectionName];
+
+            const Mapper* fallbackMapper = nullptr;
+            if (true == mapperConfigData.Contains(Strings::kStrConfigurationSettingMapperType))
+            {
+              std::wstring_view fallbackMapperName =
+                  mapperConfigData[Strings::kStrConfigurationSettingMapperType]->GetString();
+              fallbackMapper = GetByName(fallbackMapperName);
 
-            if (true == configData.Contains(Strings::kStrConfigurationSectionMapper))
+              if (nullptr == fallbackMapper)
+                Infra::Message::OutputFormatted(
+                    Infra::Message::ESeverity::Warning,
+                    L"Could not locate mapper \"%s\" specified in the configuration file as the default.",
+                    fallbackMapperName.data());
+            }
+
+            if (nullptr == fallbackMapper)
             {
-              // Mapper section exists in the configuration file.
-              // If the controller-independent type setting exists, it will be used as the fallback
-              // default, otherwise the default mapper will be used for this purpose. If any
-              // per-controller type settings exist, they take precedence.
-              const auto& mapperConfigData = configData[Strings::kStrConfigurationSectionMapper];
-
-              const Mapper* fallbackMapper = nullptr;
-              if (true == mapperConfigData.Contains(Strings::kStrConfigurationSettingMapperType))
-              {
-                std::wstring_view fallbackMapperName =
-                    mapperConfigData[Strings::kStrConfigurationSettingMapperType]->GetString();
-                fallbackMapper = GetByName(fallbackMapperName);
+              fallbackMapper = GetDefault();
 
-                if (nullptr == fallbackMapper)
-                  Infra::Message::OutputFormatted(
-                      Infra::Message::ESeverity::Warning,
-                      L"Could not locate mapper \"%s\" specified in the configuration file as the default.",
-                      fallbackMapperName.data());
+              if (nullptr == fallbackMapper)
+              {
+                Infra::Message::Output(
+                    Infra::Message::ESeverity::Error,
+                    L"Internal error: Unable to locate the default mapper.");
+                fallbackMapper = GetNull();
               }
+            }
 
-              if (nullptr == fallbackMapper)
+            for (TControllerIdentifier i = 0; i < _countof(newConfiguredMapper); ++i)
+            {
+              if (true ==
+                  mapperConfigData.Contains(Strings::MapperTypeConfigurationNameString(i)))
               {
-                fallbackMapper = GetDefault();
+                std::wstring_view configuredMapperName =
+                    mapperConfigData[Strings::MapperTypeConfigurationNameString(i)]->GetString();
+                newConfiguredMapper[i] = GetByName(configuredMapperName.data());
 
-                if (nullptr == fallbackMapper)
+                if (nullptr == newConfiguredMapper[i])
                 {
-                  Infra::Message::Output(
-                      Infra::Message::ESeverity::Error,
-                      L"Internal error: Unable to locate the default mapper.");
-                  fallbackMapper = GetNull();
+                  Infra::Message::OutputFormatted(
+                      Infra::Message::ESeverity::Warning,
+                      L"Could not locate mapper \"%s\" specified in the configuration file for controller %u.",
+                      configuredMapperName.data(),
+                      (unsigned int)(1 + i));
+                  newConfiguredMapper[i] = fallbackMapper;
                 }
               }
-
-              for (TControllerIdentifier i = 0; i < _countof(configuredMapper); ++i)
+              else
               {
-                if (true ==
-                    mapperConfigData.Contains(Strings::MapperTypeConfigurationNameString(i)))
-                {
-                  std::wstring_view configuredMapperName =
-                      mapperConfigData[Strings::MapperTypeConfigurationNameString(i)]->GetString();
-                  configuredMapper[i] = GetByName(configuredMapperName.data());
-
-                  if (nullptr == configuredMapper[i])
-                  {
-                    Infra::Message::OutputFormatted(
-                        Infra::Message::ESeverity::Warning,
-                        L"Could not locate mapper \"%s\" specified in the configuration file for controller %u.",
-                        configuredMapperName.data(),
-                        (unsigned int)(1 + i));
-                    configuredMapper[i] = fallbackMapper;
-                  }
-                }
-                else
-                {
-                  configuredMapper[i] = fallbackMapper;
-                }
+                newConfiguredMapper[i] = fallbackMapper;
               }
             }
-            else
+          }
+          else
+          {
+            // Mapper section does not exist in the configuration file.
+            const Mapper* defaultMapper = GetDefault();
+            if (nullptr == defaultMapper)
             {
-              // Mapper section does not exist in the configuration file.
-              const Mapper* defaultMapper = GetDefault();
-              if (nullptr == defaultMapper)
-              {
-                Infra::Message::Output(
-                    Infra::Message::ESeverity::Error,
-                    L"Internal error: Unable to locate the default mapper. Virtual controllers will not function.");
-                defaultMapper = GetNull();
-              }
-
-              for (TControllerIdentifier i = 0; i < _countof(configuredMapper); ++i)
-                configuredMapper[i] = defaultMapper;
+              Infra::Message::Output(
+                  Infra::Message::ESeverity::Error,
+                  L"Internal error: Unable to locate the default mapper. Virtual controllers will not function.");
+              defaultMapper = GetNull();
             }
 
-            Infra::Message::Output(
-                Infra::Message::ESeverity::Info, L"Mappers assigned to controllers...");
-            for (TControllerIdentifier i = 0; i < _countof(configuredMapper); ++i)
-              Infra::Message::OutputFormatted(
-                  Infra::Message::ESeverity::Info,
-                  L"    [%u]: %s",
-                  (unsigned int)(1 + i),
-                  configuredMapper[i]->GetName().data());
-          });
+            for (TControllerIdentifier i = 0; i < _countof(newConfiguredMapper); ++i)
+              newConfiguredMapper[i] = defaultMapper;
+          }
+
+          Infra::Message::Output(
+              Infra::Message::ESeverity::Info, L"Mappers assigned to controllers...");
+          for (TControllerIdentifier i = 0; i < _countof(newConfiguredMapper); ++i)
+            Infra::Message::OutputFormatted(
+                Infra::Message::ESeverity::Info,
+                L"    [%u]: %s",
+                (unsigned int)(1 + i),
+                newConfiguredMapper[i]->GetName().data());
+
+          for (TControllerIdentifier i = 0; i < _countof(configuredMapper); ++i)
+            configuredMapper[i].store(newConfiguredMapper[i], std::memory_order_relaxed);
+
+          configuredForGeneration.store(currentGeneration, std::memory_order_release);
+        }
+      }
 
       if (controllerIdentifier >= _countof(configuredMapper))
       {
@@ -543,7 +1011,7 @@ namespace Xidi
         return GetNull();
       }
 
-      return configuredMapper[controllerIdentifier];
+      return configuredMapper[controllerIdentifier].load(std::memory_order_relaxed);
     }
 
     const Mapper* Mapper::GetNull(void)
@@ -556,20 +1024,168 @@ namespace Xidi
         ForceFeedback::TOrderedMagnitudeComponents virtualEffectComponents,
         ForceFeedback::TEffectValue gain) const
     {
+      constexpr ForceFeedback::TEffectValue kPhysicalActuatorRange = (ForceFeedback::TEffectValue)(
+          std::numeric_limits<ForceFeedback::TPhysicalActuatorValue>::max() -
+          std::numeric_limits<ForceFeedback::TPhysicalActuatorValue>::min());
+      constexpr ForceFeedback::TEffectValue kVirtualMagnitudeRange =
+          ForceFeedback::kEffectForceMagnitudeMaximum - ForceFeedback::kEffectForceMagnitudeZero;
+      constexpr ForceFeedback::TEffectValue kScalingFactor =
+          kPhysicalActuatorRange / kVirtualMagnitudeRange;
+
+      const ForceFeedback::TEffectValue gainMultiplier =
+          gain / ForceFeedback::kEffectModifierMaximum;
+      const ForceFeedback::TEffectValue virtualActuatorStrengthMax =
+          (ForceFeedback::kEffectForceMagnitudeMaximum - ForceFeedback::kEffectForceMagnitudeZero) *
+          gainMultiplier;
+
+      // Squared magnitude components are computed in double precision so that routes compiled
+      // from either actuator mode produce results identical to computing that mode directly.
+      double squaredComponents[(int)EAxis::Count];
+      for (int axis = 0; axis < (int)EAxis::Count; ++axis)
+        squaredComponents[axis] =
+            (double)virtualEffectComponents[axis] * (double)virtualEffectComponents[axis];
+
+      ForceFeedback::TPhysicalActuatorValue
+          actuatorValues[(int)ForceFeedback::EActuator::Count] = {};
+
+      for (int i = 0; i < (int)ForceFeedback::EActuator::Count; ++i)
+      {
+        const SForceFeedbackActuatorRoute& route = forceFeedbackActuatorRoutes[i];
+
+        if (EAxisDirection::Both != route.gateAxisDirection)
+        {
+          const ForceFeedback::TEffectValue gateComponent =
+              virtualEffectComponents[(int)route.gateAxis];
+          if (ForceFeedback::kEffectForceMagnitudeZero == gateComponent) continue;
+
+          const bool gateComponentIsNegative = std::signbit(gateComponent);
+          if ((EAxisDirection::Positive == route.gateAxisDirection) &&
+              (true == gateComponentIsNegative))
+            continue;
+          if ((EAxisDirection::Negative == route.gateAxisDirection) &&
+              (false == gateComponentIsNegative))
+            continue;
+        }
+
+        double weightedSquaredSum = 0.0;
+        for (int axis = 0; axis < (int)EAxis::Count; ++axis)
+          weightedSquaredSum += (double)route.squaredComponentWeights[axis] *
+              squaredComponents[axis];
+
+        const ForceFeedback::TEffectValue virtualActuatorStrengthRaw =
+            (ForceFeedback::TEffectValue)std::sqrt(weightedSquaredSum);
+
+        const ForceFeedback::TEffectValue virtualActuatorStrength =
+            std::min(virtualActuatorStrengthMax, gainMultiplier * virtualActuatorStrengthRaw);
+
+        actuatorValues[i] = (ForceFeedback::TPhysicalActuatorValue)std::lround(
+            virtualActuatorStrength * kScalingFactor);
+      }
+
       return {
-          .leftMotor = ForceFeedbackActuatorValue(
-              virtualEffectComponents, forceFeedbackActuators.named.leftMotor, gain),
-          .rightMotor = ForceFeedbackActuatorValue(
-              virtualEffectComponents, forceFeedbackActuators.named.rightMotor, gain),
-          .leftImpulseTrigger = ForceFeedbackActuatorValue(
-              virtualEffectComponents, forceFeedbackActuators.named.leftImpulseTrigger, gain),
-          .rightImpulseTrigger = ForceFeedbackActuatorValue(
-              virtualEffectComponents, forceFeedbackActuators.named.rightImpulseTrigger, gain)};
+          .leftMotor = actuatorValues[(int)ForceFeedback::EActuator::LeftMotor],
+          .rightMotor = actuatorValues[(int)ForceFeedback::EActuator::RightMotor],
+          .leftImpulseTrigger =
+              actuatorValues[(int)ForceFeedback::EActuator::LeftImpulseTrigger],
+          .rightImpulseTrigger =
+              actuatorValues[(int)ForceFeedback::EActuator::RightImpulseTrigger]};
+    }
+
+    void Mapper::ExecuteTrivialMappingSteps(
+        SState& controllerState,
+        const SPhysicalState& physicalState,
+        const int16_t* analogValues,
+        const uint8_t* triggerValues,
+        TElementMask consumedElements) const
+    {
+      // The contribution arithmetic for every fused operation lives in
+      // #ApplyTrivialMappingStep, which is shared with the compile-time mapper facility.
+      for (const STrivialMappingStep& step : trivialMappingSteps)
+      {
+        if (0 == (step.targetElementMask & consumedElements)) continue;
+
+        ApplyTrivialMappingStep(step, controllerState, physicalState, analogValues, triggerValues);
+      }
+    }
+
+    void Mapper::ExecuteMappingSteps(
+        SState& controllerState,
+        const SPhysicalState& physicalState,
+        const int16_t* analogValues,
+        const uint8_t* triggerValues,
+        uint32_t sourceControllerIdentifier,
+        TElementMask consumedElements) const
+    {
+      // Mappers constructed with a compile-time executor run it for full mapping passes. The
+      // executor is generated from the same element map definition as the runtime tables and
+      // performs the same contributions as straight-line code with no table walk at all.
+      if (nullptr != inlinedMappingExecutor)
+        return inlinedMappingExecutor(
+            controllerState, physicalState, analogValues, triggerValues, consumedElements);
+
+      // Mappers built entirely from trivial element mappers use the specialized executor, which
+      // performs the same contributions with fully inlined arithmetic. The general loop below is
+      // kept for mappers that genuinely use split, invert, compound, or custom element mappers.
+      if (false == trivialMappingSteps.empty())
+        return ExecuteTrivialMappingSteps(
+            controllerState, physicalState, analogValues, triggerValues, consumedElements);
+
+      // The compiled mapping table holds one step per present element mapper, so the hot loop
+      // performs no null checks and, for the common concrete mapper types, no virtual calls.
+      for (const SMappingStep& step : mappingSteps)
+      {
+        if (0 == (step.targetElementMask & consumedElements)) continue;
+
+        const uint32_t sourceIdentifier =
+            SourceIdentifierForElementMapper(sourceControllerIdentifier, step.elementMapIndex);
+
+        switch (step.input)
+        {
+          case EMappingStepInput::AnalogStickLeftX:
+          case EMappingStepInput::AnalogStickLeftY:
+          case EMappingStepInput::AnalogStickRightX:
+          case EMappingStepInput::AnalogStickRightY:
+            ContributeFromAnalogValueDirect(
+                step.elementMapper,
+                step.type,
+                controllerState,
+                analogValues[(unsigned int)step.input],
+                sourceIdentifier);
+            break;
+
+          case EMappingStepInput::TriggerLT:
+          case EMappingStepInput::TriggerRT:
+            ContributeFromTriggerValueDirect(
+                step.elementMapper,
+                step.type,
+                controllerState,
+                triggerValues
+                    [(unsigned int)step.input - (unsigned int)EMappingStepInput::TriggerLT],
+                sourceIdentifier);
+            break;
+
+          case EMappingStepInput::Button:
+            ContributeFromButtonValueDirect(
+                step.elementMapper,
+                step.type,
+                controllerState,
+                physicalState[step.sourceButton],
+                sourceIdentifier);
+            break;
+
+          default:
+            break;
+        }
+      }
     }
 
     SState Mapper::MapStatePhysicalToVirtual(
-        SPhysicalState physicalState, uint32_t sourceControllerIdentifier) const
+        SPhysicalState physicalState,
+        uint32_t sourceControllerIdentifier,
+        TElementMask consumedElements) const
     {
+      const Profiler::ScopedSample profileSample(Profiler::EProfileSite::MapperStateMapping);
+
       // These properties are read from the configuration file and can be used to apply extra
       // transformations to raw analog values read from physical controllers. By default, deadzone
       // percentage is set to 0 and saturation percentage is set to 100 to avoid any reduction in
@@ -578,60 +1194,7 @@ namespace Xidi
       // some interfaces like WinMM do not even support application-supplied properties.
       // Furthermore, some games require an extra correction to map from a circular field of
       // physical motion to a square field of virtual motion.
-      static const double kCircleToSquareFractionStickLeft =
-          static_cast<double>(
-              Globals::GetConfigurationData()
-                  [Strings::kStrConfigurationSectionProperties]
-                  [Strings::kStrConfigurationSettingsPropertiesCircleToSquarePercentStickLeft]
-                      .ValueOr(0)) /
-          100.0;
-      static const double kCircleToSquareFractionStickRight =
-          static_cast<double>(
-              Globals::GetConfigurationData()
-                  [Strings::kStrConfigurationSectionProperties]
-                  [Strings::kStrConfigurationSettingsPropertiesCircleToSquarePercentStickRight]
-                      .ValueOr(0)) /
-          100.0;
-      static const unsigned int kDeadzonePercentStickLeft = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesDeadzonePercentStickLeft]
-                  .ValueOr(0));
-      static const unsigned int kDeadzonePercentStickRight = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesDeadzonePercentStickRight]
-                  .ValueOr(0));
-      static const unsigned int kDeadzonePercentTriggerLT = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesDeadzonePercentTriggerLT]
-                  .ValueOr(0));
-      static const unsigned int kDeadzonePercentTriggerRT = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesDeadzonePercentTriggerRT]
-                  .ValueOr(0));
-      static const unsigned int kSaturationPercentStickLeft = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesSaturationPercentStickLeft]
-                  .ValueOr(100));
-      static const unsigned int kSaturationPercentStickRight = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesSaturationPercentStickRight]
-                  .ValueOr(100));
-      static const unsigned int kSaturationPercentTriggerLT = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesSaturationPercentTriggerLT]
-                  .ValueOr(100));
-      static const unsigned int kSaturationPercentTriggerRT = static_cast<unsigned int>(
-          Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionProperties]
-              [Strings::kStrConfigurationSettingsPropertiesSaturationPercentTriggerRT]
-                  .ValueOr(100));
+      const Globals::SPropertiesSettings& kProperties = Globals::GetPropertiesSettings();
 
       // If requested by the user, left and right stick values need to be transformed so that a
       // circular field of physical motion is transformed into a square field of virtual motion.
@@ -639,14 +1202,12 @@ namespace Xidi
           Math::TransformCoordinatesCircleToSquare(
               {.x = physicalState[EPhysicalStick::LeftX],
                .y = physicalState[EPhysicalStick::LeftY]},
-              kCircleToSquareFractionStickLeft);
+              kProperties.circleToSquareFractionStickLeft);
       const Math::SAnalogStickCoordinates stickRightCoordinates =
           Math::TransformCoordinatesCircleToSquare(
               {.x = physicalState[EPhysicalStick::RightX],
                .y = physicalState[EPhysicalStick::RightY]},
-              kCircleToSquareFractionStickRight);
-
-      SState controllerState = {};
+              kProperties.circleToSquareFractionStickRight);
 
       // Left and right stick values need to be saturated at the virtual controller range due to a
       // very slight difference between XInput range and virtual controller range. This difference
@@ -655,151 +1216,247 @@ namespace Xidi
       // inverted because XInput presents up as positive and down as negative whereas Xidi needs to
       // do the opposite.
 
-      if (nullptr != elements.named.stickLeftX)
-        elements.named.stickLeftX->ContributeFromAnalogValue(
-            controllerState,
-            Math::ApplyRawAnalogTransform(
-                FilterAnalogStickValue(stickLeftCoordinates.x),
-                kDeadzonePercentStickLeft,
-                kSaturationPercentStickLeft),
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(stickLeftX)));
-      if (nullptr != elements.named.stickLeftY)
-        elements.named.stickLeftY->ContributeFromAnalogValue(
-            controllerState,
-            Math::ApplyRawAnalogTransform(
-                FilterAndInvertAnalogStickValue(stickLeftCoordinates.y),
-                kDeadzonePercentStickLeft,
-                kSaturationPercentStickLeft),
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(stickLeftY)));
-
-      if (nullptr != elements.named.stickRightX)
-        elements.named.stickRightX->ContributeFromAnalogValue(
-            controllerState,
-            Math::ApplyRawAnalogTransform(
-                FilterAnalogStickValue(stickRightCoordinates.x),
-                kDeadzonePercentStickRight,
-                kSaturationPercentStickRight),
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(stickRightX)));
-      if (nullptr != elements.named.stickRightY)
-        elements.named.stickRightY->ContributeFromAnalogValue(
-            controllerState,
-            Math::ApplyRawAnalogTransform(
-                FilterAndInvertAnalogStickValue(stickRightCoordinates.y),
-                kDeadzonePercentStickRight,
-                kSaturationPercentStickRight),
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(stickRightY)));
-
-      if (nullptr != elements.named.dpadUp)
-        elements.named.dpadUp->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::DpadUp],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(dpadUp)));
-      if (nullptr != elements.named.dpadDown)
-        elements.named.dpadDown->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::DpadDown],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(dpadDown)));
-      if (nullptr != elements.named.dpadLeft)
-        elements.named.dpadLeft->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::DpadLeft],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(dpadLeft)));
-      if (nullptr != elements.named.dpadRight)
-        elements.named.dpadRight->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::DpadRight],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(dpadRight)));
+      // In radial deadzone mode the deadzone and saturation for a stick are applied here, to the
+      // whole two-dimensional stick vector at once, which preserves direction and does not
+      // distort diagonals. Sticks transformed radially are then configured as pass-through lanes
+      // in the per-axis batch kernel below.
+      Math::SAnalogStickCoordinates stickLeftFiltered = {
+          .x = FilterAnalogStickValue(stickLeftCoordinates.x),
+          .y = FilterAndInvertAnalogStickValue(stickLeftCoordinates.y)};
+      Math::SAnalogStickCoordinates stickRightFiltered = {
+          .x = FilterAnalogStickValue(stickRightCoordinates.x),
+          .y = FilterAndInvertAnalogStickValue(stickRightCoordinates.y)};
+
+      if (true == kProperties.radialDeadzoneStickLeft)
+        stickLeftFiltered = Math::ApplyRadialAnalogTransform(
+            stickLeftFiltered,
+            kProperties.deadzonePercentStickLeft,
+            kProperties.saturationPercentStickLeft);
+      if (true == kProperties.radialDeadzoneStickRight)
+        stickRightFiltered = Math::ApplyRadialAnalogTransform(
+            stickRightFiltered,
+            kProperties.deadzonePercentStickRight,
+            kProperties.saturationPercentStickRight);
+
+      // Transformed analog and trigger values are prepared once per pass by the vectorized batch
+      // kernels, ordered to match the corresponding mapping step input enumerators so steps can
+      // index them directly.
+      const int16_t rawAnalogValues[4] = {
+          stickLeftFiltered.x,
+          stickLeftFiltered.y,
+          stickRightFiltered.x,
+          stickRightFiltered.y};
+      const Math::SAnalogTransformParams analogTransformParams[4] = {
+          {.deadzonePercent =
+               ((true == kProperties.radialDeadzoneStickLeft)
+                    ? 0
+                    : kProperties.deadzonePercentStickLeft),
+           .saturationPercent =
+               ((true == kProperties.radialDeadzoneStickLeft)
+                    ? 100
+                    : kProperties.saturationPercentStickLeft)},
+          {.deadzonePercent =
+               ((true == kProperties.radialDeadzoneStickLeft)
+                    ? 0
+                    : kProperties.deadzonePercentStickLeft),
+           .saturationPercent =
+               ((true == kProperties.radialDeadzoneStickLeft)
+                    ? 100
+                    : kProperties.saturationPercentStickLeft)},
+          {.deadzonePercent =
+               ((true == kProperties.radialDeadzoneStickRight)
+                    ? 0
+                    : kProperties.deadzonePercentStickRight),
+           .saturationPercent =
+               ((true == kProperties.radialDeadzoneStickRight)
+                    ? 100
+                    : kProperties.saturationPercentStickRight)},
+          {.deadzonePercent =
+               ((true == kProperties.radialDeadzoneStickRight)
+                    ? 0
+                    : kProperties.deadzonePercentStickRight),
+           .saturationPercent =
+               ((true == kProperties.radialDeadzoneStickRight)
+                    ? 100
+                    : kProperties.saturationPercentStickRight)}};
+      int16_t analogValues[4];
+      Math::ApplyRawAnalogTransformBatch(rawAnalogValues, analogTransformParams, analogValues);
+
+      const uint8_t rawTriggerValues[2] = {
+          physicalState[EPhysicalTrigger::LT], physicalState[EPhysicalTrigger::RT]};
+      const Math::SAnalogTransformParams triggerTransformParams[2] = {
+          {.deadzonePercent = kProperties.deadzonePercentTriggerLT,
+           .saturationPercent = kProperties.saturationPercentTriggerLT},
+          {.deadzonePercent = kProperties.deadzonePercentTriggerRT,
+           .saturationPercent = kProperties.saturationPercentTriggerRT}};
+      uint8_t triggerValues[2];
+      Math::ApplyRawTriggerTransformBatch(rawTriggerValues, triggerTransformParams, triggerValues);
+
+      static_assert(
+          ((unsigned int)EMappingStepInput::AnalogStickLeftX == 0) &&
+              (_countof(analogValues) == (unsigned int)EMappingStepInput::TriggerLT) &&
+              ((unsigned int)EMappingStepInput::TriggerRT ==
+               (1 + (unsigned int)EMappingStepInput::TriggerLT)),
+          "Prepared value arrays must line up with mapping step input enumerators.");
+
+      SState controllerState;
+
+      if ((true == mappingStepsSupportIncremental) &&
+          (sourceControllerIdentifier < _countof(incrementalMappingState)))
+      {
+        // Incremental mapping re-runs only those steps whose prepared input changed since the
+        // previous pass for the same controller, resetting each such step's previous contribution
+        // to neutral in the cached output state before the step executes again. This is exact
+        // because incremental support guarantees one side-effect-free step per target element.
+        // Completely-idle controllers are filtered out upstream, so this path pays off whenever a
+        // controller reports motion on only some of its elements, which is the common case.
+        SIncrementalMappingState& cache = incrementalMappingState[sourceControllerIdentifier];
+        const uint32_t buttonValues = static_cast<uint32_t>(physicalState.button.to_ulong());
+
+        std::scoped_lock lock(cache.guard);
+
+        // A change in the consumed element mask invalidates the cache, because elements excluded
+        // by the previous mask hold neutral values in the cached output state and must be
+        // recomputed if they become consumed again.
+        if (cache.consumedElements != consumedElements)
+        {
+          cache.valid = false;
+          cache.consumedElements = consumedElements;
+        }
 
-      if (nullptr != elements.named.triggerLT)
-        elements.named.triggerLT->ContributeFromTriggerValue(
-            controllerState,
-            Math::ApplyRawTriggerTransform(
-                physicalState[EPhysicalTrigger::LT],
-                kDeadzonePercentTriggerLT,
-                kSaturationPercentTriggerLT),
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(triggerLT)));
-      if (nullptr != elements.named.triggerRT)
-        elements.named.triggerRT->ContributeFromTriggerValue(
-            controllerState,
-            Math::ApplyRawTriggerTransform(
-                physicalState[EPhysicalTrigger::RT],
-                kDeadzonePercentTriggerRT,
-                kSaturationPercentTriggerRT),
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(triggerRT)));
-
-      if (nullptr != elements.named.buttonA)
-        elements.named.buttonA->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::A],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonA)));
-      if (nullptr != elements.named.buttonB)
-        elements.named.buttonB->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::B],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonB)));
-      if (nullptr != elements.named.buttonX)
-        elements.named.buttonX->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::X],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonX)));
-      if (nullptr != elements.named.buttonY)
-        elements.named.buttonY->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::Y],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonY)));
+        if (false == cache.valid)
+        {
+          cache.outputState = {};
+          ExecuteMappingSteps(
+              cache.outputState,
+              physicalState,
+              analogValues,
+              triggerValues,
+              sourceControllerIdentifier,
+              consumedElements);
+        }
+        else
+        {
+          for (const SMappingStep& step : mappingSteps)
+          {
+            if (0 == (step.targetElementMask & consumedElements)) continue;
 
-      if (nullptr != elements.named.buttonLB)
-        elements.named.buttonLB->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::LB],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonLB)));
-      if (nullptr != elements.named.buttonRB)
-        elements.named.buttonRB->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::RB],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonRB)));
+            bool inputChanged = false;
 
-      if (nullptr != elements.named.buttonBack)
-        elements.named.buttonBack->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::Back],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonBack)));
-      if (nullptr != elements.named.buttonStart)
-        elements.named.buttonStart->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::Start],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonStart)));
+            switch (step.input)
+            {
+              case EMappingStepInput::AnalogStickLeftX:
+              case EMappingStepInput::AnalogStickLeftY:
+              case EMappingStepInput::AnalogStickRightX:
+              case EMappingStepInput::AnalogStickRightY:
+                inputChanged =
+                    (analogValues[(unsigned int)step.input] !=
+                     cache.analogValues[(unsigned int)step.input]);
+                break;
 
-      if (nullptr != elements.named.buttonLS)
-        elements.named.buttonLS->ContributeFromButtonValue(
-            controllerState,
-            physicalState[EPhysicalButton::LS],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonLS)));
-      if (nullptr != elements.named.buttonRS)
-        elements.named.buttonRS->ContributeFromButtonValue(
+              case EMappingStepInput::TriggerLT:
+              case EMappingStepInput::TriggerRT:
+              {
+                const unsigned int triggerIndex =
+                    (unsigned int)step.input - (unsigned int)EMappingStepInput::TriggerLT;
+                inputChanged = (triggerValues[triggerIndex] != cache.triggerValues[triggerIndex]);
+                break;
+              }
+
+              case EMappingStepInput::Button:
+                inputChanged =
+                    (0 !=
+                     (((buttonValues ^ cache.buttonValues) >> (unsigned int)step.sourceButton) &
+                      1));
+                break;
+
+              default:
+                break;
+            }
+
+            if (false == inputChanged) continue;
+
+            switch (step.targetElement.type)
+            {
+              case EElementType::Axis:
+                cache.outputState[step.targetElement.axis] = kAnalogValueNeutral;
+                break;
+
+              case EElementType::Button:
+                cache.outputState[step.targetElement.button] = false;
+                break;
+
+              case EElementType::Pov:
+                cache.outputState[step.targetPovDirection] = false;
+                break;
+
+              default:
+                break;
+            }
+
+            const uint32_t sourceIdentifier = SourceIdentifierForElementMapper(
+                sourceControllerIdentifier, step.elementMapIndex);
+
+            switch (step.input)
+            {
+              case EMappingStepInput::AnalogStickLeftX:
+              case EMappingStepInput::AnalogStickLeftY:
+              case EMappingStepInput::AnalogStickRightX:
+              case EMappingStepInput::AnalogStickRightY:
+                ContributeFromAnalogValueDirect(
+                    step.elementMapper,
+                    step.type,
+                    cache.outputState,
+                    analogValues[(unsigned int)step.input],
+                    sourceIdentifier);
+                break;
+
+              case EMappingStepInput::TriggerLT:
+              case EMappingStepInput::TriggerRT:
+                ContributeFromTriggerValueDirect(
+                    step.elementMapper,
+                    step.type,
+                    cache.outputState,
+                    triggerValues
+                        [(unsigned int)step.input - (unsigned int)EMappingStepInput::TriggerLT],
+                    sourceIdentifier);
+                break;
+
+              case EMappingStepInput::Button:
+                ContributeFromButtonValueDirect(
+                    step.elementMapper,
+                    step.type,
+                    cache.outputState,
+                    physicalState[step.sourceButton],
+                    sourceIdentifier);
+                break;
+
+              default:
+                break;
+            }
+          }
+        }
+
+        for (unsigned int i = 0; i < _countof(analogValues); ++i)
+          cache.analogValues[i] = analogValues[i];
+        for (unsigned int i = 0; i < _countof(triggerValues); ++i)
+          cache.triggerValues[i] = triggerValues[i];
+        cache.buttonValues = buttonValues;
+        cache.valid = true;
+
+        controllerState = cache.outputState;
+      }
+      else
+      {
+        controllerState = {};
+        ExecuteMappingSteps(
             controllerState,
-            physicalState[EPhysicalButton::RS],
-            SourceIdentifierForElementMapper(
-                sourceControllerIdentifier, ELEMENT_MAP_INDEX_OF(buttonRS)));
+            physicalState,
+            analogValues,
+            triggerValues,
+            sourceControllerIdentifier,
+            consumedElements);
+      }
 
       // Once all contributions have been committed, saturate all axis values at the extreme ends of
       // the allowed range. Doing this at the end means that intermediate contributions are computed
@@ -40,6 +40,12 @@ namespace Xidi
 
     bool MapperBuilder::Build(void)
     {
+      // Blueprints are deliberately built sequentially, with template dependencies resolved by
+      // recursion and memoized via the per-blueprint build flags so each blueprint is built at
+      // most once. Farming independent blueprints out to worker threads is not an option here:
+      // this method runs during DLL initialization, and waiting on threads created while the
+      // loader lock is held deadlocks the process. Mapper registration is also unsynchronized
+      // for the same reason, namely that all mapper construction happens during initialization.
       for (const auto& blueprintItem : blueprints)
       {
         if ((true == blueprintItem.second.buildAttempted) ||
@@ -162,9 +168,28 @@ namespace Xidi
           return nullptr;
         }
 
-        mapperElements = Mapper::GetByName(blueprint.templateName)->CloneElementMap();
-        mapperForceFeedbackActuators =
-            Mapper::GetByName(blueprint.templateName)->GetForceFeedbackActuatorMap();
+        // A blueprint that specifies a template and makes no changes to it describes a mapper
+        // identical to its template. Rather than building a duplicate copy of the entire element
+        // mapper graph, the existing immutable mapper object is interned in the registry under
+        // the new name and shared. This additionally requires that the template's force feedback
+        // actuator map match the default, because built mappers without explicit actuator changes
+        // always receive the default actuator map.
+        if ((true == blueprint.elementChangesFromTemplate.empty()) &&
+            (true == blueprint.ffActuatorChangesFromTemplate.empty()) &&
+            (kTemplateMapper->GetForceFeedbackActuatorMap().named ==
+             Mapper::kDefaultForceFeedbackActuatorMap))
+        {
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Info,
+              L"Mapper %s is identical to its template %s. Sharing one mapper object between both names.",
+              mapperName.data(),
+              blueprint.templateName.data());
+          kTemplateMapper->RegisterAlias(mapperName);
+          return kTemplateMapper;
+        }
+
+        mapperElements = kTemplateMapper->CloneElementMap();
+        mapperForceFeedbackActuators = kTemplateMapper->GetForceFeedbackActuatorMap();
       }
 
       // Loop through all the changes that the blueprint describes and apply them to the starting
@@ -294,6 +319,21 @@ namespace Xidi
       return true;
     }
 
+    bool MapperBuilder::ReopenBlueprint(std::wstring_view mapperName)
+    {
+      const auto blueprintIter = blueprints.find(mapperName);
+      if (blueprints.end() == blueprintIter) return false;
+
+      if (true == blueprintIter->second.buildAttempted)
+      {
+        Mapper::UnregisterAndRetire(mapperName);
+        blueprintIter->second.buildAttempted = false;
+      }
+
+      blueprintIter->second.buildCanAttempt = true;
+      return true;
+    }
+
     bool MapperBuilder::SetBlueprintElementMapper(
         std::wstring_view mapperName,
         unsigned int elementIndex,
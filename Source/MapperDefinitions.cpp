@@ -9,6 +9,7 @@
  *   Definitions of all known mapper types.
  **************************************************************************************************/
 
+#include "CompileTimeMapper.h"
 #include "ControllerTypes.h"
 #include "ElementMapper.h"
 #include "Mapper.h"
@@ -17,121 +18,196 @@ namespace Xidi
 {
   namespace Controller
   {
+    /// Element mappers referenced by the built-in mapper definitions. All are constant-initialized
+    /// so that they, along with the definitions that point to them, occupy read-only image pages
+    /// that are shared across processes, and identical elements are shared between definitions.
+    namespace BuiltInElementMappers
+    {
+      static constexpr AxisMapper kAxisX(EAxis::X);
+      static constexpr AxisMapper kAxisY(EAxis::Y);
+      static constexpr AxisMapper kAxisZ(EAxis::Z);
+      static constexpr AxisMapper kAxisZPositive(EAxis::Z, EAxisDirection::Positive);
+      static constexpr AxisMapper kAxisZNegative(EAxis::Z, EAxisDirection::Negative);
+      static constexpr AxisMapper kAxisRotX(EAxis::RotX);
+      static constexpr AxisMapper kAxisRotY(EAxis::RotY);
+      static constexpr AxisMapper kAxisRotZ(EAxis::RotZ);
+
+      static constexpr DigitalAxisMapper kDigitalAxisX(EAxis::X);
+      static constexpr DigitalAxisMapper kDigitalAxisY(EAxis::Y);
+      static constexpr DigitalAxisMapper kDigitalAxisZ(EAxis::Z);
+      static constexpr DigitalAxisMapper kDigitalAxisRotZ(EAxis::RotZ);
+      static constexpr DigitalAxisMapper kDigitalAxisXNegative(EAxis::X, EAxisDirection::Negative);
+      static constexpr DigitalAxisMapper kDigitalAxisXPositive(EAxis::X, EAxisDirection::Positive);
+      static constexpr DigitalAxisMapper kDigitalAxisYNegative(EAxis::Y, EAxisDirection::Negative);
+      static constexpr DigitalAxisMapper kDigitalAxisYPositive(EAxis::Y, EAxisDirection::Positive);
+
+      static constexpr ButtonMapper kButton1(EButton::B1);
+      static constexpr ButtonMapper kButton2(EButton::B2);
+      static constexpr ButtonMapper kButton3(EButton::B3);
+      static constexpr ButtonMapper kButton4(EButton::B4);
+      static constexpr ButtonMapper kButton5(EButton::B5);
+      static constexpr ButtonMapper kButton6(EButton::B6);
+      static constexpr ButtonMapper kButton7(EButton::B7);
+      static constexpr ButtonMapper kButton8(EButton::B8);
+      static constexpr ButtonMapper kButton9(EButton::B9);
+      static constexpr ButtonMapper kButton10(EButton::B10);
+      static constexpr ButtonMapper kButton11(EButton::B11);
+      static constexpr ButtonMapper kButton12(EButton::B12);
+
+      static constexpr PovMapper kPovUp(EPovDirection::Up);
+      static constexpr PovMapper kPovDown(EPovDirection::Down);
+      static constexpr PovMapper kPovLeft(EPovDirection::Left);
+      static constexpr PovMapper kPovRight(EPovDirection::Right);
+    } // namespace BuiltInElementMappers
+
+    /// Element map definitions for all built-in mapper types, one per type, all
+    /// constant-initialized. Any field that corresponds to an XInput controller element can be
+    /// omitted or assigned `nullptr` and the mapper will simply ignore input from that XInput
+    /// controller element.
+    namespace BuiltInElementMaps
+    {
+      using namespace BuiltInElementMappers;
+
+      static constexpr Mapper::UElementMapDefinition kStandardGamepad(
+          {.stickLeftX = &kAxisX,
+           .stickLeftY = &kAxisY,
+           .stickRightX = &kAxisZ,
+           .stickRightY = &kAxisRotZ,
+           .dpadUp = &kPovUp,
+           .dpadDown = &kPovDown,
+           .dpadLeft = &kPovLeft,
+           .dpadRight = &kPovRight,
+           .triggerLT = &kButton7,
+           .triggerRT = &kButton8,
+           .buttonA = &kButton1,
+           .buttonB = &kButton2,
+           .buttonX = &kButton3,
+           .buttonY = &kButton4,
+           .buttonLB = &kButton5,
+           .buttonRB = &kButton6,
+           .buttonBack = &kButton9,
+           .buttonStart = &kButton10,
+           .buttonLS = &kButton11,
+           .buttonRS = &kButton12});
+
+      static constexpr Mapper::UElementMapDefinition kDigitalGamepad(
+          {.stickLeftX = &kDigitalAxisX,
+           .stickLeftY = &kDigitalAxisY,
+           .stickRightX = &kDigitalAxisZ,
+           .stickRightY = &kDigitalAxisRotZ,
+           .dpadUp = &kDigitalAxisYNegative,
+           .dpadDown = &kDigitalAxisYPositive,
+           .dpadLeft = &kDigitalAxisXNegative,
+           .dpadRight = &kDigitalAxisXPositive,
+           .triggerLT = &kButton7,
+           .triggerRT = &kButton8,
+           .buttonA = &kButton1,
+           .buttonB = &kButton2,
+           .buttonX = &kButton3,
+           .buttonY = &kButton4,
+           .buttonLB = &kButton5,
+           .buttonRB = &kButton6,
+           .buttonBack = &kButton9,
+           .buttonStart = &kButton10,
+           .buttonLS = &kButton11,
+           .buttonRS = &kButton12});
+
+      static constexpr Mapper::UElementMapDefinition kExtendedGamepad(
+          {.stickLeftX = &kAxisX,
+           .stickLeftY = &kAxisY,
+           .stickRightX = &kAxisZ,
+           .stickRightY = &kAxisRotZ,
+           .dpadUp = &kPovUp,
+           .dpadDown = &kPovDown,
+           .dpadLeft = &kPovLeft,
+           .dpadRight = &kPovRight,
+           .triggerLT = &kAxisRotX,
+           .triggerRT = &kAxisRotY,
+           .buttonA = &kButton1,
+           .buttonB = &kButton2,
+           .buttonX = &kButton3,
+           .buttonY = &kButton4,
+           .buttonLB = &kButton5,
+           .buttonRB = &kButton6,
+           .buttonBack = &kButton7,
+           .buttonStart = &kButton8,
+           .buttonLS = &kButton9,
+           .buttonRS = &kButton10});
+
+      static constexpr Mapper::UElementMapDefinition kXInputNative(
+          {.stickLeftX = &kAxisX,
+           .stickLeftY = &kAxisY,
+           .stickRightX = &kAxisRotX,
+           .stickRightY = &kAxisRotY,
+           .dpadUp = &kPovUp,
+           .dpadDown = &kPovDown,
+           .dpadLeft = &kPovLeft,
+           .dpadRight = &kPovRight,
+           .triggerLT = &kAxisZ,
+           .triggerRT = &kAxisRotZ,
+           .buttonA = &kButton1,
+           .buttonB = &kButton2,
+           .buttonX = &kButton3,
+           .buttonY = &kButton4,
+           .buttonLB = &kButton5,
+           .buttonRB = &kButton6,
+           .buttonBack = &kButton7,
+           .buttonStart = &kButton8,
+           .buttonLS = &kButton9,
+           .buttonRS = &kButton10});
+
+      static constexpr Mapper::UElementMapDefinition kXInputSharedTriggers(
+          {.stickLeftX = &kAxisX,
+           .stickLeftY = &kAxisY,
+           .stickRightX = &kAxisRotX,
+           .stickRightY = &kAxisRotY,
+           .dpadUp = &kPovUp,
+           .dpadDown = &kPovDown,
+           .dpadLeft = &kPovLeft,
+           .dpadRight = &kPovRight,
+           .triggerLT = &kAxisZPositive,
+           .triggerRT = &kAxisZNegative,
+           .buttonA = &kButton1,
+           .buttonB = &kButton2,
+           .buttonX = &kButton3,
+           .buttonY = &kButton4,
+           .buttonLB = &kButton5,
+           .buttonRB = &kButton6,
+           .buttonBack = &kButton7,
+           .buttonStart = &kButton8,
+           .buttonLS = &kButton9,
+           .buttonRS = &kButton10});
+    } // namespace BuiltInElementMaps
+
     /// Defines all known mapper types, one element per type. The first element is the default
-    /// mapper. Any field that corresponds to an XInput controller element can be omitted or
-    /// assigned `nullptr` and the mapper will simply ignore input from that XInput controller
-    /// element.
+    /// mapper. Each mapper object clones its definition's element mappers into its own arena at
+    /// construction, so the definitions above stay read-only and allocation-free. Definitions
+    /// composed entirely of plain axis, button, and POV element mappers additionally supply a
+    /// state mapping executor generated at compile time from the same definition, so their full
+    /// mapping passes run as straight-line code with no table walk. The digital gamepad uses
+    /// digital axis element mappers, which the compile-time facility does not support, so it
+    /// keeps the runtime-compiled mapping tables.
     static const Mapper kMappers[] = {
         Mapper(
             L"StandardGamepad",
-            {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
-             .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
-             .stickRightX = std::make_unique<AxisMapper>(EAxis::Z),
-             .stickRightY = std::make_unique<AxisMapper>(EAxis::RotZ),
-             .dpadUp = std::make_unique<PovMapper>(EPovDirection::Up),
-             .dpadDown = std::make_unique<PovMapper>(EPovDirection::Down),
-             .dpadLeft = std::make_unique<PovMapper>(EPovDirection::Left),
-             .dpadRight = std::make_unique<PovMapper>(EPovDirection::Right),
-             .triggerLT = std::make_unique<ButtonMapper>(EButton::B7),
-             .triggerRT = std::make_unique<ButtonMapper>(EButton::B8),
-             .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
-             .buttonB = std::make_unique<ButtonMapper>(EButton::B2),
-             .buttonX = std::make_unique<ButtonMapper>(EButton::B3),
-             .buttonY = std::make_unique<ButtonMapper>(EButton::B4),
-             .buttonLB = std::make_unique<ButtonMapper>(EButton::B5),
-             .buttonRB = std::make_unique<ButtonMapper>(EButton::B6),
-             .buttonBack = std::make_unique<ButtonMapper>(EButton::B9),
-             .buttonStart = std::make_unique<ButtonMapper>(EButton::B10),
-             .buttonLS = std::make_unique<ButtonMapper>(EButton::B11),
-             .buttonRS = std::make_unique<ButtonMapper>(EButton::B12)}),
-        Mapper(
-            L"DigitalGamepad",
-            {.stickLeftX = std::make_unique<DigitalAxisMapper>(EAxis::X),
-             .stickLeftY = std::make_unique<DigitalAxisMapper>(EAxis::Y),
-             .stickRightX = std::make_unique<DigitalAxisMapper>(EAxis::Z),
-             .stickRightY = std::make_unique<DigitalAxisMapper>(EAxis::RotZ),
-             .dpadUp = std::make_unique<DigitalAxisMapper>(EAxis::Y, EAxisDirection::Negative),
-             .dpadDown = std::make_unique<DigitalAxisMapper>(EAxis::Y, EAxisDirection::Positive),
-             .dpadLeft = std::make_unique<DigitalAxisMapper>(EAxis::X, EAxisDirection::Negative),
-             .dpadRight = std::make_unique<DigitalAxisMapper>(EAxis::X, EAxisDirection::Positive),
-             .triggerLT = std::make_unique<ButtonMapper>(EButton::B7),
-             .triggerRT = std::make_unique<ButtonMapper>(EButton::B8),
-             .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
-             .buttonB = std::make_unique<ButtonMapper>(EButton::B2),
-             .buttonX = std::make_unique<ButtonMapper>(EButton::B3),
-             .buttonY = std::make_unique<ButtonMapper>(EButton::B4),
-             .buttonLB = std::make_unique<ButtonMapper>(EButton::B5),
-             .buttonRB = std::make_unique<ButtonMapper>(EButton::B6),
-             .buttonBack = std::make_unique<ButtonMapper>(EButton::B9),
-             .buttonStart = std::make_unique<ButtonMapper>(EButton::B10),
-             .buttonLS = std::make_unique<ButtonMapper>(EButton::B11),
-             .buttonRS = std::make_unique<ButtonMapper>(EButton::B12)}),
+            BuiltInElementMaps::kStandardGamepad,
+            Mapper::kDefaultForceFeedbackActuatorMap,
+            CompileTimeMapper::Executor<BuiltInElementMaps::kStandardGamepad>),
+        Mapper(L"DigitalGamepad", BuiltInElementMaps::kDigitalGamepad),
         Mapper(
             L"ExtendedGamepad",
-            {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
-             .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
-             .stickRightX = std::make_unique<AxisMapper>(EAxis::Z),
-             .stickRightY = std::make_unique<AxisMapper>(EAxis::RotZ),
-             .dpadUp = std::make_unique<PovMapper>(EPovDirection::Up),
-             .dpadDown = std::make_unique<PovMapper>(EPovDirection::Down),
-             .dpadLeft = std::make_unique<PovMapper>(EPovDirection::Left),
-             .dpadRight = std::make_unique<PovMapper>(EPovDirection::Right),
-             .triggerLT = std::make_unique<AxisMapper>(EAxis::RotX),
-             .triggerRT = std::make_unique<AxisMapper>(EAxis::RotY),
-             .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
-             .buttonB = std::make_unique<ButtonMapper>(EButton::B2),
-             .buttonX = std::make_unique<ButtonMapper>(EButton::B3),
-             .buttonY = std::make_unique<ButtonMapper>(EButton::B4),
-             .buttonLB = std::make_unique<ButtonMapper>(EButton::B5),
-             .buttonRB = std::make_unique<ButtonMapper>(EButton::B6),
-             .buttonBack = std::make_unique<ButtonMapper>(EButton::B7),
-             .buttonStart = std::make_unique<ButtonMapper>(EButton::B8),
-             .buttonLS = std::make_unique<ButtonMapper>(EButton::B9),
-             .buttonRS = std::make_unique<ButtonMapper>(EButton::B10)}),
-
+            BuiltInElementMaps::kExtendedGamepad,
+            Mapper::kDefaultForceFeedbackActuatorMap,
+            CompileTimeMapper::Executor<BuiltInElementMaps::kExtendedGamepad>),
         Mapper(
             L"XInputNative",
-            {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
-             .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
-             .stickRightX = std::make_unique<AxisMapper>(EAxis::RotX),
-             .stickRightY = std::make_unique<AxisMapper>(EAxis::RotY),
-             .dpadUp = std::make_unique<PovMapper>(EPovDirection::Up),
-             .dpadDown = std::make_unique<PovMapper>(EPovDirection::Down),
-             .dpadLeft = std::make_unique<PovMapper>(EPovDirection::Left),
-             .dpadRight = std::make_unique<PovMapper>(EPovDirection::Right),
-             .triggerLT = std::make_unique<AxisMapper>(EAxis::Z),
-             .triggerRT = std::make_unique<AxisMapper>(EAxis::RotZ),
-             .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
-             .buttonB = std::make_unique<ButtonMapper>(EButton::B2),
-             .buttonX = std::make_unique<ButtonMapper>(EButton::B3),
-             .buttonY = std::make_unique<ButtonMapper>(EButton::B4),
-             .buttonLB = std::make_unique<ButtonMapper>(EButton::B5),
-             .buttonRB = std::make_unique<ButtonMapper>(EButton::B6),
-             .buttonBack = std::make_unique<ButtonMapper>(EButton::B7),
-             .buttonStart = std::make_unique<ButtonMapper>(EButton::B8),
-             .buttonLS = std::make_unique<ButtonMapper>(EButton::B9),
-             .buttonRS = std::make_unique<ButtonMapper>(EButton::B10)}),
+            BuiltInElementMaps::kXInputNative,
+            Mapper::kDefaultForceFeedbackActuatorMap,
+            CompileTimeMapper::Executor<BuiltInElementMaps::kXInputNative>),
         Mapper(
             L"XInputSharedTriggers",
-            {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
-             .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
-             .stickRightX = std::make_unique<AxisMapper>(EAxis::RotX),
-             .stickRightY = std::make_unique<AxisMapper>(EAxis::RotY),
-             .dpadUp = std::make_unique<PovMapper>(EPovDirection::Up),
-             .dpadDown = std::make_unique<PovMapper>(EPovDirection::Down),
-             .dpadLeft = std::make_unique<PovMapper>(EPovDirection::Left),
-             .dpadRight = std::make_unique<PovMapper>(EPovDirection::Right),
-             .triggerLT = std::make_unique<AxisMapper>(EAxis::Z, EAxisDirection::Positive),
-             .triggerRT = std::make_unique<AxisMapper>(EAxis::Z, EAxisDirection::Negative),
-             .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
-             .buttonB = std::make_unique<ButtonMapper>(EButton::B2),
-             .buttonX = std::make_unique<ButtonMapper>(EButton::B3),
-             .buttonY = std::make_unique<ButtonMapper>(EButton::B4),
-             .buttonLB = std::make_unique<ButtonMapper>(EButton::B5),
-             .buttonRB = std::make_unique<ButtonMapper>(EButton::B6),
-             .buttonBack = std::make_unique<ButtonMapper>(EButton::B7),
-             .buttonStart = std::make_unique<ButtonMapper>(EButton::B8),
-             .buttonLS = std::make_unique<ButtonMapper>(EButton::B9),
-             .buttonRS = std::make_unique<ButtonMapper>(EButton::B10)})};
+            BuiltInElementMaps::kXInputSharedTriggers,
+            Mapper::kDefaultForceFeedbackActuatorMap,
+            CompileTimeMapper::Executor<BuiltInElementMaps::kXInputSharedTriggers>)};
   } // namespace Controller
 } // namespace Xidi
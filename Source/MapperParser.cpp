@@ -12,12 +12,18 @@
 
 #include "MapperParser.h"
 
+#include <bit>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <cwchar>
 #include <cwctype>
 #include <map>
+#include <utility>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <string_view>
 
 #include <Infra/Core/Strings.h>
@@ -29,6 +35,7 @@
 #include "ForceFeedbackTypes.h"
 #include "Keyboard.h"
 #include "Mapper.h"
+#include "MemoryAccounting.h"
 #include "Mouse.h"
 
 namespace Xidi
@@ -70,6 +77,80 @@ namespace Xidi
           kCharElementMapperParamSeparator,
           L'\0'};
 
+      /// Computes a hash of a string for use with the compile-time string lookup tables in this
+      /// module. Implements the 32-bit FNV-1a algorithm over the characters of the string.
+      /// @param [in] stringToHash String whose hash is to be computed.
+      /// @return Hash of the string.
+      static constexpr uint32_t ComputeStringHash(std::wstring_view stringToHash)
+      {
+        uint32_t hash = 2166136261u;
+
+        for (const wchar_t hashChar : stringToHash)
+        {
+          hash ^= (uint32_t)hashChar;
+          hash *= 16777619u;
+        }
+
+        return hash;
+      }
+
+      /// Hash table over a fixed vocabulary of strings, constructed entirely at compile time.
+      /// Lookups hash the query string once and then probe linearly, so recognized tokens resolve
+      /// in constant expected time rather than the logarithmic number of full string comparisons
+      /// an ordered map would perform. Capacity is fixed at double the vocabulary size, rounded up
+      /// to a power of two, which bounds the load factor and keeps probe sequences short.
+      /// @tparam ValueType Type of value associated with each string in the vocabulary.
+      /// @tparam kNumEntries Number of strings in the vocabulary.
+      template <typename ValueType, size_t kNumEntries> class StringLookupTable
+      {
+      public:
+
+        /// Type used to supply the vocabulary at construction time.
+        using TEntry = std::pair<std::wstring_view, ValueType>;
+
+        constexpr StringLookupTable(const TEntry (&entries)[kNumEntries]) : keys(), values()
+        {
+          for (const TEntry& entry : entries)
+          {
+            size_t slot = ComputeStringHash(entry.first) % kNumSlots;
+            while (false == keys[slot].empty())
+              slot = ((slot + 1) % kNumSlots);
+
+            keys[slot] = entry.first;
+            values[slot] = entry.second;
+          }
+        }
+
+        /// Looks up the specified query string in this table.
+        /// @param [in] query String to look up.
+        /// @return Associated value, if the string is part of the vocabulary.
+        constexpr std::optional<ValueType> Find(std::wstring_view query) const
+        {
+          size_t slot = ComputeStringHash(query) % kNumSlots;
+
+          // An empty slot terminates the probe sequence. One is guaranteed to exist because the
+          // table holds at most half as many entries as it has slots.
+          while (false == keys[slot].empty())
+          {
+            if (query == keys[slot]) return values[slot];
+            slot = ((slot + 1) % kNumSlots);
+          }
+
+          return std::nullopt;
+        }
+
+      private:
+
+        /// Number of slots in the table.
+        static constexpr size_t kNumSlots = std::bit_ceil(2 * kNumEntries);
+
+        /// Vocabulary strings, positioned by probing. Empty entries are unoccupied slots.
+        std::wstring_view keys[kNumSlots];
+
+        /// Values associated with the corresponding elements of #keys.
+        ValueType values[kNumSlots];
+      };
+
       /// Type for all functions that attempt to build individual element mappers given a parameter
       /// string.
       using TMakeElementMapperFunc = ElementMapperOrError (*)(std::wstring_view);
@@ -697,9 +778,9 @@ namespace Xidi
       std::optional<unsigned int> FindControllerElementIndex(
           std::wstring_view controllerElementString)
       {
-        // Map of strings representing controller elements to indices within the element map data
+        // Table of strings representing controller elements to indices within the element map data
         // structure. One pair exists per field in the SElementMap structure.
-        static const std::map<std::wstring_view, unsigned int> kControllerElementStrings = {
+        static constexpr StringLookupTable<unsigned int, 21> kControllerElementStrings({
             {L"StickLeftX", ELEMENT_MAP_INDEX_OF(stickLeftX)},
             {L"StickLeftY", ELEMENT_MAP_INDEX_OF(stickLeftY)},
             {L"StickRightX", ELEMENT_MAP_INDEX_OF(stickRightX)},
@@ -719,13 +800,10 @@ namespace Xidi
             {L"ButtonBack", ELEMENT_MAP_INDEX_OF(buttonBack)},
             {L"ButtonStart", ELEMENT_MAP_INDEX_OF(buttonStart)},
             {L"ButtonLS", ELEMENT_MAP_INDEX_OF(buttonLS)},
-            {L"ButtonRS", ELEMENT_MAP_INDEX_OF(buttonRS)}};
+            {L"ButtonRS", ELEMENT_MAP_INDEX_OF(buttonRS)},
+            {L"ButtonGuide", ELEMENT_MAP_INDEX_OF(buttonGuide)}});
 
-        const auto controllerElementIter = kControllerElementStrings.find(controllerElementString);
-        if (kControllerElementStrings.cend() == controllerElementIter)
-          return std::nullopt;
-        else
-          return controllerElementIter->second;
+        return kControllerElementStrings.Find(controllerElementString);
       }
 
       std::optional<unsigned int> FindForceFeedbackActuatorIndex(std::wstring_view ffActuatorString)
@@ -743,14 +821,19 @@ namespace Xidi
           return ffActuatorIter->second;
       }
 
-      ElementMapperOrError ElementMapperFromString(std::wstring_view elementMapperString)
+      /// Parses a complete element mapper from the supplied string without consulting the parsed
+      /// prototype cache. This is the full tokenize-and-build pass over the string.
+      /// @param [in] elementMapperString Input string supposedly representing an element mapper.
+      /// @return Pointer to the new mapper object if successful, error message otherwise.
+      static ElementMapperOrError ParseElementMapperFromString(
+          std::wstring_view elementMapperString)
       {
         const std::optional<unsigned int> maybeRecursionDepth =
             ComputeRecursionDepth(elementMapperString);
         if (false == maybeRecursionDepth.has_value())
-          return Infra::Strings::Format(L"Syntax error: Unbalanced parentheses").Data();
+          return L"Syntax error: Unbalanced parentheses";
 
-        const unsigned int kRecursionDepth = ComputeRecursionDepth(elementMapperString).value();
+        const unsigned int kRecursionDepth = maybeRecursionDepth.value();
         if (kRecursionDepth > kElementMapperMaxRecursionDepth)
           return Infra::Strings::Format(
                      L"Nesting depth %u exceeds limit of %u",
@@ -769,15 +852,74 @@ namespace Xidi
         return std::move(parseResult.maybeElementMapper);
       }
 
+      /// Serializes access to the parsed element mapper prototype cache.
+      static std::mutex parsedPrototypeGuard;
+
+      /// Parsed element mapper prototype cache. Custom mapper configurations frequently repeat
+      /// the same element mapper strings, both across multiple mapper definitions and across
+      /// elements within a single definition. Parsing runs during DLL initialization, so repeated
+      /// strings are served by cloning a prototype built the first time the string was seen
+      /// instead of re-parsing. Guarded by #parsedPrototypeGuard.
+      static std::map<std::wstring, std::unique_ptr<IElementMapper>, std::less<>> parsedPrototypes;
+
+      /// Estimated number of bytes held by the parsed prototype cache, covering its key strings
+      /// and container entries but not the prototype objects themselves. Guarded by
+      /// #parsedPrototypeGuard.
+      static uint64_t parsedPrototypesBytesEstimate = 0;
+
+      void ClearParsedPrototypeCache(void)
+      {
+        std::unique_lock lock(parsedPrototypeGuard);
+        parsedPrototypes.clear();
+        MemoryAccounting::RecordRelease(
+            MemoryAccounting::ESubsystem::ParseCaches, parsedPrototypesBytesEstimate);
+        parsedPrototypesBytesEstimate = 0;
+      }
+
+      ElementMapperOrError ElementMapperFromString(std::wstring_view elementMapperString)
+      {
+        {
+          std::unique_lock lock(parsedPrototypeGuard);
+
+          const auto parsedPrototypeIter = parsedPrototypes.find(elementMapperString);
+          if (parsedPrototypes.cend() != parsedPrototypeIter)
+            return parsedPrototypeIter->second->Clone();
+        }
+
+        ElementMapperOrError parseResult = ParseElementMapperFromString(elementMapperString);
+
+        // Null element mappers parse to an empty pointer, which is both impossible to clone and
+        // trivial to re-parse, so only non-empty successful results are worth caching.
+        if ((true == parseResult.HasValue()) && (nullptr != parseResult.Value()))
+        {
+          std::unique_lock lock(parsedPrototypeGuard);
+
+          if (parsedPrototypes.cend() == parsedPrototypes.find(elementMapperString))
+          {
+            const uint64_t numBytesEstimate =
+                ((elementMapperString.size() * sizeof(wchar_t)) +
+                 sizeof(decltype(parsedPrototypes)::value_type));
+            parsedPrototypesBytesEstimate += numBytesEstimate;
+            MemoryAccounting::RecordAllocation(
+                MemoryAccounting::ESubsystem::ParseCaches, numBytesEstimate);
+
+            parsedPrototypes.emplace(
+                std::wstring(elementMapperString), parseResult.Value()->Clone());
+          }
+        }
+
+        return parseResult;
+      }
+
       ForceFeedbackActuatorOrError ForceFeedbackActuatorFromString(
           std::wstring_view ffActuatorString)
       {
         const std::optional<unsigned int> maybeRecursionDepth =
             ComputeRecursionDepth(ffActuatorString);
         if (false == maybeRecursionDepth.has_value())
-          return Infra::Strings::Format(L"Syntax error: Unbalanced parentheses").Data();
+          return L"Syntax error: Unbalanced parentheses";
 
-        const unsigned int kRecursionDepth = ComputeRecursionDepth(ffActuatorString).value();
+        const unsigned int kRecursionDepth = maybeRecursionDepth.value();
         if (kRecursionDepth > 1) return L"Nesting is not allowed for force feedback actuators";
 
         return ParseForceFeedbackActuator(ffActuatorString);
@@ -1264,8 +1406,8 @@ namespace Xidi
 
       SElementMapperParseResult ParseSingleElementMapper(std::wstring_view elementMapperString)
       {
-        static const std::map<std::wstring_view, TMakeElementMapperFunc>
-            kMakeElementMapperFunctions = {
+        static constexpr StringLookupTable<TMakeElementMapperFunc, 40>
+            kMakeElementMapperFunctions({
                 {L"axis", &MakeAxisMapper},
                 {L"Axis", &MakeAxisMapper},
 
@@ -1315,7 +1457,7 @@ namespace Xidi
                 {L"Nil", &MakeNullMapper},
 
                 {L"split", &MakeSplitMapper},
-                {L"Split", &MakeSplitMapper}};
+                {L"Split", &MakeSplitMapper}});
 
         const std::optional<SStringParts> maybeElementMapperStringParts =
             ExtractElementMapperStringParts(elementMapperString);
@@ -1330,9 +1472,9 @@ namespace Xidi
         if (true == elementMapperStringParts.type.empty())
           return {.maybeElementMapper = L"Missing or unparseable element mapper type."};
 
-        const auto makeElementMapperIter =
-            kMakeElementMapperFunctions.find(elementMapperStringParts.type);
-        if (kMakeElementMapperFunctions.cend() == makeElementMapperIter)
+        const std::optional<TMakeElementMapperFunc> maybeMakeElementMapperFunc =
+            kMakeElementMapperFunctions.Find(elementMapperStringParts.type);
+        if (false == maybeMakeElementMapperFunc.has_value())
           return {
               .maybeElementMapper = Infra::Strings::Format(
                                         L"%s: Unrecognized element mapper type",
@@ -1340,14 +1482,15 @@ namespace Xidi
                                         .Data()};
 
         return {
-            .maybeElementMapper = makeElementMapperIter->second(elementMapperStringParts.params),
+            .maybeElementMapper =
+                maybeMakeElementMapperFunc.value()(elementMapperStringParts.params),
             .remainingString = elementMapperStringParts.remaining};
       }
 
       ForceFeedbackActuatorOrError ParseForceFeedbackActuator(std::wstring_view ffActuatorString)
       {
-        static const std::map<std::wstring_view, TMakeForceFeedbackActuatorFunc>
-            kMakeForceFeedbackActuatorFunctions = {
+        static constexpr StringLookupTable<TMakeForceFeedbackActuatorFunc, 22>
+            kMakeForceFeedbackActuatorFunctions({
                 {L"disable", &MakeForceFeedbackActuatorDisabled},
                 {L"Disable", &MakeForceFeedbackActuatorDisabled},
                 {L"disabled", &MakeForceFeedbackActuatorDisabled},
@@ -1372,7 +1515,7 @@ namespace Xidi
                 {L"SingleAxis", &MakeForceFeedbackActuatorSingleAxis},
 
                 {L"magnitudeprojection", &MakeForceFeedbackActuatorMagnitudeProjection},
-                {L"MagnitudeProjection", &MakeForceFeedbackActuatorMagnitudeProjection}};
+                {L"MagnitudeProjection", &MakeForceFeedbackActuatorMagnitudeProjection}});
 
         const std::optional<SStringParts> maybeForceFeedbackActuatorStringParts =
             ExtractForceFeedbackActuatorStringParts(ffActuatorString);
@@ -1386,15 +1529,15 @@ namespace Xidi
         if (true == kForceFeedbackActuatorStringParts.type.empty())
           return L"Missing or unparseable element mapper type.";
 
-        const auto makeForceFeedbackActuatorIter =
-            kMakeForceFeedbackActuatorFunctions.find(kForceFeedbackActuatorStringParts.type);
-        if (kMakeForceFeedbackActuatorFunctions.cend() == makeForceFeedbackActuatorIter)
+        const std::optional<TMakeForceFeedbackActuatorFunc> maybeMakeForceFeedbackActuatorFunc =
+            kMakeForceFeedbackActuatorFunctions.Find(kForceFeedbackActuatorStringParts.type);
+        if (false == maybeMakeForceFeedbackActuatorFunc.has_value())
           return Infra::Strings::Format(
                      L"%s: Unrecognized force feedback actuator mode",
                      std::wstring(kForceFeedbackActuatorStringParts.type).c_str())
               .Data();
 
-        return makeForceFeedbackActuatorIter->second(kForceFeedbackActuatorStringParts.params);
+        return maybeMakeForceFeedbackActuatorFunc.value()(kForceFeedbackActuatorStringParts.params);
       }
     } // namespace MapperParser
   }   // namespace Controller
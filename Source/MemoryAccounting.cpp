@@ -0,0 +1,82 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file MemoryAccounting.cpp
+ *   Implementation of per-subsystem live memory accounting and of the low-memory operating mode.
+ **************************************************************************************************/
+
+#include "MemoryAccounting.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "ApiXidi.h"
+#include "Globals.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace MemoryAccounting
+  {
+    /// Number of bytes currently held live, per subsystem. Counters are constant-initialized so
+    /// they are usable from static initializers of other translation units.
+    static std::atomic<uint64_t> subsystemLiveBytes[(unsigned int)ESubsystem::Count];
+
+    void RecordAllocation(ESubsystem subsystem, uint64_t numBytes)
+    {
+      subsystemLiveBytes[(unsigned int)subsystem].fetch_add(numBytes, std::memory_order_relaxed);
+    }
+
+    void RecordRelease(ESubsystem subsystem, uint64_t numBytes)
+    {
+      subsystemLiveBytes[(unsigned int)subsystem].fetch_sub(numBytes, std::memory_order_relaxed);
+    }
+
+    uint64_t GetLiveBytes(ESubsystem subsystem)
+    {
+      return subsystemLiveBytes[(unsigned int)subsystem].load(std::memory_order_relaxed);
+    }
+
+    bool IsLowMemoryModeEnabled(void)
+    {
+      static const bool lowMemoryModeEnabled = []() -> bool
+      {
+        const auto& properties = Globals::GetConfigurationData()[Globals::
+            ApplicableConfigurationSection(Strings::kStrConfigurationSectionProperties)];
+        return properties[Strings::kStrConfigurationSettingsPropertiesLowMemoryMode].ValueOr(
+            false);
+      }();
+
+      return lowMemoryModeEnabled;
+    }
+
+    /// Implements the Xidi API interface #Xidi::Api::IMemoryAccounting.
+    class MemoryAccountingProvider : public Api::IMemoryAccounting
+    {
+    public:
+
+      // IMemoryAccounting
+      SMemorySnapshot GetMemorySnapshot(void) const override
+      {
+        static_assert(
+            kSubsystemCount == (unsigned int)ESubsystem::Count,
+            "Subsystem count mismatch between the Xidi API and the accounting implementation.");
+
+        SMemorySnapshot memorySnapshot = {.lowMemoryModeEnabled = IsLowMemoryModeEnabled()};
+
+        for (unsigned int subsystemIndex = 0; subsystemIndex < kSubsystemCount; ++subsystemIndex)
+          memorySnapshot.subsystemBytesLive[subsystemIndex] =
+              GetLiveBytes((ESubsystem)subsystemIndex);
+
+        return memorySnapshot;
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static MemoryAccountingProvider memoryAccountingProvider;
+  } // namespace MemoryAccounting
+} // namespace Xidi
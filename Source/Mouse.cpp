@@ -15,33 +15,29 @@
 #include <concurrent_unordered_map.h>
 
 #include <array>
-#include <bitset>
+#include <atomic>
+#include <bit>
 #include <cstdint>
-#include <mutex>
 #include <optional>
-#include <stop_token>
-#include <thread>
 #include <vector>
 
-#include <Infra/Core/Message.h>
-#include <Infra/Core/Mutex.h>
-
-#include "ApiBitSet.h"
 #include "ApiWindows.h"
 #include "ControllerTypes.h"
 #include "Globals.h"
-#include "Strings.h"
+#include "ImportApiWinMM.h"
+#include "InputDispatch.h"
+#include "Profiler.h"
 
 namespace Xidi
 {
   namespace Mouse
   {
-    /// Type used to represent the state of a virtual mouse's buttons.
-    using TButtonState = BitSetEnum<EMouseButton>;
+    /// Type used to represent the state of a virtual mouse's buttons, one bit per button.
+    using TButtonState = uint32_t;
 
-    /// Type used to represent individually-sourced mouse movement contributions. Operations allowed
-    /// are read, append, and update.
-    using TMouseMovementContributions = concurrency::concurrent_unordered_map<uint32_t, int>;
+    static_assert(
+        (unsigned int)EMouseButton::Count <= (8 * sizeof(TButtonState)),
+        "Mouse button state type must have room for one bit per button.");
 
     /// Type used to represent individually-sourced mouse speed contributions, which override the
     /// global default mouse speed scaling factor. Only one contribution is actually effective at
@@ -50,16 +46,90 @@ namespace Xidi
     using TMouseSpeedContributions =
         concurrency::concurrent_unordered_map<uint32_t, std::optional<unsigned int>>;
 
-    /// Tracks mouse state contributions and generates mouse state snapshots.
-    class StateContributionTracker
+    /// Fixed-capacity lock-free table of individually-sourced mouse movement contributions for a
+    /// single mouse axis. Since mouse movements are always relative, each source's latest
+    /// contribution persists until overwritten. A slot is claimed by the first submission from a
+    /// new source and remains assigned to that source thereafter, so a steady-state submission
+    /// from the mapping hot path is a short probe followed by a single atomic store.
+    class MovementContributionTable
     {
     public:
 
-      inline StateContributionTracker(void)
+      /// Total number of contribution slots. Must be a power of two. Sources are identified per
+      /// physical controller and element mapper, so this comfortably exceeds the number of
+      /// mouse-mapped elements that can contribute to one axis simultaneously.
+      static constexpr unsigned int kNumSlots = 128;
+
+      /// Accumulates and returns the sum of all contributions currently present in this table.
+      /// @return Sum of all contributions, in internal mouse movement units.
+      inline int SumContributions(void) const
       {
-        ResetButtons();
+        int contributionSum = 0;
+
+        for (unsigned int slot = 0; slot < kNumSlots; ++slot)
+        {
+          if (0 != slotOwners[slot].load(std::memory_order_acquire))
+            contributionSum += slotValues[slot].load(std::memory_order_relaxed);
+        }
+
+        return contributionSum;
       }
 
+      /// Submits a mouse movement. Either claims a slot for a new source or updates the slot
+      /// already assigned to an existing source. In the extremely unlikely event that the table
+      /// is completely full, the contribution is dropped.
+      /// @param [in] mouseMovementUnits Number of internal mouse movement units along the target
+      /// mouse axis.
+      /// @param [in] sourceIdentifier Opaque identifier for the source of the mouse movement
+      /// event.
+      inline void Submit(int mouseMovementUnits, uint32_t sourceIdentifier)
+      {
+        // Slot owner values are offset by 1 so that 0 can mean the slot is free.
+        const uint32_t slotOwner = 1 + sourceIdentifier;
+
+        for (unsigned int probe = 0; probe < kNumSlots; ++probe)
+        {
+          const unsigned int slot = (sourceIdentifier + probe) % kNumSlots;
+
+          uint32_t existingOwner = slotOwners[slot].load(std::memory_order_acquire);
+          if (0 == existingOwner)
+          {
+            if ((false ==
+                 slotOwners[slot].compare_exchange_strong(
+                     existingOwner, slotOwner, std::memory_order_acq_rel)) &&
+                (slotOwner != existingOwner))
+              continue;
+          }
+          else if (slotOwner != existingOwner)
+          {
+            continue;
+          }
+
+          slotValues[slot].store(mouseMovementUnits, std::memory_order_release);
+          return;
+        }
+      }
+
+    private:
+
+      /// Slot ownership markers. A value of 0 means the slot is free, and any other value
+      /// identifies the owning source as the value minus 1.
+      std::atomic<uint32_t> slotOwners[kNumSlots];
+
+      /// Per-slot contribution values, in internal mouse movement units. Valid only for slots
+      /// that have an owner; a freshly-claimed slot reads as neutral until its first value store
+      /// becomes visible, which is harmless.
+      std::atomic<int> slotValues[kNumSlots];
+    };
+
+    /// Tracks mouse state contributions and generates mouse state snapshots. Button contributions
+    /// are staged into atomic bit fields so that the mapping hot path marks buttons with single
+    /// lock-free operations, never contending on a mutex with the thread that synthesizes mouse
+    /// events.
+    class StateContributionTracker
+    {
+    public:
+
       /// Determines if the specified mouse button is marked as having been pressed since the last
       /// snapshot. A mouse button marked pressed can also be marked released. The two are not
       /// mutually exclusive.
@@ -67,26 +137,21 @@ namespace Xidi
       /// @return `true` if it is marked pressed, `false` if not.
       inline bool IsMarkedPressed(EMouseButton button) const
       {
-        return pressedButtons.contains((unsigned int)button);
+        return (
+            0 !=
+            (pressedButtons.load(std::memory_order_relaxed) & (1u << (unsigned int)button)));
       }
 
       /// Determines if the specified mouse button is marked as having been released since the last
       /// snapshot. A mouse button marked released can also be marked pressed. The two are not
       /// mutually exclusive.
-      /// @param [in] key Identifier of the mouse button of interest.
+      /// @param [in] button Identifier of the mouse button of interest.
       /// @return `true` if it is marked released, `false` if not.
       inline bool IsMarkedReleased(EMouseButton button) const
       {
-        return !(notReleasedButtons.contains((unsigned int)button));
-      }
-
-      /// Locks this object for ensuring proper concurrency control of mouse button operations.
-      /// The returned lock object is scoped and, as a result, will automatically unlock upon its
-      /// destruction.
-      /// @return Scoped lock object that has acquired this object's concurrency control mutex.
-      inline std::unique_lock<Infra::Mutex> LockButtonState(void)
-      {
-        return std::unique_lock(mouseButtonStateGuard);
+        return (
+            0 !=
+            (releasedButtons.load(std::memory_order_relaxed) & (1u << (unsigned int)button)));
       }
 
       /// Registers a mouse button press contribution.
@@ -95,7 +160,7 @@ namespace Xidi
       /// @param [in] button Identifier of the target mouse button.
       inline void MarkPressed(EMouseButton button)
       {
-        pressedButtons.insert((unsigned int)button);
+        pressedButtons.fetch_or((1u << (unsigned int)button), std::memory_order_relaxed);
       }
 
       /// Registers a mouse button release contribution.
@@ -104,37 +169,32 @@ namespace Xidi
       /// @param [in] button Identifier of the target mouse button.
       inline void MarkRelease(EMouseButton button)
       {
-        notReleasedButtons.erase((unsigned int)button);
+        releasedButtons.fetch_or((1u << (unsigned int)button), std::memory_order_relaxed);
       }
 
       /// Retrieves a read-only reference to all mouse movement contributions on all axes.
       /// @return Read-only reference to the mouse movement contribution tracking data structure.
-      inline const std::array<TMouseMovementContributions, (unsigned int)EMouseAxis::Count>&
+      inline const std::array<MovementContributionTable, (unsigned int)EMouseAxis::Count>&
           MovementContributions(void)
       {
         return mouseMovementContributions;
       }
 
-      /// Computes the next mouse button snapshot by applying the marked changes to the specified
-      /// previous snapshot. Afterwards, resets internal state so no mouse buttons are marked as
+      /// Computes the next mouse button snapshot by consuming the marked changes and applying
+      /// them to the specified previous snapshot. Afterwards, no mouse buttons are marked as
       /// pressed or released.
       /// @param [in] previousSnapshot Previous snapshot against which to apply the marked changes.
-      inline TButtonState ButtonSnapshotRelativeTo(const TButtonState& previousSnapshot)
+      inline TButtonState ButtonSnapshotRelativeTo(TButtonState previousSnapshot)
       {
+        const TButtonState pressedSnapshot =
+            pressedButtons.exchange(0, std::memory_order_relaxed);
+        const TButtonState releasedSnapshot =
+            releasedButtons.exchange(0, std::memory_order_relaxed);
+
         // If a mouse button is marked pressed since the last snapshot, then no matter what it is
         // pressed in the next snapshot. Otherwise, a mouse button continues to be pressed if it was
         // pressed in the last snapshot and not released since.
-        const TButtonState nextSnapshot = pressedButtons | (previousSnapshot & notReleasedButtons);
-
-        ResetButtons();
-        return nextSnapshot;
-      }
-
-      /// Computes a mouse button state snapshot using only the marked changes.
-      /// Afterwards, resets internal state so no keys are marked as pressed or released.
-      inline TButtonState ButtonSnapshot(void)
-      {
-        return ButtonSnapshotRelativeTo(TButtonState());
+        return (pressedSnapshot | (previousSnapshot & ~releasedSnapshot));
       }
 
       /// Determines the effective mouse speed scaling factor override, given all of the
@@ -152,13 +212,6 @@ namespace Xidi
         return std::nullopt;
       }
 
-      /// Resets all marked button contributions back to empty.
-      inline void ResetButtons(void)
-      {
-        pressedButtons.clear();
-        notReleasedButtons.fill();
-      }
-
       /// Submits a mouse movement. Either inserts a contribution from a new source or updates the
       /// contribution from an existing source.
       /// @param [in] axis Mouse axis that is affected.
@@ -168,7 +221,8 @@ namespace Xidi
       inline void SubmitMouseMovement(
           EMouseAxis axis, int mouseMovementUnits, uint32_t sourceIdentifier)
       {
-        mouseMovementContributions[(unsigned int)axis][sourceIdentifier] = mouseMovementUnits;
+        mouseMovementContributions[(unsigned int)axis].Submit(
+            mouseMovementUnits, sourceIdentifier);
       }
 
       /// Submits a mouse speed override. Either inserts a contribution from a new source or updates
@@ -185,339 +239,372 @@ namespace Xidi
 
     private:
 
-      /// Set of buttons marked "pressed" since the last snapshot.
-      TButtonState pressedButtons;
-
-      /// Inverted set of buttons marked "released" since the last snapshot.
-      /// Buttons present in this set have not been marked released since the last snapshot.
-      TButtonState notReleasedButtons;
+      /// Set of buttons marked "pressed" since the last snapshot, one bit per button.
+      std::atomic<TButtonState> pressedButtons;
 
-      /// For ensuring proper concurrency control of accesses to the virtual mouse button state
-      /// represented by this object.
-      Infra::Mutex mouseButtonStateGuard;
+      /// Set of buttons marked "released" since the last snapshot, one bit per button.
+      std::atomic<TButtonState> releasedButtons;
 
-      /// Individually-sourced mouse movement contributions, one per mouse axis. Since mouse
+      /// Individually-sourced mouse movement contributions, one table per mouse axis. Since mouse
       /// movements are always relative, only one state data structure is needed for each mouse
       /// axis.
-      std::array<TMouseMovementContributions, (unsigned int)EMouseAxis::Count>
+      std::array<MovementContributionTable, (unsigned int)EMouseAxis::Count>
           mouseMovementContributions;
 
       /// Individually-sourced mouse speed contributions. Holds override contributions.
       TMouseSpeedContributions mouseSpeedContributions;
     };
 
-    /// Manages a thread that continuously runs and updates the physical mouse state from virtual
-    /// mouse state. Wraps the thread handle to ensure safe termination and clean-up.
-    class MouseUpdateThread
-    {
-    public:
-
-      inline MouseUpdateThread(StateContributionTracker& mouseTracker)
-          : mouseUpdateThread(), mouseUpdateStop(), mouseTracker(mouseTracker)
-      {}
+    /// Holds changes to mouse state since the last snapshot.
+    /// Virtual mouse state snapshots are maintained by the input dispatch thread.
+    static StateContributionTracker mouseTracker;
 
-      /// Safely exits the keyboard update thread if it is started.
-      ~MouseUpdateThread(void)
+    /// Most recent virtual mouse button state snapshot, maintained across invocations of
+    /// #AppendPendingMouseEvents. No synchronization is needed because only the input dispatch
+    /// thread reads or writes it.
+    static TButtonState previousMouseButtonState = 0;
+
+    /// Generates a mouse input event descriptor for a state change in a mouse button.
+    /// @param [in] button Identifier of the target mouse button.
+    /// @param [in] newStateIsPressed New state of the target mouse button after transitioning,
+    /// `true` for pressed or `false` for unpressed.
+    /// @return Filled out mouse input event descriptor.
+    static constexpr MOUSEINPUT MouseInputEventForButtonTransition(
+        EMouseButton button, bool newStateIsPressed)
+    {
+      switch (button)
       {
-        Exit();
+        case EMouseButton::Left:
+          if (true == newStateIsPressed)
+            return {.mouseData = 0, .dwFlags = MOUSEEVENTF_LEFTDOWN};
+          else
+            return {.mouseData = 0, .dwFlags = MOUSEEVENTF_LEFTUP};
+
+        case EMouseButton::Middle:
+          if (true == newStateIsPressed)
+            return {.mouseData = 0, .dwFlags = MOUSEEVENTF_MIDDLEDOWN};
+          else
+            return {.mouseData = 0, .dwFlags = MOUSEEVENTF_MIDDLEUP};
+
+        case EMouseButton::Right:
+          if (true == newStateIsPressed)
+            return {.mouseData = 0, .dwFlags = MOUSEEVENTF_RIGHTDOWN};
+          else
+            return {.mouseData = 0, .dwFlags = MOUSEEVENTF_RIGHTUP};
+
+        case EMouseButton::X1:
+          if (true == newStateIsPressed)
+            return {.mouseData = XBUTTON1, .dwFlags = MOUSEEVENTF_XDOWN};
+          else
+            return {.mouseData = XBUTTON1, .dwFlags = MOUSEEVENTF_XUP};
+
+        case EMouseButton::X2:
+          if (true == newStateIsPressed)
+            return {.mouseData = XBUTTON2, .dwFlags = MOUSEEVENTF_XDOWN};
+          else
+            return {.mouseData = XBUTTON2, .dwFlags = MOUSEEVENTF_XUP};
+
+        default:
+          return {};
       }
+    }
 
-      /// Terminates the mouse update thread.
-      inline void Exit(void)
-      {
-        if (true == mouseUpdateThread.joinable())
-        {
-          mouseUpdateStop.request_stop();
-          mouseUpdateThread.join();
-        }
-      }
+    /// Index into the per-button input event templates for a button press event.
+    static constexpr unsigned int kInputTemplateIndexPress = 0;
 
-      /// Starts running the mouse update thread.
-      inline void Start(void)
-      {
-        if ((false == mouseUpdateThread.joinable()) && (false == mouseUpdateStop.stop_requested()))
-        {
-          mouseUpdateThread =
-              std::thread(UpdatePhysicalMouseState, &mouseTracker, mouseUpdateStop.get_token());
-        }
-      }
+    /// Index into the per-button input event templates for a button release event.
+    static constexpr unsigned int kInputTemplateIndexRelease = 1;
 
-    private:
+    /// Fully-populated mouse input event templates, two per mouse button: press at
+    /// #kInputTemplateIndexPress and release at #kInputTemplateIndexRelease. Built once at module
+    /// initialization so that emitting a button event is a single copy of a template with no
+    /// per-event descriptor construction. Movement events are not templated because their payload
+    /// field varies per event anyway.
+    static const std::array<std::array<INPUT, 2>, (unsigned int)EMouseButton::Count>
+        kMouseButtonInputTemplates = []()
+    {
+      std::array<std::array<INPUT, 2>, (unsigned int)EMouseButton::Count> inputTemplates = {};
 
-      /// Generates a mouse input event descriptor for a state change in a mouse button.
-      /// @param [in] button Identifier of the target mouse button.
-      /// @param [in] newStateIsPressed New state of the target mouse button after transitioning,
-      /// `true` for pressed or `false` for unpressed.
-      /// @return Filled out mouse input event descriptor.
-      static MOUSEINPUT MouseInputEventForButtonTransition(
-          EMouseButton button, bool newStateIsPressed)
+      for (unsigned int buttonIndex = 0; buttonIndex < (unsigned int)EMouseButton::Count;
+           ++buttonIndex)
       {
-        switch (button)
-        {
-          case EMouseButton::Left:
-            if (true == newStateIsPressed)
-              return {.mouseData = 0, .dwFlags = MOUSEEVENTF_LEFTDOWN};
-            else
-              return {.mouseData = 0, .dwFlags = MOUSEEVENTF_LEFTUP};
-
-          case EMouseButton::Middle:
-            if (true == newStateIsPressed)
-              return {.mouseData = 0, .dwFlags = MOUSEEVENTF_MIDDLEDOWN};
-            else
-              return {.mouseData = 0, .dwFlags = MOUSEEVENTF_MIDDLEUP};
-
-          case EMouseButton::Right:
-            if (true == newStateIsPressed)
-              return {.mouseData = 0, .dwFlags = MOUSEEVENTF_RIGHTDOWN};
-            else
-              return {.mouseData = 0, .dwFlags = MOUSEEVENTF_RIGHTUP};
-
-          case EMouseButton::X1:
-            if (true == newStateIsPressed)
-              return {.mouseData = XBUTTON1, .dwFlags = MOUSEEVENTF_XDOWN};
-            else
-              return {.mouseData = XBUTTON1, .dwFlags = MOUSEEVENTF_XUP};
-
-          case EMouseButton::X2:
-            if (true == newStateIsPressed)
-              return {.mouseData = XBUTTON2, .dwFlags = MOUSEEVENTF_XDOWN};
-            else
-              return {.mouseData = XBUTTON2, .dwFlags = MOUSEEVENTF_XUP};
-
-          default:
-            return {};
-        }
+        inputTemplates[buttonIndex][kInputTemplateIndexPress] = INPUT(
+            {.type = INPUT_MOUSE,
+             .mi = MouseInputEventForButtonTransition((EMouseButton)buttonIndex, true)});
+        inputTemplates[buttonIndex][kInputTemplateIndexRelease] = INPUT(
+            {.type = INPUT_MOUSE,
+             .mi = MouseInputEventForButtonTransition((EMouseButton)buttonIndex, false)});
       }
 
-      /// Generates a mouse input event descriptor for a mouse movement event.
-      /// @param [in] axis Identifier of the target mouse axis.
-      /// @param [in] numPixels Number of pixels of mouse movement along the target axis.
-      /// @return Filled out mouse input event descriptor.
-      static MOUSEINPUT MouseInputEventForMovement(EMouseAxis axis, int mouseMovementPixels)
+      return inputTemplates;
+    }();
+
+    /// Generates a mouse input event descriptor for a mouse movement event.
+    /// @param [in] axis Identifier of the target mouse axis.
+    /// @param [in] numPixels Number of pixels of mouse movement along the target axis.
+    /// @return Filled out mouse input event descriptor.
+    static MOUSEINPUT MouseInputEventForMovement(EMouseAxis axis, int mouseMovementPixels)
+    {
+      switch (axis)
       {
-        switch (axis)
-        {
-          case EMouseAxis::X:
-            return {.dx = mouseMovementPixels, .dwFlags = MOUSEEVENTF_MOVE};
-
-          case EMouseAxis::Y:
-            return {.dy = mouseMovementPixels, .dwFlags = MOUSEEVENTF_MOVE};
-
-          case EMouseAxis::WheelHorizontal:
-            return {.mouseData = (DWORD)mouseMovementPixels, .dwFlags = MOUSEEVENTF_HWHEEL};
-
-          case EMouseAxis::WheelVertical:
-            // Vertical mouse wheel needs inversion to be semantically consistent with up being
-            // negative and down being positive for other mouse and game controller axes.
-            // Ordinarily, positive is "forward, away from the user" (up) and negative is "backward,
-            // towards the user" (down). See
-            // https://learn.microsoft.com/en-us/windows/win32/api/winuser/ns-winuser-mouseinput for
-            // more information.
-            return {.mouseData = (DWORD)(-mouseMovementPixels), .dwFlags = MOUSEEVENTF_WHEEL};
-
-          default:
-            return {};
-        }
+        case EMouseAxis::X:
+          return {.dx = mouseMovementPixels, .dwFlags = MOUSEEVENTF_MOVE};
+
+        case EMouseAxis::Y:
+          return {.dy = mouseMovementPixels, .dwFlags = MOUSEEVENTF_MOVE};
+
+        case EMouseAxis::WheelHorizontal:
+          return {.mouseData = (DWORD)mouseMovementPixels, .dwFlags = MOUSEEVENTF_HWHEEL};
+
+        case EMouseAxis::WheelVertical:
+          // Vertical mouse wheel needs inversion to be semantically consistent with up being
+          // negative and down being positive for other mouse and game controller axes.
+          // Ordinarily, positive is "forward, away from the user" (up) and negative is "backward,
+          // towards the user" (down). See
+          // https://learn.microsoft.com/en-us/windows/win32/api/winuser/ns-winuser-mouseinput for
+          // more information.
+          return {.mouseData = (DWORD)(-mouseMovementPixels), .dwFlags = MOUSEEVENTF_WHEEL};
+
+        default:
+          return {};
       }
+    }
 
-      /// Converts internal mouse movement units to pixels.
-      /// @param [in] mouseMovementUnits Number of internal mouse movement units to be converted.
-      /// @param [in] mouseSpeedScalingFactorOverride Mouse speed scaling factor override in effect.
-      /// If not present, then the configured mouse speed scaling factor is used.
-      /// @return Appropriate number of pixels represented by the mouse movement units.
-      static int MouseMovementUnitsToPixels(
-          int mouseMovementUnits, std::optional<unsigned int> mouseSpeedScalingFactorOverride)
-      {
-        static const int kDefaultSpeedScalingFactor = static_cast<const int>(
-            Globals::GetConfigurationData()
-                [Strings::kStrConfigurationSectionProperties]
-                [Strings::kStrConfigurationSettingPropertiesMouseSpeedScalingFactorPercent]
-                    .ValueOr(100));
+    /// Sub-pixel movement remainders, one per mouse axis, carried across invocations of
+    /// #AppendPendingMouseEvents so that slow movements integrate correctly instead of being
+    /// truncated away each cycle. No synchronization is needed because only the input dispatch
+    /// thread reads or writes them.
+    static double mouseMovementSubPixelRemainders[(unsigned int)EMouseAxis::Count];
+
+    /// Timestamp of the most recent movement pass, used to pace movement independently of how
+    /// often the dispatch thread wakes up. Discrete events wake the dispatch thread immediately,
+    /// so without self-pacing a rapid-fire button would cause extra movement passes and
+    /// accelerate the pointer. No synchronization is needed because only the input dispatch
+    /// thread reads or writes it.
+    static DWORD lastMovementPassTimeMilliseconds = 0;
+
+    /// Indicates whether any mouse axis had a non-neutral contribution during the most recent
+    /// movement pass. Allows invocations that skip the movement pass to report whether periodic
+    /// synthesis is still needed. No synchronization is needed because only the input dispatch
+    /// thread reads or writes it.
+    static bool movementWasInProgress = false;
+
+    /// Computes the scaling factor used to convert internal mouse movement units to pixels per
+    /// cycle. The factor depends only on the effective speed percentage, which changes rarely
+    /// relative to how often it is consumed, so the most recent derivation is cached and per-cycle
+    /// conversion reduces to a single multiply per axis. No synchronization is needed on the
+    /// cache because only the input dispatch thread invokes this function.
+    /// @param [in] mouseSpeedScalingFactorOverride Mouse speed scaling factor override in effect.
+    /// If not present, then the configured mouse speed scaling factor is used.
+    /// @return Number of pixels, including any fractional part, represented by one internal mouse
+    /// movement unit.
+    static double MouseMovementConversionScalingFactor(
+        std::optional<unsigned int> mouseSpeedScalingFactorOverride)
+    {
+      static unsigned int previousEffectiveSpeedPercent = ~(0u);
+      static double cachedConversionScalingFactor = 0.0;
+
+      const unsigned int effectiveSpeedPercent = mouseSpeedScalingFactorOverride.value_or(
+          Globals::GetPropertiesSettings().mouseSpeedScalingFactorPercent);
 
+      if (effectiveSpeedPercent != previousEffectiveSpeedPercent)
+      {
         constexpr double kMillisecondsPerSecond = 1000.0;
         constexpr double kPollingPeriodsPerSecond =
             (kMillisecondsPerSecond / (double)kMouseUpdatePeriodMilliseconds);
 
-        const double speedScalingFactor =
-            static_cast<double>(
-                mouseSpeedScalingFactorOverride.value_or(kDefaultSpeedScalingFactor)) /
-            100.0;
+        const double speedScalingFactor = static_cast<double>(effectiveSpeedPercent) / 100.0;
 
         const double fastestPixelsPerSecond = 2000.0 * speedScalingFactor;
         const double fastestPixelsPerPollingPeriod =
             fastestPixelsPerSecond / kPollingPeriodsPerSecond;
-        const double conversionScalingFactor = fastestPixelsPerPollingPeriod /
-            ((kMouseMovementUnitsMax - kMouseMovementUnitsMin) / 2.0);
 
-        return static_cast<int>(
-            static_cast<double>(mouseMovementUnits - kMouseMovementUnitsNeutral) *
-            conversionScalingFactor);
+        cachedConversionScalingFactor = fastestPixelsPerPollingPeriod /
+            ((kMouseMovementUnitsMax - kMouseMovementUnitsMin) / 2.0);
+        previousEffectiveSpeedPercent = effectiveSpeedPercent;
       }
 
-      /// Periodically checks for changes between the previous and next views of the virtual mouse
-      /// button states. On detected state change, generates and submits a mouse input event to the
-      /// system.
-      /// @param [in] mouseTracker Pointer to the mouse state contribution tracker object to use for
-      /// updates.
-      /// @param [in] mouseUpdateStopToken Stop token used to indicate that this method should
-      /// terminate.
-      static void UpdatePhysicalMouseState(
-          StateContributionTracker* mouseTracker, std::stop_token mouseUpdateStopToken)
+      return cachedConversionScalingFactor;
+    }
+
+    bool AppendPendingMouseEvents(std::vector<INPUT>& inputEvents, bool forceNeutralState)
+    {
+      const Profiler::ScopedSample profileSample(Profiler::EProfileSite::MouseSynthesis);
+
+      // Mouse buttons
       {
-        std::vector<INPUT> mouseEvents;
-        mouseEvents.reserve(
-            static_cast<size_t>(EMouseAxis::Count) + static_cast<size_t>(EMouseButton::Count));
+        TButtonState nextMouseButtonState =
+            mouseTracker.ButtonSnapshotRelativeTo(previousMouseButtonState);
+
+        if (true == forceNeutralState) nextMouseButtonState = 0;
 
-        TButtonState previousMouseButtonState;
+        TButtonState transitionedButtons = nextMouseButtonState ^ previousMouseButtonState;
 
-        while (true)
+        while (0 != transitionedButtons)
         {
-          Sleep(kMouseUpdatePeriodMilliseconds);
+          const EMouseButton transitionedButton =
+              (EMouseButton)((unsigned int)std::countr_zero(transitionedButtons));
+          transitionedButtons &= (transitionedButtons - 1);
+
+          const bool transitionIsFromUnpressedToPressed =
+              (0 != (nextMouseButtonState & (1u << (unsigned int)transitionedButton)));
+
+          inputEvents.push_back(
+              kMouseButtonInputTemplates[(unsigned int)transitionedButton]
+                                        [(true == transitionIsFromUnpressedToPressed)
+                                             ? kInputTemplateIndexPress
+                                             : kInputTemplateIndexRelease]);
+        }
 
-          const bool haveInputFocus = Globals::DoesCurrentProcessHaveInputFocus();
-          const bool terminationRequested = mouseUpdateStopToken.stop_requested();
+        previousMouseButtonState = nextMouseButtonState;
+      }
 
-          // Mouse buttons
-          {
-            auto lock = mouseTracker->LockButtonState();
+      // Mouse movement
+      if (false == forceNeutralState)
+      {
+        // Button and wheel events above flush on every invocation, but movement self-paces to
+        // the mouse update period and scales by the time actually elapsed. This decouples the
+        // two: an early wake-up for a discrete event neither accelerates the pointer with an
+        // extra movement pass nor delays it, because a late pass emits proportionally more
+        // motion.
+        const DWORD currentTimeMilliseconds = ImportApiWinMM::timeGetTime();
 
-            TButtonState nextMouseButtonState =
-                mouseTracker->ButtonSnapshotRelativeTo(previousMouseButtonState);
+        double elapsedMovementPeriods = 0.0;
 
-            // If the current process does not have input focus or this thread is exiting then all
-            // pressed keys should be submitted to the system as released.
-            if ((false == haveInputFocus) || (true == terminationRequested))
-              nextMouseButtonState.clear();
+        if (false == movementWasInProgress)
+        {
+          // Movement is just starting, so there is no previous pass to measure against. Emit one
+          // period's worth of motion and begin pacing from now.
+          elapsedMovementPeriods = 1.0;
+        }
+        else
+        {
+          const DWORD elapsedMilliseconds =
+              currentTimeMilliseconds - lastMovementPassTimeMilliseconds;
+          if (elapsedMilliseconds >= kMouseUpdatePeriodMilliseconds)
+            elapsedMovementPeriods =
+                static_cast<double>(elapsedMilliseconds) /
+                static_cast<double>(kMouseUpdatePeriodMilliseconds);
+        }
 
-            const TButtonState transitionedButtons =
-                nextMouseButtonState ^ previousMouseButtonState;
+        if (0.0 != elapsedMovementPeriods)
+        {
+          const std::array<MovementContributionTable, (unsigned int)EMouseAxis::Count>&
+              mouseMovementContributions = mouseTracker.MovementContributions();
 
-            for (auto transitionedButtonsIter : transitionedButtons)
-            {
-              const EMouseButton transitionedButton =
-                  (EMouseButton)((unsigned int)transitionedButtonsIter);
-              const bool transitionIsFromUnpressedToPressed =
-                  (nextMouseButtonState.contains((unsigned int)transitionedButton));
-
-              mouseEvents.emplace_back(INPUT(
-                  {.type = INPUT_MOUSE,
-                   .mi = MouseInputEventForButtonTransition(
-                       (EMouseButton)transitionedButton, transitionIsFromUnpressedToPressed)}));
-            }
+          // The speed override lookup walks a concurrent container, so it is hoisted out of the
+          // per-axis loop and resolved to a conversion factor once per pass.
+          const double conversionScalingFactor = MouseMovementConversionScalingFactor(
+              mouseTracker.GetMouseSpeedScalingFactorOverride());
 
-            previousMouseButtonState = nextMouseButtonState;
-          }
+          bool anyAxisNonNeutral = false;
 
-          // Mouse movement
-          if ((true == haveInputFocus) && (false == terminationRequested))
+          for (size_t axisIndex = 0; axisIndex < mouseMovementContributions.size(); ++axisIndex)
           {
-            const std::array<TMouseMovementContributions, (unsigned int)EMouseAxis::Count>&
-                mouseMovementContributions = mouseTracker->MovementContributions();
+            int axisMovementUnits = mouseMovementContributions[axisIndex].SumContributions();
 
-            for (size_t axisIndex = 0; axisIndex < mouseMovementContributions.size(); ++axisIndex)
+            if (kMouseMovementUnitsNeutral != axisMovementUnits)
             {
-              const TMouseMovementContributions& axisMovementContributions =
-                  mouseMovementContributions[axisIndex];
-              int axisMovementUnits = 0;
-
-              for (const auto& contribution : axisMovementContributions)
-                axisMovementUnits += contribution.second;
-
-              if (kMouseMovementUnitsNeutral != axisMovementUnits)
-              {
-                if (axisMovementUnits > kMouseMovementUnitsMax)
-                  axisMovementUnits = kMouseMovementUnitsMax;
-                else if (axisMovementUnits < kMouseMovementUnitsMin)
-                  axisMovementUnits = kMouseMovementUnitsMin;
-
-                const int axisMovementPixels = MouseMovementUnitsToPixels(
-                    axisMovementUnits, mouseTracker->GetMouseSpeedScalingFactorOverride());
-                if (0 != axisMovementPixels)
-                  mouseEvents.emplace_back(INPUT(
-                      {.type = INPUT_MOUSE,
-                       .mi =
-                           MouseInputEventForMovement((EMouseAxis)axisIndex, axisMovementPixels)}));
-              }
+              if (axisMovementUnits > kMouseMovementUnitsMax)
+                axisMovementUnits = kMouseMovementUnitsMax;
+              else if (axisMovementUnits < kMouseMovementUnitsMin)
+                axisMovementUnits = kMouseMovementUnitsMin;
+
+              // Movements slower than one pixel per pass would be truncated away entirely, so the
+              // fractional part is carried across passes and contributes to a whole pixel of
+              // motion once enough of it accumulates.
+              const double axisMovementPixelsExact =
+                  (static_cast<double>(axisMovementUnits - kMouseMovementUnitsNeutral) *
+                   conversionScalingFactor * elapsedMovementPeriods) +
+                  mouseMovementSubPixelRemainders[axisIndex];
+              const int axisMovementPixels = static_cast<int>(axisMovementPixelsExact);
+              mouseMovementSubPixelRemainders[axisIndex] =
+                  axisMovementPixelsExact - static_cast<double>(axisMovementPixels);
+
+              if (0 != axisMovementPixels)
+                inputEvents.emplace_back(INPUT(
+                    {.type = INPUT_MOUSE,
+                     .mi =
+                         MouseInputEventForMovement((EMouseAxis)axisIndex, axisMovementPixels)}));
+
+              // Even if this pass's motion stayed below one pixel, periodic synthesis must
+              // continue so the remainder keeps integrating.
+              anyAxisNonNeutral = true;
+            }
+            else
+            {
+              // A neutral axis starts its next movement gesture fresh rather than inheriting a
+              // stale remainder from the previous one.
+              mouseMovementSubPixelRemainders[axisIndex] = 0.0;
             }
-          };
-
-          if (mouseEvents.size() > 0)
-          {
-            SendInput((UINT)mouseEvents.size(), mouseEvents.data(), (int)sizeof(INPUT));
-            mouseEvents.clear();
           }
 
-          if (true == terminationRequested) break;
+          lastMovementPassTimeMilliseconds = currentTimeMilliseconds;
+          movementWasInProgress = anyAxisNonNeutral;
         }
       }
+      else
+      {
+        for (double& subPixelRemainder : mouseMovementSubPixelRemainders)
+          subPixelRemainder = 0.0;
 
-      /// Handle for the update thread itself.
-      std::thread mouseUpdateThread;
-
-      /// Stop indicator to be used for exiting the keyboard update thread when needed.
-      std::stop_source mouseUpdateStop;
-
-      /// Mouse state contribution tracker object that should be used during the updates.
-      StateContributionTracker& mouseTracker;
-    };
-
-    /// Holds changes to mouse state since the last snapshot.
-    /// Virtual mouse state snapshots are maintained by the thread that periodically updates
-    /// physical mouse state.
-    static StateContributionTracker mouseTracker;
-
-    /// Singleton object that wraps the mouse update thread.
-    static MouseUpdateThread mouseUpdateThread(mouseTracker);
+        movementWasInProgress = false;
+      }
 
-    /// Initializes internal data structures, creates internal threads, and begins periodically
-    /// checking for mouse events that need to be submitted. Idempotent and concurrency-safe.
-    static void InitializeAndBeginUpdating(void)
-    {
-      static std::once_flag initFlag;
-      std::call_once(
-          initFlag,
-          []() -> void
-          {
-            mouseUpdateThread.Start();
-            Infra::Message::OutputFormatted(
-                Infra::Message::ESeverity::Info,
-                L"Initialized the mouse event thread. Desired update period is %u ms.",
-                kMouseUpdatePeriodMilliseconds);
-          });
+      return ((0 != previousMouseButtonState) || (true == movementWasInProgress));
     }
 
     void SubmitMouseButtonPressedState(EMouseButton button)
     {
-      InitializeAndBeginUpdating();
+      InputDispatch::EnsureDispatchThreadRunning();
 
+      // The check avoids a read-modify-write operation, and a wake of the dispatch thread, in
+      // the common steady-state case of a button being re-marked before the dispatch thread has
+      // taken its next snapshot.
       if (false == mouseTracker.IsMarkedPressed(button))
       {
-        auto lock = mouseTracker.LockButtonState();
         mouseTracker.MarkPressed(button);
+        InputDispatch::RecordContributionReceived();
+        InputDispatch::WakeDispatchThread();
+      }
+      else
+      {
+        InputDispatch::RecordContributionCoalesced();
       }
     }
 
     void SubmitMouseButtonReleasedState(EMouseButton button)
     {
-      InitializeAndBeginUpdating();
+      InputDispatch::EnsureDispatchThreadRunning();
 
       if (false == mouseTracker.IsMarkedReleased(button))
       {
-        auto lock = mouseTracker.LockButtonState();
         mouseTracker.MarkRelease(button);
+        InputDispatch::RecordContributionReceived();
+        InputDispatch::WakeDispatchThread();
+      }
+      else
+      {
+        InputDispatch::RecordContributionCoalesced();
       }
     }
 
     void SubmitMouseMovement(EMouseAxis axis, int mouseMovementUnits, uint32_t sourceIdentifier)
     {
-      InitializeAndBeginUpdating();
+      InputDispatch::EnsureDispatchThreadRunning();
       mouseTracker.SubmitMouseMovement(axis, mouseMovementUnits, sourceIdentifier);
+      InputDispatch::RecordContributionReceived();
+
+      // Movement contributions are resubmitted on every mapping poll, so waking the dispatch
+      // thread unconditionally here would cost an event signal per poll. The conditional wake
+      // only signals when the dispatch thread has actually gone idle.
+      InputDispatch::WakeDispatchThreadIfIdle();
     }
 
     void SubmitMouseSpeedOverride(
         std::optional<unsigned int> mouseSpeedScalingFactor, uint32_t sourceIdentifier)
     {
-      InitializeAndBeginUpdating();
+      InputDispatch::EnsureDispatchThreadRunning();
       mouseTracker.SubmitMouseSpeedOverride(mouseSpeedScalingFactor, sourceIdentifier);
     }
   } // namespace Mouse
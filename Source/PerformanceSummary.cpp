@@ -0,0 +1,172 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file PerformanceSummary.cpp
+ *   Implementation of the per-session performance summary emitted when the Xidi library is
+ *   unloaded.
+ **************************************************************************************************/
+
+#include "PerformanceSummary.h"
+
+#include <cstdint>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiXidi.h"
+
+namespace Xidi
+{
+  namespace PerformanceSummary
+  {
+    /// Estimates a latency percentile from a fixed-bucket histogram by locating the bucket that
+    /// contains the requested percentile of all samples and reporting that bucket's upper bound.
+    /// The final bucket is unbounded, so a percentile landing there is reported as the largest
+    /// finite bucket bound.
+    /// @param [in] bucketCounts Number of samples in each histogram bucket.
+    /// @param [in] bucketUpperBoundsMicroseconds Upper bound of each histogram bucket.
+    /// @param [in] bucketCount Number of buckets in the histogram.
+    /// @param [in] percent Percentile of interest, from 1 to 100.
+    /// @return Upper bound, in microseconds, of the bucket containing the requested percentile,
+    /// or 0 if the histogram holds no samples at all.
+    static uint64_t HistogramPercentileMicroseconds(
+        const uint64_t* bucketCounts,
+        const uint64_t* bucketUpperBoundsMicroseconds,
+        unsigned int bucketCount,
+        unsigned int percent)
+    {
+      uint64_t totalSampleCount = 0;
+      for (unsigned int bucket = 0; bucket < bucketCount; ++bucket)
+        totalSampleCount += bucketCounts[bucket];
+      if (0 == totalSampleCount) return 0;
+
+      const uint64_t targetSampleCount = (((totalSampleCount * (uint64_t)percent) + 99) / 100);
+
+      uint64_t cumulativeSampleCount = 0;
+      for (unsigned int bucket = 0; bucket < bucketCount; ++bucket)
+      {
+        cumulativeSampleCount += bucketCounts[bucket];
+        if (cumulativeSampleCount >= targetSampleCount)
+        {
+          if ((bucket == (bucketCount - 1)) && (bucket > 0))
+            return bucketUpperBoundsMicroseconds[bucket - 1];
+          return bucketUpperBoundsMicroseconds[bucket];
+        }
+      }
+
+      return bucketUpperBoundsMicroseconds[bucketCount - 1];
+    }
+
+    void EmitSessionSummary(void)
+    {
+      if (false == Infra::Message::WillOutputMessageOfSeverity(Infra::Message::ESeverity::Info))
+        return;
+
+      const Api::IInputMetrics* const inputMetrics = reinterpret_cast<Api::IInputMetrics*>(
+          XidiApiGetInterface(Api::EClass::InputMetrics));
+      const Api::ISynthesisStatistics* const synthesisStatistics =
+          reinterpret_cast<Api::ISynthesisStatistics*>(
+              XidiApiGetInterface(Api::EClass::SynthesisStatistics));
+      const Api::IMemoryAccounting* const memoryAccounting =
+          reinterpret_cast<Api::IMemoryAccounting*>(
+              XidiApiGetInterface(Api::EClass::MemoryAccounting));
+
+      if (nullptr != inputMetrics)
+      {
+        const Api::IInputMetrics::SPollingLoopStatistics pollingLoopStatistics =
+            inputMetrics->GetPollingLoopStatistics();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Session performance summary: %llu state polls (%llu overruns) and %llu force feedback actuation cycles (%llu overruns).",
+            pollingLoopStatistics.wakeupCount[0],
+            pollingLoopStatistics.overrunCount[0],
+            pollingLoopStatistics.wakeupCount[1],
+            pollingLoopStatistics.overrunCount[1]);
+
+        const Api::IInputMetrics::SHistograms histograms = inputMetrics->GetHistograms();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Session performance summary: poll-to-refresh latency p50/p99 = %llu/%llu us, refresh-to-read latency p50/p99 = %llu/%llu us, lock wait p99 = %llu us.",
+            HistogramPercentileMicroseconds(
+                histograms.pollToRefreshLatency,
+                Api::IInputMetrics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+                Api::IInputMetrics::kLatencyHistogramBucketCount,
+                50),
+            HistogramPercentileMicroseconds(
+                histograms.pollToRefreshLatency,
+                Api::IInputMetrics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+                Api::IInputMetrics::kLatencyHistogramBucketCount,
+                99),
+            HistogramPercentileMicroseconds(
+                histograms.refreshToReadLatency,
+                Api::IInputMetrics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+                Api::IInputMetrics::kLatencyHistogramBucketCount,
+                50),
+            HistogramPercentileMicroseconds(
+                histograms.refreshToReadLatency,
+                Api::IInputMetrics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+                Api::IInputMetrics::kLatencyHistogramBucketCount,
+                99),
+            HistogramPercentileMicroseconds(
+                histograms.lockWaitTime,
+                Api::IInputMetrics::kLockWaitHistogramBucketUpperBoundsMicroseconds,
+                Api::IInputMetrics::kLockWaitHistogramBucketCount,
+                99));
+
+        const Api::IInputMetrics::SEventBufferCounters eventBufferCounters =
+            inputMetrics->GetEventBufferCounters();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Session performance summary: %llu event buffer overflows dropped %llu events, high-water mark of %u events.",
+            eventBufferCounters.overflowCount,
+            eventBufferCounters.droppedEventCount,
+            eventBufferCounters.highWaterMarkEvents);
+      }
+
+      if (nullptr != synthesisStatistics)
+      {
+        const Api::ISynthesisStatistics::SCounters synthesisCounters =
+            synthesisStatistics->GetCounters();
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Session performance summary: %llu synthesis contributions (%llu coalesced) produced %llu injected events (%llu dropped) across %llu dispatch cycles, injection latency p50/p99 = %llu/%llu us.",
+            synthesisCounters.contributionsReceived,
+            synthesisCounters.contributionsCoalesced,
+            synthesisCounters.eventsEmitted,
+            synthesisCounters.eventsDropped,
+            synthesisCounters.dispatchCycles,
+            HistogramPercentileMicroseconds(
+                synthesisCounters.injectionLatencyHistogram,
+                Api::ISynthesisStatistics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+                Api::ISynthesisStatistics::kLatencyHistogramBucketCount,
+                50),
+            HistogramPercentileMicroseconds(
+                synthesisCounters.injectionLatencyHistogram,
+                Api::ISynthesisStatistics::kLatencyHistogramBucketUpperBoundsMicroseconds,
+                Api::ISynthesisStatistics::kLatencyHistogramBucketCount,
+                99));
+      }
+
+      if (nullptr != memoryAccounting)
+      {
+        const Api::IMemoryAccounting::SMemorySnapshot memorySnapshot =
+            memoryAccounting->GetMemorySnapshot();
+
+        uint64_t totalBytesLive = 0;
+        for (unsigned int subsystem = 0; subsystem < Api::IMemoryAccounting::kSubsystemCount;
+             ++subsystem)
+          totalBytesLive += memorySnapshot.subsystemBytesLive[subsystem];
+
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Session performance summary: %llu bytes live at exit across %u subsystems, low-memory mode %s.",
+            totalBytesLive,
+            Api::IMemoryAccounting::kSubsystemCount,
+            ((true == memorySnapshot.lowMemoryModeEnabled) ? L"enabled" : L"disabled"));
+      }
+    }
+  } // namespace PerformanceSummary
+} // namespace Xidi
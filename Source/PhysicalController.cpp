@@ -11,8 +11,15 @@
 
 #include "PhysicalController.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <map>
 #include <mutex>
+#include <new>
 #include <set>
 #include <stop_token>
 #include <thread>
@@ -20,13 +27,24 @@
 #include <Infra/Core/Message.h>
 
 #include "ApiWindows.h"
+
+#include <dbt.h>
+#include "ApiXidi.h"
 #include "ConcurrencyWrapper.h"
 #include "ControllerTypes.h"
+#include "CpuBudget.h"
+#include "Diagnostics.h"
+#include "EventTrace.h"
+#include "FlightRecorder.h"
 #include "ForceFeedbackDevice.h"
 #include "Globals.h"
 #include "ImportApiWinMM.h"
 #include "ImportApiXInput.h"
+#include "InputMetrics.h"
+#include "LatencyMeasurement.h"
 #include "Mapper.h"
+#include "SharedPhysicalState.h"
+#include "StateTrace.h"
 #include "Strings.h"
 #include "VirtualController.h"
 
@@ -34,26 +52,339 @@ namespace Xidi
 {
   namespace Controller
   {
-    /// Raw physical state data for each of the possible physical controllers.
-    static ConcurrencyWrapper<SPhysicalState> physicalControllerState[kPhysicalControllerCount];
+    /// Per-controller mutable state record. Everything specific to one physical controller that
+    /// was previously spread across parallel per-controller arrays lives together in this
+    /// structure, and the table below holds one record per controller. Each record is aligned to
+    /// the destructive interference boundary so that the polling, force feedback, and application
+    /// threads operating on different controllers never contend for the same cache line, and so
+    /// that the controller count can grow with a future backend without reintroducing false
+    /// sharing.
+    struct alignas(std::hardware_destructive_interference_size) SPhysicalControllerRecord
+    {
+      /// Raw physical state data most recently read from the controller.
+      ConcurrencyWrapper<SPhysicalState> physicalState;
+
+      /// State data for the controller after it is passed through a mapper but without any
+      /// further processing.
+      ConcurrencyWrapper<SState> rawVirtualState;
+
+      /// Pointers to the virtual controller objects registered for force feedback with the
+      /// controller.
+      std::set<const VirtualController*> forceFeedbackRegistration;
+
+      /// Mutex for protecting against concurrent accesses to the force feedback registration
+      /// data.
+      std::mutex forceFeedbackMutex;
+
+      /// Product of the device-wide force feedback gain modifiers of every registered virtual
+      /// controller, on the effect modifier scale. Recomputed under #forceFeedbackMutex whenever
+      /// a registration or a device-wide gain property changes and read lock-free by the force
+      /// feedback actuation thread on every pass.
+      std::atomic<ForceFeedback::TEffectValue> combinedForceFeedbackGain =
+          ForceFeedback::kEffectModifierMaximum;
+
+      /// Number of active registrations per consumed virtual controller element. Guarded by
+      /// #consumedElementsGuard.
+      uint16_t consumedElementRefCount[kVirtualElementCount];
+
+      /// Cached union of the consumed virtual controller elements registered for the controller.
+      /// Recomputed under #consumedElementsGuard on every registration change and read lock-free
+      /// by the polling thread on every pass.
+      std::atomic<TElementMask> consumedElementsMask;
+
+      /// Exponential moving average of the interval between consumer reads, in milliseconds. A
+      /// value of zero means no cadence has been established.
+      std::atomic<uint32_t> consumerReadIntervalAverageMilliseconds;
+
+      /// Time at which a consumer last read state, in milliseconds since system start.
+      std::atomic<uint64_t> consumerLastReadTimeMilliseconds;
+    };
+
+    /// Table of per-controller state records, one per possible physical controller. The table
+    /// size follows #kPhysicalControllerCount, which with the XInput backend is the XInput user
+    /// slot limit, so that a future backend supporting more controllers changes one constant
+    /// rather than a scattering of array declarations.
+    static SPhysicalControllerRecord physicalControllerRecords[kPhysicalControllerCount];
+
+    static_assert(
+        alignof(SPhysicalControllerRecord) >= std::hardware_destructive_interference_size,
+        "Per-controller records must start on their own cache line.");
+    static_assert(
+        (sizeof(SPhysicalControllerRecord) % std::hardware_destructive_interference_size) == 0,
+        "Mutable hot fields of adjacent per-controller records must not share a cache line.");
+
+    /// Per-controller force feedback device buffer objects. Allocated lazily, along with the
+    /// rest of the force feedback subsystem, when the first virtual controller registers for
+    /// force feedback, so input-only applications never pay for the buffers or the actuation
+    /// thread. These objects are additionally not safe for dynamic initialization, hence the
+    /// initialization by pointer.
+    static ForceFeedback::Device* physicalControllerForceFeedbackBuffer;
 
-    /// State data for each of the possible physical controllers after it is passed through a mapper
-    /// but without any further processing.
-    static ConcurrencyWrapper<SState> rawVirtualControllerState[kPhysicalControllerCount];
+    /// Enumerates the supported physical controller polling backends.
+    enum class EPollingBackend
+    {
+      /// Fixed-period sleep loop between polling attempts.
+      Sleep,
+
+      /// High-resolution waitable timer, which offers more precise scheduling and hence lower
+      /// worst-case latency than sleeping.
+      Timer,
+    };
+
+    /// Number of consumers currently demanding physical controller state updates. Polling threads
+    /// are parked whenever this count is zero.
+    static std::atomic<unsigned int> pollingDemandCount;
+
+    /// Signal counter used by parked polling threads to wait for polling demand to appear.
+    static SignalCounter pollingDemandSignal;
+
+    /// Serializes consumed element registration changes, which are rare.
+    static std::mutex consumedElementsGuard;
+
+    /// Process-wide coarse timestamp, in milliseconds and in the same units as the system
+    /// multimedia timer. Refreshed by the polling thread once per polling pass so that consumers
+    /// that stamp work items at polling cadence can read it instead of each paying an
+    /// imported-function call. A value of zero means no polling pass has published a timestamp
+    /// yet.
+    static std::atomic<uint32_t> coarseTimestampMilliseconds;
+
+    /// Number of milliseconds after which, if no consumer reads have occurred, the polling period
+    /// reverts from the learned consumer read cadence back to the default.
+    static constexpr unsigned int kConsumerReadCadenceExpiryMilliseconds = 1000;
+
+    /// Number of milliseconds a vacant-slot polling thread waits for a device change notification
+    /// before re-polling the hardware anyway as a fallback, in case notifications are unavailable.
+    static constexpr unsigned int kVacantSlotFallbackPollPeriodMilliseconds = 1000;
+
+    /// Polling period used for connected controllers while the current process does not have
+    /// input focus, in milliseconds. Backgrounded processes have no use for fresh controller
+    /// state, so polling drops to this slow keep-alive rate, which still detects disconnection
+    /// promptly. Full-rate polling resumes within one keep-alive period of regaining focus.
+    static constexpr unsigned int kBackgroundKeepAlivePollPeriodMilliseconds = 100;
+
+    /// Generation counter incremented whenever the system reports a device arrival or removal.
+    static std::atomic<uint32_t> deviceChangeGeneration;
+
+    /// Mutex for synchronizing parking and waking of vacant-slot polling threads as device change
+    /// notifications arrive.
+    static std::mutex deviceChangeMutex;
+
+    /// Condition variable used by vacant-slot polling threads to wait for device change
+    /// notifications.
+    static std::condition_variable deviceChangeSignal;
+
+    /// Describes a single physical controller status change to be logged. Status changes are
+    /// detected inline by the polling thread but logged later by a low-priority thread, so that
+    /// log output never delays a polling pass.
+    struct SStatusChangeLogEntry
+    {
+      /// Identifier of the physical controller whose status changed.
+      TControllerIdentifier controllerIdentifier;
+
+      /// Device status before the change.
+      EPhysicalDeviceStatus oldStatus;
+
+      /// Device status after the change.
+      EPhysicalDeviceStatus newStatus;
+    };
+
+    /// Queue of physical controller status changes awaiting log output. Filled only by the
+    /// polling thread and drained only by the status change logging thread, matching the ring
+    /// buffer's single-producer single-consumer model. Status changes are rare, so if the queue
+    /// nevertheless fills, further entries are dropped rather than ever blocking the polling
+    /// thread.
+    static SpscRingBuffer<SStatusChangeLogEntry, 64> statusChangeLogQueue;
+
+    /// Signal counter used by the status change logging thread to wait for entries to appear in
+    /// the queue.
+    static SignalCounter statusChangeLogSignal;
+
+    /// Computes the polling period for the specified physical controller based on the consumer
+    /// read cadence observed for it. Falls back to the default polling period if no cadence has
+    /// been established or the last consumer read is too far in the past.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @return Number of milliseconds to wait between polling attempts.
+    static unsigned int AdaptivePollingPeriodMilliseconds(
+        TControllerIdentifier controllerIdentifier)
+    {
+      const SPhysicalControllerRecord& controllerRecord =
+          physicalControllerRecords[controllerIdentifier];
+
+      const uint32_t readIntervalAverage =
+          controllerRecord.consumerReadIntervalAverageMilliseconds.load(std::memory_order_relaxed);
+      if (0 == readIntervalAverage) return kPhysicalPollingPeriodMilliseconds;
+
+      const uint64_t timeSinceLastRead = GetTickCount64() -
+          controllerRecord.consumerLastReadTimeMilliseconds.load(std::memory_order_relaxed);
+      if (timeSinceLastRead > kConsumerReadCadenceExpiryMilliseconds)
+        return kPhysicalPollingPeriodMilliseconds;
+
+      // Polling at half the consumer read interval keeps the data fresh at each read without
+      // oversampling the hardware.
+      return std::clamp(
+          readIntervalAverage / 2,
+          kPhysicalPollingPeriodMinMilliseconds,
+          kPhysicalPollingPeriodMaxMilliseconds);
+    }
 
-    /// Per-controller force feedback device buffer objects.
-    /// These objects are not safe for dynamic initialization, so they are initialized later by
-    /// pointer.
-    static ForceFeedback::Device* physicalControllerForceFeedbackBuffer;
+    /// Retrieves the polling backend selected in the configuration file.
+    /// @return Configured polling backend, defaulting to the high-resolution timer backend if the
+    /// configuration file does not specify otherwise.
+    static EPollingBackend GetConfiguredPollingBackend(void)
+    {
+      static const EPollingBackend configuredPollingBackend = []() -> EPollingBackend
+      {
+        const auto& configData = Globals::GetConfigurationData();
+        const std::wstring_view propertiesSectionName =
+            Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionProperties);
 
-    /// Pointers to the virtual controller objects registered for force feedback with each physical
-    /// controller.
-    static std::set<const VirtualController*>
-        physicalControllerForceFeedbackRegistration[kPhysicalControllerCount];
+        if (true == configData.Contains(propertiesSectionName))
+        {
+          const auto& propertiesConfigData = configData[propertiesSectionName];
+
+          if (true ==
+              propertiesConfigData.Contains(
+                  Strings::kStrConfigurationSettingPropertiesPollingBackend))
+          {
+            std::wstring_view pollingBackendName =
+                propertiesConfigData[Strings::kStrConfigurationSettingPropertiesPollingBackend]
+                    ->GetString();
+
+            if (L"Sleep" == pollingBackendName) return EPollingBackend::Sleep;
+            if (L"Timer" == pollingBackendName) return EPollingBackend::Timer;
+
+            Infra::Message::OutputFormatted(
+                Infra::Message::ESeverity::Warning,
+                L"Unrecognized polling backend \"%s\" specified in the configuration file. Defaulting to the high-resolution timer backend.",
+                pollingBackendName.data());
+          }
+        }
+
+        return EPollingBackend::Timer;
+      }();
+
+      return configuredPollingBackend;
+    }
+
+    /// Window procedure for the hidden message-only window that receives device change
+    /// notifications from the system.
+    static LRESULT CALLBACK DeviceNotificationWindowProc(
+        HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam)
+    {
+      if (WM_DEVICECHANGE == message)
+      {
+        switch (wParam)
+        {
+          case DBT_DEVICEARRIVAL:
+          case DBT_DEVICEREMOVECOMPLETE:
+          case DBT_DEVNODES_CHANGED:
+            deviceChangeGeneration.fetch_add(1, std::memory_order_release);
+
+            // Briefly acquiring the mutex ensures that no parked polling thread can miss this
+            // notification by checking its wait predicate concurrently with the update above.
+            {
+              std::unique_lock lock(deviceChangeMutex);
+            }
+            deviceChangeSignal.notify_all();
+            break;
+
+          default:
+            break;
+        }
+
+        return TRUE;
+      }
+
+      return DefWindowProc(windowHandle, message, wParam, lParam);
+    }
+
+    /// Creates a hidden message-only window, registers it for device change notifications, and
+    /// pumps its messages. Intended to be a thread entry point.
+    static void MonitorDeviceChangeNotifications(void)
+    {
+      // GUID for HID class device interfaces, the class to which XInput controllers belong.
+      static constexpr GUID kGuidDevInterfaceHid = {
+          0x4d1e55b2, 0xf16f, 0x11cf, {0x88, 0xcb, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30}};
+
+      WNDCLASSEXW windowClass = {
+          .cbSize = sizeof(WNDCLASSEXW),
+          .lpfnWndProc = DeviceNotificationWindowProc,
+          .hInstance = GetModuleHandleW(nullptr),
+          .lpszClassName = L"XidiDeviceNotificationWindow"};
+      if (0 == RegisterClassExW(&windowClass))
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Warning,
+            L"Failed to register the device change notification window class. Vacant controller slots will be re-polled periodically instead.");
+        return;
+      }
+
+      HWND notificationWindow = CreateWindowExW(
+          0,
+          windowClass.lpszClassName,
+          L"",
+          0,
+          0,
+          0,
+          0,
+          0,
+          HWND_MESSAGE,
+          nullptr,
+          windowClass.hInstance,
+          nullptr);
+      if (nullptr == notificationWindow)
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Warning,
+            L"Failed to create the device change notification window. Vacant controller slots will be re-polled periodically instead.");
+        return;
+      }
 
-    /// Mutex objects for protecting against concurrent accesses to the physical controller force
-    /// feedback registration data.
-    static std::mutex physicalControllerForceFeedbackMutex[kPhysicalControllerCount];
+      DEV_BROADCAST_DEVICEINTERFACE_W notificationFilter = {
+          .dbcc_size = sizeof(DEV_BROADCAST_DEVICEINTERFACE_W),
+          .dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE,
+          .dbcc_classguid = kGuidDevInterfaceHid};
+      if (nullptr ==
+          RegisterDeviceNotificationW(
+              notificationWindow, &notificationFilter, DEVICE_NOTIFY_WINDOW_HANDLE))
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Warning,
+            L"Failed to register for device change notifications. Relying on broadcast messages only.");
+
+      MSG message;
+      while (0 < GetMessageW(&message, notificationWindow, 0, 0))
+      {
+        TranslateMessage(&message);
+        DispatchMessageW(&message);
+      }
+    }
+
+    /// Creates and starts the device change notification monitor thread, if it is not already
+    /// running. Safe to invoke from multiple threads and multiple times.
+    static void EnsureDeviceChangeNotificationMonitorStarted(void)
+    {
+      static std::once_flag deviceChangeMonitorFlag;
+      std::call_once(
+          deviceChangeMonitorFlag,
+          []() -> void
+          {
+            std::thread(MonitorDeviceChangeNotifications).detach();
+            Infra::Message::Output(
+                Infra::Message::ESeverity::Info,
+                L"Initialized the device change notification thread.");
+          });
+    }
+
+    /// Blocks the calling polling thread until at least one consumer demands physical controller
+    /// state updates. Returns immediately if demand already exists.
+    static void WaitForPollingDemand(void)
+    {
+      pollingDemandSignal.Wait(
+          []() -> bool
+          {
+            return (pollingDemandCount.load(std::memory_order_acquire) > 0);
+          });
+    }
 
     /// Computes an opaque source identifier from a given controller identifier.
     /// @param [in] controllerIdentifier Identifier of the physical controller for which an
@@ -65,18 +396,187 @@ namespace Xidi
       return (uint32_t)controllerIdentifier;
     }
 
-    /// Reads physical controller state.
+    /// Enumerates the supported physical controller capture backends.
+    enum class ECaptureBackend
+    {
+      /// XInput API, the default.
+      XInput,
+
+      /// WinMM joystick API, which supports controllers that do not expose an XInput interface.
+      WinMM,
+    };
+
+    /// Maps a capture backend name from the configuration file to a capture backend enumerator.
+    /// @param [in] captureBackendName Capture backend name to map.
+    /// @param [in] fallbackBackend Backend to return, after logging a warning, if the name is
+    /// unrecognized.
+    /// @return Corresponding capture backend enumerator.
+    static ECaptureBackend CaptureBackendFromName(
+        std::wstring_view captureBackendName, ECaptureBackend fallbackBackend)
+    {
+      if (L"XInput" == captureBackendName) return ECaptureBackend::XInput;
+      if (L"WinMM" == captureBackendName) return ECaptureBackend::WinMM;
+
+      Infra::Message::OutputFormatted(
+          Infra::Message::ESeverity::Warning,
+          L"Unrecognized capture backend \"%s\" specified in the configuration file.",
+          captureBackendName.data());
+      return fallbackBackend;
+    }
+
+    /// Retrieves the capture backend selected in the configuration file for the specified physical
+    /// controller. A per-controller setting takes precedence over the controller-independent
+    /// setting, which in turn defaults to the XInput backend.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    /// @return Configured capture backend for the specified physical controller.
+    static ECaptureBackend GetConfiguredCaptureBackend(TControllerIdentifier controllerIdentifier)
+    {
+      static const std::array<ECaptureBackend, kPhysicalControllerCount>
+          configuredCaptureBackend =
+              []() -> std::array<ECaptureBackend, kPhysicalControllerCount>
+      {
+        std::array<ECaptureBackend, kPhysicalControllerCount> captureBackends;
+        captureBackends.fill(ECaptureBackend::XInput);
+
+        const auto& configData = Globals::GetConfigurationData();
+        const std::wstring_view propertiesSectionName =
+            Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionProperties);
+        if (false == configData.Contains(propertiesSectionName)) return captureBackends;
+
+        const auto& propertiesConfigData = configData[propertiesSectionName];
+
+        if (true ==
+            propertiesConfigData.Contains(
+                Strings::kStrConfigurationSettingPropertiesCaptureBackend))
+          captureBackends.fill(CaptureBackendFromName(
+              propertiesConfigData[Strings::kStrConfigurationSettingPropertiesCaptureBackend]
+                  ->GetString(),
+              ECaptureBackend::XInput));
+
+        for (TControllerIdentifier i = 0; i < kPhysicalControllerCount; ++i)
+          if (true ==
+              propertiesConfigData.Contains(Strings::CaptureBackendConfigurationNameString(i)))
+            captureBackends[i] = CaptureBackendFromName(
+                propertiesConfigData[Strings::CaptureBackendConfigurationNameString(i)]
+                    ->GetString(),
+                captureBackends[i]);
+
+        return captureBackends;
+      }();
+
+      return configuredCaptureBackend[controllerIdentifier];
+    }
+
+    /// Reads physical controller state using the WinMM joystick API.
+    /// The axis and button layout assumed here follows what Xbox-class controllers report through
+    /// the WinMM interface: X/Y are the left stick, U/R are the right stick, and Z is the shared
+    /// trigger axis.
     /// @param [in] controllerIdentifier Identifier of the controller on which to operate.
     /// @return Physical state of the identified controller.
-    static SPhysicalState ReadPhysicalControllerState(TControllerIdentifier controllerIdentifier)
+    static SPhysicalState ReadPhysicalControllerStateWinMM(
+        TControllerIdentifier controllerIdentifier)
     {
-      constexpr uint16_t kUnusedButtonMask =
-          ~((uint16_t)((1u << (unsigned int)EPhysicalButton::UnusedGuide) |
-                       (1u << (unsigned int)EPhysicalButton::UnusedShare)));
+      JOYINFOEX joyInfo = {
+          .dwSize = sizeof(JOYINFOEX),
+          .dwFlags =
+              (JOY_RETURNX | JOY_RETURNY | JOY_RETURNZ | JOY_RETURNR | JOY_RETURNU |
+               JOY_RETURNPOV | JOY_RETURNBUTTONS)};
+
+      const MMRESULT joyGetPosExResult =
+          ImportApiWinMM::joyGetPosEx((UINT)controllerIdentifier, &joyInfo);
+      switch (joyGetPosExResult)
+      {
+        case JOYERR_NOERROR:
+          break;
+
+        case JOYERR_UNPLUGGED:
+          return {.deviceStatus = EPhysicalDeviceStatus::NotConnected};
+
+        default:
+          Diagnostics::RecordInputStackError((uint32_t)joyGetPosExResult);
+          return {.deviceStatus = EPhysicalDeviceStatus::Error};
+      }
+
+      SPhysicalState physicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+
+      // WinMM axes are 16-bit values centered at 32767 with Y increasing downwards, whereas the
+      // internal representation follows XInput with signed values and Y increasing upwards.
+      physicalState.stick[(int)EPhysicalStick::LeftX] =
+          (int16_t)((int32_t)joyInfo.dwXpos - 32768);
+      physicalState.stick[(int)EPhysicalStick::LeftY] =
+          (int16_t)(32767 - (int32_t)joyInfo.dwYpos);
+      physicalState.stick[(int)EPhysicalStick::RightX] =
+          (int16_t)((int32_t)joyInfo.dwUpos - 32768);
+      physicalState.stick[(int)EPhysicalStick::RightY] =
+          (int16_t)(32767 - (int32_t)joyInfo.dwRpos);
+
+      // The Z axis is shared between the triggers: displacement above center means left trigger
+      // and displacement below center means right trigger.
+      const int32_t sharedTriggerDisplacement = (int32_t)joyInfo.dwZpos - 32768;
+      if (sharedTriggerDisplacement > 0)
+        physicalState.trigger[(int)EPhysicalTrigger::LT] =
+            (uint8_t)(sharedTriggerDisplacement >> 7);
+      else
+        physicalState.trigger[(int)EPhysicalTrigger::RT] =
+            (uint8_t)((-sharedTriggerDisplacement) >> 7);
+
+      // Button numbering follows the order in which Xbox-class controllers report buttons through
+      // the WinMM interface.
+      static constexpr EPhysicalButton kWinMMButtonOrder[] = {
+          EPhysicalButton::A,
+          EPhysicalButton::B,
+          EPhysicalButton::X,
+          EPhysicalButton::Y,
+          EPhysicalButton::LB,
+          EPhysicalButton::RB,
+          EPhysicalButton::Back,
+          EPhysicalButton::Start,
+          EPhysicalButton::LS,
+          EPhysicalButton::RS};
+      for (unsigned int i = 0; i < _countof(kWinMMButtonOrder); ++i)
+        if (0 != (joyInfo.dwButtons & (1u << i)))
+          physicalState.button.set((size_t)kWinMMButtonOrder[i]);
+
+      // POV hat angles are expressed in hundredths of degrees clockwise from north, with a special
+      // value indicating a centered hat. Each dpad direction covers a quarter turn.
+      if (JOY_POVCENTERED != (WORD)joyInfo.dwPOV)
+      {
+        const DWORD povAngle = joyInfo.dwPOV;
+
+        if ((povAngle >= 31500) || (povAngle <= 4500))
+          physicalState.button.set((size_t)EPhysicalButton::DpadUp);
+        if ((povAngle >= 4500) && (povAngle <= 13500))
+          physicalState.button.set((size_t)EPhysicalButton::DpadRight);
+        if ((povAngle >= 13500) && (povAngle <= 22500))
+          physicalState.button.set((size_t)EPhysicalButton::DpadDown);
+        if ((povAngle >= 22500) && (povAngle <= 31500))
+          physicalState.button.set((size_t)EPhysicalButton::DpadLeft);
+      }
+
+      return physicalState;
+    }
+
+    /// Reads physical controller state using the XInput API.
+    /// @param [in] controllerIdentifier Identifier of the controller on which to operate.
+    /// @return Physical state of the identified controller.
+    static SPhysicalState ReadPhysicalControllerStateXInput(
+        TControllerIdentifier controllerIdentifier)
+    {
+      // The state reader is selected once when the XInput library is loaded. Binding this poll
+      // function directly to the selected function avoids dispatching through the import table on
+      // every call, and where the extended state-reading function is available it also reports
+      // Guide button state without any extra calls, so that button's bit is retained rather than
+      // masked off.
+      static const ImportApiXInput::SXInputStateReader kXInputStateReader =
+          ImportApiXInput::GetXInputStateReader();
+      static const uint16_t kUnusedButtonMask = (true == kXInputStateReader.reportsGuideButton)
+          ? (uint16_t)~(1u << (unsigned int)EPhysicalButton::UnusedShare)
+          : (uint16_t)~((1u << (unsigned int)EPhysicalButton::Guide) |
+                        (1u << (unsigned int)EPhysicalButton::UnusedShare));
 
       XINPUT_STATE xinputState;
       DWORD xinputGetStateResult =
-          ImportApiXInput::XInputGetState(controllerIdentifier, &xinputState);
+          kXInputStateReader.getStateFunc(controllerIdentifier, &xinputState);
 
       switch (xinputGetStateResult)
       {
@@ -98,6 +598,7 @@ namespace Xidi
           return {.deviceStatus = EPhysicalDeviceStatus::NotConnected};
 
         default:
+          Diagnostics::RecordInputStackError((uint32_t)xinputGetStateResult);
           return {.deviceStatus = EPhysicalDeviceStatus::Error};
       }
     }
@@ -112,11 +613,54 @@ namespace Xidi
     static_assert(1u << (unsigned int)EPhysicalButton::RS == XINPUT_GAMEPAD_RIGHT_THUMB);
     static_assert(1u << (unsigned int)EPhysicalButton::LB == XINPUT_GAMEPAD_LEFT_SHOULDER);
     static_assert(1u << (unsigned int)EPhysicalButton::RB == XINPUT_GAMEPAD_RIGHT_SHOULDER);
+    // The Guide button mask is not defined in the XInput headers because the extended
+    // state-reading function that reports it is not documented.
+    static_assert(1u << (unsigned int)EPhysicalButton::Guide == 0x0400);
     static_assert(1u << (unsigned int)EPhysicalButton::A == XINPUT_GAMEPAD_A);
     static_assert(1u << (unsigned int)EPhysicalButton::B == XINPUT_GAMEPAD_B);
     static_assert(1u << (unsigned int)EPhysicalButton::X == XINPUT_GAMEPAD_X);
     static_assert(1u << (unsigned int)EPhysicalButton::Y == XINPUT_GAMEPAD_Y);
 
+    /// Reads physical controller state using the capture backend configured for the specified
+    /// controller.
+    /// @param [in] controllerIdentifier Identifier of the controller on which to operate.
+    /// @return Physical state of the identified controller.
+    static SPhysicalState ReadPhysicalControllerState(TControllerIdentifier controllerIdentifier)
+    {
+      SPhysicalState physicalState = {};
+
+      // In replay mode, recorded trace states take the place of hardware reads entirely, so the
+      // rest of the pipeline processes real gameplay input reproducibly. Replayed snapshots are
+      // stamped at read time by the replay backend.
+      if (true == StateTrace::TryReadReplayState(controllerIdentifier, physicalState))
+        return physicalState;
+
+      // In shared physical state mode, consumer processes read snapshots published by the elected
+      // poller process instead of issuing their own driver calls. The read fails, and the direct
+      // hardware read below takes over, if the poller process dies or stops publishing.
+      if (true == SharedPhysicalState::TryReadSharedPhysicalState(controllerIdentifier, physicalState))
+        return physicalState;
+
+      switch (GetConfiguredCaptureBackend(controllerIdentifier))
+      {
+        case ECaptureBackend::WinMM:
+          physicalState = ReadPhysicalControllerStateWinMM(controllerIdentifier);
+          break;
+
+        default:
+          physicalState = ReadPhysicalControllerStateXInput(controllerIdentifier);
+          break;
+      }
+
+      // Snapshots are stamped at capture time for end-to-end latency accounting. The timestamp is
+      // excluded from state comparisons, so it does not generate spurious updates.
+      LARGE_INTEGER captureTime;
+      QueryPerformanceCounter(&captureTime);
+      physicalState.captureTimestamp = captureTime.QuadPart;
+
+      return physicalState;
+    }
+
     /// Scales a vibration strength value by the specified scaling factor. If the resulting strength
     /// exceeds the maximum possible strength it is saturated at the maximum possible strength.
     /// @param [in] vibrationStrength Physical motor vibration strength value.
@@ -148,13 +692,16 @@ namespace Xidi
         TControllerIdentifier controllerIdentifier,
         ForceFeedback::SPhysicalActuatorComponents vibration)
     {
-      static const double kForceFeedbackEffectStrengthScalingFactor =
-          static_cast<double>(
-              Globals::GetConfigurationData()
-                  [Strings::kStrConfigurationSectionProperties]
-                  [Strings::kStrConfigurationSettingPropertiesForceFeedbackEffectStrengthPercent]
-                      .ValueOr(100)) /
-          100.0;
+      const double kForceFeedbackEffectStrengthScalingFactor =
+          Globals::GetPropertiesSettings().forceFeedbackEffectStrengthScalingFactor;
+
+      // XInput vibration commands most recently sent to each physical controller. Commands that
+      // would not change motor state are skipped to avoid redundant driver and USB traffic.
+      // Distinct actuator values can collapse to the same vibration command after scaling, so
+      // deduplication happens here rather than at the actuator value level. No synchronization is
+      // needed because only the actuation thread calls this function.
+      static XINPUT_VIBRATION lastSentXInputVibration[kPhysicalControllerCount];
+      static bool lastSentXInputVibrationValid[kPhysicalControllerCount];
 
       // Impulse triggers are ignored because the XInput API does not support them.
       XINPUT_VIBRATION xinputVibration = {
@@ -162,176 +709,576 @@ namespace Xidi
               vibration.leftMotor, kForceFeedbackEffectStrengthScalingFactor),
           .wRightMotorSpeed = ScaledVibrationStrength(
               vibration.rightMotor, kForceFeedbackEffectStrengthScalingFactor)};
-      return (
-          ERROR_SUCCESS ==
-          ImportApiXInput::XInputSetState((DWORD)controllerIdentifier, &xinputVibration));
+
+      if ((true == lastSentXInputVibrationValid[controllerIdentifier]) &&
+          (lastSentXInputVibration[controllerIdentifier].wLeftMotorSpeed ==
+           xinputVibration.wLeftMotorSpeed) &&
+          (lastSentXInputVibration[controllerIdentifier].wRightMotorSpeed ==
+           xinputVibration.wRightMotorSpeed))
+        return true;
+
+      const DWORD xinputSetStateResult =
+          ImportApiXInput::XInputSetState((DWORD)controllerIdentifier, &xinputVibration);
+      const bool writeResult = (ERROR_SUCCESS == xinputSetStateResult);
+
+      if ((ERROR_SUCCESS != xinputSetStateResult) &&
+          (ERROR_DEVICE_NOT_CONNECTED != xinputSetStateResult))
+        Diagnostics::RecordInputStackError((uint32_t)xinputSetStateResult);
+
+      // A failed write leaves the motor state unknown, so the cached command is only considered
+      // valid after a successful write.
+      lastSentXInputVibration[controllerIdentifier] = xinputVibration;
+      lastSentXInputVibrationValid[controllerIdentifier] = writeResult;
+
+      return writeResult;
+    }
+
+    /// Recomputes the cached combined force feedback gain for the specified physical
+    /// controller. Must be invoked with the controller record's force feedback mutex held.
+    /// @param [in] controllerIdentifier Identifier of the physical controller of interest.
+    static void RecomputeCombinedForceFeedbackGain(TControllerIdentifier controllerIdentifier)
+    {
+      ForceFeedback::TEffectValue combinedGain = ForceFeedback::kEffectModifierMaximum;
+
+      // Gain is modified downwards by each virtual controller object.
+      // Typically there would only be one, in which case the properties of that object would be
+      // effective. Otherwise this loop is essentially modeled as multiple volume knobs connected
+      // in sequence, each lowering the volume of the effects by the value of its own device-wide
+      // gain property.
+      for (auto virtualController :
+           physicalControllerRecords[controllerIdentifier].forceFeedbackRegistration)
+        combinedGain *=
+            ((ForceFeedback::TEffectValue)virtualController->GetForceFeedbackGain() /
+             ForceFeedback::kEffectModifierMaximum);
+
+      physicalControllerRecords[controllerIdentifier].combinedForceFeedbackGain.store(
+          combinedGain, std::memory_order_relaxed);
     }
 
     /// Periodically plays force feedback effects on the physical controller actuators.
-    /// @param [in] controllerIdentifier Identifier of the controller on which to operate.
-    static void ForceFeedbackActuateEffects(TControllerIdentifier controllerIdentifier)
+    /// A single thread services all physical controllers, keeping per-slot copies of the
+    /// last-computed actuator values so that only slots with changed values result in vibration
+    /// commands being written. Slots whose last write failed are individually backed off without
+    /// delaying actuation on the other slots.
+    static void ForceFeedbackActuateEffects(void)
     {
+      Globals::ApplyWorkerThreadAttributes(
+          Strings::kStrConfigurationSettingWorkerThreadsForceFeedbackThreadPriority,
+          Strings::kStrConfigurationSettingWorkerThreadsForceFeedbackThreadAffinityMask);
+      CpuBudget::RegisterCurrentWorkerThread();
+
       constexpr ForceFeedback::TOrderedMagnitudeComponents kVirtualMagnitudeVectorZero = {};
+      constexpr ForceFeedback::SPhysicalActuatorComponents kPhysicalActuatorValuesNeutral = {};
+
+      ForceFeedback::SPhysicalActuatorComponents
+          previousPhysicalActuatorValues[kPhysicalControllerCount] = {};
+      uint64_t nextActuationTimeMilliseconds[kPhysicalControllerCount] = {};
+
+      // Auto-reset event signaled whenever an effect starts playing on any controller. While no
+      // effects are playing anywhere and all actuators have been left neutral, this thread blocks
+      // on the event instead of waking every actuation period for nothing. An effect that starts
+      // while a pass is in progress just sets the event and is picked up by the next pass.
+      const HANDLE forceFeedbackActivityEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+      if (NULL != forceFeedbackActivityEvent)
+      {
+        for (TControllerIdentifier controllerIdentifier = 0;
+             controllerIdentifier < kPhysicalControllerCount;
+             ++controllerIdentifier)
+          physicalControllerForceFeedbackBuffer[controllerIdentifier]
+              .SetPlaybackActivityNotificationEvent(forceFeedbackActivityEvent);
+      }
 
-      ForceFeedback::SPhysicalActuatorComponents previousPhysicalActuatorValues;
-      ForceFeedback::SPhysicalActuatorComponents currentPhysicalActuatorValues;
+      bool idleUntilNextEffectStart = false;
 
-      const Mapper* mapper = Mapper::GetConfigured(controllerIdentifier);
-      bool lastActuationResult = true;
+      // Absolute time of the earliest scheduled effect start transition across all slots, or 0 if
+      // none is scheduled. While all playing effects everywhere are waiting out their start
+      // delays, nothing can change the actuator outputs before the earliest of them starts, so
+      // this thread can skip straight to that transition instead of waking every period.
+      uint64_t nextScheduledTransitionTimeMilliseconds = 0;
 
       while (true)
       {
-        if (true == lastActuationResult)
-          Sleep(kPhysicalForceFeedbackPeriodMilliseconds);
+        if ((true == idleUntilNextEffectStart) &&
+            (0 == nextScheduledTransitionTimeMilliseconds) &&
+            (NULL != forceFeedbackActivityEvent))
+        {
+          WaitForSingleObject(forceFeedbackActivityEvent, INFINITE);
+        }
+        else if ((true == idleUntilNextEffectStart) &&
+                 (0 != nextScheduledTransitionTimeMilliseconds) &&
+                 (NULL != forceFeedbackActivityEvent))
+        {
+          // Waiting on the activity event rather than sleeping means an effect that starts with
+          // no delay during the wait is still picked up immediately.
+          const uint64_t waitStartTimeMilliseconds = GetTickCount64();
+          if (nextScheduledTransitionTimeMilliseconds > waitStartTimeMilliseconds)
+            WaitForSingleObject(
+                forceFeedbackActivityEvent,
+                (DWORD)(nextScheduledTransitionTimeMilliseconds - waitStartTimeMilliseconds));
+        }
         else
-          Sleep(kPhysicalErrorBackoffPeriodMilliseconds);
+        {
+          const uint64_t scheduledWakeTimeMilliseconds =
+              GetTickCount64() + kPhysicalForceFeedbackPeriodMilliseconds;
+          Sleep(kPhysicalForceFeedbackPeriodMilliseconds);
+
+          const uint64_t wakeupTimeMilliseconds = GetTickCount64();
+          InputMetrics::RecordPollingLoopWakeup(
+              InputMetrics::EPollingLoop::ForceFeedback,
+              ((wakeupTimeMilliseconds > scheduledWakeTimeMilliseconds)
+                   ? (uint32_t)(wakeupTimeMilliseconds - scheduledWakeTimeMilliseconds)
+                   : 0),
+              kPhysicalForceFeedbackPeriodMilliseconds);
+        }
+
+        Diagnostics::RecordThreadHeartbeat(Diagnostics::EWorkerThread::ForceFeedback);
+
+        idleUntilNextEffectStart = true;
+        nextScheduledTransitionTimeMilliseconds = 0;
+
+        const bool currentProcessHasInputFocus = Globals::DoesCurrentProcessHaveInputFocus();
+        const uint64_t currentTimeMilliseconds = GetTickCount64();
 
-        if (true == Globals::DoesCurrentProcessHaveInputFocus())
+        for (TControllerIdentifier controllerIdentifier = 0;
+             controllerIdentifier < kPhysicalControllerCount;
+             ++controllerIdentifier)
         {
-          ForceFeedback::TEffectValue overallEffectGain = 10000;
-          ForceFeedback::SPhysicalActuatorComponents physicalActuatorVector = {};
-          ForceFeedback::TOrderedMagnitudeComponents virtualMagnitudeVector =
-              physicalControllerForceFeedbackBuffer[controllerIdentifier].PlayEffects();
+          if (currentTimeMilliseconds < nextActuationTimeMilliseconds[controllerIdentifier])
+          {
+            // A slot in error backoff may still have a vibration command change pending, so it is
+            // not safe to stop actuation passes while one exists.
+            idleUntilNextEffectStart = false;
+            continue;
+          }
 
-          if (kVirtualMagnitudeVectorZero != virtualMagnitudeVector)
+          // Playing effects, including those paused, require continued actuation passes
+          // regardless of input focus so that playback bookkeeping continues to advance. Effects
+          // that are all waiting out their start delays instead schedule a wake-up at the earliest
+          // start transition.
+          const std::optional<ForceFeedback::TEffectTimeMs> millisecondsUntilNextTransition =
+              physicalControllerForceFeedbackBuffer[controllerIdentifier]
+                  .MillisecondsUntilNextEffectTransition();
+          if (true == millisecondsUntilNextTransition.has_value())
           {
-            std::unique_lock lock(physicalControllerForceFeedbackMutex[controllerIdentifier]);
-
-            // Gain is modified downwards by each virtual controller object.
-            // Typically there would only be one, in which case the properties of that object would
-            // be effective. Otherwise this loop is essentially modeled as multiple volume knobs
-            // connected in sequence, each lowering the volume of the effects by the value of its
-            // own device-wide gain property.
-            for (auto virtualController :
-                 physicalControllerForceFeedbackRegistration[controllerIdentifier])
-              overallEffectGain *=
-                  ((ForceFeedback::TEffectValue)virtualController->GetForceFeedbackGain() /
-                   ForceFeedback::kEffectModifierMaximum);
-
-            physicalActuatorVector = mapper->MapForceFeedbackVirtualToPhysical(
-                virtualMagnitudeVector, overallEffectGain);
+            if (0 == millisecondsUntilNextTransition.value())
+            {
+              idleUntilNextEffectStart = false;
+            }
+            else
+            {
+              const uint64_t slotTransitionTimeMilliseconds =
+                  currentTimeMilliseconds + millisecondsUntilNextTransition.value();
+              if ((0 == nextScheduledTransitionTimeMilliseconds) ||
+                  (slotTransitionTimeMilliseconds < nextScheduledTransitionTimeMilliseconds))
+                nextScheduledTransitionTimeMilliseconds = slotTransitionTimeMilliseconds;
+            }
           }
 
-          currentPhysicalActuatorValues = physicalActuatorVector;
-        }
-        else
-        {
-          currentPhysicalActuatorValues = {};
-        }
+          ForceFeedback::SPhysicalActuatorComponents currentPhysicalActuatorValues = {};
 
-        if (previousPhysicalActuatorValues != currentPhysicalActuatorValues)
-        {
-          lastActuationResult =
-              WritePhysicalControllerVibration(controllerIdentifier, currentPhysicalActuatorValues);
-          previousPhysicalActuatorValues = currentPhysicalActuatorValues;
-        }
-        else
-        {
-          lastActuationResult = true;
+          if (true == currentProcessHasInputFocus)
+          {
+            ForceFeedback::TOrderedMagnitudeComponents virtualMagnitudeVector =
+                physicalControllerForceFeedbackBuffer[controllerIdentifier].PlayEffects();
+
+            if (kVirtualMagnitudeVectorZero != virtualMagnitudeVector)
+            {
+              // The combined gain across all registered virtual controller objects is cached in
+              // the controller record and recomputed only when a registration or a device-wide
+              // gain property changes, so each actuation pass pays for one lock-free load
+              // instead of a mutex acquisition and a walk of the registration set.
+              const ForceFeedback::TEffectValue overallEffectGain =
+                  physicalControllerRecords[controllerIdentifier].combinedForceFeedbackGain.load(
+                      std::memory_order_relaxed);
+
+              currentPhysicalActuatorValues =
+                  Mapper::GetConfigured(controllerIdentifier)
+                      ->MapForceFeedbackVirtualToPhysical(virtualMagnitudeVector, overallEffectGain);
+            }
+          }
+
+          // Impulse trigger components are cleared before change detection because the XInput API
+          // offers no way to transmit them (see #WritePhysicalControllerVibration). Without this,
+          // an effect routed to a trigger actuator by the mapper configuration would cause write
+          // attempts, and keep this thread from idling, despite there being no transmittable
+          // change in the body motor values.
+          currentPhysicalActuatorValues.leftImpulseTrigger = 0;
+          currentPhysicalActuatorValues.rightImpulseTrigger = 0;
+
+          if (previousPhysicalActuatorValues[controllerIdentifier] !=
+              currentPhysicalActuatorValues)
+          {
+            const bool actuationResult = WritePhysicalControllerVibration(
+                controllerIdentifier, currentPhysicalActuatorValues);
+            EventTrace::ForceFeedbackActuated(controllerIdentifier, actuationResult);
+            previousPhysicalActuatorValues[controllerIdentifier] = currentPhysicalActuatorValues;
+
+            if (false == actuationResult)
+              nextActuationTimeMilliseconds[controllerIdentifier] =
+                  currentTimeMilliseconds + kPhysicalErrorBackoffPeriodMilliseconds;
+          }
+
+          // Idling is only safe once this slot's actuators have been commanded back to neutral,
+          // otherwise a motor could be left running with no pass scheduled to stop it.
+          if (kPhysicalActuatorValuesNeutral !=
+              previousPhysicalActuatorValues[controllerIdentifier])
+            idleUntilNextEffectStart = false;
         }
       }
     }
 
-    /// Periodically polls for physical controller state.
-    /// On detected state change, updates the internal data structure and notifies all waiting
-    /// threads.
+    /// Performs one-time lazy initialization of the force feedback subsystem: the per-controller
+    /// device buffer objects and the consolidated actuation thread. Invoked when the first
+    /// virtual controller registers for force feedback, so the vast majority of applications,
+    /// which only ever read input, never pay for any of it. Concurrency-safe.
+    static void EnsureForceFeedbackInitialized(void)
+    {
+      static std::once_flag forceFeedbackInitializationFlag;
+      std::call_once(
+          forceFeedbackInitializationFlag,
+          []() -> void
+          {
+            physicalControllerForceFeedbackBuffer =
+                new ForceFeedback::Device[kPhysicalControllerCount];
+            std::thread(ForceFeedbackActuateEffects).detach();
+            Infra::Message::OutputFormatted(
+                Infra::Message::ESeverity::Info,
+                L"Initialized the physical controller force feedback actuation thread for all %u controllers. Desired actuation period is %u ms.",
+                (unsigned int)kPhysicalControllerCount,
+                kPhysicalForceFeedbackPeriodMilliseconds);
+          });
+    }
+
+    /// Polls the specified physical controller once and publishes both the physical state and the
+    /// mapped raw virtual state if either changed, notifying all waiting threads.
     /// @param [in] controllerIdentifier Identifier of the controller on which to operate.
-    static void PollForPhysicalControllerStateChanges(TControllerIdentifier controllerIdentifier)
+    /// @return Physical state read from the controller.
+    static SPhysicalState PollPhysicalControllerOnce(TControllerIdentifier controllerIdentifier)
     {
-      SPhysicalState newPhysicalState = physicalControllerState[controllerIdentifier].Get();
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
 
-      while (true)
+      const SPhysicalState newPhysicalState = ReadPhysicalControllerState(controllerIdentifier);
+      SharedPhysicalState::PublishPhysicalState(controllerIdentifier, newPhysicalState);
+      const bool physicalStateChanged = controllerRecord.physicalState.Update(newPhysicalState);
+      EventTrace::PhysicalPollCompleted(controllerIdentifier, physicalStateChanged);
+      LatencyMeasurement::SubmitPhysicalState(controllerIdentifier, newPhysicalState);
+      StateTrace::SubmitPolledState(controllerIdentifier, newPhysicalState);
+
+      if (true == physicalStateChanged)
       {
-        if (EPhysicalDeviceStatus::Ok == newPhysicalState.deviceStatus)
-          Sleep(kPhysicalPollingPeriodMilliseconds);
-        else
-          Sleep(kPhysicalErrorBackoffPeriodMilliseconds);
+        FlightRecorder::Record(
+            FlightRecorder::EEvent::PhysicalStateChange,
+            controllerIdentifier,
+            (uint32_t)newPhysicalState.deviceStatus);
+
+        // Element mappers whose targets no registered consumer reads are skipped by the mapping
+        // pass. An empty mask means no consumer has registered any elements at all, in which
+        // case every element is mapped as the conservative default.
+        const TElementMask registeredConsumedElements =
+            controllerRecord.consumedElementsMask.load(std::memory_order_acquire);
+        const TElementMask consumedElements =
+            ((0 == registeredConsumedElements) ? kElementMaskAll : registeredConsumedElements);
+
+        SState newRawVirtualState =
+            ((EPhysicalDeviceStatus::Ok == newPhysicalState.deviceStatus)
+                 ? Mapper::GetConfigured(controllerIdentifier)
+                       ->MapStatePhysicalToVirtual(
+                           newPhysicalState,
+                           OpaqueControllerSourceIdentifier(controllerIdentifier),
+                           consumedElements)
+                 : Mapper::GetConfigured(controllerIdentifier)
+                       ->MapNeutralPhysicalToVirtual(
+                           OpaqueControllerSourceIdentifier(controllerIdentifier)));
+        newRawVirtualState.captureTimestamp = newPhysicalState.captureTimestamp;
+
+        controllerRecord.rawVirtualState.Update(newRawVirtualState);
+      }
 
-        newPhysicalState = ReadPhysicalControllerState(controllerIdentifier);
+      return newPhysicalState;
+    }
 
-        if (true == physicalControllerState[controllerIdentifier].Update(newPhysicalState))
-        {
-          const SState newRawVirtualState =
-              ((EPhysicalDeviceStatus::Ok == newPhysicalState.deviceStatus)
-                   ? Mapper::GetConfigured(controllerIdentifier)
-                         ->MapStatePhysicalToVirtual(
-                             newPhysicalState,
-                             OpaqueControllerSourceIdentifier(controllerIdentifier))
-                   : Mapper::GetConfigured(controllerIdentifier)
-                         ->MapNeutralPhysicalToVirtual(
-                             OpaqueControllerSourceIdentifier(controllerIdentifier)));
-
-          rawVirtualControllerState[controllerIdentifier].Update(newRawVirtualState);
-        }
+    /// Queues a physical controller status change for deferred log output. Called by the polling
+    /// thread, which must never block on log output. If the resulting messages would not actually
+    /// be delivered as output then no entry is queued.
+    /// @param [in] controllerIdentifier Identifier of the controller whose status changed.
+    /// @param [in] oldStatus Device status before the change.
+    /// @param [in] newStatus Device status after the change.
+    static void DeferStatusChangeLogMessage(
+        TControllerIdentifier controllerIdentifier,
+        EPhysicalDeviceStatus oldStatus,
+        EPhysicalDeviceStatus newStatus)
+    {
+      if (false ==
+          Infra::Message::WillOutputMessageOfSeverity(Infra::Message::ESeverity::Warning))
+        return;
+
+      statusChangeLogQueue.TryPush(
+          {.controllerIdentifier = controllerIdentifier,
+           .oldStatus = oldStatus,
+           .newStatus = newStatus});
+      statusChangeLogSignal.Signal();
+    }
+
+    /// Emits a log message for a single physical controller status change.
+    /// @param [in] entry Status change log entry for which to emit a message.
+    static void OutputStatusChangeLogMessage(const SStatusChangeLogEntry& entry)
+    {
+      switch (entry.newStatus)
+      {
+        case EPhysicalDeviceStatus::Ok:
+          switch (entry.oldStatus)
+          {
+            case EPhysicalDeviceStatus::Ok:
+              break;
+
+            case EPhysicalDeviceStatus::NotConnected:
+              Infra::Message::OutputFormatted(
+                  Infra::Message::ESeverity::Info,
+                  L"Physical controller %u: Hardware connected.",
+                  (1 + entry.controllerIdentifier));
+              break;
+
+            default:
+              Infra::Message::OutputFormatted(
+                  Infra::Message::ESeverity::Warning,
+                  L"Physical controller %u: Cleared previous error condition.",
+                  (1 + entry.controllerIdentifier));
+              break;
+          }
+          break;
+
+        case EPhysicalDeviceStatus::NotConnected:
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Info,
+              L"Physical controller %u: Hardware disconnected.",
+              (1 + entry.controllerIdentifier));
+          break;
+
+        default:
+          Infra::Message::OutputFormatted(
+              Infra::Message::ESeverity::Warning,
+              L"Physical controller %u: Encountered an error condition.",
+              (1 + entry.controllerIdentifier));
+          break;
       }
     }
 
-    /// Monitors physical controller status for events like hardware connection or disconnection and
-    /// error conditions. Used exclusively for logging. Intended to be a thread entry point, one
-    /// thread per monitored physical controller.
-    /// @param [in] controllerIdentifier Identifier of the controller to monitor.
-    static void MonitorPhysicalControllerStatus(TControllerIdentifier controllerIdentifier)
+    /// Drains the queue of deferred physical controller status changes and emits a log message for
+    /// each. Intended to be a thread entry point. Runs at lowest priority because log output is
+    /// never time-critical.
+    static void DrainStatusChangeLogMessages(void)
     {
-      if (controllerIdentifier >= kPhysicalControllerCount)
+      SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+
+      while (true)
       {
-        Infra::Message::OutputFormatted(
-            Infra::Message::ESeverity::Error,
-            L"Attempted to monitor physical controller with invalid identifier %u.",
-            controllerIdentifier);
-        return;
+        statusChangeLogSignal.Wait(
+            []() -> bool
+            {
+              return (false == statusChangeLogQueue.Empty());
+            });
+
+        SStatusChangeLogEntry entryToOutput = {};
+        while (true == statusChangeLogQueue.TryPop(entryToOutput))
+          OutputStatusChangeLogMessage(entryToOutput);
       }
+    }
+
+    /// Services all physical controller slots from a single thread, polling each back-to-back
+    /// whenever its individually-scheduled due time arrives. Consolidating all slots into one
+    /// thread keeps the polling code cache-hot and avoids per-controller thread context switches.
+    static void PollForPhysicalControllerStateChanges(void)
+    {
+      Globals::ApplyWorkerThreadAttributes(
+          Strings::kStrConfigurationSettingWorkerThreadsPollingThreadPriority,
+          Strings::kStrConfigurationSettingWorkerThreadsPollingThreadAffinityMask);
+      CpuBudget::RegisterCurrentWorkerThread();
+
+      SPhysicalState lastPhysicalState[kPhysicalControllerCount];
+      uint64_t nextDueTimeMilliseconds[kPhysicalControllerCount];
+
+      for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
+           ++controllerIdentifier)
+      {
+        lastPhysicalState[controllerIdentifier] =
+            physicalControllerRecords[controllerIdentifier].physicalState.Get();
+        nextDueTimeMilliseconds[controllerIdentifier] = 0;
+      }
+
+      // High-resolution waitable timer used by the timer polling backend. If the timer cannot be
+      // created then this thread falls back to the sleep loop backend.
+      HANDLE pollingTimer = NULL;
+      if (EPollingBackend::Timer == GetConfiguredPollingBackend())
+      {
+        pollingTimer = CreateWaitableTimerEx(
+            nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (NULL == pollingTimer)
+          pollingTimer = CreateWaitableTimerEx(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+      }
+
+      uint32_t lastSeenDeviceChangeGeneration =
+          deviceChangeGeneration.load(std::memory_order_acquire);
 
-      SPhysicalState oldPhysicalState = GetCurrentPhysicalControllerState(controllerIdentifier);
-      SPhysicalState newPhysicalState = oldPhysicalState;
+      bool lastObservedInputFocus = true;
 
       while (true)
       {
-        WaitForPhysicalControllerStateChange(
-            controllerIdentifier, newPhysicalState, std::stop_token());
+        WaitForPollingDemand();
+        Diagnostics::RecordThreadHeartbeat(Diagnostics::EWorkerThread::StatePolling);
+
+        // A device change notification makes all vacant slots immediately due for a re-poll so
+        // that reconnection latency is bounded by notification delivery rather than by the
+        // fallback period.
+        const uint32_t currentDeviceChangeGeneration =
+            deviceChangeGeneration.load(std::memory_order_acquire);
+        if (currentDeviceChangeGeneration != lastSeenDeviceChangeGeneration)
+        {
+          lastSeenDeviceChangeGeneration = currentDeviceChangeGeneration;
 
-        // Look for status changes and output to the log, as appropriate.
-        switch (newPhysicalState.deviceStatus)
+          for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
+               ++controllerIdentifier)
+            if (EPhysicalDeviceStatus::NotConnected ==
+                lastPhysicalState[controllerIdentifier].deviceStatus)
+              nextDueTimeMilliseconds[controllerIdentifier] = 0;
+        }
+
+        // Focus state gates the polling rate for connected slots. On focus regain, all slots
+        // become immediately due so that full-rate polling resumes without waiting out a
+        // keep-alive period that began while backgrounded.
+        const bool currentProcessHasInputFocus = Globals::DoesCurrentProcessHaveInputFocus();
+        if ((true == currentProcessHasInputFocus) && (false == lastObservedInputFocus))
+        {
+          for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
+               ++controllerIdentifier)
+            nextDueTimeMilliseconds[controllerIdentifier] = 0;
+        }
+        lastObservedInputFocus = currentProcessHasInputFocus;
+
+        // One imported-function call per polling pass keeps the coarse timestamp fresh for all
+        // consumers that stamp work items at polling cadence. The multimedia timer is used rather
+        // than the tick count because its resolution is finer.
+        coarseTimestampMilliseconds.store(
+            ImportApiWinMM::timeGetTime(), std::memory_order_relaxed);
+
+        // Service every due slot back-to-back, then compute when the next slot becomes due.
+        const uint64_t currentTimeMilliseconds = GetTickCount64();
+        uint64_t earliestDueTimeMilliseconds = UINT64_MAX;
+
+        for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
+             ++controllerIdentifier)
         {
-          case EPhysicalDeviceStatus::Ok:
-            switch (oldPhysicalState.deviceStatus)
+          if (currentTimeMilliseconds >= nextDueTimeMilliseconds[controllerIdentifier])
+          {
+            const EPhysicalDeviceStatus previousDeviceStatus =
+                lastPhysicalState[controllerIdentifier].deviceStatus;
+
+            lastPhysicalState[controllerIdentifier] =
+                PollPhysicalControllerOnce(controllerIdentifier);
+
+            // Status change detection is a byproduct of the polling pass itself, with the log
+            // messages deferred to a low-priority thread.
+            if (lastPhysicalState[controllerIdentifier].deviceStatus != previousDeviceStatus)
+            {
+              Diagnostics::RecordControllerConnected(
+                  controllerIdentifier,
+                  (EPhysicalDeviceStatus::Ok ==
+                   lastPhysicalState[controllerIdentifier].deviceStatus));
+              FlightRecorder::Record(
+                  FlightRecorder::EEvent::PhysicalStatusChange,
+                  controllerIdentifier,
+                  (uint32_t)previousDeviceStatus,
+                  (uint32_t)lastPhysicalState[controllerIdentifier].deviceStatus);
+              DeferStatusChangeLogMessage(
+                  controllerIdentifier,
+                  previousDeviceStatus,
+                  lastPhysicalState[controllerIdentifier].deviceStatus);
+            }
+
+            unsigned int slotPeriodMilliseconds = 0;
+            switch (lastPhysicalState[controllerIdentifier].deviceStatus)
             {
               case EPhysicalDeviceStatus::Ok:
+                // The CPU budget governor stretches the polling period while the process is
+                // over its configured budget, trading input latency for bounded overhead.
+                slotPeriodMilliseconds =
+                    ((true == currentProcessHasInputFocus)
+                         ? AdaptivePollingPeriodMilliseconds(controllerIdentifier)
+                         : kBackgroundKeepAlivePollPeriodMilliseconds) *
+                    CpuBudget::GetPeriodScaleFactor();
                 break;
 
               case EPhysicalDeviceStatus::NotConnected:
-                Infra::Message::OutputFormatted(
-                    Infra::Message::ESeverity::Info,
-                    L"Physical controller %u: Hardware connected.",
-                    (1 + controllerIdentifier));
+                slotPeriodMilliseconds = kVacantSlotFallbackPollPeriodMilliseconds;
                 break;
 
               default:
-                Infra::Message::OutputFormatted(
-                    Infra::Message::ESeverity::Warning,
-                    L"Physical controller %u: Cleared previous error condition.",
-                    (1 + controllerIdentifier));
+                slotPeriodMilliseconds = kPhysicalErrorBackoffPeriodMilliseconds;
                 break;
             }
-            break;
 
-          case EPhysicalDeviceStatus::NotConnected:
-            if (newPhysicalState.deviceStatus != oldPhysicalState.deviceStatus)
-              Infra::Message::OutputFormatted(
-                  Infra::Message::ESeverity::Info,
-                  L"Physical controller %u: Hardware disconnected.",
-                  (1 + controllerIdentifier));
-            break;
+            nextDueTimeMilliseconds[controllerIdentifier] =
+                currentTimeMilliseconds + slotPeriodMilliseconds;
+          }
 
-          default:
-            if (newPhysicalState.deviceStatus != oldPhysicalState.deviceStatus)
-              Infra::Message::OutputFormatted(
-                  Infra::Message::ESeverity::Warning,
-                  L"Physical controller %u: Encountered an error condition.",
-                  (1 + controllerIdentifier));
-            break;
+          earliestDueTimeMilliseconds = std::min(
+              earliestDueTimeMilliseconds, nextDueTimeMilliseconds[controllerIdentifier]);
+        }
+
+        const uint64_t timeAfterPollingMilliseconds = GetTickCount64();
+        if (earliestDueTimeMilliseconds <= timeAfterPollingMilliseconds) continue;
+
+        const unsigned int waitPeriodMilliseconds =
+            (unsigned int)(earliestDueTimeMilliseconds - timeAfterPollingMilliseconds);
+
+        if (waitPeriodMilliseconds > kPhysicalErrorBackoffPeriodMilliseconds)
+        {
+          // Waits this long only happen when the next due slot is vacant, in which case the wait
+          // must remain interruptible by device change notifications so that reconnection is
+          // near-instantaneous.
+          const uint32_t generationBeforeWait =
+              deviceChangeGeneration.load(std::memory_order_acquire);
+
+          std::unique_lock lock(deviceChangeMutex);
+          deviceChangeSignal.wait_for(
+              lock,
+              std::chrono::milliseconds(waitPeriodMilliseconds),
+              [generationBeforeWait]() -> bool
+              {
+                return (
+                    deviceChangeGeneration.load(std::memory_order_acquire) !=
+                    generationBeforeWait);
+              });
+        }
+        else if (NULL != pollingTimer)
+        {
+          // Timer due times are expressed in 100ns units, with negative values indicating an
+          // interval relative to the present rather than an absolute time.
+          LARGE_INTEGER waitPeriodDueTime;
+          waitPeriodDueTime.QuadPart = -10000LL * (LONGLONG)waitPeriodMilliseconds;
+
+          if (FALSE !=
+              SetWaitableTimer(pollingTimer, &waitPeriodDueTime, 0, nullptr, nullptr, FALSE))
+            WaitForSingleObject(pollingTimer, (DWORD)waitPeriodMilliseconds);
+          else
+            Sleep(waitPeriodMilliseconds);
+        }
+        else
+        {
+          Sleep(waitPeriodMilliseconds);
         }
 
-        oldPhysicalState = newPhysicalState;
+        // The long vacant-slot wait above is interruptible by design, so wakeup lateness is only
+        // meaningful for the timed waits used while at least one slot is occupied.
+        if (waitPeriodMilliseconds <= kPhysicalErrorBackoffPeriodMilliseconds)
+        {
+          const uint64_t wakeupTimeMilliseconds = GetTickCount64();
+          InputMetrics::RecordPollingLoopWakeup(
+              InputMetrics::EPollingLoop::StatePolling,
+              ((wakeupTimeMilliseconds > earliestDueTimeMilliseconds)
+                   ? (uint32_t)(wakeupTimeMilliseconds - earliestDueTimeMilliseconds)
+                   : 0),
+              waitPeriodMilliseconds);
+        }
       }
     }
 
@@ -352,7 +1299,7 @@ namespace Xidi
           {
             // Initialize controller state data structures.
             for (auto controllerIdentifier = 0;
-                 controllerIdentifier < _countof(physicalControllerState);
+                 controllerIdentifier < _countof(physicalControllerRecords);
                  ++controllerIdentifier)
             {
               const SPhysicalState initialPhysicalState =
@@ -363,8 +1310,10 @@ namespace Xidi
                           initialPhysicalState,
                           OpaqueControllerSourceIdentifier(controllerIdentifier));
 
-              physicalControllerState[controllerIdentifier].Set(initialPhysicalState);
-              rawVirtualControllerState[controllerIdentifier].Set(initialRawVirtualState);
+              SPhysicalControllerRecord& controllerRecord =
+                  physicalControllerRecords[controllerIdentifier];
+              controllerRecord.physicalState.Set(initialPhysicalState);
+              controllerRecord.rawVirtualState.Set(initialRawVirtualState);
             }
 
             // Ensure the system timer resolution is suitable for the desired polling frequency.
@@ -393,74 +1342,93 @@ namespace Xidi
                   timeResult);
             }
 
-            // Create and start the polling threads.
-            for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
-                 ++controllerIdentifier)
-            {
-              std::thread(PollForPhysicalControllerStateChanges, controllerIdentifier).detach();
-              Infra::Message::OutputFormatted(
-                  Infra::Message::ESeverity::Info,
-                  L"Initialized the physical controller state polling thread for controller %u. Desired polling period is %u ms.",
-                  (unsigned int)(1 + controllerIdentifier),
-                  kPhysicalPollingPeriodMilliseconds);
-            }
-
-            // Allocate the force feedback device buffers, then create and start the force feedback
-            // threads.
-            physicalControllerForceFeedbackBuffer =
-                new ForceFeedback::Device[kPhysicalControllerCount];
-            for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
-                 ++controllerIdentifier)
-            {
-              std::thread(ForceFeedbackActuateEffects, controllerIdentifier).detach();
-              Infra::Message::OutputFormatted(
-                  Infra::Message::ESeverity::Info,
-                  L"Initialized the physical controller force feedback actuation thread for controller %u. Desired actuation period is %u ms.",
-                  (unsigned int)(1 + controllerIdentifier),
-                  kPhysicalForceFeedbackPeriodMilliseconds);
-            }
-
-            // Create and start the physical controller hardware status monitoring threads, but only
-            // if the messages generated by those threads will actually be delivered as output.
+            // Create and start the device change notification thread, which allows vacant-slot
+            // polling to be parked until hardware actually arrives.
+            EnsureDeviceChangeNotificationMonitorStarted();
+
+            // Create and start the consolidated polling thread, which services all physical
+            // controller slots with per-slot scheduling.
+            std::thread(PollForPhysicalControllerStateChanges).detach();
+            Infra::Message::OutputFormatted(
+                Infra::Message::ESeverity::Info,
+                L"Initialized the physical controller state polling thread for all %u controllers. Default polling period is %u ms.",
+                (unsigned int)kPhysicalControllerCount,
+                kPhysicalPollingPeriodMilliseconds);
+
+            // Create and start the deferred status change logging thread, but only if the messages
+            // generated by that thread will actually be delivered as output. Status changes
+            // themselves are detected inline by the polling thread.
             if (Infra::Message::WillOutputMessageOfSeverity(Infra::Message::ESeverity::Warning))
             {
-              for (auto controllerIdentifier = 0; controllerIdentifier < kPhysicalControllerCount;
-                   ++controllerIdentifier)
-              {
-                std::thread(MonitorPhysicalControllerStatus, controllerIdentifier).detach();
-                Infra::Message::OutputFormatted(
-                    Infra::Message::ESeverity::Info,
-                    L"Initialized the physical controller hardware status monitoring thread for controller %u.",
-                    (unsigned int)(1 + controllerIdentifier));
-              }
+              std::thread(DrainStatusChangeLogMessages).detach();
+              Infra::Message::Output(
+                  Infra::Message::ESeverity::Info,
+                  L"Initialized the physical controller status change logging thread.");
             }
 
             isInitialized = true;
           });
     }
 
+    void EnsurePhysicalControllersInitialized(void)
+    {
+      Initialize();
+    }
+
+    uint32_t GetCoarseTimestampMilliseconds(void)
+    {
+      const uint32_t cachedTimestamp =
+          coarseTimestampMilliseconds.load(std::memory_order_relaxed);
+      if (0 != cachedTimestamp) return cachedTimestamp;
+
+      return ImportApiWinMM::timeGetTime();
+    }
+
     SCapabilities GetControllerCapabilities(TControllerIdentifier controllerIdentifier)
     {
+      // Capabilities are derived entirely from the configured mapper, which is fixed once
+      // selected, so a single immutable snapshot per controller serves all subsequent calls. Some
+      // applications re-enumerate device objects every frame, and each such call previously
+      // re-dispatched through the mapper registry.
+      static SCapabilities controllerCapabilities[kPhysicalControllerCount];
+      static std::once_flag controllerCapabilitiesFlag;
+
       Initialize();
-      return Mapper::GetConfigured(controllerIdentifier)->GetCapabilities();
+
+      std::call_once(
+          controllerCapabilitiesFlag,
+          []() -> void
+          {
+            for (TControllerIdentifier i = 0; i < kPhysicalControllerCount; ++i)
+              controllerCapabilities[i] = Mapper::GetConfigured(i)->GetCapabilities();
+          });
+
+      return controllerCapabilities[controllerIdentifier];
     }
 
     SPhysicalState GetCurrentPhysicalControllerState(TControllerIdentifier controllerIdentifier)
     {
       Initialize();
-      return physicalControllerState[controllerIdentifier].Get();
+      return physicalControllerRecords[controllerIdentifier].physicalState.Get();
     }
 
     SState GetCurrentRawVirtualControllerState(TControllerIdentifier controllerIdentifier)
     {
       Initialize();
-      return rawVirtualControllerState[controllerIdentifier].Get();
+      return physicalControllerRecords[controllerIdentifier].rawVirtualState.Get();
+    }
+
+    uint32_t GetDeviceChangeNotificationGeneration(void)
+    {
+      EnsureDeviceChangeNotificationMonitorStarted();
+      return deviceChangeGeneration.load(std::memory_order_acquire);
     }
 
     ForceFeedback::Device* PhysicalControllerForceFeedbackRegister(
         TControllerIdentifier controllerIdentifier, const VirtualController* virtualController)
     {
       Initialize();
+      EnsureForceFeedbackInitialized();
 
       if (controllerIdentifier >= kPhysicalControllerCount)
       {
@@ -471,8 +1439,15 @@ namespace Xidi
         return nullptr;
       }
 
-      std::unique_lock lock(physicalControllerForceFeedbackMutex[controllerIdentifier]);
-      physicalControllerForceFeedbackRegistration[controllerIdentifier].insert(virtualController);
+      // Recording happens before acquiring the lock so that a hang while waiting for it is
+      // visible in the flight record.
+      FlightRecorder::Record(
+          FlightRecorder::EEvent::ForceFeedbackRegister, controllerIdentifier);
+
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
+      std::unique_lock lock(controllerRecord.forceFeedbackMutex);
+      controllerRecord.forceFeedbackRegistration.insert(virtualController);
+      RecomputeCombinedForceFeedbackGain(controllerIdentifier);
 
       return &physicalControllerForceFeedbackBuffer[controllerIdentifier];
     }
@@ -491,8 +1466,108 @@ namespace Xidi
         return;
       }
 
-      std::unique_lock lock(physicalControllerForceFeedbackMutex[controllerIdentifier]);
-      physicalControllerForceFeedbackRegistration[controllerIdentifier].erase(virtualController);
+      FlightRecorder::Record(
+          FlightRecorder::EEvent::ForceFeedbackUnregister, controllerIdentifier);
+
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
+      std::unique_lock lock(controllerRecord.forceFeedbackMutex);
+      controllerRecord.forceFeedbackRegistration.erase(virtualController);
+      RecomputeCombinedForceFeedbackGain(controllerIdentifier);
+    }
+
+    void PhysicalControllerForceFeedbackGainChanged(TControllerIdentifier controllerIdentifier)
+    {
+      if (controllerIdentifier >= kPhysicalControllerCount) return;
+
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
+      std::unique_lock lock(controllerRecord.forceFeedbackMutex);
+      RecomputeCombinedForceFeedbackGain(controllerIdentifier);
+    }
+
+    void PhysicalControllerPollingDemandRegister(void)
+    {
+      Initialize();
+
+      pollingDemandCount.fetch_add(1, std::memory_order_release);
+      pollingDemandSignal.Signal();
+    }
+
+    void PhysicalControllerPollingDemandUnregister(void)
+    {
+      pollingDemandCount.fetch_sub(1, std::memory_order_release);
+    }
+
+    void PhysicalControllerConsumedElementsRegister(
+        TControllerIdentifier controllerIdentifier, TElementMask elements)
+    {
+      if (controllerIdentifier >= kPhysicalControllerCount) return;
+
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
+      std::scoped_lock lock(consumedElementsGuard);
+
+      TElementMask newMask = 0;
+      for (unsigned int elementIndex = 0; elementIndex < kVirtualElementCount; ++elementIndex)
+      {
+        if (0 != (elements & ((TElementMask)1 << elementIndex)))
+          controllerRecord.consumedElementRefCount[elementIndex] += 1;
+        if (0 != controllerRecord.consumedElementRefCount[elementIndex])
+          newMask |= ((TElementMask)1 << elementIndex);
+      }
+
+      controllerRecord.consumedElementsMask.store(newMask, std::memory_order_release);
+    }
+
+    void PhysicalControllerConsumedElementsUnregister(
+        TControllerIdentifier controllerIdentifier, TElementMask elements)
+    {
+      if (controllerIdentifier >= kPhysicalControllerCount) return;
+
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
+      std::scoped_lock lock(consumedElementsGuard);
+
+      TElementMask newMask = 0;
+      for (unsigned int elementIndex = 0; elementIndex < kVirtualElementCount; ++elementIndex)
+      {
+        if (0 != (elements & ((TElementMask)1 << elementIndex)))
+          controllerRecord.consumedElementRefCount[elementIndex] -= 1;
+        if (0 != controllerRecord.consumedElementRefCount[elementIndex])
+          newMask |= ((TElementMask)1 << elementIndex);
+      }
+
+      controllerRecord.consumedElementsMask.store(newMask, std::memory_order_release);
+    }
+
+    void PhysicalControllerMarkConsumerRead(TControllerIdentifier controllerIdentifier)
+    {
+      if (controllerIdentifier >= kPhysicalControllerCount) return;
+
+      SPhysicalControllerRecord& controllerRecord = physicalControllerRecords[controllerIdentifier];
+
+      const uint64_t currentTimeMilliseconds = GetTickCount64();
+      const uint64_t lastReadTimeMilliseconds =
+          controllerRecord.consumerLastReadTimeMilliseconds.exchange(
+              currentTimeMilliseconds, std::memory_order_relaxed);
+      if (0 == lastReadTimeMilliseconds) return;
+
+      const uint64_t readIntervalMilliseconds = currentTimeMilliseconds - lastReadTimeMilliseconds;
+      if (readIntervalMilliseconds > kConsumerReadCadenceExpiryMilliseconds)
+      {
+        // Too much time passed since the previous read for it to describe a cadence, so begin
+        // learning afresh on the next read.
+        controllerRecord.consumerReadIntervalAverageMilliseconds.store(
+            0, std::memory_order_relaxed);
+        return;
+      }
+
+      const uint32_t previousReadIntervalAverage =
+          controllerRecord.consumerReadIntervalAverageMilliseconds.load(std::memory_order_relaxed);
+      const uint32_t newReadIntervalAverage =
+          ((0 == previousReadIntervalAverage)
+               ? (uint32_t)readIntervalMilliseconds
+               : (((3 * previousReadIntervalAverage) + (uint32_t)readIntervalMilliseconds) / 4));
+
+      controllerRecord.consumerReadIntervalAverageMilliseconds.store(
+          newReadIntervalAverage, std::memory_order_relaxed);
     }
 
     bool WaitForPhysicalControllerStateChange(
@@ -504,7 +1579,8 @@ namespace Xidi
 
       if (controllerIdentifier >= kPhysicalControllerCount) return false;
 
-      return physicalControllerState[controllerIdentifier].WaitForUpdate(state, stopToken);
+      return physicalControllerRecords[controllerIdentifier].physicalState.WaitForUpdate(
+          state, stopToken);
     }
 
     bool WaitForRawVirtualControllerStateChange(
@@ -514,7 +1590,164 @@ namespace Xidi
 
       if (controllerIdentifier >= kPhysicalControllerCount) return false;
 
-      return rawVirtualControllerState[controllerIdentifier].WaitForUpdate(state, stopToken);
+      return physicalControllerRecords[controllerIdentifier].rawVirtualState.WaitForUpdate(
+          state, stopToken);
     }
+
+    /// Implements the Xidi API interface #ILatency.
+    class LatencyProvider : public Api::ILatency
+    {
+    public:
+
+      // ILatency
+      int64_t GetLastCaptureTimestamp(unsigned int controllerIdentifier) const override
+      {
+        if (controllerIdentifier >= kPhysicalControllerCount) return 0;
+
+        Initialize();
+        return physicalControllerRecords[controllerIdentifier].physicalState.Get().captureTimestamp;
+      }
+
+      int64_t GetTimeSinceLastCaptureMicroseconds(unsigned int controllerIdentifier) const override
+      {
+        const int64_t lastCaptureTimestamp = GetLastCaptureTimestamp(controllerIdentifier);
+        if (0 == lastCaptureTimestamp) return -1;
+
+        LARGE_INTEGER counterFrequency;
+        QueryPerformanceFrequency(&counterFrequency);
+
+        LARGE_INTEGER currentTime;
+        QueryPerformanceCounter(&currentTime);
+
+        return (((currentTime.QuadPart - lastCaptureTimestamp) * 1000000LL) /
+                counterFrequency.QuadPart);
+      }
+    };
+
+    // Singleton Xidi API implementation object.
+    static LatencyProvider latencyProvider;
+
+    /// Implements the Xidi API interface #IStateChangeSubscription.
+    class StateChangeSubscriptionProvider : public Api::IStateChangeSubscription
+    {
+    public:
+
+      // IStateChangeSubscription
+      unsigned int Subscribe(
+          unsigned int controllerIdentifier,
+          TStateChangeCallback callback,
+          void* context) override
+      {
+        if ((controllerIdentifier >= kPhysicalControllerCount) || (nullptr == callback))
+          return 0;
+
+        Initialize();
+
+        // Subscribers receive full state snapshots, so for the lifetime of the subscription the
+        // mapping pass must produce every virtual controller element, regardless of which
+        // elements any other consumers read.
+        PhysicalControllerConsumedElementsRegister(controllerIdentifier, kElementMaskAll);
+
+        std::unique_lock lock(subscriptionGuard);
+        const unsigned int subscriptionToken = nextSubscriptionToken;
+        nextSubscriptionToken += 1;
+
+        subscriptions.emplace(
+            subscriptionToken,
+            SSubscription{
+                .controllerIdentifier = controllerIdentifier,
+                .notificationThread = std::jthread(
+                    [controllerIdentifier, callback, context](std::stop_token stopToken) -> void
+                    { NotificationThread(stopToken, controllerIdentifier, callback, context); })});
+
+        return subscriptionToken;
+      }
+
+      void Unsubscribe(unsigned int subscriptionToken) override
+      {
+        std::unique_lock lock(subscriptionGuard);
+        const auto subscriptionIter = subscriptions.find(subscriptionToken);
+        if (subscriptions.cend() == subscriptionIter) return;
+
+        const TControllerIdentifier controllerIdentifier =
+            subscriptionIter->second.controllerIdentifier;
+
+        // Destruction of the thread object requests a stop, which interrupts the blocking wait
+        // inside the notification thread, and then joins it.
+        subscriptions.erase(subscriptionIter);
+
+        PhysicalControllerConsumedElementsUnregister(controllerIdentifier, kElementMaskAll);
+      }
+
+    private:
+
+      /// Translates the internal virtual controller state representation into the plain
+      /// snapshot form delivered to subscribers.
+      /// @param [in] state Internal state representation to translate.
+      /// @return Translated state snapshot.
+      static SStateSnapshot MakeStateSnapshot(const SState& state)
+      {
+        static_assert(
+            kSnapshotAxisCount == (unsigned int)EAxis::Count,
+            "Axis count mismatch between the Xidi API and the internal state representation.");
+
+        SStateSnapshot stateSnapshot = {
+            .buttonMask = (uint32_t)state.button.to_ulong(),
+            .povDirectionMask = PovDirectionIndex(state.povDirection),
+            .captureTimestamp = state.captureTimestamp};
+
+        for (unsigned int axisIndex = 0; axisIndex < kSnapshotAxisCount; ++axisIndex)
+          stateSnapshot.axisValues[axisIndex] = state.axis[axisIndex];
+
+        return stateSnapshot;
+      }
+
+      /// Delivers state change notifications for one subscription. Blocks on the internal raw
+      /// virtual state wait infrastructure and invokes the subscriber's callback once per
+      /// published state change until the subscription is cancelled.
+      /// @param [in] stopToken Token used to interrupt the wait when the subscription is
+      /// cancelled.
+      /// @param [in] controllerIdentifier Identifier of the subscribed controller.
+      /// @param [in] callback Subscriber callback to invoke on each state change.
+      /// @param [in] context Subscriber context pointer.
+      static void NotificationThread(
+          std::stop_token stopToken,
+          TControllerIdentifier controllerIdentifier,
+          TStateChangeCallback callback,
+          void* context)
+      {
+        SState lastKnownState =
+            physicalControllerRecords[controllerIdentifier].rawVirtualState.Get();
+
+        while (true ==
+               WaitForRawVirtualControllerStateChange(
+                   controllerIdentifier, lastKnownState, stopToken))
+          callback(controllerIdentifier, MakeStateSnapshot(lastKnownState), context);
+      }
+
+      /// Information about one active subscription.
+      struct SSubscription
+      {
+        /// Identifier of the subscribed physical controller, retained so that the consumed
+        /// elements registration made at subscription time can be balanced at cancellation time.
+        TControllerIdentifier controllerIdentifier;
+
+        /// Notification thread that delivers state change notifications to the subscriber.
+        std::jthread notificationThread;
+      };
+
+      /// Active subscriptions, keyed by subscription token.
+      std::map<unsigned int, SSubscription> subscriptions;
+
+      /// Mutex for protecting against concurrent accesses to the subscription collection.
+      std::mutex subscriptionGuard;
+
+      /// Token to assign to the next subscription. Starts at 1 because 0 is reserved to
+      /// indicate subscription failure.
+      unsigned int nextSubscriptionToken = 1;
+    };
+
+    // Singleton Xidi API implementation object.
+    static StateChangeSubscriptionProvider stateChangeSubscriptionProvider;
   } // namespace Controller
 } // namespace Xidi
@@ -0,0 +1,96 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file Profiler.cpp
+ *   Implementation of sampling profiler hooks for hot-path code.
+ **************************************************************************************************/
+
+#include "Profiler.h"
+
+#ifndef XIDI_SKIP_PROFILING
+
+#include <atomic>
+#include <cstdint>
+
+#include "Globals.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace Profiler
+  {
+    /// Aggregated sample counts, one per instrumented site.
+    static std::atomic<uint64_t> siteSampleCount[(unsigned int)EProfileSite::Count];
+
+    /// Aggregated total cycles, one per instrumented site.
+    static std::atomic<uint64_t> siteTotalCycles[(unsigned int)EProfileSite::Count];
+
+    /// Aggregated maximum single-sample cycles, one per instrumented site.
+    static std::atomic<uint64_t> siteMaximumCycles[(unsigned int)EProfileSite::Count];
+
+    /// Per-thread decimation counters, one per instrumented site. Counting down per-thread means
+    /// selecting an invocation for sampling involves no synchronization whatsoever.
+    thread_local static unsigned int siteDecimationCounter[(unsigned int)EProfileSite::Count];
+
+    /// Retrieves the configured sampling interval. A value of N means one of every N invocations
+    /// of each instrumented site is sampled per thread, and 0 disables profiling entirely.
+    /// @return Configured sampling interval.
+    static unsigned int SamplingInterval(void)
+    {
+      static const unsigned int samplingInterval =
+          (unsigned int)Globals::GetConfigurationData()
+              [Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionLog)]
+              [Strings::kStrConfigurationSettingLogProfilingSampleInterval]
+                  .ValueOr(0);
+      return samplingInterval;
+    }
+
+    bool ShouldSample(EProfileSite site)
+    {
+      const unsigned int samplingInterval = SamplingInterval();
+      if (0 == samplingInterval) return false;
+
+      unsigned int& decimationCounter = siteDecimationCounter[(unsigned int)site];
+      if (0 != decimationCounter)
+      {
+        decimationCounter -= 1;
+        return false;
+      }
+
+      decimationCounter = (samplingInterval - 1);
+      return true;
+    }
+
+    void Submit(EProfileSite site, uint64_t elapsedCycles)
+    {
+      const unsigned int siteIndex = (unsigned int)site;
+
+      siteSampleCount[siteIndex].fetch_add(1, std::memory_order_relaxed);
+      siteTotalCycles[siteIndex].fetch_add(elapsedCycles, std::memory_order_relaxed);
+
+      uint64_t observedMaximum = siteMaximumCycles[siteIndex].load(std::memory_order_relaxed);
+      while ((elapsedCycles > observedMaximum) &&
+             (false ==
+              siteMaximumCycles[siteIndex].compare_exchange_weak(
+                  observedMaximum, elapsedCycles, std::memory_order_relaxed)))
+        ;
+    }
+
+    SSiteSamples GetSiteSamples(EProfileSite site)
+    {
+      if (site >= EProfileSite::Count) return {};
+
+      const unsigned int siteIndex = (unsigned int)site;
+      return {
+          .sampleCount = siteSampleCount[siteIndex].load(std::memory_order_relaxed),
+          .totalCycles = siteTotalCycles[siteIndex].load(std::memory_order_relaxed),
+          .maximumCycles = siteMaximumCycles[siteIndex].load(std::memory_order_relaxed)};
+    }
+  } // namespace Profiler
+} // namespace Xidi
+
+#endif
@@ -11,12 +11,22 @@
 
 #include "SetHooks.h"
 
+#include <mutex>
+
 #include <Hookshot/Hookshot.h>
 #include <Infra/Core/Message.h>
 #include <Infra/Core/Strings.h>
 
+#include "Globals.h"
+
 namespace Xidi
 {
+  void EnsureHookModuleInitialized(void)
+  {
+    static std::once_flag hookModuleInitializationFlag;
+    std::call_once(hookModuleInitializationFlag, []() -> void { Globals::Initialize(); });
+  }
+
   void OutputSetHookResult(const wchar_t* functionName, Hookshot::EResult setHookResult)
   {
     if (Hookshot::SuccessfulResult(setHookResult))
@@ -30,6 +40,34 @@ namespace Xidi
           functionName);
   }
 
+  void HookBatch::Prepare(
+      std::wstring_view functionName, void* originalFunc, const void* hookFunc)
+  {
+    hookSites.emplace_back(SHookSite{
+        .functionName = functionName,
+        .originalFunc = originalFunc,
+        .hookFunc = hookFunc,
+        .result = Hookshot::EResult::FailInternal});
+  }
+
+  size_t HookBatch::Commit(void)
+  {
+    size_t numSuccessfullyInstalled = 0;
+
+    // All installation attempts happen back-to-back, with logging deferred until afterwards, so
+    // that nothing but Hookshot's own code-patching work sits inside the commit pass.
+    for (auto& hookSite : hookSites)
+    {
+      hookSite.result = hookshot->CreateHook(hookSite.originalFunc, hookSite.hookFunc);
+      if (true == Hookshot::SuccessfulResult(hookSite.result)) numSuccessfullyInstalled += 1;
+    }
+
+    for (const auto& hookSite : hookSites)
+      OutputSetHookResult(hookSite.functionName.data(), hookSite.result);
+
+    return numSuccessfullyInstalled;
+  }
+
   void SetHookCoCreateInstance(Hookshot::IHookshot* hookshot)
   {
     OutputSetHookResult(L"CoCreateInstance", StaticHook_CoCreateInstance::SetHook(hookshot));
@@ -37,13 +75,17 @@ namespace Xidi
 
   void SetHooksForLibrary(
       Hookshot::IHookshot* hookshot,
-      Api::IImportFunctions2* apiImportFunctions,
+      Api::IImportFunctions3* apiImportFunctions,
       HMODULE xidiLibraryHandle,
-      Api::IImportFunctions2::ELibrary libraryIdentifier,
+      Api::IImportFunctions3::ELibrary libraryIdentifier,
       const wchar_t* libraryName,
       const wchar_t* libraryFilename,
       const wchar_t* replacementFunctionPrefix)
   {
+    // A DirectInput or WinMM library load is one of the signs of activity that triggers the hook
+    // module's deferred initialization.
+    EnsureHookModuleInitialized();
+
     Infra::Message::OutputFormatted(
         Infra::Message::ESeverity::Info, L"Beginning to set hooks for %s.", libraryName);
 
@@ -69,7 +111,10 @@ namespace Xidi
       return;
     }
 
-    std::unordered_map<std::wstring_view, const void*> replacementImportFunctions;
+    // Transaction preparation phase: resolve the addresses of every hook site up front, which
+    // requires no code patching, so that the commit phase consists of nothing but back-to-back
+    // hook installations.
+    HookBatch hookBatch(hookshot);
     for (const auto& systemFunction : *replaceableImportFunctions)
     {
       const std::wstring_view systemFunctionName = systemFunction.first;
@@ -101,12 +146,19 @@ namespace Xidi
         continue;
       }
 
-      const Hookshot::EResult hookResult = hookshot->CreateHook(systemFunc, replacementFunc);
-      OutputSetHookResult(systemFunctionName.data(), hookResult);
-      if (false == Hookshot::SuccessfulResult(hookResult)) continue;
+      hookBatch.Prepare(systemFunctionName, systemFunc, replacementFunc);
+    }
+
+    // Transaction commit phase.
+    hookBatch.Commit();
+
+    std::unordered_map<std::wstring_view, const void*> replacementImportFunctions;
+    for (const auto& hookSite : hookBatch.GetHookSites())
+    {
+      if (false == Hookshot::SuccessfulResult(hookSite.result)) continue;
 
-      replacementImportFunctions[systemFunctionName.data()] =
-          hookshot->GetOriginalFunction(systemFunc);
+      replacementImportFunctions[hookSite.functionName.data()] =
+          hookshot->GetOriginalFunction(hookSite.originalFunc);
     }
 
     const size_t numUnsuccessfullyHooked =
@@ -135,9 +187,10 @@ namespace Xidi
       TerminateProcess(Infra::ProcessInfo::GetCurrentProcessHandle(), (UINT)-1);
     }
 
-    const size_t numSuccessfullyReplaced =
-        apiImportFunctions->SetReplaceable(libraryIdentifier, replacementImportFunctions);
-    if (replacementImportFunctions.size() == numSuccessfullyReplaced)
+    // A single batched call validates the entire replacement table and publishes it atomically,
+    // so either every hooked function has its original version submitted to Xidi or none do.
+    if (true ==
+        apiImportFunctions->SetReplaceableAll(libraryIdentifier, replacementImportFunctions))
     {
       // Every hooked function has its original version successfully submitted to Xidi.
       // This is important because Xidi invokes the functions it invokes from the system, and the
@@ -145,20 +198,19 @@ namespace Xidi
       Infra::Message::OutputFormatted(
           Infra::Message::ESeverity::Debug,
           L"Hooked and successfully replaced the import addresses for %d function(s).",
-          (int)numSuccessfullyReplaced);
+          (int)replacementImportFunctions.size());
     }
     else
     {
-      // It is a serious error to have hooked system functions but only replaced the import
-      // addresses on a strict subset of them. Xidi invokes the functions it imports from the
-      // system, and failure to replace the import addresses could lead to infinite accidental
-      // recursion because the system functions are redirected to Xidi. Thus, the application is
-      // practically guaranteed to freeze or crash.
+      // It is a serious error to have hooked system functions without replacing their import
+      // addresses. Xidi invokes the functions it imports from the system, and failure to replace
+      // the import addresses could lead to infinite accidental recursion because the system
+      // functions are redirected to Xidi. Thus, the application is practically guaranteed to
+      // freeze or crash.
       Infra::Message::OutputFormatted(
           Infra::Message::ESeverity::ForcedInteractiveError,
-          L"Hooked %d function(s) but only successfully replaced the import addresses for %d of them. The application will not function correctly in this state and is therefore being terminated.",
-          (int)replacementImportFunctions.size(),
-          (int)numSuccessfullyReplaced);
+          L"Hooked %d function(s) but failed to replace their import addresses. The application will not function correctly in this state and is therefore being terminated.",
+          (int)replacementImportFunctions.size());
       TerminateProcess(Infra::ProcessInfo::GetCurrentProcessHandle(), (UINT)-1);
     }
   }
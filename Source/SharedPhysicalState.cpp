@@ -0,0 +1,315 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file SharedPhysicalState.cpp
+ *   Implementation of opt-in cross-process sharing of physical controller state.
+ **************************************************************************************************/
+
+#include "SharedPhysicalState.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "Globals.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace SharedPhysicalState
+  {
+    using namespace ::Xidi::Controller;
+
+    /// Name of the shared-memory segment, scoped to the current desktop session.
+    static constexpr wchar_t kSharedSegmentName[] = L"Local\\XidiPhysicalControllerState";
+
+    /// Name of the mutex used for poller election, scoped to the current desktop session. The
+    /// elected poller holds this mutex for its entire lifetime, so if the poller process dies
+    /// consumers observe its heartbeat going stale and fall back to direct hardware reads.
+    static constexpr wchar_t kPollerMutexName[] = L"Local\\XidiPhysicalControllerStatePoller";
+
+    /// Magic value identifying a correctly-initialized shared segment. Exactly fills the magic
+    /// field, including its terminating null character.
+    static constexpr char kSegmentMagic[16] = "XidiSharedPhys1";
+
+    /// Layout version of the shared segment. Incremented whenever the segment or slot layout
+    /// changes, so that mixed-version processes detect the mismatch instead of misreading.
+    static constexpr uint32_t kSegmentLayoutVersion = 2;
+
+    /// Maximum age of the poller heartbeat before consumers consider the poller dead or idle and
+    /// fall back to direct hardware reads. Comfortably above the polling period so that normal
+    /// scheduling jitter does not cause spurious fallbacks.
+    static constexpr uint64_t kHeartbeatStalenessThresholdMilliseconds = 500;
+
+    /// Single per-controller slot in the shared segment. Each slot is aligned to the
+    /// destructive interference boundary so that slots for different controllers never share a
+    /// cache line. Snapshots are published and read using
+    /// the same seqlock scheme as #ConcurrencyWrapper: the version counter is odd while a write
+    /// is in progress, and a reader retries until it observes the same even version before and
+    /// after copying the state.
+    struct alignas(std::hardware_destructive_interference_size) SSharedStateSlot
+    {
+      /// Seqlock version counter for this slot.
+      std::atomic<uint32_t> version;
+
+      /// Latest published physical state snapshot.
+      SPhysicalState state;
+    };
+
+    static_assert(
+        alignof(SSharedStateSlot) >= std::hardware_destructive_interference_size,
+        "Per-controller shared slots must start on their own cache line.");
+    static_assert(
+        (sizeof(SSharedStateSlot) % std::hardware_destructive_interference_size) == 0,
+        "Adjacent per-controller shared slots must not share a cache line.");
+
+    /// Layout of the shared-memory segment. Created zero-filled by the operating system, with
+    /// the header written by the elected poller and the magic value written last, so consumers
+    /// that observe a valid magic value can trust the rest of the header.
+    struct SSharedStateSegment
+    {
+      /// Magic value, equal to #kSegmentMagic once the poller has initialized the segment.
+      char magic[16];
+
+      /// Layout version, equal to #kSegmentLayoutVersion.
+      uint32_t layoutVersion;
+
+      /// Size of a single physical state snapshot, in bytes. Guards against mixed Xidi builds
+      /// that disagree on the state structure layout.
+      uint32_t stateSizeBytes;
+
+      /// Number of per-controller slots in the segment.
+      uint32_t controllerCount;
+
+      /// Identifier of the poller process, for diagnostic purposes.
+      uint32_t pollerProcessId;
+
+      /// Tick count, in milliseconds since system start, of the poller's most recent publish.
+      /// Consumers treat a stale value as a dead or idle poller.
+      std::atomic<uint64_t> pollerHeartbeatTime;
+
+      /// Per-controller snapshot slots.
+      SSharedStateSlot slots[kPhysicalControllerCount];
+    };
+
+    /// View of the shared segment mapped into this process, or `nullptr` if shared mode is
+    /// inactive.
+    static SSharedStateSegment* sharedSegment = nullptr;
+
+    /// Whether this process was elected the poller.
+    static bool electedPoller = false;
+
+    /// Whether a consumer process has successfully validated the segment header. Validation is
+    /// retried until it succeeds because the poller may still be writing the header when a
+    /// consumer starts up.
+    static std::atomic<bool> segmentValidated = false;
+
+    /// Whether a consumer process has permanently rejected the segment due to a layout mismatch.
+    static std::atomic<bool> segmentRejected = false;
+
+    /// Performs one-time setup of shared mode: reads the configuration opt-in, performs the
+    /// poller election, maps the shared segment, and, if elected poller, initializes the segment
+    /// header.
+    /// @return `true` if shared mode is active for this process, `false` otherwise.
+    static bool InitializeSharedMode(void)
+    {
+      const bool sharedModeRequested =
+          Globals::GetConfigurationData()
+              [Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionProperties)]
+              [Strings::kStrConfigurationSettingsPropertiesUseSharedPhysicalState]
+                  .ValueOr(false);
+      if (false == sharedModeRequested) return false;
+
+      // The segment handle and poller mutex are deliberately leaked. Both must live for the
+      // entire process lifetime: the segment backs the mapped view, and holding the mutex is
+      // what marks this process as the active poller.
+      HANDLE sharedSegmentMapping = CreateFileMapping(
+          INVALID_HANDLE_VALUE,
+          nullptr,
+          PAGE_READWRITE,
+          0,
+          (DWORD)sizeof(SSharedStateSegment),
+          kSharedSegmentName);
+      if (NULL == sharedSegmentMapping)
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Shared physical state mode is disabled because the shared segment could not be created (error %u).",
+            (unsigned int)GetLastError());
+        return false;
+      }
+
+      HANDLE pollerMutex = CreateMutex(nullptr, FALSE, kPollerMutexName);
+      if (NULL == pollerMutex)
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Shared physical state mode is disabled because the poller election mutex could not be created (error %u).",
+            (unsigned int)GetLastError());
+        CloseHandle(sharedSegmentMapping);
+        return false;
+      }
+
+      // A process that acquires the mutex becomes the poller and holds it until it exits. An
+      // abandoned wait result means the previous poller died, in which case this process takes
+      // over publishing.
+      const DWORD pollerElectionResult = WaitForSingleObject(pollerMutex, 0);
+      electedPoller =
+          ((WAIT_OBJECT_0 == pollerElectionResult) || (WAIT_ABANDONED == pollerElectionResult));
+
+      void* const sharedSegmentView = MapViewOfFile(
+          sharedSegmentMapping,
+          ((true == electedPoller) ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ),
+          0,
+          0,
+          0);
+      if (nullptr == sharedSegmentView)
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Shared physical state mode is disabled because the shared segment could not be mapped (error %u).",
+            (unsigned int)GetLastError());
+        if (true == electedPoller) ReleaseMutex(pollerMutex);
+        CloseHandle(pollerMutex);
+        CloseHandle(sharedSegmentMapping);
+        electedPoller = false;
+        return false;
+      }
+
+      sharedSegment = (SSharedStateSegment*)sharedSegmentView;
+
+      if (true == electedPoller)
+      {
+        // Writing the magic value last, after all other header fields, means consumers that
+        // observe a valid magic value can trust the rest of the header. A release fence ensures
+        // the ordering is visible across processes.
+        sharedSegment->layoutVersion = kSegmentLayoutVersion;
+        sharedSegment->stateSizeBytes = (uint32_t)sizeof(SPhysicalState);
+        sharedSegment->controllerCount = kPhysicalControllerCount;
+        sharedSegment->pollerProcessId = (uint32_t)GetCurrentProcessId();
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(sharedSegment->magic, kSegmentMagic, sizeof(sharedSegment->magic));
+
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Info,
+            L"Shared physical state mode is active, and this process was elected the poller.");
+      }
+      else
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Info,
+            L"Shared physical state mode is active, and this process consumes snapshots published by another process.");
+      }
+
+      return true;
+    }
+
+    /// Validates the shared segment header from a consumer process, retrying on subsequent calls
+    /// until the poller has finished writing it. A layout mismatch permanently rejects the
+    /// segment.
+    /// @return `true` if the segment header is valid, `false` otherwise.
+    static bool ValidateSegmentForConsumption(void)
+    {
+      if (true == segmentValidated.load(std::memory_order_acquire)) return true;
+      if (true == segmentRejected.load(std::memory_order_relaxed)) return false;
+
+      if (0 != memcmp(sharedSegment->magic, kSegmentMagic, sizeof(sharedSegment->magic)))
+        return false;
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if ((kSegmentLayoutVersion != sharedSegment->layoutVersion) ||
+          ((uint32_t)sizeof(SPhysicalState) != sharedSegment->stateSizeBytes) ||
+          (kPhysicalControllerCount != sharedSegment->controllerCount))
+      {
+        segmentRejected.store(true, std::memory_order_relaxed);
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Warning,
+            L"Shared physical state snapshots are being ignored because the poller process uses an incompatible Xidi version. Falling back to direct hardware reads.");
+        return false;
+      }
+
+      segmentValidated.store(true, std::memory_order_release);
+      return true;
+    }
+
+    bool IsSharedModeActive(void)
+    {
+      static const bool sharedModeActive = InitializeSharedMode();
+      return sharedModeActive;
+    }
+
+    bool IsPoller(void)
+    {
+      return electedPoller;
+    }
+
+    void PublishPhysicalState(
+        TControllerIdentifier controllerIdentifier, const SPhysicalState& physicalState)
+    {
+      if ((false == IsSharedModeActive()) || (false == electedPoller)) return;
+      if (controllerIdentifier >= kPhysicalControllerCount) return;
+
+      SSharedStateSlot& slot = sharedSegment->slots[controllerIdentifier];
+
+      // Odd version number indicates to readers that a write is in progress.
+      slot.version.fetch_add(1, std::memory_order_acquire);
+      slot.state = physicalState;
+      slot.version.fetch_add(1, std::memory_order_release);
+
+      sharedSegment->pollerHeartbeatTime.store(GetTickCount64(), std::memory_order_release);
+    }
+
+    bool TryReadSharedPhysicalState(
+        TControllerIdentifier controllerIdentifier, SPhysicalState& physicalState)
+    {
+      if ((false == IsSharedModeActive()) || (true == electedPoller)) return false;
+      if (controllerIdentifier >= kPhysicalControllerCount) return false;
+      if (false == ValidateSegmentForConsumption()) return false;
+
+      const uint64_t pollerHeartbeatTime =
+          sharedSegment->pollerHeartbeatTime.load(std::memory_order_acquire);
+      if ((0 == pollerHeartbeatTime) ||
+          ((GetTickCount64() - pollerHeartbeatTime) > kHeartbeatStalenessThresholdMilliseconds))
+        return false;
+
+      const SSharedStateSlot& slot = sharedSegment->slots[controllerIdentifier];
+      uint32_t versionBeforeRead = 0;
+
+      do
+      {
+        versionBeforeRead = slot.version.load(std::memory_order_acquire);
+
+        // An odd version number means a write is in progress, in which case the data are not
+        // safe to read until the poller finishes and publishes an even version number. Unlike an
+        // in-process seqlock writer, the poller lives in another process and can die mid-write,
+        // which would leave the version number odd forever, so the wait re-checks heartbeat
+        // staleness instead of spinning unboundedly. On staleness this read fails and the caller
+        // falls back to a direct hardware read.
+        while (0 != (versionBeforeRead & 1))
+        {
+          if ((GetTickCount64() -
+               sharedSegment->pollerHeartbeatTime.load(std::memory_order_acquire)) >
+              kHeartbeatStalenessThresholdMilliseconds)
+            return false;
+
+          versionBeforeRead = slot.version.load(std::memory_order_acquire);
+        }
+
+        physicalState = slot.state;
+        std::atomic_thread_fence(std::memory_order_acquire);
+      }
+      while (slot.version.load(std::memory_order_relaxed) != versionBeforeRead);
+
+      return true;
+    }
+  } // namespace SharedPhysicalState
+} // namespace Xidi
@@ -11,44 +11,135 @@
 
 #include "StateChangeEventBuffer.h"
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cstdint>
-
-#include <boost/circular_buffer.hpp>
+#include <span>
 
 #include "ApiWindows.h"
 #include "ControllerTypes.h"
+#include "InputMetrics.h"
+#include "MemoryAccounting.h"
 
 namespace Xidi
 {
   namespace Controller
   {
-    /// Handles a possible buffer overflow condition.
-    /// @param [in] eventBuffer Event buffer object for which to check for overflow.
-    /// @return `true` if the event buffer overflowed, `false` otherwise.
-    static inline bool HandlePossibleOverflow(
-        boost::circular_buffer<StateChangeEventBuffer::SEvent>& eventBuffer)
+    /// Next available event sequence number, globally ordered with respect to all controller
+    /// events, even those from other event buffers.
+    static std::atomic<uint32_t> nextSequence = 0;
+
+    /// Fraction of the usable event buffer capacity, expressed as a numerator and denominator,
+    /// above which the opt-in coalescing policy begins merging events. Chosen to leave enough
+    /// headroom that genuinely distinct events are still queued individually under normal load.
+    static constexpr uint32_t kCoalescingOccupancyThresholdNumerator = 3;
+
+    /// See #kCoalescingOccupancyThresholdNumerator.
+    static constexpr uint32_t kCoalescingOccupancyThresholdDenominator = 4;
+
+    uint32_t StateChangeEventBuffer::AllocateSequenceRange(uint32_t numSequenceNumbers)
+    {
+      return nextSequence.fetch_add(numSequenceNumbers, std::memory_order_relaxed);
+    }
+
+    void StateChangeEventBuffer::AppendEvent(
+        SEventData eventData, uint32_t timestamp, uint32_t sequence, int64_t captureTimestamp)
     {
+      if (0 == eventBufferCapacity) return;
+
+      const uint32_t storageIndexMask = (eventStorageSize - 1);
+      const uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+
+      // Near-overflow coalescing: once occupancy passes the threshold, an axis or POV event that
+      // refers to the same controller element as the newest queued event replaces that event's
+      // value in place instead of consuming another slot. Only the latest value of a
+      // slowly-drained element is interesting, whereas button events always queue individually so
+      // their press and release edges are never lost. Requires opt-in via the configuration file.
+      if ((true == eventCoalescingEnabled) && (EElementType::Button != eventData.element.type))
+      {
+        const uint32_t occupancy = (tail - headIndex.load(std::memory_order_acquire));
+        const uint32_t occupancyThreshold =
+            (((eventBufferCapacity - 1) * kCoalescingOccupancyThresholdNumerator) /
+             kCoalescingOccupancyThresholdDenominator);
+
+        if ((occupancy >= occupancyThreshold) && (0 != occupancy))
+        {
+          SEvent& newestEvent = eventStorage[(tail - 1) & storageIndexMask];
+
+          if (newestEvent.data.element == eventData.element)
+          {
+            newestEvent.data = eventData;
+            newestEvent.timestamp = timestamp;
+            newestEvent.sequence = sequence;
+            newestEvent.captureTimestamp = captureTimestamp;
+
+            totalCoalescedEventCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+          }
+        }
+      }
+
+      eventStorage[tail & storageIndexMask] = {
+          .data = eventData,
+          .timestamp = timestamp,
+          .sequence = sequence,
+          .captureTimestamp = captureTimestamp};
+      tailIndex.store(tail + 1, std::memory_order_release);
+
       // Per DirectInput documentation, we always need one free space in the buffer.
       // This is how we ensure the number of events stored is always one less than capacity.
+      // The oldest event is discarded on overflow, using compare-and-exchange because the consumer
+      // may concurrently advance the head by popping.
+      uint32_t numEventsDropped = 0;
+      uint32_t head = headIndex.load(std::memory_order_acquire);
 
-      const bool eventBufferWasFull = ((0 != eventBuffer.size()) && (true == eventBuffer.full()));
+      while (((tail + 1) - head) > (eventBufferCapacity - 1))
+      {
+        if (true ==
+            headIndex.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel))
+        {
+          numEventsDropped += 1;
+          head += 1;
+        }
+      }
 
-      if (true == eventBufferWasFull) eventBuffer.pop_front();
+      eventBufferOverflowed.store((0 != numEventsDropped), std::memory_order_release);
 
-      return eventBufferWasFull;
+      if (0 != numEventsDropped)
+      {
+        totalOverflowCount.fetch_add(1, std::memory_order_relaxed);
+        totalDroppedEventCount.fetch_add(numEventsDropped, std::memory_order_relaxed);
+        InputMetrics::RecordEventBufferOverflow(numEventsDropped);
+      }
+
+      // Only the producer updates the high-water mark, so a plain compare-and-store suffices.
+      const uint32_t eventCountAfterAppend = ((tail + 1) - head);
+      if (eventCountAfterAppend > eventCountHighWaterMark.load(std::memory_order_relaxed))
+      {
+        eventCountHighWaterMark.store(eventCountAfterAppend, std::memory_order_relaxed);
+        InputMetrics::RecordEventBufferHighWaterMark(eventCountAfterAppend);
+      }
     }
 
-    void StateChangeEventBuffer::AppendEvent(SEventData eventData, uint32_t timestamp)
+    StateChangeEventBuffer::SEventSpans StateChangeEventBuffer::GetEvents(
+        uint32_t maxEvents) const
     {
-      // Sequence number is globally ordered with respect to all controller events, even those from
-      // other event buffers.
-      static std::atomic<uint32_t> nextSequence = 0;
+      const uint32_t head = headIndex.load(std::memory_order_acquire);
+      const uint32_t tail = tailIndex.load(std::memory_order_acquire);
+      const uint32_t numEventsPresent = (tail - head);
+      const uint32_t numEvents = ((maxEvents > numEventsPresent) ? numEventsPresent : maxEvents);
 
-      eventBuffer.push_back(
-          {.data = eventData, .timestamp = timestamp, .sequence = nextSequence++});
+      if (0 == numEvents) return {};
 
-      eventBufferOverflowed = HandlePossibleOverflow(eventBuffer);
+      const uint32_t headStorageIndex = (head & (eventStorageSize - 1));
+      const uint32_t numEventsBeforeWraparound = (eventStorageSize - headStorageIndex);
+      const uint32_t firstPieceCount =
+          ((numEvents > numEventsBeforeWraparound) ? numEventsBeforeWraparound : numEvents);
+
+      return {
+          .first = std::span<const SEvent>(&eventStorage[headStorageIndex], firstPieceCount),
+          .second = std::span<const SEvent>(eventStorage, (numEvents - firstPieceCount))};
     }
 
     void StateChangeEventBuffer::PopOldestEvents(uint32_t numEventsToPop)
@@ -56,23 +147,139 @@ namespace Xidi
       // Popping 0 events is a no-op.
       if (numEventsToPop > 0)
       {
-        for (uint32_t i = 0; (i < numEventsToPop) && (false == eventBuffer.empty()); ++i)
-          eventBuffer.pop_front();
+        uint32_t head = headIndex.load(std::memory_order_acquire);
+
+        while (true)
+        {
+          const uint32_t tail = tailIndex.load(std::memory_order_acquire);
+          const uint32_t numEventsPresent = (tail - head);
+          const uint32_t numEventsActuallyToPop =
+              ((numEventsToPop > numEventsPresent) ? numEventsPresent : numEventsToPop);
+
+          if (0 == numEventsActuallyToPop) break;
 
-        eventBufferOverflowed = false;
+          if (true ==
+              headIndex.compare_exchange_weak(
+                  head, head + numEventsActuallyToPop, std::memory_order_acq_rel))
+            break;
+        }
+
+        eventBufferOverflowed.store(false, std::memory_order_release);
+      }
+    }
+
+    StateChangeEventBuffer::~StateChangeEventBuffer(void)
+    {
+      if (nullptr != eventStorage)
+      {
+        MemoryAccounting::RecordRelease(
+            MemoryAccounting::ESubsystem::EventBuffers,
+            (sizeof(SEvent) * eventStorageNumCommitted));
+        VirtualFree(eventStorage, 0, MEM_RELEASE);
       }
     }
 
     void StateChangeEventBuffer::SetCapacity(uint32_t capacity)
     {
       // Setting the capacity to the same as the current capacity is a no-op.
-      if (GetCapacity() != capacity)
+      if (GetCapacity() == capacity) return;
+
+      // Low-memory mode trades away buffering headroom for a hard cap on the ring storage
+      // that can ever be committed per virtual controller.
+      const uint32_t capacityMax =
+          ((true == MemoryAccounting::IsLowMemoryModeEnabled()) ? kEventBufferCapacityLowMemoryMax
+                                                                : kEventBufferCapacityMax);
+      const uint32_t newCapacity = ((capacity > capacityMax) ? capacityMax : capacity);
+      const uint32_t newStorageSizeMin = ((0 == newCapacity) ? 0 : std::bit_ceil(newCapacity));
+
+      // In-place path: whenever the ring storage is already large enough for the new capacity,
+      // the change is purely logical. The storage size, and hence the index mask, are left
+      // untouched, so the queued events stay exactly where they are and the whole resize is a
+      // few stores. The storage size never shrinks, so once a buffer has been large every later
+      // capacity change mid-session takes this path.
+      if ((0 != eventStorageSize) && (newStorageSizeMin <= eventStorageSize))
+      {
+        const uint32_t head = headIndex.load(std::memory_order_acquire);
+        const uint32_t tail = tailIndex.load(std::memory_order_acquire);
+        const uint32_t numEventsPresent = (tail - head);
+
+        // Per DirectInput documentation, we always need one free space in the buffer.
+        // This is how we ensure the number of events stored is always one less than capacity.
+        const uint32_t numEventsStoredMax = ((0 == newCapacity) ? 0 : (newCapacity - 1));
+        const uint32_t numEventsRetained =
+            ((numEventsPresent > numEventsStoredMax) ? numEventsStoredMax : numEventsPresent);
+
+        eventBufferCapacity = newCapacity;
+
+        if (numEventsRetained < numEventsPresent)
+        {
+          // The most recent events are retained, consistent with the overwrite-oldest behavior
+          // of appending to a full buffer. Disabling the buffer discards everything and leaves
+          // no overflow condition behind, same as before storage was arena-backed.
+          headIndex.store((tail - numEventsRetained), std::memory_order_release);
+          eventBufferOverflowed.store((0 != newCapacity), std::memory_order_release);
+
+          const uint32_t numEventsDropped = (numEventsPresent - numEventsRetained);
+          totalOverflowCount.fetch_add(1, std::memory_order_relaxed);
+          totalDroppedEventCount.fetch_add(numEventsDropped, std::memory_order_relaxed);
+          InputMetrics::RecordEventBufferOverflow(numEventsDropped);
+        }
+        else
+        {
+          eventBufferOverflowed.store(false, std::memory_order_release);
+        }
+
+        return;
+      }
+
+      // Growth path: the new capacity needs more ring storage than is currently in use, either
+      // because the buffer is being enabled for the first time or because it was never this large
+      // before. Address space for the entire arena is reserved on first enable, and pages are
+      // committed on demand as the ring storage grows.
+      if (nullptr == eventStorage)
       {
-        const uint32_t newCapacity =
-            ((capacity > kEventBufferCapacityMax) ? kEventBufferCapacityMax : capacity);
-        eventBuffer.rset_capacity(newCapacity);
-        eventBufferOverflowed = HandlePossibleOverflow(eventBuffer);
+        eventStorage = (SEvent*)VirtualAlloc(
+            nullptr, (sizeof(SEvent) * kEventStorageSlotsMax), MEM_RESERVE, PAGE_READWRITE);
+        if (nullptr == eventStorage) return;
+      }
+
+      if (newStorageSizeMin > eventStorageNumCommitted)
+      {
+        if (nullptr ==
+            VirtualAlloc(
+                eventStorage, (sizeof(SEvent) * newStorageSizeMin), MEM_COMMIT, PAGE_READWRITE))
+          return;
+
+        MemoryAccounting::RecordAllocation(
+            MemoryAccounting::ESubsystem::EventBuffers,
+            (sizeof(SEvent) * (newStorageSizeMin - eventStorageNumCommitted)));
+        eventStorageNumCommitted = newStorageSizeMin;
       }
+
+      const uint32_t head = headIndex.load(std::memory_order_acquire);
+      const uint32_t tail = tailIndex.load(std::memory_order_acquire);
+      const uint32_t numEventsPresent = (tail - head);
+
+      // Growing the storage size changes the index mask, so any queued events must be moved to
+      // positions that are valid under the new mask. Rotating the old ring storage in place
+      // linearizes it so the oldest event lands at storage index 0, which is valid under any
+      // larger storage size. This only happens when the buffer grows beyond its previous maximum,
+      // never on a shrink or a re-grow within it.
+      if (0 != numEventsPresent)
+      {
+        const uint32_t oldStorageIndexMask = (eventStorageSize - 1);
+
+        std::rotate(
+            eventStorage,
+            &eventStorage[(tail - numEventsPresent) & oldStorageIndexMask],
+            &eventStorage[eventStorageSize]);
+      }
+
+      eventStorageSize = newStorageSizeMin;
+      eventBufferCapacity = newCapacity;
+      headIndex.store(0, std::memory_order_release);
+      tailIndex.store(numEventsPresent, std::memory_order_release);
+      eventBufferOverflowed.store(false, std::memory_order_release);
     }
   } // namespace Controller
 } // namespace Xidi
@@ -0,0 +1,323 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file StateTrace.cpp
+ *   Implementation of record-and-replay functionality for physical controller state traces.
+ **************************************************************************************************/
+
+#include "StateTrace.h"
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <Infra/Core/Message.h>
+
+#include "ApiWindows.h"
+#include "ConcurrencyWrapper.h"
+#include "ControllerTypes.h"
+#include "Globals.h"
+#include "ImportApiWinMM.h"
+#include "Strings.h"
+
+namespace Xidi
+{
+  namespace StateTrace
+  {
+    using namespace ::Xidi::Controller;
+
+    /// Maximum number of trace records written to the trace file in a single write operation by
+    /// the writer thread.
+    static constexpr unsigned int kTraceWriteBatchSize = 64;
+
+    /// Queue of trace records awaiting file output. Filled only by the polling thread and
+    /// drained only by the trace writer thread, matching the ring buffer's single-producer
+    /// single-consumer model. If the queue nevertheless fills, further records are dropped
+    /// rather than ever blocking the polling thread.
+    static SpscRingBuffer<STraceRecord, 256> traceRecordQueue;
+
+    /// Signal counter used by the trace writer thread to wait for records to appear in the
+    /// queue.
+    static SignalCounter traceRecordSignal;
+
+    /// Last physical state recorded for each controller, used to suppress records for polls that
+    /// observed no state change. Accessed only by the polling thread.
+    static SPhysicalState lastRecordedState[kPhysicalControllerCount];
+
+    /// Whether any state has been recorded yet for each controller. Accessed only by the polling
+    /// thread.
+    static bool haveRecordedState[kPhysicalControllerCount];
+
+    /// Time at which recording started, in milliseconds since system start. Trace record
+    /// timestamps are expressed relative to this time.
+    static uint32_t recordingStartTimeMilliseconds;
+
+    /// Trace records loaded from the replay trace file, one time-ordered stream per physical
+    /// controller.
+    static std::vector<STraceRecord> replayRecords[kPhysicalControllerCount];
+
+    /// Index of the next replay record to be applied for each controller. Accessed only by the
+    /// polling thread.
+    static size_t replayNextIndex[kPhysicalControllerCount];
+
+    /// Trace state currently in effect for each controller during replay. Accessed only by the
+    /// polling thread.
+    static SPhysicalState replayCurrentState[kPhysicalControllerCount];
+
+    /// Time at which replay started, in milliseconds since system start.
+    static uint32_t replayStartTimeMilliseconds;
+
+    /// Configured replay speed, in percent of the originally recorded speed.
+    static unsigned int replaySpeedPercent;
+
+    /// Drains the queue of trace records and writes them to the trace file in batches. Intended
+    /// to be a thread entry point. Runs at lowest priority because trace output is never
+    /// time-critical.
+    /// @param [in] traceFile Open handle to the trace file, positioned just past the header.
+    static void WriteTraceRecordsToFile(HANDLE traceFile)
+    {
+      SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+
+      while (true)
+      {
+        traceRecordSignal.Wait(
+            []() -> bool
+            {
+              return (false == traceRecordQueue.Empty());
+            });
+
+        STraceRecord recordsToWrite[kTraceWriteBatchSize];
+        unsigned int numRecordsToWrite = 0;
+        while ((numRecordsToWrite < kTraceWriteBatchSize) &&
+               (true == traceRecordQueue.TryPop(recordsToWrite[numRecordsToWrite])))
+          numRecordsToWrite += 1;
+
+        DWORD numBytesWritten = 0;
+        WriteFile(
+            traceFile,
+            recordsToWrite,
+            (numRecordsToWrite * sizeof(STraceRecord)),
+            &numBytesWritten,
+            nullptr);
+      }
+    }
+
+    /// Starts trace recording if it is enabled in the configuration file, by creating the
+    /// configured trace file, writing its header, and starting the trace writer thread.
+    /// @return `true` if recording was successfully started, `false` otherwise.
+    static bool StartRecordingIfConfigured(void)
+    {
+      const auto& configData = Globals::GetConfigurationData();
+      const std::wstring_view stateTraceSectionName =
+          Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionStateTrace);
+      if (false == configData.Contains(stateTraceSectionName)) return false;
+
+      const auto& stateTraceConfigData = configData[stateTraceSectionName];
+      if (false ==
+          stateTraceConfigData.Contains(Strings::kStrConfigurationSettingStateTraceRecordFilename))
+        return false;
+
+      std::wstring_view recordFilename =
+          stateTraceConfigData[Strings::kStrConfigurationSettingStateTraceRecordFilename]
+              ->GetString();
+
+      const HANDLE traceFile = CreateFileW(
+          recordFilename.data(),
+          GENERIC_WRITE,
+          FILE_SHARE_READ,
+          nullptr,
+          CREATE_ALWAYS,
+          FILE_ATTRIBUTE_NORMAL,
+          nullptr);
+      if (INVALID_HANDLE_VALUE == traceFile)
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Failed with code %u to create the state trace recording file \"%s\".",
+            GetLastError(),
+            recordFilename.data());
+        return false;
+      }
+
+      STraceFileHeader traceFileHeader = {
+          .version = kTraceFileVersion, .recordSizeBytes = sizeof(STraceRecord)};
+      memcpy(traceFileHeader.magic, kTraceFileMagic, sizeof(kTraceFileMagic));
+
+      DWORD numBytesWritten = 0;
+      if ((FALSE ==
+           WriteFile(
+               traceFile, &traceFileHeader, sizeof(traceFileHeader), &numBytesWritten, nullptr)) ||
+          (sizeof(traceFileHeader) != numBytesWritten))
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Failed with code %u to write the header of the state trace recording file \"%s\".",
+            GetLastError(),
+            recordFilename.data());
+        CloseHandle(traceFile);
+        return false;
+      }
+
+      recordingStartTimeMilliseconds = ImportApiWinMM::timeGetTime();
+      std::thread(WriteTraceRecordsToFile, traceFile).detach();
+
+      Infra::Message::OutputFormatted(
+          Infra::Message::ESeverity::Info,
+          L"Recording physical controller state changes to \"%s\".",
+          recordFilename.data());
+      return true;
+    }
+
+    /// Loads the replay trace file if replay is enabled in the configuration file, distributing
+    /// its records into per-controller streams and reading the configured replay speed.
+    /// @return `true` if a replay trace was successfully loaded, `false` otherwise.
+    static bool LoadReplayTraceIfConfigured(void)
+    {
+      const auto& configData = Globals::GetConfigurationData();
+      const std::wstring_view stateTraceSectionName =
+          Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionStateTrace);
+      if (false == configData.Contains(stateTraceSectionName)) return false;
+
+      const auto& stateTraceConfigData = configData[stateTraceSectionName];
+      if (false ==
+          stateTraceConfigData.Contains(Strings::kStrConfigurationSettingStateTraceReplayFilename))
+        return false;
+
+      std::wstring_view replayFilename =
+          stateTraceConfigData[Strings::kStrConfigurationSettingStateTraceReplayFilename]
+              ->GetString();
+
+      const HANDLE traceFile = CreateFileW(
+          replayFilename.data(),
+          GENERIC_READ,
+          FILE_SHARE_READ,
+          nullptr,
+          OPEN_EXISTING,
+          FILE_ATTRIBUTE_NORMAL,
+          nullptr);
+      if (INVALID_HANDLE_VALUE == traceFile)
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Failed with code %u to open the state trace replay file \"%s\".",
+            GetLastError(),
+            replayFilename.data());
+        return false;
+      }
+
+      STraceFileHeader traceFileHeader = {};
+      DWORD numBytesRead = 0;
+      if ((FALSE ==
+           ReadFile(traceFile, &traceFileHeader, sizeof(traceFileHeader), &numBytesRead, nullptr)) ||
+          (sizeof(traceFileHeader) != numBytesRead) ||
+          (0 != memcmp(traceFileHeader.magic, kTraceFileMagic, sizeof(kTraceFileMagic))) ||
+          (kTraceFileVersion != traceFileHeader.version) ||
+          (sizeof(STraceRecord) != traceFileHeader.recordSizeBytes))
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"State trace replay file \"%s\" is missing, truncated, or has an unsupported layout.",
+            replayFilename.data());
+        CloseHandle(traceFile);
+        return false;
+      }
+
+      unsigned int numRecordsLoaded = 0;
+      while (true)
+      {
+        STraceRecord traceRecord = {};
+        if ((FALSE == ReadFile(traceFile, &traceRecord, sizeof(traceRecord), &numBytesRead, nullptr)) ||
+            (sizeof(traceRecord) != numBytesRead))
+          break;
+
+        if (traceRecord.controllerIdentifier < kPhysicalControllerCount)
+        {
+          replayRecords[traceRecord.controllerIdentifier].push_back(traceRecord);
+          numRecordsLoaded += 1;
+        }
+      }
+
+      CloseHandle(traceFile);
+
+      replaySpeedPercent = (unsigned int)stateTraceConfigData
+                               [Strings::kStrConfigurationSettingStateTraceReplaySpeedPercent]
+                                   .ValueOr(100);
+      if (0 == replaySpeedPercent) replaySpeedPercent = 100;
+
+      // Until the first record for a controller takes effect, replay reports the controller as
+      // not connected, exactly as live hardware would before a controller is plugged in.
+      for (TControllerIdentifier i = 0; i < kPhysicalControllerCount; ++i)
+        replayCurrentState[i] = {.deviceStatus = EPhysicalDeviceStatus::NotConnected};
+
+      replayStartTimeMilliseconds = ImportApiWinMM::timeGetTime();
+
+      Infra::Message::OutputFormatted(
+          Infra::Message::ESeverity::Info,
+          L"Replaying %u physical controller state changes from \"%s\" at %u%% speed.",
+          numRecordsLoaded,
+          replayFilename.data(),
+          replaySpeedPercent);
+      return true;
+    }
+
+    void SubmitPolledState(
+        TControllerIdentifier controllerIdentifier, const SPhysicalState& physicalState)
+    {
+      static const bool recordingActive = StartRecordingIfConfigured();
+      if (false == recordingActive) return;
+      if (controllerIdentifier >= kPhysicalControllerCount) return;
+
+      // Physical state comparison excludes the capture timestamp, so only polls that observed an
+      // actual state change produce trace records.
+      if ((true == haveRecordedState[controllerIdentifier]) &&
+          (physicalState == lastRecordedState[controllerIdentifier]))
+        return;
+
+      haveRecordedState[controllerIdentifier] = true;
+      lastRecordedState[controllerIdentifier] = physicalState;
+
+      traceRecordQueue.TryPush(TraceRecordFromPhysicalState(
+          (ImportApiWinMM::timeGetTime() - recordingStartTimeMilliseconds),
+          controllerIdentifier,
+          physicalState));
+      traceRecordSignal.Signal();
+    }
+
+    bool TryReadReplayState(
+        TControllerIdentifier controllerIdentifier, SPhysicalState& physicalState)
+    {
+      static const bool replayActive = LoadReplayTraceIfConfigured();
+      if (false == replayActive) return false;
+      if (controllerIdentifier >= kPhysicalControllerCount) return false;
+
+      const uint64_t elapsedTraceTimeMilliseconds =
+          ((uint64_t)(ImportApiWinMM::timeGetTime() - replayStartTimeMilliseconds) *
+           replaySpeedPercent) /
+          100;
+
+      const std::vector<STraceRecord>& records = replayRecords[controllerIdentifier];
+      size_t& nextIndex = replayNextIndex[controllerIdentifier];
+      while ((nextIndex < records.size()) &&
+             ((uint64_t)records[nextIndex].timestampMilliseconds <= elapsedTraceTimeMilliseconds))
+      {
+        replayCurrentState[controllerIdentifier] = PhysicalStateFromTraceRecord(records[nextIndex]);
+        nextIndex += 1;
+      }
+
+      physicalState = replayCurrentState[controllerIdentifier];
+
+      // Replayed snapshots are stamped at read time, so end-to-end latency accounting measures
+      // the replayed pipeline the same way it measures the live one.
+      LARGE_INTEGER captureTime;
+      QueryPerformanceCounter(&captureTime);
+      physicalState.captureTimestamp = captureTime.QuadPart;
+
+      return true;
+    }
+  } // namespace StateTrace
+} // namespace Xidi
@@ -17,6 +17,7 @@
 #include <cctype>
 #include <cstdlib>
 #include <cwctype>
+#include <map>
 #include <mutex>
 #include <string>
 #include <string_view>
@@ -67,6 +68,34 @@ namespace Xidi
       return initString;
     }
 
+    std::wstring_view GetConfigurationFilePath(void)
+    {
+      static std::wstring initString;
+      static std::once_flag initFlag;
+
+      std::call_once(
+          initFlag,
+          []() -> void
+          {
+            std::wstring_view pieces[] = {
+                Infra::ProcessInfo::GetThisModuleDirectoryName(),
+                L"\\",
+                Infra::ProcessInfo::GetProductName(),
+                kStrConfigurationFileExtension};
+
+            size_t totalLength = 0;
+            for (int i = 0; i < _countof(pieces); ++i)
+              totalLength += pieces[i].length();
+
+            initString.reserve(1 + totalLength);
+
+            for (int i = 0; i < _countof(pieces); ++i)
+              initString.append(pieces[i]);
+          });
+
+      return initString;
+    }
+
     std::wstring_view GetSystemDirectoryName(void)
     {
       static std::wstring initString;
@@ -235,6 +264,65 @@ namespace Xidi
           guid.Data4[7]);
     }
 
+    std::wstring_view CaptureBackendConfigurationNameString(
+        Controller::TControllerIdentifier controllerIdentifier)
+    {
+      static std::wstring initStrings[Controller::kPhysicalControllerCount];
+      static std::once_flag initFlag;
+
+      std::call_once(
+          initFlag,
+          []() -> void
+          {
+            Infra::TemporaryString perControllerCaptureBackendString;
+
+            for (Controller::TControllerIdentifier i = 0; i < _countof(initStrings); ++i)
+            {
+              perControllerCaptureBackendString.Clear();
+              perControllerCaptureBackendString
+                  << kStrConfigurationSettingPropertiesCaptureBackend
+                  << kCharConfigurationSettingSeparator << (1 + i);
+              initStrings[i] = perControllerCaptureBackendString;
+            }
+          });
+
+      if (controllerIdentifier >= Controller::kPhysicalControllerCount) return std::wstring_view();
+
+      return initStrings[controllerIdentifier];
+    }
+
+    std::wstring_view ConfigurationProfileSectionName(std::wstring_view configurationSection)
+    {
+      static std::map<std::wstring_view, std::wstring> initStrings;
+      static std::once_flag initFlag;
+
+      std::call_once(
+          initFlag,
+          []() -> void
+          {
+            Infra::TemporaryString perSectionProfileString;
+
+            for (std::wstring_view section :
+                 {kStrConfigurationSectionLog,
+                  kStrConfigurationSectionMapper,
+                  kStrConfigurationSectionProperties,
+                  kStrConfigurationSectionStateTrace,
+                  kStrConfigurationSectionWorkerThreads,
+                  kStrConfigurationSectionWorkarounds})
+            {
+              perSectionProfileString.Clear();
+              perSectionProfileString << section << kCharConfigurationSectionProfileSeparator
+                                      << Infra::ProcessInfo::GetExecutableBaseName();
+              initStrings[section] = perSectionProfileString;
+            }
+          });
+
+      const auto profileSectionRecord = initStrings.find(configurationSection);
+      if (initStrings.cend() == profileSectionRecord) return std::wstring_view();
+
+      return profileSectionRecord->second;
+    }
+
     std::wstring_view MapperTypeConfigurationNameString(
         Controller::TControllerIdentifier controllerIdentifier)
     {
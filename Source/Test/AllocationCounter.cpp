@@ -0,0 +1,159 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file AllocationCounter.cpp
+ *   Implementation of test-process heap allocation counting, by replacement of the global
+ *   allocation operators with counting versions.
+ **************************************************************************************************/
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace XidiTest
+{
+  /// Total number of heap allocations made by the test process. Incremented by every invocation
+  /// of a global allocation operator.
+  static std::atomic<uint64_t> totalHeapAllocationCount;
+
+  uint64_t GetTotalHeapAllocationCount(void)
+  {
+    return totalHeapAllocationCount.load(std::memory_order_relaxed);
+  }
+
+  /// Counts one heap allocation and performs it.
+  /// @param [in] size Number of bytes requested.
+  /// @return Pointer to the newly-allocated memory, or `nullptr` on failure.
+  static void* CountedAllocate(std::size_t size)
+  {
+    totalHeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc((0 == size) ? 1 : size);
+  }
+
+  /// Counts one over-aligned heap allocation and performs it.
+  /// @param [in] size Number of bytes requested.
+  /// @param [in] alignment Required alignment, in bytes.
+  /// @return Pointer to the newly-allocated memory, or `nullptr` on failure.
+  static void* CountedAllocateAligned(std::size_t size, std::size_t alignment)
+  {
+    totalHeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return _aligned_malloc(((0 == size) ? 1 : size), alignment);
+  }
+} // namespace XidiTest
+
+void* operator new(std::size_t size)
+{
+  void* const allocation = ::XidiTest::CountedAllocate(size);
+  if (nullptr == allocation) throw std::bad_alloc();
+  return allocation;
+}
+
+void* operator new[](std::size_t size)
+{
+  void* const allocation = ::XidiTest::CountedAllocate(size);
+  if (nullptr == allocation) throw std::bad_alloc();
+  return allocation;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return ::XidiTest::CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return ::XidiTest::CountedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  void* const allocation =
+      ::XidiTest::CountedAllocateAligned(size, static_cast<std::size_t>(alignment));
+  if (nullptr == allocation) throw std::bad_alloc();
+  return allocation;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  void* const allocation =
+      ::XidiTest::CountedAllocateAligned(size, static_cast<std::size_t>(alignment));
+  if (nullptr == allocation) throw std::bad_alloc();
+  return allocation;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return ::XidiTest::CountedAllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return ::XidiTest::CountedAllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* allocation) noexcept
+{
+  std::free(allocation);
+}
+
+void operator delete[](void* allocation) noexcept
+{
+  std::free(allocation);
+}
+
+void operator delete(void* allocation, std::size_t) noexcept
+{
+  std::free(allocation);
+}
+
+void operator delete[](void* allocation, std::size_t) noexcept
+{
+  std::free(allocation);
+}
+
+void operator delete(void* allocation, const std::nothrow_t&) noexcept
+{
+  std::free(allocation);
+}
+
+void operator delete[](void* allocation, const std::nothrow_t&) noexcept
+{
+  std::free(allocation);
+}
+
+void operator delete(void* allocation, std::align_val_t) noexcept
+{
+  _aligned_free(allocation);
+}
+
+void operator delete[](void* allocation, std::align_val_t) noexcept
+{
+  _aligned_free(allocation);
+}
+
+void operator delete(void* allocation, std::size_t, std::align_val_t) noexcept
+{
+  _aligned_free(allocation);
+}
+
+void operator delete[](void* allocation, std::size_t, std::align_val_t) noexcept
+{
+  _aligned_free(allocation);
+}
+
+void operator delete(void* allocation, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  _aligned_free(allocation);
+}
+
+void operator delete[](void* allocation, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  _aligned_free(allocation);
+}
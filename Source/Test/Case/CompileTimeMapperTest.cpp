@@ -0,0 +1,220 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file CompileTimeMapperTest.cpp
+ *   Unit tests for the compile-time mapper facility, which generates fully-inlined state mapping
+ *   executors from constant-initialized element map definitions. The key property under test is
+ *   exact behavioral equivalence between a mapper that uses a compile-time executor and a mapper
+ *   built from the same definition that uses the runtime-compiled mapping tables.
+ **************************************************************************************************/
+
+#include "CompileTimeMapper.h"
+
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+
+#include <Infra/Test/TestCase.h>
+
+#include "ApiBitSet.h"
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "ElementMapper.h"
+#include "Mapper.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi::Controller;
+
+  /// Opaque source controller identifier used throughout this file.
+  static constexpr uint32_t kOpaqueSourceIdentifier = 0;
+
+  /// Element mappers referenced by the test element map definitions, constant-initialized in the
+  /// same style as the built-in mapper definitions.
+  namespace TestElementMappers
+  {
+    static constexpr AxisMapper kAxisX(EAxis::X);
+    static constexpr AxisMapper kAxisY(EAxis::Y);
+    static constexpr AxisMapper kAxisZPositive(EAxis::Z, EAxisDirection::Positive);
+    static constexpr AxisMapper kAxisRotX(EAxis::RotX);
+    static constexpr AxisMapper kAxisRotYPositive(EAxis::RotY, EAxisDirection::Positive);
+    static constexpr AxisMapper kAxisRotZNegative(EAxis::RotZ, EAxisDirection::Negative);
+
+    static constexpr DigitalAxisMapper kDigitalAxisX(EAxis::X);
+
+    static constexpr ButtonMapper kButton1(EButton::B1);
+    static constexpr ButtonMapper kButton2(EButton::B2);
+    static constexpr ButtonMapper kButton3(EButton::B3);
+    static constexpr ButtonMapper kButton4(EButton::B4);
+
+    static constexpr PovMapper kPovUp(EPovDirection::Up);
+    static constexpr PovMapper kPovDown(EPovDirection::Down);
+    static constexpr PovMapper kPovLeft(EPovDirection::Left);
+    static constexpr PovMapper kPovRight(EPovDirection::Right);
+  } // namespace TestElementMappers
+
+  /// Element map definition deliberately constructed to exercise every fused trivial operation
+  /// family: whole and half axes fed from analog sticks, buttons, and triggers, buttons fed from
+  /// all three input kinds, and POV directions fed from buttons and analog input.
+  static constexpr Mapper::UElementMapDefinition kTestDefinition(
+      {.stickLeftX = &TestElementMappers::kAxisX,
+       .stickLeftY = &TestElementMappers::kAxisY,
+       .stickRightX = &TestElementMappers::kButton3,
+       .stickRightY = &TestElementMappers::kPovUp,
+       .dpadUp = &TestElementMappers::kPovUp,
+       .dpadDown = &TestElementMappers::kPovDown,
+       .dpadLeft = &TestElementMappers::kPovLeft,
+       .dpadRight = &TestElementMappers::kPovRight,
+       .triggerLT = &TestElementMappers::kAxisZPositive,
+       .triggerRT = &TestElementMappers::kButton4,
+       .buttonA = &TestElementMappers::kButton1,
+       .buttonB = &TestElementMappers::kButton2,
+       .buttonX = &TestElementMappers::kAxisRotX,
+       .buttonY = &TestElementMappers::kAxisRotYPositive,
+       .buttonLB = &TestElementMappers::kAxisRotZNegative});
+
+  /// Element map definition that is not compilable because it contains a digital axis element
+  /// mapper, which the compile-time facility does not support.
+  static constexpr Mapper::UElementMapDefinition kDigitalDefinition(
+      {.stickLeftX = &TestElementMappers::kDigitalAxisX,
+       .stickLeftY = &TestElementMappers::kAxisY,
+       .buttonA = &TestElementMappers::kButton1,
+       .buttonB = &TestElementMappers::kButton2});
+
+  static_assert(
+      true == CompileTimeMapper::IsCompilable(kTestDefinition),
+      "Test definition is expected to be compilable.");
+  static_assert(
+      false == CompileTimeMapper::IsCompilable(kDigitalDefinition),
+      "Digital axis definitions are expected not to be compilable.");
+  static_assert(
+      15 == CompileTimeMapper::CountSteps(kTestDefinition),
+      "Compiled step count is expected to equal the number of present element mappers.");
+
+  /// Mapper that uses the runtime-compiled mapping tables, acting as the behavioral reference.
+  static const Mapper kRuntimeMapper(kTestDefinition);
+
+  /// Mapper built from the same definition but supplied with an executor generated at compile
+  /// time from that definition.
+  static const Mapper kCompileTimeMapper(
+      kTestDefinition,
+      Mapper::kDefaultForceFeedbackActuatorMap,
+      CompileTimeMapper::Executor<kTestDefinition>);
+
+  /// Creates a button set given a compile-time-constant list of buttons.
+  /// @param [in] buttons Initializer list containing all of the desired buttons to be added to
+  /// the set.
+  /// @return Button set representation of the button list.
+  static constexpr std::bitset<(int)EPhysicalButton::Count> ButtonSet(
+      std::initializer_list<EPhysicalButton> buttons)
+  {
+    std::bitset<(int)EPhysicalButton::Count> buttonSet;
+
+    for (auto button : buttons)
+      buttonSet[(int)button] = true;
+
+    return buttonSet;
+  }
+
+  /// Physical states covering analog extremes, neutral, deadzone-edge, and mixed values along
+  /// with assorted trigger and button combinations. Used to drive equivalence comparisons.
+  static const SPhysicalState kRepresentativePhysicalStates[] = {
+      {.deviceStatus = EPhysicalDeviceStatus::Ok},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .stick = {kAnalogValueMax, kAnalogValueMax, kAnalogValueMax, kAnalogValueMax}},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .stick = {kAnalogValueMin, kAnalogValueMin, kAnalogValueMin, kAnalogValueMin}},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok, .stick = {1, -1, 1, -1}},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .stick = {12000, -9000, 30000, -30000},
+       .trigger = {128, 64}},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .trigger = {kTriggerValueMax, kTriggerValueMax}},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .button = ButtonSet(
+           {EPhysicalButton::DpadUp, EPhysicalButton::DpadLeft, EPhysicalButton::A})},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .button = ButtonSet(
+           {EPhysicalButton::DpadDown,
+            EPhysicalButton::DpadRight,
+            EPhysicalButton::B,
+            EPhysicalButton::X,
+            EPhysicalButton::Y,
+            EPhysicalButton::LB})},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .stick = {-15000, 15000, kAnalogValueMax, kAnalogValueMin},
+       .trigger = {200, kTriggerValueMax},
+       .button = ButtonSet(
+           {EPhysicalButton::DpadUp, EPhysicalButton::B, EPhysicalButton::Y})},
+  };
+
+  // Verifies that a compile-time executor produces exactly the same virtual controller states as
+  // the runtime mapping tables built from the same definition, across representative physical
+  // states with all elements consumed.
+  TEST_CASE(CompileTimeMapper_EquivalentToRuntimeMapper_AllElementsConsumed)
+  {
+    for (const SPhysicalState& physicalState : kRepresentativePhysicalStates)
+    {
+      const SState runtimeState =
+          kRuntimeMapper.MapStatePhysicalToVirtual(physicalState, kOpaqueSourceIdentifier);
+      const SState compileTimeState =
+          kCompileTimeMapper.MapStatePhysicalToVirtual(physicalState, kOpaqueSourceIdentifier);
+
+      TEST_ASSERT(runtimeState == compileTimeState);
+    }
+  }
+
+  // Verifies equivalence when only a subset of virtual controller elements is consumed, which
+  // exercises the per-step skip logic of both executors.
+  TEST_CASE(CompileTimeMapper_EquivalentToRuntimeMapper_PartialElementMasks)
+  {
+    const TElementMask kConsumedElementMasks[] = {
+        ElementMaskBit({.type = EElementType::Axis, .axis = EAxis::X}),
+        (ElementMaskBit({.type = EElementType::Axis, .axis = EAxis::Z}) |
+         ElementMaskBit({.type = EElementType::Button, .button = EButton::B4})),
+        ElementMaskBit({.type = EElementType::Pov}),
+        0,
+    };
+
+    for (const TElementMask consumedElements : kConsumedElementMasks)
+    {
+      for (const SPhysicalState& physicalState : kRepresentativePhysicalStates)
+      {
+        const SState runtimeState = kRuntimeMapper.MapStatePhysicalToVirtual(
+            physicalState, kOpaqueSourceIdentifier, consumedElements);
+        const SState compileTimeState = kCompileTimeMapper.MapStatePhysicalToVirtual(
+            physicalState, kOpaqueSourceIdentifier, consumedElements);
+
+        TEST_ASSERT(runtimeState == compileTimeState);
+      }
+    }
+  }
+
+  // Verifies that the built-in mapper definitions that ship with compile-time executors remain
+  // equivalent to runtime mapping tables built from the same built-in definitions. The standard
+  // gamepad is used as a representative built-in.
+  TEST_CASE(CompileTimeMapper_EquivalentToRuntimeMapper_BuiltInStandardGamepad)
+  {
+    const Mapper* const builtInMapper = Mapper::GetByName(L"StandardGamepad");
+    TEST_ASSERT(nullptr != builtInMapper);
+
+    // Cloning the built-in mapper's element map produces a mapper that uses the runtime-compiled
+    // mapping tables, since only definition-constructed mappers can carry a compile-time
+    // executor.
+    const Mapper runtimeEquivalentMapper(builtInMapper->CloneElementMap().named);
+
+    for (const SPhysicalState& physicalState : kRepresentativePhysicalStates)
+    {
+      const SState builtInState =
+          builtInMapper->MapStatePhysicalToVirtual(physicalState, kOpaqueSourceIdentifier);
+      const SState runtimeEquivalentState = runtimeEquivalentMapper.MapStatePhysicalToVirtual(
+          physicalState, kOpaqueSourceIdentifier);
+
+      TEST_ASSERT(builtInState == runtimeEquivalentState);
+    }
+  }
+} // namespace XidiTest
@@ -0,0 +1,155 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file ConcurrencyWrapperTest.cpp
+ *   Unit tests for the concurrency utility library: signal counters and the single-producer
+ *   single-consumer ring buffer.
+ **************************************************************************************************/
+
+#include "ConcurrencyWrapper.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <Infra/Test/TestCase.h>
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+
+  // Verifies that each signal advances the version number.
+  TEST_CASE(ConcurrencyWrapper_SignalCounter_VersionAdvancesOnSignal)
+  {
+    SignalCounter signalCounter;
+
+    const uint32_t versionBeforeSignal = signalCounter.GetVersion();
+    signalCounter.Signal();
+    TEST_ASSERT(signalCounter.GetVersion() != versionBeforeSignal);
+  }
+
+  // Verifies that a version-based wait returns immediately if the version number already moved
+  // past the supplied last-known value, so a signal delivered before the wait starts cannot be
+  // missed.
+  TEST_CASE(ConcurrencyWrapper_SignalCounter_WaitReturnsImmediatelyOnOldVersion)
+  {
+    SignalCounter signalCounter;
+
+    const uint32_t versionBeforeSignal = signalCounter.GetVersion();
+    signalCounter.Signal();
+    signalCounter.Wait(versionBeforeSignal);
+  }
+
+  // Verifies that a predicate-based wait blocks until another thread changes the state the
+  // predicate examines and then signals.
+  TEST_CASE(ConcurrencyWrapper_SignalCounter_PredicateWaitObservesStateChange)
+  {
+    SignalCounter signalCounter;
+    std::atomic<bool> conditionHolds = false;
+
+    std::thread producerThread(
+        [&signalCounter, &conditionHolds]() -> void
+        {
+          conditionHolds.store(true, std::memory_order_release);
+          signalCounter.Signal();
+        });
+
+    signalCounter.Wait(
+        [&conditionHolds]() -> bool
+        {
+          return conditionHolds.load(std::memory_order_acquire);
+        });
+
+    TEST_ASSERT(true == conditionHolds.load(std::memory_order_acquire));
+    producerThread.join();
+  }
+
+  // Verifies that elements pushed into a ring buffer are popped in first-in first-out order and
+  // that emptiness is reported correctly along the way.
+  TEST_CASE(ConcurrencyWrapper_SpscRingBuffer_FirstInFirstOut)
+  {
+    SpscRingBuffer<int, 8> ringBuffer;
+    TEST_ASSERT(true == ringBuffer.Empty());
+
+    for (int i = 0; i < 5; ++i)
+      TEST_ASSERT(true == ringBuffer.TryPush(100 + i));
+    TEST_ASSERT(false == ringBuffer.Empty());
+
+    for (int i = 0; i < 5; ++i)
+    {
+      int poppedElement = 0;
+      TEST_ASSERT(true == ringBuffer.TryPop(poppedElement));
+      TEST_ASSERT((100 + i) == poppedElement);
+    }
+
+    TEST_ASSERT(true == ringBuffer.Empty());
+  }
+
+  // Verifies that pushing fails once the ring buffer is full and popping fails once it is empty.
+  TEST_CASE(ConcurrencyWrapper_SpscRingBuffer_FullAndEmptyBounds)
+  {
+    SpscRingBuffer<int, 4> ringBuffer;
+
+    int poppedElement = 0;
+    TEST_ASSERT(false == ringBuffer.TryPop(poppedElement));
+
+    for (int i = 0; i < 4; ++i)
+      TEST_ASSERT(true == ringBuffer.TryPush(i));
+    TEST_ASSERT(false == ringBuffer.TryPush(4));
+
+    for (int i = 0; i < 4; ++i)
+      TEST_ASSERT(true == ringBuffer.TryPop(poppedElement));
+    TEST_ASSERT(false == ringBuffer.TryPop(poppedElement));
+  }
+
+  // Verifies that the monotonic indices wrap correctly around the element array by cycling many
+  // times the ring buffer's capacity through it.
+  TEST_CASE(ConcurrencyWrapper_SpscRingBuffer_IndexWraparound)
+  {
+    SpscRingBuffer<int, 4> ringBuffer;
+
+    for (int i = 0; i < 100; ++i)
+    {
+      TEST_ASSERT(true == ringBuffer.TryPush(i));
+
+      int poppedElement = 0;
+      TEST_ASSERT(true == ringBuffer.TryPop(poppedElement));
+      TEST_ASSERT(i == poppedElement);
+    }
+
+    TEST_ASSERT(true == ringBuffer.Empty());
+  }
+
+  // Verifies that a producer thread and a consumer thread transfer a long sequence of elements
+  // through the ring buffer without loss, duplication, or reordering.
+  TEST_CASE(ConcurrencyWrapper_SpscRingBuffer_CrossThreadTransfer)
+  {
+    constexpr int kNumTestElements = 10000;
+
+    SpscRingBuffer<int, 16> ringBuffer;
+
+    std::thread producerThread(
+        [&ringBuffer]() -> void
+        {
+          for (int i = 0; i < kNumTestElements; ++i)
+            while (false == ringBuffer.TryPush(i))
+              std::this_thread::yield();
+        });
+
+    for (int i = 0; i < kNumTestElements; ++i)
+    {
+      int poppedElement = 0;
+      while (false == ringBuffer.TryPop(poppedElement))
+        std::this_thread::yield();
+
+      TEST_ASSERT(i == poppedElement);
+    }
+
+    producerThread.join();
+    TEST_ASSERT(true == ringBuffer.Empty());
+  }
+} // namespace XidiTest
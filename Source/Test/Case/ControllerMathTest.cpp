@@ -12,6 +12,7 @@
 #include "ControllerMath.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include <Infra/Test/TestCase.h>
 
@@ -145,6 +146,71 @@ namespace XidiTest
     }
   }
 
+  // Verifies that no transformation is applied to two-dimensional stick positions for a deadzone
+  // and saturation of 0 and 100, respectively. These settings indicate no deadzone or saturation
+  // point.
+  TEST_CASE(ControllerMath_RadialAnalogTransformNominal)
+  {
+    constexpr unsigned int kDeadzonePercent = 0;
+    constexpr unsigned int kSaturationPercent = 100;
+
+    constexpr SAnalogStickCoordinates kTestCoordinates[] = {
+        {.x = -32768, .y = 32767}, {.x = -100, .y = 100}, {.x = 0, .y = 0}, {.x = 32767, .y = 100}};
+
+    for (const auto& testCoordinates : kTestCoordinates)
+    {
+      TEST_ASSERT(
+          testCoordinates ==
+          ApplyRadialAnalogTransform(testCoordinates, kDeadzonePercent, kSaturationPercent));
+    }
+  }
+
+  // Verifies that the radial deadzone is applied to the magnitude of the whole stick vector, so a
+  // position whose individual axis displacements are each below the cutoff but whose magnitude is
+  // inside the deadzone still transforms to neutral, and that on-axis inputs match the scalar
+  // per-axis transform.
+  TEST_CASE(ControllerMath_RadialAnalogTransformWithDeadzone)
+  {
+    constexpr unsigned int kDeadzonePercent = 50;
+    constexpr unsigned int kSaturationPercent = 100;
+
+    // Magnitude of approximately 15620 is inside the 50-percent deadzone radius of 16383.
+    constexpr SAnalogStickCoordinates kCoordinatesInsideDeadzone = {.x = 12000, .y = -10000};
+    const SAnalogStickCoordinates actualNeutralCoordinates =
+        ApplyRadialAnalogTransform(kCoordinatesInsideDeadzone, kDeadzonePercent, kSaturationPercent);
+    TEST_ASSERT(0 == actualNeutralCoordinates.x);
+    TEST_ASSERT(0 == actualNeutralCoordinates.y);
+
+    // For an on-axis input the radial transform degenerates to the scalar per-axis transform.
+    constexpr int16_t kOnAxisInput = 20000;
+    const SAnalogStickCoordinates actualOnAxisCoordinates = ApplyRadialAnalogTransform(
+        {.x = kOnAxisInput, .y = 0}, kDeadzonePercent, kSaturationPercent);
+    TEST_ASSERT(SufficientlyEqual(
+        actualOnAxisCoordinates.x,
+        ApplyRawAnalogTransform(kOnAxisInput, kDeadzonePercent, kSaturationPercent)));
+    TEST_ASSERT(0 == actualOnAxisCoordinates.y);
+  }
+
+  // Verifies that a diagonal whose magnitude exceeds the saturation radius is clamped to the
+  // extreme analog magnitude while preserving direction, instead of each axis saturating
+  // independently.
+  TEST_CASE(ControllerMath_RadialAnalogTransformWithSaturation)
+  {
+    constexpr unsigned int kDeadzonePercent = 0;
+    constexpr unsigned int kSaturationPercent = 50;
+
+    constexpr int16_t kDiagonalInput = 30000;
+    const SAnalogStickCoordinates actualCoordinates = ApplyRadialAnalogTransform(
+        {.x = kDiagonalInput, .y = kDiagonalInput}, kDeadzonePercent, kSaturationPercent);
+
+    const double expectedScaleFactor =
+        32767.0 / std::sqrt(2.0 * (double)kDiagonalInput * (double)kDiagonalInput);
+    const int16_t expectedValue = (int16_t)((double)kDiagonalInput * expectedScaleFactor);
+
+    TEST_ASSERT(SufficientlyEqual(actualCoordinates.x, expectedValue));
+    TEST_ASSERT(SufficientlyEqual(actualCoordinates.y, expectedValue));
+  }
+
   // Verifies that no transformation is applied to trigger readings for a deadzone and saturation of
   // 0 and 100, respectively. These settings indicate no deadzone or saturation point.
   TEST_CASE(ControllerMath_TriggerTransformNominal)
@@ -246,6 +312,74 @@ namespace XidiTest
     }
   }
 
+  // Verifies that the vectorized analog batch transform produces exactly the same results as
+  // invoking the scalar transform once per lane, across a sweep of input values and per-lane
+  // deadzone and saturation configurations, including mixed pass-through and transforming lanes.
+  TEST_CASE(ControllerMath_AnalogTransformBatchMatchesScalar)
+  {
+    constexpr SAnalogTransformParams kTestParams[][4] = {
+        {{0, 100}, {0, 100}, {0, 100}, {0, 100}},
+        {{25, 100}, {25, 100}, {10, 90}, {10, 90}},
+        {{0, 100}, {0, 100}, {50, 75}, {50, 75}},
+        {{5, 95}, {5, 95}, {0, 100}, {0, 100}},
+        {{50, 50}, {0, 50}, {50, 100}, {33, 67}},
+    };
+
+    for (const auto& testParams : kTestParams)
+    {
+      for (int baseValue = -32767; baseValue <= 32767; baseValue += 149)
+      {
+        const int16_t rawValues[4] = {
+            (int16_t)baseValue,
+            (int16_t)(-baseValue),
+            (int16_t)(baseValue / 2),
+            (int16_t)((baseValue / 2) + 17)};
+
+        int16_t batchValues[4];
+        ApplyRawAnalogTransformBatch(rawValues, testParams, batchValues);
+
+        for (int lane = 0; lane < _countof(rawValues); ++lane)
+        {
+          const int16_t scalarValue = ApplyRawAnalogTransform(
+              rawValues[lane], testParams[lane].deadzonePercent, testParams[lane].saturationPercent);
+          TEST_ASSERT(scalarValue == batchValues[lane]);
+        }
+      }
+    }
+  }
+
+  // Verifies that the vectorized trigger batch transform produces exactly the same results as
+  // invoking the scalar transform once per lane, across all possible trigger values and several
+  // per-lane deadzone and saturation configurations.
+  TEST_CASE(ControllerMath_TriggerTransformBatchMatchesScalar)
+  {
+    constexpr SAnalogTransformParams kTestParams[][2] = {
+        {{0, 100}, {0, 100}},
+        {{25, 75}, {25, 75}},
+        {{0, 100}, {10, 90}},
+        {{40, 60}, {0, 100}},
+        {{50, 50}, {100, 100}},
+    };
+
+    for (const auto& testParams : kTestParams)
+    {
+      for (int rawValue = 0; rawValue <= 255; ++rawValue)
+      {
+        const uint8_t rawValues[2] = {(uint8_t)rawValue, (uint8_t)(255 - rawValue)};
+
+        uint8_t batchValues[2];
+        ApplyRawTriggerTransformBatch(rawValues, testParams, batchValues);
+
+        for (int lane = 0; lane < _countof(rawValues); ++lane)
+        {
+          const uint8_t scalarValue = ApplyRawTriggerTransform(
+              rawValues[lane], testParams[lane].deadzonePercent, testParams[lane].saturationPercent);
+          TEST_ASSERT(scalarValue == batchValues[lane]);
+        }
+      }
+    }
+  }
+
   // Verifies that analog sticks are correctly identified as "pressed" as a digital button if
   // sufficiently pressed in the positive direction. Only checks extreme values to avoid enforcing a
   // specific threshold value requirement.
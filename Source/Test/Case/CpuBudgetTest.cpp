@@ -0,0 +1,91 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file CpuBudgetTest.cpp
+ *   Unit tests for the CPU budget governor's period scale factor policy.
+ **************************************************************************************************/
+
+#include "CpuBudget.h"
+
+#include <Infra/Test/TestCase.h>
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+
+  // Verifies that a budget of 0 disables the governor, keeping the period scale factor at 1 and
+  // resetting it to 1 if any degradation was previously in effect.
+  TEST_CASE(CpuBudget_PeriodScaleFactor_DisabledBudgetResetsToOne)
+  {
+    TEST_ASSERT(1 == CpuBudget::ComputeNextPeriodScaleFactor(1, 500.0, 0));
+    TEST_ASSERT(1 == CpuBudget::ComputeNextPeriodScaleFactor(4, 500.0, 0));
+    TEST_ASSERT(
+        1 == CpuBudget::ComputeNextPeriodScaleFactor(CpuBudget::kMaxPeriodScaleFactor, 0.0, 0));
+  }
+
+  // Verifies that the period scale factor doubles while utilization exceeds the budget and never
+  // exceeds its maximum value.
+  TEST_CASE(CpuBudget_PeriodScaleFactor_DoublesWhileOverBudgetUpToMaximum)
+  {
+    constexpr unsigned int kTestBudgetPercent = 10;
+    constexpr double kTestOverBudgetUtilizationPercent = 12.5;
+
+    unsigned int periodScaleFactor = 1;
+
+    while (periodScaleFactor < CpuBudget::kMaxPeriodScaleFactor)
+    {
+      const unsigned int nextPeriodScaleFactor = CpuBudget::ComputeNextPeriodScaleFactor(
+          periodScaleFactor, kTestOverBudgetUtilizationPercent, kTestBudgetPercent);
+      TEST_ASSERT((2 * periodScaleFactor) == nextPeriodScaleFactor);
+      periodScaleFactor = nextPeriodScaleFactor;
+    }
+
+    TEST_ASSERT(
+        CpuBudget::kMaxPeriodScaleFactor ==
+        CpuBudget::ComputeNextPeriodScaleFactor(
+            periodScaleFactor, kTestOverBudgetUtilizationPercent, kTestBudgetPercent));
+  }
+
+  // Verifies that the period scale factor halves once utilization drops below three quarters of
+  // the budget and never drops below 1.
+  TEST_CASE(CpuBudget_PeriodScaleFactor_HalvesWhileWellUnderBudgetDownToOne)
+  {
+    constexpr unsigned int kTestBudgetPercent = 10;
+    constexpr double kTestWellUnderBudgetUtilizationPercent = 2.0;
+
+    unsigned int periodScaleFactor = CpuBudget::kMaxPeriodScaleFactor;
+
+    while (periodScaleFactor > 1)
+    {
+      const unsigned int nextPeriodScaleFactor = CpuBudget::ComputeNextPeriodScaleFactor(
+          periodScaleFactor, kTestWellUnderBudgetUtilizationPercent, kTestBudgetPercent);
+      TEST_ASSERT((periodScaleFactor / 2) == nextPeriodScaleFactor);
+      periodScaleFactor = nextPeriodScaleFactor;
+    }
+
+    TEST_ASSERT(
+        1 ==
+        CpuBudget::ComputeNextPeriodScaleFactor(
+            periodScaleFactor, kTestWellUnderBudgetUtilizationPercent, kTestBudgetPercent));
+  }
+
+  // Verifies that the period scale factor holds steady while utilization sits in the hysteresis
+  // band between three quarters of the budget and the budget itself.
+  TEST_CASE(CpuBudget_PeriodScaleFactor_StableWithinHysteresisBand)
+  {
+    constexpr unsigned int kTestBudgetPercent = 10;
+    constexpr double kTestInBandUtilizationPercent = 8.5;
+
+    for (unsigned int periodScaleFactor = 1;
+         periodScaleFactor <= CpuBudget::kMaxPeriodScaleFactor;
+         periodScaleFactor *= 2)
+      TEST_ASSERT(
+          periodScaleFactor ==
+          CpuBudget::ComputeNextPeriodScaleFactor(
+              periodScaleFactor, kTestInBandUtilizationPercent, kTestBudgetPercent));
+  }
+} // namespace XidiTest
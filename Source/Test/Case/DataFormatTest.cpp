@@ -2826,4 +2826,53 @@ namespace XidiTest
       TestDataFormatCreateFailure(kTestFormatSpec, kTestMapperWithPov.GetCapabilities());
     }
   }
+
+  // Identical creation requests through the shared creation interface must all be satisfied by
+  // the same immutable data format object, whereas a request with different controller
+  // capabilities must be satisfied by a different object.
+  TEST_CASE(DataFormat_CreateShared_IdenticalRequestsShareOneObject)
+  {
+    struct STestDataPacket
+    {
+      TAxisValue axisValueX;
+      TAxisValue axisValueY;
+    };
+
+    static_assert(
+        0 == (sizeof(STestDataPacket) % 4), "Test data packet size must be divisible by 4.");
+
+    DIOBJECTDATAFORMAT testObjectFormatSpec[] = {
+        {.pguid = nullptr,
+         .dwOfs = offsetof(STestDataPacket, axisValueX),
+         .dwType = DIDFT_AXIS | DIDFT_ANYINSTANCE,
+         .dwFlags = 0},
+        {.pguid = nullptr,
+         .dwOfs = offsetof(STestDataPacket, axisValueY),
+         .dwType = DIDFT_AXIS | DIDFT_ANYINSTANCE,
+         .dwFlags = 0}};
+
+    const DIDATAFORMAT kTestFormatSpec = {
+        .dwSize = sizeof(DIDATAFORMAT),
+        .dwObjSize = sizeof(DIOBJECTDATAFORMAT),
+        .dwFlags = DIDF_ABSAXIS,
+        .dwDataSize = sizeof(STestDataPacket),
+        .dwNumObjs = _countof(testObjectFormatSpec),
+        .rgodf = testObjectFormatSpec};
+
+    std::shared_ptr<const DataFormat> firstDataFormat =
+        DataFormat::CreateSharedFromApplicationFormatSpec(
+            kTestFormatSpec, kTestMapperWithPov.GetCapabilities());
+    TEST_ASSERT(nullptr != firstDataFormat);
+
+    std::shared_ptr<const DataFormat> secondDataFormat =
+        DataFormat::CreateSharedFromApplicationFormatSpec(
+            kTestFormatSpec, kTestMapperWithPov.GetCapabilities());
+    TEST_ASSERT(secondDataFormat.get() == firstDataFormat.get());
+
+    std::shared_ptr<const DataFormat> differentCapabilitiesDataFormat =
+        DataFormat::CreateSharedFromApplicationFormatSpec(
+            kTestFormatSpec, kTestMapperWithoutPov.GetCapabilities());
+    TEST_ASSERT(nullptr != differentCapabilitiesDataFormat);
+    TEST_ASSERT(differentCapabilitiesDataFormat.get() != firstDataFormat.get());
+  }
 } // namespace XidiTest
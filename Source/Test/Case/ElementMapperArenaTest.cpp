@@ -0,0 +1,124 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file ElementMapperArenaTest.cpp
+ *   Unit tests for the arena allocator that holds element mapper object graphs.
+ **************************************************************************************************/
+
+#include "ElementMapperArena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <Infra/Test/TestCase.h>
+
+#include "ControllerTypes.h"
+#include "ElementMapper.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi::Controller;
+
+  // Verifies that activation scopes correctly set, nest, and restore the arena that is active on
+  // the calling thread.
+  TEST_CASE(ElementMapperArena_ActivationScopeNesting)
+  {
+    TEST_ASSERT(nullptr == ElementMapperArena::ActiveArena());
+
+    ElementMapperArena outerArena;
+    ElementMapperArena innerArena;
+
+    {
+      const ElementMapperArena::ActivationScope outerScope(outerArena);
+      TEST_ASSERT(&outerArena == ElementMapperArena::ActiveArena());
+
+      {
+        const ElementMapperArena::ActivationScope innerScope(innerArena);
+        TEST_ASSERT(&innerArena == ElementMapperArena::ActiveArena());
+      }
+
+      TEST_ASSERT(&outerArena == ElementMapperArena::ActiveArena());
+    }
+
+    TEST_ASSERT(nullptr == ElementMapperArena::ActiveArena());
+  }
+
+  // Verifies that successive small allocations from an arena are placed back-to-back within a
+  // single contiguous block of memory, which is the entire point of using an arena.
+  TEST_CASE(ElementMapperArena_AllocationsAreContiguous)
+  {
+    constexpr size_t kAllocationSizeBytes = 24;
+    constexpr int kNumAllocations = 16;
+
+    ElementMapperArena arena;
+
+    uintptr_t previousAllocation = (uintptr_t)arena.Allocate(kAllocationSizeBytes);
+    for (int i = 1; i < kNumAllocations; ++i)
+    {
+      const uintptr_t currentAllocation = (uintptr_t)arena.Allocate(kAllocationSizeBytes);
+
+      TEST_ASSERT(currentAllocation > previousAllocation);
+      TEST_ASSERT(
+          (currentAllocation - previousAllocation) <=
+          (kAllocationSizeBytes + alignof(std::max_align_t)));
+
+      previousAllocation = currentAllocation;
+    }
+  }
+
+  // Verifies that element mappers cloned under an activation scope can be safely destructed both
+  // before and after other arena-backed objects, with the arena reclaiming all of the memory at
+  // once upon its own destruction.
+  TEST_CASE(ElementMapperArena_CloneAndDestroyElementMappers)
+  {
+    ElementMapperArena arena;
+
+    const AxisMapper kTemplateMapper(EAxis::X);
+
+    std::unique_ptr<IElementMapper> clonedMappers[4];
+
+    {
+      const ElementMapperArena::ActivationScope activationScope(arena);
+      for (auto& clonedMapper : clonedMappers)
+        clonedMapper = kTemplateMapper.Clone();
+    }
+
+    for (const auto& clonedMapper : clonedMappers)
+      TEST_ASSERT(EElementMapperType::Axis == clonedMapper->GetType());
+
+    // Destroying arena-backed element mappers runs their destructors but leaves their memory to
+    // be reclaimed by the arena, so destruction in any order and at any time before the arena
+    // itself is destroyed must be safe.
+    clonedMappers[1].reset();
+    clonedMappers[3].reset();
+    clonedMappers[0].reset();
+    clonedMappers[2].reset();
+  }
+
+  // Verifies that element mappers allocated with no active arena continue to use the default heap
+  // and can outlive any arena that existed at the time they were created.
+  TEST_CASE(ElementMapperArena_HeapFallbackWithoutActiveArena)
+  {
+    std::unique_ptr<IElementMapper> heapMapper;
+
+    {
+      ElementMapperArena arena;
+      const AxisMapper kTemplateMapper(EAxis::RotZ);
+
+      {
+        const ElementMapperArena::ActivationScope activationScope(arena);
+      }
+
+      // No scope is active here, so this clone must come from the default heap even though an
+      // arena exists.
+      heapMapper = kTemplateMapper.Clone();
+    }
+
+    TEST_ASSERT(EElementMapperType::Axis == heapMapper->GetType());
+  }
+} // namespace XidiTest
@@ -0,0 +1,90 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file FlightRecorderTest.cpp
+ *   Unit tests for the in-memory flight recorder of recent input pipeline activity.
+ **************************************************************************************************/
+
+#include "FlightRecorder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <Infra/Test/TestCase.h>
+
+#include "ApiWindows.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi::FlightRecorder;
+
+  /// Scans the flight recorder ring for a fully-written record matching the specified event type
+  /// and first parameter. The flight recorder is process-global and other tests also write to it,
+  /// so locating a specific record requires scanning rather than indexing.
+  /// @param [in] event Event type for which to search.
+  /// @param [in] param1 First parameter value for which to search.
+  /// @return Pointer to a matching record, or `nullptr` if no matching record is present.
+  static const SRecord* FindRecord(EEvent event, uint32_t param1)
+  {
+    const SRecordArea& recordArea = GetRecordArea();
+
+    for (const auto& record : recordArea.records)
+    {
+      if ((0 != record.sequence.load(std::memory_order_acquire)) && (event == record.event) &&
+          (param1 == record.param1))
+        return &record;
+    }
+
+    return nullptr;
+  }
+
+  // Verifies that the flight recorder area header correctly describes the layout that post-mortem
+  // tooling would find in a crash dump, beginning with the magic value.
+  TEST_CASE(FlightRecorder_AreaHeader)
+  {
+    const SRecordArea& recordArea = GetRecordArea();
+
+    TEST_ASSERT(0 == memcmp(recordArea.magic, kRecordAreaMagic, sizeof(recordArea.magic)));
+    TEST_ASSERT(0 != recordArea.version);
+    TEST_ASSERT(sizeof(SRecord) == recordArea.recordSizeBytes);
+    TEST_ASSERT(kRecordCapacity == recordArea.recordCapacity);
+  }
+
+  // Verifies that a recorded event is stored into the ring with all of its parameters, a nonzero
+  // sequence number, and the identifier of the recording thread.
+  TEST_CASE(FlightRecorder_RecordStored)
+  {
+    constexpr uint32_t kTestParam1 = 0xfeedfa01;
+    constexpr uint32_t kTestParam2 = 22;
+    constexpr uint32_t kTestParam3 = 33;
+
+    Record(EEvent::DeviceAcquire, kTestParam1, kTestParam2, kTestParam3);
+
+    const SRecord* const record = FindRecord(EEvent::DeviceAcquire, kTestParam1);
+    TEST_ASSERT(nullptr != record);
+    TEST_ASSERT(kTestParam2 == record->param2);
+    TEST_ASSERT(kTestParam3 == record->param3);
+    TEST_ASSERT(GetCurrentThreadId() == record->threadId);
+  }
+
+  // Verifies that the ring wraps around once more events have been recorded than it has capacity
+  // to hold, overwriting the oldest records while retaining the most recent.
+  TEST_CASE(FlightRecorder_RingWraps)
+  {
+    constexpr uint32_t kOldestParam1 = 0xfeedfa02;
+    constexpr uint32_t kNewestParam1 = 0xfeedfa03;
+
+    Record(EEvent::DeviceUnacquire, kOldestParam1);
+
+    for (uint32_t i = 0; i < kRecordCapacity; ++i)
+      Record(EEvent::DeviceUnacquire, kNewestParam1);
+
+    TEST_ASSERT(nullptr == FindRecord(EEvent::DeviceUnacquire, kOldestParam1));
+    TEST_ASSERT(nullptr != FindRecord(EEvent::DeviceUnacquire, kNewestParam1));
+  }
+} // namespace XidiTest
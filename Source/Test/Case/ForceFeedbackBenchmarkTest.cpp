@@ -0,0 +1,228 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file ForceFeedbackBenchmarkTest.cpp
+ *   Benchmarks for the force feedback playback pipeline, which runs on a 5 millisecond real-time
+ *   actuation loop. These cases measure the computational cost of an actuation pass, from
+ *   starting an effect through magnitude computation and virtual-to-physical actuator mapping,
+ *   and report how that cost scales with the number of concurrently playing effects. Correctness
+ *   assertions are intentionally minimal; functional coverage lives in the other test files.
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "ElementMapper.h"
+#include "Mapper.h"
+#include "MockForceFeedbackEffect.h"
+#include "MockPhysicalController.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::AxisMapper;
+  using ::Xidi::Controller::EAxis;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::TControllerIdentifier;
+  using ::Xidi::Controller::ForceFeedback::Device;
+  using ::Xidi::Controller::ForceFeedback::SPhysicalActuatorComponents;
+  using ::Xidi::Controller::ForceFeedback::TEffectTimeMs;
+  using ::Xidi::Controller::ForceFeedback::TOrderedMagnitudeComponents;
+
+  /// Test mapper for benchmark runs. Describes a virtual controller with the X and Y axes to
+  /// which benchmark effects are associated, using the default force feedback actuator map so
+  /// both motors receive a magnitude projection of those two axes.
+  static const Mapper kBenchmarkMapper(
+      {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
+       .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y)});
+
+  /// Controller identifier used for benchmark runs.
+  static constexpr TControllerIdentifier kBenchmarkControllerIdentifier = 0;
+
+  /// Duration of benchmark effects. Long enough that effects never finish during a benchmark
+  /// run, so every playback pass computes magnitudes for every started effect.
+  static constexpr TEffectTimeMs kBenchmarkEffectDuration = 1000000;
+
+  /// Number of start-to-actuation samples collected for the latency benchmark. Large enough to
+  /// produce stable percentile figures, small enough to keep the test suite quick.
+  static constexpr unsigned int kBenchmarkNumLatencySamples = 10000;
+
+  /// Number of playback passes per effect count for the throughput benchmark.
+  static constexpr unsigned int kBenchmarkNumPasses = 20000;
+
+  /// Numbers of concurrently playing effects for which per-pass cost is measured.
+  static constexpr unsigned int kBenchmarkEffectCounts[] = {1, 2, 4, 8, 16, 32};
+
+  /// Initializes a mock periodic effect configured the way a representative application would: a
+  /// two-axis direction, an attack and fade envelope, and a waveform period on the order of tens
+  /// of milliseconds. This exercises the multi-axis direction math and the envelope path on
+  /// every magnitude computation.
+  /// @return Properly-initialized mock effect object ready for playback.
+  static MockPeriodicEffect MakeBenchmarkEffect(void)
+  {
+    static constexpr TEffectValue kBenchmarkCartesianCoordinates[] = {1, 1};
+
+    MockPeriodicEffect effect;
+
+    TEST_ASSERT(true == effect.SetAssociatedAxes({.count = 2, .type = {EAxis::X, EAxis::Y}}));
+    TEST_ASSERT(
+        true ==
+        effect.Direction().SetDirectionUsingCartesian(
+            kBenchmarkCartesianCoordinates, _countof(kBenchmarkCartesianCoordinates)));
+    TEST_ASSERT(true == effect.SetDuration(kBenchmarkEffectDuration));
+    TEST_ASSERT(
+        true ==
+        effect.SetEnvelope(
+            {.attackTime = 100, .attackLevel = 2500, .fadeTime = 100, .fadeLevel = 0}));
+    TEST_ASSERT(
+        true ==
+        effect.SetTypeSpecificParameters(
+            {.amplitude = 5000, .offset = 0, .phase = 0, .period = 50}));
+
+    return effect;
+  }
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to microseconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in microseconds.
+  static double TicksToMicroseconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return (((double)elapsedTicks * 1000000.0) / (double)frequency.QuadPart);
+  }
+
+  /// Retrieves the sample at the specified percentile from a sorted set of latency samples.
+  /// @param [in] sortedSamples Latency samples, sorted in ascending order.
+  /// @param [in] percentile Desired percentile, from 0 to 100.
+  /// @return Sample value at the desired percentile.
+  static double SampleAtPercentile(const std::vector<double>& sortedSamples, unsigned int percentile)
+  {
+    return sortedSamples[((size_t)percentile * (sortedSamples.size() - 1)) / 100];
+  }
+
+  // Measures the computational cost between an application starting an effect and the physical
+  // actuator values for it being ready to send to the controller. Each sample covers starting
+  // the effect, one playback pass at one actuation period after the start, and the
+  // virtual-to-physical actuator mapping, which together are the work the actuation thread does
+  // on its first pass after a start. Reports per-sample latency percentiles in microseconds.
+  // The actuation period itself is a fixed scheduling delay on top of these figures and is not
+  // part of the measurement.
+  TEST_CASE(ForceFeedbackBenchmark_StartToFirstActuation)
+  {
+    MockPhysicalController physicalController(kBenchmarkControllerIdentifier, kBenchmarkMapper);
+    Device& device = physicalController.GetForceFeedbackDevice();
+
+    const MockPeriodicEffect effect = MakeBenchmarkEffect();
+    TEST_ASSERT(true == device.AddOrUpdateEffect(effect));
+
+    // Accumulating actuator output prevents the magnitude computations from being optimized away
+    // and doubles as a cheap sanity check that the pipeline actually produced output.
+    uint64_t outputAccumulator = 0;
+
+    std::vector<double> latencySamples;
+    latencySamples.reserve(kBenchmarkNumLatencySamples);
+
+    for (unsigned int i = 0; i < kBenchmarkNumLatencySamples; ++i)
+    {
+      const TEffectTimeMs startTimestamp = (TEffectTimeMs)(i * 7);
+
+      LARGE_INTEGER sampleStartTime = {};
+      LARGE_INTEGER sampleEndTime = {};
+      QueryPerformanceCounter(&sampleStartTime);
+
+      TEST_ASSERT(true == device.StartEffect(effect.Identifier(), 1, startTimestamp));
+
+      const TOrderedMagnitudeComponents virtualMagnitudeVector =
+          device.PlayEffects(startTimestamp + 5);
+      const SPhysicalActuatorComponents physicalActuatorValues =
+          kBenchmarkMapper.MapForceFeedbackVirtualToPhysical(virtualMagnitudeVector);
+
+      QueryPerformanceCounter(&sampleEndTime);
+
+      outputAccumulator += physicalActuatorValues.leftMotor;
+      latencySamples.push_back(
+          TicksToMicroseconds(sampleEndTime.QuadPart - sampleStartTime.QuadPart));
+
+      TEST_ASSERT(true == device.StopEffect(effect.Identifier()));
+    }
+
+    TEST_ASSERT(0 != outputAccumulator);
+
+    std::sort(latencySamples.begin(), latencySamples.end());
+    Infra::Test::PrintFormatted(
+        L"Start to first actuation: p50 = %.2f us, p99 = %.2f us, max = %.2f us.",
+        SampleAtPercentile(latencySamples, 50),
+        SampleAtPercentile(latencySamples, 99),
+        SampleAtPercentile(latencySamples, 100));
+  }
+
+  // Measures the cost of a single actuation pass, consisting of one playback pass plus the
+  // virtual-to-physical actuator mapping, as a function of the number of concurrently playing
+  // effects. Reports microseconds per pass for each effect count, so the marginal cost of each
+  // additional playing effect can be read directly and compared against the 5 millisecond
+  // actuation period budget.
+  TEST_CASE(ForceFeedbackBenchmark_PlaybackPassCost)
+  {
+    MockPhysicalController physicalController(kBenchmarkControllerIdentifier, kBenchmarkMapper);
+    Device& device = physicalController.GetForceFeedbackDevice();
+
+    for (auto kEffectCount : kBenchmarkEffectCounts)
+    {
+      device.Clear();
+
+      std::vector<MockPeriodicEffect> effects;
+      effects.reserve(kEffectCount);
+
+      for (unsigned int i = 0; i < kEffectCount; ++i)
+      {
+        effects.push_back(MakeBenchmarkEffect());
+        TEST_ASSERT(true == device.AddOrUpdateEffect(effects.back()));
+        TEST_ASSERT(true == device.StartEffect(effects.back().Identifier(), 1, 0));
+      }
+
+      uint64_t outputAccumulator = 0;
+
+      LARGE_INTEGER runStartTime = {};
+      LARGE_INTEGER runEndTime = {};
+      QueryPerformanceCounter(&runStartTime);
+
+      for (unsigned int passIndex = 0; passIndex < kBenchmarkNumPasses; ++passIndex)
+      {
+        const TOrderedMagnitudeComponents virtualMagnitudeVector =
+            device.PlayEffects(1 + passIndex);
+        const SPhysicalActuatorComponents physicalActuatorValues =
+            kBenchmarkMapper.MapForceFeedbackVirtualToPhysical(virtualMagnitudeVector);
+
+        outputAccumulator += physicalActuatorValues.leftMotor;
+      }
+
+      QueryPerformanceCounter(&runEndTime);
+
+      TEST_ASSERT(0 != outputAccumulator);
+      TEST_ASSERT(kEffectCount == device.GetCountPlayingEffects());
+
+      Infra::Test::PrintFormatted(
+          L"%2u playing effect(s): %7.2f us/pass.",
+          kEffectCount,
+          (TicksToMicroseconds(runEndTime.QuadPart - runStartTime.QuadPart) /
+           (double)kBenchmarkNumPasses));
+    }
+  }
+} // namespace XidiTest
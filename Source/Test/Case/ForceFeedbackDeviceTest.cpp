@@ -296,6 +296,48 @@ namespace XidiTest
     TEST_ASSERT(false == Device.IsEffectPlaying(effect.Identifier()));
   }
 
+  // A single effect with a start delay is used to exercise the next-transition scheduling query.
+  // Verifies that an empty playback schedule reports no transition, a pending start delay reports
+  // the exact time remaining until the start transition, and an officially playing effect reports
+  // that passes are required at the normal actuation period.
+  TEST_CASE(ForceFeedbackDevice_SingleEffect_NextEffectTransition)
+  {
+    constexpr TEffectTimeMs kTestEffectDuration = 100;
+    constexpr TEffectTimeMs kTestEffectStartDelay = 150;
+
+    Device Device = MakeTestDevice();
+
+    MockEffect effect = MakeTestEffect(kTestEffectDuration);
+    TEST_ASSERT(true == effect.SetStartDelay(kTestEffectStartDelay));
+
+    TEST_ASSERT(true == Device.AddOrUpdateEffect(effect));
+
+    // No effects are playing, so no transition is scheduled.
+    TEST_ASSERT(
+        false ==
+        Device.MillisecondsUntilNextEffectTransition(kDefaultTimestampBase).has_value());
+
+    TEST_ASSERT(true == Device.StartEffect(effect.Identifier(), 1, kDefaultTimestampBase));
+
+    // During the start delay period the query reports the exact time remaining until the start
+    // transition.
+    for (TEffectTimeMs t = 0; t < kTestEffectStartDelay; ++t)
+      TEST_ASSERT(
+          (kTestEffectStartDelay - t) == Device.MillisecondsUntilNextEffectTransition(t));
+
+    // Once the start time is reached the effect produces continuous output, which requires passes
+    // at the normal actuation period.
+    TEST_ASSERT(0 == Device.MillisecondsUntilNextEffectTransition(kTestEffectStartDelay));
+
+    // Once playback finishes the schedule is empty again.
+    Device.PlayEffects(kTestEffectStartDelay + kTestEffectDuration);
+    TEST_ASSERT(
+        false ==
+        Device
+            .MillisecondsUntilNextEffectTransition(kTestEffectStartDelay + kTestEffectDuration)
+            .has_value());
+  }
+
   // A single effect is started and then stopped some time before the duration has elapsed.
   TEST_CASE(ForceFeedbackDevice_SingleEffect_StartAndStop)
   {
@@ -665,4 +707,51 @@ namespace XidiTest
       TEST_ASSERT(false == Device.IsEffectPlaying(effect.Identifier()));
     }
   }
+
+  // Effects are added, removed, and replaced by new effects, with status queries issued
+  // throughout. Verifies that status tracking stays correct across removal and re-addition,
+  // including when the internal bookkeeping slot vacated by a removed effect is reclaimed by a
+  // different effect.
+  TEST_CASE(ForceFeedbackDevice_MultipleEffects_StatusAcrossRemovalAndReuse)
+  {
+    constexpr TEffectTimeMs kTestEffectDuration = 100;
+
+    Device Device = MakeTestDevice();
+
+    MockEffect firstEffect = MakeTestEffect(kTestEffectDuration);
+    MockEffect secondEffect = MakeTestEffect(kTestEffectDuration);
+
+    TEST_ASSERT(true == Device.AddOrUpdateEffect(firstEffect));
+    TEST_ASSERT(true == Device.IsEffectOnDevice(firstEffect.Identifier()));
+
+    TEST_ASSERT(true == Device.RemoveEffect(firstEffect.Identifier()));
+    TEST_ASSERT(false == Device.IsEffectOnDevice(firstEffect.Identifier()));
+    TEST_ASSERT(false == Device.IsEffectPlaying(firstEffect.Identifier()));
+
+    // The second effect reclaims whatever bookkeeping slot the first effect vacated. Queries for
+    // the removed effect must keep reporting absence, and queries for the new effect must track
+    // it, through the full download-play-stop-remove cycle.
+    TEST_ASSERT(true == Device.AddOrUpdateEffect(secondEffect));
+    TEST_ASSERT(false == Device.IsEffectOnDevice(firstEffect.Identifier()));
+    TEST_ASSERT(true == Device.IsEffectOnDevice(secondEffect.Identifier()));
+    TEST_ASSERT(false == Device.IsEffectPlaying(secondEffect.Identifier()));
+
+    TEST_ASSERT(true == Device.StartEffect(secondEffect.Identifier(), 1, kDefaultTimestampBase));
+    TEST_ASSERT(false == Device.IsEffectPlaying(firstEffect.Identifier()));
+    TEST_ASSERT(true == Device.IsEffectPlaying(secondEffect.Identifier()));
+
+    TEST_ASSERT(true == Device.StopEffect(secondEffect.Identifier()));
+    TEST_ASSERT(true == Device.IsEffectOnDevice(secondEffect.Identifier()));
+    TEST_ASSERT(false == Device.IsEffectPlaying(secondEffect.Identifier()));
+
+    // Re-adding the first effect while the second is still resident verifies that both can be
+    // tracked simultaneously after a removal has occurred.
+    TEST_ASSERT(true == Device.AddOrUpdateEffect(firstEffect));
+    TEST_ASSERT(true == Device.IsEffectOnDevice(firstEffect.Identifier()));
+    TEST_ASSERT(true == Device.IsEffectOnDevice(secondEffect.Identifier()));
+
+    Device.Clear();
+    TEST_ASSERT(false == Device.IsEffectOnDevice(firstEffect.Identifier()));
+    TEST_ASSERT(false == Device.IsEffectOnDevice(secondEffect.Identifier()));
+  }
 } // namespace XidiTest
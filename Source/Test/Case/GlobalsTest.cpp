@@ -0,0 +1,97 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file GlobalsTest.cpp
+ *   Unit tests for the process-wide background task scheduler.
+ **************************************************************************************************/
+
+#include "Globals.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <Infra/Test/TestCase.h>
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+
+  /// Maximum amount of time to wait for background activity to be observed before a test gives
+  /// up and fails. Generous because test machines can be heavily loaded.
+  static constexpr std::chrono::seconds kBackgroundTaskWaitTimeout = std::chrono::seconds(10);
+
+  /// Polls until the specified counter reaches the specified value or the wait timeout elapses.
+  /// @param [in] counter Counter to poll.
+  /// @param [in] expectedValue Value the counter is expected to reach.
+  /// @return `true` if the counter reached the expected value, `false` on timeout.
+  static bool WaitForCounterValue(const std::atomic<int>& counter, int expectedValue)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + kBackgroundTaskWaitTimeout;
+
+    while (counter.load() < expectedValue)
+    {
+      if (std::chrono::steady_clock::now() >= deadline) return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+  }
+
+  // Verifies that a one-shot background task runs and that draining the scheduler does not
+  // return until the task has run to completion.
+  TEST_CASE(Globals_BackgroundTask_OneShotRunsBeforeDrainReturns)
+  {
+    std::atomic<int> taskRunCount = 0;
+
+    Globals::SubmitBackgroundTask([&taskRunCount]() -> void { taskRunCount.fetch_add(1); });
+    Globals::DrainBackgroundTasks();
+
+    TEST_ASSERT(1 == taskRunCount.load());
+  }
+
+  // Verifies that draining the scheduler waits for all outstanding one-shot tasks, including
+  // tasks submitted with a delay that has not yet elapsed at the time of the drain call.
+  TEST_CASE(Globals_BackgroundTask_DrainWaitsForDelayedTasks)
+  {
+    constexpr int kNumTasks = 4;
+    constexpr unsigned int kTaskDelayMilliseconds = 20;
+
+    std::atomic<int> taskRunCount = 0;
+
+    for (int i = 0; i < kNumTasks; ++i)
+      Globals::SubmitBackgroundTask(
+          [&taskRunCount]() -> void { taskRunCount.fetch_add(1); }, kTaskDelayMilliseconds);
+
+    Globals::DrainBackgroundTasks();
+
+    TEST_ASSERT(kNumTasks == taskRunCount.load());
+  }
+
+  // Verifies that a periodic background task runs repeatedly and stops recurring once it returns
+  // `false`. The task captures its counter by reference, so the test must not return until the
+  // task has indicated that it will not run again.
+  TEST_CASE(Globals_BackgroundTask_PeriodicTaskStopsWhenItReturnsFalse)
+  {
+    constexpr int kNumPeriodicRuns = 3;
+    constexpr unsigned int kTaskPeriodMilliseconds = 1;
+
+    std::atomic<int> taskRunCount = 0;
+
+    Globals::SubmitPeriodicBackgroundTask(
+        [&taskRunCount]() -> bool
+        { return (taskRunCount.fetch_add(1) + 1) < kNumPeriodicRuns; },
+        kTaskPeriodMilliseconds);
+
+    TEST_ASSERT(true == WaitForCounterValue(taskRunCount, kNumPeriodicRuns));
+
+    // The task declines to recur on its final run, so once the expected count is observed and
+    // the scheduler has gone idle no further increments can occur.
+    Globals::DrainBackgroundTasks();
+    TEST_ASSERT(kNumPeriodicRuns == taskRunCount.load());
+  }
+} // namespace XidiTest
@@ -0,0 +1,151 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file GuidHashTableTest.cpp
+ *   Unit tests for open-addressing hash containers keyed by GUID.
+ **************************************************************************************************/
+
+#include "GuidHashTable.h"
+
+#include <cstdint>
+
+#include <Infra/Test/TestCase.h>
+
+#include "ApiWindows.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+
+  /// Generates a test GUID whose content is derived from the specified seed value. Distinct seeds
+  /// produce distinct GUIDs.
+  /// @param [in] seed Seed value from which to derive the GUID content.
+  /// @return Test GUID derived from the seed value.
+  static GUID TestGuid(uint32_t seed)
+  {
+    return {
+        .Data1 = seed,
+        .Data2 = (unsigned short)(seed * 3),
+        .Data3 = (unsigned short)(seed * 5),
+        .Data4 = {(unsigned char)seed, 1, 2, 3, 4, 5, 6, 7}};
+  }
+
+  // Verifies that values inserted into a map can be found by key, that absent keys are not found,
+  // and that the size correctly reflects the number of elements inserted.
+  TEST_CASE(GuidHashTable_Map_InsertAndFind)
+  {
+    GuidHashMap<int> guidMap;
+
+    TEST_ASSERT(true == guidMap.InsertOrAssign(TestGuid(1), 100));
+    TEST_ASSERT(true == guidMap.InsertOrAssign(TestGuid(2), 200));
+    TEST_ASSERT(2 == guidMap.Size());
+
+    const int* const foundValue = guidMap.Find(TestGuid(1));
+    TEST_ASSERT(nullptr != foundValue);
+    TEST_ASSERT(100 == *foundValue);
+
+    TEST_ASSERT(nullptr == guidMap.Find(TestGuid(3)));
+    TEST_ASSERT(false == guidMap.Contains(TestGuid(3)));
+  }
+
+  // Verifies that inserting an existing key replaces its associated value without adding a new
+  // element.
+  TEST_CASE(GuidHashTable_Map_InsertOrAssignReplaces)
+  {
+    GuidHashMap<int> guidMap;
+
+    TEST_ASSERT(true == guidMap.InsertOrAssign(TestGuid(1), 100));
+    TEST_ASSERT(false == guidMap.InsertOrAssign(TestGuid(1), 111));
+    TEST_ASSERT(1 == guidMap.Size());
+
+    const int* const foundValue = guidMap.Find(TestGuid(1));
+    TEST_ASSERT(nullptr != foundValue);
+    TEST_ASSERT(111 == *foundValue);
+  }
+
+  // Verifies that a map sized for a small expected key population grows transparently and that
+  // all previously-inserted elements remain reachable after rehashing.
+  TEST_CASE(GuidHashTable_Map_GrowthPreservesElements)
+  {
+    constexpr uint32_t kNumTestElements = 1000;
+
+    GuidHashMap<uint32_t> guidMap(4);
+
+    for (uint32_t i = 0; i < kNumTestElements; ++i)
+      TEST_ASSERT(true == guidMap.InsertOrAssign(TestGuid(i), i));
+
+    TEST_ASSERT(kNumTestElements == guidMap.Size());
+
+    for (uint32_t i = 0; i < kNumTestElements; ++i)
+    {
+      const uint32_t* const foundValue = guidMap.Find(TestGuid(i));
+      TEST_ASSERT(nullptr != foundValue);
+      TEST_ASSERT(i == *foundValue);
+    }
+  }
+
+  // Verifies that clearing a map removes all of its elements.
+  TEST_CASE(GuidHashTable_Map_Clear)
+  {
+    GuidHashMap<int> guidMap;
+
+    guidMap.InsertOrAssign(TestGuid(1), 100);
+    guidMap.InsertOrAssign(TestGuid(2), 200);
+    guidMap.Clear();
+
+    TEST_ASSERT(0 == guidMap.Size());
+    TEST_ASSERT(false == guidMap.Contains(TestGuid(1)));
+    TEST_ASSERT(false == guidMap.Contains(TestGuid(2)));
+  }
+
+  // Verifies that a map constructed from an initializer list contains exactly the listed
+  // elements.
+  TEST_CASE(GuidHashTable_Map_InitializerList)
+  {
+    const GuidHashMap<int> guidMap = {
+        {TestGuid(1), 100}, {TestGuid(2), 200}, {TestGuid(3), 300}};
+
+    TEST_ASSERT(3 == guidMap.Size());
+
+    for (int i = 1; i <= 3; ++i)
+    {
+      const int* const foundValue = guidMap.Find(TestGuid((uint32_t)i));
+      TEST_ASSERT(nullptr != foundValue);
+      TEST_ASSERT((100 * i) == *foundValue);
+    }
+  }
+
+  // Verifies that the null GUID, whose representation matches an unoccupied slot's key, is usable
+  // as an ordinary key.
+  TEST_CASE(GuidHashTable_Map_NullGuidKey)
+  {
+    GuidHashMap<int> guidMap;
+
+    TEST_ASSERT(false == guidMap.Contains(GUID()));
+    TEST_ASSERT(true == guidMap.InsertOrAssign(GUID(), 100));
+    TEST_ASSERT(true == guidMap.Contains(GUID()));
+  }
+
+  // Verifies set membership semantics: insertion reports whether the key is new, duplicates are
+  // not double-counted, and clearing empties the set.
+  TEST_CASE(GuidHashTable_Set_InsertAndContains)
+  {
+    GuidHashSet guidSet;
+
+    TEST_ASSERT(true == guidSet.Insert(TestGuid(1)));
+    TEST_ASSERT(true == guidSet.Insert(TestGuid(2)));
+    TEST_ASSERT(false == guidSet.Insert(TestGuid(1)));
+    TEST_ASSERT(2 == guidSet.Size());
+
+    TEST_ASSERT(true == guidSet.Contains(TestGuid(1)));
+    TEST_ASSERT(false == guidSet.Contains(TestGuid(3)));
+
+    guidSet.Clear();
+    TEST_ASSERT(0 == guidSet.Size());
+    TEST_ASSERT(false == guidSet.Contains(TestGuid(1)));
+  }
+} // namespace XidiTest
@@ -0,0 +1,215 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file MapperBenchmarkTest.cpp
+ *   Benchmarks for the state mapping layer, the hottest code path in the product. These cases
+ *   drive large numbers of synthetic physical state transitions through each built-in mapper,
+ *   plus representative custom mappers constructed via MapperBuilder, and report nanoseconds per
+ *   poll so mapper designs can be compared and throughput regressions caught. Correctness
+ *   assertions are intentionally minimal; functional coverage lives in the other test files.
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "ElementMapper.h"
+#include "Mapper.h"
+#include "MapperBuilder.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::AxisMapper;
+  using ::Xidi::Controller::ButtonMapper;
+  using ::Xidi::Controller::EAxis;
+  using ::Xidi::Controller::EAxisDirection;
+  using ::Xidi::Controller::EButton;
+  using ::Xidi::Controller::EPhysicalButton;
+  using ::Xidi::Controller::EPhysicalDeviceStatus;
+  using ::Xidi::Controller::InvertMapper;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::MapperBuilder;
+  using ::Xidi::Controller::SPhysicalState;
+  using ::Xidi::Controller::SplitMapper;
+
+  /// Number of state mapping polls per benchmark run per mapper. Large enough to produce stable
+  /// per-poll figures, small enough to keep the test suite quick.
+  static constexpr unsigned int kBenchmarkNumPolls = 500000;
+
+  /// Opaque source controller identifier used for all benchmark polls.
+  static constexpr uint32_t kBenchmarkControllerIdentifier = 0;
+
+  /// Names of all the built-in mappers to benchmark, as registered by "MapperDefinitions.cpp".
+  static constexpr std::wstring_view kBuiltInMapperNames[] = {
+      L"StandardGamepad",
+      L"DigitalGamepad",
+      L"ExtendedGamepad",
+      L"XInputNative",
+      L"XInputSharedTriggers"};
+
+  /// Generates a synthetic full-motion physical state for the specified benchmark iteration.
+  /// Every stick component and trigger changes each iteration, and the buttons toggle at
+  /// different rates, so every poll does the maximum amount of mapping work.
+  /// @param [in] iteration Benchmark iteration number.
+  /// @return Synthetic physical state for the iteration.
+  static SPhysicalState SyntheticFullMotionState(unsigned int iteration)
+  {
+    SPhysicalState physicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+
+    physicalState.stick[0] = (int16_t)(((iteration * 7919) % 16384) + 1);
+    physicalState.stick[1] = (int16_t)(0 - (int16_t)(((iteration * 6101) % 16384) + 1));
+    physicalState.stick[2] = (int16_t)(((iteration * 4409) % 16384) + 1);
+    physicalState.stick[3] = (int16_t)(0 - (int16_t)(((iteration * 3307) % 16384) + 1));
+    physicalState.trigger[0] = (uint8_t)((iteration * 151) % 256);
+    physicalState.trigger[1] = (uint8_t)((iteration * 101) % 256);
+    physicalState[EPhysicalButton::A] = (0 != (iteration & 1));
+    physicalState[EPhysicalButton::B] = (0 != (iteration & 4));
+    physicalState[EPhysicalButton::DpadUp] = (0 != (iteration & 8));
+    physicalState[EPhysicalButton::LB] = (0 != (iteration & 16));
+
+    return physicalState;
+  }
+
+  /// Generates a synthetic mostly-idle physical state for the specified benchmark iteration.
+  /// Only a single button toggles occasionally, which is representative of a controller sitting
+  /// still between inputs and is the best case for incremental mapping.
+  /// @param [in] iteration Benchmark iteration number.
+  /// @return Synthetic physical state for the iteration.
+  static SPhysicalState SyntheticMostlyIdleState(unsigned int iteration)
+  {
+    SPhysicalState physicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+    physicalState[EPhysicalButton::A] = (0 != (iteration & 64));
+    return physicalState;
+  }
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to nanoseconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in nanoseconds.
+  static double TicksToNanoseconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return (((double)elapsedTicks * 1000000000.0) / (double)frequency.QuadPart);
+  }
+
+  /// Runs the state mapping benchmark for the specified mapper and prints per-poll figures for
+  /// both a full-motion state sequence and a mostly-idle state sequence.
+  /// @param [in] mapper Mapper to benchmark.
+  /// @param [in] mapperLabel Human-readable label identifying the mapper in printed output.
+  static void RunMappingBenchmark(const Mapper& mapper, std::wstring_view mapperLabel)
+  {
+    // Accumulating an output value per poll prevents the mapping work from being optimized away
+    // and doubles as a cheap sanity check that the mapper actually produced output.
+    int64_t outputAccumulator = 0;
+
+    LARGE_INTEGER fullMotionStartTime = {};
+    LARGE_INTEGER fullMotionEndTime = {};
+    QueryPerformanceCounter(&fullMotionStartTime);
+
+    for (unsigned int i = 0; i < kBenchmarkNumPolls; ++i)
+    {
+      const Controller::SState mappedState = mapper.MapStatePhysicalToVirtual(
+          SyntheticFullMotionState(i), kBenchmarkControllerIdentifier);
+      outputAccumulator += mappedState[EAxis::X];
+      outputAccumulator += (mappedState[EButton::B1] ? 1 : 0);
+    }
+
+    QueryPerformanceCounter(&fullMotionEndTime);
+
+    LARGE_INTEGER mostlyIdleStartTime = {};
+    LARGE_INTEGER mostlyIdleEndTime = {};
+    QueryPerformanceCounter(&mostlyIdleStartTime);
+
+    for (unsigned int i = 0; i < kBenchmarkNumPolls; ++i)
+    {
+      const Controller::SState mappedState = mapper.MapStatePhysicalToVirtual(
+          SyntheticMostlyIdleState(i), kBenchmarkControllerIdentifier);
+      outputAccumulator += (mappedState[EButton::B1] ? 1 : 0);
+    }
+
+    QueryPerformanceCounter(&mostlyIdleEndTime);
+
+    // All mappers under benchmark map at least one physical element, so across both sequences
+    // something must have contributed to the accumulated output.
+    TEST_ASSERT(0 != outputAccumulator);
+
+    Infra::Test::PrintFormatted(
+        L"%-24s full motion: %7.1f ns/poll, mostly idle: %7.1f ns/poll.",
+        mapperLabel.data(),
+        (TicksToNanoseconds(fullMotionEndTime.QuadPart - fullMotionStartTime.QuadPart) /
+         (double)kBenchmarkNumPolls),
+        (TicksToNanoseconds(mostlyIdleEndTime.QuadPart - mostlyIdleStartTime.QuadPart) /
+         (double)kBenchmarkNumPolls));
+  }
+
+  // Benchmarks every built-in mapper definition from "MapperDefinitions.cpp" and reports
+  // nanoseconds per poll for full-motion and mostly-idle synthetic state sequences.
+  TEST_CASE(MapperBenchmark_BuiltInMappers)
+  {
+    for (auto kMapperName : kBuiltInMapperNames)
+    {
+      const Mapper* const mapper = Mapper::GetByName(kMapperName);
+      TEST_ASSERT(nullptr != mapper);
+
+      RunMappingBenchmark(*mapper, kMapperName);
+    }
+  }
+
+  // Benchmarks representative custom mappers constructed via MapperBuilder, one modifying a
+  // built-in template with split and inverted element mappers and one equivalent to its template.
+  // Custom element mapper types disable the direct-dispatch and incremental mapping fast paths,
+  // so these figures quantify the cost of the general path.
+  TEST_CASE(MapperBenchmark_CustomMappers)
+  {
+    constexpr std::wstring_view kCustomMapperName = L"BenchmarkCustomMapper";
+    constexpr std::wstring_view kAliasMapperName = L"BenchmarkAliasMapper";
+    constexpr std::wstring_view kTemplateMapperName = L"StandardGamepad";
+
+    MapperBuilder builder;
+    TEST_ASSERT(true == builder.CreateBlueprint(kCustomMapperName));
+    TEST_ASSERT(true == builder.SetBlueprintTemplate(kCustomMapperName, kTemplateMapperName));
+    TEST_ASSERT(
+        true ==
+        builder.SetBlueprintElementMapper(
+            kCustomMapperName,
+            ELEMENT_MAP_INDEX_OF(stickRightY),
+            std::make_unique<SplitMapper>(
+                std::make_unique<AxisMapper>(EAxis::RotY, EAxisDirection::Positive),
+                std::make_unique<ButtonMapper>(EButton::B15))));
+    TEST_ASSERT(
+        true ==
+        builder.SetBlueprintElementMapper(
+            kCustomMapperName,
+            ELEMENT_MAP_INDEX_OF(stickLeftY),
+            std::make_unique<InvertMapper>(std::make_unique<AxisMapper>(EAxis::Y))));
+
+    TEST_ASSERT(true == builder.CreateBlueprint(kAliasMapperName));
+    TEST_ASSERT(true == builder.SetBlueprintTemplate(kAliasMapperName, kTemplateMapperName));
+
+    const std::unique_ptr<const Mapper> customMapper(builder.Build(kCustomMapperName));
+    TEST_ASSERT(nullptr != customMapper);
+    RunMappingBenchmark(*customMapper, kCustomMapperName);
+
+    const Mapper* const aliasMapper = builder.Build(kAliasMapperName);
+    TEST_ASSERT(nullptr != aliasMapper);
+    RunMappingBenchmark(*aliasMapper, kAliasMapperName);
+
+    Mapper::UnregisterAlias(kAliasMapperName);
+    TEST_ASSERT(false == Mapper::IsMapperNameKnown(kAliasMapperName));
+  }
+} // namespace XidiTest
@@ -475,6 +475,62 @@ namespace XidiTest
     VerifyElementMapIsEmpty(mapper->ElementMap());
   }
 
+  // Verifies that a built blueprint can be reopened, modified, and rebuilt under the same name.
+  // The replacement mapper is expected to be registered under the name, and the original mapper
+  // object is expected to be retired from the registry but left alive.
+  TEST_CASE(MapperBuilder_Build_ReopenAndRebuild)
+  {
+    constexpr std::wstring_view kMapperName = L"TestMapper";
+    constexpr ButtonMapper kInitialElementMapper(EButton::B1);
+    constexpr ButtonMapper kReplacementElementMapper(EButton::B15);
+    const std::set<int> kControllerElements = {ELEMENT_MAP_INDEX_OF(buttonA)};
+
+    MapperBuilder builder;
+    TEST_ASSERT(true == builder.CreateBlueprint(kMapperName));
+    TEST_ASSERT(
+        true ==
+        builder.SetBlueprintElementMapper(
+            kMapperName, ELEMENT_MAP_INDEX_OF(buttonA), kInitialElementMapper.Clone()));
+
+    // The initial mapper object is deliberately not placed into a smart pointer. Reopening the
+    // blueprint retires it, which transfers ownership to the internal retired mapper list.
+    const Mapper* const initialMapper = builder.Build(kMapperName);
+    TEST_ASSERT(nullptr != initialMapper);
+    TEST_ASSERT(Mapper::GetByName(kMapperName) == initialMapper);
+
+    TEST_ASSERT(true == builder.ReopenBlueprint(kMapperName));
+    TEST_ASSERT(false == Mapper::IsMapperNameKnown(kMapperName));
+
+    TEST_ASSERT(
+        true ==
+        builder.SetBlueprintElementMapper(
+            kMapperName, ELEMENT_MAP_INDEX_OF(buttonA), kReplacementElementMapper.Clone()));
+
+    std::unique_ptr<const Mapper> replacementMapper(builder.Build(kMapperName));
+    TEST_ASSERT(nullptr != replacementMapper);
+    TEST_ASSERT(replacementMapper.get() != initialMapper);
+    TEST_ASSERT(Mapper::GetByName(kMapperName) == replacementMapper.get());
+    VerifyElementMapMatchesSpec(
+        kControllerElements, kReplacementElementMapper, replacementMapper->ElementMap());
+  }
+
+  // Verifies that reopening a blueprint previously marked invalid makes it buildable again.
+  TEST_CASE(MapperBuilder_Build_ReopenAfterMarkInvalid)
+  {
+    constexpr std::wstring_view kMapperName = L"TestMapper";
+
+    MapperBuilder builder;
+    TEST_ASSERT(true == builder.CreateBlueprint(kMapperName));
+    TEST_ASSERT(true == builder.InvalidateBlueprint(kMapperName));
+    TEST_ASSERT(nullptr == builder.Build(kMapperName));
+
+    TEST_ASSERT(true == builder.ReopenBlueprint(kMapperName));
+
+    std::unique_ptr<const Mapper> mapper(builder.Build(kMapperName));
+    TEST_ASSERT(nullptr != mapper);
+    TEST_ASSERT(Mapper::GetByName(kMapperName) == mapper.get());
+  }
+
   // Verifies that a mapper with a template and no modification can be built and registered.
   // After build is completed, checks that the element mappers all match.
   // For this test the template is a known and documented mapper.
@@ -489,11 +545,17 @@ namespace XidiTest
     TEST_ASSERT(true == builder.CreateBlueprint(kMapperName));
     TEST_ASSERT(true == builder.SetBlueprintTemplate(kMapperName, kTemplateMapper->GetName()));
 
-    std::unique_ptr<const Mapper> mapper(builder.Build(kMapperName));
+    // A blueprint with no changes from its template does not produce a new mapper object. The
+    // template object itself is shared, interned in the registry under the new name.
+    const Mapper* const mapper = builder.Build(kMapperName);
     TEST_ASSERT(nullptr != mapper);
-    TEST_ASSERT(Mapper::GetByName(kMapperName) == mapper.get());
+    TEST_ASSERT(kTemplateMapper == mapper);
+    TEST_ASSERT(Mapper::GetByName(kMapperName) == kTemplateMapper);
 
     VerifyElementMapsAreEquivalent(mapper->ElementMap(), kTemplateMapper->ElementMap());
+
+    Mapper::UnregisterAlias(kMapperName);
+    TEST_ASSERT(false == Mapper::IsMapperNameKnown(kMapperName));
   }
 
   // Verifies that a mapper with a template and some changes applied can be built and registered, in
@@ -597,11 +659,17 @@ namespace XidiTest
     for (auto controllerElement : kControllerElements)
       TEST_ASSERT(true == builder.ClearBlueprintElementMapper(kMapperName, controllerElement));
 
-    std::unique_ptr<const Mapper> mapper(builder.Build(kMapperName));
+    // With all changes cleared the blueprint is identical to its template, so the template object
+    // itself is shared rather than a new mapper object being built.
+    const Mapper* const mapper = builder.Build(kMapperName);
     TEST_ASSERT(nullptr != mapper);
-    TEST_ASSERT(Mapper::GetByName(kMapperName) == mapper.get());
+    TEST_ASSERT(kTemplateMapper == mapper);
+    TEST_ASSERT(Mapper::GetByName(kMapperName) == kTemplateMapper);
 
     VerifyElementMapsAreEquivalent(mapper->ElementMap(), kTemplateMapper->ElementMap());
+
+    Mapper::UnregisterAlias(kMapperName);
+    TEST_ASSERT(false == Mapper::IsMapperNameKnown(kMapperName));
   }
 
   // Verifies that a mapper fails to be built if it refers to itself as its own template.
@@ -655,12 +723,20 @@ namespace XidiTest
             builder.SetBlueprintTemplate(kMapperNames[nameIndex], kMapperNames[templateIndex]));
     }
 
-    TEST_ASSERT(nullptr != builder.Build(kMapperNames[0]));
+    const Mapper* const builtMapper = builder.Build(kMapperNames[0]);
+    TEST_ASSERT(nullptr != builtMapper);
+
+    // Every blueprint in the chain makes no changes to its template, so all of the names share
+    // the single mapper object built from the end of the chain.
     for (auto kMapperName : kMapperNames)
     {
       TEST_ASSERT(true == Mapper::IsMapperNameKnown(kMapperName));
-      delete Mapper::GetByName(kMapperName);
+      TEST_ASSERT(builtMapper == Mapper::GetByName(kMapperName));
     }
+
+    for (int i = 0; i < (_countof(kMapperNames) - 1); ++i)
+      Mapper::UnregisterAlias(kMapperNames[i]);
+    delete builtMapper;
   }
 
   // Verifies that a dependent mapper fails to build if its template has been invalidated.
@@ -696,14 +772,20 @@ namespace XidiTest
       TEST_ASSERT(true == builder.SetBlueprintTemplate(kMapperName, kMapperNameCommonDependency));
     }
 
+    // Neither fork makes any changes to the common dependency, so both names share the single
+    // mapper object built for the common dependency.
     for (auto kMapperName : kMapperNames)
     {
-      std::unique_ptr<const Mapper> mapper(builder.Build(kMapperName));
+      const Mapper* const mapper = builder.Build(kMapperName);
       TEST_ASSERT(nullptr != mapper);
-      TEST_ASSERT(Mapper::GetByName(kMapperName) == mapper.get());
+      TEST_ASSERT(Mapper::GetByName(kMapperName) == mapper);
+      TEST_ASSERT(Mapper::GetByName(kMapperNameCommonDependency) == mapper);
     }
 
     TEST_ASSERT(true == Mapper::IsMapperNameKnown(kMapperNameCommonDependency));
+
+    for (auto kMapperName : kMapperNames)
+      Mapper::UnregisterAlias(kMapperName);
     delete Mapper::GetByName(kMapperNameCommonDependency);
   }
 
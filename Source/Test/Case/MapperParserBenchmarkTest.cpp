@@ -0,0 +1,225 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file MapperParserBenchmarkTest.cpp
+ *   Fuzz and throughput harness for the element mapper string parser, which processes untrusted
+ *   configuration text at startup. The fuzz case mutates a corpus of representative definition
+ *   strings with a deterministic pseudo-random generator and verifies that the parser always
+ *   returns cleanly, either with a mapper or with an error, no matter how pathological the
+ *   input. The throughput case reports megabytes per second of definition text and mappers
+ *   parsed per second, so parser optimizations can be measured and regressions caught.
+ *   Functional coverage of the parser lives in "MapperParserTest.cpp".
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiWindows.h"
+#include "ElementMapper.h"
+#include "MapperParser.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi::Controller::MapperParser;
+
+  /// Corpus of representative element mapper definition strings, covering every mapper type and
+  /// the kinds of nesting that appear in real configuration files. Used directly by the
+  /// throughput case and as mutation seeds by the fuzz case.
+  static constexpr std::wstring_view kRepresentativeMapperStrings[] = {
+      L"Axis(X)",
+      L"Axis(RotY, +)",
+      L"DigitalAxis(Z, -)",
+      L"Button(10)",
+      L"Pov(Up)",
+      L"Keyboard(DownArrow)",
+      L"Keyboard(DIK_RALT)",
+      L"MouseButton(LeftButton)",
+      L"MouseAxis(Horizontal, +)",
+      L"Invert(Axis(RX))",
+      L"Split(Button(1), Button(2))",
+      L"Split(Axis(Y, +), Split(Pov(Down), Null))",
+      L"Compound(Button(3), Keyboard(DIK_LSHIFT), MouseButton(RightButton))",
+      L"Compound(Invert(Axis(X)), Split(Button(4), DigitalAxis(RotZ, +)), Pov(Left))",
+      L"Null"};
+
+  /// Number of times the whole corpus is parsed by the throughput case. Large enough to produce
+  /// stable figures, small enough to keep the test suite quick.
+  static constexpr unsigned int kThroughputNumCorpusPasses = 20000;
+
+  /// Number of mutated inputs submitted to the parser by the fuzz case.
+  static constexpr unsigned int kFuzzNumIterations = 100000;
+
+  /// Characters the fuzz case inserts and substitutes with elevated probability. Parser
+  /// metacharacters shake out structural handling bugs far more effectively than uniformly
+  /// random characters.
+  static constexpr wchar_t kFuzzMetacharacters[] = {
+      L'(', L')', L',', L' ', L'+', L'-', L'0', L'9', L'A', L'z', L'\t', L'\0'};
+
+  /// Deterministic pseudo-random number generator used to drive fuzz mutations. A fixed seed
+  /// makes every fuzz run reproducible, so a failure can be replayed by iteration number.
+  class FuzzRandomSource
+  {
+  public:
+
+    /// Retrieves the next pseudo-random value in the sequence.
+    /// @return Next pseudo-random 32-bit value.
+    inline uint32_t Next(void)
+    {
+      // xorshift* keeps the generator self-contained and fast enough to be negligible compared
+      // to the parsing work being fuzzed.
+      state ^= (state >> 12);
+      state ^= (state << 25);
+      state ^= (state >> 27);
+      return (uint32_t)((state * 2685821657736338717ull) >> 32);
+    }
+
+    /// Retrieves the next pseudo-random value bounded to the specified limit.
+    /// @param [in] bound Exclusive upper bound on the returned value, must be nonzero.
+    /// @return Next pseudo-random value in the range from 0 to one less than the bound.
+    inline uint32_t Next(uint32_t bound)
+    {
+      return (Next() % bound);
+    }
+
+  private:
+
+    /// Internal generator state, fixed at a nonzero seed for reproducibility.
+    uint64_t state = 0x58494449u;
+  };
+
+  /// Produces a mutated copy of a corpus string for the specified fuzz iteration. Mutations
+  /// include character substitution, metacharacter insertion, truncation, and duplication of a
+  /// random substring, applied one or more times.
+  /// @param [in] seedString Corpus string to mutate.
+  /// @param [in,out] randomSource Pseudo-random source driving the mutation choices.
+  /// @return Mutated string to submit to the parser.
+  static std::wstring MutatedMapperString(
+      std::wstring_view seedString, FuzzRandomSource& randomSource)
+  {
+    std::wstring mutatedString(seedString);
+
+    const unsigned int numMutations = (1 + randomSource.Next(4));
+    for (unsigned int i = 0; i < numMutations; ++i)
+    {
+      switch (randomSource.Next(4))
+      {
+        case 0:
+          // Substitute one character, with equal chance of a metacharacter or arbitrary value.
+          if (false == mutatedString.empty())
+            mutatedString[randomSource.Next((uint32_t)mutatedString.size())] =
+                ((0 == randomSource.Next(2))
+                     ? kFuzzMetacharacters[randomSource.Next(_countof(kFuzzMetacharacters))]
+                     : (wchar_t)(1 + randomSource.Next(0xfffe)));
+          break;
+
+        case 1:
+          // Insert a metacharacter at a random position.
+          mutatedString.insert(
+              mutatedString.begin() + randomSource.Next((uint32_t)mutatedString.size() + 1),
+              kFuzzMetacharacters[randomSource.Next(_countof(kFuzzMetacharacters))]);
+          break;
+
+        case 2:
+          // Truncate at a random position.
+          mutatedString.resize(randomSource.Next((uint32_t)mutatedString.size() + 1));
+          break;
+
+        case 3:
+          // Duplicate a random prefix onto the end, which is effective at producing unbalanced
+          // nesting and repeated parameter lists.
+          mutatedString.append(
+              mutatedString, 0, randomSource.Next((uint32_t)mutatedString.size() + 1));
+          break;
+      }
+    }
+
+    return mutatedString;
+  }
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to seconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in seconds.
+  static double TicksToSeconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return ((double)elapsedTicks / (double)frequency.QuadPart);
+  }
+
+  // Submits a large number of deterministically mutated definition strings to the parser and
+  // verifies that every one of them is handled cleanly, producing either a mapper or an error
+  // message. Any crash, hang, or unbalanced result is a parser bug on untrusted input.
+  TEST_CASE(MapperParserBenchmark_FuzzElementMapperStrings)
+  {
+    FuzzRandomSource randomSource;
+
+    unsigned int numAccepted = 0;
+    unsigned int numRejected = 0;
+
+    for (unsigned int i = 0; i < kFuzzNumIterations; ++i)
+    {
+      const std::wstring mutatedString = MutatedMapperString(
+          kRepresentativeMapperStrings[i % _countof(kRepresentativeMapperStrings)], randomSource);
+
+      ElementMapperOrError maybeElementMapper = ElementMapperFromString(mutatedString);
+      if (true == maybeElementMapper.HasValue())
+        numAccepted += 1;
+      else
+        numRejected += 1;
+    }
+
+    TEST_ASSERT(kFuzzNumIterations == (numAccepted + numRejected));
+    Infra::Test::PrintFormatted(
+        L"Fuzzed %u inputs: %u parsed as mappers, %u cleanly rejected.",
+        kFuzzNumIterations,
+        numAccepted,
+        numRejected);
+  }
+
+  // Parses the representative definition string corpus repeatedly and reports parser throughput
+  // as megabytes of definition text per second and mappers parsed per second.
+  TEST_CASE(MapperParserBenchmark_Throughput)
+  {
+    uint64_t numBytesParsed = 0;
+    uint64_t numMappersParsed = 0;
+
+    LARGE_INTEGER startTime = {};
+    LARGE_INTEGER endTime = {};
+    QueryPerformanceCounter(&startTime);
+
+    for (unsigned int pass = 0; pass < kThroughputNumCorpusPasses; ++pass)
+    {
+      for (const auto& mapperString : kRepresentativeMapperStrings)
+      {
+        ElementMapperOrError maybeElementMapper = ElementMapperFromString(mapperString);
+        TEST_ASSERT(true == maybeElementMapper.HasValue());
+
+        numBytesParsed += (mapperString.size() * sizeof(wchar_t));
+        numMappersParsed += 1;
+      }
+    }
+
+    QueryPerformanceCounter(&endTime);
+
+    const double elapsedSeconds = TicksToSeconds(endTime.QuadPart - startTime.QuadPart);
+    Infra::Test::PrintFormatted(
+        L"Parsed %llu mappers in %.3f s: %7.2f MB/s, %9.0f mappers/s.",
+        (unsigned long long)numMappersParsed,
+        elapsedSeconds,
+        (((double)numBytesParsed / (1024.0 * 1024.0)) / elapsedSeconds),
+        ((double)numMappersParsed / elapsedSeconds));
+  }
+} // namespace XidiTest
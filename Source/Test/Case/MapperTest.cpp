@@ -604,6 +604,22 @@ namespace XidiTest
     TEST_ASSERT(1 == numContributions);
   }
 
+  // Guide button
+  TEST_CASE(Mapper_Route_ButtonGuide)
+  {
+    constexpr bool kTestValue = true;
+    int numContributions = 0;
+
+    const Mapper controllerMapper(
+        {.buttonGuide = std::make_unique<MockElementMapper>(
+             MockElementMapper::EExpectedSource::Button, kTestValue, &numContributions)});
+    controllerMapper.MapStatePhysicalToVirtual(
+        {.deviceStatus = EPhysicalDeviceStatus::Ok, .button = ButtonSet({EPhysicalButton::Guide})},
+        kOpaqueSourceIdentifier);
+
+    TEST_ASSERT(1 == numContributions);
+  }
+
   // Empty mapper.
   // Nothing should be present on the virtual controller.
   TEST_CASE(Mapper_Capabilities_EmptyMapper)
@@ -1148,6 +1164,69 @@ namespace XidiTest
     TEST_ASSERT(actualState == expectedState);
   }
 
+  // When a consumed element mask is supplied, element mappers whose targets are not in the mask
+  // are skipped, leaving those elements at their neutral values, while element mappers whose
+  // targets are in the mask contribute normally.
+  TEST_CASE(Mapper_State_ConsumedElementsSkipsUnconsumed)
+  {
+    constexpr TElementMask kConsumedElements =
+        (ElementMaskBit({.type = EElementType::Axis, .axis = EAxis::X}) |
+         ElementMaskBit({.type = EElementType::Button, .button = EButton::B1}));
+
+    const Mapper mapper(
+        {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
+         .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
+         .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
+         .buttonB = std::make_unique<ButtonMapper>(EButton::B2)});
+
+    const SState actualState = mapper.MapStatePhysicalToVirtual(
+        {.deviceStatus = EPhysicalDeviceStatus::Ok,
+         .stick = {kAnalogValueMax, kAnalogValueMax, 0, 0},
+         .button = ButtonSet({EPhysicalButton::A, EPhysicalButton::B})},
+        kOpaqueSourceIdentifier,
+        kConsumedElements);
+
+    TEST_ASSERT(kAnalogValueNeutral != actualState[EAxis::X]);
+    TEST_ASSERT(true == actualState[EButton::B1]);
+    TEST_ASSERT(kAnalogValueNeutral == actualState[EAxis::Y]);
+    TEST_ASSERT(false == actualState[EButton::B2]);
+  }
+
+  // Widening the consumed element mask between mapping attempts for the same source controller
+  // must recompute previously-skipped elements, even if the physical state is unchanged and hence
+  // an incremental pass would otherwise re-run no steps at all.
+  TEST_CASE(Mapper_State_ConsumedElementsWidenRecomputes)
+  {
+    // Source controller identifiers below the physical controller count are eligible for
+    // incremental mapping, which is the path under test.
+    constexpr uint32_t kIncrementalSourceIdentifier = 0;
+
+    constexpr TElementMask kNarrowConsumedElements =
+        ElementMaskBit({.type = EElementType::Axis, .axis = EAxis::X});
+
+    const Mapper mapper(
+        {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
+         .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
+         .buttonA = std::make_unique<ButtonMapper>(EButton::B1)});
+
+    constexpr SPhysicalState kPhysicalState = {
+        .deviceStatus = EPhysicalDeviceStatus::Ok,
+        .stick = {kAnalogValueMax, kAnalogValueMax, 0, 0},
+        .button = ButtonSet({EPhysicalButton::A})};
+
+    const SState narrowState = mapper.MapStatePhysicalToVirtual(
+        kPhysicalState, kIncrementalSourceIdentifier, kNarrowConsumedElements);
+    TEST_ASSERT(kAnalogValueNeutral != narrowState[EAxis::X]);
+    TEST_ASSERT(kAnalogValueNeutral == narrowState[EAxis::Y]);
+    TEST_ASSERT(false == narrowState[EButton::B1]);
+
+    const SState wideState = mapper.MapStatePhysicalToVirtual(
+        kPhysicalState, kIncrementalSourceIdentifier, kElementMaskAll);
+    TEST_ASSERT(kAnalogValueNeutral != wideState[EAxis::X]);
+    TEST_ASSERT(kAnalogValueNeutral != wideState[EAxis::Y]);
+    TEST_ASSERT(true == wideState[EButton::B1]);
+  }
+
   // Nominal case of some actuators mapped in single axis mode and using axes with the default of
   // both directions.
   TEST_CASE(Mapper_ForceFeedback_Nominal_SingleAxis)
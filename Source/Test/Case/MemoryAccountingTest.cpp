@@ -0,0 +1,69 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file MemoryAccountingTest.cpp
+ *   Unit tests for per-subsystem live memory accounting.
+ **************************************************************************************************/
+
+#include "MemoryAccounting.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Infra/Test/TestCase.h>
+
+#include "ElementMapperArena.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi::MemoryAccounting;
+
+  // Verifies that allocation and release records are reflected in the live byte count for the
+  // subsystem they name and do not affect other subsystems. Counters are global, so all checks
+  // are expressed as deltas from whatever the counts were when the test began.
+  TEST_CASE(MemoryAccounting_RecordAllocationAndRelease)
+  {
+    constexpr uint64_t kTestNumBytes = 12345;
+
+    const uint64_t initialEventBufferBytes = GetLiveBytes(ESubsystem::EventBuffers);
+    const uint64_t initialMapperObjectBytes = GetLiveBytes(ESubsystem::MapperObjects);
+
+    RecordAllocation(ESubsystem::EventBuffers, kTestNumBytes);
+    TEST_ASSERT(
+        (initialEventBufferBytes + kTestNumBytes) == GetLiveBytes(ESubsystem::EventBuffers));
+    TEST_ASSERT(initialMapperObjectBytes == GetLiveBytes(ESubsystem::MapperObjects));
+
+    RecordRelease(ESubsystem::EventBuffers, kTestNumBytes);
+    TEST_ASSERT(initialEventBufferBytes == GetLiveBytes(ESubsystem::EventBuffers));
+  }
+
+  // Verifies that element mapper arena chunks are counted against the mapper object subsystem
+  // while the arena is alive and released from it when the arena is destroyed.
+  TEST_CASE(MemoryAccounting_ArenaChunksAreAccounted)
+  {
+    constexpr size_t kAllocationSizeBytes = 64;
+
+    const uint64_t initialMapperObjectBytes = GetLiveBytes(ESubsystem::MapperObjects);
+
+    {
+      ::Xidi::Controller::ElementMapperArena arena;
+      arena.Allocate(kAllocationSizeBytes);
+      TEST_ASSERT(
+          GetLiveBytes(ESubsystem::MapperObjects) >=
+          (initialMapperObjectBytes + kAllocationSizeBytes));
+    }
+
+    TEST_ASSERT(initialMapperObjectBytes == GetLiveBytes(ESubsystem::MapperObjects));
+  }
+
+  // Verifies that low-memory mode is disabled by default. Test builds run with an empty
+  // configuration, so the mode must latch to its default of disabled.
+  TEST_CASE(MemoryAccounting_LowMemoryModeDisabledByDefault)
+  {
+    TEST_ASSERT(false == IsLowMemoryModeEnabled());
+  }
+} // namespace XidiTest
@@ -0,0 +1,299 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file PhysicalControllerScalingTest.cpp
+ *   Stress harness for the physical controller interface under simulated multi-controller load.
+ *   These cases instantiate mock physical controllers for every supported slot, drive concurrent
+ *   state changes on all of them while multiple reader threads per controller hammer the shared
+ *   state read path, and report throughput and state change latency at each controller count so
+ *   that shared-lock contention or false-sharing regressions surface as a degradation curve
+ *   rather than going unnoticed. Correctness assertions are intentionally minimal; functional
+ *   coverage of the physical controller interface lives in the other test files.
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "Mapper.h"
+#include "MockPhysicalController.h"
+#include "PhysicalController.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::EPhysicalButton;
+  using ::Xidi::Controller::EPhysicalDeviceStatus;
+  using ::Xidi::Controller::EPhysicalStick;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::SPhysicalState;
+  using ::Xidi::Controller::SState;
+  using ::Xidi::Controller::TControllerIdentifier;
+
+  /// Number of state changes driven through each mock physical controller. Each change costs at
+  /// least one polling interval of the mock wait functions, so this value bounds the running time
+  /// of each stress case to a few hundred milliseconds per controller count.
+  static constexpr unsigned int kNumStateChangesPerController = 250;
+
+  /// Number of reader threads per controller that concurrently hammer the shared state read path
+  /// while state changes are in flight.
+  static constexpr unsigned int kNumReaderThreadsPerController = 2;
+
+  /// Name of the built-in mapper used for all mock physical controllers in these cases.
+  static constexpr std::wstring_view kStressMapperName = L"StandardGamepad";
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to nanoseconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in nanoseconds.
+  static double TicksToNanoseconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return (((double)elapsedTicks * 1000000000.0) / (double)frequency.QuadPart);
+  }
+
+  /// Generates the sequence of mock physical states through which one controller is driven. Each
+  /// state toggles a digital button relative to its predecessor, which maps one-to-one through
+  /// the mapper, so every advancement is guaranteed to be observed as a raw virtual state change.
+  /// An analog stick axis also sweeps across the sequence to keep the analog mapping path in
+  /// play.
+  /// @param [in] numStateChanges Number of state changes the sequence should support.
+  /// @return Generated physical state sequence, one element longer than the requested number of
+  /// changes because the first element is the initial state.
+  static std::vector<SPhysicalState> GenerateMockPhysicalStates(unsigned int numStateChanges)
+  {
+    std::vector<SPhysicalState> mockPhysicalStates;
+    mockPhysicalStates.reserve(1 + numStateChanges);
+
+    for (unsigned int i = 0; i <= numStateChanges; ++i)
+    {
+      SPhysicalState mockPhysicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+      mockPhysicalState.button[(int)EPhysicalButton::A] = (0 != (i % 2));
+      mockPhysicalState.stick[(int)EPhysicalStick::LeftX] = (int16_t)((i * 64) % 32000);
+      mockPhysicalStates.push_back(mockPhysicalState);
+    }
+
+    return mockPhysicalStates;
+  }
+
+  /// Sorts the supplied per-change latency samples and prints a throughput and latency report for
+  /// one controller count, producing one point on the degradation curve.
+  /// @param [in] controllerCount Number of controllers that were active for these samples.
+  /// @param [in] totalElapsedTicks Wall time for the whole run, in performance counter ticks.
+  /// @param [in] totalReadCalls Aggregate number of shared state read calls completed.
+  /// @param [in,out] latencySamplesTicks Per-change latency samples, in performance counter
+  /// ticks. Sorted in place as a side effect.
+  static void PrintScalingReport(
+      unsigned int controllerCount,
+      int64_t totalElapsedTicks,
+      uint64_t totalReadCalls,
+      std::vector<int64_t>& latencySamplesTicks)
+  {
+    TEST_ASSERT(false == latencySamplesTicks.empty());
+    std::sort(latencySamplesTicks.begin(), latencySamplesTicks.end());
+
+    const double totalSeconds = (TicksToNanoseconds(totalElapsedTicks) / 1000000000.0);
+    const double changesPerSecond = ((double)latencySamplesTicks.size() / totalSeconds);
+    const double readsPerSecond = ((double)totalReadCalls / totalSeconds);
+
+    const size_t lastSampleIndex = (latencySamplesTicks.size() - 1);
+    const double p50Microseconds =
+        (TicksToNanoseconds(latencySamplesTicks[std::min(
+             lastSampleIndex, (latencySamplesTicks.size() * 50) / 100)]) /
+         1000.0);
+    const double p99Microseconds =
+        (TicksToNanoseconds(latencySamplesTicks[std::min(
+             lastSampleIndex, (latencySamplesTicks.size() * 99) / 100)]) /
+         1000.0);
+
+    Infra::Test::PrintFormatted(
+        L"%u controller(s): %9.0f changes/sec, %12.0f reads/sec, change latency p50 %8.0f us, p99 %8.0f us.",
+        controllerCount,
+        changesPerSecond,
+        readsPerSecond,
+        p50Microseconds,
+        p99Microseconds);
+  }
+
+  /// Runs one stress pass with the specified number of active controllers. Each controller gets a
+  /// writer thread driving state changes, a waiter thread consuming them through the wait-style
+  /// interface, and multiple reader threads hammering the shared-lock state read path. Verifies
+  /// that every driven state change is observed exactly once and returns the collected samples
+  /// through the output parameters.
+  /// @param [in] controllerCount Number of controllers to drive concurrently.
+  /// @param [out] totalElapsedTicks Filled with the wall time for the pass, in performance counter
+  /// ticks.
+  /// @param [out] totalReadCalls Filled with the aggregate number of shared state read calls
+  /// completed during the pass.
+  /// @param [out] latencySamplesTicks Filled with one request-to-observation latency sample per
+  /// driven state change, in performance counter ticks.
+  static void RunScalingStressPass(
+      unsigned int controllerCount,
+      int64_t& totalElapsedTicks,
+      uint64_t& totalReadCalls,
+      std::vector<int64_t>& latencySamplesTicks)
+  {
+    const Mapper* const mapper = Mapper::GetByName(kStressMapperName);
+    TEST_ASSERT(nullptr != mapper);
+
+    std::vector<std::vector<SPhysicalState>> mockPhysicalStates;
+    std::vector<std::unique_ptr<MockPhysicalController>> mockPhysicalControllers;
+    for (unsigned int i = 0; i < controllerCount; ++i)
+    {
+      mockPhysicalStates.push_back(GenerateMockPhysicalStates(kNumStateChangesPerController));
+      mockPhysicalControllers.push_back(std::make_unique<MockPhysicalController>(
+          (TControllerIdentifier)i,
+          *mapper,
+          mockPhysicalStates[i].data(),
+          mockPhysicalStates[i].size()));
+    }
+
+    // Each writer stamps the request time for its controller just before requesting an
+    // advancement, and the corresponding waiter turns it into a latency sample once the change
+    // is observed. Writers wait for the observation counter to advance before driving the next
+    // change, so a timestamp is never overwritten while still in use.
+    std::vector<std::atomic<int64_t>> changeRequestTimestampTicks(controllerCount);
+    std::vector<std::atomic<unsigned int>> numChangesObserved(controllerCount);
+    std::vector<std::vector<int64_t>> perControllerLatencySamplesTicks(controllerCount);
+    std::atomic<uint64_t> numReadCalls = 0;
+    std::atomic<bool> readersShouldStop = false;
+
+    LARGE_INTEGER startTime = {};
+    LARGE_INTEGER endTime = {};
+    QueryPerformanceCounter(&startTime);
+
+    std::vector<std::jthread> waiterThreads;
+    std::vector<std::thread> writerThreads;
+    std::vector<std::thread> readerThreads;
+
+    for (unsigned int i = 0; i < controllerCount; ++i)
+    {
+      perControllerLatencySamplesTicks[i].reserve(kNumStateChangesPerController);
+
+      waiterThreads.emplace_back(
+          [i, &changeRequestTimestampTicks, &numChangesObserved, &perControllerLatencySamplesTicks](
+              std::stop_token stopToken) -> void
+          {
+            SState observedState = {};
+            for (unsigned int changeIndex = 0; changeIndex < kNumStateChangesPerController;
+                 ++changeIndex)
+            {
+              if (false ==
+                  Controller::WaitForRawVirtualControllerStateChange(
+                      (TControllerIdentifier)i, observedState, stopToken))
+                return;
+
+              LARGE_INTEGER observationTime = {};
+              QueryPerformanceCounter(&observationTime);
+              perControllerLatencySamplesTicks[i].push_back(
+                  observationTime.QuadPart -
+                  changeRequestTimestampTicks[i].load(std::memory_order_acquire));
+              numChangesObserved[i].fetch_add(1, std::memory_order_release);
+            }
+          });
+
+      writerThreads.emplace_back(
+          [i,
+           &mockPhysicalControllers,
+           &changeRequestTimestampTicks,
+           &numChangesObserved]() -> void
+          {
+            for (unsigned int changeIndex = 0; changeIndex < kNumStateChangesPerController;
+                 ++changeIndex)
+            {
+              LARGE_INTEGER requestTime = {};
+              QueryPerformanceCounter(&requestTime);
+              changeRequestTimestampTicks[i].store(
+                  requestTime.QuadPart, std::memory_order_release);
+              mockPhysicalControllers[i]->RequestAdvancePhysicalState();
+
+              while (numChangesObserved[i].load(std::memory_order_acquire) <= changeIndex)
+                std::this_thread::yield();
+            }
+          });
+
+      for (unsigned int readerIndex = 0; readerIndex < kNumReaderThreadsPerController;
+           ++readerIndex)
+      {
+        readerThreads.emplace_back(
+            [i, &numReadCalls, &readersShouldStop]() -> void
+            {
+              uint64_t numLocalReadCalls = 0;
+              while (false == readersShouldStop.load(std::memory_order_relaxed))
+              {
+                const SState readState =
+                    Controller::GetCurrentRawVirtualControllerState((TControllerIdentifier)i);
+                (void)readState;
+                numLocalReadCalls += 1;
+              }
+              numReadCalls.fetch_add(numLocalReadCalls, std::memory_order_relaxed);
+            });
+      }
+    }
+
+    for (std::thread& writerThread : writerThreads)
+      writerThread.join();
+    for (std::jthread& waiterThread : waiterThreads)
+      waiterThread.join();
+
+    QueryPerformanceCounter(&endTime);
+
+    readersShouldStop.store(true, std::memory_order_relaxed);
+    for (std::thread& readerThread : readerThreads)
+      readerThread.join();
+
+    for (unsigned int i = 0; i < controllerCount; ++i)
+    {
+      TEST_ASSERT(
+          kNumStateChangesPerController ==
+          numChangesObserved[i].load(std::memory_order_acquire));
+      for (const int64_t latencySampleTicks : perControllerLatencySamplesTicks[i])
+        latencySamplesTicks.push_back(latencySampleTicks);
+    }
+
+    totalElapsedTicks = (endTime.QuadPart - startTime.QuadPart);
+    totalReadCalls = numReadCalls.load(std::memory_order_relaxed);
+    TEST_ASSERT(0 != totalReadCalls);
+  }
+
+  // Drives concurrent state changes and shared state reads at every supported controller count,
+  // from a single controller up to a fully populated system, and reports one throughput and
+  // latency line per count so that scaling bottlenecks show up as a degradation curve.
+  TEST_CASE(PhysicalControllerScaling_StateChangeDegradationCurve)
+  {
+    for (unsigned int controllerCount = 1; controllerCount <= Controller::kPhysicalControllerCount;
+         ++controllerCount)
+    {
+      int64_t totalElapsedTicks = 0;
+      uint64_t totalReadCalls = 0;
+      std::vector<int64_t> latencySamplesTicks;
+      latencySamplesTicks.reserve((size_t)controllerCount * kNumStateChangesPerController);
+
+      RunScalingStressPass(
+          controllerCount, totalElapsedTicks, totalReadCalls, latencySamplesTicks);
+
+      TEST_ASSERT(
+          ((size_t)controllerCount * kNumStateChangesPerController) == latencySamplesTicks.size());
+      PrintScalingReport(controllerCount, totalElapsedTicks, totalReadCalls, latencySamplesTicks);
+    }
+  }
+} // namespace XidiTest
@@ -0,0 +1,91 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file RateLimitedLoggingTest.cpp
+ *   Unit tests for per-call-site message rate limiting.
+ **************************************************************************************************/
+
+#include "RateLimitedLogging.h"
+
+#include <cstdint>
+
+#include <Infra/Test/TestCase.h>
+
+namespace XidiTest
+{
+  using namespace ::Xidi::RateLimitedLogging;
+
+  // Verifies that a call site is permitted to output up to the per-window message limit and that
+  // messages beyond the limit within the same window are suppressed.
+  TEST_CASE(RateLimitedLogging_SingleWindow_LimitsOutput)
+  {
+    constexpr uint64_t kTestWindowStartTime = 10000;
+
+    SCallSiteState callSiteState;
+    uint32_t numSuppressedMessages = 0;
+
+    for (uint32_t i = 0; i < kMaxMessagesPerWindow; ++i)
+    {
+      TEST_ASSERT(
+          true == ShouldOutput(callSiteState, numSuppressedMessages, kTestWindowStartTime + i));
+      TEST_ASSERT(0 == numSuppressedMessages);
+    }
+
+    for (uint32_t i = 0; i < 100; ++i)
+      TEST_ASSERT(
+          false ==
+          ShouldOutput(
+              callSiteState,
+              numSuppressedMessages,
+              kTestWindowStartTime + kMaxMessagesPerWindow + i));
+  }
+
+  // Verifies that suppressed messages are counted and that the count is reclaimed by the first
+  // permitted output of the next window.
+  TEST_CASE(RateLimitedLogging_NextWindow_ReportsSuppressedCount)
+  {
+    constexpr uint64_t kTestWindowStartTime = 10000;
+    constexpr uint32_t kTestNumSuppressedMessages = 250;
+
+    SCallSiteState callSiteState;
+    uint32_t numSuppressedMessages = 0;
+
+    for (uint32_t i = 0; i < kMaxMessagesPerWindow; ++i)
+      TEST_ASSERT(true == ShouldOutput(callSiteState, numSuppressedMessages, kTestWindowStartTime));
+
+    for (uint32_t i = 0; i < kTestNumSuppressedMessages; ++i)
+      TEST_ASSERT(
+          false == ShouldOutput(callSiteState, numSuppressedMessages, kTestWindowStartTime + 1));
+
+    TEST_ASSERT(
+        true ==
+        ShouldOutput(
+            callSiteState,
+            numSuppressedMessages,
+            kTestWindowStartTime + kWindowLengthMilliseconds));
+    TEST_ASSERT(kTestNumSuppressedMessages == numSuppressedMessages);
+  }
+
+  // Verifies that each new time window permits output again after the previous window's limit was
+  // exhausted, and that a window in which nothing was suppressed reports no suppressed messages.
+  TEST_CASE(RateLimitedLogging_MultipleWindows_OutputPermittedEachWindow)
+  {
+    constexpr uint64_t kTestWindowStartTime = 10000;
+
+    SCallSiteState callSiteState;
+    uint32_t numSuppressedMessages = 0;
+
+    for (uint32_t window = 0; window < 4; ++window)
+    {
+      const uint64_t windowStartTime =
+          kTestWindowStartTime + (window * kWindowLengthMilliseconds);
+
+      TEST_ASSERT(true == ShouldOutput(callSiteState, numSuppressedMessages, windowStartTime));
+      TEST_ASSERT(0 == numSuppressedMessages);
+    }
+  }
+} // namespace XidiTest
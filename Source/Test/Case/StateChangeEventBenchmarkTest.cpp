@@ -0,0 +1,214 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file StateChangeEventBenchmarkTest.cpp
+ *   Benchmarks for the virtual controller state change event pipeline. These cases drive the
+ *   state refresh, event generation, and event retrieval path with synthetic high-rate state
+ *   sequences and report throughput and latency figures, so regressions in the event pipeline
+ *   can be quantified rather than just suspected. Correctness assertions are intentionally
+ *   minimal; functional coverage lives in the other test files.
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "ElementMapper.h"
+#include "MockPhysicalController.h"
+#include "StateChangeEventBuffer.h"
+#include "VirtualController.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::AxisMapper;
+  using ::Xidi::Controller::ButtonMapper;
+  using ::Xidi::Controller::EAxis;
+  using ::Xidi::Controller::EButton;
+  using ::Xidi::Controller::EPhysicalButton;
+  using ::Xidi::Controller::EPhysicalDeviceStatus;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::SPhysicalState;
+  using ::Xidi::Controller::StateChangeEventBuffer;
+  using ::Xidi::Controller::TControllerIdentifier;
+  using ::Xidi::Controller::VirtualController;
+
+  /// Test mapper for benchmark runs.
+  /// Describes a virtual controller with 4 axes and 2 buttons, enough to generate several events
+  /// per state refresh.
+  static const Mapper kBenchmarkMapper(
+      {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
+       .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
+       .stickRightX = std::make_unique<AxisMapper>(EAxis::RotX),
+       .stickRightY = std::make_unique<AxisMapper>(EAxis::RotY),
+       .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
+       .buttonB = std::make_unique<ButtonMapper>(EButton::B2)});
+
+  /// Number of state refresh iterations per benchmark run. Large enough to produce stable
+  /// figures, small enough to keep the test suite quick.
+  static constexpr unsigned int kBenchmarkNumIterations = 20000;
+
+  /// Event buffer capacity used during benchmark runs.
+  static constexpr uint32_t kBenchmarkEventBufferCapacity = 64;
+
+  /// Generates a synthetic physical state for the specified benchmark iteration. Every stick
+  /// component changes each iteration so that every state refresh generates one event per mapped
+  /// axis, and the buttons toggle at different rates.
+  /// @param [in] iteration Benchmark iteration number.
+  /// @return Synthetic physical state for the iteration.
+  static SPhysicalState SyntheticPhysicalState(unsigned int iteration)
+  {
+    SPhysicalState physicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+
+    physicalState.stick[0] = (int16_t)(((iteration * 7919) % 16384) + 1);
+    physicalState.stick[1] = (int16_t)(0 - (int16_t)(((iteration * 6101) % 16384) + 1));
+    physicalState.stick[2] = (int16_t)(((iteration * 4409) % 16384) + 1);
+    physicalState.stick[3] = (int16_t)(0 - (int16_t)(((iteration * 3307) % 16384) + 1));
+    physicalState[EPhysicalButton::A] = (0 != (iteration & 1));
+    physicalState[EPhysicalButton::B] = (0 != (iteration & 4));
+
+    return physicalState;
+  }
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to microseconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in microseconds.
+  static double TicksToMicroseconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return (((double)elapsedTicks * 1000000.0) / (double)frequency.QuadPart);
+  }
+
+  /// Retrieves the sample at the specified percentile from a sorted set of latency samples.
+  /// @param [in] sortedSamples Latency samples, sorted in ascending order.
+  /// @param [in] percentile Desired percentile, from 0 to 100.
+  /// @return Sample value at the desired percentile.
+  static double SampleAtPercentile(const std::vector<double>& sortedSamples, unsigned int percentile)
+  {
+    return sortedSamples[((size_t)percentile * (sortedSamples.size() - 1)) / 100];
+  }
+
+  // Drives the full state refresh, event generation, and batched event retrieval pipeline with a
+  // synthetic high-rate state sequence and reports events per second along with per-event latency
+  // percentiles. Per-event latency is measured from submission of a new state to completed
+  // retrieval of the events it generated, the same round trip an application pays between polling
+  // cycles.
+  TEST_CASE(StateChangeEventBenchmark_RefreshAndRetrieve)
+  {
+    constexpr TControllerIdentifier kControllerIndex = 0;
+
+    MockPhysicalController physicalController(kControllerIndex, kBenchmarkMapper);
+    VirtualController controller(kControllerIndex);
+
+    controller.SetAllAxisRange(Controller::kAnalogValueMin, Controller::kAnalogValueMax);
+    controller.SetEventBufferCapacity(kBenchmarkEventBufferCapacity);
+
+    std::vector<double> latencySamplesMicroseconds;
+    latencySamplesMicroseconds.reserve(kBenchmarkNumIterations);
+
+    uint64_t numEventsRetrieved = 0;
+    LARGE_INTEGER runStartTime = {};
+    LARGE_INTEGER runEndTime = {};
+    QueryPerformanceCounter(&runStartTime);
+
+    for (unsigned int i = 0; i < kBenchmarkNumIterations; ++i)
+    {
+      const Controller::SState newRawState =
+          kBenchmarkMapper.MapStatePhysicalToVirtual(SyntheticPhysicalState(i), kControllerIndex);
+
+      LARGE_INTEGER iterationStartTime = {};
+      LARGE_INTEGER iterationEndTime = {};
+      QueryPerformanceCounter(&iterationStartTime);
+
+      controller.RefreshState(newRawState);
+
+      const StateChangeEventBuffer::SEventSpans eventSpans =
+          controller.GetEventBufferEvents(controller.GetEventBufferCount());
+      const uint32_t numEventsThisIteration = eventSpans.Count();
+      controller.PopEventBufferOldestEvents(numEventsThisIteration);
+
+      QueryPerformanceCounter(&iterationEndTime);
+
+      numEventsRetrieved += numEventsThisIteration;
+      latencySamplesMicroseconds.push_back(
+          TicksToMicroseconds(iterationEndTime.QuadPart - iterationStartTime.QuadPart));
+    }
+
+    QueryPerformanceCounter(&runEndTime);
+
+    // Every iteration changes all four mapped axes, so the pipeline is required to have produced
+    // at least that many events. This guards against silently benchmarking a broken pipeline.
+    TEST_ASSERT(numEventsRetrieved >= ((uint64_t)kBenchmarkNumIterations * 4));
+    TEST_ASSERT(0 == controller.GetEventBufferCount());
+
+    std::sort(latencySamplesMicroseconds.begin(), latencySamplesMicroseconds.end());
+
+    const double runElapsedSeconds =
+        (TicksToMicroseconds(runEndTime.QuadPart - runStartTime.QuadPart) / 1000000.0);
+
+    Infra::Test::PrintFormatted(
+        L"Event pipeline throughput: %.0f events/second (%llu events in %.3f seconds).",
+        ((double)numEventsRetrieved / runElapsedSeconds),
+        (unsigned long long)numEventsRetrieved,
+        runElapsedSeconds);
+    Infra::Test::PrintFormatted(
+        L"Refresh-to-retrieval latency: p50 = %.2f us, p95 = %.2f us, p99 = %.2f us, max = %.2f us.",
+        SampleAtPercentile(latencySamplesMicroseconds, 50),
+        SampleAtPercentile(latencySamplesMicroseconds, 95),
+        SampleAtPercentile(latencySamplesMicroseconds, 99),
+        latencySamplesMicroseconds.back());
+  }
+
+  // Drives state refreshes with the event buffer held at capacity so that every append overwrites
+  // the oldest event, and reports throughput for the overwrite-on-overflow path. This is the
+  // worst-case producer path, exercised by applications that enable buffering but retrieve events
+  // infrequently.
+  TEST_CASE(StateChangeEventBenchmark_RefreshWithOverflow)
+  {
+    constexpr TControllerIdentifier kControllerIndex = 0;
+
+    MockPhysicalController physicalController(kControllerIndex, kBenchmarkMapper);
+    VirtualController controller(kControllerIndex);
+
+    controller.SetAllAxisRange(Controller::kAnalogValueMin, Controller::kAnalogValueMax);
+    controller.SetEventBufferCapacity(kBenchmarkEventBufferCapacity);
+
+    LARGE_INTEGER runStartTime = {};
+    LARGE_INTEGER runEndTime = {};
+    QueryPerformanceCounter(&runStartTime);
+
+    for (unsigned int i = 0; i < kBenchmarkNumIterations; ++i)
+      controller.RefreshState(
+          kBenchmarkMapper.MapStatePhysicalToVirtual(SyntheticPhysicalState(i), kControllerIndex));
+
+    QueryPerformanceCounter(&runEndTime);
+
+    TEST_ASSERT(true == controller.IsEventBufferOverflowed());
+    TEST_ASSERT((kBenchmarkEventBufferCapacity - 1) == controller.GetEventBufferCount());
+
+    const double runElapsedSeconds =
+        (TicksToMicroseconds(runEndTime.QuadPart - runStartTime.QuadPart) / 1000000.0);
+
+    Infra::Test::PrintFormatted(
+        L"Overflow path throughput: %.0f refreshes/second (%u refreshes in %.3f seconds).",
+        ((double)kBenchmarkNumIterations / runElapsedSeconds),
+        kBenchmarkNumIterations,
+        runElapsedSeconds);
+  }
+} // namespace XidiTest
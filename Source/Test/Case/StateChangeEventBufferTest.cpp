@@ -102,6 +102,33 @@ namespace XidiTest
     }
   }
 
+  // Verifies that a batch-allocated sequence number range is consecutive, that explicitly-assigned
+  // sequence numbers are stored as supplied, and that global monotonicity is preserved across a mix
+  // of batched and automatic sequence number assignment.
+  TEST_CASE(StateChangeEventBuffer_BatchedSequenceAllocation)
+  {
+    constexpr uint32_t kEventBufferCapacity = (_countof(kTestEventData) + 1);
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    uint32_t sequence =
+        StateChangeEventBuffer::AllocateSequenceRange(_countof(kTestEventData));
+
+    for (int i = 0; i < _countof(kTestEventData); ++i)
+      testEventBuffer.AppendEvent(kTestEventData[i], kTimestamp, sequence++);
+
+    for (int i = 1; i < _countof(kTestEventData); ++i)
+      TEST_ASSERT(testEventBuffer[i].sequence == (1 + testEventBuffer[i - 1].sequence));
+
+    // An automatically-assigned sequence number must come after the batch-allocated range.
+    testEventBuffer.PopOldestEvents(1);
+    testEventBuffer.AppendEvent(kTestEventData[0], kTimestamp);
+    TEST_ASSERT(
+        testEventBuffer[testEventBuffer.GetCount() - 1].sequence >
+        testEventBuffer[testEventBuffer.GetCount() - 2].sequence);
+  }
+
   // Verifies the buffer correctly retains its contents as the buffer size increases.
   // No overflow condition is triggered.
   TEST_CASE(StateChangeEventBuffer_BufferGrow)
@@ -153,6 +180,32 @@ namespace XidiTest
       TEST_ASSERT(kTestEventData[i] == testEventBuffer[i].data);
   }
 
+  // Verifies the buffer retains its contents when the capacity is reduced and then increased again
+  // within the largest capacity ever used. Both changes are in-place logical changes, so no events
+  // are dropped and no overflow condition is triggered.
+  TEST_CASE(StateChangeEventBuffer_BufferShrinkThenRegrow)
+  {
+    constexpr uint32_t kEventBufferLargeCapacity = (4 * _countof(kTestEventData));
+    constexpr uint32_t kEventBufferSmallCapacity = (1 + _countof(kTestEventData));
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferLargeCapacity);
+
+    for (const auto& testEventData : kTestEventData)
+      testEventBuffer.AppendEvent(testEventData, kTimestamp);
+
+    testEventBuffer.SetCapacity(kEventBufferSmallCapacity);
+    testEventBuffer.SetCapacity(kEventBufferLargeCapacity);
+
+    TEST_ASSERT(kEventBufferLargeCapacity == testEventBuffer.GetCapacity());
+    TEST_ASSERT(_countof(kTestEventData) == testEventBuffer.GetCount());
+    TEST_ASSERT(false == testEventBuffer.IsOverflowed());
+    TEST_ASSERT(0 == testEventBuffer.GetTotalDroppedEventCount());
+
+    for (int i = 0; i < _countof(kTestEventData); ++i)
+      TEST_ASSERT(kTestEventData[i] == testEventBuffer[i].data);
+  }
+
   // Verifies correct behavior in the case of an overflow due to appending more events than the
   // buffer can hold. The most recent events should remain, and the buffer should indicate an
   // overflow condition.
@@ -256,6 +309,85 @@ namespace XidiTest
     TEST_ASSERT(false == testEventBuffer.IsOverflowed());
   }
 
+  // Verifies that overflows due to appending events are counted persistently, including the number
+  // of events dropped, and that the high-water mark reflects the maximum number of events retained
+  // in the buffer at once.
+  TEST_CASE(StateChangeEventBuffer_DropAccountingAppend)
+  {
+    constexpr uint32_t kEventBufferCapacity = _countof(kTestEventData) / 4;
+    constexpr uint32_t kMaxRetainedEventCount = kEventBufferCapacity - 1;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    TEST_ASSERT(0 == testEventBuffer.GetTotalOverflowCount());
+    TEST_ASSERT(0 == testEventBuffer.GetTotalDroppedEventCount());
+    TEST_ASSERT(0 == testEventBuffer.GetEventCountHighWaterMark());
+
+    for (const auto& testEventData : kTestEventData)
+      testEventBuffer.AppendEvent(testEventData, kTimestamp);
+
+    // Once the buffer reaches its maximum retained event count, every subsequent append overflows
+    // and drops exactly one event.
+    constexpr uint64_t kExpectedDroppedEventCount =
+        _countof(kTestEventData) - kMaxRetainedEventCount;
+    TEST_ASSERT(kExpectedDroppedEventCount == testEventBuffer.GetTotalOverflowCount());
+    TEST_ASSERT(kExpectedDroppedEventCount == testEventBuffer.GetTotalDroppedEventCount());
+    TEST_ASSERT(kMaxRetainedEventCount == testEventBuffer.GetEventCountHighWaterMark());
+  }
+
+  // Verifies that an overflow due to shrinking the buffer is counted as a single overflow
+  // occurrence whose dropped event count covers all of the discarded events, and that the
+  // high-water mark is unaffected by the shrink.
+  TEST_CASE(StateChangeEventBuffer_DropAccountingBufferShrink)
+  {
+    constexpr uint32_t kEventBufferInitialCapacity = (1 + _countof(kTestEventData));
+    constexpr uint32_t kEventBufferFinalCapacity = _countof(kTestEventData) / 4;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferInitialCapacity);
+
+    for (const auto& testEventData : kTestEventData)
+      testEventBuffer.AppendEvent(testEventData, kTimestamp);
+
+    TEST_ASSERT(0 == testEventBuffer.GetTotalOverflowCount());
+    TEST_ASSERT(0 == testEventBuffer.GetTotalDroppedEventCount());
+    TEST_ASSERT(_countof(kTestEventData) == testEventBuffer.GetEventCountHighWaterMark());
+
+    testEventBuffer.SetCapacity(kEventBufferFinalCapacity);
+
+    // The shrink retains one less than the new capacity, and everything else is dropped in a
+    // single overflow occurrence.
+    constexpr uint64_t kExpectedDroppedEventCount =
+        _countof(kTestEventData) - (kEventBufferFinalCapacity - 1);
+    TEST_ASSERT(1 == testEventBuffer.GetTotalOverflowCount());
+    TEST_ASSERT(kExpectedDroppedEventCount == testEventBuffer.GetTotalDroppedEventCount());
+    TEST_ASSERT(_countof(kTestEventData) == testEventBuffer.GetEventCountHighWaterMark());
+  }
+
+  // Verifies that the drop accounting counters persist after the overflow condition itself is
+  // cleared by popping events, unlike the overflow flag.
+  TEST_CASE(StateChangeEventBuffer_DropAccountingPersistsAfterPop)
+  {
+    constexpr uint32_t kEventBufferCapacity = _countof(kTestEventData) / 4;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    for (const auto& testEventData : kTestEventData)
+      testEventBuffer.AppendEvent(testEventData, kTimestamp);
+
+    TEST_ASSERT(true == testEventBuffer.IsOverflowed());
+    const uint64_t overflowCountBeforePop = testEventBuffer.GetTotalOverflowCount();
+    const uint64_t droppedEventCountBeforePop = testEventBuffer.GetTotalDroppedEventCount();
+
+    testEventBuffer.PopOldestEvents(testEventBuffer.GetCount());
+
+    TEST_ASSERT(false == testEventBuffer.IsOverflowed());
+    TEST_ASSERT(overflowCountBeforePop == testEventBuffer.GetTotalOverflowCount());
+    TEST_ASSERT(droppedEventCountBeforePop == testEventBuffer.GetTotalDroppedEventCount());
+  }
+
   // Verifies that the event buffer properly empties itself without issue if the number of events to
   // pop is in excess of the number of events present.
   TEST_CASE(StateChangeEventBuffer_PopNumberAboveCount)
@@ -272,6 +404,71 @@ namespace XidiTest
     TEST_ASSERT(0 == testEventBuffer.GetCount());
   }
 
+  // Verifies that the zero-copy batch event view exposes the same events, in the same order, as
+  // indexed access, in the nominal case of events that do not wrap around the end of the
+  // underlying ring storage.
+  TEST_CASE(StateChangeEventBuffer_EventSpansNominal)
+  {
+    constexpr uint32_t kEventBufferCapacity = _countof(kTestEventData) * 4;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    for (const auto& testEventData : kTestEventData)
+      testEventBuffer.AppendEvent(testEventData, kTimestamp);
+
+    const StateChangeEventBuffer::SEventSpans eventSpans =
+        testEventBuffer.GetEvents(testEventBuffer.GetCount());
+    TEST_ASSERT(_countof(kTestEventData) == eventSpans.Count());
+    TEST_ASSERT(true == eventSpans.second.empty());
+
+    for (uint32_t i = 0; i < (uint32_t)eventSpans.first.size(); ++i)
+      TEST_ASSERT(kTestEventData[i] == eventSpans.first[i].data);
+
+    // Limiting the number of events in the view should yield a prefix of the oldest events.
+    const StateChangeEventBuffer::SEventSpans limitedEventSpans = testEventBuffer.GetEvents(4);
+    TEST_ASSERT(4 == limitedEventSpans.Count());
+
+    for (uint32_t i = 0; i < 4; ++i)
+      TEST_ASSERT(kTestEventData[i] == limitedEventSpans.first[i].data);
+  }
+
+  // Verifies that the zero-copy batch event view exposes the same events, in the same order, as
+  // indexed access when the events wrap around the end of the underlying ring storage and must
+  // therefore be described by two contiguous pieces.
+  TEST_CASE(StateChangeEventBuffer_EventSpansWraparound)
+  {
+    constexpr uint32_t kEventBufferCapacity = 8;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    // Appending well past capacity positions the oldest retained event such that the retained
+    // events span the end of the ring storage.
+    for (const auto& testEventData : kTestEventData)
+      testEventBuffer.AppendEvent(testEventData, kTimestamp);
+    testEventBuffer.AppendEvent(kTestEventData[0], kTimestamp);
+    testEventBuffer.AppendEvent(kTestEventData[1], kTimestamp);
+
+    const uint32_t numEventsPresent = testEventBuffer.GetCount();
+    TEST_ASSERT((kEventBufferCapacity - 1) == numEventsPresent);
+
+    const StateChangeEventBuffer::SEventSpans eventSpans =
+        testEventBuffer.GetEvents(numEventsPresent);
+    TEST_ASSERT(numEventsPresent == eventSpans.Count());
+    TEST_ASSERT(false == eventSpans.second.empty());
+
+    for (uint32_t i = 0; i < numEventsPresent; ++i)
+    {
+      const StateChangeEventBuffer::SEvent& eventFromSpans =
+          ((i < (uint32_t)eventSpans.first.size())
+               ? eventSpans.first[i]
+               : eventSpans.second[i - (uint32_t)eventSpans.first.size()]);
+      TEST_ASSERT(testEventBuffer[i].data == eventFromSpans.data);
+      TEST_ASSERT(testEventBuffer[i].sequence == eventFromSpans.sequence);
+    }
+  }
+
   // Verifies that the event buffer correctly reports is enabled and disabled status based on its
   // capacity.
   TEST_CASE(StateChangeBuffer_EnableAndDisable)
@@ -297,4 +494,111 @@ namespace XidiTest
     testEventBuffer.SetCapacity(0);
     TEST_ASSERT(false == testEventBuffer.IsEnabled());
   }
+
+  // Verifies that, when the coalescing policy is enabled and occupancy has reached the high-water
+  // mark, an appended axis event that refers to the same element as the newest queued event
+  // replaces that event's value in place instead of consuming another slot.
+  TEST_CASE(StateChangeEventBuffer_CoalescingMergesNewestSameElement)
+  {
+    constexpr uint32_t kEventBufferCapacity = 8;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    TEST_ASSERT(false == testEventBuffer.IsCoalescingEnabled());
+    testEventBuffer.SetCoalescingEnabled(true);
+    TEST_ASSERT(true == testEventBuffer.IsCoalescingEnabled());
+
+    // Occupancy after these appends is 5, which is the coalescing high-water mark of 3/4 of the
+    // usable capacity of 7.
+    constexpr StateChangeEventBuffer::SEventData kDistinctEvents[] = {
+        {.element = {.type = EElementType::Axis, .axis = EAxis::X}, .value = {.axis = 1}},
+        {.element = {.type = EElementType::Axis, .axis = EAxis::Y}, .value = {.axis = 2}},
+        {.element = {.type = EElementType::Axis, .axis = EAxis::Z}, .value = {.axis = 3}},
+        {.element = {.type = EElementType::Axis, .axis = EAxis::RotX}, .value = {.axis = 4}},
+        {.element = {.type = EElementType::Axis, .axis = EAxis::RotY}, .value = {.axis = 5}},
+    };
+
+    for (const auto& eventData : kDistinctEvents)
+      testEventBuffer.AppendEvent(eventData, kTimestamp);
+    TEST_ASSERT(_countof(kDistinctEvents) == testEventBuffer.GetCount());
+
+    constexpr StateChangeEventBuffer::SEventData kCoalescedEvent = {
+        .element = {.type = EElementType::Axis, .axis = EAxis::RotY}, .value = {.axis = 55}};
+    testEventBuffer.AppendEvent(kCoalescedEvent, kTimestamp);
+
+    TEST_ASSERT(_countof(kDistinctEvents) == testEventBuffer.GetCount());
+    TEST_ASSERT(testEventBuffer[testEventBuffer.GetCount() - 1].data == kCoalescedEvent);
+    TEST_ASSERT(1 == testEventBuffer.GetTotalCoalescedEventCount());
+    TEST_ASSERT(false == testEventBuffer.IsOverflowed());
+  }
+
+  // Verifies that button events are never coalesced, even when the coalescing policy is enabled
+  // and occupancy has passed the high-water mark, so press and release edges are always preserved.
+  TEST_CASE(StateChangeEventBuffer_CoalescingPreservesButtonEdges)
+  {
+    constexpr uint32_t kEventBufferCapacity = 16;
+
+    StateChangeEventBuffer testEventBuffer;
+    testEventBuffer.SetCapacity(kEventBufferCapacity);
+    testEventBuffer.SetCoalescingEnabled(true);
+
+    // Occupancy after these appends is well past the coalescing high-water mark.
+    for (int i = 0; i < 12; ++i)
+      testEventBuffer.AppendEvent(
+          {.element = {.type = EElementType::Axis, .axis = EAxis::X}, .value = {.axis = i}},
+          kTimestamp);
+
+    const uint32_t eventCountBeforeButtonEvents = testEventBuffer.GetCount();
+
+    testEventBuffer.AppendEvent(
+        {.element = {.type = EElementType::Button, .button = EButton::B1},
+         .value = {.button = true}},
+        kTimestamp);
+    testEventBuffer.AppendEvent(
+        {.element = {.type = EElementType::Button, .button = EButton::B1},
+         .value = {.button = false}},
+        kTimestamp);
+
+    TEST_ASSERT((eventCountBeforeButtonEvents + 2) == testEventBuffer.GetCount());
+  }
+
+  // Verifies that the coalescing policy is inactive while occupancy is below the high-water mark
+  // and when it has not been enabled at all, so successive same-element events are queued
+  // individually in both situations.
+  TEST_CASE(StateChangeEventBuffer_CoalescingInactiveBelowHighWaterMark)
+  {
+    constexpr uint32_t kEventBufferCapacity = 16;
+    constexpr StateChangeEventBuffer::SEventData kRepeatedElementEvent = {
+        .element = {.type = EElementType::Axis, .axis = EAxis::X}, .value = {.axis = 1}};
+
+    StateChangeEventBuffer coalescingEventBuffer;
+    coalescingEventBuffer.SetCapacity(kEventBufferCapacity);
+    coalescingEventBuffer.SetCoalescingEnabled(true);
+
+    StateChangeEventBuffer nonCoalescingEventBuffer;
+    nonCoalescingEventBuffer.SetCapacity(kEventBufferCapacity);
+
+    // Two events for the same element, well below the high-water mark, must queue individually
+    // whether or not the policy is enabled.
+    for (int i = 0; i < 2; ++i)
+    {
+      coalescingEventBuffer.AppendEvent(kRepeatedElementEvent, kTimestamp);
+      nonCoalescingEventBuffer.AppendEvent(kRepeatedElementEvent, kTimestamp);
+    }
+
+    TEST_ASSERT(2 == coalescingEventBuffer.GetCount());
+    TEST_ASSERT(2 == nonCoalescingEventBuffer.GetCount());
+
+    // Past the high-water mark, only the buffer with the policy enabled coalesces.
+    for (int i = 0; i < 12; ++i)
+    {
+      coalescingEventBuffer.AppendEvent(kRepeatedElementEvent, kTimestamp);
+      nonCoalescingEventBuffer.AppendEvent(kRepeatedElementEvent, kTimestamp);
+    }
+
+    TEST_ASSERT(nonCoalescingEventBuffer.GetCount() > coalescingEventBuffer.GetCount());
+    TEST_ASSERT(0 == nonCoalescingEventBuffer.GetTotalCoalescedEventCount());
+    TEST_ASSERT(0 != coalescingEventBuffer.GetTotalCoalescedEventCount());
+  }
 } // namespace XidiTest
@@ -0,0 +1,76 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file StateTraceTest.cpp
+ *   Unit tests for physical controller state trace record serialization.
+ **************************************************************************************************/
+
+#include "StateTrace.h"
+
+#include <Infra/Test/TestCase.h>
+
+#include "ControllerTypes.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi::Controller;
+  using namespace ::Xidi::StateTrace;
+
+  // Verifies that a representative physical state survives a round trip through trace record
+  // serialization with all fields intact.
+  TEST_CASE(StateTrace_RecordRoundTrip_Nominal)
+  {
+    SPhysicalState testPhysicalState = {
+        .deviceStatus = EPhysicalDeviceStatus::Ok,
+        .stick = {12345, -23456, 32767, -32768},
+        .trigger = {0, 255}};
+    testPhysicalState[EPhysicalButton::A] = true;
+    testPhysicalState[EPhysicalButton::DpadLeft] = true;
+    testPhysicalState[EPhysicalButton::RB] = true;
+
+    constexpr uint32_t kTestTimestamp = 5678;
+    constexpr TControllerIdentifier kTestControllerIdentifier = 2;
+
+    const STraceRecord traceRecord = TraceRecordFromPhysicalState(
+        kTestTimestamp, kTestControllerIdentifier, testPhysicalState);
+    TEST_ASSERT(kTestTimestamp == traceRecord.timestampMilliseconds);
+    TEST_ASSERT(kTestControllerIdentifier == traceRecord.controllerIdentifier);
+
+    const SPhysicalState actualPhysicalState = PhysicalStateFromTraceRecord(traceRecord);
+    TEST_ASSERT(actualPhysicalState == testPhysicalState);
+  }
+
+  // Verifies that every individual digital button maps to its own trace record bit and is
+  // recovered on deserialization.
+  TEST_CASE(StateTrace_RecordRoundTrip_EveryButton)
+  {
+    for (int i = 0; i < static_cast<int>(EPhysicalButton::Count); ++i)
+    {
+      SPhysicalState testPhysicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+      testPhysicalState[static_cast<EPhysicalButton>(i)] = true;
+
+      const STraceRecord traceRecord = TraceRecordFromPhysicalState(0, 0, testPhysicalState);
+      TEST_ASSERT((1u << i) == traceRecord.buttons);
+
+      const SPhysicalState actualPhysicalState = PhysicalStateFromTraceRecord(traceRecord);
+      TEST_ASSERT(actualPhysicalState == testPhysicalState);
+    }
+  }
+
+  // Verifies that a device status other than a healthy connected controller also survives a
+  // round trip, so replay reproduces disconnections faithfully.
+  TEST_CASE(StateTrace_RecordRoundTrip_DeviceStatus)
+  {
+    constexpr SPhysicalState kTestPhysicalState = {
+        .deviceStatus = EPhysicalDeviceStatus::NotConnected};
+
+    const STraceRecord traceRecord = TraceRecordFromPhysicalState(0, 0, kTestPhysicalState);
+    const SPhysicalState actualPhysicalState = PhysicalStateFromTraceRecord(traceRecord);
+    TEST_ASSERT(EPhysicalDeviceStatus::NotConnected == actualPhysicalState.deviceStatus);
+    TEST_ASSERT(actualPhysicalState == kTestPhysicalState);
+  }
+} // namespace XidiTest
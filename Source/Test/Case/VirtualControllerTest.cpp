@@ -1188,4 +1188,41 @@ namespace XidiTest
     TEST_ASSERT(
         false == physicalController.IsVirtualControllerRegisteredForForceFeedback(controller));
   }
+
+  // Exercises the reuse preparation operation, which is used when virtual controllers are recycled
+  // through the device object pool. All application-visible state is expected to return to
+  // freshly-constructed defaults.
+  TEST_CASE(VirtualController_PrepareForReuse)
+  {
+    constexpr TControllerIdentifier kControllerIndex = 1;
+    constexpr uint32_t kEventBufferCapacity = 64;
+    constexpr SPhysicalState kPhysicalState = {.deviceStatus = EPhysicalDeviceStatus::Ok};
+
+    MockPhysicalController physicalController(kControllerIndex, kTestMapper, &kPhysicalState, 1);
+    VirtualController controller(kControllerIndex);
+
+    TEST_ASSERT(true == controller.SetAllAxisDeadzone(5000));
+    TEST_ASSERT(true == controller.SetAllAxisRange(-1000, 1000));
+    TEST_ASSERT(true == controller.SetEventBufferCapacity(kEventBufferCapacity));
+    TEST_ASSERT(true == controller.ForceFeedbackRegister());
+
+    controller.PrepareForReuse();
+
+    for (int i = 0; i < (int)EAxis::Count; ++i)
+    {
+      TEST_ASSERT(
+          VirtualController::kAxisDeadzoneDefault == controller.GetAxisDeadzone((EAxis)i));
+      TEST_ASSERT(
+          std::make_pair(
+              VirtualController::kRangeMinDefault, VirtualController::kRangeMaxDefault) ==
+          controller.GetAxisRange((EAxis)i));
+    }
+
+    TEST_ASSERT(0 == controller.GetEventBufferCapacity());
+    TEST_ASSERT(false == controller.IsEventBufferEnabled());
+    TEST_ASSERT(false == controller.ForceFeedbackIsRegistered());
+    TEST_ASSERT(
+        false == physicalController.IsVirtualControllerRegisteredForForceFeedback(&controller));
+    TEST_ASSERT(false == controller.HasStateChangeEventHandle());
+  }
 } // namespace XidiTest
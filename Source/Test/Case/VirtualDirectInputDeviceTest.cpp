@@ -2552,6 +2552,37 @@ namespace XidiTest
     TEST_ASSERT(actualSeenEffects == expectedSeenEffects);
   }
 
+  // Creates an effect, fully releases it, and then creates another effect with the same GUID. The
+  // released effect object is expected to be pooled and reused, with all of its parameters reset
+  // back to their defaults.
+  TEST_CASE(VirtualDirectInputDevice_ForceFeedback_ReleaseThenCreateReusesEffectObject)
+  {
+    const GUID kEffectGuid = GUID_ConstantForce;
+
+    MockPhysicalController physicalController(kTestControllerIdentifier, kTestMapper);
+    VirtualDirectInputDevice<EDirectInputVersion::k8W> diController(CreateTestVirtualController());
+
+    VirtualDirectInputEffect<EDirectInputVersion::k8W>* diEffect = nullptr;
+    TEST_ASSERT(
+        DI_OK ==
+        diController.CreateEffect(kEffectGuid, nullptr, (LPDIRECTINPUTEFFECT*)&diEffect, nullptr));
+    TEST_ASSERT(nullptr != diEffect);
+
+    IDirectInputEffect* const firstEffectObject = diEffect;
+    diEffect->UnderlyingEffect().SetDuration(100);
+    TEST_ASSERT(true == diEffect->UnderlyingEffect().HasDuration());
+    TEST_ASSERT(0 == diEffect->Release());
+
+    diEffect = nullptr;
+    TEST_ASSERT(
+        DI_OK ==
+        diController.CreateEffect(kEffectGuid, nullptr, (LPDIRECTINPUTEFFECT*)&diEffect, nullptr));
+    TEST_ASSERT(firstEffectObject == diEffect);
+    TEST_ASSERT(false == diEffect->UnderlyingEffect().HasDuration());
+
+    diEffect->Release();
+  }
+
   // Creates several effects, attempts to enumerate them all, and destroys each during the
   // enumeration callback. DirectInput documentation explicitly states that this behavior is
   // permitted.
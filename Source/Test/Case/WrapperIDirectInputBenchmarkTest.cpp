@@ -0,0 +1,355 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file WrapperIDirectInputBenchmarkTest.cpp
+ *   End-to-end benchmark of the DirectInput pipeline as a title drives it. The case performs the
+ *   canonical application startup sequence against the top-level DirectInput interface object,
+ *   the same object the dinput8 exports hand out: device enumeration, device creation, data
+ *   format selection, buffer size property, and acquisition. It then polls the created device at
+ *   a paced 1 kHz cadence, backed by changing mock physical controller data, and reports per-call
+ *   tail latency for state and buffered event retrieval. Functional coverage of the layers
+ *   involved lives in the other test files.
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiDirectInput.h"
+#include "ApiWindows.h"
+#include "ControllerIdentification.h"
+#include "ControllerTypes.h"
+#include "Mapper.h"
+#include "MockDirectInput.h"
+#include "MockPhysicalController.h"
+#include "VirtualDirectInputDevice.h"
+#include "WrapperIDirectInput.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::EPhysicalDeviceStatus;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::SPhysicalState;
+  using ::Xidi::Controller::TControllerIdentifier;
+
+  /// Test value of controller identifier used throughout this benchmark.
+  static constexpr TControllerIdentifier kTestControllerIdentifier = 0;
+
+  /// Name of the built-in mapper used for the mock physical controller in this benchmark.
+  static constexpr std::wstring_view kBenchmarkMapperName = L"StandardGamepad";
+
+  /// Number of paced polling iterations, one per millisecond, so this is also the benchmark
+  /// duration in milliseconds.
+  static constexpr unsigned int kNumPacedIterations = 2000;
+
+  /// Event buffer size requested via the buffer size property, in events. Typical of what titles
+  /// request for buffered joystick data.
+  static constexpr DWORD kEventBufferSize = 64;
+
+  /// Holds an application data format specification equivalent to the position elements of the
+  /// built-in `c_dfDIJoystick2` format, along with the object format array backing it. The
+  /// DirectInput-supplied constant itself lives in the system import library, which the test
+  /// executable does not link against, so the specification is built directly instead.
+  struct SJoystick2FormatSpec
+  {
+    /// Per-object format specifications referenced by the top-level format specification.
+    std::vector<DIOBJECTDATAFORMAT> objectFormatSpecs;
+
+    /// Top-level application data format specification.
+    DIDATAFORMAT formatSpec;
+  };
+
+  /// Builds an application data format specification equivalent to the position elements of
+  /// `c_dfDIJoystick2`: eight axes, four POVs, and 128 buttons, all optional, targeting the
+  /// `DIJOYSTATE2` structure.
+  /// @return Newly-built data format specification.
+  static SJoystick2FormatSpec MakeJoystick2FormatSpec(void)
+  {
+    SJoystick2FormatSpec spec;
+    spec.objectFormatSpecs.reserve(8 + 4 + 128);
+
+    constexpr struct
+    {
+      const GUID* axisGuid;
+      DWORD offset;
+    } kAxisFormatSpecs[] = {
+        {&GUID_XAxis, offsetof(DIJOYSTATE2, lX)},
+        {&GUID_YAxis, offsetof(DIJOYSTATE2, lY)},
+        {&GUID_ZAxis, offsetof(DIJOYSTATE2, lZ)},
+        {&GUID_RxAxis, offsetof(DIJOYSTATE2, lRx)},
+        {&GUID_RyAxis, offsetof(DIJOYSTATE2, lRy)},
+        {&GUID_RzAxis, offsetof(DIJOYSTATE2, lRz)},
+        {&GUID_Slider, offsetof(DIJOYSTATE2, rglSlider[0])},
+        {&GUID_Slider, offsetof(DIJOYSTATE2, rglSlider[1])}};
+
+    for (const auto& axisFormatSpec : kAxisFormatSpecs)
+      spec.objectFormatSpecs.push_back(
+          {.pguid = axisFormatSpec.axisGuid,
+           .dwOfs = axisFormatSpec.offset,
+           .dwType = (DIDFT_OPTIONAL | DIDFT_AXIS | DIDFT_ANYINSTANCE),
+           .dwFlags = 0});
+
+    for (unsigned int i = 0; i < _countof(DIJOYSTATE2::rgdwPOV); ++i)
+      spec.objectFormatSpecs.push_back(
+          {.pguid = &GUID_POV,
+           .dwOfs = (DWORD)offsetof(DIJOYSTATE2, rgdwPOV[i]),
+           .dwType = (DIDFT_OPTIONAL | DIDFT_POV | DIDFT_ANYINSTANCE),
+           .dwFlags = 0});
+
+    for (unsigned int i = 0; i < _countof(DIJOYSTATE2::rgbButtons); ++i)
+      spec.objectFormatSpecs.push_back(
+          {.pguid = nullptr,
+           .dwOfs = (DWORD)offsetof(DIJOYSTATE2, rgbButtons[i]),
+           .dwType = (DIDFT_OPTIONAL | DIDFT_BUTTON | DIDFT_ANYINSTANCE),
+           .dwFlags = 0});
+
+    spec.formatSpec = {
+        .dwSize = sizeof(DIDATAFORMAT),
+        .dwObjSize = sizeof(DIOBJECTDATAFORMAT),
+        .dwFlags = DIDF_ABSAXIS,
+        .dwDataSize = sizeof(DIJOYSTATE2),
+        .dwNumObjs = (DWORD)spec.objectFormatSpecs.size(),
+        .rgodf = spec.objectFormatSpecs.data()};
+
+    return spec;
+  }
+
+  /// Builds the sequence of mock physical states through which the benchmark advances, one per
+  /// paced iteration plus the required initial and final slack states. Consecutive states always
+  /// differ, so every advancement produces a state change and buffered events.
+  /// @return Newly-built mock physical state sequence.
+  static std::vector<SPhysicalState> MakeMockPhysicalStates(void)
+  {
+    std::vector<SPhysicalState> mockPhysicalStates;
+    mockPhysicalStates.reserve(kNumPacedIterations + 2);
+
+    for (unsigned int i = 0; i < (kNumPacedIterations + 2); ++i)
+      mockPhysicalStates.push_back(
+          {.deviceStatus = EPhysicalDeviceStatus::Ok,
+           .stick =
+               {(int16_t)((i * 1021) % 30000),
+                (int16_t)(0 - (int16_t)((i * 2027) % 30000)),
+                (int16_t)((i * 3049) % 30000),
+                (int16_t)(0 - (int16_t)((i * 4091) % 30000))},
+           .button = (1u << (i % 16))});
+
+    return mockPhysicalStates;
+  }
+
+  /// DirectInput device enumeration callback that captures the instance GUID of the first Xidi
+  /// virtual controller enumerated.
+  /// @param [in] deviceInstancePtr Pointer to the device instance structure.
+  /// @param [in] capturedGuidPtr Typeless pointer to the GUID object that receives the capture.
+  /// @return `DIENUM_STOP` once a virtual controller has been captured, `DIENUM_CONTINUE`
+  /// otherwise.
+  static BOOL __stdcall CaptureFirstVirtualControllerGuidCallback(
+      const DirectInputTypes<EDirectInputVersion::k8W>::DeviceInstanceType* deviceInstancePtr,
+      LPVOID capturedGuidPtr)
+  {
+    if (false ==
+        VirtualControllerIdFromInstanceGuid(deviceInstancePtr->guidInstance).has_value())
+      return DIENUM_CONTINUE;
+
+    *((GUID*)capturedGuidPtr) = deviceInstancePtr->guidInstance;
+    return DIENUM_STOP;
+  }
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to nanoseconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in nanoseconds.
+  static double TicksToNanoseconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return (((double)elapsedTicks * 1000000000.0) / (double)frequency.QuadPart);
+  }
+
+  /// Sorts the supplied per-call latency samples and prints a tail latency report for them.
+  /// Unlike an unpaced throughput benchmark, calls per second is fixed by the pacing, so only
+  /// per-call latency figures are meaningful here.
+  /// @param [in] label Human-readable label identifying the entry point in printed output.
+  /// @param [in,out] latencySamplesTicks Per-call latency samples, in performance counter ticks.
+  /// Sorted in place as a side effect.
+  static void PrintLatencyReport(std::wstring_view label, std::vector<int64_t>& latencySamplesTicks)
+  {
+    TEST_ASSERT(false == latencySamplesTicks.empty());
+    std::sort(latencySamplesTicks.begin(), latencySamplesTicks.end());
+
+    const size_t lastSampleIndex = (latencySamplesTicks.size() - 1);
+    const double p50Nanoseconds = TicksToNanoseconds(
+        latencySamplesTicks[std::min(lastSampleIndex, (latencySamplesTicks.size() * 50) / 100)]);
+    const double p99Nanoseconds = TicksToNanoseconds(
+        latencySamplesTicks[std::min(lastSampleIndex, (latencySamplesTicks.size() * 99) / 100)]);
+    const double p999Nanoseconds = TicksToNanoseconds(
+        latencySamplesTicks[std::min(lastSampleIndex, (latencySamplesTicks.size() * 999) / 1000)]);
+    const double maxNanoseconds = TicksToNanoseconds(latencySamplesTicks[lastSampleIndex]);
+
+    Infra::Test::PrintFormatted(
+        L"%-16s p50 %7.0f ns, p99 %7.0f ns, p99.9 %7.0f ns, max %8.0f ns.",
+        label.data(),
+        p50Nanoseconds,
+        p99Nanoseconds,
+        p999Nanoseconds,
+        maxNanoseconds);
+  }
+
+  // Performs the canonical title startup sequence against the top-level DirectInput interface
+  // object and then polls the created device at a paced 1 kHz cadence, reporting per-call tail
+  // latency for both immediate state retrieval and buffered event retrieval.
+  TEST_CASE(WrapperIDirectInputBenchmark_TitlePollingSequence)
+  {
+    const Mapper* const mapper = Mapper::GetByName(kBenchmarkMapperName);
+    TEST_ASSERT(nullptr != mapper);
+
+    const std::vector<SPhysicalState> mockPhysicalStates = MakeMockPhysicalStates();
+    MockPhysicalController physicalController(
+        kTestControllerIdentifier, *mapper, mockPhysicalStates.data(), mockPhysicalStates.size());
+
+    MockDirectInput mockDirectInput;
+    WrapperIDirectInput<EDirectInputVersion::k8W> testDirectInput(
+        reinterpret_cast<DirectInputTypes<EDirectInputVersion::k8W>::IDirectInputType*>(
+            &mockDirectInput));
+
+    // Canonical title startup sequence: enumerate devices, create the first controller found,
+    // select a data format, request a buffered event queue, and acquire the device.
+    GUID capturedVirtualControllerGuid = {};
+    TEST_ASSERT(
+        DI_OK ==
+        testDirectInput.EnumDevices(
+            DI8DEVCLASS_GAMECTRL,
+            &CaptureFirstVirtualControllerGuidCallback,
+            &capturedVirtualControllerGuid,
+            DIEDFL_ATTACHEDONLY));
+    TEST_ASSERT(
+        VirtualControllerGuid(kTestControllerIdentifier) == capturedVirtualControllerGuid);
+
+    DirectInputTypes<EDirectInputVersion::k8W>::IDirectInputDeviceCompatType*
+        testDirectInputDevice = nullptr;
+    TEST_ASSERT(
+        DI_OK ==
+        testDirectInput.CreateDevice(
+            capturedVirtualControllerGuid, &testDirectInputDevice, nullptr));
+    TEST_ASSERT(nullptr != testDirectInputDevice);
+
+    const SJoystick2FormatSpec joystick2FormatSpec = MakeJoystick2FormatSpec();
+    TEST_ASSERT(DI_OK == testDirectInputDevice->SetDataFormat(&joystick2FormatSpec.formatSpec));
+
+    constexpr DIPROPDWORD kBufferSizeProperty = {
+        .diph =
+            {.dwSize = sizeof(DIPROPDWORD),
+             .dwHeaderSize = sizeof(DIPROPHEADER),
+             .dwObj = 0,
+             .dwHow = DIPH_DEVICE},
+        .dwData = kEventBufferSize};
+    TEST_ASSERT(
+        DI_OK ==
+        testDirectInputDevice->SetProperty(
+            DIPROP_BUFFERSIZE, (LPCDIPROPHEADER)&kBufferSizeProperty));
+
+    TEST_ASSERT(DI_OK == testDirectInputDevice->Acquire());
+
+    // One warm-up pass through both retrieval paths triggers any lazy initialization before
+    // latency samples are collected.
+    DIJOYSTATE2 joystickState = {};
+    DIDEVICEOBJECTDATA objectData[kEventBufferSize];
+    DWORD numObjectDataElements = _countof(objectData);
+    TEST_ASSERT(
+        DI_OK == testDirectInputDevice->GetDeviceState(sizeof(joystickState), &joystickState));
+    TEST_ASSERT(
+        DI_OK ==
+        testDirectInputDevice->GetDeviceData(
+            sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, 0));
+
+    std::vector<int64_t> getDeviceStateLatencySamplesTicks;
+    std::vector<int64_t> getDeviceDataLatencySamplesTicks;
+    getDeviceStateLatencySamplesTicks.reserve(kNumPacedIterations);
+    getDeviceDataLatencySamplesTicks.reserve(kNumPacedIterations);
+
+    LARGE_INTEGER pacingFrequency = {};
+    QueryPerformanceFrequency(&pacingFrequency);
+    const int64_t kTicksPerIteration = (pacingFrequency.QuadPart / 1000);
+
+    unsigned int numFailedCalls = 0;
+    uint64_t numEventsRetrieved = 0;
+
+    LARGE_INTEGER loopStartTime = {};
+    QueryPerformanceCounter(&loopStartTime);
+
+    for (unsigned int i = 0; i < kNumPacedIterations; ++i)
+    {
+      LARGE_INTEGER callStartTime = {};
+      LARGE_INTEGER callEndTime = {};
+
+      QueryPerformanceCounter(&callStartTime);
+      const HRESULT getDeviceStateResult =
+          testDirectInputDevice->GetDeviceState(sizeof(joystickState), &joystickState);
+      QueryPerformanceCounter(&callEndTime);
+
+      if (DI_OK != getDeviceStateResult) numFailedCalls += 1;
+      getDeviceStateLatencySamplesTicks.push_back(
+          callEndTime.QuadPart - callStartTime.QuadPart);
+
+      numObjectDataElements = _countof(objectData);
+
+      QueryPerformanceCounter(&callStartTime);
+      const HRESULT getDeviceDataResult = testDirectInputDevice->GetDeviceData(
+          sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, 0);
+      QueryPerformanceCounter(&callEndTime);
+
+      if ((DI_OK != getDeviceDataResult) && (DI_BUFFEROVERFLOW != getDeviceDataResult))
+        numFailedCalls += 1;
+      else
+        numEventsRetrieved += numObjectDataElements;
+      getDeviceDataLatencySamplesTicks.push_back(callEndTime.QuadPart - callStartTime.QuadPart);
+
+      // Simulated hardware produces a new physical state roughly once per iteration, subject to
+      // the mock interface having consumed the previous advancement request.
+      if (false == physicalController.IsAdvanceStateRequested())
+        physicalController.RequestAdvancePhysicalState();
+
+      // Pace the loop to 1 kHz by spinning until the next iteration's deadline. Spinning rather
+      // than sleeping keeps the cadence tight, mirroring the busy polling loops of the titles
+      // whose behavior this benchmark models.
+      const int64_t iterationDeadline =
+          (loopStartTime.QuadPart + ((int64_t)(i + 1) * kTicksPerIteration));
+      LARGE_INTEGER currentTime = {};
+      do
+      {
+        YieldProcessor();
+        QueryPerformanceCounter(&currentTime);
+      }
+      while (currentTime.QuadPart < iterationDeadline);
+    }
+
+    TEST_ASSERT(0 == numFailedCalls);
+    TEST_ASSERT(0 != numEventsRetrieved);
+
+    PrintLatencyReport(L"GetDeviceState:", getDeviceStateLatencySamplesTicks);
+    PrintLatencyReport(L"GetDeviceData:", getDeviceDataLatencySamplesTicks);
+    Infra::Test::PrintFormatted(
+        L"Retrieved %llu buffered events across %u paced iterations.",
+        (unsigned long long)numEventsRetrieved,
+        kNumPacedIterations);
+
+    // Releasing the device interface object parks it, and its virtual controller, in the device
+    // object pool. Taking it back out and destroying it keeps the controller's background
+    // monitoring thread from outliving the mock physical controller and touching state that
+    // belongs to later test cases.
+    testDirectInputDevice->Release();
+    delete VirtualDirectInputDevicePoolTake<EDirectInputVersion::k8W>(kTestControllerIdentifier);
+  }
+} // namespace XidiTest
@@ -0,0 +1,306 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file WrapperJoyWinMMBenchmarkTest.cpp
+ *   Benchmarks and a concurrency soak for the WinMM joystick wrapper call path. These cases
+ *   drive large numbers of calls through the real wrapper entry points, backed by mock physical
+ *   controller data, and report calls per second and tail latency so routing and state retrieval
+ *   regressions can be caught. Correctness assertions are intentionally minimal; functional
+ *   coverage of the underlying layers lives in the other test files.
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <Infra/Test/TestCase.h>
+#include <Infra/Test/Utilities.h>
+
+#include "ApiWindows.h"
+#include "ControllerIdentification.h"
+#include "ControllerTypes.h"
+#include "Mapper.h"
+#include "MockPhysicalController.h"
+#include "WrapperJoyWinMM.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::TControllerIdentifier;
+
+  /// Number of calls per single-threaded benchmark case. Large enough to produce stable
+  /// throughput and tail latency figures, small enough to keep the test suite quick.
+  static constexpr unsigned int kBenchmarkNumCalls = 200000;
+
+  /// Number of calls each thread makes in the multi-threaded soak case.
+  static constexpr unsigned int kSoakNumCallsPerThread = 100000;
+
+  /// Name of the built-in mapper used for all mock physical controllers in these cases.
+  static constexpr std::wstring_view kBenchmarkMapperName = L"StandardGamepad";
+
+  /// Creates and holds one mock physical controller per physical controller slot. The WinMM
+  /// wrapper consumes capabilities and state for every physical controller, so all slots need to
+  /// be backed by mocks before any wrapper entry point is invoked.
+  class AllMockPhysicalControllers
+  {
+  public:
+
+    AllMockPhysicalControllers(void)
+    {
+      const Mapper* const mapper = Mapper::GetByName(kBenchmarkMapperName);
+      TEST_ASSERT(nullptr != mapper);
+
+      for (TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount; ++i)
+        mockPhysicalControllers.push_back(std::make_unique<MockPhysicalController>(i, *mapper));
+    }
+
+  private:
+
+    /// Owns the mock physical controller objects themselves.
+    std::vector<std::unique_ptr<MockPhysicalController>> mockPhysicalControllers;
+  };
+
+  /// Identifies which application-facing joystick indices route to Xidi virtual controllers, by
+  /// matching the device names the wrapper reports against expected virtual controller names.
+  /// Indices that route to system devices, or are not present at all, are excluded so the
+  /// benchmarks measure the virtual controller path regardless of what hardware happens to be
+  /// attached to the machine running the test suite.
+  /// @return Application-facing joystick indices of all Xidi virtual controllers.
+  static std::vector<UINT> VirtualControllerJoyIndices(void)
+  {
+    std::vector<UINT> virtualControllerIndices;
+
+    JOYCAPSW expectedCaps[Controller::kPhysicalControllerCount] = {};
+    for (TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount; ++i)
+      FillVirtualControllerName(expectedCaps[i].szPname, _countof(expectedCaps[i].szPname), i);
+
+    const UINT numDevs = WrapperJoyWinMM::joyGetNumDevs();
+    for (UINT joyIndex = 0; joyIndex < numDevs; ++joyIndex)
+    {
+      JOYCAPSW joyCaps = {};
+      if (JOYERR_NOERROR != WrapperJoyWinMM::joyGetDevCapsW(joyIndex, &joyCaps, sizeof(joyCaps)))
+        continue;
+
+      for (TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount; ++i)
+      {
+        if (0 == wcsncmp(joyCaps.szPname, expectedCaps[i].szPname, _countof(joyCaps.szPname)))
+        {
+          virtualControllerIndices.push_back(joyIndex);
+          break;
+        }
+      }
+    }
+
+    return virtualControllerIndices;
+  }
+
+  /// Converts an elapsed QueryPerformanceCounter tick count to nanoseconds.
+  /// @param [in] elapsedTicks Elapsed tick count.
+  /// @return Elapsed time in nanoseconds.
+  static double TicksToNanoseconds(int64_t elapsedTicks)
+  {
+    static LARGE_INTEGER frequency = []() -> LARGE_INTEGER
+    {
+      LARGE_INTEGER queriedFrequency = {};
+      QueryPerformanceFrequency(&queriedFrequency);
+      return queriedFrequency;
+    }();
+
+    return (((double)elapsedTicks * 1000000000.0) / (double)frequency.QuadPart);
+  }
+
+  /// Sorts the supplied per-call latency samples and prints a throughput and tail latency report
+  /// for them.
+  /// @param [in] label Human-readable label identifying the entry point in printed output.
+  /// @param [in,out] latencySamplesTicks Per-call latency samples, in performance counter ticks.
+  /// Sorted in place as a side effect.
+  static void PrintLatencyReport(std::wstring_view label, std::vector<int64_t>& latencySamplesTicks)
+  {
+    TEST_ASSERT(false == latencySamplesTicks.empty());
+    std::sort(latencySamplesTicks.begin(), latencySamplesTicks.end());
+
+    int64_t totalTicks = 0;
+    for (const int64_t latencySampleTicks : latencySamplesTicks)
+      totalTicks += latencySampleTicks;
+
+    const double totalSeconds = (TicksToNanoseconds(totalTicks) / 1000000000.0);
+    const double callsPerSecond = ((double)latencySamplesTicks.size() / totalSeconds);
+
+    const size_t lastSampleIndex = (latencySamplesTicks.size() - 1);
+    const double p50Nanoseconds = TicksToNanoseconds(
+        latencySamplesTicks[std::min(lastSampleIndex, (latencySamplesTicks.size() * 50) / 100)]);
+    const double p99Nanoseconds = TicksToNanoseconds(
+        latencySamplesTicks[std::min(lastSampleIndex, (latencySamplesTicks.size() * 99) / 100)]);
+    const double p999Nanoseconds = TicksToNanoseconds(
+        latencySamplesTicks[std::min(lastSampleIndex, (latencySamplesTicks.size() * 999) / 1000)]);
+
+    Infra::Test::PrintFormatted(
+        L"%-16s %12.0f calls/sec, p50 %7.0f ns, p99 %7.0f ns, p99.9 %7.0f ns.",
+        label.data(),
+        callsPerSecond,
+        p50Nanoseconds,
+        p99Nanoseconds,
+        p999Nanoseconds);
+  }
+
+  // Benchmarks joyGetPosEx against a Xidi virtual controller, the hottest WinMM wrapper entry
+  // point, and reports throughput and tail latency.
+  TEST_CASE(WrapperJoyWinMMBenchmark_JoyGetPosEx)
+  {
+    AllMockPhysicalControllers allMockPhysicalControllers;
+
+    const std::vector<UINT> virtualControllerIndices = VirtualControllerJoyIndices();
+    TEST_ASSERT(false == virtualControllerIndices.empty());
+    const UINT joyIndex = virtualControllerIndices[0];
+
+    std::vector<int64_t> latencySamplesTicks;
+    latencySamplesTicks.reserve(kBenchmarkNumCalls);
+
+    unsigned int numFailedCalls = 0;
+    for (unsigned int i = 0; i < kBenchmarkNumCalls; ++i)
+    {
+      JOYINFOEX joyInfo = {.dwSize = sizeof(JOYINFOEX), .dwFlags = JOY_RETURNALL};
+
+      LARGE_INTEGER callStartTime = {};
+      LARGE_INTEGER callEndTime = {};
+      QueryPerformanceCounter(&callStartTime);
+      const MMRESULT result = WrapperJoyWinMM::joyGetPosEx(joyIndex, &joyInfo);
+      QueryPerformanceCounter(&callEndTime);
+
+      if (JOYERR_NOERROR != result) numFailedCalls += 1;
+      latencySamplesTicks.push_back(callEndTime.QuadPart - callStartTime.QuadPart);
+    }
+
+    TEST_ASSERT(0 == numFailedCalls);
+    PrintLatencyReport(L"joyGetPosEx:", latencySamplesTicks);
+  }
+
+  // Benchmarks joyGetDevCapsW against a Xidi virtual controller and reports throughput and tail
+  // latency. Exercises the cached capabilities path.
+  TEST_CASE(WrapperJoyWinMMBenchmark_JoyGetDevCaps)
+  {
+    AllMockPhysicalControllers allMockPhysicalControllers;
+
+    const std::vector<UINT> virtualControllerIndices = VirtualControllerJoyIndices();
+    TEST_ASSERT(false == virtualControllerIndices.empty());
+    const UINT joyIndex = virtualControllerIndices[0];
+
+    std::vector<int64_t> latencySamplesTicks;
+    latencySamplesTicks.reserve(kBenchmarkNumCalls);
+
+    unsigned int numFailedCalls = 0;
+    for (unsigned int i = 0; i < kBenchmarkNumCalls; ++i)
+    {
+      JOYCAPSW joyCaps = {};
+
+      LARGE_INTEGER callStartTime = {};
+      LARGE_INTEGER callEndTime = {};
+      QueryPerformanceCounter(&callStartTime);
+      const MMRESULT result = WrapperJoyWinMM::joyGetDevCapsW(joyIndex, &joyCaps, sizeof(joyCaps));
+      QueryPerformanceCounter(&callEndTime);
+
+      if (JOYERR_NOERROR != result) numFailedCalls += 1;
+      latencySamplesTicks.push_back(callEndTime.QuadPart - callStartTime.QuadPart);
+    }
+
+    TEST_ASSERT(0 == numFailedCalls);
+    PrintLatencyReport(L"joyGetDevCapsW:", latencySamplesTicks);
+  }
+
+  // Benchmarks joyGetNumDevs, which sits in the prologue of many application polling loops, and
+  // reports aggregate throughput.
+  TEST_CASE(WrapperJoyWinMMBenchmark_JoyGetNumDevs)
+  {
+    AllMockPhysicalControllers allMockPhysicalControllers;
+
+    // Accumulating the results prevents the calls from being optimized away.
+    unsigned int numDevsAccumulator = 0;
+
+    LARGE_INTEGER startTime = {};
+    LARGE_INTEGER endTime = {};
+    QueryPerformanceCounter(&startTime);
+
+    for (unsigned int i = 0; i < kBenchmarkNumCalls; ++i)
+      numDevsAccumulator += WrapperJoyWinMM::joyGetNumDevs();
+
+    QueryPerformanceCounter(&endTime);
+    TEST_ASSERT(0 != numDevsAccumulator);
+
+    const double totalSeconds =
+        (TicksToNanoseconds(endTime.QuadPart - startTime.QuadPart) / 1000000000.0);
+    Infra::Test::PrintFormatted(
+        L"%-16s %12.0f calls/sec.", L"joyGetNumDevs:", ((double)kBenchmarkNumCalls / totalSeconds));
+  }
+
+  // Soaks the wrapper with several threads simultaneously hammering different joystick indices
+  // with a mix of position, capabilities, and device count calls, to validate that the call path
+  // is safe and remains error-free under concurrency.
+  TEST_CASE(WrapperJoyWinMMSoak_MultithreadedPolling)
+  {
+    AllMockPhysicalControllers allMockPhysicalControllers;
+
+    const std::vector<UINT> virtualControllerIndices = VirtualControllerJoyIndices();
+    TEST_ASSERT(false == virtualControllerIndices.empty());
+
+    std::atomic<unsigned int> numFailedCalls = 0;
+
+    std::vector<std::thread> soakThreads;
+    soakThreads.reserve(virtualControllerIndices.size());
+
+    LARGE_INTEGER startTime = {};
+    LARGE_INTEGER endTime = {};
+    QueryPerformanceCounter(&startTime);
+
+    for (const UINT joyIndex : virtualControllerIndices)
+    {
+      soakThreads.emplace_back(
+          [joyIndex, &numFailedCalls]() -> void
+          {
+            for (unsigned int i = 0; i < kSoakNumCallsPerThread; ++i)
+            {
+              JOYINFOEX joyInfo = {.dwSize = sizeof(JOYINFOEX), .dwFlags = JOY_RETURNALL};
+              if (JOYERR_NOERROR != WrapperJoyWinMM::joyGetPosEx(joyIndex, &joyInfo))
+                numFailedCalls.fetch_add(1, std::memory_order_relaxed);
+
+              // Mix in the other entry points at a low rate, the way applications interleave
+              // occasional capability queries with steady position polling.
+              if (0 == (i % 1024))
+              {
+                JOYCAPSW joyCaps = {};
+                if (JOYERR_NOERROR !=
+                    WrapperJoyWinMM::joyGetDevCapsW(joyIndex, &joyCaps, sizeof(joyCaps)))
+                  numFailedCalls.fetch_add(1, std::memory_order_relaxed);
+
+                if (0 == WrapperJoyWinMM::joyGetNumDevs())
+                  numFailedCalls.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+          });
+    }
+
+    for (std::thread& soakThread : soakThreads)
+      soakThread.join();
+
+    QueryPerformanceCounter(&endTime);
+
+    TEST_ASSERT(0 == numFailedCalls.load(std::memory_order_relaxed));
+
+    const double totalSeconds =
+        (TicksToNanoseconds(endTime.QuadPart - startTime.QuadPart) / 1000000000.0);
+    const double totalCalls =
+        ((double)kSoakNumCallsPerThread * (double)virtualControllerIndices.size());
+    Infra::Test::PrintFormatted(
+        L"Soak: %u threads, %12.0f aggregate joyGetPosEx calls/sec, no errors.",
+        (unsigned int)virtualControllerIndices.size(),
+        (totalCalls / totalSeconds));
+  }
+} // namespace XidiTest
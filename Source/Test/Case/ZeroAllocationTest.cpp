@@ -0,0 +1,306 @@
+/***************************************************************************************************
+ * Xidi
+ *   DirectInput interface for XInput controllers.
+ ***************************************************************************************************
+ * Authored by Samuel Grossman
+ * Copyright (c) 2016-2026
+ ***********************************************************************************************//**
+ * @file ZeroAllocationTest.cpp
+ *   Tests that codify the zero-allocation invariant on hot input pipeline paths. Each test
+ *   warms up its target path once, so lazy initialization is excluded, and then drives it
+ *   repeatedly while counting heap allocations via the test executable's counting allocation
+ *   operators. Any heap allocation on one of these paths is a regression.
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+
+#include <Infra/Test/TestCase.h>
+
+#include "AllocationCounter.h"
+#include "ApiDirectInput.h"
+#include "ApiWindows.h"
+#include "ControllerTypes.h"
+#include "DataFormat.h"
+#include "Mapper.h"
+#include "MockPhysicalController.h"
+#include "VirtualDirectInputDevice.h"
+
+namespace XidiTest
+{
+  using namespace ::Xidi;
+  using ::Xidi::Controller::AxisMapper;
+  using ::Xidi::Controller::ButtonMapper;
+  using ::Xidi::Controller::EAxis;
+  using ::Xidi::Controller::EButton;
+  using ::Xidi::Controller::EPhysicalButton;
+  using ::Xidi::Controller::EPhysicalDeviceStatus;
+  using ::Xidi::Controller::EPovDirection;
+  using ::Xidi::Controller::Mapper;
+  using ::Xidi::Controller::PovMapper;
+  using ::Xidi::Controller::SPhysicalState;
+  using ::Xidi::Controller::TControllerIdentifier;
+  using ::Xidi::Controller::VirtualController;
+
+  /// Data packet structure definition used throughout these test cases.
+  struct STestDataPacket
+  {
+    TAxisValue axisX;
+    TAxisValue axisY;
+    EPovValue pov;
+    TButtonValue button[4];
+  };
+
+  static_assert(
+      0 == (sizeof(STestDataPacket) % 4), "Test data packet size must be divisible by 4.");
+
+  /// Test value of controller identifier used throughout these test cases.
+  static constexpr TControllerIdentifier kTestControllerIdentifier = 0;
+
+  /// Number of times each hot path is driven while allocations are being counted.
+  static constexpr unsigned int kNumCountedIterations = 50;
+
+  /// Test mapper used throughout these test cases.
+  /// Describes a layout with 2 axes, a POV, and 4 buttons.
+  static const Mapper kTestMapper(
+      {.stickLeftX = std::make_unique<AxisMapper>(EAxis::X),
+       .stickLeftY = std::make_unique<AxisMapper>(EAxis::Y),
+       .dpadUp = std::make_unique<PovMapper>(EPovDirection::Up),
+       .dpadDown = std::make_unique<PovMapper>(EPovDirection::Down),
+       .dpadLeft = std::make_unique<PovMapper>(EPovDirection::Left),
+       .dpadRight = std::make_unique<PovMapper>(EPovDirection::Right),
+       .buttonA = std::make_unique<ButtonMapper>(EButton::B1),
+       .buttonB = std::make_unique<ButtonMapper>(EButton::B2),
+       .buttonX = std::make_unique<ButtonMapper>(EButton::B3),
+       .buttonY = std::make_unique<ButtonMapper>(EButton::B4)});
+
+  /// Physical states alternated between while driving hot paths, so that every counted iteration
+  /// observes a state change and exercises the full mapping and event generation work.
+  static constexpr SPhysicalState kTestPhysicalStates[2] = {
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .stick = {11111, -22222, 0, 0},
+       .button = (1 << (int)EPhysicalButton::A)},
+      {.deviceStatus = EPhysicalDeviceStatus::Ok,
+       .stick = {-11111, 22222, 0, 0},
+       .button = (1 << (int)EPhysicalButton::B)}};
+
+  /// Object format specification for #STestDataPacket.
+  static DIOBJECTDATAFORMAT testObjectFormatSpec[] = {
+      {.pguid = &GUID_XAxis,
+       .dwOfs = offsetof(STestDataPacket, axisX),
+       .dwType = DIDFT_AXIS | DIDFT_ANYINSTANCE,
+       .dwFlags = 0},
+      {.pguid = &GUID_YAxis,
+       .dwOfs = offsetof(STestDataPacket, axisY),
+       .dwType = DIDFT_AXIS | DIDFT_ANYINSTANCE,
+       .dwFlags = 0},
+      {.pguid = &GUID_POV,
+       .dwOfs = offsetof(STestDataPacket, pov),
+       .dwType = DIDFT_POV | DIDFT_ANYINSTANCE,
+       .dwFlags = 0},
+      {.pguid = &GUID_Button,
+       .dwOfs = offsetof(STestDataPacket, button[0]),
+       .dwType = DIDFT_BUTTON | DIDFT_ANYINSTANCE,
+       .dwFlags = 0},
+      {.pguid = &GUID_Button,
+       .dwOfs = offsetof(STestDataPacket, button[1]),
+       .dwType = DIDFT_BUTTON | DIDFT_ANYINSTANCE,
+       .dwFlags = 0},
+      {.pguid = &GUID_Button,
+       .dwOfs = offsetof(STestDataPacket, button[2]),
+       .dwType = DIDFT_BUTTON | DIDFT_ANYINSTANCE,
+       .dwFlags = 0},
+      {.pguid = &GUID_Button,
+       .dwOfs = offsetof(STestDataPacket, button[3]),
+       .dwType = DIDFT_BUTTON | DIDFT_ANYINSTANCE,
+       .dwFlags = 0}};
+
+  /// Complete application data format specification for #STestDataPacket.
+  static constexpr DIDATAFORMAT kTestFormatSpec = {
+      .dwSize = sizeof(DIDATAFORMAT),
+      .dwObjSize = sizeof(DIOBJECTDATAFORMAT),
+      .dwFlags = DIDF_ABSAXIS,
+      .dwDataSize = sizeof(STestDataPacket),
+      .dwNumObjs = _countof(testObjectFormatSpec),
+      .rgodf = testObjectFormatSpec};
+
+  // Verifies that mapping physical to virtual state and refreshing a virtual controller,
+  // including buffered event generation, performs no heap allocation in the steady state.
+  TEST_CASE(ZeroAllocation_MapAndRefreshState)
+  {
+    constexpr uint32_t kEventBufferCapacity = 1024;
+
+    MockPhysicalController physicalController(kTestControllerIdentifier, kTestMapper);
+    VirtualController controller(kTestControllerIdentifier);
+    controller.SetEventBufferCapacity(kEventBufferCapacity);
+
+    // One pass through each test state triggers any lazy initialization on the path.
+    for (const auto& physicalState : kTestPhysicalStates)
+      controller.RefreshState(
+          kTestMapper.MapStatePhysicalToVirtual(physicalState, kTestControllerIdentifier));
+
+    const ScopedAllocationCounter allocationCounter;
+
+    for (unsigned int i = 0; i < kNumCountedIterations; ++i)
+      controller.RefreshState(kTestMapper.MapStatePhysicalToVirtual(
+          kTestPhysicalStates[i % _countof(kTestPhysicalStates)], kTestControllerIdentifier));
+
+    TEST_ASSERT(0 == allocationCounter.NumAllocations());
+  }
+
+  // Verifies that writing an application data packet from virtual controller state performs no
+  // heap allocation in the steady state.
+  TEST_CASE(ZeroAllocation_WriteDataPacket)
+  {
+    const std::unique_ptr<DataFormat> dataFormat =
+        DataFormat::CreateFromApplicationFormatSpec(kTestFormatSpec, kTestMapper.GetCapabilities());
+    TEST_ASSERT(nullptr != dataFormat);
+
+    const Controller::SState testControllerStates[2] = {
+        kTestMapper.MapStatePhysicalToVirtual(kTestPhysicalStates[0], kTestControllerIdentifier),
+        kTestMapper.MapStatePhysicalToVirtual(kTestPhysicalStates[1], kTestControllerIdentifier)};
+
+    STestDataPacket testDataPacket;
+    TEST_ASSERT(
+        true ==
+        dataFormat->WriteDataPacket(
+            &testDataPacket, sizeof(testDataPacket), testControllerStates[0]));
+
+    const ScopedAllocationCounter allocationCounter;
+
+    for (unsigned int i = 0; i < kNumCountedIterations; ++i)
+      TEST_ASSERT(
+          true ==
+          dataFormat->WriteDataPacket(
+              &testDataPacket,
+              sizeof(testDataPacket),
+              testControllerStates[i % _countof(testControllerStates)]));
+
+    TEST_ASSERT(0 == allocationCounter.NumAllocations());
+  }
+
+  // Verifies that retrieving buffered events through the DirectInput device interface performs
+  // no heap allocation in the steady state.
+  TEST_CASE(ZeroAllocation_GetDeviceData)
+  {
+    constexpr DWORD kBufferSize = 64;
+    constexpr DIPROPDWORD kBufferSizeProperty = {
+        .diph =
+            {.dwSize = sizeof(DIPROPDWORD),
+             .dwHeaderSize = sizeof(DIPROPHEADER),
+             .dwObj = 0,
+             .dwHow = DIPH_DEVICE},
+        .dwData = kBufferSize};
+
+    MockPhysicalController physicalController(kTestControllerIdentifier, kTestMapper);
+    VirtualDirectInputDevice<EDirectInputVersion::k8W> diController(
+        std::make_unique<VirtualController>(kTestControllerIdentifier));
+    TEST_ASSERT(DI_OK == diController.SetDataFormat(&kTestFormatSpec));
+    TEST_ASSERT(
+        DI_OK ==
+        diController.SetProperty(DIPROP_BUFFERSIZE, (LPCDIPROPHEADER)&kBufferSizeProperty));
+
+    DIDEVICEOBJECTDATA objectData[kBufferSize];
+    DWORD numObjectDataElements = _countof(objectData);
+
+    // One warm-up pass through the whole path triggers any lazy initialization.
+    diController.GetVirtualController().RefreshState(
+        kTestMapper.MapStatePhysicalToVirtual(kTestPhysicalStates[0], kTestControllerIdentifier));
+    TEST_ASSERT(
+        DI_OK ==
+        diController.GetDeviceData(
+            sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, 0));
+
+    const ScopedAllocationCounter allocationCounter;
+
+    for (unsigned int i = 0; i < kNumCountedIterations; ++i)
+    {
+      diController.GetVirtualController().RefreshState(kTestMapper.MapStatePhysicalToVirtual(
+          kTestPhysicalStates[(1 + i) % _countof(kTestPhysicalStates)],
+          kTestControllerIdentifier));
+
+      numObjectDataElements = _countof(objectData);
+      TEST_ASSERT(
+          DI_OK ==
+          diController.GetDeviceData(
+              sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, 0));
+      TEST_ASSERT(0 != numObjectDataElements);
+    }
+
+    TEST_ASSERT(0 == allocationCounter.NumAllocations());
+  }
+
+  // Verifies that retrieving large buffered event batches, of the size produced by a title
+  // requesting 1024 events per call, performs no heap allocation in the steady state. Both the
+  // peek and the pop forms of retrieval are exercised, with each batch built up from many state
+  // refreshes so that the ring buffer hands back multi-hundred-event spans.
+  TEST_CASE(ZeroAllocation_GetDeviceDataLargeBatch)
+  {
+    constexpr DWORD kBufferSize = 1024;
+    constexpr DIPROPDWORD kBufferSizeProperty = {
+        .diph =
+            {.dwSize = sizeof(DIPROPDWORD),
+             .dwHeaderSize = sizeof(DIPROPHEADER),
+             .dwObj = 0,
+             .dwHow = DIPH_DEVICE},
+        .dwData = kBufferSize};
+
+    // Number of state refreshes per batch. Each refresh of an alternating state generates a few
+    // events, so this fills most of the event buffer without overflowing it.
+    constexpr unsigned int kNumRefreshesPerBatch = 200;
+
+    // Number of batches driven while allocations are being counted. Lower than the usual counted
+    // iteration count because each batch involves hundreds of refreshes.
+    constexpr unsigned int kNumCountedBatches = 10;
+
+    MockPhysicalController physicalController(kTestControllerIdentifier, kTestMapper);
+    VirtualDirectInputDevice<EDirectInputVersion::k8W> diController(
+        std::make_unique<VirtualController>(kTestControllerIdentifier));
+    TEST_ASSERT(DI_OK == diController.SetDataFormat(&kTestFormatSpec));
+    TEST_ASSERT(
+        DI_OK ==
+        diController.SetProperty(DIPROP_BUFFERSIZE, (LPCDIPROPHEADER)&kBufferSizeProperty));
+
+    static DIDEVICEOBJECTDATA objectData[kBufferSize];
+    DWORD numObjectDataElements = _countof(objectData);
+
+    // One warm-up batch through the whole path triggers any lazy initialization, including the
+    // event buffer growing its ring storage to the full requested capacity.
+    const auto driveOneBatch = [&diController]() -> void
+    {
+      for (unsigned int i = 0; i < kNumRefreshesPerBatch; ++i)
+        diController.GetVirtualController().RefreshState(kTestMapper.MapStatePhysicalToVirtual(
+            kTestPhysicalStates[i % _countof(kTestPhysicalStates)], kTestControllerIdentifier));
+    };
+
+    driveOneBatch();
+    TEST_ASSERT(
+        DI_OK ==
+        diController.GetDeviceData(
+            sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, 0));
+
+    const ScopedAllocationCounter allocationCounter;
+
+    for (unsigned int i = 0; i < kNumCountedBatches; ++i)
+    {
+      driveOneBatch();
+
+      // Peek first, the way titles inspect pending input before consuming it, then pop.
+      numObjectDataElements = _countof(objectData);
+      TEST_ASSERT(
+          DI_OK ==
+          diController.GetDeviceData(
+              sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, DIGDD_PEEK));
+      TEST_ASSERT(numObjectDataElements > (kBufferSize / 4));
+
+      numObjectDataElements = _countof(objectData);
+      TEST_ASSERT(
+          DI_OK ==
+          diController.GetDeviceData(
+              sizeof(DIDEVICEOBJECTDATA), objectData, &numObjectDataElements, 0));
+      TEST_ASSERT(numObjectDataElements > (kBufferSize / 4));
+    }
+
+    TEST_ASSERT(0 == allocationCounter.NumAllocations());
+  }
+} // namespace XidiTest
@@ -12,6 +12,8 @@
 
 #include "MockPhysicalController.h"
 
+#include <atomic>
+#include <cstdint>
 #include <shared_mutex>
 #include <stop_token>
 #include <vector>
@@ -19,7 +21,10 @@
 #include <Infra/Test/TestCase.h>
 
 #include "ApiWindows.h"
+#include "Diagnostics.h"
 #include "ForceFeedbackDevice.h"
+#include "ImportApiWinMM.h"
+#include "LatencyMeasurement.h"
 #include "Mapper.h"
 #include "PhysicalController.h"
 #include "VirtualController.h"
@@ -41,6 +46,15 @@ namespace XidiTest
   /// physical controller.
   static MockPhysicalController* mockPhysicalController[kPhysicalControllerCount];
 
+  /// Mock device change notification generation counter, incremented by test cases that simulate
+  /// hardware arrival or removal.
+  static std::atomic<uint32_t> mockDeviceChangeGeneration;
+
+  void SimulateDeviceChangeNotification(void)
+  {
+    mockDeviceChangeGeneration.fetch_add(1, std::memory_order_release);
+  }
+
   MockPhysicalController::MockPhysicalController(
       TControllerIdentifier controllerIdentifier,
       const Mapper& mapper,
@@ -68,12 +82,23 @@ namespace XidiTest
           controllerIdentifier);
 
     mockPhysicalController[kControllerIdentifier] = this;
+
+    // Mirrors the connection status tracking performed by the real physical controller polling
+    // loop, so that presence checks that consult the connected-controller mask see the mocked
+    // controller.
+    Xidi::Diagnostics::RecordControllerConnected(
+        kControllerIdentifier,
+        (EPhysicalDeviceStatus::Ok == GetCurrentPhysicalState().deviceStatus));
   }
 
   MockPhysicalController::~MockPhysicalController(void)
   {
     std::unique_lock lock(mockPhysicalStateGuard[kControllerIdentifier]);
     mockPhysicalController[kControllerIdentifier] = nullptr;
+
+    // The connected-controller mask is process-wide state, so the bit for this controller must
+    // be cleared on destruction to avoid leaking mocked connection status into subsequent tests.
+    Xidi::Diagnostics::RecordControllerConnected(kControllerIdentifier, false);
   }
 
   void MockPhysicalController::AdvancePhysicalState(void)
@@ -86,6 +111,15 @@ namespace XidiTest
 
     currentPhysicalStateIndex += 1;
     advanceRequested = false;
+
+    // Mirrors the snapshot publication hook in the real physical controller implementation, so
+    // that marked input transitions injected via mock physical states are tracked for latency
+    // measurement.
+    Xidi::LatencyMeasurement::SubmitPhysicalState(
+        kControllerIdentifier, GetCurrentPhysicalState());
+    Xidi::Diagnostics::RecordControllerConnected(
+        kControllerIdentifier,
+        (EPhysicalDeviceStatus::Ok == GetCurrentPhysicalState().deviceStatus));
   }
 
   SCapabilities MockPhysicalController::GetControllerCapabilities(void) const
@@ -131,6 +165,13 @@ namespace Xidi
   {
     using namespace ::XidiTest;
 
+    uint32_t GetCoarseTimestampMilliseconds(void)
+    {
+      // No polling threads exist for mock physical controllers, so the system multimedia timer is
+      // queried directly.
+      return ImportApiWinMM::timeGetTime();
+    }
+
     SCapabilities GetControllerCapabilities(TControllerIdentifier controllerIdentifier)
     {
       if (controllerIdentifier >= kPhysicalControllerCount)
@@ -182,6 +223,11 @@ namespace Xidi
             controllerIdentifier);
     }
 
+    uint32_t GetDeviceChangeNotificationGeneration(void)
+    {
+      return mockDeviceChangeGeneration.load(std::memory_order_acquire);
+    }
+
     ForceFeedback::Device* PhysicalControllerForceFeedbackRegister(
         TControllerIdentifier controllerIdentifier, const VirtualController* virtualController)
     {
@@ -217,6 +263,48 @@ namespace Xidi
       }
     }
 
+    void PhysicalControllerForceFeedbackGainChanged(TControllerIdentifier controllerIdentifier)
+    {
+      if (controllerIdentifier >= kPhysicalControllerCount)
+        TEST_FAILED_BECAUSE(
+            L"%s: Invalid controller identifier (%u).", __FUNCTIONW__, controllerIdentifier);
+
+      // The mock physical controller layer does not actuate force feedback effects, so there is
+      // no cached combined gain to recompute.
+    }
+
+    void PhysicalControllerPollingDemandRegister(void)
+    {
+      // Polling demand has no meaning for mock physical controllers, which are driven entirely by
+      // test cases rather than by polling threads.
+    }
+
+    void PhysicalControllerPollingDemandUnregister(void)
+    {
+      // Polling demand has no meaning for mock physical controllers, which are driven entirely by
+      // test cases rather than by polling threads.
+    }
+
+    void PhysicalControllerConsumedElementsRegister(
+        TControllerIdentifier controllerIdentifier, TElementMask elements)
+    {
+      // Consumed element registration has no meaning for mock physical controllers, whose state
+      // is supplied directly by test cases rather than produced by a mapping pass.
+    }
+
+    void PhysicalControllerConsumedElementsUnregister(
+        TControllerIdentifier controllerIdentifier, TElementMask elements)
+    {
+      // Consumed element registration has no meaning for mock physical controllers, whose state
+      // is supplied directly by test cases rather than produced by a mapping pass.
+    }
+
+    void PhysicalControllerMarkConsumerRead(TControllerIdentifier controllerIdentifier)
+    {
+      // Consumer read cadence has no meaning for mock physical controllers, which are driven
+      // entirely by test cases rather than by polling threads.
+    }
+
     bool WaitForPhysicalControllerStateChange(
         TControllerIdentifier controllerIdentifier,
         SPhysicalState& state,
@@ -6,14 +6,116 @@
  * Copyright (c) 2016-2026
  ***********************************************************************************************//**
  * @file TestMain.cpp
- *   Entry point for the test executable.
+ *   Entry point for the test executable, including the parallel test runner. In parallel mode
+ *   the test executable spawns one child copy of itself per test name prefix shard, up to one
+ *   per processor at a time, and aggregates their results. Sharding at process granularity means
+ *   cases in different shards can never share process-global state, such as the state held in
+ *   Globals.cpp or the singleton keyboard and mouse state, while cases within a shard run
+ *   serially in registration order exactly as they would in a serial run.
  **************************************************************************************************/
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <Infra/Test/Harness.h>
 
+#include "ApiWindows.h"
 #include "Globals.h"
 
+/// Command-line argument that selects parallel test execution.
+static constexpr std::wstring_view kParallelModeArgument = L"--parallel";
+
+/// Test name prefix shards used in parallel mode, one per leading letter. Every test case name
+/// begins with the name of the module under test, so all cases for one module land in the same
+/// shard and preserve their relative execution order. Letters with no matching test cases simply
+/// produce shards that run zero cases.
+static constexpr std::wstring_view kShardPrefixes[] = {
+    L"A", L"B", L"C", L"D", L"E", L"F", L"G", L"H", L"I", L"J", L"K", L"L", L"M",
+    L"N", L"O", L"P", L"Q", L"R", L"S", L"T", L"U", L"V", L"W", L"X", L"Y", L"Z"};
+
+/// Runs all test cases by sharding them across child copies of this executable, at most one per
+/// processor at a time.
+/// @return Aggregated number of failing test cases across all shards, or a nonzero value if any
+/// shard could not be launched.
+static int RunAllTestsInParallel(void)
+{
+  wchar_t executablePath[MAX_PATH];
+  if (0 == GetModuleFileNameW(nullptr, executablePath, _countof(executablePath))) return 1;
+
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const size_t maxConcurrentShards = std::min(
+      (size_t)((systemInfo.dwNumberOfProcessors > 0) ? systemInfo.dwNumberOfProcessors : 1),
+      (size_t)MAXIMUM_WAIT_OBJECTS);
+
+  int numFailingTests = 0;
+  std::vector<HANDLE> runningShards;
+  runningShards.reserve(maxConcurrentShards);
+
+  // Waits for one running shard to exit, adds its exit code to the failure total, and removes it
+  // from the running set.
+  const auto reapOneShard = [&numFailingTests, &runningShards]() -> void
+  {
+    const DWORD waitResult = WaitForMultipleObjects(
+        (DWORD)runningShards.size(), runningShards.data(), FALSE, INFINITE);
+    if (waitResult >= (WAIT_OBJECT_0 + runningShards.size()))
+    {
+      numFailingTests += 1;
+      return;
+    }
+
+    const size_t exitedShardIndex = (size_t)(waitResult - WAIT_OBJECT_0);
+    DWORD shardExitCode = 1;
+    GetExitCodeProcess(runningShards[exitedShardIndex], &shardExitCode);
+    numFailingTests += (int)shardExitCode;
+
+    CloseHandle(runningShards[exitedShardIndex]);
+    runningShards.erase(runningShards.begin() + exitedShardIndex);
+  };
+
+  for (const auto& shardPrefix : kShardPrefixes)
+  {
+    while (runningShards.size() >= maxConcurrentShards)
+      reapOneShard();
+
+    std::wstring shardCommandLine;
+    shardCommandLine.reserve(MAX_PATH + 8);
+    shardCommandLine.append(L"\"").append(executablePath).append(L"\" ").append(shardPrefix);
+
+    STARTUPINFOW startupInfo = {.cb = sizeof(STARTUPINFOW)};
+    PROCESS_INFORMATION processInfo = {};
+    if (FALSE ==
+        CreateProcessW(
+            executablePath,
+            shardCommandLine.data(),
+            nullptr,
+            nullptr,
+            FALSE,
+            0,
+            nullptr,
+            nullptr,
+            &startupInfo,
+            &processInfo))
+    {
+      numFailingTests += 1;
+      continue;
+    }
+
+    CloseHandle(processInfo.hThread);
+    runningShards.push_back(processInfo.hProcess);
+  }
+
+  while (false == runningShards.empty())
+    reapOneShard();
+
+  return numFailingTests;
+}
+
 int wmain(int argc, const wchar_t* argv[])
 {
+  if ((argc > 1) && (kParallelModeArgument == argv[1])) return RunAllTestsInParallel();
+
   return Infra::Test::Harness::RunTestsWithMatchingPrefix(((argc > 1) ? argv[1] : L""));
 }
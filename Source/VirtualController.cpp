@@ -11,15 +11,22 @@
 
 #include "VirtualController.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <stop_token>
 #include <thread>
 
 #include <Infra/Core/Message.h>
 
+#include "ApiBitSet.h"
 #include "ControllerTypes.h"
+#include "DevicePropertyCache.h"
+#include "EventTrace.h"
 #include "ForceFeedbackTypes.h"
-#include "ImportApiWinMM.h"
+#include "Globals.h"
+#include "LatencyMeasurement.h"
 #include "Mapper.h"
 #include "PhysicalController.h"
 
@@ -27,30 +34,46 @@ namespace Xidi
 {
   namespace Controller
   {
-    /// Maps a value in one range to its corresponding value in another range.
-    /// Ranges are specified as origin values and displacements, essentially one-dimensional vectors
-    /// with direction either positive (maximum displacement value is greater than origin value) or
-    /// negative (maximum displacement value is less than origin value). It is not necessary that
-    /// the direction of the vectors be the same for both old and new range.
-    /// @param [in] oldRangeValue Raw value to transform in the old range.
-    /// @param [in] oldRangeOrigin Origin value of the old range.
-    /// @param [in] oldRangeDispMax Maximum displacement value in the old range.
-    /// @param [in] newRangeOrigin Origin value of the new range.
-    /// @param [in] newRangeDispMax Maximum displacement value in the new range.
-    /// @return Result of mapping the input value from the old range to the new range.
-    static inline int32_t MapValueInRangeToRange(
-        int32_t oldRangeValue,
-        int32_t oldRangeOrigin,
-        int32_t oldRangeDispMax,
-        int32_t newRangeOrigin,
-        int32_t newRangeDispMax)
-    {
-      const int64_t oldRangeValueDisp = (int64_t)oldRangeValue - (int64_t)oldRangeOrigin;
-      const int64_t newRangeMagnitudeMax = (int64_t)newRangeDispMax - (int64_t)newRangeOrigin;
-      const int64_t oldRangeMagnitudeMax = (int64_t)oldRangeDispMax - (int64_t)oldRangeOrigin;
-
-      return newRangeOrigin +
-          (int32_t)((oldRangeValueDisp * newRangeMagnitudeMax) / oldRangeMagnitudeMax);
+    /// Applies a precomputed fixed-point linear transformation to an axis value displacement.
+    /// The slope carries #VirtualController::SAxisProperties::kTransformFixedPointBits fractional
+    /// bits, so the mapping reduces to a multiply, a round-to-nearest addend, and an arithmetic
+    /// shift, with no division on the per-refresh hot path.
+    /// @param [in] rawValueDisp Displacement of the raw axis value from the start of the linear
+    /// region.
+    /// @param [in] transformSlope Precomputed fixed-point slope of the linear region.
+    /// @param [in] rangeOrigin Reported value at the start of the linear region.
+    /// @return Result of mapping the input displacement to the reportable range.
+    static inline int32_t ApplyTransformSlope(
+        int64_t rawValueDisp, int64_t transformSlope, int32_t rangeOrigin)
+    {
+      constexpr int64_t kRoundingAddend =
+          (1LL << (VirtualController::SAxisProperties::kTransformFixedPointBits - 1));
+
+      return rangeOrigin +
+          (int32_t)(((rawValueDisp * transformSlope) + kRoundingAddend) >>
+                    VirtualController::SAxisProperties::kTransformFixedPointBits);
+    }
+
+    /// Compares the comparable elements of two virtual controller state objects for equality
+    /// using a single bulk memory comparison instead of per-element comparisons.
+    /// All comparable elements of #SState hold canonical representations, so representation
+    /// equality and value equality coincide, and the compiler can reduce the whole comparison to
+    /// a few vector instructions. This quickly rejects the overwhelmingly common "nothing changed"
+    /// case before any per-element work.
+    /// @param [in] stateA First state object to compare.
+    /// @param [in] stateB Second state object to compare.
+    /// @return `true` if all comparable elements are equal, `false` otherwise.
+    static inline bool StatesEqual(const SState& stateA, const SState& stateB)
+    {
+      // The comparable elements occupy a contiguous, padding-free prefix of the structure that
+      // ends where the capture timestamp begins, which keeps the timestamp excluded from the
+      // comparison just as it is excluded from the structure's equality operator.
+      static_assert(
+          offsetof(SState, captureTimestamp) ==
+              (sizeof(SState::axis) + sizeof(SState::button) + sizeof(SState::povDirection)),
+          "Comparable elements of SState are required to be contiguous.");
+
+      return (0 == memcmp(&stateA, &stateB, offsetof(SState, captureTimestamp)));
     }
 
     /// Monitors for changes in an associated physical controller's state and, on state change,
@@ -80,6 +103,20 @@ namespace Xidi
       }
     }
 
+    /// Determines whether state change event generation is currently enabled. Event generation
+    /// is suspended while the current process does not have input focus. Test builds have no
+    /// meaningful focus state, so there event generation is always enabled.
+    /// @return `true` if accepted state refreshes should generate buffered events, `false` if
+    /// not.
+    static bool IsEventGenerationEnabled(void)
+    {
+#ifndef XIDI_SKIP_CONFIG
+      return Globals::DoesCurrentProcessHaveInputFocus();
+#else
+      return true;
+#endif
+    }
+
     /// Looks for differences between two virtual controller state objects and submits them as
     /// events to the specified event buffer. Events are only submitted if the associated virtual
     /// controller element is included in the event filter.
@@ -97,42 +134,78 @@ namespace Xidi
     {
       if (true == eventBuffer.IsEnabled())
       {
-        const uint32_t timestamp = ImportApiWinMM::timeGetTime();
+        // First pass identifies all changed elements as a set, so that the event filter can be
+        // consulted once with whole-word bit operations instead of once per changed element.
+        VirtualController::EventFilter::TElementSet changedElements;
 
         for (unsigned int i = 0; i < oldState.axis.size(); ++i)
-        {
           if (oldState.axis[i] != newState.axis[i])
-          {
-            const SElementIdentifier axisElement = {.type = EElementType::Axis, .axis = (EAxis)i};
+            changedElements.insert(VirtualController::EventFilter::kBaseIndexAxis + i);
+
+        // Buttons are diffed with a single whole-word XOR, and only the bits that actually
+        // changed are visited.
+        ForEachSetBit(
+            oldState.button ^ newState.button,
+            [&changedElements](unsigned int buttonIndex)
+            {
+              changedElements.insert(
+                  VirtualController::EventFilter::kBaseIndexButton + buttonIndex);
+            });
 
-            if (eventFilter.Contains(axisElement))
-              eventBuffer.AppendEvent(
-                  {.element = axisElement, .value = {.axis = newState.axis[i]}}, timestamp);
-          }
-        }
+        if (oldState.povDirection.all != newState.povDirection.all)
+          changedElements.insert(VirtualController::EventFilter::kBaseIndexPov);
+
+        // In the common case of an application that filters out most controller objects the
+        // intersection is empty, and the whole submission is skipped.
+        const VirtualController::EventFilter::TElementSet allowedChangedElements =
+            eventFilter.AllowedElements(changedElements);
+        if (true == allowedChangedElements.empty()) return;
+
+        const uint32_t timestamp = GetCoarseTimestampMilliseconds();
 
-        for (unsigned int i = 0; i < oldState.button.size(); ++i)
+        // A single state refresh can fan out into one event per allowed changed element, so the
+        // whole sequence number range is allocated up front with one synchronized operation and
+        // assigned locally as events are appended.
+        uint32_t sequence = StateChangeEventBuffer::AllocateSequenceRange(
+            (uint32_t)allowedChangedElements.size());
+
+        // Set iteration is in ascending index order, which preserves the axis, button, POV event
+        // ordering that existed when elements were diffed and appended one at a time.
+        for (const auto elementIndex : allowedChangedElements)
         {
-          if (oldState.button[i] != newState.button[i])
-          {
-            const SElementIdentifier buttonElement = {
-                .type = EElementType::Button, .button = (EButton)i};
+          const SElementIdentifier element =
+              VirtualController::EventFilter::IndexToElement((unsigned int)elementIndex);
 
-            if (eventFilter.Contains(buttonElement))
+          switch (element.type)
+          {
+            case EElementType::Axis:
               eventBuffer.AppendEvent(
-                  {.element = buttonElement, .value = {.button = newState.button[i]}}, timestamp);
-          }
-        }
+                  {.element = element, .value = {.axis = newState[element.axis]}},
+                  timestamp,
+                  sequence++,
+                  newState.captureTimestamp);
+              break;
 
-        if (oldState.povDirection.all != newState.povDirection.all)
-        {
-          const SElementIdentifier povElement = {.type = EElementType::Pov};
+            case EElementType::Button:
+              eventBuffer.AppendEvent(
+                  {.element = element, .value = {.button = newState[element.button]}},
+                  timestamp,
+                  sequence++,
+                  newState.captureTimestamp);
+              break;
 
-          if (eventFilter.Contains(povElement))
-            eventBuffer.AppendEvent(
-                {.element = povElement,
-                 .value = {.povDirection = {.all = newState.povDirection.all}}},
-                timestamp);
+            case EElementType::Pov:
+              eventBuffer.AppendEvent(
+                  {.element = element,
+                   .value = {.povDirection = {.all = newState.povDirection.all}}},
+                  timestamp,
+                  sequence++,
+                  newState.captureTimestamp);
+              break;
+
+            default:
+              break;
+          }
         }
       }
     }
@@ -153,12 +226,10 @@ namespace Xidi
         else if (axisValueRaw >= axisProperties.saturationRawCutoffPositive)
           return axisProperties.rangeMax;
         else
-          return MapValueInRangeToRange(
-              axisValueRaw,
-              axisProperties.deadzoneRawCutoffPositive,
-              axisProperties.saturationRawCutoffPositive,
-              axisProperties.rangeNeutral,
-              axisProperties.rangeMax);
+          return ApplyTransformSlope(
+              ((int64_t)axisValueRaw - (int64_t)axisProperties.deadzoneRawCutoffPositive),
+              axisProperties.transformSlopePositive,
+              axisProperties.rangeNeutral);
       }
       else
       {
@@ -167,33 +238,47 @@ namespace Xidi
         else if (axisValueRaw <= axisProperties.saturationRawCutoffNegative)
           return axisProperties.rangeMin;
         else
-          return MapValueInRangeToRange(
-              axisValueRaw,
-              axisProperties.deadzoneRawCutoffNegative,
-              axisProperties.saturationRawCutoffNegative,
-              axisProperties.rangeNeutral,
-              axisProperties.rangeMin);
+          return ApplyTransformSlope(
+              ((int64_t)axisValueRaw - (int64_t)axisProperties.deadzoneRawCutoffNegative),
+              axisProperties.transformSlopeNegative,
+              axisProperties.rangeNeutral);
       }
     }
 
     VirtualController::VirtualController(TControllerIdentifier controllerId)
         : kControllerIdentifier(controllerId),
+          kStateChangeEventSignalingWatermark(
+              Globals::GetPropertiesSettings().stateChangeEventSignalingWatermark),
           controllerMutex(),
           eventBuffer(),
           eventFilter(),
+          consumedElements(kElementMaskAll),
           properties(),
+          dirtyAxisProperties(),
+          hasDirtyAxisProperties(false),
           stateRaw(),
           stateProcessed(),
+          stateProcessedSnapshot(),
           stateChangeEventHandle(NULL),
+          stateChangeEventShouldSignal(false),
           physicalControllerMonitor(),
           physicalControllerMonitorStop(),
           physicalControllerForceFeedbackBuffer()
     {
+      PhysicalControllerPollingDemandRegister();
+      PhysicalControllerConsumedElementsRegister(kControllerIdentifier, consumedElements);
+
+      eventBuffer.SetCoalescingEnabled(Globals::GetPropertiesSettings().stateChangeEventCoalescing);
+
       const SState initialState = GetCurrentRawVirtualControllerState(kControllerIdentifier);
 
       RefreshState(initialState);
       ReapplyProperties();
 
+      // Pre-applying cached device properties at creation time means that an application
+      // re-applying the same properties it used last launch finds every value already in place.
+      DevicePropertyCache::ApplyToController(*this);
+
       physicalControllerMonitor = std::thread(
           MonitorPhysicalControllerState,
           this,
@@ -213,6 +298,21 @@ namespace Xidi
       physicalControllerMonitorStop.request_stop();
       physicalControllerMonitor.join();
 
+      PhysicalControllerConsumedElementsUnregister(kControllerIdentifier, consumedElements);
+      PhysicalControllerPollingDemandUnregister();
+
+      // The summary supports sizing event buffer capacity recommendations, so it is only emitted
+      // if buffered events were ever actually used with this virtual controller.
+      if (0 != eventBuffer.GetEventCountHighWaterMark())
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Event buffer summary for virtual controller %u: %llu overflows, %llu dropped events, high-water mark of %u events, final capacity of %u events.",
+            (1 + kControllerIdentifier),
+            (unsigned long long)eventBuffer.GetTotalOverflowCount(),
+            (unsigned long long)eventBuffer.GetTotalDroppedEventCount(),
+            eventBuffer.GetEventCountHighWaterMark(),
+            eventBuffer.GetCapacity());
+
       Infra::Message::OutputFormatted(
           Infra::Message::ESeverity::Info,
           L"Destroyed virtual controller object with identifier %u.",
@@ -230,6 +330,26 @@ namespace Xidi
       }
     }
 
+    void VirtualController::ApplyDirtyAxisProperties(void)
+    {
+      if (false == hasDirtyAxisProperties.load(std::memory_order_acquire)) return;
+
+      const SCapabilities capabilities = GetCapabilities();
+
+      for (const auto dirtyAxisIndex : dirtyAxisProperties)
+      {
+        const EAxis axis = (EAxis)dirtyAxisIndex;
+
+        if (true == capabilities.HasAxis(axis))
+          stateProcessed[axis] = TransformAxisValue(stateRaw[axis], properties[axis]);
+      }
+
+      dirtyAxisProperties.clear();
+      hasDirtyAxisProperties.store(false, std::memory_order_release);
+
+      stateProcessedSnapshot.Set(stateProcessed);
+    }
+
     bool VirtualController::ForceFeedbackRegister(void)
     {
       auto lock = Lock();
@@ -256,8 +376,44 @@ namespace Xidi
 
     SState VirtualController::GetState(void)
     {
-      auto lock = Lock();
-      return stateProcessed;
+      PhysicalControllerMarkConsumerRead(kControllerIdentifier);
+      InputMetrics::RecordStateRead(kControllerIdentifier);
+      LatencyMeasurement::SubmitStateRead(kControllerIdentifier);
+
+      // Property changes are applied lazily, so any still-pending changes need to be folded into
+      // the published snapshot before it is read. The check is a single atomic load, keeping the
+      // common no-pending-changes path lock-free.
+      if (true == hasDirtyAxisProperties.load(std::memory_order_acquire))
+      {
+        auto lock = Lock();
+        ApplyDirtyAxisProperties();
+      }
+
+      // Reading the published snapshot avoids taking this virtual controller's lock, so state
+      // reads from application threads never contend with the background refresh thread.
+      return stateProcessedSnapshot.Get();
+    }
+
+    SState VirtualController::GetState(uint32_t& stateVersion)
+    {
+      PhysicalControllerMarkConsumerRead(kControllerIdentifier);
+      InputMetrics::RecordStateRead(kControllerIdentifier);
+      LatencyMeasurement::SubmitStateRead(kControllerIdentifier);
+
+      // Property changes are applied lazily, so any still-pending changes need to be folded into
+      // the published snapshot before it is read. The check is a single atomic load, keeping the
+      // common no-pending-changes path lock-free.
+      if (true == hasDirtyAxisProperties.load(std::memory_order_acquire))
+      {
+        auto lock = Lock();
+        ApplyDirtyAxisProperties();
+      }
+
+      // Reading the published snapshot avoids taking this virtual controller's lock, so state
+      // reads from application threads never contend with the background refresh thread. The
+      // snapshot's version number doubles as the state version: it advances exactly when a state
+      // change is published.
+      return stateProcessedSnapshot.Get(stateVersion);
     }
 
     void VirtualController::PopEventBufferOldestEvents(uint32_t numEventsToPop)
@@ -266,15 +422,50 @@ namespace Xidi
       eventBuffer.PopOldestEvents(numEventsToPop);
     }
 
+    void VirtualController::PrepareForReuse(void)
+    {
+      ForceFeedbackUnregister();
+
+      auto lock = Lock();
+
+      stateChangeEventHandle = NULL;
+      stateChangeEventShouldSignal = false;
+
+      eventBuffer.PopOldestEvents(eventBuffer.GetCount());
+      eventBuffer.SetCapacity(0);
+      eventFilter.AddAll();
+
+      properties = SProperties();
+      ReapplyProperties();
+    }
+
     void VirtualController::ReapplyProperties(void)
     {
       stateProcessed = stateRaw;
       ApplyProperties(stateProcessed);
+
+      dirtyAxisProperties.clear();
+      hasDirtyAxisProperties.store(false, std::memory_order_release);
+
+      stateProcessedSnapshot.Set(stateProcessed);
     }
 
     bool VirtualController::RefreshState(SState newStateRaw)
     {
       auto lock = Lock();
+
+      // Any still-pending lazy property changes are folded in first, so the processed state and
+      // published snapshot reflect them even if the raw state turns out to be unchanged.
+      ApplyDirtyAxisProperties();
+
+      // Properties are applied deterministically, so unchanged raw state means unchanged
+      // processed state and the entire refresh can be rejected up front.
+      if (true == StatesEqual(stateRaw, newStateRaw))
+      {
+        EventTrace::VirtualControllerRefreshed(kControllerIdentifier, false);
+        return false;
+      }
+
       stateRaw = newStateRaw;
 
       SState newStateProcessed = newStateRaw;
@@ -285,10 +476,47 @@ namespace Xidi
       // deadzone might result in filtering out changes in analog stick position, or if a particular
       // XInput controller element is ignored by the mapper then a change in that element does not
       // influence the virtual controller state.
-      if (newStateProcessed == stateProcessed) return false;
+      if (true == StatesEqual(newStateProcessed, stateProcessed))
+      {
+        EventTrace::VirtualControllerRefreshed(kControllerIdentifier, false);
+        return false;
+      }
 
-      SubmitStateChangeEvents(stateProcessed, newStateProcessed, eventFilter, eventBuffer);
+      // Event generation is suspended while the process is in the background. DirectInput
+      // devices are typically unacquired without focus anyway, and buffering events nobody will
+      // drain would only overflow the buffer and then surface as a stale flood on refocus. The
+      // processed state snapshot is still refreshed so that immediate-mode reads stay current.
+      const uint32_t eventCountBeforeSubmit = eventBuffer.GetCount();
+      if (true == IsEventGenerationEnabled())
+        SubmitStateChangeEvents(stateProcessed, newStateProcessed, eventFilter, eventBuffer);
       stateProcessed = newStateProcessed;
+      stateProcessedSnapshot.Set(stateProcessed);
+
+      // The signaling policy is evaluated here, while the event buffer counts are exact and the
+      // lock is held, and the decision is consumed by the subsequent signal attempt. With the
+      // default watermark of 0, or whenever the event buffer is disabled, every accepted refresh
+      // signals. A non-zero watermark coalesces notifications by signalling only when the
+      // buffered event count crosses the watermark from below, clamped to the buffer capacity so
+      // that an over-sized watermark still signals once the buffer fills.
+      if ((0 == kStateChangeEventSignalingWatermark) || (false == eventBuffer.IsEnabled()))
+      {
+        stateChangeEventShouldSignal = true;
+      }
+      else
+      {
+        const uint32_t signalThreshold =
+            std::min(kStateChangeEventSignalingWatermark, eventBuffer.GetCapacity());
+        stateChangeEventShouldSignal = ((eventCountBeforeSubmit < signalThreshold) &&
+                                        (eventBuffer.GetCount() >= signalThreshold));
+      }
+
+      InputMetrics::RecordStateRefreshed(kControllerIdentifier, newStateRaw.captureTimestamp);
+      LatencyMeasurement::SubmitStateRefresh(kControllerIdentifier, newStateRaw.captureTimestamp);
+      if (true == eventBuffer.IsEnabled())
+        InputMetrics::RecordEventBufferOccupancy(
+            eventBuffer.GetCount(), eventBuffer.GetCapacity());
+
+      EventTrace::VirtualControllerRefreshed(kControllerIdentifier, true);
       return true;
     }
 
@@ -300,7 +528,8 @@ namespace Xidi
 
         properties[axis].SetDeadzone(deadzone);
 
-        ReapplyProperties();
+        MarkAxisPropertiesDirty(axis);
+        DevicePropertyCache::RecordAxisDeadzone(kControllerIdentifier, axis, deadzone);
         return true;
       }
 
@@ -315,7 +544,8 @@ namespace Xidi
 
         properties[axis].SetRange(rangeMin, rangeMax);
 
-        ReapplyProperties();
+        MarkAxisPropertiesDirty(axis);
+        DevicePropertyCache::RecordAxisRange(kControllerIdentifier, axis, rangeMin, rangeMax);
         return true;
       }
 
@@ -330,7 +560,8 @@ namespace Xidi
 
         properties[axis].SetSaturation(saturation);
 
-        ReapplyProperties();
+        MarkAxisPropertiesDirty(axis);
+        DevicePropertyCache::RecordAxisSaturation(kControllerIdentifier, axis, saturation);
         return true;
       }
 
@@ -343,7 +574,7 @@ namespace Xidi
 
       properties[axis].SetTransformationsEnabled(transformationsEnabled);
 
-      ReapplyProperties();
+      MarkAxisPropertiesDirty(axis);
     }
 
     bool VirtualController::SetAllAxisDeadzone(uint32_t deadzone)
@@ -355,7 +586,8 @@ namespace Xidi
         for (auto& axis : properties.axis)
           axis.SetDeadzone(deadzone);
 
-        ReapplyProperties();
+        MarkAllAxisPropertiesDirty();
+        DevicePropertyCache::RecordAxisDeadzone(kControllerIdentifier, std::nullopt, deadzone);
         return true;
       }
 
@@ -371,7 +603,8 @@ namespace Xidi
         for (auto& axis : properties.axis)
           axis.SetRange(rangeMin, rangeMax);
 
-        ReapplyProperties();
+        MarkAllAxisPropertiesDirty();
+        DevicePropertyCache::RecordAxisRange(kControllerIdentifier, std::nullopt, rangeMin, rangeMax);
         return true;
       }
 
@@ -387,7 +620,8 @@ namespace Xidi
         for (auto& axis : properties.axis)
           axis.SetSaturation(saturation);
 
-        ReapplyProperties();
+        MarkAllAxisPropertiesDirty();
+        DevicePropertyCache::RecordAxisSaturation(kControllerIdentifier, std::nullopt, saturation);
         return true;
       }
 
@@ -401,7 +635,19 @@ namespace Xidi
       for (auto& axis : properties.axis)
         axis.SetTransformationsEnabled(transformationsEnabled);
 
-      ReapplyProperties();
+      MarkAllAxisPropertiesDirty();
+    }
+
+    void VirtualController::SetConsumedElements(TElementMask newConsumedElements)
+    {
+      if (newConsumedElements == consumedElements) return;
+
+      // Registering the new mask before unregistering the old one ensures that the union of
+      // consumed elements registered with the physical controller layer never transiently drops
+      // an element that remains consumed across the change.
+      PhysicalControllerConsumedElementsRegister(kControllerIdentifier, newConsumedElements);
+      PhysicalControllerConsumedElementsUnregister(kControllerIdentifier, consumedElements);
+      consumedElements = newConsumedElements;
     }
 
     bool VirtualController::SetEventBufferCapacity(uint32_t capacity)
@@ -412,6 +658,7 @@ namespace Xidi
         eventBuffer.SetCapacity(capacity);
       }
 
+      DevicePropertyCache::RecordEventBufferCapacity(kControllerIdentifier, capacity);
       return true;
     }
 
@@ -422,6 +669,9 @@ namespace Xidi
       {
         auto lock = Lock();
         properties.device.SetFfGain(newFfGain);
+
+        PhysicalControllerForceFeedbackGainChanged(kControllerIdentifier);
+        DevicePropertyCache::RecordForceFeedbackGain(kControllerIdentifier, ffGain);
         return true;
       }
 
@@ -435,6 +685,8 @@ namespace Xidi
 
     void VirtualController::SignalStateChangeEvent(void)
     {
+      if (true != stateChangeEventShouldSignal) return;
+
       const HANDLE eventHandleToSignal = stateChangeEventHandle;
 
       if ((NULL != eventHandleToSignal) && (INVALID_HANDLE_VALUE != eventHandleToSignal))
@@ -11,13 +11,13 @@
 
 #include "VirtualDirectInputDevice.h"
 
+#include <array>
 #include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <unordered_map>
 
 #include <Infra/Core/Configuration.h>
 #include <Infra/Core/Message.h>
@@ -28,10 +28,15 @@
 #include "ControllerIdentification.h"
 #include "ControllerTypes.h"
 #include "DataFormat.h"
+#include "EventTrace.h"
+#include "FlightRecorder.h"
 #include "ForceFeedbackDevice.h"
 #include "ForceFeedbackTypes.h"
 #include "Globals.h"
+#include "GuidHashTable.h"
+#include "HotPathLogging.h"
 #include "PhysicalController.h"
+#include "RateLimitedLogging.h"
 #include "Strings.h"
 #include "VirtualController.h"
 #include "VirtualDirectInputEffect.h"
@@ -52,6 +57,49 @@
   }                                                                                                        \
   while (false)
 
+/// Logs a DirectInput interface method invocation on the input hot path and returns. Instead of
+/// formatting a message immediately, the invocation is captured as a fixed-size binary record in a
+/// per-thread buffer and formatted only when that buffer fills, so enabling diagnostic logging
+/// does not add per-call formatting latency to methods that applications invoke every frame.
+/// Capture is gated on a per-device flag sampled at construction rather than a per-call severity
+/// query, so the severity passed in should not be more verbose than the diagnostic severity used
+/// to compute that flag.
+#define LOG_HOT_PATH_INVOCATION_AND_RETURN(result, severity)           \
+  do                                                                   \
+  {                                                                    \
+    const HRESULT hresult = (result);                                  \
+    if (true == this->kHotPathLoggingEnabled)                          \
+      HotPathLogging::RecordInvocation(                                \
+          severity,                                                    \
+          __FUNCTIONW__ L"()",                                         \
+          this->kObjectId,                                             \
+          (1 + this->controller->GetIdentifier()),                     \
+          hresult);                                                    \
+    return hresult;                                                    \
+  }                                                                    \
+  while (false)
+
+/// Logs a DirectInput interface method invocation subject to per-call-site rate limiting and
+/// returns. Intended for error paths of methods that applications invoke every frame: an
+/// application that repeatedly invokes such a method in a state in which it can only fail would
+/// otherwise pay for, and flood the log with, thousands of identical formatted messages per
+/// second. Suppressed messages are summarized with a repeat count the next time the call site is
+/// permitted to output.
+#define LOG_RATE_LIMITED_INVOCATION_AND_RETURN(result, severity)                                           \
+  do                                                                                                       \
+  {                                                                                                        \
+    const HRESULT hresult = (result);                                                                      \
+    XIDI_RATE_LIMITED_OUTPUT_FORMATTED(                                                                    \
+        severity,                                                                                          \
+        L"Invoked %s on interface object %u associated with Xidi virtual controller %u, result = 0x%08x.", \
+        __FUNCTIONW__ L"()",                                                                               \
+        this->kObjectId,                                                                                   \
+        (1 + this->controller->GetIdentifier()),                                                           \
+        hresult);                                                                                          \
+    return hresult;                                                                                        \
+  }                                                                                                        \
+  while (false)
+
 /// Logs a DirectInput property-related method invocation and returns.
 #define LOG_PROPERTY_INVOCATION_AND_RETURN(result, severity, rguidprop, propvalfmt, ...)                                                          \
   do                                                                                                                                              \
@@ -115,6 +163,26 @@ namespace Xidi
   /// that is created.
   static std::atomic<unsigned int> nextVirtualDirectInputDeviceBaseObjectId = 0;
 
+  /// Maximum number of fully-released force feedback effect objects retained per effect GUID in a
+  /// device object's effect pool. Applications that churn through effect objects typically only
+  /// keep a handful of each type alive at once, so a small bound captures the reuse benefit while
+  /// keeping the retained memory footprint negligible.
+  static constexpr size_t kForceFeedbackEffectPoolCapacityPerGuid = 8;
+
+  /// Pooled fully-released device interface objects available for reuse by subsequent device
+  /// creation requests, one slot per virtual controller identifier. Pooled objects have already
+  /// been reset to their freshly-constructed state, and their virtual controllers, including the
+  /// background monitoring threads, are kept alive. Some applications close and re-open the same
+  /// controller repeatedly, and pooling turns those cycles into hand-backs of warm objects
+  /// instead of full destroy-construct round trips that include thread termination and creation.
+  /// Guarded by #devicePoolGuard.
+  template <EDirectInputVersion diVersion> static std::array<
+      VirtualDirectInputDeviceBase<diVersion>*, Controller::kPhysicalControllerCount>
+      devicePool;
+
+  /// Serializes access to the device object pool.
+  static std::mutex devicePoolGuard;
+
   /// Converts from axis type enumerator to axis type GUID.
   /// @param [in] axis Axis type enumerator to convert.
   /// @return Read-only reference to the corresponding GUID object.
@@ -596,7 +664,7 @@ namespace Xidi
     // force feedback effect objects and how to do it. Presence or absence of a GUID in this
     // registry determines whether GUIDs are presented during enumeration or are recognized by calls
     // to device interface methods that use force feedback effect GUIDs.
-    static const std::unordered_map<GUID, TForceFeedbackEffectCreatorFunc<diVersion>>
+    static const GuidHashMap<TForceFeedbackEffectCreatorFunc<diVersion>>
         kForceFeedbackEffectObjectCreators = {
             {GUID_ConstantForce,
              [](REFGUID rguidEffect, VirtualDirectInputDeviceBase<diVersion>& associatedDevice)
@@ -649,11 +717,11 @@ namespace Xidi
              }},
         };
 
-    auto forceFeedbackEffectObjectCreatorIt = kForceFeedbackEffectObjectCreators.find(rguidEffect);
-    if (kForceFeedbackEffectObjectCreators.cend() == forceFeedbackEffectObjectCreatorIt)
-      return nullptr;
+    const TForceFeedbackEffectCreatorFunc<diVersion>* const forceFeedbackEffectObjectCreator =
+        kForceFeedbackEffectObjectCreators.Find(rguidEffect);
+    if (nullptr == forceFeedbackEffectObjectCreator) return nullptr;
 
-    return forceFeedbackEffectObjectCreatorIt->second;
+    return *forceFeedbackEffectObjectCreator;
   }
 
   /// Allocates and constructs a new DirectInput force feedback effect object for the specified
@@ -817,6 +885,118 @@ namespace Xidi
     }
   }
 
+  /// Builds the element identification lookup tables for a virtual controller with the specified
+  /// capabilities. Intended to be invoked once per device object at construction time.
+  /// @param [in] controllerCapabilities Capabilities that describe the layout of the virtual
+  /// controller.
+  /// @return Resulting element identification tables.
+  static SElementIdentificationTables BuildElementIdentificationTables(
+      Controller::SCapabilities controllerCapabilities)
+  {
+    SElementIdentificationTables identificationTables;
+
+    for (int i = 0; i < controllerCapabilities.numAxes; ++i)
+    {
+      const Controller::SElementIdentifier axisIdentifier = {
+          .type = Controller::EElementType::Axis,
+          .axis = controllerCapabilities.axisCapabilities[i].type};
+      identificationTables.axisElementByInstance[i] = axisIdentifier;
+
+      const SHidUsageData axisHidUsageData = HidUsageDataForControllerElement(axisIdentifier);
+      identificationTables.elementByHidUsageData.emplace(
+          (((DWORD)axisHidUsageData.usagePage << 16) | (DWORD)axisHidUsageData.usage),
+          axisIdentifier);
+    }
+
+    for (int i = 0; i < controllerCapabilities.numButtons; ++i)
+    {
+      const Controller::SElementIdentifier buttonIdentifier = {
+          .type = Controller::EElementType::Button, .button = (Controller::EButton)i};
+      identificationTables.buttonElementByInstance[i] = buttonIdentifier;
+
+      const SHidUsageData buttonHidUsageData = HidUsageDataForControllerElement(buttonIdentifier);
+      identificationTables.elementByHidUsageData.emplace(
+          (((DWORD)buttonHidUsageData.usagePage << 16) | (DWORD)buttonHidUsageData.usage),
+          buttonIdentifier);
+    }
+
+    {
+      const Controller::SElementIdentifier povIdentifier = {.type = Controller::EElementType::Pov};
+
+      // Identification of the POV by instance identifier deliberately succeeds whether or not the
+      // virtual controller actually has a POV, consistent with how object identifiers are
+      // generated. Identification by HID usage data, on the other hand, requires that the POV be
+      // present.
+      identificationTables.povElement = povIdentifier;
+
+      if (true == controllerCapabilities.HasPov())
+      {
+        const SHidUsageData povHidUsageData = HidUsageDataForControllerElement(povIdentifier);
+        identificationTables.elementByHidUsageData.emplace(
+            (((DWORD)povHidUsageData.usagePage << 16) | (DWORD)povHidUsageData.usage),
+            povIdentifier);
+      }
+    }
+
+    return identificationTables;
+  }
+
+  /// Builds a fully-populated device instance information structure for the specified virtual
+  /// controller. Invoked once per device object at construction time, since the contents are
+  /// fixed per virtual controller.
+  /// @tparam diVersion DirectInput version enumerator.
+  /// @param [in] controllerId Identifier of the virtual controller.
+  /// @return Resulting device instance information structure.
+  template <EDirectInputVersion diVersion> static
+      typename DirectInputTypes<diVersion>::DeviceInstanceType BuildDeviceInstanceInfo(
+          Controller::TControllerIdentifier controllerId)
+  {
+    typename DirectInputTypes<diVersion>::DeviceInstanceType instanceInfo = {
+        .dwSize = sizeof(typename DirectInputTypes<diVersion>::DeviceInstanceType)};
+    FillVirtualControllerInfo<diVersion>(instanceInfo, controllerId);
+    return instanceInfo;
+  }
+
+  /// Builds the display name of the specified virtual controller in wide-character form. Invoked
+  /// once per device object at construction time. Name-valued properties always use wide
+  /// characters, even for devices operating in ASCII character mode, so this name is cached
+  /// separately from the device instance information structure, which uses the device object's
+  /// own character width.
+  /// @param [in] controllerId Identifier of the virtual controller.
+  /// @return Null-terminated wide-character display name of the virtual controller.
+  static std::array<WCHAR, MAX_PATH> BuildControllerNameWide(
+      Controller::TControllerIdentifier controllerId)
+  {
+    std::array<WCHAR, MAX_PATH> controllerName = {};
+    FillVirtualControllerName(controllerName.data(), controllerName.size(), controllerId);
+    return controllerName;
+  }
+
+  /// Builds a shadow copy of the commonly-polled property values held by the specified virtual
+  /// controller. Invoked at device object construction time and again whenever a SetProperty call
+  /// could have changed one of the shadowed values.
+  /// @param [in] controller Virtual controller from which property values are read.
+  /// @return Resulting property value shadow.
+  static SPropertyValueShadow BuildPropertyValueShadow(
+      const Controller::VirtualController& controller)
+  {
+    SPropertyValueShadow propertyValueShadow = {
+        .eventBufferCapacity = (DWORD)controller.GetEventBufferCapacity()};
+
+    for (int i = 0; i < (int)Controller::EAxis::Count; ++i)
+    {
+      const Controller::EAxis axis = (Controller::EAxis)i;
+      const std::pair axisRange = controller.GetAxisRange(axis);
+
+      propertyValueShadow.axisDeadzone[i] = (DWORD)controller.GetAxisDeadzone(axis);
+      propertyValueShadow.axisSaturation[i] = (DWORD)controller.GetAxisSaturation(axis);
+      propertyValueShadow.axisRangeMin[i] = (LONG)axisRange.first;
+      propertyValueShadow.axisRangeMax[i] = (LONG)axisRange.second;
+    }
+
+    return propertyValueShadow;
+  }
+
   /// Generates an object identifier given a controller element and its associated controller
   /// capabilities.
   /// @param [in] controllerCapabilities Capabilities that describe the layout of the virtual
@@ -874,6 +1054,64 @@ namespace Xidi
         effectInfo->guid, effectInfo->tszName, _countof(effectInfo->tszName));
   }
 
+  /// One entry in the table of force feedback effects recognized by Xidi, holding a
+  /// fully-populated effect information structure ready to be handed to applications.
+  /// @tparam charMode Selects between ASCII ("A" suffix) and Unicode ("W") suffix versions of
+  /// types and interfaces.
+  template <EDirectInputVersion diVersion> struct SForceFeedbackEffectRecord
+  {
+    /// Effect information structure, completely filled in including friendly name.
+    typename DirectInputTypes<diVersion>::EffectInfoType effectInfo;
+
+    /// Whether an effect object can actually be constructed for this GUID. Effects that are
+    /// recognized but not constructible are excluded from enumeration.
+    bool canCreateObject;
+  };
+
+  /// Retrieves the table of force feedback effects recognized by Xidi, in enumeration order.
+  /// The table is built once per character mode on first use and shared by all subsequent
+  /// enumeration and information query calls, which therefore involve no per-call GUID assembly
+  /// or name formatting.
+  /// @tparam charMode Selects between ASCII ("A" suffix) and Unicode ("W") suffix versions of
+  /// types and interfaces.
+  /// @return Read-only reference to the effect information table.
+  template <EDirectInputVersion diVersion> static const auto& ForceFeedbackEffectInfoTable(void)
+  {
+    static const std::array<SForceFeedbackEffectRecord<diVersion>, 8>
+        kForceFeedbackEffectRecords = []() -> std::array<SForceFeedbackEffectRecord<diVersion>, 8>
+    {
+      // Enumeration order is category-major: constant force, ramp force, periodic effects, and
+      // finally custom force.
+      const GUID* kEffectGuids[] = {
+          &GUID_ConstantForce,
+          &GUID_RampForce,
+          &GUID_Square,
+          &GUID_Sine,
+          &GUID_Triangle,
+          &GUID_SawtoothUp,
+          &GUID_SawtoothDown,
+          &GUID_CustomForce};
+
+      std::array<SForceFeedbackEffectRecord<diVersion>, 8> effectRecords = {};
+
+      for (size_t i = 0; i < _countof(kEffectGuids); ++i)
+      {
+        effectRecords[i].effectInfo = {
+            .dwSize = sizeof(effectRecords[i].effectInfo),
+            .guid = *kEffectGuids[i],
+            .dwEffType = ForceFeedbackEffectType(*kEffectGuids[i]).value()};
+        FillForceFeedbackEffectInfo<diVersion>(&effectRecords[i].effectInfo);
+
+        effectRecords[i].canCreateObject =
+            (nullptr != ForceFeedbackEffectObjectCreator<diVersion>(*kEffectGuids[i]));
+      }
+
+      return effectRecords;
+    }();
+
+    return kForceFeedbackEffectRecords;
+  }
+
   /// Fills the specified object instance information structure with information about the specified
   /// HID collection. Size member must already be initialized because multiple versions of the
   /// structure exist, so it is used to determine which members to fill in.
@@ -994,10 +1232,28 @@ namespace Xidi
   template <EDirectInputVersion diVersion> VirtualDirectInputDeviceBase<diVersion>::
       VirtualDirectInputDeviceBase(std::unique_ptr<Controller::VirtualController>&& controller)
       : kObjectId(nextVirtualDirectInputDeviceBaseObjectId++),
+        kPollReturnCode(static_cast<DWORD>(
+            Globals::GetConfigurationData()
+                [Globals::ApplicableConfigurationSection(
+                    Strings::kStrConfigurationSectionWorkarounds)]
+                [Strings::kStrConfigurationSettingWorkaroundsPollReturnCode]
+                    .ValueOr(DI_NOEFFECT))),
+        kHotPathLoggingEnabled(
+            Infra::Message::WillOutputMessageOfSeverity(Infra::Message::ESeverity::SuperDebug)),
         controller(std::move(controller)),
         cooperativeLevel(ECooperativeLevel::Shared),
         dataFormat(),
+        elementIdentificationTables(
+            BuildElementIdentificationTables(this->controller->GetCapabilities())),
+        propertyValueShadow(BuildPropertyValueShadow(*this->controller)),
+        cachedStatePacket(),
+        cachedStatePacketVersion(0),
+        cachedObjectEnumerationTable(),
+        cachedDeviceInstanceInfo(
+            BuildDeviceInstanceInfo<diVersion>(this->controller->GetIdentifier())),
+        cachedControllerNameWide(BuildControllerNameWide(this->controller->GetIdentifier())),
         effectRegistry(),
+        effectPool(),
         refCount(1),
         unusedProperties()
   {}
@@ -1005,9 +1261,30 @@ namespace Xidi
   template <EDirectInputVersion diVersion> VirtualDirectInputDeviceBase<
       diVersion>::~VirtualDirectInputDeviceBase(void)
   {
+    // Pooled effect objects are fully detached from this object and hence owned by the pool
+    // itself, so they are destroyed along with this object.
+    for (auto& effectPoolRecord : effectPool)
+      for (auto& pooledEffectObject : effectPoolRecord.second)
+        delete pooledEffectObject;
+
     controller->ForceFeedbackUnregister();
   }
 
+  template <EDirectInputVersion diVersion> void VirtualDirectInputDeviceBase<
+      diVersion>::PrepareForReuse(void)
+  {
+    controller->PrepareForReuse();
+
+    cooperativeLevel = ECooperativeLevel::Shared;
+    dataFormat.reset();
+    propertyValueShadow = BuildPropertyValueShadow(*controller);
+    cachedStatePacket.clear();
+    cachedStatePacketVersion = 0;
+    cachedObjectEnumerationTable.clear();
+    unusedProperties = {};
+    refCount = 1;
+  }
+
   template <EDirectInputVersion diVersion> void
       VirtualDirectInputDeviceBase<diVersion>::ElementToString(
           Controller::SElementIdentifier element,
@@ -1024,6 +1301,30 @@ namespace Xidi
     return (nullptr != ForceFeedbackEffectObjectCreator<diVersion>(rguidEffect));
   }
 
+  template <EDirectInputVersion diVersion> VirtualDirectInputEffect<diVersion>*
+      VirtualDirectInputDeviceBase<diVersion>::ForceFeedbackEffectPoolTake(REFGUID rguidEffect)
+  {
+    auto effectPoolIt = effectPool.find(rguidEffect);
+    if ((effectPool.end() == effectPoolIt) || (true == effectPoolIt->second.empty()))
+      return nullptr;
+
+    VirtualDirectInputEffect<diVersion>* const pooledEffectObject = effectPoolIt->second.back();
+    effectPoolIt->second.pop_back();
+    return pooledEffectObject;
+  }
+
+  template <EDirectInputVersion diVersion> bool
+      VirtualDirectInputDeviceBase<diVersion>::ForceFeedbackEffectPoolReturn(
+          REFGUID rguidEffect, VirtualDirectInputEffect<diVersion>* effectObject)
+  {
+    std::vector<VirtualDirectInputEffect<diVersion>*>& pooledEffectObjects =
+        effectPool[rguidEffect];
+    if (pooledEffectObjects.size() >= kForceFeedbackEffectPoolCapacityPerGuid) return false;
+
+    pooledEffectObjects.push_back(effectObject);
+    return true;
+  }
+
   template <EDirectInputVersion diVersion> Controller::ForceFeedback::Device*
       VirtualDirectInputDeviceBase<diVersion>::AutoAcquireAndGetForceFeedbackDevice(void)
   {
@@ -1064,9 +1365,8 @@ namespace Xidi
 
       case DIPH_BYID:
         // Controller element is being identified by instance identifier.
-        // Object identifier contains type and index, and the latter refers to the controller's
-        // reported capabilities.
-        if ((unsigned int)DIDFT_GETINSTANCE(dwObj) >= 0)
+        // Object identifier contains type and index, and the latter indexes a lookup table that
+        // was built from the controller's reported capabilities.
         {
           const unsigned int kType = (unsigned int)DIDFT_GETTYPE(dwObj);
           const unsigned int kIndex = (unsigned int)DIDFT_GETINSTANCE(dwObj);
@@ -1074,24 +1374,17 @@ namespace Xidi
           switch (kType)
           {
             case DIDFT_ABSAXIS:
-              if ((kIndex < (unsigned int)Controller::EAxis::Count) &&
-                  (kIndex < (unsigned int)controller->GetCapabilities().numAxes))
-                return Controller::SElementIdentifier(
-                    {.type = Controller::EElementType::Axis,
-                     .axis = controller->GetCapabilities().axisCapabilities[kIndex].type});
+              if (kIndex < (unsigned int)Controller::EAxis::Count)
+                return elementIdentificationTables.axisElementByInstance[kIndex];
               break;
 
             case DIDFT_PSHBUTTON:
-              if ((kIndex < (unsigned int)Controller::EButton::Count) &&
-                  (kIndex < (unsigned int)controller->GetCapabilities().numButtons))
-                return Controller::SElementIdentifier(
-                    {.type = Controller::EElementType::Button,
-                     .button = (Controller::EButton)kIndex});
+              if (kIndex < (unsigned int)Controller::EButton::Count)
+                return elementIdentificationTables.buttonElementByInstance[kIndex];
               break;
 
             case DIDFT_POV:
-              if (kIndex == 0)
-                return Controller::SElementIdentifier({.type = Controller::EElementType::Pov});
+              if (kIndex == 0) return elementIdentificationTables.povElement;
               break;
           }
         }
@@ -1100,21 +1393,14 @@ namespace Xidi
       case DIPH_BYUSAGE:
         // Controller element is being identified by HID usage data.
         // The HID specification defines a fixed mapping between this information and controller
-        // elements. If the identified controller element exists on this virtual controller then the
-        // usage-based identification succeeds.
+        // elements, and the lookup table contains an entry for each element present on this
+        // virtual controller, keyed by the packed usage page and usage encoding of the object
+        // identifier.
         {
-          const uint16_t hidUsage = (uint16_t)((dwObj >> 0) & 0x0000ffff);
-          const uint16_t hidUsagePage = (uint16_t)((dwObj >> 16) & 0x0000ffff);
-
-          const std::optional<Controller::SElementIdentifier> maybeControllerElement =
-              ControllerElementFromHidUsageData({.usagePage = hidUsagePage, .usage = hidUsage});
-
-          if (true == maybeControllerElement.has_value())
-          {
-            const Controller::SElementIdentifier controllerElement = maybeControllerElement.value();
-            if (controller->GetCapabilities().HasElement(controllerElement))
-              return controllerElement;
-          }
+          const auto elementIter =
+              elementIdentificationTables.elementByHidUsageData.find(dwObj);
+          if (elementIdentificationTables.elementByHidUsageData.cend() != elementIter)
+            return elementIter->second;
           break;
         }
     }
@@ -1141,6 +1427,106 @@ namespace Xidi
     return std::nullopt;
   }
 
+  template <EDirectInputVersion diVersion> void
+      VirtualDirectInputDeviceBase<diVersion>::PrewarmStateReadPath(void)
+  {
+    if (false == IsApplicationDataFormatSet()) return;
+
+    std::vector<uint8_t> prewarmPacketBuffer(dataFormat->GetPacketSizeBytes());
+
+    auto lock = controller->Lock();
+
+    uint32_t stateVersion = 0;
+    const Controller::SState controllerState = controller->GetState(stateVersion);
+
+    // One full mapping pass and data packet write exercises the same code and touches the same
+    // memory that the first application state read would otherwise hit cold. The result seeds the
+    // cached state packet, so if the controller state is unchanged by the time the application
+    // issues its first read, that read takes the differential fast path and skips the mapping
+    // pass entirely. The buffer is sized exactly to the declared data packet and every byte of it
+    // is defined by WriteDataPacket, so the seeded cache obeys the same invariant GetDeviceState
+    // establishes when it caches a packet itself.
+    if (true ==
+        dataFormat->WriteDataPacket(
+            prewarmPacketBuffer.data(), (TOffset)prewarmPacketBuffer.size(), controllerState))
+    {
+      cachedStatePacket.assign(prewarmPacketBuffer.cbegin(), prewarmPacketBuffer.cend());
+      cachedStatePacketVersion = stateVersion;
+    }
+  }
+
+  template <EDirectInputVersion diVersion> void
+      VirtualDirectInputDeviceBase<diVersion>::RefreshCachedObjectEnumerationTable(void)
+  {
+    if (false == cachedObjectEnumerationTable.empty()) return;
+
+    const Controller::SCapabilities controllerCapabilities = controller->GetCapabilities();
+
+    for (int i = 0; i < controllerCapabilities.numAxes; ++i)
+    {
+      const Controller::EAxis axis = controllerCapabilities.axisCapabilities[i].type;
+      const Controller::SElementIdentifier axisIdentifier = {
+          .type = Controller::EElementType::Axis, .axis = axis};
+      const TOffset axisOffset =
+          ((true == IsApplicationDataFormatSet())
+               ? dataFormat->GetOffsetForElement(axisIdentifier)
+                     .value_or(DataFormat::kInvalidOffsetValue)
+               : NativeOffsetForElement(axisIdentifier));
+
+      typename DirectInputTypes<diVersion>::DeviceObjectInstanceType& objectDescriptor =
+          cachedObjectEnumerationTable.emplace_back();
+      objectDescriptor = {.dwSize = sizeof(objectDescriptor)};
+      FillObjectInstanceInfo<diVersion>(
+          controllerCapabilities, axisIdentifier, axisOffset, &objectDescriptor);
+    }
+
+    for (int i = 0; i < controllerCapabilities.numButtons; ++i)
+    {
+      const Controller::EButton button = (Controller::EButton)i;
+      const Controller::SElementIdentifier buttonIdentifier = {
+          .type = Controller::EElementType::Button, .button = button};
+      const TOffset buttonOffset =
+          ((true == IsApplicationDataFormatSet())
+               ? dataFormat->GetOffsetForElement(buttonIdentifier)
+                     .value_or(DataFormat::kInvalidOffsetValue)
+               : NativeOffsetForElement(buttonIdentifier));
+
+      typename DirectInputTypes<diVersion>::DeviceObjectInstanceType& objectDescriptor =
+          cachedObjectEnumerationTable.emplace_back();
+      objectDescriptor = {.dwSize = sizeof(objectDescriptor)};
+      FillObjectInstanceInfo<diVersion>(
+          controllerCapabilities, buttonIdentifier, buttonOffset, &objectDescriptor);
+    }
+
+    if (true == controllerCapabilities.HasPov())
+    {
+      const Controller::SElementIdentifier povIdentifier = {.type = Controller::EElementType::Pov};
+      const TOffset povOffset =
+          ((true == IsApplicationDataFormatSet())
+               ? dataFormat->GetOffsetForElement(povIdentifier)
+                     .value_or(DataFormat::kInvalidOffsetValue)
+               : NativeOffsetForElement(povIdentifier));
+
+      typename DirectInputTypes<diVersion>::DeviceObjectInstanceType& objectDescriptor =
+          cachedObjectEnumerationTable.emplace_back();
+      objectDescriptor = {.dwSize = sizeof(objectDescriptor)};
+      FillObjectInstanceInfo<diVersion>(
+          controllerCapabilities, povIdentifier, povOffset, &objectDescriptor);
+    }
+
+    constexpr uint16_t kHidCollectionsToEnumerate[] = {
+        kVirtualControllerHidCollectionForEntireDevice,
+        kVirtualControllerHidCollectionForIndividualElements};
+
+    for (const auto hidCollectionNumber : kHidCollectionsToEnumerate)
+    {
+      typename DirectInputTypes<diVersion>::DeviceObjectInstanceType& objectDescriptor =
+          cachedObjectEnumerationTable.emplace_back();
+      objectDescriptor = {.dwSize = sizeof(objectDescriptor)};
+      FillHidCollectionInstanceInfo<diVersion>(hidCollectionNumber, &objectDescriptor);
+    }
+  }
+
   template <EDirectInputVersion diVersion> HRESULT
       VirtualDirectInputDeviceBase<diVersion>::QueryInterface(REFIID riid, LPVOID* ppvObj)
   {
@@ -1167,7 +1553,29 @@ namespace Xidi
   {
     const unsigned long numRemainingRefs = --refCount;
 
-    if (0 == numRemainingRefs) delete this;
+    if (0 == numRemainingRefs)
+    {
+      // Fully-released device interface objects are reset and offered back to the device object
+      // pool so that a future request to open the same virtual controller can reuse them. Only if
+      // the pool slot for the associated virtual controller is already occupied is the object
+      // actually destroyed.
+      const Controller::TControllerIdentifier controllerId = controller->GetIdentifier();
+      bool pooledThisObject = false;
+
+      if (controllerId < Controller::kPhysicalControllerCount)
+      {
+        PrepareForReuse();
+
+        std::scoped_lock lock(devicePoolGuard);
+        if (nullptr == devicePool<diVersion>[controllerId])
+        {
+          devicePool<diVersion>[controllerId] = this;
+          pooledThisObject = true;
+        }
+      }
+
+      if (false == pooledThisObject) delete this;
+    }
 
     return (ULONG)numRemainingRefs;
   }
@@ -1177,11 +1585,21 @@ namespace Xidi
   {
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::Info;
 
+    FlightRecorder::Record(
+        FlightRecorder::EEvent::DeviceAcquire,
+        controller->GetIdentifier(),
+        (uint32_t)cooperativeLevel);
+
     // DirectInput documentation requires that the application data format already be set before a
     // device can be acquired.
     if (false == IsApplicationDataFormatSet())
       LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, Infra::Message::ESeverity::Warning);
 
+    // Priming the read path here moves the cold-start costs of the first state read into
+    // acquisition itself, so the application's first input frame after acquiring runs at
+    // steady-state latency.
+    PrewarmStateReadPath();
+
     switch (cooperativeLevel)
     {
       case ECooperativeLevel::Exclusive:
@@ -1238,8 +1656,15 @@ namespace Xidi
         L"Creating effect with GUID %s.",
         ForceFeedbackEffectGuidString(rguid));
 
-    std::unique_ptr<VirtualDirectInputEffect<diVersion>> newEffect =
-        ForceFeedbackEffectCreateObject<diVersion>(rguid, *this);
+    // A pooled effect object from a previous create-and-release cycle is preferred over a new
+    // allocation, in which case construction reduces to reattaching the object and resetting its
+    // parameters back to defaults.
+    std::unique_ptr<VirtualDirectInputEffect<diVersion>> newEffect(
+        ForceFeedbackEffectPoolTake(rguid));
+    if (nullptr != newEffect)
+      newEffect->PrepareForReuse();
+    else
+      newEffect = ForceFeedbackEffectCreateObject<diVersion>(rguid, *this);
     if (nullptr == newEffect) LOG_INVOCATION_AND_RETURN(DIERR_DEVICENOTREG, kMethodSeverity);
 
     if (nullptr != lpeff)
@@ -1336,120 +1761,25 @@ namespace Xidi
       LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
     }
 
-    const bool willEnumerateConstantForce =
-        ((DIEFT_ALL == dwEffType) || (DIEFT_CONSTANTFORCE == DIEFT_GETTYPE(dwEffType)));
-    const bool willEnumerateRampForce =
-        ((DIEFT_ALL == dwEffType) || (DIEFT_RAMPFORCE == DIEFT_GETTYPE(dwEffType)));
-    const bool willEnumeratePeriodic =
-        ((DIEFT_ALL == dwEffType) || (DIEFT_PERIODIC == DIEFT_GETTYPE(dwEffType)));
-    const bool willEnumerateCustomForce =
-        ((DIEFT_ALL == dwEffType) || (DIEFT_CUSTOMFORCE == DIEFT_GETTYPE(dwEffType)));
-
-    if ((true == willEnumerateConstantForce) || (true == willEnumerateCustomForce) ||
-        (true == willEnumeratePeriodic) || (true == willEnumerateRampForce))
+    // The effect information table is pre-populated in enumeration order, so enumeration is a
+    // walk over it that filters by requested effect category and skips effects for which no
+    // object can be constructed.
+    for (const auto& effectRecord : ForceFeedbackEffectInfoTable<diVersion>())
     {
-      std::unique_ptr<DirectInputTypes<diVersion>::EffectInfoType> effectDescriptor =
-          std::make_unique<DirectInputTypes<diVersion>::EffectInfoType>();
-
-      if (true == willEnumerateConstantForce)
-      {
-        const GUID* kEffectGuids[] = {&GUID_ConstantForce};
-        for (const auto effectGuid : kEffectGuids)
-        {
-          if (true == ForceFeedbackEffectCanCreateObject(*effectGuid))
-          {
-            *effectDescriptor = {
-                .dwSize = sizeof(*effectDescriptor),
-                .guid = *effectGuid,
-                .dwEffType = ForceFeedbackEffectType(*effectGuid).value()};
-            FillForceFeedbackEffectInfo<diVersion>(effectDescriptor.get());
-            switch (lpCallback(effectDescriptor.get(), pvRef))
-            {
-              case DIENUM_CONTINUE:
-                break;
-              case DIENUM_STOP:
-                LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-              default:
-                LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
-            }
-          }
-        }
-      }
-
-      if (true == willEnumerateRampForce)
-      {
-        const GUID* kEffectGuids[] = {&GUID_RampForce};
-        for (const auto effectGuid : kEffectGuids)
-        {
-          if (true == ForceFeedbackEffectCanCreateObject(*effectGuid))
-          {
-            *effectDescriptor = {
-                .dwSize = sizeof(*effectDescriptor),
-                .guid = *effectGuid,
-                .dwEffType = ForceFeedbackEffectType(*effectGuid).value()};
-            FillForceFeedbackEffectInfo<diVersion>(effectDescriptor.get());
-            switch (lpCallback(effectDescriptor.get(), pvRef))
-            {
-              case DIENUM_CONTINUE:
-                break;
-              case DIENUM_STOP:
-                LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-              default:
-                LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
-            }
-          }
-        }
-      }
+      if (false == effectRecord.canCreateObject) continue;
 
-      if (true == willEnumeratePeriodic)
-      {
-        const GUID* kEffectGuids[] = {
-            &GUID_Square, &GUID_Sine, &GUID_Triangle, &GUID_SawtoothUp, &GUID_SawtoothDown};
-        for (const auto effectGuid : kEffectGuids)
-        {
-          if (true == ForceFeedbackEffectCanCreateObject(*effectGuid))
-          {
-            *effectDescriptor = {
-                .dwSize = sizeof(*effectDescriptor),
-                .guid = *effectGuid,
-                .dwEffType = ForceFeedbackEffectType(*effectGuid).value()};
-            FillForceFeedbackEffectInfo<diVersion>(effectDescriptor.get());
-            switch (lpCallback(effectDescriptor.get(), pvRef))
-            {
-              case DIENUM_CONTINUE:
-                break;
-              case DIENUM_STOP:
-                LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-              default:
-                LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
-            }
-          }
-        }
-      }
+      if ((DIEFT_ALL != dwEffType) &&
+          (DIEFT_GETTYPE(effectRecord.effectInfo.dwEffType) != DIEFT_GETTYPE(dwEffType)))
+        continue;
 
-      if (true == willEnumerateCustomForce)
+      switch (lpCallback(&effectRecord.effectInfo, pvRef))
       {
-        const GUID* kEffectGuids[] = {&GUID_CustomForce};
-        for (const auto effectGuid : kEffectGuids)
-        {
-          if (true == ForceFeedbackEffectCanCreateObject(*effectGuid))
-          {
-            *effectDescriptor = {
-                .dwSize = sizeof(*effectDescriptor),
-                .guid = *effectGuid,
-                .dwEffType = ForceFeedbackEffectType(*effectGuid).value()};
-            FillForceFeedbackEffectInfo<diVersion>(effectDescriptor.get());
-            switch (lpCallback(effectDescriptor.get(), pvRef))
-            {
-              case DIENUM_CONTINUE:
-                break;
-              case DIENUM_STOP:
-                LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-              default:
-                LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
-            }
-          }
-        }
+        case DIENUM_CONTINUE:
+          break;
+        case DIENUM_STOP:
+          LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
+        default:
+          LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
       }
     }
 
@@ -1475,7 +1805,7 @@ namespace Xidi
   {
     static const bool kAlwaysContinueEnumerating =
         Globals::GetConfigurationData()
-            [Strings::kStrConfigurationSectionWorkarounds]
+            [Globals::ApplicableConfigurationSection(Strings::kStrConfigurationSectionWorkarounds)]
             [Strings::kStrConfigurationSettingsWorkaroundsIgnoreEnumObjectsCallbackReturnCode]
                 .ValueOr(false);
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::Info;
@@ -1503,101 +1833,41 @@ namespace Xidi
     if ((true == willEnumerateAxes) || (true == willEnumerateButtons) ||
         (true == willEnumeratePov) || (true == willEnumerateHidCollections))
     {
+      // Object instance information depends only on virtual controller capabilities and the
+      // application's data format, so the full table of enumerable objects is generated once and
+      // cached. Filter flags vary from call to call and so are applied on each enumeration pass.
+      RefreshCachedObjectEnumerationTable();
+
+      // Applications receive a pointer to a scratch copy of each cached structure, rather than a
+      // pointer into the cache itself, so that a misbehaving callback cannot corrupt the cache.
       std::unique_ptr<DirectInputTypes<diVersion>::DeviceObjectInstanceType> objectDescriptor =
           std::make_unique<DirectInputTypes<diVersion>::DeviceObjectInstanceType>();
-      const Controller::SCapabilities controllerCapabilities = controller->GetCapabilities();
-
-      if (true == willEnumerateAxes)
-      {
-        for (int i = 0; i < controllerCapabilities.numAxes; ++i)
-        {
-          if ((true == forceFeedbackActuatorsOnly) &&
-              (false == controllerCapabilities.axisCapabilities[i].supportsForceFeedback))
-            continue;
-
-          const Controller::EAxis axis = controllerCapabilities.axisCapabilities[i].type;
-          const Controller::SElementIdentifier axisIdentifier = {
-              .type = Controller::EElementType::Axis, .axis = axis};
-          const TOffset axisOffset =
-              ((true == IsApplicationDataFormatSet())
-                   ? dataFormat->GetOffsetForElement(axisIdentifier)
-                         .value_or(DataFormat::kInvalidOffsetValue)
-                   : NativeOffsetForElement(axisIdentifier));
-
-          *objectDescriptor = {.dwSize = sizeof(*objectDescriptor)};
-          FillObjectInstanceInfo<diVersion>(
-              controllerCapabilities, axisIdentifier, axisOffset, objectDescriptor.get());
-
-          const bool continueEnumerating =
-              (DIENUM_STOP != lpCallback(objectDescriptor.get(), pvRef));
-          if (!kAlwaysContinueEnumerating && !continueEnumerating)
-            LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-        }
-      }
-
-      if (true == willEnumerateButtons)
-      {
-        for (int i = 0; i < controllerCapabilities.numButtons; ++i)
-        {
-          const Controller::EButton button = (Controller::EButton)i;
-          const Controller::SElementIdentifier buttonIdentifier = {
-              .type = Controller::EElementType::Button, .button = button};
-          const TOffset buttonOffset =
-              ((true == IsApplicationDataFormatSet())
-                   ? dataFormat->GetOffsetForElement(buttonIdentifier)
-                         .value_or(DataFormat::kInvalidOffsetValue)
-                   : NativeOffsetForElement(buttonIdentifier));
-
-          *objectDescriptor = {.dwSize = sizeof(*objectDescriptor)};
-          FillObjectInstanceInfo<diVersion>(
-              controllerCapabilities, buttonIdentifier, buttonOffset, objectDescriptor.get());
-
-          const bool continueEnumerating =
-              (DIENUM_STOP != lpCallback(objectDescriptor.get(), pvRef));
-          if (!kAlwaysContinueEnumerating && !continueEnumerating)
-            LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-        }
-      }
-
-      if (true == willEnumeratePov)
-      {
-        if (true == controllerCapabilities.HasPov())
-        {
-          const Controller::SElementIdentifier povIdentifier = {
-              .type = Controller::EElementType::Pov};
-          const TOffset povOffset =
-              ((true == IsApplicationDataFormatSet())
-                   ? dataFormat->GetOffsetForElement(povIdentifier)
-                         .value_or(DataFormat::kInvalidOffsetValue)
-                   : NativeOffsetForElement(povIdentifier));
-
-          *objectDescriptor = {.dwSize = sizeof(*objectDescriptor)};
-          FillObjectInstanceInfo<diVersion>(
-              controllerCapabilities, povIdentifier, povOffset, objectDescriptor.get());
-
-          const bool continueEnumerating =
-              (DIENUM_STOP != lpCallback(objectDescriptor.get(), pvRef));
-          if (!kAlwaysContinueEnumerating && !continueEnumerating)
-            LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-        }
-      }
 
-      if (true == willEnumerateHidCollections)
+      for (const auto& cachedObjectDescriptor : cachedObjectEnumerationTable)
       {
-        constexpr uint16_t kHidCollectionsToEnumerate[] = {
-            kVirtualControllerHidCollectionForEntireDevice,
-            kVirtualControllerHidCollectionForIndividualElements};
-
-        for (const auto hidCollectionNumber : kHidCollectionsToEnumerate)
-        {
-          *objectDescriptor = {.dwSize = sizeof(*objectDescriptor)};
-          FillHidCollectionInstanceInfo<diVersion>(hidCollectionNumber, objectDescriptor.get());
-
-          const bool continueEnumerating =
-              (DIENUM_STOP != lpCallback(objectDescriptor.get(), pvRef));
-          if (!kAlwaysContinueEnumerating && !continueEnumerating)
-            LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
-        }
+        // Object class is identified by the type byte of the object identifier, and force
+        // feedback actuator capability by its attribute bits, exactly as applications would
+        // themselves decode the identifier.
+        bool willEnumerateObject = false;
+        if (0 != (cachedObjectDescriptor.dwType & DIDFT_ABSAXIS))
+          willEnumerateObject =
+              ((true == willEnumerateAxes) &&
+               ((false == forceFeedbackActuatorsOnly) ||
+                (0 != (cachedObjectDescriptor.dwType & DIDFT_FFACTUATOR))));
+        else if (0 != (cachedObjectDescriptor.dwType & DIDFT_PSHBUTTON))
+          willEnumerateObject = willEnumerateButtons;
+        else if (0 != (cachedObjectDescriptor.dwType & DIDFT_POV))
+          willEnumerateObject = willEnumeratePov;
+        else if (0 != (cachedObjectDescriptor.dwType & DIDFT_COLLECTION))
+          willEnumerateObject = willEnumerateHidCollections;
+
+        if (false == willEnumerateObject) continue;
+
+        *objectDescriptor = cachedObjectDescriptor;
+
+        const bool continueEnumerating = (DIENUM_STOP != lpCallback(objectDescriptor.get(), pvRef));
+        if (!kAlwaysContinueEnumerating && !continueEnumerating)
+          LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
       }
     }
 
@@ -1657,9 +1927,12 @@ namespace Xidi
               (DIDC_FORCEFEEDBACK | DIDC_FFFADE | DIDC_FFATTACK | DIDC_STARTDELAY);
 
         // Information about controller layout comes from controller capabilities.
-        lpDIDevCaps->dwAxes = controller->GetCapabilities().numAxes;
-        lpDIDevCaps->dwButtons = controller->GetCapabilities().numButtons;
-        lpDIDevCaps->dwPOVs = ((true == controller->GetCapabilities().HasPov()) ? 1 : 0);
+        {
+          const Controller::SCapabilities controllerCapabilities = controller->GetCapabilities();
+          lpDIDevCaps->dwAxes = controllerCapabilities.numAxes;
+          lpDIDevCaps->dwButtons = controllerCapabilities.numButtons;
+          lpDIDevCaps->dwPOVs = ((true == controllerCapabilities.HasPov()) ? 1 : 0);
+        }
         break;
 
       default:
@@ -1676,13 +1949,21 @@ namespace Xidi
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::SuperDebug;
     constexpr Infra::Message::ESeverity kMethodSeverityForError = Infra::Message::ESeverity::Info;
 
+    const EventTrace::ScopedDeviceDataTrace deviceDataTrace(controller->GetIdentifier());
+
+    FlightRecorder::Record(
+        FlightRecorder::EEvent::DeviceGetDeviceData,
+        controller->GetIdentifier(),
+        ((nullptr != pdwInOut) ? (uint32_t)*pdwInOut : 0),
+        (uint32_t)dwFlags);
+
     // DIDEVICEOBJECTDATA and DIDEVICEOBJECTDATA_DX3 are defined identically for all DirectInput
     // versions below 8. There is therefore no need to differentiate, as the distinction between
     // "dinput" and "dinput8" takes care of it.
 
     if ((false == IsApplicationDataFormatSet()) || (nullptr == pdwInOut) ||
         (sizeof(DIDEVICEOBJECTDATA) != cbObjectData))
-      LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverityForError);
+      LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverityForError);
 
     switch (dwFlags)
     {
@@ -1691,11 +1972,11 @@ namespace Xidi
         break;
 
       default:
-        LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverityForError);
+        LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverityForError);
     }
 
     if (false == controller->IsEventBufferEnabled())
-      LOG_INVOCATION_AND_RETURN(DIERR_NOTBUFFERED, kMethodSeverityForError);
+      LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_NOTBUFFERED, kMethodSeverityForError);
 
     auto lock = controller->Lock();
     const DWORD numEventsAffected = std::min(*pdwInOut, (DWORD)controller->GetEventBufferCount());
@@ -1704,42 +1985,28 @@ namespace Xidi
 
     if (nullptr != rgdod)
     {
-      for (DWORD i = 0; i < numEventsAffected; ++i)
-      {
-        const Controller::StateChangeEventBuffer::SEvent& event =
-            controller->GetEventBufferEvent(i);
-        ZeroMemory(&rgdod[i], sizeof(rgdod[i]));
-        rgdod[i].dwOfs = dataFormat->GetOffsetForElement(event.data.element)
-                             .value(); // A value should always be present.
-        rgdod[i].dwTimeStamp = event.timestamp;
-        rgdod[i].dwSequence = event.sequence;
-
-        switch (event.data.element.type)
-        {
-          case Controller::EElementType::Axis:
-            rgdod[i].dwData = (DWORD)DataFormat::DirectInputAxisValue(event.data.value.axis);
-            break;
-
-          case Controller::EElementType::Button:
-            rgdod[i].dwData = (DWORD)DataFormat::DirectInputButtonValue(event.data.value.button);
-            break;
+      // Events are exposed as at most two contiguous pieces of the underlying ring buffer, so the
+      // whole batch is translated in a single pass without any per-event accessor calls.
+      const Controller::StateChangeEventBuffer::SEventSpans eventSpans =
+          controller->GetEventBufferEvents((uint32_t)numEventsAffected);
+      DWORD i = 0;
 
-          case Controller::EElementType::Pov:
-            rgdod[i].dwData = (DWORD)DataFormat::DirectInputPovValue(event.data.value.povDirection);
-            break;
+      for (const auto& eventSpan : {eventSpans.first, eventSpans.second})
+      {
+        // Each piece is handed to the bulk translation kernel, which resolves offsets from the
+        // data format's precomputed per-element arrays. Translation only fails on an event whose
+        // element is absent from the data format, which the event filter is supposed to prevent.
+        if (false == dataFormat->TranslateStateChangeEvents(eventSpan, &rgdod[i]))
+          LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_GENERIC, kMethodSeverityForError);
 
-          default:
-            LOG_INVOCATION_AND_RETURN(
-                DIERR_GENERIC, kMethodSeverityForError); // This should never happen.
-            break;
-        }
+        i += (DWORD)eventSpan.size();
       }
     }
 
     if (true == shouldPopEvents) controller->PopEventBufferOldestEvents(numEventsAffected);
 
     *pdwInOut = numEventsAffected;
-    LOG_INVOCATION_AND_RETURN(
+    LOG_HOT_PATH_INVOCATION_AND_RETURN(
         ((true == eventBufferOverflowed) ? DI_BUFFEROVERFLOW : DI_OK), kMethodSeverity);
   }
 
@@ -1761,7 +2028,12 @@ namespace Xidi
         LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
     }
 
-    FillVirtualControllerInfo<diVersion>(*pdidi, controller->GetIdentifier());
+    // The compatibility version of the structure is a prefix of the full version, so both
+    // requests are served by copying the requested number of bytes from the cached structure and
+    // restoring the application-specified size member.
+    const DWORD requestedSize = pdidi->dwSize;
+    CopyMemory(pdidi, &cachedDeviceInstanceInfo, requestedSize);
+    pdidi->dwSize = requestedSize;
     LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
   }
 
@@ -1771,16 +2043,52 @@ namespace Xidi
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::SuperDebug;
     constexpr Infra::Message::ESeverity kMethodSeverityForError = Infra::Message::ESeverity::Info;
 
+    const EventTrace::ScopedDeviceStateTrace deviceStateTrace(controller->GetIdentifier());
+
+    FlightRecorder::Record(
+        FlightRecorder::EEvent::DeviceGetDeviceState, controller->GetIdentifier(), (uint32_t)cbData);
+
     if ((nullptr == lpvData) || (false == IsApplicationDataFormatSet()) ||
         (cbData < dataFormat->GetPacketSizeBytes()))
-      LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverityForError);
+      LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverityForError);
 
     bool writeDataPacketResult = false;
     {
       auto lock = controller->Lock();
-      writeDataPacketResult = dataFormat->WriteDataPacket(lpvData, cbData, controller->GetState());
+
+      uint32_t stateVersion = 0;
+      const Controller::SState controllerState = controller->GetState(stateVersion);
+
+      if ((false == cachedStatePacket.empty()) && (stateVersion == cachedStatePacketVersion))
+      {
+        // Differential fast path: the virtual controller state is unchanged since the packet was
+        // last produced, so the cached packet is still valid and the mapping pass can be skipped.
+        // The cached packet holds the declared data packet exactly as WriteDataPacket defines it,
+        // and WriteDataPacket zeroes any extra buffer space beyond the declared packet, so doing
+        // the same here makes this path byte-identical to the full path for any given buffer size.
+        CopyMemory(lpvData, cachedStatePacket.data(), cachedStatePacket.size());
+        if (cbData > cachedStatePacket.size())
+          ZeroMemory(
+              &((uint8_t*)lpvData)[cachedStatePacket.size()],
+              (cbData - cachedStatePacket.size()));
+
+        writeDataPacketResult = true;
+      }
+      else
+      {
+        writeDataPacketResult = dataFormat->WriteDataPacket(lpvData, cbData, controllerState);
+
+        if (true == writeDataPacketResult)
+        {
+          // Cache exactly the declared data packet, every byte of which WriteDataPacket just
+          // defined, establishing the invariant the fast path above relies upon.
+          cachedStatePacket.assign(
+              (uint8_t*)lpvData, &((uint8_t*)lpvData)[dataFormat->GetPacketSizeBytes()]);
+          cachedStatePacketVersion = stateVersion;
+        }
+      }
     }
-    LOG_INVOCATION_AND_RETURN(
+    LOG_HOT_PATH_INVOCATION_AND_RETURN(
         ((true == writeDataPacketResult) ? DI_OK : DIERR_INVALIDPARAM), kMethodSeverity);
   }
 
@@ -1804,15 +2112,18 @@ namespace Xidi
     if (sizeof(*pdei) != pdei->dwSize)
       LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
 
-    const std::optional<DWORD> maybeEffectType = ForceFeedbackEffectType(rguid);
-    if (false == maybeEffectType.has_value())
-      LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
-
-    const DWORD effectType = maybeEffectType.value();
-    *pdei = {.dwSize = sizeof(*pdei), .guid = rguid, .dwEffType = effectType};
-    FillForceFeedbackEffectInfo<diVersion>(pdei);
+    // Recognized effects, including those that are recognized but not constructible, are served
+    // directly from the pre-populated effect information table.
+    for (const auto& effectRecord : ForceFeedbackEffectInfoTable<diVersion>())
+    {
+      if (rguid == effectRecord.effectInfo.guid)
+      {
+        *pdei = effectRecord.effectInfo;
+        LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
+      }
+    }
 
-    LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
+    LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
   }
 
   template <EDirectInputVersion diVersion> HRESULT
@@ -1822,18 +2133,18 @@ namespace Xidi
 
     if (false == controller->GetCapabilities().ForceFeedbackIsSupported())
     {
-      Infra::Message::OutputFormatted(
+      XIDI_RATE_LIMITED_OUTPUT_FORMATTED(
           Infra::Message::ESeverity::Warning,
           L"Application is attempting to get force feedback state on Xidi virtual controller %u which does not support force feedback.",
           (1 + controller->GetIdentifier()));
-      LOG_INVOCATION_AND_RETURN(DIERR_UNSUPPORTED, kMethodSeverity);
+      LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_UNSUPPORTED, kMethodSeverity);
     }
 
     if (nullptr == pdwOut) LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
 
     Controller::ForceFeedback::Device* forceFeedbackDevice = AutoAcquireAndGetForceFeedbackDevice();
     if (nullptr == forceFeedbackDevice)
-      LOG_INVOCATION_AND_RETURN(DIERR_NOTEXCLUSIVEACQUIRED, kMethodSeverity);
+      LOG_RATE_LIMITED_INVOCATION_AND_RETURN(DIERR_NOTEXCLUSIVEACQUIRED, kMethodSeverity);
 
     DWORD forceFeedbackDeviceState = DIGFFS_POWERON;
 
@@ -1897,8 +2208,54 @@ namespace Xidi
     if (Controller::EElementType::WholeController == element.type)
       LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
 
+    // Object instance information is served from the same cached table that EnumObjects uses,
+    // whose entries are ordered axes first, then buttons, then the POV. As with GetDeviceInfo,
+    // the compatibility version of the structure is a prefix of the full version, so a copy of
+    // the requested number of bytes covers both.
+    RefreshCachedObjectEnumerationTable();
+
+    const Controller::SCapabilities controllerCapabilities = controller->GetCapabilities();
+    std::optional<size_t> maybeObjectIndex;
+
+    switch (element.type)
+    {
+      case Controller::EElementType::Axis:
+      {
+        const int axisIndex = controllerCapabilities.FindAxis(element.axis);
+        if (axisIndex >= 0) maybeObjectIndex = (size_t)axisIndex;
+        break;
+      }
+
+      case Controller::EElementType::Button:
+        if (true == controllerCapabilities.HasButton(element.button))
+          maybeObjectIndex =
+              ((size_t)controllerCapabilities.numAxes + (size_t)element.button);
+        break;
+
+      case Controller::EElementType::Pov:
+        if (true == controllerCapabilities.HasPov())
+          maybeObjectIndex =
+              ((size_t)controllerCapabilities.numAxes + (size_t)controllerCapabilities.numButtons);
+        break;
+
+      default:
+        break;
+    }
+
+    if (true == maybeObjectIndex.has_value())
+    {
+      const DWORD requestedSize = pdidoi->dwSize;
+      CopyMemory(
+          pdidoi, &cachedObjectEnumerationTable[maybeObjectIndex.value()], requestedSize);
+      pdidoi->dwSize = requestedSize;
+      LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
+    }
+
+    // Identification can succeed for an element the controller does not actually have, such as
+    // the POV being identified by instance identifier on a controller without one. Such elements
+    // have no cached table entry and fall back to being filled directly.
     FillObjectInstanceInfo<diVersion>(
-        controller->GetCapabilities(),
+        controllerCapabilities,
         element,
         ((true == IsApplicationDataFormatSet())
              ? dataFormat->GetOffsetForElement(element).value_or(DataFormat::kInvalidOffsetValue)
@@ -1935,7 +2292,7 @@ namespace Xidi
         LOG_PROPERTY_INVOCATION_DIPROPDWORD_AND_RETURN(DI_OK, kMethodSeverity, rguidProp, pdiph);
 
       case ((size_t)&DIPROP_BUFFERSIZE):
-        ((LPDIPROPDWORD)pdiph)->dwData = controller->GetEventBufferCapacity();
+        ((LPDIPROPDWORD)pdiph)->dwData = propertyValueShadow.eventBufferCapacity;
         LOG_PROPERTY_INVOCATION_DIPROPDWORD_AND_RETURN(DI_OK, kMethodSeverity, rguidProp, pdiph);
 
       case ((size_t)&DIPROP_CALIBRATIONMODE):
@@ -1952,7 +2309,7 @@ namespace Xidi
         if (Controller::EElementType::Axis != element.type)
           LOG_PROPERTY_INVOCATION_NO_VALUE_AND_RETURN(
               DIERR_INVALIDPARAM, kMethodSeverity, rguidProp);
-        ((LPDIPROPDWORD)pdiph)->dwData = controller->GetAxisDeadzone(element.axis);
+        ((LPDIPROPDWORD)pdiph)->dwData = propertyValueShadow.axisDeadzone[(int)element.axis];
         LOG_PROPERTY_INVOCATION_DIPROPDWORD_AND_RETURN(DI_OK, kMethodSeverity, rguidProp, pdiph);
 
       case ((size_t)&DIPROP_FFGAIN):
@@ -2011,10 +2368,11 @@ namespace Xidi
 
       case ((size_t)&DIPROP_INSTANCENAME):
       case ((size_t)&DIPROP_PRODUCTNAME):
-        FillVirtualControllerName(
+        wcsncpy_s(
             ((LPDIPROPSTRING)pdiph)->wsz,
             _countof(((LPDIPROPSTRING)pdiph)->wsz),
-            controller->GetIdentifier());
+            cachedControllerNameWide.data(),
+            _TRUNCATE);
         LOG_PROPERTY_INVOCATION_DIPROPSTRING_AND_RETURN(DI_OK, kMethodSeverity, rguidProp, pdiph);
 
       case ((size_t)&DIPROP_JOYSTICKID):
@@ -2043,9 +2401,8 @@ namespace Xidi
           LOG_PROPERTY_INVOCATION_NO_VALUE_AND_RETURN(
               DIERR_INVALIDPARAM, kMethodSeverity, rguidProp);
 
-        const std::pair axisRange = controller->GetAxisRange(element.axis);
-        ((LPDIPROPRANGE)pdiph)->lMin = axisRange.first;
-        ((LPDIPROPRANGE)pdiph)->lMax = axisRange.second;
+        ((LPDIPROPRANGE)pdiph)->lMin = propertyValueShadow.axisRangeMin[(int)element.axis];
+        ((LPDIPROPRANGE)pdiph)->lMax = propertyValueShadow.axisRangeMax[(int)element.axis];
 
         LOG_PROPERTY_INVOCATION_DIPROPRANGE_AND_RETURN(DI_OK, kMethodSeverity, rguidProp, pdiph);
       }
@@ -2054,7 +2411,7 @@ namespace Xidi
         if (Controller::EElementType::Axis != element.type)
           LOG_PROPERTY_INVOCATION_NO_VALUE_AND_RETURN(
               DIERR_INVALIDPARAM, kMethodSeverity, rguidProp);
-        ((LPDIPROPDWORD)pdiph)->dwData = controller->GetAxisSaturation(element.axis);
+        ((LPDIPROPDWORD)pdiph)->dwData = propertyValueShadow.axisSaturation[(int)element.axis];
         LOG_PROPERTY_INVOCATION_DIPROPDWORD_AND_RETURN(DI_OK, kMethodSeverity, rguidProp, pdiph);
 
       case ((size_t)&DIPROP_USERNAME):
@@ -2110,16 +2467,11 @@ namespace Xidi
   template <EDirectInputVersion diVersion> HRESULT VirtualDirectInputDeviceBase<diVersion>::Poll(
       void)
   {
-    // Not required for Xidi virtual controllers as they are implemented now.
-    // However, some applications explicitly check for return codes like `DI_OK`, which is why a
-    // workaround is allowed to change the return code.
-    static const DWORD kPollReturnCode = static_cast<DWORD>(
-        Globals::GetConfigurationData()[Strings::kStrConfigurationSectionWorkarounds]
-                                       [Strings::kStrConfigurationSettingWorkaroundsPollReturnCode]
-                                           .ValueOr(DI_NOEFFECT));
-
+    // Polling is not required for Xidi virtual controllers as they are implemented now, so this
+    // method reduces to returning the per-device return code that was computed at construction
+    // time, with invocation logging deferred whenever it is enabled at all.
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::SuperDebug;
-    LOG_INVOCATION_AND_RETURN(kPollReturnCode, kMethodSeverity);
+    LOG_HOT_PATH_INVOCATION_AND_RETURN(kPollReturnCode, kMethodSeverity);
   }
 
   template <EDirectInputVersion diVersion> HRESULT
@@ -2227,8 +2579,10 @@ namespace Xidi
     if (nullptr == lpdf) LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
 
     // If this operation fails, then the current data format and event filter remain unaltered.
-    std::unique_ptr<DataFormat> newDataFormat =
-        DataFormat::CreateFromApplicationFormatSpec(*lpdf, controller->GetCapabilities());
+    // Identical requests from multiple devices, common when an application opens all of the Xidi
+    // virtual controllers, share a single immutable data format object.
+    std::shared_ptr<const DataFormat> newDataFormat =
+        DataFormat::CreateSharedFromApplicationFormatSpec(*lpdf, controller->GetCapabilities());
     if (nullptr == newDataFormat) LOG_INVOCATION_AND_RETURN(DIERR_INVALIDPARAM, kMethodSeverity);
 
     // Use the event filter to prevent the controller from buffering any events that correspond to
@@ -2236,12 +2590,16 @@ namespace Xidi
     auto lock = controller->Lock();
     controller->EventFilterAddAllElements();
 
+    Controller::TElementMask consumedElements = 0;
+
     for (int i = 0; i < (int)Controller::EAxis::Count; ++i)
     {
       const Controller::SElementIdentifier element = {
           .type = Controller::EElementType::Axis, .axis = (Controller::EAxis)i};
       if (false == newDataFormat->HasElement(element))
         controller->EventFilterRemoveElement(element);
+      else
+        consumedElements |= Controller::ElementMaskBit(element);
     }
 
     for (int i = 0; i < (int)Controller::EButton::Count; ++i)
@@ -2250,15 +2608,23 @@ namespace Xidi
           .type = Controller::EElementType::Button, .button = (Controller::EButton)i};
       if (false == newDataFormat->HasElement(element))
         controller->EventFilterRemoveElement(element);
+      else
+        consumedElements |= Controller::ElementMaskBit(element);
     }
 
     {
       const Controller::SElementIdentifier element = {.type = Controller::EElementType::Pov};
       if (false == newDataFormat->HasElement(element))
         controller->EventFilterRemoveElement(element);
+      else
+        consumedElements |= Controller::ElementMaskBit(element);
     }
 
+    controller->SetConsumedElements(consumedElements);
+
     dataFormat = std::move(newDataFormat);
+    cachedStatePacket.clear();
+    cachedObjectEnumerationTable.clear();
     LOG_INVOCATION_AND_RETURN(DI_OK, kMethodSeverity);
   }
 
@@ -2279,6 +2645,32 @@ namespace Xidi
 
   template <EDirectInputVersion diVersion> HRESULT
       VirtualDirectInputDeviceBase<diVersion>::SetProperty(REFGUID rguidProp, LPCDIPROPHEADER pdiph)
+  {
+    FlightRecorder::Record(
+        FlightRecorder::EEvent::DeviceSetProperty,
+        controller->GetIdentifier(),
+        (uint32_t)rguidProp.Data1);
+
+    const HRESULT setPropertyResult = SetPropertyInternal(rguidProp, pdiph);
+
+    // Whether or not the attempt succeeded, a change attempt targeting one of the shadowed
+    // properties invalidates the shadow, which is refreshed by re-reading the authoritative
+    // values from the virtual controller.
+    switch ((size_t)&rguidProp)
+    {
+      case ((size_t)&DIPROP_BUFFERSIZE):
+      case ((size_t)&DIPROP_DEADZONE):
+      case ((size_t)&DIPROP_RANGE):
+      case ((size_t)&DIPROP_SATURATION):
+        propertyValueShadow = BuildPropertyValueShadow(*controller);
+        break;
+    }
+
+    return setPropertyResult;
+  }
+
+  template <EDirectInputVersion diVersion> HRESULT VirtualDirectInputDeviceBase<
+      diVersion>::SetPropertyInternal(REFGUID rguidProp, LPCDIPROPHEADER pdiph)
   {
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::Info;
 
@@ -2461,6 +2853,9 @@ namespace Xidi
   {
     constexpr Infra::Message::ESeverity kMethodSeverity = Infra::Message::ESeverity::Info;
 
+    FlightRecorder::Record(
+        FlightRecorder::EEvent::DeviceUnacquire, controller->GetIdentifier());
+
     // The only possible state that would need to be undone when unacquiring a device is
     // relinquishing control over the physical device's force feedback buffer.
     controller->ForceFeedbackUnregister();
@@ -2510,6 +2905,32 @@ namespace Xidi
     LOG_INVOCATION_AND_RETURN(DIERR_UNSUPPORTED, kMethodSeverity);
   }
 
+  template <EDirectInputVersion diVersion> VirtualDirectInputDeviceBase<diVersion>*
+      VirtualDirectInputDevicePoolTake(Controller::TControllerIdentifier controllerId)
+  {
+    if (controllerId >= Controller::kPhysicalControllerCount) return nullptr;
+
+    std::scoped_lock lock(devicePoolGuard);
+
+    VirtualDirectInputDeviceBase<diVersion>* const pooledObject =
+        devicePool<diVersion>[controllerId];
+    devicePool<diVersion>[controllerId] = nullptr;
+    return pooledObject;
+  }
+
+  template VirtualDirectInputDeviceBase<EDirectInputVersion::k8A>*
+      VirtualDirectInputDevicePoolTake<EDirectInputVersion::k8A>(
+          Controller::TControllerIdentifier);
+  template VirtualDirectInputDeviceBase<EDirectInputVersion::k8W>*
+      VirtualDirectInputDevicePoolTake<EDirectInputVersion::k8W>(
+          Controller::TControllerIdentifier);
+  template VirtualDirectInputDeviceBase<EDirectInputVersion::kLegacyA>*
+      VirtualDirectInputDevicePoolTake<EDirectInputVersion::kLegacyA>(
+          Controller::TControllerIdentifier);
+  template VirtualDirectInputDeviceBase<EDirectInputVersion::kLegacyW>*
+      VirtualDirectInputDevicePoolTake<EDirectInputVersion::kLegacyW>(
+          Controller::TControllerIdentifier);
+
   template class VirtualDirectInputDeviceBase<EDirectInputVersion::k8A>;
   template class VirtualDirectInputDeviceBase<EDirectInputVersion::k8W>;
   template class VirtualDirectInputDeviceBase<EDirectInputVersion::kLegacyA>;
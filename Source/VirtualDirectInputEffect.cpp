@@ -208,13 +208,31 @@ namespace Xidi
       : associatedDevice(associatedDevice),
         effect(effect.Clone()),
         effectGuid(effectGuid),
-        refCount(1)
+        refCount(1),
+        isDetachedForPooling(false)
   {
     associatedDevice.AddRef();
     associatedDevice.ForceFeedbackEffectRegister((void*)this);
   }
 
   template <EDirectInputVersion diVersion> VirtualDirectInputEffect<diVersion>::~VirtualDirectInputEffect(void)
+  {
+    // Objects being destroyed out of the associated device object's effect pool were already
+    // detached when they were pooled, so no further cleanup is needed for them.
+    if (false == isDetachedForPooling)
+    {
+      // If the effect represented by this object is already downloaded to a device then it must be
+      // removed from that device.
+      Controller::ForceFeedback::Device* const forceFeedbackDevice =
+          associatedDevice.GetVirtualController().ForceFeedbackGetDevice();
+      if (nullptr != forceFeedbackDevice) forceFeedbackDevice->RemoveEffect(effect->Identifier());
+
+      associatedDevice.ForceFeedbackEffectUnregister((void*)this);
+      associatedDevice.Release();
+    }
+  }
+
+  template <EDirectInputVersion diVersion> void VirtualDirectInputEffect<diVersion>::DetachForPooling(void)
   {
     // If the effect represented by this object is already downloaded to a device then it must be
     // removed from that device.
@@ -223,9 +241,24 @@ namespace Xidi
     if (nullptr != forceFeedbackDevice) forceFeedbackDevice->RemoveEffect(effect->Identifier());
 
     associatedDevice.ForceFeedbackEffectUnregister((void*)this);
+    isDetachedForPooling = true;
+
+    // Releasing the reference on the associated device object must come last. If this is the final
+    // reference then the device object is destroyed, and its destructor takes ownership of
+    // destroying everything in the effect pool, including this object.
     associatedDevice.Release();
   }
 
+  template <EDirectInputVersion diVersion> void VirtualDirectInputEffect<diVersion>::PrepareForReuse(void)
+  {
+    effect->ResetAllParameters();
+    refCount = 1;
+    isDetachedForPooling = false;
+
+    associatedDevice.AddRef();
+    associatedDevice.ForceFeedbackEffectRegister((void*)this);
+  }
+
   template <EDirectInputVersion diVersion> HRESULT VirtualDirectInputEffect<diVersion>::DownloadInternal(void)
   {
     Controller::ForceFeedback::Device* const forceFeedbackDevice =
@@ -438,6 +471,22 @@ namespace Xidi
         return DIERR_INVALIDPARAM;
     }
 
+    // Fast lane for applications that modulate a force by submitting new type-specific parameters
+    // every frame, a common pattern for constant-force steering effects. When the update consists
+    // of type-specific parameters only and no download is requested, the new values are applied
+    // directly to the underlying effect, skipping the clone-update-sync sequence the general path
+    // below uses. The direct parameter setter performs the same semantic validation and leaves the
+    // effect untouched on failure, so the fail-safe guarantee is preserved.
+    if ((DIEP_TYPESPECIFICPARAMS == (dwFlags & DIEP_ALLPARAMS)) &&
+        (0 != (dwFlags & DIEP_NODOWNLOAD)))
+    {
+      if (nullptr == peff->lpvTypeSpecificParams) return DIERR_INVALIDPARAM;
+
+      if (false == SetTypeSpecificParametersDirect(peff)) return DIERR_INVALIDPARAM;
+
+      return DI_DOWNLOADSKIPPED;
+    }
+
     // This cloned effect will receive all the parameter updates and will be synced back to the
     // original effect once all parameter values are accepted. Doing this means that an invalid
     // value for a parameter means the original effect remains untouched.
@@ -834,7 +883,16 @@ namespace Xidi
   {
     const unsigned long numRemainingRefs = --refCount;
 
-    if (0 == numRemainingRefs) delete this;
+    if (0 == numRemainingRefs)
+    {
+      // Fully-released effect objects are offered back to the associated device object's effect
+      // pool so that a future effect creation request with the same GUID can reuse them. Only if
+      // the pool declines, because it is already full, is the object actually destroyed.
+      if (true == associatedDevice.ForceFeedbackEffectPoolReturn(effectGuid, this))
+        DetachForPooling();
+      else
+        delete this;
+    }
 
     return (ULONG)numRemainingRefs;
   }
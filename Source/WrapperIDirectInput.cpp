@@ -13,9 +13,12 @@
 #include "WrapperIDirectInput.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <mutex>
 #include <optional>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <Infra/Core/Message.h>
 #include <Infra/Core/TemporaryBuffer.h>
@@ -23,7 +26,9 @@
 #include "ApiDirectInput.h"
 #include "ApiGUID.h"
 #include "ControllerIdentification.h"
+#include "GuidHashTable.h"
 #include "Mapper.h"
+#include "PhysicalController.h"
 #include "Strings.h"
 #include "VirtualController.h"
 #include "VirtualDirectInputDevice.h"
@@ -46,7 +51,7 @@ namespace Xidi
     BOOL callbackReturnCode;
 
     /// Holds device identifiers seen during device enumeration.
-    std::unordered_set<GUID> seenInstanceIdentifiers;
+    GuidHashSet seenInstanceIdentifiers;
   };
 
   template <EDirectInputVersion diVersion> WrapperIDirectInputBase<diVersion>::
@@ -185,10 +190,22 @@ namespace Xidi
           maybeVirtualControllerId.value();
 
       // Is a virtual controller GUID, so create a virtual controller wrapped with a DirectInput
-      // interface.
-      VirtualDirectInputDevice<diVersion>* const newDirectInputDeviceInterfaceObject =
-          new VirtualDirectInputDevice<diVersion>(
-              std::make_unique<Controller::VirtualController>(virtualControllerId));
+      // interface. If a previously-released interface object for the same virtual controller is
+      // available in the device object pool then it is reused, which avoids a full
+      // destroy-construct round trip for applications that close and re-open the same controller.
+      VirtualDirectInputDeviceBase<diVersion>* newDirectInputDeviceInterfaceObject =
+          VirtualDirectInputDevicePoolTake<diVersion>(virtualControllerId);
+
+      if (nullptr == newDirectInputDeviceInterfaceObject)
+        newDirectInputDeviceInterfaceObject = new VirtualDirectInputDevice<diVersion>(
+            std::make_unique<Controller::VirtualController>(virtualControllerId));
+      else
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Info,
+            L"Reusing pooled interface object %u for Xidi virtual controller %u.",
+            newDirectInputDeviceInterfaceObject->ObjectIdentifier(),
+            (virtualControllerId + 1));
+
       *lplpDirectInputDevice = newDirectInputDeviceInterfaceObject;
 
       Infra::Message::OutputFormatted(
@@ -211,6 +228,82 @@ namespace Xidi
           DirectInputTypes<diVersion>::EnumDevicesCallbackType lpCallback,
           LPVOID pvRef,
           DWORD dwFlags)
+  {
+    // Several engines re-enumerate devices every few seconds to detect hotplug events. The merged
+    // device list is deterministic for a given set of enumeration parameters until the hardware
+    // configuration changes, so it is built once, cached, and replayed to the application until a
+    // device change notification invalidates it.
+    const uint32_t currentDeviceChangeGeneration =
+        Controller::GetDeviceChangeNotificationGeneration();
+    const std::pair<DWORD, DWORD> cacheKey = std::make_pair(dwDevType, dwFlags);
+
+    std::vector<typename DirectInputTypes<diVersion>::DeviceInstanceType> deviceInstances;
+    bool servedFromCache = false;
+
+    {
+      std::scoped_lock lock(enumerationCacheGuard);
+      auto cachedEnumeration = cachedEnumerations.find(cacheKey);
+      if ((cachedEnumerations.end() != cachedEnumeration) &&
+          (currentDeviceChangeGeneration == cachedEnumeration->second.deviceChangeGeneration))
+      {
+        deviceInstances = cachedEnumeration->second.deviceInstances;
+        servedFromCache = true;
+      }
+    }
+
+    if (false == servedFromCache)
+    {
+      const HRESULT enumResult = EnumDevicesInternal(
+          dwDevType, &CallbackEnumDevicesCapture, (LPVOID)&deviceInstances, dwFlags);
+      if (DI_OK != enumResult) return enumResult;
+
+      std::scoped_lock lock(enumerationCacheGuard);
+      cachedEnumerations.insert_or_assign(
+          cacheKey,
+          SCachedEnumeration{
+              .deviceChangeGeneration = currentDeviceChangeGeneration,
+              .deviceInstances = deviceInstances});
+    }
+    else
+    {
+      Infra::Message::Output(
+          Infra::Message::ESeverity::Debug,
+          L"Enumerate: Serving cached device enumeration results.");
+    }
+
+    // Replay the merged device list to the application, honoring its request to stop early.
+    for (const auto& deviceInstance : deviceInstances)
+    {
+      const BOOL callbackReturnCode =
+          ((BOOL(FAR PASCAL*)(const DirectInputTypes<diVersion>::DeviceInstanceType*, LPVOID))(
+              lpCallback))(&deviceInstance, pvRef);
+
+      if (DIENUM_STOP == callbackReturnCode)
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Debug, L"Application has terminated enumeration.");
+        break;
+      }
+    }
+
+    return DI_OK;
+  }
+
+  template <EDirectInputVersion diVersion> BOOL __stdcall WrapperIDirectInputBase<diVersion>::
+      CallbackEnumDevicesCapture(
+          const DirectInputTypes<diVersion>::DeviceInstanceType* lpddi, LPVOID pvRef)
+  {
+    ((std::vector<typename DirectInputTypes<diVersion>::DeviceInstanceType>*)pvRef)
+        ->push_back(*lpddi);
+    return DIENUM_CONTINUE;
+  }
+
+  template <EDirectInputVersion diVersion> HRESULT WrapperIDirectInputBase<diVersion>::
+      EnumDevicesInternal(
+          DWORD dwDevType,
+          DirectInputTypes<diVersion>::EnumDevicesCallbackType lpCallback,
+          LPVOID pvRef,
+          DWORD dwFlags)
   {
     const DWORD gameControllerDevClass = 4; // DI8DEVCLASS_GAMECTRL, DIDEVTYPE_JOYSTICK
     const DWORD allDevicesDevClass = 0;     // DI8DEVCLASS_ALL, undefined for legacy
@@ -224,7 +317,7 @@ namespace Xidi
     callbackInfo.lpCallback = lpCallback;
     callbackInfo.pvRef = pvRef;
     callbackInfo.callbackReturnCode = DIENUM_CONTINUE;
-    callbackInfo.seenInstanceIdentifiers.clear();
+    callbackInfo.seenInstanceIdentifiers.Clear();
 
     HRESULT enumResult = DI_OK;
     Infra::Message::Output(
@@ -242,15 +335,29 @@ namespace Xidi
       // request. In general, XInput devices enumerated via DirectInput do not report supporting
       // force feedback, even though Xidi does implement such support. For this reason any filtering
       // by force feedback support must be removed while using the system-supplied interfaces to
-      // scan for XInput devices.
+      // scan for XInput devices. Candidate devices are captured first so that the per-device
+      // support checks, which each require creating a device interface object, can run
+      // concurrently rather than one at a time inside the enumeration callback.
+      std::vector<typename DirectInputTypes<diVersion>::DeviceInstanceType> scanDeviceInstances;
       enumResult = underlyingDIObject->EnumDevices(
           dwDevType,
-          &WrapperIDirectInputBase<diVersion>::CallbackEnumGameControllersXInputScan,
-          (LPVOID)&callbackInfo,
+          &WrapperIDirectInputBase<diVersion>::CallbackEnumDevicesCapture,
+          (LPVOID)&scanDeviceInstances,
           (dwFlags & ~(DIEDFL_FORCEFEEDBACK)));
       if (DI_OK != enumResult) return enumResult;
 
-      const BOOL systemHasXInputDevices = (0 != callbackInfo.seenInstanceIdentifiers.size());
+      std::vector<GUID> scanInstanceIdentifiers;
+      scanInstanceIdentifiers.reserve(scanDeviceInstances.size());
+      for (const auto& scanDeviceInstance : scanDeviceInstances)
+        scanInstanceIdentifiers.push_back(scanDeviceInstance.guidInstance);
+
+      PrescanDirectInputControllersForXInputSupport<diVersion>(
+          underlyingDIObject, scanInstanceIdentifiers);
+
+      for (const auto& scanDeviceInstance : scanDeviceInstances)
+        CallbackEnumGameControllersXInputScan(&scanDeviceInstance, (LPVOID)&callbackInfo);
+
+      const BOOL systemHasXInputDevices = (0 != callbackInfo.seenInstanceIdentifiers.Size());
 
       if (systemHasXInputDevices)
         Infra::Message::Output(
@@ -374,7 +481,7 @@ namespace Xidi
     if (DoesDirectInputControllerSupportXInput<diVersion>(
             callbackInfo->instance->underlyingDIObject, lpddi->guidInstance))
     {
-      callbackInfo->seenInstanceIdentifiers.insert(lpddi->guidInstance);
+      callbackInfo->seenInstanceIdentifiers.Insert(lpddi->guidInstance);
       if (Infra::Message::WillOutputMessageOfSeverity(Infra::Message::ESeverity::Debug))
       {
         Infra::Message::OutputFormatted(
@@ -406,7 +513,7 @@ namespace Xidi
     SEnumDevicesCallbackInfo<diVersion>* callbackInfo = (SEnumDevicesCallbackInfo<diVersion>*)pvRef;
 
     // If the device has not been seen already, add it to the set and present it to the application.
-    if (0 == callbackInfo->seenInstanceIdentifiers.count(lpddi->guidInstance))
+    if (false == callbackInfo->seenInstanceIdentifiers.Contains(lpddi->guidInstance))
     {
       if (Infra::Message::WillOutputMessageOfSeverity(Infra::Message::ESeverity::Info))
       {
@@ -417,7 +524,7 @@ namespace Xidi
             Strings::GuidToString(lpddi->guidInstance).AsCString());
       }
 
-      callbackInfo->seenInstanceIdentifiers.insert(lpddi->guidInstance);
+      callbackInfo->seenInstanceIdentifiers.Insert(lpddi->guidInstance);
       callbackInfo->callbackReturnCode =
           ((BOOL(FAR PASCAL*)(const DirectInputTypes<diVersion>::DeviceInstanceType*, LPVOID))(
               callbackInfo->lpCallback))(lpddi, callbackInfo->pvRef);
@@ -13,10 +13,15 @@
 
 #include <regstr.h>
 
+#include <array>
 #include <climits>
 #include <cstdint>
+#include <atomic>
 #include <mutex>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -28,16 +33,26 @@
 #include "ControllerIdentification.h"
 #include "ControllerTypes.h"
 #include "DataFormat.h"
+#include "Diagnostics.h"
 #include "Globals.h"
+#include "HotPathLogging.h"
 #include "ImportApiDirectInput.h"
 #include "ImportApiWinMM.h"
+#include "PhysicalController.h"
 #include "Strings.h"
 #include "VirtualController.h"
 
-/// Logs a WinMM device-specific function invocation.
+/// Logs a WinMM device-specific function invocation. Invocations are captured as compact binary
+/// records and formatted by a background writer thread, so no string formatting or log output
+/// happens on the calling thread, even for functions invoked once or more per frame.
 #define LOG_INVOCATION(severity, joyID, result)                                                    \
-  Infra::Message::OutputFormatted(                                                                 \
-      severity, L"Invoked %s on device %d, result = %u.", __FUNCTIONW__ L"()", joyID, result)
+  do                                                                                               \
+  {                                                                                                \
+    if (true == Infra::Message::WillOutputMessageOfSeverity(severity))                             \
+      Xidi::HotPathLogging::RecordWinMMInvocation(                                                 \
+          severity, __FUNCTIONW__ L"()", (unsigned int)(joyID), (unsigned int)(result));           \
+  }                                                                                                \
+  while (false)
 
 /// Logs invocation of an unsupported WinMM operation.
 #define LOG_UNSUPPORTED_OPERATION()                                                                \
@@ -67,6 +82,11 @@ namespace Xidi
     /// to be the representable set of values for that type.
     static constexpr int32_t kAxisRangeMax = USHRT_MAX;
 
+    /// Neutral axis value for a controller presented by WinMM. Matches the neutral value that a
+    /// virtual controller produces for the WinMM axis range, so it can be served directly for
+    /// controller slots known to be disconnected without consulting any virtual controller state.
+    static constexpr int32_t kAxisRangeNeutral = ((kAxisRangeMin + kAxisRangeMax) / 2);
+
     /// Axis deadzone value to use for a controller presented by WinMM.
     /// WinMM has no way for applications to set deadzone, so use a small part of the axis just to
     /// enable some minor filtering but to avoid interfering with any applications that do their own
@@ -79,6 +99,10 @@ namespace Xidi
     /// filtering.
     static constexpr int32_t kAxisSaturation = 9250;
 
+    /// Maximum allowed size, in bytes, of the device enumeration cache file. Guards against
+    /// attempting to read an unexpectedly large or corrupted file.
+    static constexpr DWORD kDeviceCacheMaxFileSizeBytes = 65536;
+
     // Used to provide all information needed to get a list of XInput devices exposed by WinMM.
     struct SWinMMEnumCallbackInfo
     {
@@ -99,6 +123,35 @@ namespace Xidi
     /// specifies whether the device supports XInput.
     static std::vector<std::pair<std::wstring, bool>> joySystemDeviceInfo;
 
+    /// Pre-decoded routing decision for one application-facing joystick index. Built alongside
+    /// the joystick index map so that the prologue of each WinMM entry point is a single indexed
+    /// load instead of a per-call sign decode of a raw index map entry.
+    struct SJoyRouteEntry
+    {
+      /// Possible targets to which an application-facing joystick index can route.
+      enum class ETarget : uint8_t
+      {
+        /// Xidi virtual controller, identified by #virtualControllerID.
+        VirtualController,
+
+        /// System-supplied WinMM device, identified by #systemJoyID.
+        SystemDevice,
+      };
+
+      /// Target to which the application-facing joystick index routes.
+      ETarget target;
+
+      /// Xidi virtual controller identifier. Valid only when the target is a virtual controller.
+      Controller::TControllerIdentifier virtualControllerID;
+
+      /// System WinMM joystick index. Valid only when the target is a system device.
+      UINT systemJoyID;
+    };
+
+    /// Routing entries for all application-facing joystick indices, indexed by application
+    /// joystick index. Rebuilt whenever the joystick index map is rebuilt.
+    static std::vector<SJoyRouteEntry> joyRouteTable;
+
     /// Templated wrapper around the imported `joyGetDevCaps` WinMM function, which ordinarily
     /// exists in a Unicode and non-Unicode version separately.
     /// @tparam JoyCapsType Either JOYCAPSA or JOYCAPSW depending on whether ASCII or Unicode is
@@ -145,7 +198,8 @@ namespace Xidi
     {
       const uint64_t activeVirtualControllerMask =
           Globals::GetConfigurationData()
-              [Strings::kStrConfigurationSectionWorkarounds]
+              [Globals::ApplicableConfigurationSection(
+                  Strings::kStrConfigurationSectionWorkarounds)]
               [Strings::kStrConfigurationSettingWorkaroundsActiveVirtualControllerMask]
                   .ValueOr(UINT64_MAX);
 
@@ -224,6 +278,23 @@ namespace Xidi
           }
         }
       }
+
+      // Compile the routing decision for each application-facing index into the route table, so
+      // that WinMM entry points do not need to re-decode index map entries on every call.
+      joyRouteTable.clear();
+      joyRouteTable.reserve(joyIndexMap.size());
+      for (size_t i = 0; i < joyIndexMap.size(); ++i)
+      {
+        if (joyIndexMap[i] < 0)
+          joyRouteTable.push_back(
+              {.target = SJoyRouteEntry::ETarget::VirtualController,
+               .virtualControllerID =
+                   (Controller::TControllerIdentifier)((-joyIndexMap[i]) - 1)});
+        else
+          joyRouteTable.push_back(
+              {.target = SJoyRouteEntry::ETarget::SystemDevice,
+               .systemJoyID = (UINT)joyIndexMap[i]});
+      }
     }
 
     /// Callback during DirectInput device enumeration.
@@ -280,6 +351,263 @@ namespace Xidi
       return DIENUM_CONTINUE;
     }
 
+    /// Generates and returns the path of the file used to cache system device enumeration
+    /// results across launches. This is a combination of the product name, Xidi form name, and a
+    /// fixed suffix, placed in the current user's desktop directory next to any log files. The
+    /// name deliberately excludes the process ID so that successive launches share the same file.
+    /// @return Device enumeration cache file path.
+    static const std::wstring& GetDeviceCacheFilePath(void)
+    {
+      static std::wstring deviceCacheFilePath;
+      static std::once_flag initFlag;
+
+      std::call_once(
+          initFlag,
+          []() -> void
+          {
+            Infra::TemporaryString cacheFilename;
+
+            PWSTR knownFolderPath;
+            const HRESULT result =
+                SHGetKnownFolderPath(FOLDERID_Desktop, 0, nullptr, &knownFolderPath);
+
+            if (S_OK == result)
+            {
+              cacheFilename << knownFolderPath << L'\\';
+              CoTaskMemFree(knownFolderPath);
+            }
+
+            cacheFilename << Infra::ProcessInfo::GetProductName();
+            if (Strings::GetFormName() != Infra::ProcessInfo::GetProductName())
+              cacheFilename << L'.' << Strings::GetFormName();
+
+            cacheFilename << L"_DeviceCache.txt";
+
+            deviceCacheFilePath.assign(cacheFilename);
+          });
+
+      return deviceCacheFilePath;
+    }
+
+    /// Attempts to load cached XInput support detection results and apply them to the supplied
+    /// system device information data structure. The cache records the complete ordered list of
+    /// WinMM device identifier strings alongside the detection results, and that list acts as a
+    /// cheap fingerprint of the hardware configuration: the cache is applied only if it exactly
+    /// matches the identifier strings just read from the registry.
+    /// @param [in,out] systemDeviceInfo System device information with identifier strings already
+    /// filled in. On a fingerprint match, receives the cached XInput support flags.
+    /// @return `true` if the cache was present, valid, and applied, `false` otherwise.
+    static bool TryApplyCachedSystemDeviceInfo(
+        std::vector<std::pair<std::wstring, bool>>& systemDeviceInfo)
+    {
+      const HANDLE cacheFile = CreateFileW(
+          GetDeviceCacheFilePath().c_str(),
+          GENERIC_READ,
+          FILE_SHARE_READ,
+          nullptr,
+          OPEN_EXISTING,
+          FILE_ATTRIBUTE_NORMAL,
+          NULL);
+      if (INVALID_HANDLE_VALUE == cacheFile) return false;
+
+      const DWORD cacheFileSize = GetFileSize(cacheFile, nullptr);
+      if ((INVALID_FILE_SIZE == cacheFileSize) || (0 == cacheFileSize) ||
+          (cacheFileSize > kDeviceCacheMaxFileSizeBytes) ||
+          (0 != (cacheFileSize % sizeof(wchar_t))))
+      {
+        CloseHandle(cacheFile);
+        return false;
+      }
+
+      std::wstring cacheFileContents(((size_t)cacheFileSize / sizeof(wchar_t)), L'\0');
+      DWORD numBytesRead = 0;
+      const BOOL readResult =
+          ReadFile(cacheFile, cacheFileContents.data(), cacheFileSize, &numBytesRead, nullptr);
+      CloseHandle(cacheFile);
+      if ((FALSE == readResult) || (cacheFileSize != numBytesRead)) return false;
+
+      // Each line holds one device: a '0' or '1' XInput support flag character followed by the
+      // device identifier string. Everything is validated against the live device list before
+      // any flags are applied, so a stale or corrupted cache is rejected in its entirety.
+      std::vector<bool> cachedXInputSupport;
+      cachedXInputSupport.reserve(systemDeviceInfo.size());
+
+      size_t parsePosition = 0;
+      while (parsePosition < cacheFileContents.size())
+      {
+        const size_t lineEnd = cacheFileContents.find(L'\n', parsePosition);
+        if (std::wstring::npos == lineEnd) return false;
+
+        const std::wstring_view line(&cacheFileContents[parsePosition], (lineEnd - parsePosition));
+        parsePosition = lineEnd + 1;
+
+        if (true == line.empty()) return false;
+        if ((L'0' != line[0]) && (L'1' != line[0])) return false;
+
+        const size_t deviceIndex = cachedXInputSupport.size();
+        if (deviceIndex >= systemDeviceInfo.size()) return false;
+        if (line.substr(1) != systemDeviceInfo[deviceIndex].first) return false;
+
+        cachedXInputSupport.push_back(L'1' == line[0]);
+      }
+
+      if (cachedXInputSupport.size() != systemDeviceInfo.size()) return false;
+
+      for (size_t i = 0; i < systemDeviceInfo.size(); ++i)
+        systemDeviceInfo[i].second = cachedXInputSupport[i];
+
+      return true;
+    }
+
+    /// Writes the supplied XInput support detection results to the device enumeration cache file,
+    /// replacing any previous contents, so that the next launch can skip DirectInput enumeration.
+    /// Operates on a snapshot of the system device information, passed by value, so it can run on
+    /// a background task without racing device re-enumeration.
+    /// @param [in] systemDeviceInfoSnapshot Copy of the system device information to cache.
+    static void WriteSystemDeviceInfoCache(
+        std::vector<std::pair<std::wstring, bool>> systemDeviceInfoSnapshot)
+    {
+      std::wstring cacheFileContents;
+      for (size_t i = 0; i < systemDeviceInfoSnapshot.size(); ++i)
+      {
+        cacheFileContents += ((true == systemDeviceInfoSnapshot[i].second) ? L'1' : L'0');
+        cacheFileContents += systemDeviceInfoSnapshot[i].first;
+        cacheFileContents += L'\n';
+      }
+
+      const HANDLE cacheFile = CreateFileW(
+          GetDeviceCacheFilePath().c_str(),
+          GENERIC_WRITE,
+          0,
+          nullptr,
+          CREATE_ALWAYS,
+          FILE_ATTRIBUTE_NORMAL,
+          NULL);
+      if (INVALID_HANDLE_VALUE == cacheFile)
+      {
+        Infra::Message::OutputFormatted(
+            Infra::Message::ESeverity::Warning,
+            L"Unable to write the device enumeration cache file \"%s\".",
+            GetDeviceCacheFilePath().c_str());
+        return;
+      }
+
+      DWORD numBytesWritten = 0;
+      WriteFile(
+          cacheFile,
+          cacheFileContents.data(),
+          (DWORD)(cacheFileContents.size() * sizeof(wchar_t)),
+          &numBytesWritten,
+          nullptr);
+      CloseHandle(cacheFile);
+    }
+
+    /// Uses DirectInput device enumeration to determine which of the supplied WinMM devices
+    /// support XInput, marking the support flag of each matching device.
+    /// @param [in,out] systemDeviceInfo System device information with identifier strings already
+    /// filled in.
+    static void DetectXInputDeviceSupport(
+        std::vector<std::pair<std::wstring, bool>>& systemDeviceInfo)
+    {
+      // Enumerate all devices using DirectInput8 to find any XInput devices with matching vendor
+      // and product identifiers. This will provide information on whether each WinMM device
+      // supports XInput.
+      Infra::Message::Output(
+          Infra::Message::ESeverity::Debug, L"Using DirectInput to detect XInput devices...");
+      IDirectInput8W* directInputInterface = nullptr;
+      if (S_OK !=
+          ImportApiDirectInput::Version8::DirectInput8Create(
+              Infra::ProcessInfo::GetThisModuleInstanceHandle(),
+              DIRECTINPUT_VERSION,
+              IID_IDirectInput8,
+              (LPVOID*)&directInputInterface,
+              nullptr))
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Debug,
+            L"Unable to detect XInput devices because a DirectInput interface object could not be created.");
+        return;
+      }
+
+      SWinMMEnumCallbackInfo callbackInfo;
+      callbackInfo.systemDeviceInfo = &systemDeviceInfo;
+      callbackInfo.directInputInterface = directInputInterface;
+      if (S_OK !=
+          directInputInterface->EnumDevices(
+              DI8DEVCLASS_GAMECTRL, CreateSystemDeviceInfoEnumCallback, (LPVOID)&callbackInfo, 0))
+      {
+        Infra::Message::Output(
+            Infra::Message::ESeverity::Debug,
+            L"Unable to detect XInput devices because enumeration of DirectInput devices failed.");
+        return;
+      }
+
+      Infra::Message::Output(Infra::Message::ESeverity::Debug, L"Done detecting XInput devices.");
+    }
+
+    /// Re-runs XInput support detection on a snapshot of the system device information and
+    /// rewrites the device enumeration cache file with the results. Used after cached results are
+    /// applied, so that a change in XInput support not accompanied by a change in device
+    /// identifier strings is still picked up on the next launch without stalling this one.
+    /// @param [in] systemDeviceInfoSnapshot Copy of the system device information to refresh.
+    static void RefreshSystemDeviceInfoCache(
+        std::vector<std::pair<std::wstring, bool>> systemDeviceInfoSnapshot)
+    {
+      for (size_t i = 0; i < systemDeviceInfoSnapshot.size(); ++i)
+        systemDeviceInfoSnapshot[i].second = false;
+
+      DetectXInputDeviceSupport(systemDeviceInfoSnapshot);
+      WriteSystemDeviceInfoCache(std::move(systemDeviceInfoSnapshot));
+    }
+
+    /// Manages the background task that maintains the device enumeration cache file. DirectInput
+    /// re-detection and file writes are kept off the critical path of the first WinMM call. Wraps
+    /// the thread handle to ensure safe termination and clean-up.
+    class DeviceCacheRefreshTask
+    {
+    public:
+
+      /// Safely waits for any in-progress cache maintenance before clean-up.
+      ~DeviceCacheRefreshTask(void)
+      {
+        Join();
+      }
+
+      /// Begins asynchronously re-running XInput support detection and rewriting the cache file,
+      /// using a copy of the supplied system device information. Waits for any previously started
+      /// task to finish first.
+      /// @param [in] systemDeviceInfoSnapshot Copy of the system device information to refresh.
+      inline void Refresh(std::vector<std::pair<std::wstring, bool>> systemDeviceInfoSnapshot)
+      {
+        Join();
+        refreshThread =
+            std::thread(RefreshSystemDeviceInfoCache, std::move(systemDeviceInfoSnapshot));
+      }
+
+      /// Begins asynchronously writing the supplied system device information to the cache file.
+      /// Waits for any previously started task to finish first.
+      /// @param [in] systemDeviceInfoSnapshot Copy of the system device information to cache.
+      inline void Save(std::vector<std::pair<std::wstring, bool>> systemDeviceInfoSnapshot)
+      {
+        Join();
+        refreshThread = std::thread(WriteSystemDeviceInfoCache, std::move(systemDeviceInfoSnapshot));
+      }
+
+    private:
+
+      /// Waits for any in-progress cache maintenance to finish.
+      inline void Join(void)
+      {
+        if (true == refreshThread.joinable()) refreshThread.join();
+      }
+
+      /// Handle for the cache maintenance thread itself.
+      std::thread refreshThread;
+    };
+
+    /// Singleton object that wraps the device enumeration cache maintenance task.
+    static DeviceCacheRefreshTask deviceCacheRefreshTask;
+
     /// Fills in the system device info data structure with information from the registry and from
     /// DirectInput.
     static void CreateSystemDeviceInfo(void)
@@ -385,40 +713,25 @@ namespace Xidi
           Infra::Message::ESeverity::Debug, L"Done enumerating system WinMM devices.");
       RegCloseKey(registryKey);
 
-      // Enumerate all devices using DirectInput8 to find any XInput devices with matching vendor
-      // and product identifiers. This will provide information on whether each WinMM device
-      // supports XInput.
-      Infra::Message::Output(
-          Infra::Message::ESeverity::Debug, L"Using DirectInput to detect XInput devices...");
-      IDirectInput8W* directInputInterface = nullptr;
-      if (S_OK !=
-          ImportApiDirectInput::Version8::DirectInput8Create(
-              Infra::ProcessInfo::GetThisModuleInstanceHandle(),
-              DIRECTINPUT_VERSION,
-              IID_IDirectInput8,
-              (LPVOID*)&directInputInterface,
-              nullptr))
+      // If a previous launch cached XInput support detection results for this exact set of WinMM
+      // devices, apply them and skip DirectInput enumeration entirely, which is by far the most
+      // expensive part of device enumeration. Detection is still re-run on a background task so
+      // that the cache converges if XInput support changed without the device identifier strings
+      // changing, taking effect on the next launch.
+      if (true == TryApplyCachedSystemDeviceInfo(joySystemDeviceInfo))
       {
         Infra::Message::Output(
-            Infra::Message::ESeverity::Debug,
-            L"Unable to detect XInput devices because a DirectInput interface object could not be created.");
+            Infra::Message::ESeverity::Info,
+            L"Applied cached XInput device detection results and skipped DirectInput enumeration.");
+        deviceCacheRefreshTask.Refresh(joySystemDeviceInfo);
         return;
       }
 
-      SWinMMEnumCallbackInfo callbackInfo;
-      callbackInfo.systemDeviceInfo = &joySystemDeviceInfo;
-      callbackInfo.directInputInterface = directInputInterface;
-      if (S_OK !=
-          directInputInterface->EnumDevices(
-              DI8DEVCLASS_GAMECTRL, CreateSystemDeviceInfoEnumCallback, (LPVOID)&callbackInfo, 0))
-      {
-        Infra::Message::Output(
-            Infra::Message::ESeverity::Debug,
-            L"Unable to detect XInput devices because enumeration of DirectInput devices failed.");
-        return;
-      }
+      DetectXInputDeviceSupport(joySystemDeviceInfo);
 
-      Infra::Message::Output(Infra::Message::ESeverity::Debug, L"Done detecting XInput devices.");
+      // Save the detection results so the next launch can skip DirectInput enumeration. The file
+      // write itself happens on a background task off the initialization path.
+      deviceCacheRefreshTask.Save(joySystemDeviceInfo);
     }
 
     /// Fills in the specified buffer with the name of the registry key to use for referencing
@@ -438,8 +751,14 @@ namespace Xidi
     }
 
     /// Places the required keys and values into the registry so that WinMM-based applications can
-    /// find the correct controller names. Consumes the system device information data structure.
-    static void SetControllerNameRegistryInfo(void)
+    /// find the correct controller names. Operates on snapshots of the joystick index map and
+    /// system device information data structures, passed by value, so it can run on a background
+    /// task without racing device re-enumeration.
+    /// @param [in] joyIndexMapSnapshot Copy of the joystick index map to publish.
+    /// @param [in] joySystemDeviceInfoSnapshot Copy of the system device information to publish.
+    static void SetControllerNameRegistryInfo(
+        std::vector<int> joyIndexMapSnapshot,
+        std::vector<std::pair<std::wstring, bool>> joySystemDeviceInfoSnapshot)
     {
       HKEY registryKey;
       LSTATUS result;
@@ -511,13 +830,13 @@ namespace Xidi
           nullptr);
       if (ERROR_SUCCESS != result) return;
 
-      for (size_t i = 0; i < joyIndexMap.size(); ++i)
+      for (size_t i = 0; i < joyIndexMapSnapshot.size(); ++i)
       {
         wchar_t valueName[64];
         const int valueNameCount =
             swprintf_s(valueName, _countof(valueName), REGSTR_VAL_JOYNOEMNAME, ((int)i + 1));
 
-        if (joyIndexMap[i] < 0)
+        if (joyIndexMapSnapshot[i] < 0)
         {
           // Map points to a Xidi virtual controller.
 
@@ -525,7 +844,11 @@ namespace Xidi
           // Use this value to create the correct string to write to the registry.
           wchar_t valueData[64];
           const int valueDataCount = swprintf_s(
-              valueData, _countof(valueData), L"%s%u", registryKeyName, ((UINT)(-joyIndexMap[i])));
+              valueData,
+              _countof(valueData),
+              L"%s%u",
+              registryKeyName,
+              ((UINT)(-joyIndexMapSnapshot[i])));
 
           // Write the value to the registry.
           RegSetValueEx(
@@ -541,8 +864,10 @@ namespace Xidi
           // Map points to a non-Xidi device.
 
           // Just reference the string directly.
-          const wchar_t* valueData = joySystemDeviceInfo[joyIndexMap[i]].first.c_str();
-          const int valueDataCount = (int)joySystemDeviceInfo[joyIndexMap[i]].first.length();
+          const wchar_t* valueData =
+              joySystemDeviceInfoSnapshot[joyIndexMapSnapshot[i]].first.c_str();
+          const int valueDataCount =
+              (int)joySystemDeviceInfoSnapshot[joyIndexMapSnapshot[i]].first.length();
 
           // Write the value to the registry.
           RegSetValueEx(
@@ -551,21 +876,275 @@ namespace Xidi
               0,
               REG_SZ,
               (const BYTE*)valueData,
-              (sizeof(joySystemDeviceInfo[joyIndexMap[i]].first[0]) * (valueDataCount + 1)));
+              (sizeof(joySystemDeviceInfoSnapshot[joyIndexMapSnapshot[i]].first[0]) *
+               (valueDataCount + 1)));
         }
       }
     }
 
-    /// Translates an application-supplied joystick index to an internal joystick index using the
-    /// map.
+    /// Manages the background task that publishes controller name information to the registry.
+    /// Registry virtualization can make these writes slow on some deployments, so they are kept
+    /// off the critical path of the first WinMM call. Wraps the thread handle to ensure safe
+    /// termination and clean-up.
+    class RegistryPublicationTask
+    {
+    public:
+
+      /// Safely waits for any in-progress publication before clean-up.
+      ~RegistryPublicationTask(void)
+      {
+        Join();
+      }
+
+      /// Begins asynchronous registry publication using copies of the supplied device data
+      /// structures. Waits for any previously started publication to finish first, so
+      /// publications are naturally serialized in submission order.
+      /// @param [in] joyIndexMapSnapshot Copy of the joystick index map to publish.
+      /// @param [in] joySystemDeviceInfoSnapshot Copy of the system device information to publish.
+      inline void Publish(
+          std::vector<int> joyIndexMapSnapshot,
+          std::vector<std::pair<std::wstring, bool>> joySystemDeviceInfoSnapshot)
+      {
+        Join();
+        publicationThread = std::thread(
+            SetControllerNameRegistryInfo,
+            std::move(joyIndexMapSnapshot),
+            std::move(joySystemDeviceInfoSnapshot));
+      }
+
+    private:
+
+      /// Waits for any in-progress publication to finish.
+      inline void Join(void)
+      {
+        if (true == publicationThread.joinable()) publicationThread.join();
+      }
+
+      /// Handle for the publication thread itself.
+      std::thread publicationThread;
+    };
+
+    /// Singleton object that wraps the registry publication task.
+    static RegistryPublicationTask registryPublicationTask;
+
+    /// Number of joysticks for which WinMM defines capture messages. The message identifiers
+    /// MM_JOY1* and MM_JOY2* only exist for the first two joysticks.
+    inline constexpr UINT kJoyCaptureMaxDevices = 2;
+
+    /// Joystick movement capture message identifiers, indexed by application joystick index.
+    static constexpr UINT kJoyCaptureMoveMessages[kJoyCaptureMaxDevices] = {
+        MM_JOY1MOVE, MM_JOY2MOVE};
+
+    /// Joystick Z axis movement capture message identifiers, indexed by application joystick
+    /// index.
+    static constexpr UINT kJoyCaptureZMoveMessages[kJoyCaptureMaxDevices] = {
+        MM_JOY1ZMOVE, MM_JOY2ZMOVE};
+
+    /// Joystick button press capture message identifiers, indexed by application joystick index.
+    static constexpr UINT kJoyCaptureButtonDownMessages[kJoyCaptureMaxDevices] = {
+        MM_JOY1BUTTONDOWN, MM_JOY2BUTTONDOWN};
+
+    /// Joystick button release capture message identifiers, indexed by application joystick
+    /// index.
+    static constexpr UINT kJoyCaptureButtonUpMessages[kJoyCaptureMaxDevices] = {
+        MM_JOY1BUTTONUP, MM_JOY2BUTTONUP};
+
+    /// Snapshot of the WinMM-visible position and button state of a Xidi virtual controller, in
+    /// the representation that joystick capture messages carry. Capture messages only have room
+    /// for the X, Y, and Z axes and the first four buttons.
+    struct SJoyCaptureSnapshot
+    {
+      WORD xPos;
+      WORD yPos;
+      WORD zPos;
+
+      /// Pressed state of the first four buttons, one bit per button, matching the
+      /// `JOY_BUTTON1` through `JOY_BUTTON4` flags.
+      WORD buttons;
+
+      constexpr bool operator==(const SJoyCaptureSnapshot& other) const = default;
+    };
+
+    /// Captures the current WinMM-visible position and button state of the specified Xidi virtual
+    /// controller.
+    /// @param [in] xJoyID Xidi virtual controller identifier.
+    /// @return Snapshot in joystick capture message representation.
+    static SJoyCaptureSnapshot JoyCaptureSnapshotForController(
+        Controller::TControllerIdentifier xJoyID)
+    {
+      const Controller::SState joyStateData = controllers[xJoyID]->GetState();
+
+      SJoyCaptureSnapshot snapshot = {
+          .xPos = (WORD)joyStateData[Controller::EAxis::X],
+          .yPos = (WORD)joyStateData[Controller::EAxis::Y],
+          .zPos = (WORD)joyStateData[Controller::EAxis::Z],
+          .buttons = 0};
+
+      // Virtual controller buttons map 1:1 onto the packed button flags, so the packed word is
+      // just the low bits of the button bitset.
+      constexpr size_t kMaxButtonIndex = 4;
+      snapshot.buttons =
+          (WORD)(joyStateData.button.to_ullong() & ((1ull << kMaxButtonIndex) - 1ull));
+
+      return snapshot;
+    }
+
+    /// Delivers joystick capture messages to the capturing window until the capture is released
+    /// or the window is destroyed. Runs on a dedicated thread per captured joystick and blocks on
+    /// the physical controller state-change wait infrastructure between deliveries, so messages
+    /// are posted only on actual state changes and no CPU time is consumed while the controller
+    /// is idle.
+    /// @param [in] stopToken Token used to interrupt the state-change wait when the capture is
+    /// released.
+    /// @param [in] captureWindow Window to which capture messages are posted.
+    /// @param [in] applicationJoyID Application-facing joystick index, which selects the message
+    /// identifiers to post.
+    /// @param [in] xJoyID Xidi virtual controller identifier.
+    /// @param [in] captureActiveFlag Flag to clear on exit, so the owning task object knows the
+    /// capture is no longer in effect.
+    static void DeliverJoyCaptureMessages(
+        std::stop_token stopToken,
+        HWND captureWindow,
+        UINT applicationJoyID,
+        Controller::TControllerIdentifier xJoyID,
+        std::atomic<bool>* captureActiveFlag)
+    {
+      SJoyCaptureSnapshot previousSnapshot = JoyCaptureSnapshotForController(xJoyID);
+      Controller::SState rawState = {};
+
+      while ((false == stopToken.stop_requested()) &&
+             (true ==
+              Controller::WaitForRawVirtualControllerStateChange(xJoyID, rawState, stopToken)))
+      {
+        // WinMM releases a capture automatically when the capturing window is destroyed.
+        if (FALSE == IsWindow(captureWindow)) break;
+
+        const SJoyCaptureSnapshot currentSnapshot = JoyCaptureSnapshotForController(xJoyID);
+        if (currentSnapshot == previousSnapshot) continue;
+
+        const LPARAM positionParam = MAKELPARAM(currentSnapshot.xPos, currentSnapshot.yPos);
+
+        if ((currentSnapshot.xPos != previousSnapshot.xPos) ||
+            (currentSnapshot.yPos != previousSnapshot.yPos))
+          PostMessage(
+              captureWindow,
+              kJoyCaptureMoveMessages[applicationJoyID],
+              (WPARAM)currentSnapshot.buttons,
+              positionParam);
+
+        if (currentSnapshot.zPos != previousSnapshot.zPos)
+          PostMessage(
+              captureWindow,
+              kJoyCaptureZMoveMessages[applicationJoyID],
+              (WPARAM)currentSnapshot.buttons,
+              MAKELPARAM(currentSnapshot.zPos, 0));
+
+        // Button change flags (JOY_BUTTON1CHG and so on) occupy the byte above the pressed-state
+        // flags in the wParam of button capture messages.
+        const WORD changedButtons = (WORD)(currentSnapshot.buttons ^ previousSnapshot.buttons);
+        const WORD pressedChangedButtons = (WORD)(changedButtons & currentSnapshot.buttons);
+        const WORD releasedChangedButtons = (WORD)(changedButtons & previousSnapshot.buttons);
+
+        if (0 != pressedChangedButtons)
+          PostMessage(
+              captureWindow,
+              kJoyCaptureButtonDownMessages[applicationJoyID],
+              (WPARAM)((pressedChangedButtons << 8) | currentSnapshot.buttons),
+              positionParam);
+
+        if (0 != releasedChangedButtons)
+          PostMessage(
+              captureWindow,
+              kJoyCaptureButtonUpMessages[applicationJoyID],
+              (WPARAM)((releasedChangedButtons << 8) | currentSnapshot.buttons),
+              positionParam);
+
+        previousSnapshot = currentSnapshot;
+      }
+
+      captureActiveFlag->store(false, std::memory_order_release);
+    }
+
+    /// Holds the capture state of one application-facing joystick and manages its message
+    /// delivery thread. Wraps the thread handle to ensure safe termination and clean-up.
+    class JoyCaptureTask
+    {
+    public:
+
+      /// Safely releases the capture, if one is in effect, before clean-up.
+      ~JoyCaptureTask(void)
+      {
+        Stop();
+      }
+
+      /// Attempts to begin capturing the specified Xidi virtual controller on behalf of the
+      /// specified window.
+      /// @param [in] captureWindow Window to which capture messages should be posted.
+      /// @param [in] applicationJoyID Application-facing joystick index.
+      /// @param [in] xJoyID Xidi virtual controller identifier.
+      /// @return `JOYERR_NOERROR` on success, `JOYERR_NOCANDO` if a capture is already in effect.
+      MMRESULT Start(
+          HWND captureWindow, UINT applicationJoyID, Controller::TControllerIdentifier xJoyID)
+      {
+        std::scoped_lock lock(captureGuard);
+
+        if (true == captureActive.load(std::memory_order_acquire)) return JOYERR_NOCANDO;
+
+        // The previous delivery thread, if any, exited on its own because its capture window was
+        // destroyed, and just needs to be cleaned up.
+        if (true == deliveryThread.joinable()) deliveryThread.join();
+
+        captureActive.store(true, std::memory_order_release);
+        deliveryThread = std::jthread(
+            DeliverJoyCaptureMessages, captureWindow, applicationJoyID, xJoyID, &captureActive);
+
+        return JOYERR_NOERROR;
+      }
+
+      /// Releases the capture, if one is in effect.
+      /// @return `JOYERR_NOERROR` in all cases, consistent with WinMM behavior when releasing a
+      /// joystick that is not captured.
+      MMRESULT Stop(void)
+      {
+        std::scoped_lock lock(captureGuard);
+
+        if (true == deliveryThread.joinable())
+        {
+          deliveryThread.request_stop();
+          deliveryThread.join();
+        }
+
+        captureActive.store(false, std::memory_order_release);
+        return JOYERR_NOERROR;
+      }
+
+    private:
+
+      /// Handle for the message delivery thread itself.
+      std::jthread deliveryThread;
+
+      /// Indicates whether a capture is currently in effect. Cleared by the delivery thread
+      /// itself if it exits because the capturing window was destroyed.
+      std::atomic<bool> captureActive;
+
+      /// Serializes capture and release requests, which can come from multiple application
+      /// threads.
+      std::mutex captureGuard;
+    };
+
+    /// Capture state for the application-facing joysticks that can deliver capture messages.
+    static JoyCaptureTask joyCaptureTasks[kJoyCaptureMaxDevices];
+
+    /// Retrieves the pre-decoded routing entry for an application-supplied joystick index.
     /// @param [in] uJoyID WinMM joystick ID supplied by the application.
-    /// @return Internal joystick index to either handle or pass to WinMM.
-    static int TranslateApplicationJoyIndex(UINT uJoyID)
+    /// @return Routing entry for the index. Out-of-range indices route to the system WinMM
+    /// implementation with an out-of-range system index, which preserves its error reporting.
+    static SJoyRouteEntry RouteApplicationJoyIndex(UINT uJoyID)
     {
-      if (joyIndexMap.size() <= (size_t)uJoyID)
-        return INT_MAX;
-      else
-        return joyIndexMap[uJoyID];
+      if (joyRouteTable.size() <= (size_t)uJoyID)
+        return {.target = SJoyRouteEntry::ETarget::SystemDevice, .systemJoyID = (UINT)INT_MAX};
+
+      return joyRouteTable[uJoyID];
     }
 
     /// Initializes all WinMM functionality.
@@ -584,12 +1163,14 @@ namespace Xidi
           {
             const bool enableAxisProperites =
                 Globals::GetConfigurationData()
-                    [Strings::kStrConfigurationSectionProperties]
+                    [Globals::ApplicableConfigurationSection(
+                        Strings::kStrConfigurationSectionProperties)]
                     [Strings::kStrConfigurationSettingsPropertiesUseBuiltinProperties]
                         .ValueOr(true);
             const uint64_t activeVirtualControllerMask =
                 Globals::GetConfigurationData()
-                    [Strings::kStrConfigurationSectionWorkarounds]
+                    [Globals::ApplicableConfigurationSection(
+                        Strings::kStrConfigurationSectionWorkarounds)]
                     [Strings::kStrConfigurationSettingWorkaroundsActiveVirtualControllerMask]
                         .ValueOr(UINT64_MAX);
 
@@ -600,6 +1181,11 @@ namespace Xidi
               if (0 != (activeVirtualControllerMask & ((uint64_t)1 << i)))
               {
                 controllers[i] = new Controller::VirtualController(i);
+
+                // The WinMM axis range is applied unconditionally, not as an optional built-in
+                // property. The joyGetPos and joyGetPosEx paths store axis values directly into
+                // the output structures with no per-call rescaling, which is only correct
+                // because every virtual controller axis is fixed to the WinMM range here.
                 controllers[i]->SetAllAxisRange(kAxisRangeMin, kAxisRangeMax);
 
                 if (enableAxisProperites)
@@ -616,8 +1202,11 @@ namespace Xidi
             // Initialize the joystick index map.
             CreateJoyIndexMap();
 
-            // Ensure all controllers have their names published in the system registry.
-            SetControllerNameRegistryInfo();
+            // Ensure all controllers have their names published in the system registry. The
+            // writes themselves happen on a background task so the first WinMM call is not
+            // stalled behind slow registry virtualization; applications read these keys well
+            // after their input loop starts, so convergence shortly after is sufficient.
+            registryPublicationTask.Publish(joyIndexMap, joySystemDeviceInfo);
 
             // Initialization complete.
             Infra::Message::Output(
@@ -628,6 +1217,85 @@ namespace Xidi
           });
     }
 
+    /// Builds a complete capabilities image for the specified Xidi virtual controller, including
+    /// the resource-loaded registry key and controller name strings.
+    /// @tparam JoyCapsType Either JOYCAPSA or JOYCAPSW depending on whether ASCII or Unicode is
+    /// desired.
+    /// @param [in] xJoyID Xidi virtual controller identifier.
+    /// @return Fully filled-in capabilities structure.
+    template <typename JoyCapsType> static JoyCapsType BuildVirtualControllerCaps(
+        Controller::TControllerIdentifier xJoyID)
+    {
+      const Controller::SCapabilities controllerCapabilities =
+          Controller::GetControllerCapabilities(xJoyID);
+
+      JoyCapsType joyCaps;
+      ZeroMemory(&joyCaps, sizeof(joyCaps));
+
+      joyCaps.wMaxAxes = (WORD)Controller::EAxis::Count;
+      joyCaps.wMaxButtons = (WORD)Controller::EButton::Count;
+      joyCaps.wNumAxes = (WORD)controllerCapabilities.numAxes;
+      joyCaps.wNumButtons = (WORD)controllerCapabilities.numButtons;
+      joyCaps.wXmin = kAxisRangeMin;
+      joyCaps.wXmax = kAxisRangeMax;
+      joyCaps.wYmin = kAxisRangeMin;
+      joyCaps.wYmax = kAxisRangeMax;
+      joyCaps.wZmin = kAxisRangeMin;
+      joyCaps.wZmax = kAxisRangeMax;
+      joyCaps.wRmin = kAxisRangeMin;
+      joyCaps.wRmax = kAxisRangeMax;
+      joyCaps.wUmin = kAxisRangeMin;
+      joyCaps.wUmax = kAxisRangeMax;
+      joyCaps.wVmin = kAxisRangeMin;
+      joyCaps.wVmax = kAxisRangeMax;
+
+      if (true == controllerCapabilities.HasPov()) joyCaps.wCaps = JOYCAPS_HASPOV | JOYCAPS_POVCTS;
+
+      if (true == controllerCapabilities.HasAxis(Controller::EAxis::Z))
+        joyCaps.wCaps |= JOYCAPS_HASZ;
+
+      if (true == controllerCapabilities.HasAxis(Controller::EAxis::RotZ))
+        joyCaps.wCaps |= JOYCAPS_HASR;
+
+      if (true == controllerCapabilities.HasAxis(Controller::EAxis::RotY))
+        joyCaps.wCaps |= JOYCAPS_HASU;
+
+      if (true == controllerCapabilities.HasAxis(Controller::EAxis::RotX))
+        joyCaps.wCaps |= JOYCAPS_HASV;
+
+      FillRegistryKeyString(joyCaps.szRegKey, _countof(joyCaps.szRegKey));
+      FillVirtualControllerName(joyCaps.szPname, _countof(joyCaps.szPname), xJoyID);
+
+      return joyCaps;
+    }
+
+    /// Retrieves a cached capabilities image for the specified Xidi virtual controller. Mappers,
+    /// and therefore virtual controller capabilities, are fixed once initialization completes, so
+    /// the images are built once for all virtual controllers on first use and each subsequent
+    /// query reduces to a bounds-checked copy with no resource string lookups.
+    /// @tparam JoyCapsType Either JOYCAPSA or JOYCAPSW depending on whether ASCII or Unicode is
+    /// desired.
+    /// @param [in] xJoyID Xidi virtual controller identifier.
+    /// @return Read-only reference to the cached capabilities structure.
+    template <typename JoyCapsType> static const JoyCapsType& CachedVirtualControllerCaps(
+        Controller::TControllerIdentifier xJoyID)
+    {
+      static const std::array<JoyCapsType, Controller::kPhysicalControllerCount>
+          cachedVirtualControllerCaps =
+              []() -> std::array<JoyCapsType, Controller::kPhysicalControllerCount>
+      {
+        std::array<JoyCapsType, Controller::kPhysicalControllerCount> allCaps;
+
+        for (Controller::TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount;
+             ++i)
+          allCaps[i] = BuildVirtualControllerCaps<JoyCapsType>(i);
+
+        return allCaps;
+      }();
+
+      return cachedVirtualControllerCaps[xJoyID];
+    }
+
     /// Templated implementation of the `joyGetDevCaps` function, allowing an "A" version and a "W"
     /// version to be exported separately.
     template <typename JoyCapsType> static inline MMRESULT JoyGetDevCapsInternal(
@@ -643,13 +1311,12 @@ namespace Xidi
         return result;
       }
 
-      const int realJoyID = TranslateApplicationJoyIndex((UINT)uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex((UINT)uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
         // Querying an XInput controller.
-        const Controller::TControllerIdentifier xJoyID =
-            (Controller::TControllerIdentifier)((-realJoyID) - 1);
+        const Controller::TControllerIdentifier xJoyID = joyRoute.virtualControllerID;
 
         if (sizeof(*pjc) != cbjc)
         {
@@ -658,43 +1325,7 @@ namespace Xidi
           return result;
         }
 
-        const Controller::SCapabilities controllerCapabilities =
-            controllers[xJoyID]->GetCapabilities();
-
-        ZeroMemory(pjc, sizeof(*pjc));
-        pjc->wMaxAxes = (WORD)Controller::EAxis::Count;
-        pjc->wMaxButtons = (WORD)Controller::EButton::Count;
-        pjc->wNumAxes = (WORD)controllerCapabilities.numAxes;
-        pjc->wNumButtons = (WORD)controllerCapabilities.numButtons;
-        pjc->wXmin = kAxisRangeMin;
-        pjc->wXmax = kAxisRangeMax;
-        pjc->wYmin = kAxisRangeMin;
-        pjc->wYmax = kAxisRangeMax;
-        pjc->wZmin = kAxisRangeMin;
-        pjc->wZmax = kAxisRangeMax;
-        pjc->wRmin = kAxisRangeMin;
-        pjc->wRmax = kAxisRangeMax;
-        pjc->wUmin = kAxisRangeMin;
-        pjc->wUmax = kAxisRangeMax;
-        pjc->wVmin = kAxisRangeMin;
-        pjc->wVmax = kAxisRangeMax;
-
-        if (true == controllerCapabilities.HasPov()) pjc->wCaps = JOYCAPS_HASPOV | JOYCAPS_POVCTS;
-
-        if (true == controllerCapabilities.HasAxis(Controller::EAxis::Z))
-          pjc->wCaps |= JOYCAPS_HASZ;
-
-        if (true == controllerCapabilities.HasAxis(Controller::EAxis::RotZ))
-          pjc->wCaps |= JOYCAPS_HASR;
-
-        if (true == controllerCapabilities.HasAxis(Controller::EAxis::RotY))
-          pjc->wCaps |= JOYCAPS_HASU;
-
-        if (true == controllerCapabilities.HasAxis(Controller::EAxis::RotX))
-          pjc->wCaps |= JOYCAPS_HASV;
-
-        FillRegistryKeyString(pjc->szRegKey, _countof(pjc->szRegKey));
-        FillVirtualControllerName(pjc->szPname, _countof(pjc->szPname), xJoyID);
+        *pjc = CachedVirtualControllerCaps<JoyCapsType>(xJoyID);
 
         const MMRESULT result = JOYERR_NOERROR;
         return result;
@@ -703,7 +1334,7 @@ namespace Xidi
       {
         // Querying a non-XInput controller.
         // Replace the registry key but otherwise leave the response unchanged.
-        MMRESULT result = ImportedJoyGetDevCaps((UINT_PTR)realJoyID, pjc, cbjc);
+        MMRESULT result = ImportedJoyGetDevCaps((UINT_PTR)joyRoute.systemJoyID, pjc, cbjc);
 
         if (JOYERR_NOERROR == result) FillRegistryKeyString(pjc->szRegKey, _countof(pjc->szRegKey));
 
@@ -725,7 +1356,7 @@ namespace Xidi
       // Update Xidi's view of devices.
       CreateSystemDeviceInfo();
       CreateJoyIndexMap();
-      SetControllerNameRegistryInfo();
+      registryPublicationTask.Publish(joyIndexMap, joySystemDeviceInfo);
 
       return result;
     }
@@ -764,26 +1395,37 @@ namespace Xidi
     MMRESULT __stdcall joyGetPos(UINT uJoyID, LPJOYINFO pji)
     {
       Initialize();
-      const int realJoyID = TranslateApplicationJoyIndex(uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex(uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
         // Querying an XInput controller.
-        const Controller::TControllerIdentifier xJoyID =
-            (Controller::TControllerIdentifier)((-realJoyID) - 1);
+        const Controller::TControllerIdentifier xJoyID = joyRoute.virtualControllerID;
+
+        // Applications commonly probe every joystick index each frame to detect connection
+        // changes. For slots known to be disconnected, the virtual controller state is the fixed
+        // neutral state, so the response can be served from a single relaxed load of the
+        // connected-controller mask without touching any virtual controller state.
+        if (0 == (Diagnostics::GetConnectedControllerMask() & (1u << xJoyID)))
+        {
+          pji->wXpos = (WORD)kAxisRangeNeutral;
+          pji->wYpos = (WORD)kAxisRangeNeutral;
+          pji->wZpos = (WORD)kAxisRangeNeutral;
+          pji->wButtons = 0;
+
+          const MMRESULT result = JOYERR_NOERROR;
+          LOG_INVOCATION(Infra::Message::ESeverity::SuperDebug, (unsigned int)uJoyID, result);
+          return result;
+        }
 
         const Controller::SState joyStateData = controllers[xJoyID]->GetState();
 
         pji->wXpos = (WORD)joyStateData[Controller::EAxis::X];
         pji->wYpos = (WORD)joyStateData[Controller::EAxis::Y];
         pji->wZpos = (WORD)joyStateData[Controller::EAxis::Z];
-        pji->wButtons = 0;
-
-        constexpr size_t maxButtonIndex = 8 * sizeof(pji->wButtons);
-        for (size_t i = 0; ((i < joyStateData.button.size()) && (i < maxButtonIndex)); ++i)
-        {
-          if (true == joyStateData.button[i]) pji->wButtons |= (1 << i);
-        }
+        // Virtual controller buttons map 1:1 onto the packed button flags, so the packed word
+        // is just the low bits of the button bitset.
+        pji->wButtons = (WORD)joyStateData.button.to_ullong();
 
         const MMRESULT result = JOYERR_NOERROR;
         LOG_INVOCATION(Infra::Message::ESeverity::SuperDebug, (unsigned int)uJoyID, result);
@@ -792,7 +1434,7 @@ namespace Xidi
       else
       {
         // Querying a non-XInput controller.
-        const MMRESULT result = ImportApiWinMM::joyGetPos((UINT)realJoyID, pji);
+        const MMRESULT result = ImportApiWinMM::joyGetPos(joyRoute.systemJoyID, pji);
         LOG_INVOCATION(Infra::Message::ESeverity::SuperDebug, (unsigned int)uJoyID, result);
         return result;
       }
@@ -801,13 +1443,12 @@ namespace Xidi
     MMRESULT __stdcall joyGetPosEx(UINT uJoyID, LPJOYINFOEX pji)
     {
       Initialize();
-      const int realJoyID = TranslateApplicationJoyIndex(uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex(uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
         // Querying an XInput controller.
-        const Controller::TControllerIdentifier xJoyID =
-            (Controller::TControllerIdentifier)((-realJoyID) - 1);
+        const Controller::TControllerIdentifier xJoyID = joyRoute.virtualControllerID;
 
         if (sizeof(*pji) != pji->dwSize)
         {
@@ -817,6 +1458,25 @@ namespace Xidi
           return result;
         }
 
+        // As in joyGetPos, serve disconnected slots from a single relaxed load of the
+        // connected-controller mask, since their virtual controller state is the fixed neutral
+        // state anyway. Per-frame presence probes across all indices thus stay wait-free.
+        if (0 == (Diagnostics::GetConnectedControllerMask() & (1u << xJoyID)))
+        {
+          pji->dwPOV = (DWORD)JOY_POVCENTERED;
+          pji->dwXpos = (DWORD)kAxisRangeNeutral;
+          pji->dwYpos = (DWORD)kAxisRangeNeutral;
+          pji->dwZpos = (DWORD)kAxisRangeNeutral;
+          pji->dwRpos = (DWORD)kAxisRangeNeutral;
+          pji->dwUpos = (DWORD)kAxisRangeNeutral;
+          pji->dwVpos = (DWORD)kAxisRangeNeutral;
+          pji->dwButtons = 0;
+
+          const MMRESULT result = JOYERR_NOERROR;
+          LOG_INVOCATION(Infra::Message::ESeverity::SuperDebug, (unsigned int)uJoyID, result);
+          return result;
+        }
+
         const Controller::SState joyStateData = controllers[xJoyID]->GetState();
         const EPovValue joyStateDataPovValue =
             DataFormat::DirectInputPovValue(joyStateData.povDirection);
@@ -834,13 +1494,9 @@ namespace Xidi
         pji->dwRpos = joyStateData[Controller::EAxis::RotZ];
         pji->dwUpos = joyStateData[Controller::EAxis::RotY];
         pji->dwVpos = joyStateData[Controller::EAxis::RotX];
-        pji->dwButtons = 0;
-
-        constexpr size_t maxButtonIndex = 8 * sizeof(pji->dwButtons);
-        for (size_t i = 0; ((i < joyStateData.button.size()) && (i < maxButtonIndex)); ++i)
-        {
-          if (true == joyStateData.button[i]) pji->dwButtons |= (1 << i);
-        }
+        // Virtual controller buttons map 1:1 onto the packed button flags, so the packed word
+        // is just the low bits of the button bitset.
+        pji->dwButtons = (DWORD)joyStateData.button.to_ullong();
 
         const MMRESULT result = JOYERR_NOERROR;
         LOG_INVOCATION(Infra::Message::ESeverity::SuperDebug, (unsigned int)uJoyID, result);
@@ -849,7 +1505,7 @@ namespace Xidi
       else
       {
         // Querying a non-XInput controller.
-        const MMRESULT result = ImportApiWinMM::joyGetPosEx((UINT)realJoyID, pji);
+        const MMRESULT result = ImportApiWinMM::joyGetPosEx(joyRoute.systemJoyID, pji);
         LOG_INVOCATION(Infra::Message::ESeverity::SuperDebug, (unsigned int)uJoyID, result);
         return result;
       }
@@ -858,9 +1514,9 @@ namespace Xidi
     MMRESULT __stdcall joyGetThreshold(UINT uJoyID, LPUINT puThreshold)
     {
       Initialize();
-      const int realJoyID = TranslateApplicationJoyIndex(uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex(uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
         // Querying an XInput controller.
 
@@ -873,7 +1529,7 @@ namespace Xidi
       else
       {
         // Querying a non-XInput controller.
-        const MMRESULT result = ImportApiWinMM::joyGetThreshold((UINT)realJoyID, puThreshold);
+        const MMRESULT result = ImportApiWinMM::joyGetThreshold(joyRoute.systemJoyID, puThreshold);
         LOG_INVOCATION(Infra::Message::ESeverity::Info, (unsigned int)uJoyID, result);
         return result;
       }
@@ -882,22 +1538,21 @@ namespace Xidi
     MMRESULT __stdcall joyReleaseCapture(UINT uJoyID)
     {
       Initialize();
-      const int realJoyID = TranslateApplicationJoyIndex(uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex(uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
-        // Querying an XInput controller.
+        // Releasing an XInput controller.
+        MMRESULT result = JOYERR_NOERROR;
+        if (uJoyID < kJoyCaptureMaxDevices) result = joyCaptureTasks[uJoyID].Stop();
 
-        // Operation not supported.
-        const MMRESULT result = JOYERR_NOCANDO;
-        LOG_UNSUPPORTED_OPERATION();
         LOG_INVOCATION(Infra::Message::ESeverity::Info, (unsigned int)uJoyID, result);
         return result;
       }
       else
       {
-        // Querying a non-XInput controller.
-        const MMRESULT result = ImportApiWinMM::joyReleaseCapture((UINT)realJoyID);
+        // Releasing a non-XInput controller.
+        const MMRESULT result = ImportApiWinMM::joyReleaseCapture(joyRoute.systemJoyID);
         LOG_INVOCATION(Infra::Message::ESeverity::Info, (unsigned int)uJoyID, result);
         return result;
       }
@@ -906,23 +1561,42 @@ namespace Xidi
     MMRESULT __stdcall joySetCapture(HWND hwnd, UINT uJoyID, UINT uPeriod, BOOL fChanged)
     {
       Initialize();
-      const int realJoyID = TranslateApplicationJoyIndex(uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex(uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
-        // Querying an XInput controller.
+        // Capturing an XInput controller.
+        const Controller::TControllerIdentifier xJoyID = joyRoute.virtualControllerID;
+
+        MMRESULT result = JOYERR_NOERROR;
+
+        if (uJoyID >= kJoyCaptureMaxDevices)
+        {
+          // WinMM defines capture messages for only the first two joysticks.
+          result = JOYERR_NOCANDO;
+          LOG_UNSUPPORTED_OPERATION();
+        }
+        else if (FALSE == IsWindow(hwnd))
+        {
+          result = JOYERR_PARMS;
+          LOG_INVALID_PARAMS();
+        }
+        else
+        {
+          // Capture message delivery is driven by actual controller state changes rather than by
+          // the requested polling period, so the period and change-only parameters are accepted
+          // but otherwise not used.
+          result = joyCaptureTasks[uJoyID].Start(hwnd, uJoyID, xJoyID);
+        }
 
-        // Operation not supported.
-        const MMRESULT result = JOYERR_NOCANDO;
-        LOG_UNSUPPORTED_OPERATION();
         LOG_INVOCATION(Infra::Message::ESeverity::Info, (unsigned int)uJoyID, result);
         return result;
       }
       else
       {
-        // Querying a non-XInput controller.
+        // Capturing a non-XInput controller.
         const MMRESULT result =
-            ImportApiWinMM::joySetCapture(hwnd, (UINT)realJoyID, uPeriod, fChanged);
+            ImportApiWinMM::joySetCapture(hwnd, joyRoute.systemJoyID, uPeriod, fChanged);
         LOG_INVOCATION(Infra::Message::ESeverity::Info, (unsigned int)uJoyID, result);
         return result;
       }
@@ -931,9 +1605,9 @@ namespace Xidi
     MMRESULT __stdcall joySetThreshold(UINT uJoyID, UINT uThreshold)
     {
       Initialize();
-      const int realJoyID = TranslateApplicationJoyIndex(uJoyID);
+      const SJoyRouteEntry joyRoute = RouteApplicationJoyIndex(uJoyID);
 
-      if (realJoyID < 0)
+      if (SJoyRouteEntry::ETarget::VirtualController == joyRoute.target)
       {
         // Querying an XInput controller.
 
@@ -946,7 +1620,7 @@ namespace Xidi
       else
       {
         // Querying a non-XInput controller.
-        const MMRESULT result = ImportApiWinMM::joySetThreshold((UINT)realJoyID, uThreshold);
+        const MMRESULT result = ImportApiWinMM::joySetThreshold(joyRoute.systemJoyID, uThreshold);
         LOG_INVOCATION(Infra::Message::ESeverity::Info, (unsigned int)uJoyID, result);
         return result;
       }
@@ -11,12 +11,13 @@
 
 #include "XidiConfigReader.h"
 
-#include <map>
 #include <mutex>
 #include <optional>
 #include <string_view>
+#include <utility>
 
 #include <Infra/Core/Configuration.h>
+#include <Infra/Core/ProcessInfo.h>
 #include <Infra/Core/Strings.h>
 #include <Infra/Core/TemporaryBuffer.h>
 
@@ -65,6 +66,12 @@ namespace Xidi
                   Strings::kStrConfigurationSettingLogEnabled, EValueType::Boolean),
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingLogLevel, EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingLogProfilingSampleInterval,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingLogPollingJitterWarningThreshold,
+                  EValueType::Integer),
           }),
       ConfigurationFileLayoutSection(
           Strings::kStrConfigurationSectionMapper,
@@ -75,6 +82,12 @@ namespace Xidi
       ConfigurationFileLayoutSection(
           Strings::kStrConfigurationSectionProperties,
           {
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingPropertiesCaptureBackend, EValueType::String),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingPropertiesPollingBackend, EValueType::String),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingPropertiesSynthesisBackend, EValueType::String),
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingPropertiesForceFeedbackEffectStrengthPercent,
                   EValueType::Integer),
@@ -84,6 +97,12 @@ namespace Xidi
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingsPropertiesUseBuiltinProperties,
                   EValueType::Boolean),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesUseDevicePropertyCache,
+                  EValueType::Boolean),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesUseSharedPhysicalState,
+                  EValueType::Boolean),
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingsPropertiesCircleToSquarePercentStickLeft,
                   EValueType::Integer),
@@ -102,6 +121,12 @@ namespace Xidi
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingsPropertiesDeadzonePercentTriggerRT,
                   EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesRadialDeadzoneStickLeft,
+                  EValueType::Boolean),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesRadialDeadzoneStickRight,
+                  EValueType::Boolean),
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingsPropertiesSaturationPercentStickLeft,
                   EValueType::Integer),
@@ -114,6 +139,56 @@ namespace Xidi
               ConfigurationFileLayoutNameAndValueType(
                   Strings::kStrConfigurationSettingsPropertiesSaturationPercentTriggerRT,
                   EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesStateChangeEventSignalingWatermark,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesLowMemoryMode, EValueType::Boolean),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingsPropertiesStateChangeEventCoalescing,
+                  EValueType::Boolean),
+          }),
+      ConfigurationFileLayoutSection(
+          Strings::kStrConfigurationSectionStateTrace,
+          {
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingStateTraceRecordFilename, EValueType::String),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingStateTraceReplayFilename, EValueType::String),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingStateTraceReplaySpeedPercent,
+                  EValueType::Integer),
+          }),
+      ConfigurationFileLayoutSection(
+          Strings::kStrConfigurationSectionWorkerThreads,
+          {
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsPollingThreadPriority,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsPollingThreadAffinityMask,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsForceFeedbackThreadPriority,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsForceFeedbackThreadAffinityMask,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsInputDispatchThreadPriority,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsInputDispatchThreadAffinityMask,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsBackgroundTaskThreadPriority,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsBackgroundTaskThreadAffinityMask,
+                  EValueType::Integer),
+              ConfigurationFileLayoutNameAndValueType(
+                  Strings::kStrConfigurationSettingWorkerThreadsCpuBudgetPercent,
+                  EValueType::Integer),
           }),
       ConfigurationFileLayoutSection(
           Strings::kStrConfigurationSectionWorkarounds,
@@ -134,17 +209,16 @@ namespace Xidi
 
 #ifndef XIDI_SKIP_MAPPERS
   /// Determines the operation that should be performed on a mapper blueprint based on the name of a
-  /// configuration setting.
+  /// configuration setting. This function runs for every line of every custom mapper section, once
+  /// for type determination and once for value dispatch, so it deliberately performs only direct
+  /// string comparisons with no container lookups or allocations.
   /// @param [in] name Configuration setting name.
   /// @return Operation to perform.
   static EBlueprintOperation BlueprintOperationFromName(std::wstring_view name)
   {
-    /// Map of supported configuration setting names to associated blueprint operations.
-    static const std::map<std::wstring_view, EBlueprintOperation> kBlueprintOperationsMap = {
-        {Strings::kStrConfigurationSettingCustomMapperTemplate, EBlueprintOperation::SetTemplate}};
-
     // If the configuration setting name identifies a valid controller element, then the value
-    // should be parsed for an element mapper to be assigned to that controller element.
+    // should be parsed for an element mapper to be assigned to that controller element. This is by
+    // far the most common kind of setting in a custom mapper section, so it is checked first.
     if (true == Controller::MapperParser::IsControllerElementStringValid(name))
       return EBlueprintOperation::SetElementMapper;
 
@@ -153,11 +227,8 @@ namespace Xidi
     if (true == Controller::MapperParser::IsForceFeedbackActuatorStringValid(name))
       return EBlueprintOperation::SetForceFeedbackActuator;
 
-    // If the configuration setting name is known and contained within the map above, simply return
-    // it.
-    const auto blueprintOperationIter = kBlueprintOperationsMap.find(name);
-    if (kBlueprintOperationsMap.cend() != blueprintOperationIter)
-      return blueprintOperationIter->second;
+    if (Strings::kStrConfigurationSettingCustomMapperTemplate == name)
+      return EBlueprintOperation::SetTemplate;
 
     return EBlueprintOperation::Error;
   }
@@ -173,6 +244,34 @@ namespace Xidi
     return (section.starts_with(Strings::kStrConfigurationSectionCustomMapperPrefix));
   }
 
+  /// Splits a per-application profile section name into its base section name and executable name
+  /// parts. Profile sections are named by qualifying a base section name with an executable name,
+  /// as in "Properties:Game.exe".
+  /// @param [in] section Section name to split.
+  /// @return Base section name and executable name, if the section name contains the profile
+  /// separator character.
+  static std::optional<std::pair<std::wstring_view, std::wstring_view>> SplitProfileSectionName(
+      std::wstring_view section)
+  {
+    const size_t separatorPosition =
+        section.find(Strings::kCharConfigurationSectionProfileSeparator);
+    if (std::wstring_view::npos == separatorPosition) return std::nullopt;
+
+    return std::make_pair(
+        section.substr(0, separatorPosition), section.substr(1 + separatorPosition));
+  }
+
+  /// Strips the executable name qualifier, if one is present, from a section name, leaving just
+  /// the base section name. Per-application profile sections use the same settings layout and
+  /// validation rules as the base sections they override, so value handling is keyed on the base
+  /// section name.
+  /// @param [in] section Section name from which to strip any executable name qualifier.
+  /// @return Base section name.
+  static inline std::wstring_view ProfileSectionBaseName(std::wstring_view section)
+  {
+    return section.substr(0, section.find(Strings::kCharConfigurationSectionProfileSeparator));
+  }
+
 #ifndef XIDI_SKIP_MAPPERS
   /// Extracts the name of a custom mapper from a section name and performs no error checks
   /// whatsoever.
@@ -231,6 +330,24 @@ namespace Xidi
     if (true == IsCustomMapperSectionName(section)) return Action::Skip();
 #endif
 
+    const std::optional<std::pair<std::wstring_view, std::wstring_view>> maybeProfileSection =
+        SplitProfileSectionName(section);
+    if (true == maybeProfileSection.has_value())
+    {
+      if (0 == configurationFileLayout.count(maybeProfileSection->first)) return Action::Error();
+
+      // Profile sections for other applications are skipped outright, without parsing or
+      // validating any of the values they contain. This way the cost of reading a configuration
+      // file shared by many applications scales with the sections that are applicable to the
+      // current application, not with the file as a whole.
+      if (false ==
+          Infra::Strings::EqualsCaseInsensitive(
+              maybeProfileSection->second, Infra::ProcessInfo::GetExecutableBaseName()))
+        return Action::Skip();
+
+      return Action::Process();
+    }
+
     if (0 != configurationFileLayout.count(section)) return Action::Process();
 
     return Action::Error();
@@ -239,6 +356,8 @@ namespace Xidi
   Action XidiConfigReader::ActionForValue(
       std::wstring_view section, std::wstring_view name, TIntegerView value)
   {
+    section = ProfileSectionBaseName(section);
+
 #ifndef XIDI_SKIP_MAPPERS
     if (Strings::kStrConfigurationSectionProperties == section)
     {
@@ -282,6 +401,19 @@ namespace Xidi
     }
 #endif
 
+    if (Strings::kStrConfigurationSectionWorkerThreads == section)
+    {
+      if (name.ends_with(L"Priority"))
+      {
+        // Worker thread priorities use the Windows per-thread priority value range, which
+        // includes negative values for below-normal priorities.
+        if ((value >= THREAD_PRIORITY_IDLE) && (value <= THREAD_PRIORITY_TIME_CRITICAL))
+          return Action::Process();
+        else
+          return Action::Error();
+      }
+    }
+
     if (value >= 0) return Action::Process();
 
     return Action::Error();
@@ -395,6 +527,14 @@ namespace Xidi
             configurationFileLayout[Strings::kStrConfigurationSectionMapper]
                                    [Strings::MapperTypeConfigurationNameString(i)] =
                                        EValueType::String;
+
+          // Create the per-controller capture backend settings types and submit them to the
+          // configuration file layout, likewise generated dynamically.
+          for (Controller::TControllerIdentifier i = 0; i < Controller::kPhysicalControllerCount;
+               ++i)
+            configurationFileLayout[Strings::kStrConfigurationSectionProperties]
+                                   [Strings::CaptureBackendConfigurationNameString(i)] =
+                                       EValueType::String;
         });
   }
 
@@ -421,7 +561,7 @@ namespace Xidi
     }
 #endif
 
-    auto sectionLayout = configurationFileLayout.find(section);
+    auto sectionLayout = configurationFileLayout.find(ProfileSectionBaseName(section));
     if (configurationFileLayout.end() == sectionLayout) return EValueType::Error;
 
     auto settingInfo = sectionLayout->second.find(name);